@@ -0,0 +1,99 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Helpers shared by the C benchmark drivers: a monotonic clock, checked allocations, and the
+ * reader of the corpus written by benchmarks/run_benchmarks.py. Included first by each driver,
+ * so that clock_gettime is declared in the strict C11 builds of run_benchmarks.py.
+ */
+
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+// Number of columns of the corpus: TDryBulb, RelHum, Pressure, TWetBulb, HumRatio and MoistAirEnthalpy,
+// as CORPUS_COLUMNS in run_benchmarks.py
+#define CORPUS_COLUMNS 6
+
+// Monotonic time in s, not affected by changes of the time of day
+static inline double Now(void)
+{
+#if defined(_WIN32)
+  LARGE_INTEGER Counter, Frequency;
+  QueryPerformanceCounter(&Counter);
+  QueryPerformanceFrequency(&Frequency);
+  return (double) Counter.QuadPart / Frequency.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+#endif
+}
+
+// realloc that exits the driver when out of memory; Pointer may be NULL
+static inline void *Reallocate(void *Pointer, size_t Size)
+{
+  void *Result = realloc(Pointer, Size > 0 ? Size : 1);
+
+  if (Result == NULL)
+  {
+    fprintf(stderr, "Out of memory\n");
+    exit(EXIT_FAILURE);
+  }
+  return Result;
+}
+
+// malloc that exits the driver when out of memory
+static inline void *Allocate(size_t Size)
+{
+  return Reallocate(NULL, Size);
+}
+
+// Read the corpus below its header line, and return its rows of CORPUS_COLUMNS values one after the
+// other, to be freed by the caller. Exits the driver when the file cannot be read.
+static inline double *ReadCorpus(const char *Path, size_t *NRows)
+{
+  char line[1024], *p;
+  size_t Capacity = 1024;
+  double *Rows;
+  FILE *fp;
+  int c;
+
+  fp = fopen(Path, "r");
+  if (fp == NULL || fgets(line, sizeof line, fp) == NULL)
+  {
+    fprintf(stderr, "Cannot read corpus: %s\n", Path);
+    exit(EXIT_FAILURE);
+  }
+  Rows = Allocate(Capacity * CORPUS_COLUMNS * sizeof(double));
+  *NRows = 0;
+  while (fgets(line, sizeof line, fp) != NULL)
+  {
+    if (*NRows == Capacity)
+    {
+      Capacity *= 2;
+      Rows = Reallocate(Rows, Capacity * CORPUS_COLUMNS * sizeof(double));
+    }
+    p = line;
+    for (c = 0; c < CORPUS_COLUMNS; c++)
+    {
+      Rows[*NRows * CORPUS_COLUMNS + c] = strtod(p, &p);
+      p++;
+    }
+    (*NRows)++;
+  }
+  fclose(fp);
+  return Rows;
+}
+
+#endif // BENCH_COMMON_H
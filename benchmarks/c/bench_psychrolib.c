@@ -0,0 +1,111 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Benchmark driver of the C implementation, run by benchmarks/run_benchmarks.py.
+ * Usage: bench_psychrolib <SI|IP> <corpus.csv> <values.csv> <timings.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+
+#define N_FUNCTIONS 11
+
+// Columns of the corpus
+enum { TDRYBULB, RELHUM, PRESSURE, TWETBULB, HUMRATIO, MOISTAIRENTHALPY };
+
+static const char *FUNCTION_NAMES[N_FUNCTIONS] =
+{
+  "GetSatVapPres", "GetSatHumRatio", "GetHumRatioFromRelHum", "GetTDewPointFromRelHum",
+  "GetTWetBulbFromRelHum", "GetRelHumFromTWetBulb", "GetTDewPointFromHumRatio",
+  "GetTWetBulbFromHumRatio", "GetMoistAirEnthalpy", "GetMoistAirVolume",
+  "GetTDryBulbFromEnthalpyAndHumRatio"
+};
+
+// Evaluate function f on row i of the corpus
+static double Evaluate(int f, const double *row)
+{
+  switch (f)
+  {
+    case 0: return GetSatVapPres(row[TDRYBULB]);
+    case 1: return GetSatHumRatio(row[TDRYBULB], row[PRESSURE]);
+    case 2: return GetHumRatioFromRelHum(row[TDRYBULB], row[RELHUM], row[PRESSURE]);
+    case 3: return GetTDewPointFromRelHum(row[TDRYBULB], row[RELHUM]);
+    case 4: return GetTWetBulbFromRelHum(row[TDRYBULB], row[RELHUM], row[PRESSURE]);
+    case 5: return GetRelHumFromTWetBulb(row[TDRYBULB], row[TWETBULB], row[PRESSURE]);
+    case 6: return GetTDewPointFromHumRatio(row[TDRYBULB], row[HUMRATIO], row[PRESSURE]);
+    case 7: return GetTWetBulbFromHumRatio(row[TDRYBULB], row[HUMRATIO], row[PRESSURE]);
+    case 8: return GetMoistAirEnthalpy(row[TDRYBULB], row[HUMRATIO]);
+    case 9: return GetMoistAirVolume(row[TDRYBULB], row[HUMRATIO], row[PRESSURE]);
+    default: return GetTDryBulbFromEnthalpyAndHumRatio(row[MOISTAIRENTHALPY], row[HUMRATIO]);
+  }
+}
+
+static void Fail(const char *message, const char *path)
+{
+  fprintf(stderr, "%s: %s\n", message, path);
+  exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc != 6)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <values.csv> <timings.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+  double minTime = atof(argv[5]);
+
+  // Read the corpus
+  size_t nRows;
+  double *corpus = ReadCorpus(argv[2], &nRows);
+
+  // Values of each function on each row
+  double *values = Allocate(nRows * N_FUNCTIONS * sizeof(double));
+  for (size_t i = 0; i < nRows; i++)
+    for (int f = 0; f < N_FUNCTIONS; f++)
+      values[i * N_FUNCTIONS + f] = Evaluate(f, &corpus[i * CORPUS_COLUMNS]);
+
+  FILE *fp = fopen(argv[3], "w");
+  if (fp == NULL)
+    Fail("Cannot open values", argv[3]);
+  for (int f = 0; f < N_FUNCTIONS; f++)
+    fprintf(fp, "%s%c", FUNCTION_NAMES[f], f == N_FUNCTIONS - 1 ? '\n' : ',');
+  for (size_t i = 0; i < nRows; i++)
+    for (int f = 0; f < N_FUNCTIONS; f++)
+      fprintf(fp, "%.17g%c", values[i * N_FUNCTIONS + f], f == N_FUNCTIONS - 1 ? '\n' : ',');
+  fclose(fp);
+
+  // Timings: passes over the corpus are doubled until the minimum time is reached
+  fp = fopen(argv[4], "w");
+  if (fp == NULL)
+    Fail("Cannot open timings", argv[4]);
+  fprintf(fp, "Function,Calls,Seconds\n");
+  volatile double sink = 0;
+  for (int f = 0; f < N_FUNCTIONS; f++)
+  {
+    long passes = 1;
+    double elapsed;
+    for (;;)
+    {
+      double start = Now();
+      for (long r = 0; r < passes; r++)
+        for (size_t i = 0; i < nRows; i++)
+          sink += Evaluate(f, &corpus[i * CORPUS_COLUMNS]);
+      elapsed = Now() - start;
+      if (elapsed >= minTime)
+        break;
+      passes *= 2;
+    }
+    fprintf(fp, "%s,%ld,%.9g\n", FUNCTION_NAMES[f], passes * (long)nRows, elapsed);
+  }
+  fclose(fp);
+
+  free(values);
+  free(corpus);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,391 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Accuracy against throughput of the implementations of each function, run by
+ * benchmarks/run_benchmarks.py: the generic functions (PSYCHROLIB_TOLERANCE), the bounded-latency
+ * functions (SOLVER_TOLERANCE) and trilinear and cubic property tables at two resolutions, against
+ * the extended-precision reference functions of psychrolib_reference.c evaluated at the same double
+ * inputs. The points are a dense grid of the range of the equations: 241 dry-bulb temperatures from
+ * -100 to 200 °C (-148 to 392 °F), 25 relative humidities from 0.01 to 1 and the standard pressures
+ * at 0, 1000, 2000, 3000 and 5000 m, with vapor pressures below 90% of the pressure and dew points
+ * 0.5 °C (0.9 °F) above the lower bound of the equations. The other inputs (humidity ratio, vapor
+ * pressure, wet-bulb temperature, enthalpy) are the reference functions of these, rounded to double.
+ * The maximum error is also reported over the points below the boiling point at their pressure,
+ * above which the bisection of the generic wet-bulb temperature may converge to the dry-bulb
+ * temperature. The tables cover the range of temperatures and pressures and humidity ratios up to
+ * 0.1, and are measured on the points of the grid in them. Each function has a tolerance on the
+ * maximum error below the boiling point (TOLERANCES): the rows within it that no other row within it
+ * beats in both that error and time per call are marked Pareto optimal, and a faster implementation
+ * is accepted when its row is. The rows above the tolerance are not marked. The corpus is not used.
+ * Prints a Markdown table.
+ * Usage: bench_psychrolib_accuracy <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_bounded.h"
+#include "psychrolib_reference.h"
+#include "psychrolib_table.h"
+
+#define N_TDRY_BULB 241
+#define N_REL_HUM 25
+#define N_PRESSURE 5
+
+#define TABLE_MAX_HUM_RATIO 0.1
+
+enum Function
+{
+  SAT_VAP_PRES, SAT_HUM_RATIO, HUM_RATIO_FROM_REL_HUM, HUM_RATIO_FROM_TWET_BULB, TDEW_POINT_FROM_VAP_PRES,
+  TDEW_POINT_FROM_REL_HUM, TDEW_POINT_FROM_HUM_RATIO, TWET_BULB_FROM_HUM_RATIO, TWET_BULB_FROM_REL_HUM,
+  REL_HUM_FROM_TWET_BULB, MOIST_AIR_ENTHALPY, MOIST_AIR_VOLUME, TDRY_BULB_FROM_ENTHALPY_AND_HUM_RATIO,
+  N_FUNCTIONS
+};
+
+static const char *FUNCTION_NAMES[N_FUNCTIONS] =
+{
+  "GetSatVapPres", "GetSatHumRatio", "GetHumRatioFromRelHum", "GetHumRatioFromTWetBulb",
+  "GetTDewPointFromVapPres", "GetTDewPointFromRelHum", "GetTDewPointFromHumRatio",
+  "GetTWetBulbFromHumRatio", "GetTWetBulbFromRelHum", "GetRelHumFromTWetBulb", "GetMoistAirEnthalpy",
+  "GetMoistAirVolume", "GetTDryBulbFromEnthalpyAndHumRatio"
+};
+
+// Temperatures, whose relative error is not reported
+static const int IS_TEMPERATURE[N_FUNCTIONS] = { 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 1 };
+
+// Tolerance on the maximum absolute error below the boiling point, in SI and IP units: 0.01 Pa,
+// 1e-6 kg kg⁻¹, 0.01 °C, 1e-4, 10 J kg⁻¹ and 1e-4 m³ kg⁻¹
+static const double TOLERANCES[2][N_FUNCTIONS] =
+{
+  { 0.01, 1e-6, 1e-6, 1e-6, 0.01, 0.01, 0.01, 0.01, 0.01, 1e-4, 10., 1e-4, 0.01 },
+  { 1.45e-6, 1e-6, 1e-6, 1e-6, 0.018, 0.018, 0.018, 0.018, 0.018, 1e-4, 4.3e-3, 1.6e-3, 0.018 }
+};
+
+enum Backend
+{
+  GENERIC, BOUNDED, TRILINEAR_COARSE, TRILINEAR_FINE, CUBIC_COARSE, CUBIC_FINE, N_BACKENDS
+};
+
+static const char *BACKEND_NAMES[N_BACKENDS] =
+{
+  "Generic", "Bounded", "Trilinear table, coarse", "Trilinear table, fine", "Cubic table, coarse", "Cubic table, fine"
+};
+
+// Nodes of the tables in temperature and humidity ratio, coarse and fine
+static const size_t TABLE_NODES[2][2] = { { 121, 41 }, { 241, 81 } };
+
+struct Point
+{
+  double TDryBulb, RelHum, Pressure, HumRatio, VapPres, TWetBulb, MoistAirEnthalpy;
+  int BelowBoiling;                     // Dry-bulb temperature below the boiling point at the pressure
+};
+
+struct Row
+{
+  size_t Points, Failures;
+  double MaxAbsError, MaxAbsErrorBelowBoiling, Percentile99, MaxRelError, Time;
+};
+
+static struct Point *Points;
+static size_t N;
+static PsychroRefReal *Reference[N_FUNCTIONS];
+static double *Values, *Errors;
+static PsychroTable *Tables[N_BACKENDS];
+static size_t *Selected, NSelected;
+static enum Backend CurrentBackend;
+static enum Function CurrentFunction;
+
+static void Fail(const char *Message)
+{
+  fprintf(stderr, "%s\n", Message);
+  exit(EXIT_FAILURE);
+}
+
+static PsychroRefReal ReferenceValue(enum Function f, const struct Point *p)
+{
+  switch (f)
+  {
+    case SAT_VAP_PRES: return ReferenceGetSatVapPres(p->TDryBulb);
+    case SAT_HUM_RATIO: return ReferenceGetSatHumRatio(p->TDryBulb, p->Pressure);
+    case HUM_RATIO_FROM_REL_HUM: return ReferenceGetHumRatioFromRelHum(p->TDryBulb, p->RelHum, p->Pressure);
+    case HUM_RATIO_FROM_TWET_BULB: return ReferenceGetHumRatioFromTWetBulb(p->TDryBulb, p->TWetBulb, p->Pressure);
+    case TDEW_POINT_FROM_VAP_PRES: return ReferenceGetTDewPointFromVapPres(p->TDryBulb, p->VapPres);
+    case TDEW_POINT_FROM_REL_HUM: return ReferenceGetTDewPointFromRelHum(p->TDryBulb, p->RelHum);
+    case TDEW_POINT_FROM_HUM_RATIO: return ReferenceGetTDewPointFromHumRatio(p->TDryBulb, p->HumRatio, p->Pressure);
+    case TWET_BULB_FROM_HUM_RATIO: return ReferenceGetTWetBulbFromHumRatio(p->TDryBulb, p->HumRatio, p->Pressure);
+    case TWET_BULB_FROM_REL_HUM: return ReferenceGetTWetBulbFromRelHum(p->TDryBulb, p->RelHum, p->Pressure);
+    case REL_HUM_FROM_TWET_BULB: return ReferenceGetRelHumFromTWetBulb(p->TDryBulb, p->TWetBulb, p->Pressure);
+    case MOIST_AIR_ENTHALPY: return ReferenceGetMoistAirEnthalpy(p->TDryBulb, p->HumRatio);
+    case MOIST_AIR_VOLUME: return ReferenceGetMoistAirVolume(p->TDryBulb, p->HumRatio, p->Pressure);
+    default: return ReferenceGetTDryBulbFromEnthalpyAndHumRatio(p->MoistAirEnthalpy, p->HumRatio);
+  }
+}
+
+static double Generic(enum Function f, const struct Point *p)
+{
+  switch (f)
+  {
+    case SAT_VAP_PRES: return GetSatVapPres(p->TDryBulb);
+    case SAT_HUM_RATIO: return GetSatHumRatio(p->TDryBulb, p->Pressure);
+    case HUM_RATIO_FROM_REL_HUM: return GetHumRatioFromRelHum(p->TDryBulb, p->RelHum, p->Pressure);
+    case HUM_RATIO_FROM_TWET_BULB: return GetHumRatioFromTWetBulb(p->TDryBulb, p->TWetBulb, p->Pressure);
+    case TDEW_POINT_FROM_VAP_PRES: return GetTDewPointFromVapPres(p->TDryBulb, p->VapPres);
+    case TDEW_POINT_FROM_REL_HUM: return GetTDewPointFromRelHum(p->TDryBulb, p->RelHum);
+    case TDEW_POINT_FROM_HUM_RATIO: return GetTDewPointFromHumRatio(p->TDryBulb, p->HumRatio, p->Pressure);
+    case TWET_BULB_FROM_HUM_RATIO: return GetTWetBulbFromHumRatio(p->TDryBulb, p->HumRatio, p->Pressure);
+    case TWET_BULB_FROM_REL_HUM: return GetTWetBulbFromRelHum(p->TDryBulb, p->RelHum, p->Pressure);
+    case REL_HUM_FROM_TWET_BULB: return GetRelHumFromTWetBulb(p->TDryBulb, p->TWetBulb, p->Pressure);
+    case MOIST_AIR_ENTHALPY: return GetMoistAirEnthalpy(p->TDryBulb, p->HumRatio);
+    case MOIST_AIR_VOLUME: return GetMoistAirVolume(p->TDryBulb, p->HumRatio, p->Pressure);
+    default: return GetTDryBulbFromEnthalpyAndHumRatio(p->MoistAirEnthalpy, p->HumRatio);
+  }
+}
+
+// Bounded-latency function, NAN if it fails
+static double Bounded(enum Function f, const struct Point *p)
+{
+  PsychroReal Value;
+  enum PsychroStatus Status;
+
+  switch (f)
+  {
+    case SAT_VAP_PRES: Status = BoundedGetSatVapPres(p->TDryBulb, &Value); break;
+    case SAT_HUM_RATIO: Status = BoundedGetSatHumRatio(p->TDryBulb, p->Pressure, &Value); break;
+    case HUM_RATIO_FROM_REL_HUM: Status = BoundedGetHumRatioFromRelHum(p->TDryBulb, p->RelHum, p->Pressure, &Value); break;
+    case HUM_RATIO_FROM_TWET_BULB: Status = BoundedGetHumRatioFromTWetBulb(p->TDryBulb, p->TWetBulb, p->Pressure, &Value); break;
+    case TDEW_POINT_FROM_VAP_PRES: Status = BoundedGetTDewPointFromVapPres(p->TDryBulb, p->VapPres, &Value); break;
+    case TDEW_POINT_FROM_REL_HUM: Status = BoundedGetTDewPointFromRelHum(p->TDryBulb, p->RelHum, &Value); break;
+    case TDEW_POINT_FROM_HUM_RATIO: Status = BoundedGetTDewPointFromHumRatio(p->TDryBulb, p->HumRatio, p->Pressure, &Value); break;
+    case TWET_BULB_FROM_HUM_RATIO: Status = BoundedGetTWetBulbFromHumRatio(p->TDryBulb, p->HumRatio, p->Pressure, &Value); break;
+    default: Status = BoundedGetTWetBulbFromRelHum(p->TDryBulb, p->RelHum, p->Pressure, &Value);
+  }
+  return Status == PSYCHRO_STATUS_OK ? Value : NAN;
+}
+
+static double Tabulated(enum Function f, const struct Point *p, const PsychroTable *Table)
+{
+  enum PsychroTableProperty Property = f == MOIST_AIR_ENTHALPY ? PSYCHRO_TABLE_MOIST_AIR_ENTHALPY
+    : f == MOIST_AIR_VOLUME ? PSYCHRO_TABLE_MOIST_AIR_VOLUME
+    : f == TWET_BULB_FROM_HUM_RATIO ? PSYCHRO_TABLE_TWET_BULB : PSYCHRO_TABLE_TDEW_POINT;
+
+  return PsychroTableLookup(Table, Property, p->TDryBulb, p->HumRatio, p->Pressure);
+}
+
+// Whether a backend implements a function
+static int Implements(enum Backend b, enum Function f)
+{
+  if (b == GENERIC)
+    return 1;
+  if (b == BOUNDED)
+    return f <= TWET_BULB_FROM_REL_HUM;
+  return f == TDEW_POINT_FROM_HUM_RATIO || f == TWET_BULB_FROM_HUM_RATIO || f == MOIST_AIR_ENTHALPY || f == MOIST_AIR_VOLUME;
+}
+
+static void Run(void)
+{
+  size_t k;
+
+  for (k = 0; k < NSelected; k++)
+  {
+    const struct Point *p = &Points[Selected[k]];
+    if (CurrentBackend == GENERIC)
+      Values[k] = Generic(CurrentFunction, p);
+    else if (CurrentBackend == BOUNDED)
+      Values[k] = Bounded(CurrentFunction, p);
+    else
+      Values[k] = Tabulated(CurrentFunction, p, Tables[CurrentBackend]);
+  }
+}
+
+// Time per call in ns, doubling the passes until the minimum time is reached
+static double Time(double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run();
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e9 * Elapsed / ((double) Passes * NSelected);
+    Passes *= 2;
+  }
+}
+
+static int CompareDoubles(const void *a, const void *b)
+{
+  double x = *(const double *) a, y = *(const double *) b;
+  return (x > y) - (x < y);
+}
+
+static struct Row Measure(enum Backend b, enum Function f, double MinTime)
+{
+  struct Row Row = { 0, 0, 0., 0., 0., 0., 0. };
+  PsychroRefReal Exact;
+  size_t k, n = 0;
+
+  NSelected = 0;
+  for (k = 0; k < N; k++)
+    if (b < TRILINEAR_COARSE || Points[k].HumRatio <= TABLE_MAX_HUM_RATIO)
+      Selected[NSelected++] = k;
+  CurrentBackend = b;
+  CurrentFunction = f;
+  Row.Time = Time(MinTime);
+  Row.Points = NSelected;
+
+  for (k = 0; k < NSelected; k++)
+  {
+    Exact = Reference[f][Selected[k]];
+    if (isnan(Values[k]))
+    {
+      Row.Failures++;
+      continue;
+    }
+    Errors[n] = fabs((double) ((PsychroRefReal) Values[k] - Exact));
+    if (Errors[n] > Row.MaxAbsError)
+      Row.MaxAbsError = Errors[n];
+    if (Points[Selected[k]].BelowBoiling && Errors[n] > Row.MaxAbsErrorBelowBoiling)
+      Row.MaxAbsErrorBelowBoiling = Errors[n];
+    if (!IS_TEMPERATURE[f] && Exact != 0 && Errors[n] / fabs((double) Exact) > Row.MaxRelError)
+      Row.MaxRelError = Errors[n] / fabs((double) Exact);
+    n++;
+  }
+  if (n > 0)
+  {
+    qsort(Errors, n, sizeof(double), CompareDoubles);
+    Row.Percentile99 = Errors[(size_t) ceil(0.99 * n) - 1];
+  }
+  return Row;
+}
+
+int main(int argc, char *argv[])
+{
+  static struct Row Rows[N_FUNCTIONS][N_BACKENDS];
+  static struct PsychroTableConfig Config;
+  double TLow, THigh, Altitude, MinTime;
+  struct Point p;
+  size_t i, j, k;
+  int f, b, c;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+  MinTime = atof(argv[3]);
+  TLow = isIP() ? -148. : -100.;
+  THigh = isIP() ? 392. : 200.;
+
+  // Grid of the range of the equations
+  if ((Points = malloc(N_TDRY_BULB * N_REL_HUM * N_PRESSURE * sizeof(struct Point))) == NULL)
+    Fail("Out of memory");
+  for (k = 0; k < N_PRESSURE; k++)
+  {
+    Altitude = (k < 4 ? 1000. * k : 5000.) * (isIP() ? 1. / 0.3048 : 1.);
+    for (i = 0; i < N_TDRY_BULB; i++)
+      for (j = 0; j < N_REL_HUM; j++)
+      {
+        p.TDryBulb = TLow + (THigh - TLow) * i / (N_TDRY_BULB - 1);
+        p.RelHum = j == 0 ? 0.01 : (double) j / (N_REL_HUM - 1);
+        p.Pressure = GetStandardAtmPressure(Altitude);
+        p.VapPres = (double) (p.RelHum * ReferenceGetSatVapPres(p.TDryBulb));
+        if (p.VapPres > 0.9 * p.Pressure
+          || !(ReferenceGetTDewPointFromVapPres(p.TDryBulb, p.VapPres) >= TLow + (isIP() ? 0.9 : 0.5)))
+          continue;
+        p.HumRatio = (double) ReferenceGetHumRatioFromRelHum(p.TDryBulb, p.RelHum, p.Pressure);
+        p.TWetBulb = (double) ReferenceGetTWetBulbFromHumRatio(p.TDryBulb, p.HumRatio, p.Pressure);
+        p.MoistAirEnthalpy = (double) ReferenceGetMoistAirEnthalpy(p.TDryBulb, p.HumRatio);
+        p.BelowBoiling = ReferenceGetSatVapPres(p.TDryBulb) < p.Pressure;
+        Points[N++] = p;
+      }
+  }
+  Values = malloc(N * sizeof(double));
+  Errors = malloc(N * sizeof(double));
+  Selected = malloc(N * sizeof(size_t));
+  if (Values == NULL || Errors == NULL || Selected == NULL)
+    Fail("Out of memory");
+  for (f = 0; f < N_FUNCTIONS; f++)
+  {
+    if ((Reference[f] = malloc(N * sizeof(PsychroRefReal))) == NULL)
+      Fail("Out of memory");
+    for (k = 0; k < N; k++)
+      Reference[f][k] = ReferenceValue(f, &Points[k]);
+  }
+
+  // Tables over the temperatures and pressures of the grid
+  for (b = TRILINEAR_COARSE; b < N_BACKENDS; b++)
+  {
+    c = b == TRILINEAR_FINE || b == CUBIC_FINE;
+    Config.TDryBulb = (struct PsychroTableAxis) { TLow, THigh, TABLE_NODES[c][0] };
+    Config.HumRatio = (struct PsychroTableAxis) { 0., TABLE_MAX_HUM_RATIO, TABLE_NODES[c][1] };
+    Config.Pressure = (struct PsychroTableAxis) { GetStandardAtmPressure(5000. * (isIP() ? 1. / 0.3048 : 1.)),
+      GetStandardAtmPressure(0.), N_PRESSURE };
+    Config.Properties = 1 << PSYCHRO_TABLE_MOIST_AIR_ENTHALPY | 1 << PSYCHRO_TABLE_MOIST_AIR_VOLUME
+      | 1 << PSYCHRO_TABLE_TWET_BULB | 1 << PSYCHRO_TABLE_TDEW_POINT;
+    Config.Interpolation = b < CUBIC_COARSE ? PSYCHRO_TABLE_TRILINEAR : PSYCHRO_TABLE_CUBIC;
+    Config.Tolerance[PSYCHRO_TABLE_MOIST_AIR_ENTHALPY] = TOLERANCES[isIP()][MOIST_AIR_ENTHALPY];
+    Config.Tolerance[PSYCHRO_TABLE_MOIST_AIR_VOLUME] = TOLERANCES[isIP()][MOIST_AIR_VOLUME];
+    Config.Tolerance[PSYCHRO_TABLE_TWET_BULB] = TOLERANCES[isIP()][TWET_BULB_FROM_HUM_RATIO];
+    Config.Tolerance[PSYCHRO_TABLE_TDEW_POINT] = TOLERANCES[isIP()][TDEW_POINT_FROM_HUM_RATIO];
+    if ((Tables[b] = PsychroTableCreate(&Config)) == NULL)
+      Fail("Cannot create table");
+  }
+
+  for (f = 0; f < N_FUNCTIONS; f++)
+    for (b = 0; b < N_BACKENDS; b++)
+      if (Implements(b, f))
+        Rows[f][b] = Measure(b, f, MinTime);
+
+  printf("Error against the %s reference functions over %zu points of the range of the equations, "
+    "tables on the %zu points with humidity ratios up to %g.\n\n",
+    sizeof(PsychroRefReal) > sizeof(double) ? "extended-precision" : "double-precision", N,
+    Rows[MOIST_AIR_ENTHALPY][TRILINEAR_COARSE].Points, TABLE_MAX_HUM_RATIO);
+  printf("| Function | Implementation | Max abs error | Below boiling point | Tolerance | 99th percentile abs error | Max rel error | Failures | Time per call (ns) | Pareto optimal |\n");
+  printf("|---|---|---:|---:|---:|---:|---:|---:|---:|---|\n");
+  for (f = 0; f < N_FUNCTIONS; f++)
+    for (b = 0; b < N_BACKENDS; b++)
+    {
+      struct Row *r = &Rows[f][b];
+      double Tolerance = TOLERANCES[isIP()][f];
+      int Optimal, o;
+      char Rel[32];
+
+      if (!Implements(b, f))
+        continue;
+      Optimal = r->MaxAbsErrorBelowBoiling <= Tolerance;
+      for (o = 0; o < N_BACKENDS; o++)
+      {
+        struct Row *s = &Rows[f][o];
+        if (o != b && Implements(o, f) && s->MaxAbsErrorBelowBoiling <= Tolerance && s->Failures <= r->Failures
+          && s->MaxAbsErrorBelowBoiling <= r->MaxAbsErrorBelowBoiling && s->Time <= r->Time
+          && (s->MaxAbsErrorBelowBoiling < r->MaxAbsErrorBelowBoiling || s->Time < r->Time))
+          Optimal = 0;
+      }
+      if (IS_TEMPERATURE[f])
+        strcpy(Rel, "-");
+      else
+        sprintf(Rel, "%.1e", r->MaxRelError);
+      printf("| %s | %s | %.1e | %.1e | %.1e | %.1e | %s | %zu | %.0f | %s |\n", FUNCTION_NAMES[f], BACKEND_NAMES[b],
+        r->MaxAbsError, r->MaxAbsErrorBelowBoiling, Tolerance, r->Percentile99, Rel, r->Failures, r->Time,
+        Optimal ? "yes" : "");
+    }
+
+  for (b = TRILINEAR_COARSE; b < N_BACKENDS; b++)
+    PsychroTableDestroy(Tables[b]);
+  for (f = 0; f < N_FUNCTIONS; f++)
+    free(Reference[f]);
+  free(Points);
+  free(Values);
+  free(Errors);
+  free(Selected);
+  return EXIT_SUCCESS;
+}
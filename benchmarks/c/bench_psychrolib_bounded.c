@@ -0,0 +1,200 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Worst-case execution time of the bounded-latency functions, run by benchmarks/run_benchmarks.py.
+ * The points are the rows of the corpus, a grid over the range of validity of the equations at
+ * standard pressure, and points in the band where the wet-bulb temperature has a solution on each
+ * side of the freezing point. The time of each point is the fastest of TRIALS runs of REPEATS
+ * calls, which removes the interruptions of the system but not the effect of the data; the maximum
+ * over the points is the measured WCET. Prints a Markdown table.
+ * Usage: bench_psychrolib_bounded <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_bounded.h"
+
+#define N_FUNCTIONS 8
+
+#define TRIALS 5
+
+#define REPEATS 16
+
+static const char *FUNCTION_NAMES[N_FUNCTIONS] =
+{
+  "GetSatVapPres", "GetHumRatioFromTWetBulb", "GetTDewPointFromHumRatio", "GetTWetBulbFromHumRatio",
+  "GetTWetBulbFromRelHum", "CalcPsychrometricsFromTWetBulb", "CalcPsychrometricsFromTDewPoint",
+  "CalcPsychrometricsFromRelHum"
+};
+
+// Operation count from psychrolib_bounded.c, outside the band of two wet-bulb temperatures
+static const char *OPERATION_COUNTS[N_FUNCTIONS] =
+{
+  "1 log, 1 exp", "1 log, 1 exp", "5 log", "15 log, 1 exp", "16 log, 2 exp", "7 log, 2 exp",
+  "17 log, 3 exp", "21 log, 2 exp"
+};
+
+struct Point
+{
+  double TDryBulb, RelHum, Pressure, HumRatio, TWetBulb, TDewPoint;
+};
+
+static struct Point *Points;
+static size_t N, Capacity;
+static volatile double Sink;
+
+static void AddPoint(double TDryBulb, double RelHum, double Pressure)
+{
+  struct Point *p;
+
+  if (N == Capacity)
+  {
+    Capacity = Capacity == 0 ? 1024 : 2 * Capacity;
+    Points = Reallocate(Points, Capacity * sizeof(struct Point));
+  }
+  p = &Points[N++];
+  p->TDryBulb = TDryBulb;
+  p->RelHum = RelHum;
+  p->Pressure = Pressure;
+  p->HumRatio = GetHumRatioFromRelHum(TDryBulb, RelHum, Pressure);
+  p->TWetBulb = GetTWetBulbFromHumRatio(TDryBulb, p->HumRatio, Pressure);
+  p->TDewPoint = GetTDewPointFromHumRatio(TDryBulb, p->HumRatio, Pressure);
+}
+
+// Evaluate function f on point p with the generic functions, return the first output
+static double Generic(int f, const struct Point *p)
+{
+  double o[7];
+
+  switch (f)
+  {
+    case 0: return GetSatVapPres(p->TDryBulb);
+    case 1: return GetHumRatioFromTWetBulb(p->TDryBulb, p->TWetBulb, p->Pressure);
+    case 2: return GetTDewPointFromHumRatio(p->TDryBulb, p->HumRatio, p->Pressure);
+    case 3: return GetTWetBulbFromHumRatio(p->TDryBulb, p->HumRatio, p->Pressure);
+    case 4: return GetTWetBulbFromRelHum(p->TDryBulb, p->RelHum, p->Pressure);
+    case 5: CalcPsychrometricsFromTWetBulb(p->TDryBulb, p->TWetBulb, p->Pressure, &o[0], &o[1], &o[2], &o[3],
+      &o[4], &o[5], &o[6]); return o[0];
+    case 6: CalcPsychrometricsFromTDewPoint(p->TDryBulb, p->TDewPoint, p->Pressure, &o[0], &o[1], &o[2], &o[3],
+      &o[4], &o[5], &o[6]); return o[1];
+    default: CalcPsychrometricsFromRelHum(p->TDryBulb, p->RelHum, p->Pressure, &o[0], &o[1], &o[2], &o[3],
+      &o[4], &o[5], &o[6]); return o[1];
+  }
+}
+
+// Evaluate function f on point p with the bounded-latency functions, return the first output
+static double Bounded(int f, const struct Point *p, enum PsychroStatus *Status)
+{
+  double o[7];
+
+  switch (f)
+  {
+    case 0: *Status = BoundedGetSatVapPres(p->TDryBulb, &o[0]); break;
+    case 1: *Status = BoundedGetHumRatioFromTWetBulb(p->TDryBulb, p->TWetBulb, p->Pressure, &o[0]); break;
+    case 2: *Status = BoundedGetTDewPointFromHumRatio(p->TDryBulb, p->HumRatio, p->Pressure, &o[0]); break;
+    case 3: *Status = BoundedGetTWetBulbFromHumRatio(p->TDryBulb, p->HumRatio, p->Pressure, &o[0]); break;
+    case 4: *Status = BoundedGetTWetBulbFromRelHum(p->TDryBulb, p->RelHum, p->Pressure, &o[0]); break;
+    case 5: *Status = BoundedCalcPsychrometricsFromTWetBulb(p->TDryBulb, p->TWetBulb, p->Pressure, &o[0], &o[1],
+      &o[2], &o[3], &o[4], &o[5], &o[6]); break;
+    case 6: *Status = BoundedCalcPsychrometricsFromTDewPoint(p->TDryBulb, p->TDewPoint, p->Pressure, &o[1], &o[0],
+      &o[2], &o[3], &o[4], &o[5], &o[6]); break;
+    default: *Status = BoundedCalcPsychrometricsFromRelHum(p->TDryBulb, p->RelHum, p->Pressure, &o[2], &o[0],
+      &o[1], &o[3], &o[4], &o[5], &o[6]);
+  }
+  return o[0];
+}
+
+// Time of one call of function f on point p in ns, the fastest of TRIALS runs
+static double Time(int f, const struct Point *p, int IsBounded)
+{
+  enum PsychroStatus Status;
+  double Start, Best = HUGE_VAL;
+  int t, r;
+
+  for (t = 0; t < TRIALS; t++)
+  {
+    Start = Now();
+    for (r = 0; r < REPEATS; r++)
+      Sink = IsBounded ? Bounded(f, p, &Status) : Generic(f, p);
+    Best = fmin(Best, Now() - Start);
+  }
+  return 1e9 * Best / REPEATS;
+}
+
+int main(int argc, char *argv[])
+{
+  double *Corpus, TMin, TMax, FreezingPoint, Pressure, T, WLiquid, WIce, Deviation, t;
+  double GenericMean, GenericMax, BoundedMean, BoundedMax;
+  static const double RELHUMS[] = { 1e-6, 1e-3, 0.05, 0.5, 1. };
+  size_t i, k, NCorpus, NNotConverged;
+  enum PsychroStatus Status;
+  int f;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+  TMin = isIP() ? -148. : -100.;
+  TMax = isIP() ? 392. : 200.;
+  FreezingPoint = isIP() ? 32. : 0.;
+
+  Corpus = ReadCorpus(argv[2], &NCorpus);
+  for (i = 0; i < NCorpus; i++)
+    AddPoint(Corpus[i * CORPUS_COLUMNS], Corpus[i * CORPUS_COLUMNS + 1], Corpus[i * CORPUS_COLUMNS + 2]);
+  free(Corpus);
+
+  // Grid over the range of validity, below the boiling point
+  Pressure = GetStandardAtmPressure(0.);
+  for (i = 0; i <= 100; i++)
+  {
+    T = TMin + (TMax - TMin) * i / 100.;
+    for (k = 0; k < sizeof RELHUMS / sizeof RELHUMS[0]; k++)
+      if (GetSatVapPres(T) < 0.9 * Pressure && GetVapPresFromRelHum(T, RELHUMS[k]) > GetSatVapPres(TMin))
+        AddPoint(T, RELHUMS[k], Pressure);
+  }
+
+  // Band of two wet-bulb temperatures: humidity ratio between the limits of ASHRAE eqn. 33 and 35
+  for (i = 1; i <= 20; i++)
+  {
+    T = FreezingPoint + (isIP() ? 1.8 : 1.) * i;
+    WLiquid = GetHumRatioFromTWetBulb(T, FreezingPoint, Pressure);
+    WIce = GetHumRatioFromTWetBulb(T, nextafter(FreezingPoint, TMin), Pressure);
+    AddPoint(T, GetRelHumFromHumRatio(T, (WLiquid + WIce) / 2., Pressure), Pressure);
+  }
+
+  printf("Bounded-latency functions on %zu points: %zu rows of the corpus, %zu points of a grid and of the "
+    "band of two wet-bulb temperatures.\n\n", N, NCorpus, N - NCorpus);
+  printf("| Function | Operations | Generic mean (ns) | Generic max (ns) | Bounded mean (ns) | Bounded WCET (ns) "
+    "| Not converged | Max deviation |\n");
+  printf("|---|---|---:|---:|---:|---:|---:|---:|\n");
+  for (f = 0; f < N_FUNCTIONS; f++)
+  {
+    GenericMean = GenericMax = BoundedMean = BoundedMax = Deviation = 0.;
+    NNotConverged = 0;
+    for (i = 0; i < N; i++)
+    {
+      Deviation = fmax(Deviation, fabs(Bounded(f, &Points[i], &Status) - Generic(f, &Points[i])));
+      NNotConverged += Status != PSYCHRO_STATUS_OK;
+
+      t = Time(f, &Points[i], 0);
+      GenericMean += t / N;
+      GenericMax = fmax(GenericMax, t);
+      t = Time(f, &Points[i], 1);
+      BoundedMean += t / N;
+      BoundedMax = fmax(BoundedMax, t);
+    }
+    printf("| %s | %s | %.1f | %.1f | %.1f | %.1f | %zu | %.2e |\n", FUNCTION_NAMES[f], OPERATION_COUNTS[f],
+      GenericMean, GenericMax, BoundedMean, BoundedMax, NNotConverged, Deviation);
+  }
+
+  free(Points);
+  return EXIT_SUCCESS;
+}
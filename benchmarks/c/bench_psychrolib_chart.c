@@ -0,0 +1,185 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Time per redraw of a psychrometric chart at the standard pressure with 10 relative humidity, 9
+ * wet-bulb, 10 enthalpy, 6 specific volume and 9 dew-point isolines: isolines sampled point by
+ * point at 1000 dry-bulb temperatures across the viewport, against the chart geometry of
+ * psychrolib_chart.c built without cached tiles, then panned by 10% of the viewport back and forth
+ * and zoomed by a factor of 2 in and out with the cached tiles. The corpus is not used. Prints a
+ * Markdown table.
+ * Usage: bench_psychrolib_chart <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_chart.h"
+
+#define N_SAMPLES 1000
+#define N_CONFIGS 4
+
+static double Pressure, Values[PSYCHRO_CHART_N_FAMILIES][10];
+static struct PsychroChartLines Lines;
+static struct PsychroChartViewport Viewports[2][2];
+static PsychroChart *Chart;
+static size_t Redraws, NPoints[N_CONFIGS], Config;
+static float Samples[2 * N_SAMPLES];
+
+static double HumRatio(int Family, double Value, double TDryBulb)
+{
+  double Volume0;
+
+  switch (Family)
+  {
+  case PSYCHRO_CHART_REL_HUM:
+    return GetHumRatioFromRelHum(TDryBulb, Value, Pressure);
+  case PSYCHRO_CHART_TWET_BULB:
+    return TDryBulb >= Value ? GetHumRatioFromTWetBulb(TDryBulb, Value, Pressure) : -1.;
+  case PSYCHRO_CHART_MOIST_AIR_ENTHALPY:
+    return GetHumRatioFromEnthalpyAndTDryBulb(Value, TDryBulb);
+  case PSYCHRO_CHART_MOIST_AIR_VOLUME:
+    Volume0 = GetMoistAirVolume(TDryBulb, 0., Pressure);
+    return (Value - Volume0) / (GetMoistAirVolume(TDryBulb, 1., Pressure) - Volume0);
+  default:
+    return TDryBulb >= Value ? GetHumRatioFromTDewPoint(Value, Pressure) : -1.;
+  }
+}
+
+// Each isoline at N_SAMPLES dry-bulb temperatures, kept below saturation and within the viewport
+static void PointByPoint(void)
+{
+  const struct PsychroChartViewport *v = &Viewports[0][0];
+  size_t Line, n, Count = 0;
+  double T, W;
+  int Family, i;
+
+  for (Family = 0; Family < PSYCHRO_CHART_N_FAMILIES; Family++)
+    for (Line = 0; Line < Lines.Counts[Family]; Line++)
+    {
+      for (i = 0, n = 0; i < N_SAMPLES; i++)
+      {
+        T = v->TDryBulbMin + (v->TDryBulbMax - v->TDryBulbMin) * i / (N_SAMPLES - 1);
+        W = HumRatio(Family, Values[Family][Line], T);
+        if (W > 0. && W >= v->HumRatioMin && W <= v->HumRatioMax && W <= GetSatHumRatio(T, Pressure))
+        {
+          Samples[2 * n] = (float) T;
+          Samples[2 * n + 1] = (float) W;
+          n++;
+        }
+      }
+      Count += n;
+    }
+  NPoints[Config] = Count;
+}
+
+static void Build(const struct PsychroChartViewport *Viewport)
+{
+  struct PsychroChartGeometry Geometry;
+
+  if (PsychroChartBuild(Chart, Pressure, Viewport, &Lines, &Geometry) != 0)
+  {
+    fprintf(stderr, "Chart build failed\n");
+    exit(EXIT_FAILURE);
+  }
+  NPoints[Config] = Geometry.NPoints;
+}
+
+static void FirstBuild(void)
+{
+  Chart = PsychroChartCreate(0., 0);
+  Build(&Viewports[0][0]);
+  PsychroChartDestroy(Chart);
+}
+
+static void Pan(void)
+{
+  Build(&Viewports[0][Redraws++ % 2]);
+}
+
+static void Zoom(void)
+{
+  Build(&Viewports[1][Redraws++ % 2]);
+}
+
+// Time per redraw in ms, doubling the passes until the minimum time is reached
+static double Time(void (*Run)(void), double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run();
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e3 * Elapsed / Passes;
+    Passes *= 2;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  static const char *NAMES[N_CONFIGS] = { "Point by point, 1000 samples per isoline", "Chart geometry, first build",
+    "Chart geometry, pan by 10%", "Chart geometry, zoom by 2" };
+  static void (*const RUNS[N_CONFIGS])(void) = { PointByPoint, FirstBuild, Pan, Zoom };
+  double Times[N_CONFIGS], MinTime;
+  int IP_ = 0, Family, i;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  IP_ = strcmp(argv[1], "IP") == 0;
+  SetUnitSystem(IP_ ? IP : SI);
+  Pressure = IP_ ? 14.696 : 101325.;
+  MinTime = atof(argv[3]);
+
+  for (i = 0; i < 10; i++)
+  {
+    Values[PSYCHRO_CHART_REL_HUM][i] = 0.1 * (i + 1);
+    Values[PSYCHRO_CHART_TWET_BULB][i] = IP_ ? 35. + 10. * i : 0. + 5. * i;
+    Values[PSYCHRO_CHART_MOIST_AIR_ENTHALPY][i] = IP_ ? 10. + 5. * i : 10000. + 10000. * i;
+    Values[PSYCHRO_CHART_MOIST_AIR_VOLUME][i] = IP_ ? 12.5 + 0.5 * i : 0.78 + 0.02 * i;
+    Values[PSYCHRO_CHART_TDEW_POINT][i] = IP_ ? 30. + 10. * i : -5. + 5. * i;
+  }
+  for (Family = 0; Family < PSYCHRO_CHART_N_FAMILIES; Family++)
+    Lines.Values[Family] = Values[Family];
+  Lines.Counts[PSYCHRO_CHART_REL_HUM] = 10;
+  Lines.Counts[PSYCHRO_CHART_TWET_BULB] = 9;
+  Lines.Counts[PSYCHRO_CHART_MOIST_AIR_ENTHALPY] = 10;
+  Lines.Counts[PSYCHRO_CHART_MOIST_AIR_VOLUME] = 6;
+  Lines.Counts[PSYCHRO_CHART_TDEW_POINT] = 9;
+
+  Viewports[0][0].TDryBulbMin = IP_ ? 20. : -5.;
+  Viewports[0][0].TDryBulbMax = IP_ ? 120. : 50.;
+  Viewports[0][0].HumRatioMax = 0.03;
+  Viewports[0][1] = Viewports[0][0];
+  Viewports[0][1].TDryBulbMin += 0.1 * (Viewports[0][0].TDryBulbMax - Viewports[0][0].TDryBulbMin);
+  Viewports[0][1].TDryBulbMax += 0.1 * (Viewports[0][0].TDryBulbMax - Viewports[0][0].TDryBulbMin);
+  Viewports[1][0] = Viewports[0][0];
+  Viewports[1][1] = Viewports[0][0];
+  Viewports[1][1].TDryBulbMax = 0.5 * (Viewports[0][0].TDryBulbMin + Viewports[0][0].TDryBulbMax);
+  Viewports[1][1].HumRatioMax = 0.015;
+
+  for (Config = 0; Config < N_CONFIGS; Config++)
+  {
+    if (Config == 2)
+      Chart = PsychroChartCreate(0., 0);
+    Times[Config] = Time(RUNS[Config], MinTime);
+  }
+  PsychroChartDestroy(Chart);
+
+  printf("Redraw of a chart of 44 isolines at the standard pressure, tolerance of 1e-3 of the viewport.\n\n");
+  printf("| Configuration | Time per redraw (ms) | Speedup | Points |\n");
+  printf("|---|---:|---:|---:|\n");
+  for (Config = 0; Config < N_CONFIGS; Config++)
+    printf("| %s | %.3f | %.1f | %zu |\n", NAMES[Config], Times[Config], Times[0] / Times[Config], NPoints[Config]);
+  return EXIT_SUCCESS;
+}
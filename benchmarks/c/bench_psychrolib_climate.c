@@ -0,0 +1,173 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Time per record of the design conditions of 10 years of hourly records (87600 records cycling
+ * through the points of the corpus, with the dew point calculated from the humidity ratio): the
+ * properties of all records calculated with CalcPsychrometricsFromTDewPoint, stored and sorted,
+ * against the streaming statistics of the default configuration, in the calling thread and in 4
+ * threads. Also prints the memory of each approach, and the maximum deviation of the streaming
+ * quantiles from the sorted ones at the 0.4%, 1%, 2%, 98%, 99% and 99.6% cumulative frequencies.
+ * Prints a Markdown table. Usage: bench_psychrolib_climate <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_climate.h"
+
+#define N_RECORDS 87600
+#define N_PROBABILITIES 6
+
+static const char *VARIABLE_NAMES[PSYCHRO_CLIMATE_N_VARIABLES] =
+{
+  "TDryBulb", "TWetBulb", "TDewPoint", "HumRatio", "MoistAirEnthalpy"
+};
+
+static const double PROBABILITIES[N_PROBABILITIES] = { 0.004, 0.01, 0.02, 0.98, 0.99, 0.996 };
+
+static double *TDryBulb, *TDewPoint, *Pressure, *Values[PSYCHRO_CLIMATE_N_VARIABLES];
+static double Quantiles[2][PSYCHRO_CLIMATE_N_VARIABLES][N_PROBABILITIES];
+static struct PsychroClimateConfig Config;
+
+static int Compare(const void *a, const void *b)
+{
+  double x = *(const double *) a, y = *(const double *) b;
+  return (x > y) - (x < y);
+}
+
+// Properties of all records, stored and sorted
+static void Sorted(unsigned Threads)
+{
+  double HumRatio, TWetBulb, RelHum, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation;
+  size_t i;
+  int k, p;
+
+  (void) Threads;
+  for (i = 0; i < N_RECORDS; i++)
+  {
+    CalcPsychrometricsFromTDewPoint(TDryBulb[i], TDewPoint[i], Pressure[i], &HumRatio, &TWetBulb, &RelHum,
+      &VapPres, &MoistAirEnthalpy, &MoistAirVolume, &DegreeOfSaturation);
+    Values[PSYCHRO_CLIMATE_TDRY_BULB][i] = TDryBulb[i];
+    Values[PSYCHRO_CLIMATE_TWET_BULB][i] = TWetBulb;
+    Values[PSYCHRO_CLIMATE_TDEW_POINT][i] = TDewPoint[i];
+    Values[PSYCHRO_CLIMATE_HUM_RATIO][i] = HumRatio;
+    Values[PSYCHRO_CLIMATE_MOIST_AIR_ENTHALPY][i] = MoistAirEnthalpy;
+  }
+  for (k = 0; k < PSYCHRO_CLIMATE_N_VARIABLES; k++)
+  {
+    qsort(Values[k], N_RECORDS, sizeof(double), Compare);
+    for (p = 0; p < N_PROBABILITIES; p++)
+      Quantiles[0][k][p] = Values[k][(size_t) (PROBABILITIES[p] * (N_RECORDS - 1))];
+  }
+}
+
+// Streaming statistics of all records
+static void Streaming(unsigned Threads)
+{
+  PsychroClimate *Stats = PsychroClimateCreate(&Config);
+  int k, p;
+
+  PsychroClimateAdd(Stats, N_RECORDS, TDryBulb, TDewPoint, Pressure, Threads);
+  for (k = 0; k < PSYCHRO_CLIMATE_N_VARIABLES; k++)
+    for (p = 0; p < N_PROBABILITIES; p++)
+      Quantiles[1][k][p] = PsychroClimateGetQuantile(Stats, k, PROBABILITIES[p]);
+  PsychroClimateDestroy(Stats);
+}
+
+// Time per record in ns, doubling the passes until the minimum time is reached
+static double Time(void (*Run)(unsigned), unsigned Threads, double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run(Threads);
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e9 * Elapsed / ((double) Passes * N_RECORDS);
+    Passes *= 2;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  const double *Row;
+  double *Corpus, *CorpusT, *CorpusTDew, *CorpusP, SortedTime, Time1, Time4, Deviation;
+  size_t i, N = 0, SketchBytes, NRows, r;
+  int k, p;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+
+  Corpus = ReadCorpus(argv[2], &NRows);
+  CorpusT = Allocate(NRows * sizeof(double));
+  CorpusTDew = Allocate(NRows * sizeof(double));
+  CorpusP = Allocate(NRows * sizeof(double));
+  for (r = 0; r < NRows; r++)
+  {
+    Row = &Corpus[r * CORPUS_COLUMNS];
+    CorpusT[N] = Row[0];
+    CorpusTDew[N] = GetTDewPointFromHumRatio(Row[0], Row[4], Row[2]);
+    CorpusP[N] = Row[2];
+    N++;
+  }
+  free(Corpus);
+
+  TDryBulb = malloc(N_RECORDS * sizeof(double));
+  TDewPoint = malloc(N_RECORDS * sizeof(double));
+  Pressure = malloc(N_RECORDS * sizeof(double));
+  for (k = 0; k < PSYCHRO_CLIMATE_N_VARIABLES; k++)
+    Values[k] = malloc(N_RECORDS * sizeof(double));
+  for (i = 0; i < N_RECORDS; i++)
+  {
+    TDryBulb[i] = CorpusT[i % N];
+    TDewPoint[i] = CorpusTDew[i % N];
+    Pressure[i] = CorpusP[i % N];
+  }
+  PsychroClimateGetDefaultConfig(&Config);
+  SketchBytes = Config.TDryBulb.Count * Config.HumRatio.Count * sizeof(uint64_t);
+  for (k = 0; k < PSYCHRO_CLIMATE_N_VARIABLES; k++)
+    SketchBytes += (Config.Quantiles[k].Count + 2) * sizeof(uint64_t);
+
+  SortedTime = Time(Sorted, 1, atof(argv[3]));
+  Time1 = Time(Streaming, 1, atof(argv[3]));
+  Time4 = Time(Streaming, 4, atof(argv[3]));
+
+  printf("Design conditions of %d hourly records.\n\n", N_RECORDS);
+  printf("| Approach | Time per record (ns) | Speedup | Memory (KB) |\n");
+  printf("|---|---:|---:|---:|\n");
+  printf("| Stored and sorted | %.1f | 1.0 | %.0f |\n", SortedTime,
+    PSYCHRO_CLIMATE_N_VARIABLES * N_RECORDS * sizeof(double) / 1024.);
+  printf("| Streaming, 1 thread | %.1f | %.2f | %.0f |\n", Time1, SortedTime / Time1, SketchBytes / 1024.);
+  printf("| Streaming, 4 threads | %.1f | %.2f | %.0f |\n\n", Time4, SortedTime / Time4, 4 * SketchBytes / 1024.);
+  printf("| Variable | Max deviation of the design quantiles |\n");
+  printf("|---|---:|\n");
+  for (k = 0; k < PSYCHRO_CLIMATE_N_VARIABLES; k++)
+  {
+    Deviation = 0.;
+    for (p = 0; p < N_PROBABILITIES; p++)
+      Deviation = fmax(Deviation, fabs(Quantiles[1][k][p] - Quantiles[0][k][p]));
+    printf("| %s | %.2e |\n", VARIABLE_NAMES[k], Deviation);
+  }
+
+  for (k = 0; k < PSYCHRO_CLIMATE_N_VARIABLES; k++)
+    free(Values[k]);
+  free(CorpusT);
+  free(CorpusTDew);
+  free(CorpusP);
+  free(TDryBulb);
+  free(TDewPoint);
+  free(Pressure);
+  return EXIT_SUCCESS;
+}
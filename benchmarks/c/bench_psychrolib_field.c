@@ -0,0 +1,168 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Time per point of the wet-bulb temperature, relative humidity and enthalpy fields of single
+ * precision dry-bulb temperature, dew-point temperature and pressure fields of 2^20 points, made of
+ * the corpus repeated and written next to it: the fields read whole into memory, calculated with
+ * BoundedCalcPsychrometricsFromTDewPoint and written, against the tiled processing of the mapped
+ * files of psychrolib_field.c with 1 to 4 threads. Also prints the memory of the fields or tiles.
+ * Prints a Markdown table.
+ * Usage: bench_psychrolib_field <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_bounded.h"
+#include "psychrolib_field.h"
+
+#define N_POINTS (1 << 20)
+#define N_CORPUS 20000
+#define N_CONFIGS 3
+
+static const unsigned THREADS[N_CONFIGS] = { 1, 2, 4 };
+
+static char Paths[6][1100];
+static struct PsychroFieldConfig Config;
+static size_t Memory[N_CONFIGS + 1];
+static int Current;
+
+static void Fail(const char *Message)
+{
+  fprintf(stderr, "%s\n", Message);
+  exit(EXIT_FAILURE);
+}
+
+// Whole fields read into memory, calculated and written
+static void InMemory(void)
+{
+  float *Fields[6];
+  double HumRatio, Out[3], VapPres, Volume, DegreeOfSaturation;
+  size_t i;
+  int k;
+  FILE *fp;
+
+  for (k = 0; k < 6; k++)
+    if ((Fields[k] = malloc(N_POINTS * sizeof(float))) == NULL)
+      Fail("Out of memory");
+  for (k = 0; k < 3; k++)
+    if ((fp = fopen(Paths[k], "rb")) == NULL || fread(Fields[k], sizeof(float), N_POINTS, fp) != N_POINTS || fclose(fp) != 0)
+      Fail("Cannot read field");
+  for (i = 0; i < N_POINTS; i++)
+  {
+    if (BoundedCalcPsychrometricsFromTDewPoint(Fields[0][i], fmin(Fields[1][i], Fields[0][i]), Fields[2][i], &HumRatio,
+      &Out[0], &Out[1], &VapPres, &Out[2], &Volume, &DegreeOfSaturation) != PSYCHRO_STATUS_OK)
+      Out[0] = Out[1] = Out[2] = NAN;
+    for (k = 0; k < 3; k++)
+      Fields[3 + k][i] = (float) Out[k];
+  }
+  for (k = 3; k < 6; k++)
+    if ((fp = fopen(Paths[k], "wb")) == NULL || fwrite(Fields[k], sizeof(float), N_POINTS, fp) != N_POINTS || fclose(fp) != 0)
+      Fail("Cannot write field");
+  for (k = 0; k < 6; k++)
+    free(Fields[k]);
+  Memory[0] = 6 * N_POINTS * sizeof(float);
+}
+
+static void Tiled(void)
+{
+  struct PsychroFieldReport Report;
+
+  Config.Threads = THREADS[Current];
+  if (PsychroFieldProcess(&Config, &Report) != 0 || Report.Points != N_POINTS)
+    Fail("Field processing failed");
+  Memory[1 + Current] = Report.Memory;
+}
+
+// Time per point in ns, doubling the passes until the minimum time is reached
+static double Time(void (*Run)(void), double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run();
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e9 * Elapsed / ((double) Passes * N_POINTS);
+    Passes *= 2;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  static const char *NAMES[6] = { "tdb", "tdp", "p", "twb", "rh", "h" };
+  static const enum PsychroFieldOutput OUTPUTS[3] = { PSYCHRO_FIELD_TWET_BULB, PSYCHRO_FIELD_REL_HUM, PSYCHRO_FIELD_MOIST_AIR_ENTHALPY };
+  const double *Row;
+  double *Rows, Reference, Times[N_CONFIGS];
+  float *Corpus[3], Value;
+  size_t N = 0, i, NRows, r;
+  int k;
+  FILE *fp;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+  if (strlen(argv[2]) > 1000)
+    Fail("Corpus path too long");
+
+  for (k = 0; k < 3; k++)
+    if ((Corpus[k] = malloc(N_CORPUS * sizeof(float))) == NULL)
+      Fail("Out of memory");
+  Rows = ReadCorpus(argv[2], &NRows);
+  for (r = 0; r < NRows && N < N_CORPUS; r++)
+  {
+    Row = &Rows[r * CORPUS_COLUMNS];
+    Corpus[0][N] = (float) Row[0];
+    Corpus[1][N] = (float) GetTDewPointFromRelHum(Row[0], Row[1]);
+    Corpus[2][N] = (float) Row[2];
+    N++;
+  }
+  free(Rows);
+
+  // Fields of the corpus repeated, next to it
+  for (k = 0; k < 6; k++)
+    sprintf(Paths[k], "%s.%s.f32", argv[2], NAMES[k]);
+  for (k = 0; k < 3; k++)
+  {
+    if ((fp = fopen(Paths[k], "wb")) == NULL)
+      Fail("Cannot write field");
+    for (i = 0; i < N_POINTS; i++)
+    {
+      Value = Corpus[k][i % N];
+      fwrite(&Value, sizeof Value, 1, fp);
+    }
+    fclose(fp);
+    free(Corpus[k]);
+  }
+  Config.NPoints = N_POINTS;
+  for (k = 0; k < 3; k++)
+  {
+    Config.Inputs[k] = (struct PsychroFieldFile) { Paths[k], PSYCHRO_FIELD_FLOAT32, 0, 1., 0. };
+    Config.Outputs[OUTPUTS[k]] = (struct PsychroFieldFile) { Paths[3 + k], PSYCHRO_FIELD_FLOAT32, 0, 1., 0. };
+  }
+
+  Reference = Time(InMemory, atof(argv[3]));
+  for (Current = 0; Current < N_CONFIGS; Current++)
+    Times[Current] = Time(Tiled, atof(argv[3]));
+  for (k = 0; k < 6; k++)
+    remove(Paths[k]);
+
+  printf("Wet-bulb temperature, relative humidity and enthalpy fields of %d points, single precision files.\n\n", N_POINTS);
+  printf("| Configuration | Time per point (ns) | Speedup | Memory (KiB) |\n");
+  printf("|---|---:|---:|---:|\n");
+  printf("| Fields in memory | %.0f | 1.0 | %zu |\n", Reference, Memory[0] / 1024);
+  for (k = 0; k < N_CONFIGS; k++)
+    printf("| Mapped tiles, %u threads | %.0f | %.1f | %zu |\n", THREADS[k], Times[k], Reference / Times[k], Memory[1 + k] / 1024);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Time per point of CalcPsychrometricsFromRelHum on the corpus in batches, with the seven result
+ * arrays allocated and freed for each batch, and with a frame reused from one batch to the next
+ * with double and float columns. Run by benchmarks/run_benchmarks.py.
+ * Prints a Markdown table.
+ * Usage: bench_psychrolib_frame <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_frame.h"
+
+#define N_BATCH_SIZES 3
+
+static const size_t BATCH_SIZES[N_BATCH_SIZES] = { 100, 1000, 10000 };
+
+static size_t N, BatchSize;
+static double *TDryBulb, *RelHum, *Pressure;
+static PsychroFrame *Frame;
+
+// Calculate all the batches with result arrays allocated for each batch
+static void Allocated(int Float32)
+{
+  double *Out[7];
+  size_t First, n, i;
+  int k;
+
+  (void) Float32;
+  for (First = 0; First < N; First += n)
+  {
+    n = N - First < BatchSize ? N - First : BatchSize;
+    for (k = 0; k < 7; k++)
+      Out[k] = malloc(n * sizeof(double));
+    for (i = 0; i < n; i++)
+      CalcPsychrometricsFromRelHum(TDryBulb[First + i], RelHum[First + i], Pressure[First + i], &Out[0][i],
+        &Out[1][i], &Out[2][i], &Out[3][i], &Out[4][i], &Out[5][i], &Out[6][i]);
+    for (k = 0; k < 7; k++)
+      free(Out[k]);
+  }
+}
+
+// Calculate all the batches in the frame, with double or float columns
+static void Framed(int Float32)
+{
+  enum PsychroColumnType Type = Float32 ? PSYCHRO_COLUMN_FLOAT32 : PSYCHRO_COLUMN_FLOAT64;
+  const double *Inputs[3] = { TDryBulb, RelHum, Pressure };
+  static const enum PsychroColumn COLUMNS[3] = { PSYCHRO_COLUMN_TDRY_BULB, PSYCHRO_COLUMN_REL_HUM, PSYCHRO_COLUMN_PRESSURE };
+  size_t First, n, i;
+  void *Column;
+  int k;
+
+  for (First = 0; First < N; First += n)
+  {
+    n = N - First < BatchSize ? N - First : BatchSize;
+    PsychroFrameReset(Frame, n);
+    for (k = 0; k < 3; k++)
+    {
+      Column = PsychroFrameAddColumn(Frame, COLUMNS[k], Type);
+      if (Float32)
+        for (i = 0; i < n; i++)
+          ((float *) Column)[i] = (float) Inputs[k][First + i];
+      else
+        memcpy(Column, Inputs[k] + First, n * sizeof(double));
+    }
+    PsychroFrameCalcPsychrometrics(Frame, PSYCHRO_COLUMN_REL_HUM, Type, NULL);
+  }
+}
+
+// Time per point in ns, doubling the passes until the minimum time is reached
+static double Time(void (*Run)(int), int Float32, double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run(Float32);
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e9 * Elapsed / ((double) Passes * N);
+    Passes *= 2;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  const double *Row;
+  double *Corpus, AllocatedTime, DoubleTime, FloatTime;
+  size_t ArenaSize, NRows, r;
+  int b;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+
+  Corpus = ReadCorpus(argv[2], &NRows);
+  TDryBulb = Allocate(NRows * sizeof(double));
+  RelHum = Allocate(NRows * sizeof(double));
+  Pressure = Allocate(NRows * sizeof(double));
+  for (r = 0; r < NRows; r++)
+  {
+    Row = &Corpus[r * CORPUS_COLUMNS];
+    TDryBulb[N] = Row[0];
+    RelHum[N] = Row[1];
+    Pressure[N] = Row[2];
+    N++;
+  }
+  free(Corpus);
+
+  printf("CalcPsychrometricsFromRelHum in batches, %zu points. The arena is its size after the runs with double columns.\n\n", N);
+  printf("| Batch size | Allocated arrays (ns/point) | Frame, double (ns/point) | Frame, float (ns/point) | Speedup, double | Arena (KiB) |\n");
+  printf("|---:|---:|---:|---:|---:|---:|\n");
+  for (b = 0; b < N_BATCH_SIZES; b++)
+  {
+    BatchSize = BATCH_SIZES[b];
+    Frame = PsychroFrameCreate(0);
+    AllocatedTime = Time(Allocated, 0, atof(argv[3]));
+    DoubleTime = Time(Framed, 0, atof(argv[3]));
+    ArenaSize = PsychroFrameGetArenaSize(Frame);
+    FloatTime = Time(Framed, 1, atof(argv[3]));
+    PsychroFrameDestroy(Frame);
+    printf("| %zu | %.1f | %.1f | %.1f | %.2f | %.1f |\n", BatchSize, AllocatedTime, DoubleTime, FloatTime,
+      AllocatedTime / DoubleTime, ArenaSize / 1024.);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,196 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Cost of the value and gradient functions against forward finite differences of the generic
+ * functions, run by benchmarks/run_benchmarks.py. The finite differences take one more call of
+ * the generic function per input, with steps of 0.01 °C (0.018 °F), 0.001 of relative humidity,
+ * 0.1 % of humidity ratio and 0.01 % of pressure. The deviation is the median over the points and
+ * the nonzero partial derivatives of the relative difference between the two gradients, which
+ * is dominated by the tolerance of the solvers in the finite differences. Prints a Markdown table.
+ * Usage: bench_psychrolib_gradient <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_gradient.h"
+
+#define N_FUNCTIONS 5
+
+static const char *FUNCTION_NAMES[N_FUNCTIONS] =
+{
+  "GetHumRatioFromRelHum", "GetTDewPointFromHumRatio", "GetTWetBulbFromHumRatio", "GetTWetBulbFromRelHum",
+  "CalcPsychrometricsFromRelHum"
+};
+
+// Number of outputs of each function
+static const int N_OUTPUTS[N_FUNCTIONS] = { 1, 1, 1, 1, PSYCHRO_GRAD_N_OUTPUTS };
+
+#define BLOCK (PSYCHRO_GRAD_N_OUTPUTS * PSYCHRO_GRAD_N_INPUTS)
+
+static size_t N;
+static double *TDryBulb, *RelHum, *Pressure, *HumRatio, *Values, *Jacobian, *Reference;
+static double TStep;
+
+static int Compare(const void *a, const void *b)
+{
+  double x = *(const double *) a, y = *(const double *) b;
+  return (x > y) - (x < y);
+}
+
+// Evaluate the outputs of function f, given the humidity input of the function
+static void Evaluate(int f, double T, double Humidity, double P, double *Out)
+{
+  switch (f)
+  {
+    case 0: Out[0] = GetHumRatioFromRelHum(T, Humidity, P); break;
+    case 1: Out[0] = GetTDewPointFromHumRatio(T, Humidity, P); break;
+    case 2: Out[0] = GetTWetBulbFromHumRatio(T, Humidity, P); break;
+    case 3: Out[0] = GetTWetBulbFromRelHum(T, Humidity, P); break;
+    default: CalcPsychrometricsFromRelHum(T, Humidity, P, &Out[0], &Out[1], &Out[2], &Out[3], &Out[4],
+      &Out[5], &Out[6]);
+  }
+}
+
+// Evaluate function f and its Jacobian on all points with forward finite differences
+static void FiniteDifferences(int f)
+{
+  double Humidity, Step[3], Shifted[3], Base[PSYCHRO_GRAD_N_OUTPUTS], Out[PSYCHRO_GRAD_N_OUTPUTS];
+  int j, o, No = N_OUTPUTS[f];
+  size_t i;
+
+  for (i = 0; i < N; i++)
+  {
+    Humidity = f == 1 || f == 2 ? HumRatio[i] : RelHum[i];
+    Step[0] = TStep;
+    Step[1] = f == 1 || f == 2 ? 1e-3 * Humidity : (Humidity + 1e-3 > 1. ? -1e-3 : 1e-3);
+    Step[2] = 1e-4 * Pressure[i];
+    Evaluate(f, TDryBulb[i], Humidity, Pressure[i], Base);
+    for (j = 0; j < 3; j++)
+    {
+      Shifted[0] = TDryBulb[i];
+      Shifted[1] = Humidity;
+      Shifted[2] = Pressure[i];
+      Shifted[j] += Step[j];
+      Evaluate(f, Shifted[0], Shifted[1], Shifted[2], Out);
+      for (o = 0; o < No; o++)
+        Jacobian[i * BLOCK + o * 3 + j] = (Out[o] - Base[o]) / Step[j];
+    }
+    memcpy(&Values[i * PSYCHRO_GRAD_N_OUTPUTS], Base, No * sizeof(double));
+  }
+}
+
+// Evaluate function f and its Jacobian on all points with the value and gradient functions
+static void Analytic(int f)
+{
+  size_t i;
+
+  if (f == 4)
+  {
+    GradCalcPsychrometricsFromRelHum(N, TDryBulb, RelHum, Pressure, Values, Jacobian);
+    return;
+  }
+  for (i = 0; i < N; i++)
+    switch (f)
+    {
+      case 0: Values[i * PSYCHRO_GRAD_N_OUTPUTS] = GradGetHumRatioFromRelHum(TDryBulb[i], RelHum[i], Pressure[i],
+        &Jacobian[i * BLOCK]); break;
+      case 1: Values[i * PSYCHRO_GRAD_N_OUTPUTS] = GradGetTDewPointFromHumRatio(TDryBulb[i], HumRatio[i], Pressure[i],
+        &Jacobian[i * BLOCK]); break;
+      case 2: Values[i * PSYCHRO_GRAD_N_OUTPUTS] = GradGetTWetBulbFromHumRatio(TDryBulb[i], HumRatio[i], Pressure[i],
+        &Jacobian[i * BLOCK]); break;
+      default: Values[i * PSYCHRO_GRAD_N_OUTPUTS] = GradGetTWetBulbFromRelHum(TDryBulb[i], RelHum[i], Pressure[i],
+        &Jacobian[i * BLOCK]);
+    }
+}
+
+// Time per point in ns, doubling the passes until the minimum time is reached
+static double Time(void (*Run)(int), int f, double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run(f);
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e9 * Elapsed / ((double) Passes * N);
+    Passes *= 2;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  const double *Row;
+  double *Corpus, *Deviations, FiniteTime, AnalyticTime;
+  size_t i, k, NDeviations, NRows, r;
+  int f;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+  TStep = isIP() ? 0.018 : 0.01;
+
+  Corpus = ReadCorpus(argv[2], &NRows);
+  TDryBulb = Allocate(NRows * sizeof(double));
+  RelHum = Allocate(NRows * sizeof(double));
+  Pressure = Allocate(NRows * sizeof(double));
+  HumRatio = Allocate(NRows * sizeof(double));
+  for (r = 0; r < NRows; r++)
+  {
+    Row = &Corpus[r * CORPUS_COLUMNS];
+    TDryBulb[N] = Row[0];
+    RelHum[N] = Row[1];
+    Pressure[N] = Row[2];
+    HumRatio[N] = Row[4];
+    N++;
+  }
+  free(Corpus);
+
+  Values = malloc(N * PSYCHRO_GRAD_N_OUTPUTS * sizeof(double));
+  Jacobian = malloc(N * BLOCK * sizeof(double));
+  Reference = malloc(N * BLOCK * sizeof(double));
+  Deviations = malloc(N * BLOCK * sizeof(double));
+
+  printf("Analytic gradients against forward finite differences, %zu points of the corpus.\n\n", N);
+  printf("| Function | Finite differences (ns/point) | Analytic (ns/point) | Speedup | Median relative deviation |\n");
+  printf("|---|---:|---:|---:|---:|\n");
+  for (f = 0; f < N_FUNCTIONS; f++)
+  {
+    Analytic(f);
+    memcpy(Reference, Jacobian, N * BLOCK * sizeof(double));
+    FiniteDifferences(f);
+    NDeviations = 0;
+    for (i = 0; i < N; i++)
+      for (k = 0; k < (size_t) N_OUTPUTS[f] * 3; k++)
+        if (Reference[i * BLOCK + k] != 0.)
+          Deviations[NDeviations++] = fabs(Jacobian[i * BLOCK + k] / Reference[i * BLOCK + k] - 1.);
+    qsort(Deviations, NDeviations, sizeof(double), Compare);
+
+    FiniteTime = Time(FiniteDifferences, f, atof(argv[3]));
+    AnalyticTime = Time(Analytic, f, atof(argv[3]));
+    printf("| %s | %.1f | %.1f | %.1f | %.2e |\n", FUNCTION_NAMES[f], FiniteTime, AnalyticTime,
+      FiniteTime / AnalyticTime, NDeviations > 0 ? Deviations[NDeviations / 2] : 0.);
+  }
+
+  free(TDryBulb);
+  free(RelHum);
+  free(Pressure);
+  free(HumRatio);
+  free(Values);
+  free(Jacobian);
+  free(Reference);
+  free(Deviations);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Speedup of the header-only build of psychrolib_inline.h over the linked library, run by
+ * benchmarks/run_benchmarks.py. The same loops over the corpus are compiled in this file, where they
+ * call the functions of psychrolib.c, and in bench_psychrolib_inline_loops.c, where the functions are
+ * static inline, and with the check-free variants of psychrolib_inline.h, which are vectorized.
+ * Prints a Markdown table.
+ * Usage: bench_psychrolib_inline <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "bench_psychrolib_inline_loops.h"
+
+// Defined in bench_psychrolib_inline_loops.c
+void InlineSetUnitSystem(enum UnitSystem Units);
+void InlineLoops(int f, size_t N, const double *TDryBulb, const double *RelHum, const double *Pressure,
+  const double *HumRatio, const double *VapPres, double *Out);
+int UncheckedInlineLoops(int f, size_t N, const double *TDryBulb, const double *RelHum, const double *Pressure,
+  const double *HumRatio, const double *VapPres, double *Out);
+
+static const char *FUNCTION_NAMES[N_FUNCTIONS] =
+{
+  "GetMoistAirEnthalpy", "GetMoistAirVolume", "GetHumRatioFromVapPres", "GetVapPresFromHumRatio",
+  "GetSatVapPres", "GetHumRatioFromRelHum", "GetTDewPointFromHumRatio", "GetTWetBulbFromHumRatio"
+};
+
+static size_t N;
+static double *TDryBulb, *RelHum, *Pressure, *HumRatio, *VapPres, *Out;
+
+static void Linked(int f)
+{
+  Loops(f, N, TDryBulb, RelHum, Pressure, HumRatio, VapPres, Out);
+}
+
+static void Inline(int f)
+{
+  InlineLoops(f, N, TDryBulb, RelHum, Pressure, HumRatio, VapPres, Out);
+}
+
+static void Unchecked(int f)
+{
+  UncheckedInlineLoops(f, N, TDryBulb, RelHum, Pressure, HumRatio, VapPres, Out);
+}
+
+// Time per point in ns, doubling the passes until the minimum time is reached
+static double Time(void (*Run)(int), int f, double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run(f);
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e9 * Elapsed / ((double) Passes * N);
+    Passes *= 2;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  const double *Row;
+  double *Corpus, *Expected, LinkedTime, InlineTime, UncheckedTime, Deviation;
+  size_t i, NRows, r;
+  enum UnitSystem Units;
+  int f;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  Units = strcmp(argv[1], "IP") == 0 ? IP : SI;
+  SetUnitSystem(Units);
+  InlineSetUnitSystem(Units);
+
+  Corpus = ReadCorpus(argv[2], &NRows);
+  TDryBulb = Allocate(NRows * sizeof(double));
+  RelHum = Allocate(NRows * sizeof(double));
+  Pressure = Allocate(NRows * sizeof(double));
+  HumRatio = Allocate(NRows * sizeof(double));
+  for (r = 0; r < NRows; r++)
+  {
+    Row = &Corpus[r * CORPUS_COLUMNS];
+    TDryBulb[N] = Row[0];
+    RelHum[N] = Row[1];
+    Pressure[N] = Row[2];
+    HumRatio[N] = Row[4];
+    N++;
+  }
+  free(Corpus);
+
+  VapPres = malloc(N * sizeof(double));
+  Expected = malloc(N * sizeof(double));
+  Out = malloc(N * sizeof(double));
+  for (i = 0; i < N; i++)
+    VapPres[i] = GetVapPresFromHumRatio(HumRatio[i], Pressure[i]);
+
+  printf("Loops over %zu points of the corpus. The check-free variants are vectorized in blocks; "
+    "their deviation is relative.\n\n", N);
+  printf("| Function | Linked (ns/point) | Static inline (ns/point) | Speedup | Max deviation "
+    "| Check-free (ns/point) | Speedup | Max rel deviation |\n");
+  printf("|---|---:|---:|---:|---:|---:|---:|---:|\n");
+  for (f = 0; f < N_FUNCTIONS; f++)
+  {
+    Linked(f);
+    memcpy(Expected, Out, N * sizeof(double));
+    Inline(f);
+    Deviation = 0.;
+    for (i = 0; i < N; i++)
+      Deviation = fmax(Deviation, fabs(Out[i] - Expected[i]));
+
+    LinkedTime = Time(Linked, f, atof(argv[3]));
+    InlineTime = Time(Inline, f, atof(argv[3]));
+    printf("| %s | %.1f | %.1f | %.1f | %.2e ", FUNCTION_NAMES[f], LinkedTime, InlineTime,
+      LinkedTime / InlineTime, Deviation);
+
+    if (!UncheckedInlineLoops(f, N, TDryBulb, RelHum, Pressure, HumRatio, VapPres, Out))
+    {
+      printf("| - | - | - |\n");
+      continue;
+    }
+    Deviation = 0.;
+    for (i = 0; i < N; i++)
+      Deviation = fmax(Deviation, fabs(Out[i] - Expected[i]) / fmax(fabs(Expected[i]), 1.));
+    UncheckedTime = Time(Unchecked, f, atof(argv[3]));
+    printf("| %.1f | %.1f | %.2e |\n", UncheckedTime, LinkedTime / UncheckedTime, Deviation);
+  }
+
+  return EXIT_SUCCESS;
+}
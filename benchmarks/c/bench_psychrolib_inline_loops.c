@@ -0,0 +1,90 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Loops of the benchmark of the header-only build, calling the static inline functions, and the
+ * check-free functions in blocks of BLOCK points. Linked with bench_psychrolib_inline.c.
+ */
+
+#include <stddef.h>
+#define PSYCHROLIB_STATIC_INLINE
+#include "psychrolib_inline.h"
+#include "bench_psychrolib_inline_loops.h"
+
+// The static inline copy of the library has its own system of units
+void InlineSetUnitSystem(enum UnitSystem Units)
+{
+  SetUnitSystem(Units);
+}
+
+void InlineLoops(int f, size_t N, const double *TDryBulb, const double *RelHum, const double *Pressure,
+  const double *HumRatio, const double *VapPres, double *Out)
+{
+  Loops(f, N, TDryBulb, RelHum, Pressure, HumRatio, VapPres, Out);
+}
+
+#define BLOCK 16
+
+// Evaluate the check-free variant of function f on N points, 0 if there is none. The blocks have a
+// constant trip count, so that gcc vectorizes them at -O2.
+int UncheckedInlineLoops(int f, size_t N, const double *restrict TDryBulb, const double *restrict RelHum,
+  const double *restrict Pressure, const double *restrict HumRatio, const double *restrict VapPres,
+  double *restrict Out)
+{
+  size_t i = 0, l;
+
+  switch (f)
+  {
+    case 0:
+      for (; i + BLOCK <= N; i += BLOCK)
+        for (l = i; l < i + BLOCK; l++)
+          Out[l] = UncheckedGetMoistAirEnthalpy(TDryBulb[l], HumRatio[l]);
+      for (; i < N; i++)
+        Out[i] = UncheckedGetMoistAirEnthalpy(TDryBulb[i], HumRatio[i]);
+      return 1;
+    case 1:
+      for (; i + BLOCK <= N; i += BLOCK)
+        for (l = i; l < i + BLOCK; l++)
+          Out[l] = UncheckedGetMoistAirVolume(TDryBulb[l], HumRatio[l], Pressure[l]);
+      for (; i < N; i++)
+        Out[i] = UncheckedGetMoistAirVolume(TDryBulb[i], HumRatio[i], Pressure[i]);
+      return 1;
+    case 2:
+      for (; i + BLOCK <= N; i += BLOCK)
+        for (l = i; l < i + BLOCK; l++)
+          Out[l] = UncheckedGetHumRatioFromVapPres(VapPres[l], Pressure[l]);
+      for (; i < N; i++)
+        Out[i] = UncheckedGetHumRatioFromVapPres(VapPres[i], Pressure[i]);
+      return 1;
+    case 3:
+      for (; i + BLOCK <= N; i += BLOCK)
+        for (l = i; l < i + BLOCK; l++)
+          Out[l] = UncheckedGetVapPresFromHumRatio(HumRatio[l], Pressure[l]);
+      for (; i < N; i++)
+        Out[i] = UncheckedGetVapPresFromHumRatio(HumRatio[i], Pressure[i]);
+      return 1;
+    case 4:
+      for (; i + BLOCK <= N; i += BLOCK)
+        for (l = i; l < i + BLOCK; l++)
+          Out[l] = UncheckedGetSatVapPres(TDryBulb[l]);
+      for (; i < N; i++)
+        Out[i] = UncheckedGetSatVapPres(TDryBulb[i]);
+      return 1;
+    case 5:
+      for (; i + BLOCK <= N; i += BLOCK)
+        for (l = i; l < i + BLOCK; l++)
+          Out[l] = UncheckedGetHumRatioFromRelHum(TDryBulb[l], RelHum[l], Pressure[l]);
+      for (; i < N; i++)
+        Out[i] = UncheckedGetHumRatioFromRelHum(TDryBulb[i], RelHum[i], Pressure[i]);
+      return 1;
+    case 6:
+      for (; i + BLOCK <= N; i += BLOCK)
+        for (l = i; l < i + BLOCK; l++)
+          Out[l] = UncheckedGetTDewPointFromHumRatio(TDryBulb[l], HumRatio[l], Pressure[l]);
+      for (; i < N; i++)
+        Out[i] = UncheckedGetTDewPointFromHumRatio(TDryBulb[i], HumRatio[i], Pressure[i]);
+      return 1;
+    default:
+      return 0;
+  }
+}
@@ -0,0 +1,60 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Loops of the benchmark of the header-only build. They are included in bench_psychrolib_inline.c,
+ * where they call the functions of the linked library, and in bench_psychrolib_inline_loops.c, where
+ * they call the static inline functions of psychrolib_inline.h.
+ */
+
+#define N_FUNCTIONS 8
+
+// Evaluate function f on N points
+static void Loops
+  ( int f
+  , size_t N
+  , const double *TDryBulb
+  , const double *RelHum
+  , const double *Pressure
+  , const double *HumRatio
+  , const double *VapPres
+  , double *Out
+  )
+{
+  size_t i;
+
+  switch (f)
+  {
+    case 0:
+      for (i = 0; i < N; i++)
+        Out[i] = GetMoistAirEnthalpy(TDryBulb[i], HumRatio[i]);
+      break;
+    case 1:
+      for (i = 0; i < N; i++)
+        Out[i] = GetMoistAirVolume(TDryBulb[i], HumRatio[i], Pressure[i]);
+      break;
+    case 2:
+      for (i = 0; i < N; i++)
+        Out[i] = GetHumRatioFromVapPres(VapPres[i], Pressure[i]);
+      break;
+    case 3:
+      for (i = 0; i < N; i++)
+        Out[i] = GetVapPresFromHumRatio(HumRatio[i], Pressure[i]);
+      break;
+    case 4:
+      for (i = 0; i < N; i++)
+        Out[i] = GetSatVapPres(TDryBulb[i]);
+      break;
+    case 5:
+      for (i = 0; i < N; i++)
+        Out[i] = GetHumRatioFromRelHum(TDryBulb[i], RelHum[i], Pressure[i]);
+      break;
+    case 6:
+      for (i = 0; i < N; i++)
+        Out[i] = GetTDewPointFromHumRatio(TDryBulb[i], HumRatio[i], Pressure[i]);
+      break;
+    default:
+      for (i = 0; i < N; i++)
+        Out[i] = GetTWetBulbFromHumRatio(TDryBulb[i], HumRatio[i], Pressure[i]);
+  }
+}
@@ -0,0 +1,140 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Time per point of the dry-bulb temperature from the relative humidity and the enthalpy, the
+ * wet-bulb temperature or the specific volume of the first 4096 points of the corpus: a bisection
+ * on CalcPsychrometricsFromRelHum over the dry-bulb temperatures of the corpus, to the tolerance of
+ * the library (0.001 °C or °F), against the batch inverse functions of psychrolib_inverse.c. Also
+ * prints the maximum difference from the dry-bulb temperatures of the corpus, which for the wet-bulb
+ * temperature includes the tolerance of the wet-bulb temperatures of the corpus, amplified at low
+ * relative humidity, and of the nested bisection of the root finder. Prints a Markdown table.
+ * Usage: bench_psychrolib_inverse <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_inverse.h"
+
+#define N_POINTS 4096
+
+enum { ENTHALPY, TWET_BULB, VOLUME, N_PAIRS };
+
+static const char *NAMES[N_PAIRS] = { "Enthalpy", "Wet bulb temperature", "Specific volume" };
+static const int OUTPUTS[N_PAIRS] = { 4, 1, 5 };        // Position among the outputs of CalcPsychrometricsFromRelHum
+
+static size_t N;
+static int Pair;
+static double TDryBulb[N_POINTS], RelHum[N_POINTS], Pressure[N_POINTS], Inputs[N_PAIRS][N_POINTS];
+static double Solutions[N_POINTS], Deviation[2][N_PAIRS];
+static double TLower, TUpper;
+
+// Bisection on the outputs of CalcPsychrometricsFromRelHum, all increasing in the dry-bulb temperature
+static void RootFinder(void)
+{
+  double Out[7], Lower, Upper, T;
+  size_t i;
+
+  for (i = 0; i < N; i++)
+  {
+    Lower = TLower;
+    Upper = TUpper;
+    while (Upper - Lower > (isIP() ? 0.001 * 9. / 5. : 0.001))
+    {
+      T = 0.5 * (Lower + Upper);
+      CalcPsychrometricsFromRelHum(T, RelHum[i], Pressure[i], &Out[0], &Out[1], &Out[2], &Out[3], &Out[4], &Out[5], &Out[6]);
+      if (Out[OUTPUTS[Pair]] > Inputs[Pair][i])
+        Upper = T;
+      else
+        Lower = T;
+    }
+    Solutions[i] = 0.5 * (Lower + Upper);
+  }
+}
+
+// Batch inverse functions
+static void Inverse(void)
+{
+  if (Pair == ENTHALPY)
+    GetTDryBulbFromEnthalpyAndRelHumBatch(N, Inputs[ENTHALPY], RelHum, Pressure, Solutions);
+  else if (Pair == TWET_BULB)
+    GetTDryBulbFromTWetBulbAndRelHumBatch(N, Inputs[TWET_BULB], RelHum, Pressure, Solutions);
+  else
+    GetTDryBulbFromMoistAirVolumeAndRelHumBatch(N, Inputs[VOLUME], RelHum, Pressure, Solutions);
+}
+
+// Time per point in ns, doubling the passes until the minimum time is reached
+static double Time(void (*Run)(void), double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run();
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e9 * Elapsed / ((double) Passes * N);
+    Passes *= 2;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  const double *Row;
+  double *Corpus, Times[2][N_PAIRS];
+  size_t i, NRows, r;
+  int k;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+
+  Corpus = ReadCorpus(argv[2], &NRows);
+  TLower = HUGE_VAL;
+  TUpper = -HUGE_VAL;
+  for (r = 0; r < NRows && N < N_POINTS; r++)
+  {
+    Row = &Corpus[r * CORPUS_COLUMNS];
+    TDryBulb[N] = Row[0];
+    RelHum[N] = Row[1];
+    Pressure[N] = Row[2];
+    Inputs[ENTHALPY][N] = Row[5];
+    Inputs[TWET_BULB][N] = Row[3];
+    Inputs[VOLUME][N] = GetMoistAirVolume(Row[0], Row[4], Row[2]);
+    TLower = fmin(TLower, Row[0]);
+    TUpper = fmax(TUpper, Row[0]);
+    N++;
+  }
+  free(Corpus);
+  TLower -= 1.;
+  TUpper += 1.;
+
+  for (Pair = 0; Pair < N_PAIRS; Pair++)
+  {
+    Times[0][Pair] = Time(RootFinder, atof(argv[3]));
+    for (i = 0; i < N; i++)
+      Deviation[0][Pair] = fmax(Deviation[0][Pair], fabs(Solutions[i] - TDryBulb[i]));
+    Times[1][Pair] = Time(Inverse, atof(argv[3]));
+    for (i = 0; i < N; i++)
+      Deviation[1][Pair] = fmax(Deviation[1][Pair], fabs(Solutions[i] - TDryBulb[i]));
+  }
+
+  printf("Dry-bulb temperature from the relative humidity and another property, %zu points.\n\n", N);
+  printf("| Property | Bisection on CalcPsychrometricsFromRelHum (ns) | Inverse function (ns) | Speedup | Maximum difference, bisection | Maximum difference, inverse |\n");
+  printf("|---|---:|---:|---:|---:|---:|\n");
+  for (k = 0; k < N_PAIRS; k++)
+    printf("| %s | %.0f | %.0f | %.1f | %.2g | %.2g |\n", NAMES[k], Times[0][k], Times[1][k], Times[0][k] / Times[1][k],
+      Deviation[0][k], Deviation[1][k]);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Speedup of the lock-step solvers over the generic functions, run by benchmarks/run_benchmarks.py.
+ * The inputs are the points of the corpus, and a mix of the same dry-bulb temperatures and
+ * pressures with, in turn, a relative humidity of 0.1 %, 30 % and 99.9 %, so that neighbouring
+ * points take very different numbers of iterations. The lane-steps per point are the lock-step
+ * iterations times PSYCHRO_LOCKSTEP_LANES divided by the number of points.
+ * Prints a Markdown table.
+ * Usage: bench_psychrolib_lockstep <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_lockstep.h"
+
+#define N_FUNCTIONS 2
+
+#define N_INPUTS 2
+
+static const char *FUNCTION_NAMES[N_FUNCTIONS] = { "GetTDewPointFromVapPres", "GetTWetBulbFromHumRatio" };
+
+static const char *INPUT_NAMES[N_INPUTS] = { "corpus", "mixed" };
+
+static size_t N;
+static double *TDryBulb, *Pressure, *HumRatio[N_INPUTS], *VapPres[N_INPUTS], *Out;
+static int Input;
+static size_t Steps;
+
+// Evaluate function f on all points with the generic functions
+static void Generic(int f)
+{
+  size_t i;
+
+  for (i = 0; i < N; i++)
+    if (f == 0)
+      Out[i] = GetTDewPointFromVapPres(TDryBulb[i], VapPres[Input][i]);
+    else
+      Out[i] = GetTWetBulbFromHumRatio(TDryBulb[i], HumRatio[Input][i], Pressure[i]);
+}
+
+// Evaluate function f on all points with the lock-step solvers
+static void Lockstep(int f)
+{
+  if (f == 0)
+    Steps = LockstepGetTDewPointFromVapPres(N, TDryBulb, VapPres[Input], Out);
+  else
+    Steps = LockstepGetTWetBulbFromHumRatio(N, TDryBulb, HumRatio[Input], Pressure, Out);
+}
+
+// Time per point in ns, doubling the passes until the minimum time is reached
+static double Time(void (*Run)(int), int f, double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run(f);
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e9 * Elapsed / ((double) Passes * N);
+    Passes *= 2;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  static const double MIXED_REL_HUM[3] = { 0.001, 0.3, 0.999 };
+  const double *Row;
+  double *Corpus, *RelHum, *Expected, GenericTime, LockstepTime, Deviation;
+  size_t i, NRows, r;
+  int f;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+
+  Corpus = ReadCorpus(argv[2], &NRows);
+  TDryBulb = Allocate(NRows * sizeof(double));
+  RelHum = Allocate(NRows * sizeof(double));
+  Pressure = Allocate(NRows * sizeof(double));
+  for (r = 0; r < NRows; r++)
+  {
+    Row = &Corpus[r * CORPUS_COLUMNS];
+    TDryBulb[N] = Row[0];
+    RelHum[N] = Row[1];
+    Pressure[N] = Row[2];
+    N++;
+  }
+  free(Corpus);
+
+  for (Input = 0; Input < N_INPUTS; Input++)
+  {
+    HumRatio[Input] = malloc(N * sizeof(double));
+    VapPres[Input] = malloc(N * sizeof(double));
+    for (i = 0; i < N; i++)
+    {
+      HumRatio[Input][i] = GetHumRatioFromRelHum(TDryBulb[i], Input == 0 ? RelHum[i] : MIXED_REL_HUM[i % 3], Pressure[i]);
+      VapPres[Input][i] = GetVapPresFromHumRatio(HumRatio[Input][i], Pressure[i]);
+    }
+  }
+  Out = malloc(N * sizeof(double));
+  Expected = malloc(N * sizeof(double));
+
+  printf("Lock-step solvers with %d lanes, %zu points.\n\n", PSYCHRO_LOCKSTEP_LANES, N);
+  printf("| Function | Inputs | Generic (ns/point) | Lock-step (ns/point) | Speedup | Lane-steps per point | Max deviation |\n");
+  printf("|---|---|---:|---:|---:|---:|---:|\n");
+  for (f = 0; f < N_FUNCTIONS; f++)
+    for (Input = 0; Input < N_INPUTS; Input++)
+    {
+      Generic(f);
+      memcpy(Expected, Out, N * sizeof(double));
+      Lockstep(f);
+      Deviation = 0.;
+      for (i = 0; i < N; i++)
+        Deviation = fmax(Deviation, fabs(Out[i] - Expected[i]));
+
+      GenericTime = Time(Generic, f, atof(argv[3]));
+      LockstepTime = Time(Lockstep, f, atof(argv[3]));
+      printf("| %s | %s | %.1f | %.1f | %.1f | %.1f | %.2e |\n", FUNCTION_NAMES[f], INPUT_NAMES[Input],
+        GenericTime, LockstepTime, GenericTime / LockstepTime, (double) Steps * PSYCHRO_LOCKSTEP_LANES / N, Deviation);
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,181 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Time per reading of an ingestion path on the first 4096 points of the corpus: frames parsed into
+ * the dry-bulb temperature in tenths of a degree and the relative humidity in percent, validated,
+ * converted, calculated with BoundedCalcPsychrometricsFromRelHum and aggregated into the mean
+ * enthalpy. The readings are processed one at a time in the calling thread, against the streaming
+ * pipeline of psychrolib_pipeline.c with a map, a compute and a sink stage, with 1 to 4 workers in
+ * the compute stage. Also prints the mean and maximum latency from the push of a reading to the
+ * end of the sink stage. Prints a Markdown table.
+ * Usage: bench_psychrolib_pipeline <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_bounded.h"
+#include "psychrolib_pipeline.h"
+
+#define N_POINTS 4096
+#define N_CONFIGS 3
+
+static const unsigned WORKERS[N_CONFIGS] = { 1, 2, 4 };
+
+static size_t N;
+static unsigned Workers;
+static struct PsychroReading Readings[N_POINTS];
+static double Pressure, Sum, Count, Latency[2][N_CONFIGS];
+
+// Frame: dry-bulb temperature in tenths of a degree and relative humidity in percent, 16-bit integers
+static int Parse(void *Context, struct PsychroReading *Reading)
+{
+  int16_t T;
+  uint16_t RH;
+
+  (void) Context;
+  memcpy(&T, Reading->Frame, sizeof T);
+  memcpy(&RH, Reading->Frame + sizeof T, sizeof RH);
+  if (RH > 10000)
+    return 1;
+  Reading->TDryBulb = 0.1 * T;
+  Reading->RelHum = 1e-4 * RH;
+  Reading->Pressure = Pressure;
+  return 0;
+}
+
+static void Aggregate(void *Context, const struct PsychroReading *Readings, size_t n)
+{
+  size_t i;
+
+  (void) Context;
+  for (i = 0; i < n; i++)
+    if (!isnan(Readings[i].MoistAirEnthalpy))
+    {
+      Sum += Readings[i].MoistAirEnthalpy;
+      Count++;
+    }
+}
+
+static void Synchronous(void)
+{
+  struct PsychroReading Reading;
+  size_t i;
+
+  Sum = Count = 0.;
+  for (i = 0; i < N; i++)
+  {
+    Reading = Readings[i];
+    if (Parse(NULL, &Reading) != 0)
+      continue;
+    if (BoundedCalcPsychrometricsFromRelHum(Reading.TDryBulb, Reading.RelHum, Reading.Pressure, &Reading.HumRatio,
+      &Reading.TWetBulb, &Reading.TDewPoint, &Reading.VapPres, &Reading.MoistAirEnthalpy, &Reading.MoistAirVolume,
+      &Reading.DegreeOfSaturation) != PSYCHRO_STATUS_OK)
+      Reading.MoistAirEnthalpy = NAN;
+    Aggregate(NULL, &Reading, 1);
+  }
+}
+
+static void Pipelined(void)
+{
+  struct PsychroStageConfig Stages[3] = {
+    { PSYCHRO_STAGE_MAP, 1, 256, 1e-4, 0, PSYCHRO_STAGE_FROM_REL_HUM, Parse, NULL, NULL },
+    { PSYCHRO_STAGE_COMPUTE, 1, 256, 1e-4, 0, PSYCHRO_STAGE_FROM_REL_HUM, NULL, NULL, NULL },
+    { PSYCHRO_STAGE_SINK, 1, 1024, 1e-3, 0, PSYCHRO_STAGE_FROM_REL_HUM, NULL, Aggregate, NULL } };
+  struct PsychroStageStats Stats;
+  PsychroPipeline *Pipeline;
+  size_t i;
+  int k;
+
+  Stages[1].Workers = Workers;
+  Sum = Count = 0.;
+  Pipeline = PsychroPipelineCreate(Stages, 3, 1);
+  for (i = 0; i < N; i++)
+    PsychroPipelinePush(Pipeline, &Readings[i]);
+  PsychroPipelineFinish(Pipeline);
+  PsychroPipelineGetStats(Pipeline, 2, &Stats);
+  for (k = 0; k < N_CONFIGS; k++)
+    if (WORKERS[k] == Workers)
+    {
+      Latency[0][k] = Stats.MeanLatency;
+      Latency[1][k] = Stats.MaxLatency;
+    }
+  PsychroPipelineDestroy(Pipeline);
+}
+
+// Time per reading in ns, doubling the passes until the minimum time is reached
+static double Time(void (*Run)(void), double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run();
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e9 * Elapsed / ((double) Passes * N);
+    Passes *= 2;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  const double *Row;
+  size_t NRows, r;
+  double *Corpus, Reference, MeanReference, Times[N_CONFIGS];
+  int16_t T;
+  uint16_t RH;
+  int k;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+  Pressure = strcmp(argv[1], "IP") == 0 ? 14.696 : 101325.;
+
+  Corpus = ReadCorpus(argv[2], &NRows);
+  for (r = 0; r < NRows && N < N_POINTS; r++)
+  {
+    Row = &Corpus[r * CORPUS_COLUMNS];
+    memset(&Readings[N], 0, sizeof Readings[N]);
+    Readings[N].Sensor = N;
+    T = (int16_t) lround(10. * Row[0]);
+    RH = (uint16_t) lround(1e4 * Row[1]);
+    memcpy(Readings[N].Frame, &T, sizeof T);
+    memcpy(Readings[N].Frame + sizeof T, &RH, sizeof RH);
+    N++;
+  }
+  free(Corpus);
+
+  Reference = Time(Synchronous, atof(argv[3]));
+  MeanReference = Sum / Count;
+  for (k = 0; k < N_CONFIGS; k++)
+  {
+    Workers = WORKERS[k];
+    Times[k] = Time(Pipelined, atof(argv[3]));
+    if (fabs(Sum / Count - MeanReference) > 1e-9 * fabs(MeanReference))
+    {
+      fprintf(stderr, "Mean enthalpy differs: %.17g and %.17g\n", Sum / Count, MeanReference);
+      return EXIT_FAILURE;
+    }
+  }
+
+  printf("Ingestion of %zu sensor readings: parsing, validation, psychrometrics and mean enthalpy.\n\n", N);
+  printf("| Configuration | Time per reading (ns) | Speedup | Mean latency (us) | Maximum latency (us) |\n");
+  printf("|---|---:|---:|---:|---:|\n");
+  printf("| One reading at a time | %.0f | 1.0 | | |\n", Reference);
+  for (k = 0; k < N_CONFIGS; k++)
+    printf("| Pipeline, %u compute workers | %.0f | %.1f | %.0f | %.0f |\n", WORKERS[k], Times[k], Reference / Times[k],
+      1e6 * Latency[0][k], 1e6 * Latency[1][k]);
+  return EXIT_SUCCESS;
+}
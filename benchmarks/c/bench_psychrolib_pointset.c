@@ -0,0 +1,174 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Time per poll of a point set of 500000 rows, built from the points of the corpus, of which 5%
+ * change between polls: the full recomputation of all rows with CalcPsychrometricsFromRelHum,
+ * against the update of all rows of the point set followed by the recomputation of the dirty rows,
+ * in the calling thread and in 4 threads. The rows that change are spread at random over the point
+ * set, and alternate between two dry-bulb temperatures 0.1 °C (0.18 °F) apart. Prints a Markdown
+ * table. Usage: bench_psychrolib_pointset <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_pointset.h"
+
+#define N_ROWS 500000
+#define CHANGED_FRACTION 0.05
+
+static size_t NChanged, *ChangedRows, *Reported;
+static double *TDryBulb, *RelHum, *Pressure, *Base, *Outputs[PSYCHRO_POINT_N_OUTPUTS];
+static PsychroPointSet *Set;
+static long Poll;
+
+// Readings of the next poll
+static void Read(void)
+{
+  double Delta = (++Poll & 1) ? (isIP() ? 0.18 : 0.1) : 0.;
+  size_t i;
+
+  for (i = 0; i < NChanged; i++)
+    TDryBulb[ChangedRows[i]] = Base[ChangedRows[i]] + Delta;
+}
+
+// Recomputation of all rows
+static void Full(unsigned Threads)
+{
+  size_t i;
+
+  (void) Threads;
+  Read();
+  for (i = 0; i < N_ROWS; i++)
+    CalcPsychrometricsFromRelHum(TDryBulb[i], RelHum[i], Pressure[i], &Outputs[0][i], &Outputs[1][i],
+      &Outputs[2][i], &Outputs[3][i], &Outputs[4][i], &Outputs[5][i], &Outputs[6][i]);
+}
+
+// Update of all rows and recomputation of the dirty rows
+static void Incremental(unsigned Threads)
+{
+  Read();
+  PsychroPointSetUpdateRange(Set, 0, N_ROWS, TDryBulb, RelHum, Pressure, NULL);
+  PsychroPointSetRecompute(Set, Threads, Reported);
+}
+
+// Time per poll in ms, doubling the polls until the minimum time is reached
+static double Time(void (*Run)(unsigned), unsigned Threads, double MinTime)
+{
+  long Polls = 2, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Polls; r++)
+      Run(Threads);
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e3 * Elapsed / Polls;
+    Polls *= 2;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  const double *Row;
+  double *Corpus, *CorpusT, *CorpusRH, *CorpusP, FullTime, Time1, Time4;
+  struct PsychroPointSetConfig Config;
+  size_t i, N = 0, NReported, NRows, r;
+  unsigned Seed = 37;
+  int k;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+
+  Corpus = ReadCorpus(argv[2], &NRows);
+  CorpusT = Allocate(NRows * sizeof(double));
+  CorpusRH = Allocate(NRows * sizeof(double));
+  CorpusP = Allocate(NRows * sizeof(double));
+  for (r = 0; r < NRows; r++)
+  {
+    Row = &Corpus[r * CORPUS_COLUMNS];
+    CorpusT[N] = Row[0];
+    CorpusRH[N] = Row[1];
+    CorpusP[N] = Row[2];
+    N++;
+  }
+  free(Corpus);
+
+  // Rows cycling through the corpus, and the rows that change between polls
+  TDryBulb = malloc(N_ROWS * sizeof(double));
+  RelHum = malloc(N_ROWS * sizeof(double));
+  Pressure = malloc(N_ROWS * sizeof(double));
+  Base = malloc(N_ROWS * sizeof(double));
+  ChangedRows = malloc(N_ROWS * sizeof(size_t));
+  Reported = malloc(N_ROWS * sizeof(size_t));
+  for (k = 0; k < PSYCHRO_POINT_N_OUTPUTS; k++)
+    Outputs[k] = malloc(N_ROWS * sizeof(double));
+  for (i = 0; i < N_ROWS; i++)
+  {
+    TDryBulb[i] = Base[i] = CorpusT[i % N];
+    RelHum[i] = CorpusRH[i % N];
+    Pressure[i] = CorpusP[i % N];
+    Seed = Seed * 1103515245u + 12345u;
+    if ((Seed >> 8) % 10000 < CHANGED_FRACTION * 10000)
+      ChangedRows[NChanged++] = i;
+  }
+
+  // Thresholds of 0.01 °C (0.018 °F) for the temperatures, and of about the same relative size
+  // for the other outputs
+  Config.Count = N_ROWS;
+  Config.Thresholds[PSYCHRO_POINT_HUM_RATIO] = 1e-5;
+  Config.Thresholds[PSYCHRO_POINT_TWET_BULB] = isIP() ? 0.018 : 0.01;
+  Config.Thresholds[PSYCHRO_POINT_TDEW_POINT] = isIP() ? 0.018 : 0.01;
+  Config.Thresholds[PSYCHRO_POINT_VAP_PRES] = isIP() ? 0.0001 : 1.;
+  Config.Thresholds[PSYCHRO_POINT_MOIST_AIR_ENTHALPY] = isIP() ? 0.01 : 20.;
+  Config.Thresholds[PSYCHRO_POINT_MOIST_AIR_VOLUME] = isIP() ? 0.001 : 1e-4;
+  Config.Thresholds[PSYCHRO_POINT_DEGREE_OF_SATURATION] = 1e-4;
+  Set = PsychroPointSetCreate(&Config);
+  if (Set == NULL)
+  {
+    fprintf(stderr, "Cannot create point set\n");
+    return EXIT_FAILURE;
+  }
+  PsychroPointSetUpdateRange(Set, 0, N_ROWS, TDryBulb, RelHum, Pressure, NULL);
+  PsychroPointSetRecompute(Set, 1, NULL);
+
+  FullTime = Time(Full, 1, atof(argv[3]));
+  Time1 = Time(Incremental, 1, atof(argv[3]));
+  Time4 = Time(Incremental, 4, atof(argv[3]));
+  Read();
+  PsychroPointSetUpdateRange(Set, 0, N_ROWS, TDryBulb, RelHum, Pressure, NULL);
+  NReported = PsychroPointSetRecompute(Set, 1, Reported);
+
+  printf("Point set of %d rows, of which %zu (%.0f%%) change between polls; %zu rows reported per poll.\n\n",
+    N_ROWS, NChanged, 100. * NChanged / N_ROWS, NReported);
+  printf("| Recomputation | Time per poll (ms) | Speedup |\n");
+  printf("|---|---:|---:|\n");
+  printf("| All rows | %.2f | 1.0 |\n", FullTime);
+  printf("| Dirty rows, 1 thread | %.2f | %.1f |\n", Time1, FullTime / Time1);
+  printf("| Dirty rows, 4 threads | %.2f | %.1f |\n", Time4, FullTime / Time4);
+
+  PsychroPointSetDestroy(Set);
+  for (k = 0; k < PSYCHRO_POINT_N_OUTPUTS; k++)
+    free(Outputs[k]);
+  free(CorpusT);
+  free(CorpusRH);
+  free(CorpusP);
+  free(TDryBulb);
+  free(RelHum);
+  free(Pressure);
+  free(Base);
+  free(ChangedRows);
+  free(Reported);
+  return EXIT_SUCCESS;
+}
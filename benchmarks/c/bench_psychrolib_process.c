@@ -0,0 +1,256 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Time per air handler of the chain of processes of an air handler: mixing of 30% of outdoor air,
+ * the points of the corpus, with return air at 24 °C and 50% (75.2 °F), cooling to 12 °C (53.6 °F),
+ * reheating to 16 °C (60.8 °F), fan heat of 1 kJ kg⁻¹ (0.43 Btu lb⁻¹) and steam humidification to
+ * 40% relative humidity. The conventional chain carries the relative humidity between the processes
+ * with the generic functions (humidity ratio from relative humidity, dew point to decide whether the
+ * air condenses, relative humidity from humidity ratio), against the batch processes of
+ * psychrolib_process.c on the state of temperature, humidity ratio, pressure and enthalpy. Also
+ * prints the maximum differences of the supply air and of the loads: the cooling loads differ where
+ * the mixture is supersaturated, which the conventional chain clips at a relative humidity of 1 and
+ * constant temperature, losing the enthalpy of the water in excess. Prints a Markdown table.
+ * Usage: bench_psychrolib_process <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_process.h"
+
+#define OUTDOOR_FRACTION 0.3
+
+// Loads of the air handlers: cooling, reheat and humidification
+enum { COOLING, REHEAT, STEAM, N_LOADS };
+
+static size_t N;
+static double *TDryBulb, *RelHum, *Pressure, *OutdoorFlow, *ReturnFlow, *TCool, *THeat, *FanHeat, *TSteam, *Target;
+static double *Supply[2][2], *Loads[2][N_LOADS];
+static struct PsychroAirState *Outdoor, *Return, *States;
+static double TReturn, TCoolSetpoint, THeatSetpoint, Fan, TSteamSupply;
+
+static double WaterEnthalpy(double T)
+{
+  return isIP() ? T - 32. : 4186. * T;
+}
+
+static double SteamEnthalpy(double T)
+{
+  return isIP() ? 1061. + 0.444 * T : (2501. + 1.86 * T) * 1000.;
+}
+
+// Conventional chain carrying the relative humidity
+static void Conventional(void)
+{
+  double T, RH, W, h, HumRatioOutdoor, HumRatioReturn, TDewPoint, TNext, WNext, hNext;
+  size_t i;
+
+  for (i = 0; i < N; i++)
+  {
+    // Mixing
+    HumRatioOutdoor = GetHumRatioFromRelHum(TDryBulb[i], RelHum[i], Pressure[i]);
+    HumRatioReturn = GetHumRatioFromRelHum(TReturn, 0.5, Pressure[i]);
+    W = OUTDOOR_FRACTION * HumRatioOutdoor + (1. - OUTDOOR_FRACTION) * HumRatioReturn;
+    h = OUTDOOR_FRACTION * GetMoistAirEnthalpy(TDryBulb[i], HumRatioOutdoor)
+      + (1. - OUTDOOR_FRACTION) * GetMoistAirEnthalpy(TReturn, HumRatioReturn);
+    T = GetTDryBulbFromEnthalpyAndHumRatio(h, W);
+    RH = fmin(GetRelHumFromHumRatio(T, W, Pressure[i]), 1.);
+
+    // Cooling, saturated below the dew point
+    W = GetHumRatioFromRelHum(T, RH, Pressure[i]);
+    h = GetMoistAirEnthalpy(T, W);
+    TNext = fmin(TCoolSetpoint, T);
+    TDewPoint = GetTDewPointFromRelHum(T, RH);
+    if (TNext < TDewPoint)
+      RH = 1.;
+    else
+      RH = GetRelHumFromHumRatio(TNext, W, Pressure[i]);
+    WNext = GetHumRatioFromRelHum(TNext, RH, Pressure[i]);
+    hNext = GetMoistAirEnthalpy(TNext, WNext);
+    Loads[0][COOLING][i] = h - hNext - (W - WNext) * WaterEnthalpy(TNext);
+    T = TNext;
+
+    // Reheating
+    W = GetHumRatioFromRelHum(T, RH, Pressure[i]);
+    h = GetMoistAirEnthalpy(T, W);
+    T = fmax(THeatSetpoint, T);
+    RH = GetRelHumFromHumRatio(T, W, Pressure[i]);
+    Loads[0][REHEAT][i] = GetMoistAirEnthalpy(T, W) - h;
+
+    // Fan heat
+    W = GetHumRatioFromRelHum(T, RH, Pressure[i]);
+    T = GetTDryBulbFromEnthalpyAndHumRatio(GetMoistAirEnthalpy(T, W) + Fan, W);
+    RH = GetRelHumFromHumRatio(T, W, Pressure[i]);
+
+    // Steam humidification
+    W = GetHumRatioFromRelHum(T, RH, Pressure[i]);
+    h = GetMoistAirEnthalpy(T, W);
+    WNext = fmax(W, GetHumRatioFromRelHum(T, 0.4, Pressure[i]));
+    Loads[0][STEAM][i] = WNext - W;
+    T = GetTDryBulbFromEnthalpyAndHumRatio(h + (WNext - W) * SteamEnthalpy(TSteamSupply), WNext);
+    RH = GetRelHumFromHumRatio(T, WNext, Pressure[i]);
+
+    Supply[0][0][i] = T;
+    Supply[0][1][i] = GetHumRatioFromRelHum(T, RH, Pressure[i]);
+  }
+}
+
+// Batch processes on the air states
+static void Processes(void)
+{
+  size_t i;
+
+  PsychroAirMixBatch(N, Outdoor, OutdoorFlow, Return, ReturnFlow, States);
+  for (i = 0; i < N; i++)
+    TCool[i] = fmin(TCoolSetpoint, States[i].TDryBulb);
+  PsychroAirCoolToBatch(N, States, TCool, Loads[1][COOLING], NULL);
+  for (i = 0; i < N; i++)
+    THeat[i] = fmax(THeatSetpoint, States[i].TDryBulb);
+  PsychroAirHeatToBatch(N, States, THeat, Loads[1][REHEAT]);
+  PsychroAirHeatBatch(N, States, FanHeat);
+  for (i = 0; i < N; i++)
+  {
+    Target[i] = fmax(States[i].HumRatio, GetHumRatioFromRelHum(States[i].TDryBulb, 0.4, States[i].Pressure));
+    Loads[1][STEAM][i] = Target[i] - States[i].HumRatio;
+  }
+  PsychroAirHumidifySteamBatch(N, States, Target, TSteam);
+  for (i = 0; i < N; i++)
+  {
+    Supply[1][0][i] = States[i].TDryBulb;
+    Supply[1][1][i] = States[i].HumRatio;
+  }
+}
+
+// Time per air handler in ns, doubling the passes until the minimum time is reached
+static double Time(void (*Run)(void), double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run();
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e9 * Elapsed / ((double) Passes * N);
+    Passes *= 2;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  const double *Row;
+  double *Corpus, ConventionalTime, ProcessTime, Deviation[2 + N_LOADS] = { 0. };
+  size_t i, NRows, r;
+  int k;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+  TReturn = isIP() ? 75.2 : 24.;
+  TCoolSetpoint = isIP() ? 53.6 : 12.;
+  THeatSetpoint = isIP() ? 60.8 : 16.;
+  Fan = isIP() ? 0.43 : 1000.;
+  TSteamSupply = isIP() ? 212. : 100.;
+
+  Corpus = ReadCorpus(argv[2], &NRows);
+  TDryBulb = Allocate(NRows * sizeof(double));
+  RelHum = Allocate(NRows * sizeof(double));
+  Pressure = Allocate(NRows * sizeof(double));
+  for (r = 0; r < NRows; r++)
+  {
+    Row = &Corpus[r * CORPUS_COLUMNS];
+    TDryBulb[N] = Row[0];
+    RelHum[N] = Row[1];
+    Pressure[N] = Row[2];
+    N++;
+  }
+  free(Corpus);
+
+  Outdoor = malloc(N * sizeof(struct PsychroAirState));
+  Return = malloc(N * sizeof(struct PsychroAirState));
+  States = malloc(N * sizeof(struct PsychroAirState));
+  OutdoorFlow = malloc(N * sizeof(double));
+  ReturnFlow = malloc(N * sizeof(double));
+  TCool = malloc(N * sizeof(double));
+  THeat = malloc(N * sizeof(double));
+  FanHeat = malloc(N * sizeof(double));
+  TSteam = malloc(N * sizeof(double));
+  Target = malloc(N * sizeof(double));
+  for (k = 0; k < 2; k++)
+  {
+    Supply[k][0] = malloc(N * sizeof(double));
+    Supply[k][1] = malloc(N * sizeof(double));
+  }
+  for (k = 0; k < N_LOADS; k++)
+  {
+    Loads[0][k] = malloc(N * sizeof(double));
+    Loads[1][k] = malloc(N * sizeof(double));
+  }
+
+  // The states of the outdoor and return air are set once, as a simulation keeps them between steps
+  for (i = 0; i < N; i++)
+  {
+    PsychroAirSetStateFromRelHum(&Outdoor[i], TDryBulb[i], RelHum[i], Pressure[i]);
+    PsychroAirSetStateFromRelHum(&Return[i], TReturn, 0.5, Pressure[i]);
+    OutdoorFlow[i] = OUTDOOR_FRACTION;
+    ReturnFlow[i] = 1. - OUTDOOR_FRACTION;
+    FanHeat[i] = Fan;
+    TSteam[i] = TSteamSupply;
+  }
+
+  ConventionalTime = Time(Conventional, atof(argv[3]));
+  ProcessTime = Time(Processes, atof(argv[3]));
+  for (i = 0; i < N; i++)
+  {
+    for (k = 0; k < 2; k++)
+      Deviation[k] = fmax(Deviation[k], fabs(Supply[1][k][i] - Supply[0][k][i]));
+    for (k = 0; k < N_LOADS; k++)
+      Deviation[2 + k] = fmax(Deviation[2 + k], fabs(Loads[1][k][i] - Loads[0][k][i]));
+  }
+
+  printf("Air handler chain (mixing, cooling, reheat, fan, steam humidification) over %zu air handlers.\n\n", N);
+  printf("| Chain | Time per air handler (ns) | Speedup |\n");
+  printf("|---|---:|---:|\n");
+  printf("| Relative humidity between processes | %.0f | 1.0 |\n", ConventionalTime);
+  printf("| Batch processes on the air state | %.0f | %.1f |\n\n", ProcessTime, ConventionalTime / ProcessTime);
+  printf("Maximum differences, in the units of the system: supply temperature %.2g, supply humidity ratio %.2g, "
+    "cooling load %.2g, reheat load %.2g, steam %.2g.\n", Deviation[0], Deviation[1], Deviation[2 + COOLING],
+    Deviation[2 + REHEAT], Deviation[2 + STEAM]);
+
+  for (k = 0; k < 2; k++)
+  {
+    free(Supply[k][0]);
+    free(Supply[k][1]);
+  }
+  for (k = 0; k < N_LOADS; k++)
+  {
+    free(Loads[0][k]);
+    free(Loads[1][k]);
+  }
+  free(Outdoor);
+  free(Return);
+  free(States);
+  free(OutdoorFlow);
+  free(ReturnFlow);
+  free(TCool);
+  free(THeat);
+  free(FanHeat);
+  free(TSteam);
+  free(Target);
+  free(TDryBulb);
+  free(RelHum);
+  free(Pressure);
+  return EXIT_SUCCESS;
+}
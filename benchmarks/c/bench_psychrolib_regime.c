@@ -0,0 +1,155 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Speedup of the regime-partitioned schedule over the interleaved one, run by
+ * benchmarks/run_benchmarks.py. The inputs are the points of the corpus, whose temperatures
+ * alternate between both sides of the triple point in no particular order. The interleaved
+ * schedule is also timed on the same points sorted by temperature, where the branches of the
+ * generic functions are always predicted: the difference between both interleaved columns is the
+ * cost of the mispredictions that the partitioned schedule removes, and the rest of the speedup
+ * comes from its vectorized kernels.
+ * Prints a Markdown table.
+ * Usage: bench_psychrolib_regime <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_regime.h"
+
+#define N_FUNCTIONS 3
+
+static const char *FUNCTION_NAMES[N_FUNCTIONS] = { "GetSatVapPres", "GetSatHumRatio", "GetHumRatioFromTWetBulb" };
+
+static size_t N;
+static double *TDryBulb, *TWetBulb, *Pressure, *Out;
+static enum PsychroRegimeSchedule Schedule;
+
+// Evaluate function f on all points with the current schedule. The saturation functions are
+// evaluated at the wet-bulb temperatures, which cross the freezing point more often.
+static void Run(int f)
+{
+  if (f == 0)
+    RegimeGetSatVapPres(N, TWetBulb, Out, Schedule);
+  else if (f == 1)
+    RegimeGetSatHumRatio(N, TWetBulb, Pressure, Out, Schedule);
+  else
+    RegimeGetHumRatioFromTWetBulb(N, TDryBulb, TWetBulb, Pressure, Out, Schedule);
+}
+
+// Time per point in ns, doubling the passes until the minimum time is reached
+static double Time(int f, double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run(f);
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e9 * Elapsed / ((double) Passes * N);
+    Passes *= 2;
+  }
+}
+
+// Order of the points by wet-bulb temperature
+static int CompareTWetBulb(const void *a, const void *b)
+{
+  const double *x = a, *y = b;
+  return (x[1] > y[1]) - (x[1] < y[1]);
+}
+
+int main(int argc, char *argv[])
+{
+  const double *Row;
+  double *Corpus, *Sorted, *Swap[3], *Expected, SortedTime, InterleavedTime, PartitionedTime, Deviation, Ice = 0.;
+  size_t i, NRows, r;
+  int f;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+
+  Corpus = ReadCorpus(argv[2], &NRows);
+  TDryBulb = Allocate(NRows * sizeof(double));
+  TWetBulb = Allocate(NRows * sizeof(double));
+  Pressure = Allocate(NRows * sizeof(double));
+  for (r = 0; r < NRows; r++)
+  {
+    Row = &Corpus[r * CORPUS_COLUMNS];
+    TDryBulb[N] = Row[0];
+    TWetBulb[N] = Row[3];
+    Pressure[N] = Row[2];
+    Ice += Row[3] <= (strcmp(argv[1], "IP") == 0 ? 32.018 : 0.01);
+    N++;
+  }
+  free(Corpus);
+
+  // Points sorted by wet-bulb temperature, as rows of (TDryBulb, TWetBulb, Pressure)
+  Sorted = malloc(3 * N * sizeof(double));
+  for (i = 0; i < N; i++)
+  {
+    Sorted[3 * i] = TDryBulb[i];
+    Sorted[3 * i + 1] = TWetBulb[i];
+    Sorted[3 * i + 2] = Pressure[i];
+  }
+  qsort(Sorted, N, 3 * sizeof(double), CompareTWetBulb);
+  Out = malloc(N * sizeof(double));
+  Expected = malloc(N * sizeof(double));
+
+  printf("Regime-partitioned schedule in blocks of %d points, %zu points, %.0f %% over ice.\n\n",
+    PSYCHRO_REGIME_BLOCK, N, 100. * Ice / N);
+  printf("| Function | Interleaved, sorted (ns/point) | Interleaved (ns/point) | Partitioned (ns/point) | Speedup | Max relative deviation |\n");
+  printf("|---|---:|---:|---:|---:|---:|\n");
+  for (f = 0; f < N_FUNCTIONS; f++)
+  {
+    Schedule = PSYCHRO_REGIME_INTERLEAVED;
+    Run(f);
+    memcpy(Expected, Out, N * sizeof(double));
+    Schedule = PSYCHRO_REGIME_PARTITIONED;
+    Run(f);
+    Deviation = 0.;
+    for (i = 0; i < N; i++)
+      Deviation = fmax(Deviation, fabs(Out[i] - Expected[i]) / fabs(Expected[i]));
+
+    PartitionedTime = Time(f, atof(argv[3]));
+    Schedule = PSYCHRO_REGIME_INTERLEAVED;
+    InterleavedTime = Time(f, atof(argv[3]));
+
+    // Same points in sorted order
+    Swap[0] = TDryBulb;
+    Swap[1] = TWetBulb;
+    Swap[2] = Pressure;
+    TDryBulb = malloc(N * sizeof(double));
+    TWetBulb = malloc(N * sizeof(double));
+    Pressure = malloc(N * sizeof(double));
+    for (i = 0; i < N; i++)
+    {
+      TDryBulb[i] = Sorted[3 * i];
+      TWetBulb[i] = Sorted[3 * i + 1];
+      Pressure[i] = Sorted[3 * i + 2];
+    }
+    SortedTime = Time(f, atof(argv[3]));
+    free(TDryBulb);
+    free(TWetBulb);
+    free(Pressure);
+    TDryBulb = Swap[0];
+    TWetBulb = Swap[1];
+    Pressure = Swap[2];
+
+    printf("| %s | %.1f | %.1f | %.1f | %.2f | %.2e |\n", FUNCTION_NAMES[f], SortedTime, InterleavedTime,
+      PartitionedTime, InterleavedTime / PartitionedTime, Deviation);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Time per point of the wet-bulb temperature of the first 4096 points of the corpus: calls of
+ * BoundedGetTWetBulbFromRelHum in the process, against requests to the compute service of
+ * psychrolib_service.c, run in a thread of the process, for several sizes of the requests. The
+ * requests are either sent one at a time, waiting for each response, or submitted 64 at a time
+ * before waiting for their responses, so that the service coalesces them into batches. Also prints
+ * the overhead of the transport per request and the latency statistics of the service. Prints a
+ * Markdown table.
+ * Usage: bench_psychrolib_service <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "psychrolib.h"
+#include "psychrolib_bounded.h"
+#include "psychrolib_service.h"
+
+#define N_POINTS 4096
+#define N_SIZES 5
+#define PIPELINE 64
+
+static const size_t SIZES[N_SIZES] = { 1, 16, 256, 1024, 4096 };
+
+static size_t N, Size;
+static double TDryBulb[N_POINTS], RelHum[N_POINTS], Pressure[N_POINTS], TWetBulb[N_POINTS];
+static PsychroClient *Client;
+
+static void *Serve(void *Service)
+{
+  PsychroServiceRun(Service);
+  return NULL;
+}
+
+static void InProcess(void)
+{
+  size_t i;
+
+  for (i = 0; i < N; i++)
+    BoundedGetTWetBulbFromRelHum(TDryBulb[i], RelHum[i], Pressure[i], &TWetBulb[i]);
+}
+
+// Requests of Size points, one at a time
+static void Calls(void)
+{
+  size_t i, Count;
+
+  for (i = 0; i < N; i += Count)
+  {
+    const double *Inputs[3] = { TDryBulb + i, RelHum + i, Pressure + i };
+    double *Outputs[1] = { TWetBulb + i };
+    Count = N - i < Size ? N - i : Size;
+    PsychroClientCall(Client, PSYCHRO_SERVICE_TWET_BULB_FROM_REL_HUM, Count, Inputs, Outputs);
+  }
+}
+
+// Requests of Size points, PIPELINE at a time
+static void Pipelined(void)
+{
+  int64_t Tickets[PIPELINE];
+  size_t i, Count, Start[PIPELINE];
+  int k, NTickets;
+
+  for (i = 0; i < N; )
+  {
+    for (NTickets = 0; NTickets < PIPELINE && i < N; NTickets++, i += Count)
+    {
+      const double *Inputs[3] = { TDryBulb + i, RelHum + i, Pressure + i };
+      Count = N - i < Size ? N - i : Size;
+      Start[NTickets] = i;
+      Tickets[NTickets] = PsychroClientSubmit(Client, PSYCHRO_SERVICE_TWET_BULB_FROM_REL_HUM, Count, Inputs);
+    }
+    for (k = 0; k < NTickets; k++)
+    {
+      double *Outputs[1] = { TWetBulb + Start[k] };
+      PsychroClientWait(Client, Tickets[k], Outputs);
+    }
+  }
+}
+
+// Time per point in ns, doubling the passes until the minimum time is reached
+static double Time(void (*Run)(void), double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run();
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e9 * Elapsed / ((double) Passes * N);
+    Passes *= 2;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  char Path[64];
+  const double *Row;
+  size_t NRows, r;
+  double *Corpus, Reference, Times[2][N_SIZES], PerRequest[2][N_SIZES], BatchesPerRequest[N_SIZES];
+  struct PsychroServiceConfig Config = { NULL, 1, 0 };
+  struct PsychroServiceStats Before, After;
+  PsychroService *Service;
+  pthread_t Thread;
+  int k;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+
+  Corpus = ReadCorpus(argv[2], &NRows);
+  for (r = 0; r < NRows && N < N_POINTS; r++)
+  {
+    Row = &Corpus[r * CORPUS_COLUMNS];
+    TDryBulb[N] = Row[0];
+    RelHum[N] = Row[1];
+    Pressure[N] = Row[2];
+    N++;
+  }
+  free(Corpus);
+
+  snprintf(Path, sizeof Path, "/tmp/bench_psychrolib_service.%ld.sock", (long) getpid());
+  Config.SocketPath = Path;
+  Service = PsychroServiceCreate(&Config);
+  if (Service == NULL || pthread_create(&Thread, NULL, Serve, Service) != 0
+    || (Client = PsychroClientConnect(Path, 4 * N_POINTS)) == NULL)
+  {
+    fprintf(stderr, "Cannot start the service on %s\n", Path);
+    return EXIT_FAILURE;
+  }
+
+  Reference = Time(InProcess, atof(argv[3]));
+  for (k = 0; k < N_SIZES; k++)
+  {
+    Size = SIZES[k];
+    Times[0][k] = Time(Calls, atof(argv[3]));
+    PerRequest[0][k] = 1e-3 * (Times[0][k] - Reference) * N / ((N + Size - 1) / Size);
+    PsychroServiceGetStats(Service, &Before);
+    Times[1][k] = Time(Pipelined, atof(argv[3]));
+    PsychroServiceGetStats(Service, &After);
+    PerRequest[1][k] = 1e-3 * (Times[1][k] - Reference) * N / ((N + Size - 1) / Size);
+    BatchesPerRequest[k] = (double) (After.Batches - Before.Batches) / (After.Requests - Before.Requests);
+  }
+
+  printf("Wet-bulb temperature from the relative humidity through the compute service, %zu points, "
+    "%.0f ns per point in the process.\n\n", N, Reference);
+  printf("| Points per request | Service, one request at a time (ns/point) | Overhead per request (us) "
+    "| Service, %d requests in flight (ns/point) | Overhead per request (us) | Batches per request |\n", PIPELINE);
+  printf("|---:|---:|---:|---:|---:|---:|\n");
+  for (k = 0; k < N_SIZES; k++)
+    printf("| %zu | %.0f | %.1f | %.0f | %.1f | %.2f |\n", SIZES[k], Times[0][k], PerRequest[0][k], Times[1][k],
+      PerRequest[1][k], BatchesPerRequest[k]);
+  PsychroServiceGetStats(Service, &After);
+  printf("\nService: %llu requests, %.3g points/s of uptime, latency from receipt to response: mean %.3g us, "
+    "median < %.3g us, p99 < %.3g us, max %.3g us.\n", (unsigned long long) After.Requests, After.PointsPerSecond,
+    1e6 * After.MeanLatency, 1e6 * After.MedianLatency, 1e6 * After.P99Latency, 1e6 * After.MaxLatency);
+
+  PsychroClientClose(Client);
+  PsychroServiceStop(Service);
+  pthread_join(Thread, NULL);
+  PsychroServiceDestroy(Service);
+  return EXIT_SUCCESS;
+}
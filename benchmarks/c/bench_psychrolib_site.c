@@ -0,0 +1,148 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Speedup of the site context over the generic functions, run by benchmarks/run_benchmarks.py.
+ * The site pressure is the pressure of the first row of the corpus. The humidity inputs are
+ * recalculated at that pressure from the dry-bulb temperature and relative humidity of the corpus.
+ * Prints a Markdown table.
+ * Usage: bench_psychrolib_site <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_site.h"
+
+#define N_FUNCTIONS 7
+
+static const char *FUNCTION_NAMES[N_FUNCTIONS] =
+{
+  "GetSatVapPres", "GetSatHumRatio", "GetHumRatioFromRelHum", "GetHumRatioFromTWetBulb",
+  "GetTWetBulbFromHumRatio", "GetTDewPointFromHumRatio", "CalcPsychrometricsFromRelHum"
+};
+
+static size_t N;
+static double Pressure;
+static double *TDryBulb, *RelHum, *HumRatio, *TWetBulb, *Out[7];
+static PsychroSite *Site;
+
+// Evaluate function f on all points with the generic functions
+static void Generic(int f)
+{
+  size_t i;
+
+  for (i = 0; i < N; i++)
+    switch (f)
+    {
+      case 0: Out[0][i] = GetSatVapPres(TDryBulb[i]); break;
+      case 1: Out[0][i] = GetSatHumRatio(TDryBulb[i], Pressure); break;
+      case 2: Out[0][i] = GetHumRatioFromRelHum(TDryBulb[i], RelHum[i], Pressure); break;
+      case 3: Out[0][i] = GetHumRatioFromTWetBulb(TDryBulb[i], TWetBulb[i], Pressure); break;
+      case 4: Out[0][i] = GetTWetBulbFromHumRatio(TDryBulb[i], HumRatio[i], Pressure); break;
+      case 5: Out[0][i] = GetTDewPointFromHumRatio(TDryBulb[i], HumRatio[i], Pressure); break;
+      default: CalcPsychrometricsFromRelHum(TDryBulb[i], RelHum[i], Pressure, &Out[0][i], &Out[1][i],
+        &Out[2][i], &Out[3][i], &Out[4][i], &Out[5][i], &Out[6][i]);
+    }
+}
+
+// Evaluate function f on all points with the site context
+static void Batch(int f)
+{
+  switch (f)
+  {
+    case 0: PsychroSiteGetSatVapPres(Site, N, TDryBulb, Out[0]); break;
+    case 1: PsychroSiteGetSatHumRatio(Site, N, TDryBulb, Out[0]); break;
+    case 2: PsychroSiteGetHumRatioFromRelHum(Site, N, TDryBulb, RelHum, Out[0]); break;
+    case 3: PsychroSiteGetHumRatioFromTWetBulb(Site, N, TDryBulb, TWetBulb, Out[0]); break;
+    case 4: PsychroSiteGetTWetBulbFromHumRatio(Site, N, TDryBulb, HumRatio, Out[0]); break;
+    case 5: PsychroSiteGetTDewPointFromHumRatio(Site, N, TDryBulb, HumRatio, Out[0]); break;
+    default: PsychroSiteCalcPsychrometricsFromRelHum(Site, N, TDryBulb, RelHum, Out[0], Out[1], Out[2],
+      Out[3], Out[4], Out[5], Out[6]);
+  }
+}
+
+// Time per point in ns, doubling the passes until the minimum time is reached
+static double Time(void (*Run)(int), int f, double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run(f);
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e9 * Elapsed / ((double) Passes * N);
+    Passes *= 2;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  const double *Row;
+  double *Corpus, *Expected, GenericTime, SiteTime, Deviation;
+  size_t i, NRows, r;
+  int f, c;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+
+  Corpus = ReadCorpus(argv[2], &NRows);
+  TDryBulb = Allocate(NRows * sizeof(double));
+  RelHum = Allocate(NRows * sizeof(double));
+  for (r = 0; r < NRows; r++)
+  {
+    Row = &Corpus[r * CORPUS_COLUMNS];
+    if (N == 0)
+      Pressure = Row[2];
+    TDryBulb[N] = Row[0];
+    RelHum[N] = Row[1];
+    N++;
+  }
+  free(Corpus);
+
+  HumRatio = malloc(N * sizeof(double));
+  TWetBulb = malloc(N * sizeof(double));
+  Expected = malloc(N * sizeof(double));
+  for (c = 0; c < 7; c++)
+    Out[c] = malloc(N * sizeof(double));
+  for (i = 0; i < N; i++)
+  {
+    HumRatio[i] = GetHumRatioFromRelHum(TDryBulb[i], RelHum[i], Pressure);
+    TWetBulb[i] = GetTWetBulbFromHumRatio(TDryBulb[i], HumRatio[i], Pressure);
+  }
+  Site = PsychroSiteCreate(Pressure);
+
+  printf("Site context at %g %s, %zu points.\n\n", Pressure, isIP() ? "Psi" : "Pa", N);
+  printf("| Function | Generic (ns/point) | Site (ns/point) | Speedup | Max deviation |\n");
+  printf("|---|---:|---:|---:|---:|\n");
+  for (f = 0; f < N_FUNCTIONS; f++)
+  {
+    // Deviation of the first output, the humidity ratio for CalcPsychrometricsFromRelHum
+    Generic(f);
+    memcpy(Expected, Out[0], N * sizeof(double));
+    Batch(f);
+    Deviation = 0.;
+    for (i = 0; i < N; i++)
+      Deviation = fmax(Deviation, fabs(Out[0][i] - Expected[i]));
+
+    GenericTime = Time(Generic, f, atof(argv[3]));
+    SiteTime = Time(Batch, f, atof(argv[3]));
+    printf("| %s | %.1f | %.1f | %.1f | %.2e |\n", FUNCTION_NAMES[f], GenericTime, SiteTime,
+      GenericTime / SiteTime, Deviation);
+  }
+
+  PsychroSiteDestroy(Site);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,186 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Speedup of the batch lookups of trilinear and cubic property tables over the exact functions,
+ * run by benchmarks/run_benchmarks.py. The tables cover the bounding box of the corpus with
+ * steps of 0.5 °C (0.9 °F) and 0.0005 of humidity ratio, and 9 pressures; the time to build them
+ * is reported. The deviation is the maximum absolute difference from the exact functions over the
+ * points of the corpus; for the dew-point temperature it is dominated by the driest points, where
+ * it varies as the logarithm of the humidity ratio. The points of the corpus are in random order,
+ * so that most lookups read nodes that are not in the caches. Prints a Markdown table.
+ * Usage: bench_psychrolib_table <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_table.h"
+
+static const char *PROPERTY_NAMES[PSYCHRO_TABLE_N_PROPERTIES] =
+{
+  "MoistAirDensity", "MoistAirEnthalpy", "MoistAirVolume", "TWetBulb", "TDewPoint", "RelHum"
+};
+
+static size_t N;
+static double *TDryBulb, *HumRatio, *Pressure, *Value;
+static const PsychroTable *Table;
+
+// Exact property of all points
+static void Exact(int p)
+{
+  size_t i;
+
+  for (i = 0; i < N; i++)
+    switch (p)
+    {
+      case PSYCHRO_TABLE_MOIST_AIR_DENSITY: Value[i] = GetMoistAirDensity(TDryBulb[i], HumRatio[i], Pressure[i]); break;
+      case PSYCHRO_TABLE_MOIST_AIR_ENTHALPY: Value[i] = GetMoistAirEnthalpy(TDryBulb[i], HumRatio[i]); break;
+      case PSYCHRO_TABLE_MOIST_AIR_VOLUME: Value[i] = GetMoistAirVolume(TDryBulb[i], HumRatio[i], Pressure[i]); break;
+      case PSYCHRO_TABLE_TWET_BULB: Value[i] = GetTWetBulbFromHumRatio(TDryBulb[i], HumRatio[i], Pressure[i]); break;
+      case PSYCHRO_TABLE_TDEW_POINT: Value[i] = GetTDewPointFromHumRatio(TDryBulb[i], HumRatio[i], Pressure[i]); break;
+      default: Value[i] = GetRelHumFromHumRatio(TDryBulb[i], HumRatio[i], Pressure[i]);
+    }
+}
+
+// Interpolated property of all points
+static void Lookup(int p)
+{
+  PsychroTableLookupBatch(Table, p, N, TDryBulb, HumRatio, Pressure, Value);
+}
+
+// Time per point in ns, doubling the passes until the minimum time is reached
+static double Time(void (*Run)(int), int p, double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run(p);
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e9 * Elapsed / ((double) Passes * N);
+    Passes *= 2;
+  }
+}
+
+// Maximum absolute deviation of the values from the reference
+static double MaxDeviation(const double *Reference)
+{
+  double Deviation = 0.;
+  size_t i;
+
+  for (i = 0; i < N; i++)
+    Deviation = fmax(Deviation, fabs(Value[i] - Reference[i]));
+  return Deviation;
+}
+
+int main(int argc, char *argv[])
+{
+  const double *Row;
+  double *Corpus, *Reference, BuildTime[2], LookupTime[2], Deviation[2], ExactTime, TStep, Start;
+  static struct PsychroTableConfig Config;
+  PsychroTable *Tables[2];
+  size_t i, NRows, r;
+  int p, k;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+  TStep = isIP() ? 0.9 : 0.5;
+
+  Corpus = ReadCorpus(argv[2], &NRows);
+  TDryBulb = Allocate(NRows * sizeof(double));
+  HumRatio = Allocate(NRows * sizeof(double));
+  Pressure = Allocate(NRows * sizeof(double));
+  for (r = 0; r < NRows; r++)
+  {
+    Row = &Corpus[r * CORPUS_COLUMNS];
+    TDryBulb[N] = Row[0];
+    Pressure[N] = Row[2];
+    HumRatio[N] = Row[4];
+    N++;
+  }
+  free(Corpus);
+  Value = malloc(N * sizeof(double));
+  Reference = malloc(N * sizeof(double));
+
+  // Bounding box of the corpus, on the grid of the steps
+  Config.TDryBulb.Min = Config.TDryBulb.Max = TDryBulb[0];
+  Config.HumRatio.Min = Config.HumRatio.Max = HumRatio[0];
+  Config.Pressure.Min = Config.Pressure.Max = Pressure[0];
+  for (i = 1; i < N; i++)
+  {
+    Config.TDryBulb.Min = fmin(Config.TDryBulb.Min, TDryBulb[i]);
+    Config.TDryBulb.Max = fmax(Config.TDryBulb.Max, TDryBulb[i]);
+    Config.HumRatio.Min = fmin(Config.HumRatio.Min, HumRatio[i]);
+    Config.HumRatio.Max = fmax(Config.HumRatio.Max, HumRatio[i]);
+    Config.Pressure.Min = fmin(Config.Pressure.Min, Pressure[i]);
+    Config.Pressure.Max = fmax(Config.Pressure.Max, Pressure[i]);
+  }
+  Config.TDryBulb.Min = TStep * floor(Config.TDryBulb.Min / TStep);
+  Config.TDryBulb.Count = (size_t) ceil(Config.TDryBulb.Max / TStep - Config.TDryBulb.Min / TStep) + 1;
+  Config.TDryBulb.Max = Config.TDryBulb.Min + TStep * (Config.TDryBulb.Count - 1);
+  Config.HumRatio.Count = (size_t) ceil((Config.HumRatio.Max - Config.HumRatio.Min) / 0.0005) + 1;
+  Config.HumRatio.Max = Config.HumRatio.Min + 0.0005 * (Config.HumRatio.Count - 1);
+  Config.Pressure.Count = 9;
+  Config.Properties = (1u << PSYCHRO_TABLE_N_PROPERTIES) - 1;
+
+  for (k = 0; k < 2; k++)
+  {
+    Config.Interpolation = k == 0 ? PSYCHRO_TABLE_TRILINEAR : PSYCHRO_TABLE_CUBIC;
+    Start = Now();
+    Tables[k] = PsychroTableCreate(&Config);
+    BuildTime[k] = Now() - Start;
+    if (Tables[k] == NULL)
+    {
+      fprintf(stderr, "Cannot create table\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  printf("Property tables of %zu x %zu x %zu nodes over the corpus, %zu points. Built in %.2f s (trilinear) "
+    "and %.2f s (cubic), including the error report.\n\n", Config.TDryBulb.Count, Config.HumRatio.Count,
+    Config.Pressure.Count, N, BuildTime[0], BuildTime[1]);
+  printf("| Property | Exact (ns/point) | Trilinear (ns/point) | Speedup | Cubic (ns/point) | Speedup "
+    "| Max deviation trilinear | Max deviation cubic |\n");
+  printf("|---|---:|---:|---:|---:|---:|---:|---:|\n");
+  for (p = 0; p < PSYCHRO_TABLE_N_PROPERTIES; p++)
+  {
+    Exact(p);
+    memcpy(Reference, Value, N * sizeof(double));
+    for (k = 0; k < 2; k++)
+    {
+      Table = Tables[k];
+      Lookup(p);
+      Deviation[k] = MaxDeviation(Reference);
+    }
+    ExactTime = Time(Exact, p, atof(argv[3]));
+    for (k = 0; k < 2; k++)
+    {
+      Table = Tables[k];
+      LookupTime[k] = Time(Lookup, p, atof(argv[3]));
+    }
+    printf("| %s | %.1f | %.1f | %.1f | %.1f | %.1f | %.2e | %.2e |\n", PROPERTY_NAMES[p], ExactTime,
+      LookupTime[0], ExactTime / LookupTime[0], LookupTime[1], ExactTime / LookupTime[1], Deviation[0], Deviation[1]);
+  }
+
+  PsychroTableDestroy(Tables[0]);
+  PsychroTableDestroy(Tables[1]);
+  free(TDryBulb);
+  free(HumRatio);
+  free(Pressure);
+  free(Value);
+  free(Reference);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,187 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Time per point of the propagation of sensor uncertainties (0.2 °C, 2% and 100 Pa, or 0.36 °F,
+ * 2% and 0.0145 psi, rectangular and uncorrelated) with 10000 samples to the wet-bulb and dew-point
+ * temperatures and the enthalpy of the first 32 points of the corpus with a relative humidity
+ * between 10% and 95%: row-by-row calls of CalcPsychrometricsFromRelHum on the perturbed inputs,
+ * with all samples stored and sorted for the 2.5% and 97.5% percentiles, against
+ * PsychroUncertaintyPropagate in the calling thread and in 4 threads. Also prints the maximum
+ * difference between the 95% intervals of both, relative to their widths. Prints a Markdown table.
+ * Usage: bench_psychrolib_uncertainty <SI|IP> <corpus.csv> <min-time>
+ */
+
+#include "bench_common.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_uncertainty.h"
+
+#define N_POINTS 32
+#define N_SAMPLES 10000
+#define N_OUTPUTS 3
+
+static const int OUTPUTS[N_OUTPUTS] = { PSYCHRO_UNC_TWET_BULB, PSYCHRO_UNC_TDEW_POINT, PSYCHRO_UNC_MOIST_AIR_ENTHALPY };
+
+static double TDryBulb[N_POINTS], RelHum[N_POINTS], Pressure[N_POINTS], *Samples[N_OUTPUTS];
+static double Intervals[2][N_POINTS][N_OUTPUTS][2];
+static struct PsychroUncertaintyConfig Config;
+static struct PsychroUncertaintyResult Results[N_POINTS];
+
+static int Compare(const void *a, const void *b)
+{
+  double x = *(const double *) a, y = *(const double *) b;
+  return (x > y) - (x < y);
+}
+
+// Standard normal variate from a xorshift generator and the Box-Muller transform
+static double Normal(uint64_t *State)
+{
+  double u[2];
+  int i;
+
+  for (i = 0; i < 2; i++)
+  {
+    *State ^= *State << 13;
+    *State ^= *State >> 7;
+    *State ^= *State << 17;
+    u[i] = ((*State >> 11) + 1.) / 9007199254740993.;
+  }
+  return sqrt(-2. * log(u[0])) * cos(6.283185307179586 * u[1]);
+}
+
+// Row-by-row calls, samples stored and sorted
+static void RowByRow(unsigned Threads)
+{
+  double Out[7];
+  uint64_t State = 39;
+  size_t i, s;
+  int k;
+
+  (void) Threads;
+  for (i = 0; i < N_POINTS; i++)
+  {
+    for (s = 0; s < N_SAMPLES; s++)
+    {
+      double RH = RelHum[i] + Config.StdDev[1] * Normal(&State);
+      CalcPsychrometricsFromRelHum(TDryBulb[i] + Config.StdDev[0] * Normal(&State), fmin(fmax(RH, 0.01), 1.),
+        Pressure[i] + Config.StdDev[2] * Normal(&State), &Out[0], &Out[1], &Out[2], &Out[3], &Out[4], &Out[5], &Out[6]);
+      for (k = 0; k < N_OUTPUTS; k++)
+        Samples[k][s] = Out[OUTPUTS[k]];
+    }
+    for (k = 0; k < N_OUTPUTS; k++)
+    {
+      qsort(Samples[k], N_SAMPLES, sizeof(double), Compare);
+      Intervals[0][i][k][0] = Samples[k][(size_t) (0.025 * (N_SAMPLES - 1))];
+      Intervals[0][i][k][1] = Samples[k][(size_t) (0.975 * (N_SAMPLES - 1))];
+    }
+  }
+}
+
+// Uncertainty engine
+static void Engine(unsigned Threads)
+{
+  size_t i;
+  int k;
+
+  Config.Threads = Threads;
+  PsychroUncertaintyPropagate(&Config, N_POINTS, TDryBulb, RelHum, Pressure, Results);
+  for (i = 0; i < N_POINTS; i++)
+    for (k = 0; k < N_OUTPUTS; k++)
+    {
+      Intervals[1][i][k][0] = Results[i].Quantiles[OUTPUTS[k]][0];
+      Intervals[1][i][k][1] = Results[i].Quantiles[OUTPUTS[k]][1];
+    }
+}
+
+// Time per point in ms, doubling the passes until the minimum time is reached
+static double Time(void (*Run)(unsigned), unsigned Threads, double MinTime)
+{
+  long Passes = 1, r;
+  double Start, Elapsed;
+
+  for (;;)
+  {
+    Start = Now();
+    for (r = 0; r < Passes; r++)
+      Run(Threads);
+    Elapsed = Now() - Start;
+    if (Elapsed >= MinTime)
+      return 1e3 * Elapsed / ((double) Passes * N_POINTS);
+    Passes *= 2;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  const double *Row;
+  double *Corpus, RowTime, Time1, Time4, Deviation = 0., Width;
+  size_t i, N = 0, NRows, r;
+  int k, e;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <SI|IP> <corpus.csv> <min-time>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[1], "IP") == 0 ? IP : SI);
+
+  Corpus = ReadCorpus(argv[2], &NRows);
+  for (r = 0; r < NRows && N < N_POINTS; r++)
+  {
+    Row = &Corpus[r * CORPUS_COLUMNS];
+    if (Row[1] < 0.1 || Row[1] > 0.95)
+      continue;
+    TDryBulb[N] = Row[0];
+    RelHum[N] = Row[1];
+    Pressure[N] = Row[2];
+    N++;
+  }
+  free(Corpus);
+  if (N < N_POINTS)
+  {
+    fprintf(stderr, "Not enough points in corpus: %s\n", argv[2]);
+    return EXIT_FAILURE;
+  }
+  for (k = 0; k < N_OUTPUTS; k++)
+    Samples[k] = malloc(N_SAMPLES * sizeof(double));
+
+  Config.StdDev[0] = (isIP() ? 0.36 : 0.2) / sqrt(3.);
+  Config.StdDev[1] = 0.02 / sqrt(3.);
+  Config.StdDev[2] = (isIP() ? 0.0145 : 100.) / sqrt(3.);
+  for (k = 0; k < 3; k++)
+    Config.Correlation[k][k] = 1.;
+  Config.Samples = N_SAMPLES;
+  Config.NQuantiles = 2;
+  Config.Probabilities[0] = 0.025;
+  Config.Probabilities[1] = 0.975;
+  Config.Seed = 39;
+
+  RowTime = Time(RowByRow, 1, atof(argv[3]));
+  Time1 = Time(Engine, 1, atof(argv[3]));
+  Time4 = Time(Engine, 4, atof(argv[3]));
+  for (i = 0; i < N_POINTS; i++)
+    for (k = 0; k < N_OUTPUTS; k++)
+    {
+      Width = Intervals[0][i][k][1] - Intervals[0][i][k][0];
+      for (e = 0; e < 2; e++)
+        Deviation = fmax(Deviation, fabs(Intervals[1][i][k][e] - Intervals[0][i][k][e]) / Width);
+    }
+
+  printf("Propagation of sensor uncertainties with %d samples per point, %d points.\n\n", N_SAMPLES, N_POINTS);
+  printf("| Approach | Time per point (ms) | Speedup |\n");
+  printf("|---|---:|---:|\n");
+  printf("| Row by row, stored and sorted | %.2f | 1.0 |\n", RowTime);
+  printf("| Engine, 1 thread | %.2f | %.1f |\n", Time1, RowTime / Time1);
+  printf("| Engine, 4 threads | %.2f | %.1f |\n\n", Time4, RowTime / Time4);
+  printf("Maximum difference between the 95%% intervals, relative to their width: %.3f\n", Deviation);
+
+  for (k = 0; k < N_OUTPUTS; k++)
+    free(Samples[k]);
+  return EXIT_SUCCESS;
+}
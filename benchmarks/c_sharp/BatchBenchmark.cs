@@ -0,0 +1,146 @@
+// PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+// Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+//
+// Comparison of the span-based batch functions of psychrolib_batch.cs with the scalar functions
+// called row by row, sequentially and in parallel, run by benchmarks/run_benchmarks.py.
+// Usage: dotnet PsychroLib.Bench.dll batch <SI|IP> <corpus.csv> <min-time>
+
+using System;
+using System.Diagnostics;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+
+namespace PsychroLib.Bench
+{
+    public static class BatchBenchmark
+    {
+        private const int N_OUTPUTS = 7;
+
+        private static Psychrometrics psy;
+        private static double[] tDryBulb, relHum, pressure;
+        private static double[][] outputs;
+        private static BatchStatus[] status;
+
+        private static void SatHumRatioScalar()
+        {
+            for (var i = 0; i < tDryBulb.Length; i++)
+                outputs[0][i] = psy.GetSatHumRatio(tDryBulb[i], pressure[i]);
+        }
+
+        private static void SatHumRatioBatch()
+        {
+            psy.GetSatHumRatio(tDryBulb, pressure, outputs[0], status);
+        }
+
+        private static void CalcFromRelHumScalar()
+        {
+            for (var i = 0; i < tDryBulb.Length; i++)
+            {
+                var value = psy.CalcPsychrometricsFromRelHum(tDryBulb[i], relHum[i], pressure[i]);
+                outputs[0][i] = value.HumRatio;
+                outputs[1][i] = value.TWetBulb;
+                outputs[2][i] = value.TDewPoint;
+                outputs[3][i] = value.VapPres;
+                outputs[4][i] = value.MoistAirEnthalpy;
+                outputs[5][i] = value.MoistAirVolume;
+                outputs[6][i] = value.DegreeOfSaturation;
+            }
+        }
+
+        private static void CalcFromRelHumBatch()
+        {
+            psy.CalcPsychrometricsFromRelHum(tDryBulb, relHum, pressure, outputs[0], outputs[1], outputs[2],
+                outputs[3], outputs[4], outputs[5], outputs[6], status);
+        }
+
+        private static void CalcFromRelHumParallel()
+        {
+            psy.CalcPsychrometricsFromRelHumParallel(tDryBulb, relHum, pressure, outputs[0], outputs[1], outputs[2],
+                outputs[3], outputs[4], outputs[5], outputs[6], status);
+        }
+
+        /// <summary>
+        /// Time in ns per row of a function; passes over the rows are doubled until the minimum time is reached.
+        /// </summary>
+        private static double Time(Action function, double minTime)
+        {
+            long passes = 1;
+            while (true)
+            {
+                var watch = Stopwatch.StartNew();
+                for (long p = 0; p < passes; p++)
+                    function();
+                var elapsed = watch.Elapsed.TotalSeconds;
+                if (elapsed >= minTime)
+                    return 1e9 * elapsed / (passes * tDryBulb.Length);
+                passes *= 2;
+            }
+        }
+
+        /// <summary>
+        /// Maximum absolute deviation of the outputs of a batch function from those of the scalar function.
+        /// </summary>
+        private static double Deviation(Action scalar, Action batch, int nOutputs)
+        {
+            scalar();
+            var expected = outputs.Take(nOutputs).Select(o => (double[])o.Clone()).ToArray();
+            batch();
+            var deviation = 0.0;
+            for (var o = 0; o < nOutputs; o++)
+                for (var i = 0; i < tDryBulb.Length; i++)
+                    deviation = Math.Max(deviation, Math.Abs(outputs[o][i] - expected[o][i]));
+            return deviation;
+        }
+
+        public static int Run(string[] args)
+        {
+            if (args.Length != 3)
+            {
+                Console.Error.WriteLine("Usage: PsychroLib.Bench batch <SI|IP> <corpus.csv> <min-time>");
+                return 1;
+            }
+
+            psy = new Psychrometrics(args[0] == "IP" ? UnitSystem.IP : UnitSystem.SI);
+            var corpus = File.ReadLines(args[1]).Skip(1)
+                .Select(line => line.Split(',').Select(v => double.Parse(v, CultureInfo.InvariantCulture)).ToArray())
+                .ToArray();
+            var minTime = double.Parse(args[2], CultureInfo.InvariantCulture);
+
+            tDryBulb = corpus.Select(row => row[0]).ToArray();
+            relHum = corpus.Select(row => row[1]).ToArray();
+            pressure = corpus.Select(row => row[2]).ToArray();
+            outputs = Enumerable.Range(0, N_OUTPUTS).Select(o => new double[corpus.Length]).ToArray();
+            status = new BatchStatus[corpus.Length];
+
+            var functions = new (string Name, Action Scalar, Action Batch, Action Parallel, int NOutputs)[]
+            {
+                ("GetSatHumRatio", SatHumRatioScalar, SatHumRatioBatch, null, 1),
+                ("CalcPsychrometricsFromRelHum", CalcFromRelHumScalar, CalcFromRelHumBatch, CalcFromRelHumParallel,
+                    N_OUTPUTS),
+            };
+
+            Console.WriteLine("{0} rows, parallel from {1} rows on {2} processors.", corpus.Length,
+                psy.ParallelThreshold, Environment.ProcessorCount);
+            Console.WriteLine();
+            Console.WriteLine("| Function | Scalar (ns/row) | Batch (ns/row) | Parallel (ns/row) | Speedup | Max deviation |");
+            Console.WriteLine("|---|---:|---:|---:|---:|---:|");
+            foreach (var (name, scalar, batch, parallel, nOutputs) in functions)
+            {
+                var deviation = Deviation(scalar, batch, nOutputs);
+                if (parallel != null)
+                    deviation = Math.Max(deviation, Deviation(scalar, parallel, nOutputs));
+
+                var scalarTime = Time(scalar, minTime);
+                var batchTime = Time(batch, minTime);
+                var parallelTime = parallel != null ? Time(parallel, minTime) : double.NaN;
+                var bestTime = parallel != null ? Math.Min(batchTime, parallelTime) : batchTime;
+                Console.WriteLine(string.Format(CultureInfo.InvariantCulture,
+                    "| {0} | {1:F1} | {2:F1} | {3} | {4:F1} | {5:0.00e+00} |", name, scalarTime, batchTime,
+                    parallel != null ? parallelTime.ToString("F1", CultureInfo.InvariantCulture) : "-",
+                    scalarTime / bestTime, deviation));
+            }
+            return 0;
+        }
+    }
+}
@@ -0,0 +1,104 @@
+// PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+// Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+//
+// Benchmark driver of the C# implementation, run by benchmarks/run_benchmarks.py.
+// Usage: dotnet PsychroLib.Bench.dll <SI|IP> <corpus.csv> <values.csv> <timings.csv> <min-time>
+// The first argument batch selects the comparison of the batch functions of BatchBenchmark.cs.
+
+using System;
+using System.Diagnostics;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+using System.Text;
+
+namespace PsychroLib.Bench
+{
+    public static class Program
+    {
+        private static readonly string[] FunctionNames =
+        {
+            "GetSatVapPres", "GetSatHumRatio", "GetHumRatioFromRelHum", "GetTDewPointFromRelHum",
+            "GetTWetBulbFromRelHum", "GetRelHumFromTWetBulb", "GetTDewPointFromHumRatio",
+            "GetTWetBulbFromHumRatio", "GetMoistAirEnthalpy", "GetMoistAirVolume",
+            "GetTDryBulbFromEnthalpyAndHumRatio"
+        };
+
+        // Columns of the corpus
+        private const int TDryBulb = 0, RelHum = 1, Pressure = 2, TWetBulb = 3, HumRatio = 4, MoistAirEnthalpy = 5;
+
+        /// <summary>
+        /// Evaluate function f on a row of the corpus.
+        /// </summary>
+        private static double Evaluate(Psychrometrics psy, int f, double[] row)
+        {
+            switch (f)
+            {
+                case 0: return psy.GetSatVapPres(row[TDryBulb]);
+                case 1: return psy.GetSatHumRatio(row[TDryBulb], row[Pressure]);
+                case 2: return psy.GetHumRatioFromRelHum(row[TDryBulb], row[RelHum], row[Pressure]);
+                case 3: return psy.GetTDewPointFromRelHum(row[TDryBulb], row[RelHum]);
+                case 4: return psy.GetTWetBulbFromRelHum(row[TDryBulb], row[RelHum], row[Pressure]);
+                case 5: return psy.GetRelHumFromTWetBulb(row[TDryBulb], row[TWetBulb], row[Pressure]);
+                case 6: return psy.GetTDewPointFromHumRatio(row[TDryBulb], row[HumRatio], row[Pressure]);
+                case 7: return psy.GetTWetBulbFromHumRatio(row[TDryBulb], row[HumRatio], row[Pressure]);
+                case 8: return psy.GetMoistAirEnthalpy(row[TDryBulb], row[HumRatio]);
+                case 9: return psy.GetMoistAirVolume(row[TDryBulb], row[HumRatio], row[Pressure]);
+                default: return psy.GetTDryBulbFromEnthalpyAndHumRatio(row[MoistAirEnthalpy], row[HumRatio]);
+            }
+        }
+
+        public static int Main(string[] args)
+        {
+            if (args.Length > 0 && args[0] == "batch")
+                return BatchBenchmark.Run(args.Skip(1).ToArray());
+
+            if (args.Length != 5)
+            {
+                Console.Error.WriteLine("Usage: PsychroLib.Bench <SI|IP> <corpus.csv> <values.csv> <timings.csv> <min-time>");
+                return 1;
+            }
+
+            var psy = new Psychrometrics(args[0] == "IP" ? UnitSystem.IP : UnitSystem.SI);
+            var corpus = File.ReadLines(args[1]).Skip(1)
+                .Select(line => line.Split(',').Select(v => double.Parse(v, CultureInfo.InvariantCulture)).ToArray())
+                .ToArray();
+            var minTime = double.Parse(args[4], CultureInfo.InvariantCulture);
+
+            var values = new StringBuilder();
+            values.AppendLine(string.Join(",", FunctionNames));
+            foreach (var row in corpus)
+                values.AppendLine(string.Join(",", Enumerable.Range(0, FunctionNames.Length)
+                    .Select(f => Evaluate(psy, f, row).ToString("R", CultureInfo.InvariantCulture))));
+            File.WriteAllText(args[2], values.ToString());
+
+            // Timings: passes over the corpus are doubled until the minimum time is reached
+            var timings = new StringBuilder();
+            timings.AppendLine("Function,Calls,Seconds");
+            var sink = 0.0;
+            for (var f = 0; f < FunctionNames.Length; f++)
+            {
+                long passes = 1;
+                double elapsed;
+                while (true)
+                {
+                    var watch = Stopwatch.StartNew();
+                    for (long r = 0; r < passes; r++)
+                        foreach (var row in corpus)
+                            sink += Evaluate(psy, f, row);
+                    elapsed = watch.Elapsed.TotalSeconds;
+                    if (elapsed >= minTime)
+                        break;
+                    passes *= 2;
+                }
+                timings.AppendLine(string.Format(CultureInfo.InvariantCulture, "{0},{1},{2:R}",
+                    FunctionNames[f], passes * corpus.Length, elapsed));
+            }
+            File.WriteAllText(args[3], timings.ToString());
+
+            if (double.IsNaN(sink))
+                Console.WriteLine(sink);
+            return 0;
+        }
+    }
+}
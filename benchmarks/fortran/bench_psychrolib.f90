@@ -0,0 +1,143 @@
+! PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+! Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+!
+! Benchmark driver of the Fortran implementation, run by benchmarks/run_benchmarks.py.
+! Usage: bench_psychrolib <SI|IP> <corpus.csv> <values.csv> <timings.csv> <min-time>
+!
+! The Fortran implementation is in single precision, its deviations from the C implementation
+! are therefore expected to be of the order of the single precision epsilon.
+
+program bench_psychrolib
+  use psychrolib, only: SetUnitSystem, SI, IP,                                                              &
+                        GetSatVapPres, GetSatHumRatio, GetHumRatioFromRelHum, GetTDewPointFromRelHum,       &
+                        GetTWetBulbFromRelHum, GetRelHumFromTWetBulb, GetTDewPointFromHumRatio,             &
+                        GetTWetBulbFromHumRatio, GetMoistAirEnthalpy, GetMoistAirVolume,                    &
+                        GetTDryBulbFromEnthalpyAndHumRatio
+  use, intrinsic :: iso_fortran_env, only: int64, real64
+  implicit none
+
+  integer, parameter :: N_COLUMNS = 6
+  integer, parameter :: N_FUNCTIONS = 11
+  integer, parameter :: TDRYBULB = 1, RELHUM = 2, PRESSURE = 3, TWETBULB = 4, HUMRATIO = 5, MOISTAIRENTHALPY = 6
+  character(len=*), dimension(N_FUNCTIONS), parameter :: FUNCTION_NAMES = [character(len=34) ::             &
+    "GetSatVapPres", "GetSatHumRatio", "GetHumRatioFromRelHum", "GetTDewPointFromRelHum",                   &
+    "GetTWetBulbFromRelHum", "GetRelHumFromTWetBulb", "GetTDewPointFromHumRatio",                           &
+    "GetTWetBulbFromHumRatio", "GetMoistAirEnthalpy", "GetMoistAirVolume",                                  &
+    "GetTDryBulbFromEnthalpyAndHumRatio"]
+
+  character(len=512) :: units, corpus_path, values_path, timings_path, arg
+  real(real64), allocatable :: corpus64(:, :)
+  real, allocatable :: corpus(:, :), values(:, :)
+  real(real64) :: min_time, elapsed
+  real :: sink
+  integer :: n_rows, i, f, unit, ios
+  integer(int64) :: passes, r, start, finish, rate
+
+  if (command_argument_count() /= 5) then
+    error stop "Usage: bench_psychrolib <SI|IP> <corpus.csv> <values.csv> <timings.csv> <min-time>"
+  end if
+  call get_command_argument(1, units)
+  call get_command_argument(2, corpus_path)
+  call get_command_argument(3, values_path)
+  call get_command_argument(4, timings_path)
+  call get_command_argument(5, arg)
+  read (arg, *) min_time
+
+  if (trim(units) == "IP") then
+    call SetUnitSystem(IP)
+  else
+    call SetUnitSystem(SI)
+  end if
+
+  ! Read the corpus: count the rows, then read them
+  open (newunit=unit, file=corpus_path, status="old", action="read")
+  n_rows = -1
+  do
+    read (unit, *, iostat=ios)
+    if (ios /= 0) exit
+    n_rows = n_rows + 1
+  end do
+  allocate(corpus64(N_COLUMNS, n_rows), corpus(N_COLUMNS, n_rows), values(N_FUNCTIONS, n_rows))
+  rewind (unit)
+  read (unit, *)
+  do i = 1, n_rows
+    read (unit, *) corpus64(:, i)
+  end do
+  close (unit)
+  corpus = real(corpus64)
+
+  ! Values of each function on each row
+  do i = 1, n_rows
+    do f = 1, N_FUNCTIONS
+      values(f, i) = Evaluate(f, corpus(:, i))
+    end do
+  end do
+
+  open (newunit=unit, file=values_path, status="replace", action="write")
+  write (unit, "(*(a, :, ','))") (trim(FUNCTION_NAMES(f)), f = 1, N_FUNCTIONS)
+  do i = 1, n_rows
+    write (unit, "(*(es16.9, :, ','))") values(:, i)
+  end do
+  close (unit)
+
+  ! Timings: passes over the corpus are doubled until the minimum time is reached
+  open (newunit=unit, file=timings_path, status="replace", action="write")
+  write (unit, "(a)") "Function,Calls,Seconds"
+  sink = 0.0
+  call system_clock(count_rate=rate)
+  do f = 1, N_FUNCTIONS
+    passes = 1
+    do
+      call system_clock(start)
+      do r = 1, passes
+        do i = 1, n_rows
+          sink = sink + Evaluate(f, corpus(:, i))
+        end do
+      end do
+      call system_clock(finish)
+      elapsed = real(finish - start, real64) / real(rate, real64)
+      if (elapsed >= min_time) exit
+      passes = passes * 2
+    end do
+    write (unit, "(a, ',', i0, ',', es16.9)") trim(FUNCTION_NAMES(f)), passes * n_rows, elapsed
+  end do
+  close (unit)
+
+  ! Prevent the timed loops from being optimised away
+  if (sink /= sink) print *, sink
+
+contains
+
+  ! Evaluate function f on a row of the corpus
+  function Evaluate(f, row) result(value)
+    integer, intent(in) :: f
+    real, dimension(N_COLUMNS), intent(in) :: row
+    real :: value
+
+    select case (f)
+    case (1)
+      value = GetSatVapPres(row(TDRYBULB))
+    case (2)
+      value = GetSatHumRatio(row(TDRYBULB), row(PRESSURE))
+    case (3)
+      value = GetHumRatioFromRelHum(row(TDRYBULB), row(RELHUM), row(PRESSURE))
+    case (4)
+      value = GetTDewPointFromRelHum(row(TDRYBULB), row(RELHUM))
+    case (5)
+      value = GetTWetBulbFromRelHum(row(TDRYBULB), row(RELHUM), row(PRESSURE))
+    case (6)
+      value = GetRelHumFromTWetBulb(row(TDRYBULB), row(TWETBULB), row(PRESSURE))
+    case (7)
+      value = GetTDewPointFromHumRatio(row(TDRYBULB), row(HUMRATIO), row(PRESSURE))
+    case (8)
+      value = GetTWetBulbFromHumRatio(row(TDRYBULB), row(HUMRATIO), row(PRESSURE))
+    case (9)
+      value = GetMoistAirEnthalpy(row(TDRYBULB), row(HUMRATIO))
+    case (10)
+      value = GetMoistAirVolume(row(TDRYBULB), row(HUMRATIO), row(PRESSURE))
+    case default
+      value = GetTDryBulbFromEnthalpyAndHumRatio(row(MOISTAIRENTHALPY), row(HUMRATIO))
+    end select
+  end function Evaluate
+
+end program bench_psychrolib
@@ -0,0 +1,73 @@
+// PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+// Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+//
+// Benchmark driver of the JavaScript implementation, run by benchmarks/run_benchmarks.py.
+// Usage: node bench_psychrolib.js <SI|IP> <corpus.csv> <values.csv> <timings.csv> <min-time>
+
+var fs = require('fs');
+var path = require('path');
+var psyjs = require(path.join(__dirname, '..', '..', 'src', 'js', 'psychrolib.js'));
+
+var FUNCTIONS = [
+    ['GetSatVapPres', ['TDryBulb']],
+    ['GetSatHumRatio', ['TDryBulb', 'Pressure']],
+    ['GetHumRatioFromRelHum', ['TDryBulb', 'RelHum', 'Pressure']],
+    ['GetTDewPointFromRelHum', ['TDryBulb', 'RelHum']],
+    ['GetTWetBulbFromRelHum', ['TDryBulb', 'RelHum', 'Pressure']],
+    ['GetRelHumFromTWetBulb', ['TDryBulb', 'TWetBulb', 'Pressure']],
+    ['GetTDewPointFromHumRatio', ['TDryBulb', 'HumRatio', 'Pressure']],
+    ['GetTWetBulbFromHumRatio', ['TDryBulb', 'HumRatio', 'Pressure']],
+    ['GetMoistAirEnthalpy', ['TDryBulb', 'HumRatio']],
+    ['GetMoistAirVolume', ['TDryBulb', 'HumRatio', 'Pressure']],
+    ['GetTDryBulbFromEnthalpyAndHumRatio', ['MoistAirEnthalpy', 'HumRatio']]
+];
+
+function main(units, corpusPath, valuesPath, timingsPath, minTime) {
+    psyjs.SetUnitSystem(units === 'IP' ? psyjs.IP : psyjs.SI);
+
+    var lines = fs.readFileSync(corpusPath, 'utf8').trim().split('\n');
+    var header = lines[0].split(',');
+    var corpus = lines.slice(1).map(function (line) { return line.split(',').map(Number); });
+
+    // Arguments of each function on each row
+    var args = FUNCTIONS.map(function (f) {
+        var columns = f[1].map(function (name) { return header.indexOf(name); });
+        return corpus.map(function (row) { return columns.map(function (c) { return row[c]; }); });
+    });
+    var functions = FUNCTIONS.map(function (f) { return psyjs[f[0]].bind(psyjs); });
+
+    var columns = functions.map(function (fn, f) {
+        return args[f].map(function (a) { return fn.apply(null, a); });
+    });
+    var out = [FUNCTIONS.map(function (f) { return f[0]; }).join(',')];
+    for (var i = 0; i < corpus.length; i++)
+        out.push(columns.map(function (column) { return column[i].toPrecision(17); }).join(','));
+    fs.writeFileSync(valuesPath, out.join('\n') + '\n');
+
+    // Timings: passes over the corpus are doubled until the minimum time is reached
+    var timings = ['Function,Calls,Seconds'];
+    var sink = 0;
+    functions.forEach(function (fn, f) {
+        var passes = 1, elapsed;
+        for (;;) {
+            var start = process.hrtime.bigint();
+            for (var r = 0; r < passes; r++)
+                for (var i = 0; i < args[f].length; i++)
+                    sink += fn.apply(null, args[f][i]);
+            elapsed = Number(process.hrtime.bigint() - start) * 1e-9;
+            if (elapsed >= minTime)
+                break;
+            passes *= 2;
+        }
+        timings.push(FUNCTIONS[f][0] + ',' + passes * corpus.length + ',' + elapsed);
+    });
+    fs.writeFileSync(timingsPath, timings.join('\n') + '\n');
+    if (isNaN(sink))
+        console.log(sink);
+}
+
+if (process.argv.length !== 7) {
+    console.error('Usage: node bench_psychrolib.js <SI|IP> <corpus.csv> <values.csv> <timings.csv> <min-time>');
+    process.exit(1);
+}
+main(process.argv[2], process.argv[3], process.argv[4], process.argv[5], Number(process.argv[6]));
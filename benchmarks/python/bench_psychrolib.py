@@ -0,0 +1,67 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+"""Benchmark driver of the Python implementation, run by benchmarks/run_benchmarks.py.
+
+Usage: python bench_psychrolib.py <SI|IP> <corpus.csv> <values.csv> <timings.csv> <min-time>
+"""
+
+import csv
+import sys
+import time
+from pathlib import Path
+
+sys.path.append(str(Path(__file__).resolve().parents[2] / 'src' / 'python'))
+import psychrolib
+
+FUNCTIONS = [
+    ('GetSatVapPres', ['TDryBulb']),
+    ('GetSatHumRatio', ['TDryBulb', 'Pressure']),
+    ('GetHumRatioFromRelHum', ['TDryBulb', 'RelHum', 'Pressure']),
+    ('GetTDewPointFromRelHum', ['TDryBulb', 'RelHum']),
+    ('GetTWetBulbFromRelHum', ['TDryBulb', 'RelHum', 'Pressure']),
+    ('GetRelHumFromTWetBulb', ['TDryBulb', 'TWetBulb', 'Pressure']),
+    ('GetTDewPointFromHumRatio', ['TDryBulb', 'HumRatio', 'Pressure']),
+    ('GetTWetBulbFromHumRatio', ['TDryBulb', 'HumRatio', 'Pressure']),
+    ('GetMoistAirEnthalpy', ['TDryBulb', 'HumRatio']),
+    ('GetMoistAirVolume', ['TDryBulb', 'HumRatio', 'Pressure']),
+    ('GetTDryBulbFromEnthalpyAndHumRatio', ['MoistAirEnthalpy', 'HumRatio']),
+]
+
+
+def main(units, corpus_path, values_path, timings_path, min_time):
+    psychrolib.SetUnitSystem(getattr(psychrolib, units))
+    with open(corpus_path, newline='') as f:
+        corpus = [{name: float(value) for name, value in row.items()} for row in csv.DictReader(f)]
+
+    # Arguments of each function on each row
+    arguments = [[tuple(row[name] for name in inputs) for row in corpus] for _, inputs in FUNCTIONS]
+    functions = [getattr(psychrolib, name) for name, _ in FUNCTIONS]
+
+    with open(values_path, 'w') as f:
+        f.write(','.join(name for name, _ in FUNCTIONS) + '\n')
+        columns = [[function(*args) for args in function_args] for function, function_args in zip(functions, arguments)]
+        for row in zip(*columns):
+            f.write(','.join('%.17g' % value for value in row) + '\n')
+
+    # Timings: passes over the corpus are doubled until the minimum time is reached
+    with open(timings_path, 'w') as f:
+        f.write('Function,Calls,Seconds\n')
+        for (name, _), function, function_args in zip(FUNCTIONS, functions, arguments):
+            passes = 1
+            while True:
+                start = time.perf_counter()
+                for _ in range(passes):
+                    for args in function_args:
+                        function(*args)
+                elapsed = time.perf_counter() - start
+                if elapsed >= min_time:
+                    break
+                passes *= 2
+            f.write('%s,%d,%.9g\n' % (name, passes * len(corpus), elapsed))
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 6:
+        sys.exit(__doc__)
+    main(sys.argv[1], sys.argv[2], sys.argv[3], sys.argv[4], float(sys.argv[5]))
@@ -0,0 +1,403 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+"""Cross-language performance and agreement benchmark of PsychroLib.
+
+Generates a shared input corpus in SI and IP units, builds and runs the driver of
+each implementation on it, and writes a consolidated report with the number of calls
+per second of each function and the maximum absolute and relative deviations from
+the results of the C implementation.
+
+Usage:
+    python benchmarks/run_benchmarks.py [--rows N] [--min-time SECONDS] [--languages C Python ...]
+
+Implementations whose toolchain is not available are skipped and reported as such.
+"""
+
+import argparse
+import csv
+import json
+import os
+import platform
+import shutil
+import subprocess
+import sys
+from pathlib import Path
+
+import numpy as np
+
+ROOT = Path(__file__).resolve().parents[1]
+BENCHMARKS = ROOT / 'benchmarks'
+SRC = ROOT / 'src'
+
+sys.path.append(str(SRC / 'python'))
+import psychrolib
+
+# Functions benchmarked by every driver, in this order, with the corpus columns they take as inputs.
+FUNCTIONS = [
+    ('GetSatVapPres', ['TDryBulb']),
+    ('GetSatHumRatio', ['TDryBulb', 'Pressure']),
+    ('GetHumRatioFromRelHum', ['TDryBulb', 'RelHum', 'Pressure']),
+    ('GetTDewPointFromRelHum', ['TDryBulb', 'RelHum']),
+    ('GetTWetBulbFromRelHum', ['TDryBulb', 'RelHum', 'Pressure']),
+    ('GetRelHumFromTWetBulb', ['TDryBulb', 'TWetBulb', 'Pressure']),
+    ('GetTDewPointFromHumRatio', ['TDryBulb', 'HumRatio', 'Pressure']),
+    ('GetTWetBulbFromHumRatio', ['TDryBulb', 'HumRatio', 'Pressure']),
+    ('GetMoistAirEnthalpy', ['TDryBulb', 'HumRatio']),
+    ('GetMoistAirVolume', ['TDryBulb', 'HumRatio', 'Pressure']),
+    ('GetTDryBulbFromEnthalpyAndHumRatio', ['MoistAirEnthalpy', 'HumRatio']),
+]
+
+CORPUS_COLUMNS = ['TDryBulb', 'RelHum', 'Pressure', 'TWetBulb', 'HumRatio', 'MoistAirEnthalpy']
+
+# Sampling domains of the corpus: dry-bulb temperature, relative humidity and altitude,
+# the pressure being the standard atmosphere pressure at the altitude.
+DOMAINS = {
+    'SI': {'TDryBulb': (-30., 50.), 'RelHum': (0.05, 1.), 'Altitude': (-300., 3000.)},
+    'IP': {'TDryBulb': (-22., 122.), 'RelHum': (0.05, 1.), 'Altitude': (-1000., 10000.)},
+}
+
+REFERENCE = 'C'
+
+# Benchmarks of the optional modules of the C library: title, source files of the driver in benchmarks/c
+# (the first one with main) and modules in src/c.
+# The drivers take the arguments <SI|IP> <corpus.csv> <min-time> and print a Markdown section; they
+# read the corpus and time the functions with the helpers of benchmarks/c/bench_common.h.
+C_MODULE_BENCHMARKS = [
+    ('Site context speedup', ['bench_psychrolib_site.c'], ['psychrolib_site.c']),
+    ('Bounded-latency functions', ['bench_psychrolib_bounded.c'], ['psychrolib_bounded.c']),
+    ('Header-only build speedup', ['bench_psychrolib_inline.c', 'bench_psychrolib_inline_loops.c'], []),
+    ('Analytic gradients', ['bench_psychrolib_gradient.c'], ['psychrolib_gradient.c']),
+    ('Property tables', ['bench_psychrolib_table.c'], ['psychrolib_table.c']),
+    ('Point sets', ['bench_psychrolib_pointset.c'], ['psychrolib_pointset.c']),
+    ('Climate statistics', ['bench_psychrolib_climate.c'], ['psychrolib_climate.c']),
+    ('Uncertainty propagation', ['bench_psychrolib_uncertainty.c'], ['psychrolib_bounded.c', 'psychrolib_uncertainty.c']),
+    ('Air processes', ['bench_psychrolib_process.c'], ['psychrolib_process.c']),
+    ('Inverse functions', ['bench_psychrolib_inverse.c'], ['psychrolib_inverse.c']),
+    ('Compute service', ['bench_psychrolib_service.c'], ['psychrolib_bounded.c', 'psychrolib_service.c']),
+    ('Streaming pipeline', ['bench_psychrolib_pipeline.c'], ['psychrolib_bounded.c', 'psychrolib_pipeline.c']),
+    ('Chart geometry', ['bench_psychrolib_chart.c'], ['psychrolib_chart.c']),
+    ('Gridded fields', ['bench_psychrolib_field.c'], ['psychrolib_bounded.c', 'psychrolib_field.c']),
+    ('Accuracy and throughput', ['bench_psychrolib_accuracy.c'], ['psychrolib_bounded.c', 'psychrolib_table.c', 'psychrolib_reference.c']),
+    ('Lock-step solvers', ['bench_psychrolib_lockstep.c'], ['psychrolib_lockstep.c']),
+    ('Regime-partitioned schedule', ['bench_psychrolib_regime.c'], ['psychrolib_regime.c']),
+    ('Columnar frames', ['bench_psychrolib_frame.c'], ['psychrolib_site.c', 'psychrolib_frame.c']),
+]
+
+
+#########################################################
+# Corpus
+#########################################################
+
+def generate_corpus(units, rows, seed, path):
+    """Write the input corpus of a system of units to a CSV file and return its rows."""
+    psychrolib.SetUnitSystem(getattr(psychrolib, units))
+    rng = np.random.default_rng(seed)
+    domain = DOMAINS[units]
+    corpus = []
+    for _ in range(rows):
+        TDryBulb = rng.uniform(*domain['TDryBulb'])
+        RelHum = rng.uniform(*domain['RelHum'])
+        Pressure = psychrolib.GetStandardAtmPressure(rng.uniform(*domain['Altitude']))
+        TWetBulb = psychrolib.GetTWetBulbFromRelHum(TDryBulb, RelHum, Pressure)
+        HumRatio = psychrolib.GetHumRatioFromRelHum(TDryBulb, RelHum, Pressure)
+        MoistAirEnthalpy = psychrolib.GetMoistAirEnthalpy(TDryBulb, HumRatio)
+        corpus.append([TDryBulb, RelHum, Pressure, TWetBulb, HumRatio, MoistAirEnthalpy])
+
+    with open(path, 'w', newline='') as f:
+        f.write(','.join(CORPUS_COLUMNS) + '\n')
+        for row in corpus:
+            f.write(','.join('%.17g' % value for value in row) + '\n')
+    return corpus
+
+
+#########################################################
+# Drivers
+#########################################################
+
+def run(command, **kwargs):
+    return subprocess.run([str(c) for c in command], check=True, capture_output=True, text=True, **kwargs)
+
+
+class Driver:
+    """Build and run the benchmark driver of one implementation.
+
+    The drivers share a command line interface:
+        <driver> <SI|IP> <corpus.csv> <values.csv> <timings.csv> <min-time>
+    values.csv has one column per function and one row per corpus row,
+    timings.csv has the columns Function, Calls and Seconds.
+    """
+    name = None
+    tools = []
+
+    def __init__(self, build_dir):
+        self.build_dir = build_dir / self.name.lower().replace('#', 'sharp')
+
+    def missing_tool(self):
+        for tool in self.tools:
+            if shutil.which(tool) is None:
+                return tool
+        return None
+
+    def build(self):
+        pass
+
+    def command(self):
+        raise NotImplementedError
+
+
+class CDriver(Driver):
+    name = 'C'
+    tools = [os.environ.get('CC', 'cc')]
+
+    def build(self):
+        self.build_dir.mkdir(parents=True, exist_ok=True)
+        self.exe = self.build_dir / 'bench_psychrolib'
+        run([self.tools[0], '-O2', '-std=c11', '-I', SRC / 'c', BENCHMARKS / 'c' / 'bench_psychrolib.c',
+             SRC / 'c' / 'psychrolib.c', '-lm', '-o', self.exe])
+
+    def command(self):
+        return [self.exe]
+
+
+class FortranDriver(Driver):
+    name = 'Fortran'
+    tools = [os.environ.get('FC', 'gfortran')]
+
+    def build(self):
+        self.build_dir.mkdir(parents=True, exist_ok=True)
+        self.exe = self.build_dir / 'bench_psychrolib'
+        run([self.tools[0], '-O2', SRC / 'fortran' / 'psychrolib.f90',
+             BENCHMARKS / 'fortran' / 'bench_psychrolib.f90', '-o', self.exe], cwd=self.build_dir)
+
+    def command(self):
+        return [self.exe]
+
+
+class PythonDriver(Driver):
+    name = 'Python'
+
+    def command(self):
+        return [sys.executable, BENCHMARKS / 'python' / 'bench_psychrolib.py']
+
+
+class JavaScriptDriver(Driver):
+    name = 'JavaScript'
+    tools = ['node']
+
+    def command(self):
+        return ['node', BENCHMARKS / 'js' / 'bench_psychrolib.js']
+
+
+class CSharpDriver(Driver):
+    name = 'C#'
+    tools = ['dotnet']
+
+    def build(self):
+        self.project = BENCHMARKS / 'c_sharp' / 'PsychroLib.Bench.csproj'
+        run(['dotnet', 'build', '-c', 'Release', '-o', self.build_dir, self.project])
+
+    def command(self):
+        return ['dotnet', self.build_dir / 'PsychroLib.Bench.dll']
+
+    def batch_command(self):
+        """Command of the comparison of the batch and scalar functions, <SI|IP> <corpus.csv> <min-time> to be appended."""
+        return self.command() + ['batch']
+
+
+class RDriver(Driver):
+    name = 'R'
+    tools = ['Rscript']
+
+    def command(self):
+        return ['Rscript', BENCHMARKS / 'r' / 'bench_psychrolib.R']
+
+
+DRIVERS = [CDriver, FortranDriver, PythonDriver, JavaScriptDriver, CSharpDriver, RDriver]
+
+
+def run_batch_benchmarks(driver, corpus_paths, min_time):
+    """Run the comparison of the batch and scalar functions of a built driver, return its output."""
+    result = {}
+    try:
+        for units in corpus_paths:
+            print('%s batch: running %s' % (driver.name, units))
+            result[units] = run(driver.batch_command() + [units, corpus_paths[units], min_time]).stdout
+    except subprocess.CalledProcessError as e:
+        result = {'error': 'failed: %s' % (e.stderr.strip().splitlines() or ['exit status %d' % e.returncode])[-1]}
+    return result
+
+
+def run_c_module_benchmarks(build_dir, corpus_paths, min_time):
+    """Build and run the benchmarks of the optional modules of the C library, return their output."""
+    results = {}
+    compiler = CDriver.tools[0]
+    if shutil.which(compiler) is None:
+        return results
+    build_dir.mkdir(parents=True, exist_ok=True)
+    for title, drivers, modules in C_MODULE_BENCHMARKS:
+        exe = build_dir / Path(drivers[0]).stem
+        result = results[title] = {}
+        try:
+            print('%s: building' % title)
+            run([compiler, '-O2', '-std=c11', '-I', SRC / 'c'] + [BENCHMARKS / 'c' / driver for driver in drivers]
+                + [SRC / 'c' / 'psychrolib.c'] + [SRC / 'c' / module for module in modules] + ['-lm', '-pthread', '-o', exe])
+            for units in corpus_paths:
+                print('%s: running %s' % (title, units))
+                result[units] = run([exe, units, corpus_paths[units], min_time]).stdout
+        except subprocess.CalledProcessError as e:
+            results[title] = {'error': 'failed: %s' % (e.stderr.strip().splitlines() or ['exit status %d' % e.returncode])[-1]}
+    return results
+
+
+#########################################################
+# Results
+#########################################################
+
+def read_values(path):
+    with open(path, newline='') as f:
+        reader = csv.reader(f)
+        header = next(reader)
+        columns = list(zip(*[[float(value) for value in row] for row in reader]))
+    return {name: np.array(column) for name, column in zip(header, columns)}
+
+
+def read_timings(path):
+    with open(path, newline='') as f:
+        return {row['Function']: int(row['Calls']) / float(row['Seconds']) for row in csv.DictReader(f)}
+
+
+def deviations(values, reference):
+    result = {}
+    for name, _ in FUNCTIONS:
+        diff = np.abs(values[name] - reference[name])
+        scale = np.maximum(np.abs(reference[name]), np.finfo(float).tiny)
+        result[name] = {'max_abs': float(diff.max()), 'max_rel': float((diff / scale).max())}
+    return result
+
+
+def format_rate(rate):
+    if rate >= 1e6:
+        return '%.1f M' % (rate / 1e6)
+    if rate >= 1e3:
+        return '%.1f k' % (rate / 1e3)
+    return '%.0f' % rate
+
+
+def write_report(report, path):
+    languages = [name for name, result in report['languages'].items() if 'error' not in result]
+    lines = ['# PsychroLib cross-language benchmark', '',
+             '%d corpus rows per system of units, minimum of %.2f s per timed function.' %
+             (report['rows'], report['min_time']),
+             'Platform: %s.' % report['platform'], '']
+
+    skipped = {name: result['error'] for name, result in report['languages'].items() if 'error' in result}
+    if skipped:
+        lines += ['Skipped implementations:', '']
+        lines += ['- %s: %s' % (name, error) for name, error in skipped.items()]
+        lines.append('')
+
+    for units in report['units']:
+        lines += ['## %s' % units, '', '### Calls per second', '']
+        lines.append('| Function | ' + ' | '.join(languages) + ' |')
+        lines.append('|---|' + '---:|' * len(languages))
+        for name, _ in FUNCTIONS:
+            rates = [format_rate(report['languages'][lang][units]['calls_per_second'][name]) for lang in languages]
+            lines.append('| %s | %s |' % (name, ' | '.join(rates)))
+        lines.append('')
+
+        others = [lang for lang in languages if lang != REFERENCE]
+        if REFERENCE in languages and others:
+            lines += ['### Maximum deviation from %s (absolute / relative)' % REFERENCE, '']
+            lines.append('| Function | ' + ' | '.join(others) + ' |')
+            lines.append('|---|' + '---:|' * len(others))
+            for name, _ in FUNCTIONS:
+                cells = []
+                for lang in others:
+                    dev = report['languages'][lang][units]['deviation'][name]
+                    cells.append('%.2e / %.2e' % (dev['max_abs'], dev['max_rel']))
+                lines.append('| %s | %s |' % (name, ' | '.join(cells)))
+            lines.append('')
+
+    for title, result in report['modules'].items():
+        lines += ['## %s' % title, '']
+        if 'error' in result:
+            lines += ['Skipped: %s' % result['error'], '']
+            continue
+        for units in report['units']:
+            lines += ['### %s' % units, '', result[units]]
+
+    path.write_text('\n'.join(lines))
+
+
+#########################################################
+# Main
+#########################################################
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--rows', type=int, default=10000, help='number of corpus rows per system of units')
+    parser.add_argument('--min-time', type=float, default=0.2, help='minimum duration of each timed function in s')
+    parser.add_argument('--seed', type=int, default=2017, help='seed of the corpus generator')
+    parser.add_argument('--languages', nargs='+', default=[d.name for d in DRIVERS],
+                        help='implementations to run among %s' % ', '.join(d.name for d in DRIVERS))
+    parser.add_argument('--output-dir', type=Path, default=BENCHMARKS / 'results')
+    args = parser.parse_args()
+
+    output_dir = args.output_dir.resolve()
+    output_dir.mkdir(parents=True, exist_ok=True)
+    build_dir = output_dir / 'build'
+
+    corpus_paths = {}
+    for units in DOMAINS:
+        corpus_paths[units] = output_dir / ('corpus_%s.csv' % units)
+        generate_corpus(units, args.rows, args.seed, corpus_paths[units])
+
+    report = {'rows': args.rows, 'min_time': args.min_time, 'units': list(DOMAINS),
+              'platform': '%s %s, Python %s' % (platform.system(), platform.machine(), platform.python_version()),
+              'languages': {}, 'modules': {}}
+    values = {}
+    for driver_class in DRIVERS:
+        if driver_class.name not in args.languages:
+            continue
+        driver = driver_class(build_dir)
+        result = report['languages'][driver.name] = {}
+        tool = driver.missing_tool()
+        if tool is not None:
+            result['error'] = '%s not found' % tool
+            print('%s: skipped (%s)' % (driver.name, result['error']))
+            continue
+        try:
+            print('%s: building' % driver.name)
+            driver.build()
+            for units in DOMAINS:
+                print('%s: running %s' % (driver.name, units))
+                prefix = output_dir / ('%s_%s' % (driver.build_dir.name, units))
+                values_path = prefix.with_name(prefix.name + '_values.csv')
+                timings_path = prefix.with_name(prefix.name + '_timings.csv')
+                run(driver.command() + [units, corpus_paths[units], values_path, timings_path, args.min_time])
+                values[driver.name, units] = read_values(values_path)
+                result[units] = {'calls_per_second': read_timings(timings_path)}
+        except subprocess.CalledProcessError as e:
+            result.clear()
+            result['error'] = 'failed: %s' % (e.stderr.strip().splitlines() or ['exit status %d' % e.returncode])[-1]
+            print('%s: %s' % (driver.name, result['error']))
+            continue
+
+        if isinstance(driver, CSharpDriver):
+            report['modules']['C# batch functions'] = run_batch_benchmarks(driver, corpus_paths, args.min_time)
+
+    for (lang, units), lang_values in values.items():
+        if (REFERENCE, units) in values and 'error' not in report['languages'][lang]:
+            report['languages'][lang][units]['deviation'] = deviations(lang_values, values[REFERENCE, units])
+
+    if 'C' in args.languages:
+        report['modules'].update(run_c_module_benchmarks(build_dir / 'c', corpus_paths, args.min_time))
+
+    (output_dir / 'report.json').write_text(json.dumps(report, indent=2))
+    write_report(report, output_dir / 'report.md')
+    print('Report written to %s' % (output_dir / 'report.md'))
+
+
+if __name__ == '__main__':
+    main()
@@ -47,6 +47,8 @@
 
 // Header specific to this file
 #include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_trace.h"
 
 
 /******************************************************************************************************
@@ -67,38 +69,21 @@
 
 #define INVALID -99999                  // Invalid value.
 
-#define MAX_ITER_COUNT 100              // Maximum number of iterations before exiting while loops.
-
-#define MIN_HUM_RATIO 1e-7              // Minimum acceptable humidity ratio used/returned by any functions.
-                                        // Any value above 0 or below the MIN_HUM_RATIO will be reset to this value.
-
-#define FREEZING_POINT_WATER_IP 32.0    // Freezing point of water in Fahrenheit.
-
-#define FREEZING_POINT_WATER_SI 0.0     // Freezing point of water in Celsius.
-
-#define TRIPLE_POINT_WATER_IP 32.018    // Triple point of water in Fahrenheit.
-
-#define TRIPLE_POINT_WATER_SI 0.01      // Triple point of water in Celsius.
-
 
 /******************************************************************************************************
  * Helper functions
  *****************************************************************************************************/
 
-#define ASSERT(condition, msg) \
-  if (! (condition)) \
-  { \
-    Assert(msg, __FILE__, __LINE__); \
-  }
-
 // Function called if an assertion fails
 // Replace this function with your own function for better error processing
+PSYCHROLIB_API
 void Assert
     ( char *Msg                 // (i) message to print to screen
     , char *FileName            // (i) name of file in which error occurred
     , int LineNo                // (i) number of line in which error occurred
     )
 {
+  PSYCHRO_PROBE3(assert_failed, (const char *) Msg, (const char *) FileName, LineNo);
   printf("Assert failed in file %s at line %d:\n", FileName, LineNo);
   printf("%s\n", Msg);
   printf("Aborting program...");
@@ -106,15 +91,6 @@ void Assert
   exit(1);
 }
 
-// Min and max macros (in case they are not defined)
-#ifndef min
-#define min(a,b)            (((a) < (b)) ? (a) : (b))
-#endif
-
-#ifndef max
-#define max(a,b)            (((a) > (b)) ? (a) : (b))
-#endif
-
 // Systems of units (IP or SI)
 static enum UnitSystem PSYCHROLIB_UNITS = UNDEFINED;
 
@@ -147,6 +123,7 @@ enum UnitSystem GetUnitSystem  // (o) System of units (SI or IP)
 
 // Check whether the system in use is IP or SI.
 // The function exits in error if the system of units is undefined
+PSYCHROLIB_API
 int isIP                    // (o) 1 if IP, 0 if SI, error otherwise
 (
 )
@@ -319,6 +296,7 @@ double GetRelHumFromVapPres     // (o) Relative humidity [0-1]
 // Helper function returning the derivative of the natural log of the saturation vapor pressure
 // as a function of dry-bulb temperature.
 // Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 5 & 6
+PSYCHROLIB_API
 double dLnPws_        // (o) Derivative of natural log of vapor pressure of saturated air in Psi [IP] or Pa [SI]
   ( double TDryBulb   // (i) Dry bulb temperature in °F [IP] or °C [SI]
   )
@@ -369,6 +347,8 @@ double GetTDewPointFromVapPres  // (o) Dew Point temperature in °F [IP] or °C
   // Bounds function of the system of units
   double BOUNDS[2];              // Domain of validity of the equations
 
+  PSYCHRO_PROBE2(tdew_point_entry, PSYCHRO_TRACE_VALUE(TDryBulb), PSYCHRO_TRACE_VALUE(VapPres));
+
   if (isIP())
   {
     BOUNDS[0] = -148.;
@@ -411,6 +391,8 @@ double GetTDewPointFromVapPres  // (o) Dew Point temperature in °F [IP] or °C
     index++;
   }
   while (fabs(TDewPoint - TDewPoint_iter) > PSYCHROLIB_TOLERANCE);
+
+  PSYCHRO_PROBE2(tdew_point_return, PSYCHRO_TRACE_VALUE(min(TDewPoint, TDryBulb)), index - 1);
   return min(TDewPoint, TDryBulb);
 }
 
@@ -441,6 +423,7 @@ double GetTWetBulbFromHumRatio  // (o) Wet bulb temperature in °F [IP] or °C [
   double TDewPoint, TWetBulb, TWetBulbSup, TWetBulbInf, BoundedHumRatio;
   int index = 1;
 
+  PSYCHRO_PROBE3(twet_bulb_entry, PSYCHRO_TRACE_VALUE(TDryBulb), PSYCHRO_TRACE_VALUE(HumRatio), PSYCHRO_TRACE_VALUE(Pressure));
   ASSERT (HumRatio >= 0., "Humidity ratio is negative")
   BoundedHumRatio = max(HumRatio, MIN_HUM_RATIO);
 
@@ -471,6 +454,7 @@ double GetTWetBulbFromHumRatio  // (o) Wet bulb temperature in °F [IP] or °C [
    index++;
   }
 
+  PSYCHRO_PROBE2(twet_bulb_return, PSYCHRO_TRACE_VALUE(TWetBulb), index - 1);
   return TWetBulb;
 }
 
@@ -708,9 +692,9 @@ double GetTDryBulbFromEnthalpyAndHumRatio  // (o) Dry-bulb temperature in °F [I
   BoundedHumRatio = max(HumRatio, MIN_HUM_RATIO);
 
   if (isIP())
-    return (MoistAirEnthalpy - 1061.0 * BoundedHumRatio) / (0.240 + 0.444 * BoundedHumRatio);
+    return (MoistAirEnthalpy - H_VAPOR_IP * BoundedHumRatio) / (CP_DRY_AIR_IP + CP_VAPOR_IP * BoundedHumRatio);
   else
-    return (MoistAirEnthalpy / 1000.0 - 2501.0 * BoundedHumRatio) / (1.006 + 1.86 * BoundedHumRatio);
+    return (MoistAirEnthalpy / 1000.0 - H_VAPOR_SI * BoundedHumRatio) / (CP_DRY_AIR_SI + CP_VAPOR_SI * BoundedHumRatio);
 }
 
 // Return humidity ratio from enthalpy and dry-bulb temperature.
@@ -723,9 +707,9 @@ double GetHumRatioFromEnthalpyAndTDryBulb  // (o) Humidity ratio in lb_H₂O lb_
 {
   double HumRatio;
   if (isIP())
-    HumRatio = (MoistAirEnthalpy - 0.240 * TDryBulb) / (1061.0 + 0.444 * TDryBulb);
+    HumRatio = (MoistAirEnthalpy - CP_DRY_AIR_IP * TDryBulb) / (H_VAPOR_IP + CP_VAPOR_IP * TDryBulb);
   else
-    HumRatio = (MoistAirEnthalpy / 1000.0 - 1.006 * TDryBulb) / (2501.0 + 1.86 * TDryBulb);
+    HumRatio = (MoistAirEnthalpy / 1000.0 - CP_DRY_AIR_SI * TDryBulb) / (H_VAPOR_SI + CP_VAPOR_SI * TDryBulb);
 
   // Validity check.
   return max(HumRatio, MIN_HUM_RATIO);
@@ -857,9 +841,9 @@ double GetMoistAirEnthalpy      // (o) Moist Air Enthalpy in Btu lb⁻¹ [IP] or
   BoundedHumRatio = max(HumRatio, MIN_HUM_RATIO);
 
   if (isIP())
-    return 0.240 * TDryBulb + BoundedHumRatio*(1061. + 0.444 * TDryBulb);
+    return CP_DRY_AIR_IP * TDryBulb + BoundedHumRatio*(H_VAPOR_IP + CP_VAPOR_IP * TDryBulb);
   else
-    return (1.006 * TDryBulb + BoundedHumRatio*(2501. + 1.86 * TDryBulb)) * 1000.;
+    return (CP_DRY_AIR_SI * TDryBulb + BoundedHumRatio*(H_VAPOR_SI + CP_VAPOR_SI * TDryBulb)) * 1000.;
 }
 
 // Return moist air specific volume given dry-bulb temperature, humidity ratio, and pressure.
@@ -1026,6 +1010,7 @@ void CalcPsychrometricsFromTWetBulb
   , double *DegreeOfSaturation  // (o) Degree of saturation [unitless]
 )
 {
+  PSYCHRO_PROBE4(calc_entry, (const char *) __func__, PSYCHRO_TRACE_VALUE(TDryBulb), PSYCHRO_TRACE_VALUE(TWetBulb), PSYCHRO_TRACE_VALUE(Pressure));
   ASSERT(TWetBulb <= TDryBulb, "Wet bulb temperature is above dry bulb temperature")
 
   *HumRatio = GetHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure);
@@ -1035,6 +1020,7 @@ void CalcPsychrometricsFromTWetBulb
   *MoistAirEnthalpy = GetMoistAirEnthalpy(TDryBulb, *HumRatio);
   *MoistAirVolume = GetMoistAirVolume(TDryBulb, *HumRatio, Pressure);
   *DegreeOfSaturation = GetDegreeOfSaturation(TDryBulb, *HumRatio, Pressure);
+  PSYCHRO_PROBE2(calc_return, (const char *) __func__, PSYCHRO_TRACE_VALUE(*HumRatio));
 }
 
 // Utility function to calculate humidity ratio, wet-bulb temperature, relative humidity,
@@ -1053,6 +1039,7 @@ void CalcPsychrometricsFromTDewPoint
   , double *DegreeOfSaturation  // (o) Degree of saturation [unitless]
 )
 {
+  PSYCHRO_PROBE4(calc_entry, (const char *) __func__, PSYCHRO_TRACE_VALUE(TDryBulb), PSYCHRO_TRACE_VALUE(TDewPoint), PSYCHRO_TRACE_VALUE(Pressure));
   ASSERT(TDewPoint <= TDryBulb, "Dew point temperature is above dry bulb temperature")
 
   *HumRatio = GetHumRatioFromTDewPoint(TDewPoint, Pressure);
@@ -1062,6 +1049,7 @@ void CalcPsychrometricsFromTDewPoint
   *MoistAirEnthalpy = GetMoistAirEnthalpy(TDryBulb, *HumRatio);
   *MoistAirVolume = GetMoistAirVolume(TDryBulb, *HumRatio, Pressure);
   *DegreeOfSaturation = GetDegreeOfSaturation(TDryBulb, *HumRatio, Pressure);
+  PSYCHRO_PROBE2(calc_return, (const char *) __func__, PSYCHRO_TRACE_VALUE(*HumRatio));
 }
 
 // Utility function to calculate humidity ratio, wet-bulb temperature, dew-point temperature,
@@ -1080,6 +1068,7 @@ void CalcPsychrometricsFromRelHum
   , double *DegreeOfSaturation  // (o) Degree of saturation [unitless]
 )
 {
+  PSYCHRO_PROBE4(calc_entry, (const char *) __func__, PSYCHRO_TRACE_VALUE(TDryBulb), PSYCHRO_TRACE_VALUE(RelHum), PSYCHRO_TRACE_VALUE(Pressure));
   ASSERT(RelHum >= 0 && RelHum <= 1, "Relative humidity is outside range [0,1]")
 
   *HumRatio = GetHumRatioFromRelHum(TDryBulb, RelHum, Pressure);
@@ -1089,4 +1078,5 @@ void CalcPsychrometricsFromRelHum
   *MoistAirEnthalpy = GetMoistAirEnthalpy(TDryBulb, *HumRatio);
   *MoistAirVolume = GetMoistAirVolume(TDryBulb, *HumRatio, Pressure);
   *DegreeOfSaturation = GetDegreeOfSaturation(TDryBulb, *HumRatio, Pressure);
+  PSYCHRO_PROBE2(calc_return, (const char *) __func__, PSYCHRO_TRACE_VALUE(*HumRatio));
 }
@@ -5,16 +5,37 @@
  * Licensed under the MIT License.
 */
 
+/******************************************************************************************************
+ * Linkage and attributes of the functions
+ *****************************************************************************************************/
+
+// Empty by default. psychrolib_inline.h defines them to build the library as static inline
+// functions, and to declare pure or const the functions that have no side effect and no check.
+#ifndef PSYCHROLIB_API
+#define PSYCHROLIB_API
+#endif
+
+#ifndef PSYCHROLIB_PURE
+#define PSYCHROLIB_PURE
+#endif
+
+#ifndef PSYCHROLIB_CONST
+#define PSYCHROLIB_CONST
+#endif
+
+
 /******************************************************************************************************
  * Helper functions
  *****************************************************************************************************/
 
 enum UnitSystem { UNDEFINED, IP, SI };
 
+PSYCHROLIB_API
 void SetUnitSystem
   ( enum UnitSystem Units       // (i) System of units (IP or SI)
   );
 
+PSYCHROLIB_API PSYCHROLIB_PURE
 enum UnitSystem GetUnitSystem  // (o) System of units (SI or IP)
   (
   );
@@ -24,47 +45,53 @@ enum UnitSystem GetUnitSystem  // (o) System of units (SI or IP)
  * Conversion between temperature units
  *****************************************************************************************************/
 
-double GetTRankineFromTFahrenheit(double T_F);
+PSYCHROLIB_API PSYCHROLIB_CONST double GetTRankineFromTFahrenheit(double T_F);
 
-double GetTFahrenheitFromTRankine(double T_R);
+PSYCHROLIB_API PSYCHROLIB_CONST double GetTFahrenheitFromTRankine(double T_R);
 
-double GetTKelvinFromTCelsius(double T_C);
+PSYCHROLIB_API PSYCHROLIB_CONST double GetTKelvinFromTCelsius(double T_C);
 
-double GetTCelsiusFromTKelvin(double T_K);
+PSYCHROLIB_API PSYCHROLIB_CONST double GetTCelsiusFromTKelvin(double T_K);
 
 
 /******************************************************************************************************
  * Conversions between dew point, wet bulb, and relative humidity
  *****************************************************************************************************/
 
+PSYCHROLIB_API
 double GetTWetBulbFromTDewPoint // (o) Wet bulb temperature in °F [IP] or °C [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double TDewPoint            // (i) Dew point temperature in °F [IP] or °C [SI]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetTWetBulbFromRelHum    // (o) Wet bulb temperature in °F [IP] or °C [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double RelHum               // (i) Relative humidity [0-1]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetRelHumFromTDewPoint   // (o) Relative humidity [0-1]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double TDewPoint            // (i) Dew point temperature in °F [IP] or °C [SI]
   );
 
+PSYCHROLIB_API
 double GetRelHumFromTWetBulb    // (o) Relative humidity [0-1]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double TWetBulb             // (i) Wet bulb temperature in °F [IP] or °C [SI]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetTDewPointFromRelHum   // (o) Dew Point temperature in °F [IP] or °C [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double RelHum               // (i) Relative humidity [0-1]
   );
 
+PSYCHROLIB_API
 double GetTDewPointFromTWetBulb // (o) Dew Point temperature in °F [IP] or °C [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double TWetBulb             // (i) Wet bulb temperature in °F [IP] or °C [SI]
@@ -76,21 +103,25 @@ double GetTDewPointFromTWetBulb // (o) Dew Point temperature in °F [IP] or °C
  * Conversions between dew point, or relative humidity and vapor pressure
  *****************************************************************************************************/
 
+PSYCHROLIB_API
 double GetVapPresFromRelHum     // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double RelHum               // (i) Relative humidity [0-1]
   );
 
+PSYCHROLIB_API
 double GetRelHumFromVapPres     // (o) Relative humidity [0-1]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double VapPres              // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetTDewPointFromVapPres  // (o) Dew Point temperature in °F [IP] or °C [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double VapPres              // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetVapPresFromTDewPoint  // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
   ( double TDewPoint            // (i) Dew point temperature in °F [IP] or °C [SI]
   );
@@ -100,35 +131,41 @@ double GetVapPresFromTDewPoint  // (o) Partial pressure of water vapor in moist
  * Conversions from wet-bulb temperature, dew-point temperature, or relative humidity to humidity ratio
  *****************************************************************************************************/
 
+PSYCHROLIB_API
 double GetTWetBulbFromHumRatio  // (o) Wet bulb temperature in °F [IP] or °C [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetHumRatioFromTWetBulb  // (o) Humidity Ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double TWetBulb             // (i) Wet bulb temperature in °F [IP] or °C [SI]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetHumRatioFromRelHum    // (o) Humidity Ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double RelHum               // (i) Relative humidity [0-1]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetRelHumFromHumRatio    // (o) Relative humidity [0-1]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetHumRatioFromTDewPoint // (o) Humidity Ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   ( double TDewPoint            // (i) Dew point temperature in °F [IP] or °C [SI]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetTDewPointFromHumRatio // (o) Dew Point temperature in °F [IP] or °C [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
@@ -140,11 +177,13 @@ double GetTDewPointFromHumRatio // (o) Dew Point temperature in °F [IP] or °C
  * Conversions between humidity ratio and vapor pressure
  *****************************************************************************************************/
 
+PSYCHROLIB_API
 double GetHumRatioFromVapPres   // (o) Humidity Ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   ( double VapPres              // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetVapPresFromHumRatio   // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
   ( double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
@@ -155,10 +194,12 @@ double GetVapPresFromHumRatio   // (o) Partial pressure of water vapor in moist
  * Conversions between humidity ratio and specific humidity
  *****************************************************************************************************/
 
+PSYCHROLIB_API
 double GetSpecificHumFromHumRatio // (o) Specific humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   ( double HumRatio               // (i) Humidity ratio in lb_H₂O lb_Dry_Air⁻¹ [IP] or kg_H₂O kg_Dry_Air⁻¹ [SI]
   );
 
+PSYCHROLIB_API
 double GetHumRatioFromSpecificHum // (o) Humidity ratio in lb_H₂O lb_Dry_Air⁻¹ [IP] or kg_H₂O kg_Dry_Air⁻¹ [SI]
   ( double SpecificHum            // (i) Specific humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   );
@@ -168,25 +209,30 @@ double GetHumRatioFromSpecificHum // (o) Humidity ratio in lb_H₂O lb_Dry_Air
  * Dry Air Calculations
  *****************************************************************************************************/
 
+PSYCHROLIB_API
 double GetDryAirEnthalpy                  // (o) Dry air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
   ( double TDryBulb                       // (i) Dry bulb temperature in °F [IP] or °C [SI]
   );
 
+PSYCHROLIB_API
 double GetDryAirDensity                   // (o) Dry air density in lb ft⁻³ [IP] or kg m⁻³ [SI]
   ( double TDryBulb                       // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double Pressure                       // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetDryAirVolume                    // (o) Dry air volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
   ( double TDryBulb                       // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double Pressure                       // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetTDryBulbFromEnthalpyAndHumRatio    // (o) Dry-bulb temperature in °F [IP] or °C [SI]
   ( double MoistAirEnthalpy                  // (i) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹
   , double HumRatio                          // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   );
 
+PSYCHROLIB_API
 double GetHumRatioFromEnthalpyAndTDryBulb  // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   ( double MoistAirEnthalpy                // (i) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹
   , double TDryBulb                        // (i) Dry-bulb temperature in °F [IP] or °C [SI]
@@ -197,15 +243,18 @@ double GetHumRatioFromEnthalpyAndTDryBulb  // (o) Humidity ratio in lb_H₂O lb_
  * Saturated Air Calculations
  *****************************************************************************************************/
 
+PSYCHROLIB_API
 double GetSatVapPres            // (o) Vapor Pressure of saturated air in Psi [IP] or Pa [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   );
 
+PSYCHROLIB_API
 double GetSatHumRatio           // (o) Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetSatAirEnthalpy        // (o) Saturated air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
@@ -215,35 +264,41 @@ double GetSatAirEnthalpy        // (o) Saturated air enthalpy in Btu lb⁻¹ [IP
 /******************************************************************************************************
  * Moist Air Calculations
  *****************************************************************************************************/
+PSYCHROLIB_API
 double GetVaporPressureDeficit  // (o) Vapor pressure deficit in Psi [IP] or Pa [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetDegreeOfSaturation    // (o) Degree of saturation []
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetMoistAirEnthalpy      // (o) Moist Air Enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   );
 
+PSYCHROLIB_API
 double GetMoistAirVolume        // (o) Specific Volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetTDryBulbFromMoistAirVolumeAndHumRatio   // (o) Dry-bulb temperature in °F [IP] or °C [SI]
   ( double MoistAirVolume                         // (i) Specific volume of moist air in ft³ lb⁻¹ of dry air [IP] or in m³ kg⁻¹ of dry air [SI]
   , double HumRatio                               // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
   , double Pressure                               // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
   );
 
+PSYCHROLIB_API
 double GetMoistAirDensity       // (o) Moist air density in lb ft⁻³ [IP] or kg m⁻³ [SI]
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
@@ -255,20 +310,24 @@ double GetMoistAirDensity       // (o) Moist air density in lb ft⁻³ [IP] or k
  * Standard atmosphere
  *****************************************************************************************************/
 
+PSYCHROLIB_API
 double GetStandardAtmPressure   // (o) Standard atmosphere barometric pressure in Psi [IP] or Pa [SI]
   ( double Altitude             // (i) Altitude in ft [IP] or m [SI]
   );
 
+PSYCHROLIB_API
 double GetStandardAtmTemperature // (o) Standard atmosphere dry bulb temperature in °F [IP] or °C [SI]
   ( double Altitude              // (i) Altitude in ft [IP] or m [SI]
   );
 
+PSYCHROLIB_API
 double GetSeaLevelPressure   // (o) Sea level barometric pressure in Psi [IP] or Pa [SI]
   ( double StnPressure       // (i) Observed station pressure in Psi [IP] or Pa [SI]
   , double Altitude          // (i) Altitude above sea level in ft [IP] or m [SI]
   , double TDryBulb          // (i) Dry bulb temperature ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
   );
 
+PSYCHROLIB_API
 double GetStationPressure    // (o) Station pressure in Psi [IP] or Pa [SI]
   ( double SeaLevelPressure  // (i) Sea level barometric pressure in Psi [IP] or Pa [SI]
   , double Altitude          // (i) Altitude above sea level in ft [IP] or m [SI]
@@ -280,6 +339,7 @@ double GetStationPressure    // (o) Station pressure in Psi [IP] or Pa [SI]
  * Functions to set all psychrometric values
  *****************************************************************************************************/
 
+PSYCHROLIB_API
 void CalcPsychrometricsFromTWetBulb
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double TWetBulb             // (i) Wet bulb temperature in °F [IP] or °C [SI]
@@ -293,6 +353,7 @@ void CalcPsychrometricsFromTWetBulb
   , double *DegreeOfSaturation  // (o) Degree of saturation [unitless]
   );
 
+PSYCHROLIB_API
 void CalcPsychrometricsFromTDewPoint
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double TDewPoint            // (i) Dew point temperature in °F [IP] or °C [SI]
@@ -306,6 +367,7 @@ void CalcPsychrometricsFromTDewPoint
   , double *DegreeOfSaturation  // (o) Degree of saturation [unitless]
   );
 
+PSYCHROLIB_API
 void CalcPsychrometricsFromRelHum
   ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
   , double RelHum               // (i) Relative humidity [0-1]
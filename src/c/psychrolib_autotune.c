@@ -0,0 +1,793 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Autotuner: selection of the fastest backend meeting an accuracy target on the host, with a
+ *  cache file of the decisions.
+ *
+ *  The saturation vapor pressure and the dew-point and wet-bulb temperatures have several
+ *  implementations in the C library, and the fastest depends on the processor, the size of the
+ *  batches, the range of the inputs and the accuracy needed. For each of these kernels, the
+ *  autotuner measures on the host the candidates that apply to the workload of the caller:
+ *   - the generic functions of psychrolib.c;
+ *   - the fixed-iteration functions of psychrolib_bounded.c;
+ *   - the site context of psychrolib_site.c, for the saturation vapor pressure at any pressure,
+ *     and for the dew-point and wet-bulb temperatures when the pressure is fixed;
+ *   - trilinear and cubic property tables of psychrolib_table.c over the range of the workload,
+ *     for the dew-point and wet-bulb temperatures. The resolution starts at INITIAL_CELLS cells
+ *     per axis and is doubled until the tolerance is met, up to MAX_TABLE_NODES nodes.
+ *  The error of each candidate is measured at N_SAMPLES points spread over the range, against the
+ *  bounded-latency functions where they converge (to within 1e-6 °F [IP] or °C [SI] for the
+ *  temperatures) and the generic functions elsewhere. The generic solvers are themselves only
+ *  guaranteed to within PSYCHROLIB_TOLERANCE, so the bisection of the wet-bulb temperature is
+ *  rejected by tighter tolerances. The error of a table is the larger of its error at these
+ *  points and the maximum error of its error report, measured at the centers of its cells, so
+ *  that a table is not accepted on points that miss its worst cells. The candidates that meet
+ *  the tolerance are timed on batches of BatchSize points, up to MAX_BATCH_SIZE, taking the
+ *  fastest of REPEATS runs of at least MEASURE_TIME each, and the fastest is selected. If no candidate meets the tolerance, the most accurate is selected.
+ *
+ *  Tuning takes from a fraction of a second to a few seconds, mostly to build the tables. With a
+ *  cache file, the decisions are written to the file, with the tables of the selected backends
+ *  next to it (the cache file name followed by the name of the kernel). At the next creation
+ *  with the same workload, tolerances, system of units and host, the decisions are read from the
+ *  file and the tables are mapped in memory instead of being measured and built again. Any
+ *  difference, or a damaged file, starts a new tuning that replaces the file. Files are
+ *  written to a temporary file first and renamed, so that processes starting together on a
+ *  host read either the old or the new decisions.
+ *
+ *  The decisions and the measurements are returned by PsychroAutotuneGetReport for logging. The
+ *  tuned batch functions take any inputs: points outside the range of the workload, or at
+ *  another pressure than the site, are calculated with the generic functions, and their inputs
+ *  are checked as in the generic functions. The tuned kernels are read-only once created and can
+ *  be shared by threads. The system of units must not be changed while they are in use.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_autotune.h"
+ *  SetUnitSystem(SI);
+ *  struct PsychroAutotuneConfig Config = { -10., 45., 0.0005, 0.025, 101325., 101325., 4096, 0.01, 1e-6,
+ *    "/var/cache/psychrolib/autotune" };
+ *  PsychroAutotune *Tuner = PsychroAutotuneCreate(&Config);
+ *  PsychroAutotuneGetTWetBulbFromHumRatio(Tuner, Count, TDryBulb, HumRatio, Pressure, TWetBulb);
+ *  PsychroAutotuneDestroy(Tuner);
+ */
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+// Standard C header files
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/utsname.h>
+#endif
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_autotune.h"
+#include "psychrolib_bounded.h"
+#include "psychrolib_site.h"
+#include "psychrolib_table.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define N_SAMPLES 2048              // Number of points at which the error of the candidates is measured.
+
+#define MAX_BATCH_SIZE 65536        // Largest batch timed; the time per point no longer depends on the size.
+
+#define MEASURE_TIME 0.005          // Minimum time of a run of a candidate in s.
+
+#define REPEATS 3                   // Number of runs of each candidate; the fastest is kept.
+
+#define INITIAL_CELLS 8             // Cells per axis of the coarsest table.
+
+#define MAX_TABLE_NODES 1048576     // Maximum number of nodes of a table.
+
+#define CACHE_MAGIC "psychrolib-autotune"
+
+#define CACHE_VERSION 1             // Version of the format of the cache file.
+
+static const char *KERNEL_NAMES[PSYCHRO_N_KERNELS] = { "SatVapPres", "TDewPoint", "TWetBulb" };
+
+static const char *BACKEND_NAMES[PSYCHRO_N_BACKENDS] =
+{
+  "generic", "bounded", "site", "table-trilinear", "table-cubic"
+};
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+struct PsychroAutotune
+{
+  struct PsychroAutotuneConfig Config;  // Configuration, without the cache path
+  struct PsychroAutotuneReport Report;
+  PsychroSite *Site;                    // Site context at the minimum pressure
+  int FixedPressure;                    // 1 if the pressure of the workload is fixed
+  PsychroTable *Tables[PSYCHRO_N_KERNELS]; // Table of the selected backend, NULL if not a table
+};
+
+// Points of the workload
+struct Points
+{
+  size_t Count;
+  double *TDryBulb;
+  double *HumRatio;
+  double *Pressure;
+  double *Value;
+};
+
+// Monotonic time in s, not affected by changes of the time of day
+static double Now_(void)
+{
+#if defined(_WIN32)
+  LARGE_INTEGER Counter, Frequency;
+  QueryPerformanceCounter(&Counter);
+  QueryPerformanceFrequency(&Frequency);
+  return (double) Counter.QuadPart / Frequency.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+#endif
+}
+
+static int IsTable_
+  ( enum PsychroBackend Backend
+  )
+{
+  return Backend == PSYCHRO_BACKEND_TABLE_TRILINEAR || Backend == PSYCHRO_BACKEND_TABLE_CUBIC;
+}
+
+// Allocate Count points spread over the range of the workload, along an additive recurrence
+// with irrational steps
+static int InitPoints_
+  ( struct Points *Points
+  , const struct PsychroAutotuneConfig *Config
+  , size_t Count
+  )
+{
+  size_t k;
+  double u;
+
+  Points->Count = Count;
+  Points->TDryBulb = malloc(Count * sizeof(double));
+  Points->HumRatio = malloc(Count * sizeof(double));
+  Points->Pressure = malloc(Count * sizeof(double));
+  Points->Value = malloc(Count * sizeof(double));
+  if (Points->TDryBulb == NULL || Points->HumRatio == NULL || Points->Pressure == NULL || Points->Value == NULL)
+    return 0;
+  for (k = 0; k < Count; k++)
+  {
+    u = k + 0.5;
+    Points->TDryBulb[k] = Config->TDryBulbMin + fmod(u * 0.41421356237309505, 1.) * (Config->TDryBulbMax - Config->TDryBulbMin);
+    Points->HumRatio[k] = Config->HumRatioMin + fmod(u * 0.7320508075688772, 1.) * (Config->HumRatioMax - Config->HumRatioMin);
+    Points->Pressure[k] = Config->PressureMin + fmod(u * 0.2360679774997897, 1.) * (Config->PressureMax - Config->PressureMin);
+  }
+  return 1;
+}
+
+static void FreePoints_
+  ( struct Points *Points
+  )
+{
+  free(Points->TDryBulb);
+  free(Points->HumRatio);
+  free(Points->Pressure);
+  free(Points->Value);
+}
+
+static double Generic_
+  ( enum PsychroKernel Kernel
+  , double TDryBulb
+  , double HumRatio
+  , double Pressure
+  )
+{
+  switch (Kernel)
+  {
+    case PSYCHRO_KERNEL_SAT_VAP_PRES: return GetSatVapPres(TDryBulb);
+    case PSYCHRO_KERNEL_TDEW_POINT: return GetTDewPointFromHumRatio(TDryBulb, HumRatio, Pressure);
+    default: return GetTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure);
+  }
+}
+
+// Bounded-latency function, or generic function if it does not converge or the inputs are invalid
+static double Bounded_
+  ( enum PsychroKernel Kernel
+  , double TDryBulb
+  , double HumRatio
+  , double Pressure
+  )
+{
+  enum PsychroStatus Status;
+  double Value;
+
+  switch (Kernel)
+  {
+    case PSYCHRO_KERNEL_SAT_VAP_PRES: Status = BoundedGetSatVapPres(TDryBulb, &Value); break;
+    case PSYCHRO_KERNEL_TDEW_POINT: Status = BoundedGetTDewPointFromHumRatio(TDryBulb, HumRatio, Pressure, &Value); break;
+    default: Status = BoundedGetTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure, &Value);
+  }
+  return Status == PSYCHRO_STATUS_OK ? Value : Generic_(Kernel, TDryBulb, HumRatio, Pressure);
+}
+
+// Site context on the runs of points at the pressure of the site, generic function elsewhere
+static void Site_
+  ( const PsychroSite *Site
+  , enum PsychroKernel Kernel
+  , size_t Count
+  , const double *TDryBulb
+  , const double *HumRatio
+  , const double *Pressure
+  , double *Value
+  )
+{
+  double SitePressure = PsychroSiteGetPressure(Site);
+  size_t i = 0, j;
+
+  if (Kernel == PSYCHRO_KERNEL_SAT_VAP_PRES)
+  {
+    PsychroSiteGetSatVapPres(Site, Count, TDryBulb, Value);
+    return;
+  }
+  while (i < Count)
+  {
+    for (j = i; j < Count && Pressure[j] == SitePressure; j++)
+      ;
+    if (j > i && Kernel == PSYCHRO_KERNEL_TDEW_POINT)
+      PsychroSiteGetTDewPointFromHumRatio(Site, j - i, TDryBulb + i, HumRatio + i, Value + i);
+    else if (j > i)
+      PsychroSiteGetTWetBulbFromHumRatio(Site, j - i, TDryBulb + i, HumRatio + i, Value + i);
+    for (; j < Count && Pressure[j] != SitePressure; j++)
+      Value[j] = Generic_(Kernel, TDryBulb[j], HumRatio[j], Pressure[j]);
+    i = j;
+  }
+}
+
+// Evaluate a kernel with a backend
+static void Run_
+  ( const PsychroAutotune *Tuner
+  , enum PsychroKernel Kernel
+  , enum PsychroBackend Backend
+  , const PsychroTable *Table
+  , size_t Count
+  , const double *TDryBulb
+  , const double *HumRatio
+  , const double *Pressure
+  , double *Value
+  )
+{
+  size_t i;
+
+  switch (Backend)
+  {
+    case PSYCHRO_BACKEND_GENERIC:
+      for (i = 0; i < Count; i++)
+        Value[i] = Generic_(Kernel, TDryBulb[i], HumRatio == NULL ? 0. : HumRatio[i], Pressure == NULL ? 0. : Pressure[i]);
+      break;
+    case PSYCHRO_BACKEND_BOUNDED:
+      for (i = 0; i < Count; i++)
+        Value[i] = Bounded_(Kernel, TDryBulb[i], HumRatio == NULL ? 0. : HumRatio[i], Pressure == NULL ? 0. : Pressure[i]);
+      break;
+    case PSYCHRO_BACKEND_SITE:
+      Site_(Tuner->Site, Kernel, Count, TDryBulb, HumRatio, Pressure, Value);
+      break;
+    default:
+      PsychroTableLookupBatch(Table, Kernel == PSYCHRO_KERNEL_TDEW_POINT ? PSYCHRO_TABLE_TDEW_POINT : PSYCHRO_TABLE_TWET_BULB,
+        Count, TDryBulb, HumRatio, Pressure, Value);
+  }
+}
+
+// Maximum error of the values of the points against the reference: relative for the saturation
+// vapor pressure, absolute for the temperatures
+static double MaxError_
+  ( enum PsychroKernel Kernel
+  , const struct Points *Points
+  , const double *Reference
+  )
+{
+  double Error = 0.;
+  size_t k;
+
+  for (k = 0; k < Points->Count; k++)
+    Error = fmax(Error, Kernel == PSYCHRO_KERNEL_SAT_VAP_PRES ? fabs(Points->Value[k] / Reference[k] - 1.)
+      : fabs(Points->Value[k] - Reference[k]));
+  return Error;
+}
+
+// Time per point in ns of a kernel on a batch: fastest of REPEATS runs, doubling the passes of
+// each run until MEASURE_TIME is reached
+static double Time_
+  ( const PsychroAutotune *Tuner
+  , enum PsychroKernel Kernel
+  , enum PsychroBackend Backend
+  , const PsychroTable *Table
+  , struct Points *Batch
+  )
+{
+  double Best = HUGE_VAL, Start, Elapsed;
+  long Passes, p;
+  int r;
+
+  for (r = 0; r < REPEATS; r++)
+  {
+    for (Passes = 1;; Passes *= 2)
+    {
+      Start = Now_();
+      for (p = 0; p < Passes; p++)
+        Run_(Tuner, Kernel, Backend, Table, Batch->Count, Batch->TDryBulb, Batch->HumRatio, Batch->Pressure, Batch->Value);
+      Elapsed = Now_() - Start;
+      if (Elapsed >= MEASURE_TIME)
+        break;
+    }
+    Best = fmin(Best, 1e9 * Elapsed / ((double) Passes * Batch->Count));
+  }
+  return Best;
+}
+
+// Table of a kernel over the range of the workload with the given number of nodes per axis
+static PsychroTable *CreateTable_
+  ( const PsychroAutotune *Tuner
+  , enum PsychroKernel Kernel
+  , enum PsychroBackend Backend
+  , const size_t Count[3]
+  )
+{
+  const struct PsychroAutotuneConfig *c = &Tuner->Config;
+  struct PsychroTableConfig Config =
+  {
+    { c->TDryBulbMin, c->TDryBulbMax, Count[0] },
+    { c->HumRatioMin, c->HumRatioMax, Count[1] },
+    { c->PressureMin, c->PressureMax, Count[2] },
+    1u << (Kernel == PSYCHRO_KERNEL_TDEW_POINT ? PSYCHRO_TABLE_TDEW_POINT : PSYCHRO_TABLE_TWET_BULB),
+    Backend == PSYCHRO_BACKEND_TABLE_CUBIC ? PSYCHRO_TABLE_CUBIC : PSYCHRO_TABLE_TRILINEAR,
+    { 0. }
+  };
+
+  return PsychroTableCreate(&Config);
+}
+
+// Nodes of the table along each axis for a number of cells of the temperature and humidity axes
+static size_t TableNodes_
+  ( const PsychroAutotune *Tuner
+  , size_t Cells
+  , size_t Count[3]             // (o) Nodes of the table along each axis
+  )
+{
+  Count[0] = Count[1] = Cells + 1;
+  Count[2] = Tuner->FixedPressure ? 1 : Cells / 4 + 1;
+  return Count[0] * Count[1] * Count[2];
+}
+
+// Coarsest table that meets the tolerance both on the sample points and at the centers of its cells
+// (its error report), NULL if none within MAX_TABLE_NODES.
+// The resolution is doubled until the tolerance is met, or until the error has not decreased for
+// two doublings, which happens when it is dominated by the kinks of the function.
+static PsychroTable *TuneTable_
+  ( const PsychroAutotune *Tuner
+  , enum PsychroKernel Kernel
+  , enum PsychroBackend Backend
+  , struct Points *Samples
+  , const double *Reference
+  , double *Error               // (o) Error of the table
+  , size_t Count[3]             // (o) Nodes of the table along each axis
+  )
+{
+  struct PsychroTableErrorReport Report;
+  double BestError = HUGE_VAL;
+  PsychroTable *Table;
+  size_t Cells;
+  int Stalled = 0;
+
+  for (Cells = INITIAL_CELLS; TableNodes_(Tuner, Cells, Count) <= MAX_TABLE_NODES; Cells *= 2)
+  {
+    Table = CreateTable_(Tuner, Kernel, Backend, Count);
+    if (Table == NULL)
+      return NULL;
+    Run_(Tuner, Kernel, Backend, Table, Samples->Count, Samples->TDryBulb, Samples->HumRatio, Samples->Pressure,
+      Samples->Value);
+    PsychroTableGetErrorReport(Table, &Report);
+    *Error = fmax(MaxError_(Kernel, Samples, Reference),
+      Report.MaxAbsError[Kernel == PSYCHRO_KERNEL_TDEW_POINT ? PSYCHRO_TABLE_TDEW_POINT : PSYCHRO_TABLE_TWET_BULB]);
+    if (*Error <= Tuner->Config.Tolerance)
+      return Table;
+    PsychroTableDestroy(Table);
+    Stalled = *Error < BestError ? 0 : Stalled + 1;
+    if (Stalled == 2)
+      return NULL;
+    BestError = fmin(BestError, *Error);
+  }
+  return NULL;
+}
+
+// Measure the candidates of all kernels and select the backends
+static int Tune_
+  ( PsychroAutotune *Tuner
+  )
+{
+  struct Points Samples, Batch;
+  struct PsychroAutotuneDecision *Decision, Candidate;
+  double *Reference, Tolerance, BestError;
+  PsychroTable *Table, *CandidateTables[PSYCHRO_N_BACKENDS];
+  int Kernel, Backend, Best, Ok;
+  size_t k;
+
+  memset(&Samples, 0, sizeof Samples);
+  memset(&Batch, 0, sizeof Batch);
+  Reference = malloc(N_SAMPLES * sizeof(double));
+  Ok = Reference != NULL && InitPoints_(&Samples, &Tuner->Config, N_SAMPLES)
+    && InitPoints_(&Batch, &Tuner->Config, Tuner->Config.BatchSize < MAX_BATCH_SIZE ? Tuner->Config.BatchSize : MAX_BATCH_SIZE);
+
+  for (Kernel = 0; Kernel < PSYCHRO_N_KERNELS && Ok; Kernel++)
+  {
+    Tolerance = Kernel == PSYCHRO_KERNEL_SAT_VAP_PRES ? Tuner->Config.SatVapPresTolerance : Tuner->Config.Tolerance;
+    for (k = 0; k < N_SAMPLES; k++)
+      Reference[k] = Bounded_(Kernel, Samples.TDryBulb[k], Samples.HumRatio[k], Samples.Pressure[k]);
+
+    Decision = &Tuner->Report.Decisions[Kernel];
+    Best = -1;
+    BestError = HUGE_VAL;
+    for (Backend = 0; Backend < PSYCHRO_N_BACKENDS; Backend++)
+    {
+      CandidateTables[Backend] = NULL;
+      if ((Backend == PSYCHRO_BACKEND_SITE && Kernel != PSYCHRO_KERNEL_SAT_VAP_PRES && !Tuner->FixedPressure)
+          || (IsTable_(Backend) && Kernel == PSYCHRO_KERNEL_SAT_VAP_PRES))
+        continue;
+      memset(&Candidate, 0, sizeof Candidate);
+      Candidate.Backend = Backend;
+      if (IsTable_(Backend))
+      {
+        Table = CandidateTables[Backend] = TuneTable_(Tuner, Kernel, Backend, &Samples, Reference, &Candidate.MaxError,
+          Candidate.TableCount);
+        if (Table == NULL)
+          continue;
+      }
+      else
+      {
+        Table = NULL;
+        Run_(Tuner, Kernel, Backend, NULL, Samples.Count, Samples.TDryBulb, Samples.HumRatio, Samples.Pressure, Samples.Value);
+        Candidate.MaxError = MaxError_(Kernel, &Samples, Reference);
+      }
+      if (Candidate.MaxError <= Tolerance)
+      {
+        Candidate.TimePerPoint = Time_(Tuner, Kernel, Backend, Table, &Batch);
+        Tuner->Report.CandidateTime[Kernel][Backend] = Candidate.TimePerPoint;
+        if (BestError > Tolerance || Candidate.TimePerPoint < Decision->TimePerPoint)
+        {
+          *Decision = Candidate;
+          Best = Backend;
+          BestError = Candidate.MaxError;
+        }
+      }
+      else if (BestError > Tolerance && Candidate.MaxError < BestError)
+      {
+        // Most accurate so far, while no candidate meets the tolerance
+        Candidate.TimePerPoint = Time_(Tuner, Kernel, Backend, Table, &Batch);
+        *Decision = Candidate;
+        Best = Backend;
+        BestError = Candidate.MaxError;
+      }
+    }
+    for (Backend = 0; Backend < PSYCHRO_N_BACKENDS; Backend++)
+      if (Backend == Best)
+        Tuner->Tables[Kernel] = CandidateTables[Backend];
+      else
+        PsychroTableDestroy(CandidateTables[Backend]);
+  }
+
+  FreePoints_(&Samples);
+  FreePoints_(&Batch);
+  free(Reference);
+  return Ok;
+}
+
+
+/******************************************************************************************************
+ * Cache file
+ *****************************************************************************************************/
+
+// Name of the host, to reject cache files shared between hosts
+static void HostName_
+  ( char *Name
+  , size_t Size
+  )
+{
+#if defined(_WIN32)
+  DWORD Length = (DWORD) Size;
+  if (!GetComputerNameA(Name, &Length))
+    snprintf(Name, Size, "unknown");
+#else
+  struct utsname Host;
+  if (uname(&Host) == 0)
+    snprintf(Name, Size, "%s-%s", Host.nodename, Host.machine);
+  else
+    snprintf(Name, Size, "unknown");
+#endif
+}
+
+// Write to a temporary file, then rename it
+static int Replace_
+  ( const char *Temporary
+  , const char *Path
+  )
+{
+#if defined(_WIN32)
+  remove(Path);
+#endif
+  if (rename(Temporary, Path) == 0)
+    return 1;
+  remove(Temporary);
+  return 0;
+}
+
+static void TablePath_
+  ( char *Path
+  , size_t Size
+  , const char *CachePath
+  , int Kernel
+  )
+{
+  snprintf(Path, Size, "%s.%s", CachePath, KERNEL_NAMES[Kernel]);
+}
+
+// Write the decisions and the tables of the selected backends
+static void WriteCache_
+  ( const PsychroAutotune *Tuner
+  , const char *CachePath
+  )
+{
+  const struct PsychroAutotuneConfig *c = &Tuner->Config;
+  const struct PsychroAutotuneDecision *d;
+  char Host[256], Path[FILENAME_MAX - 8], Temporary[FILENAME_MAX];
+  int Kernel, Failed;
+  FILE *fp;
+
+  for (Kernel = 0; Kernel < PSYCHRO_N_KERNELS; Kernel++)
+    if (Tuner->Tables[Kernel] != NULL)
+    {
+      TablePath_(Path, sizeof Path, CachePath, Kernel);
+      snprintf(Temporary, sizeof Temporary, "%s.tmp", Path);
+      if (PsychroTableSave(Tuner->Tables[Kernel], Temporary) != 0 || !Replace_(Temporary, Path))
+        return;
+    }
+
+  snprintf(Temporary, sizeof Temporary, "%s.tmp", CachePath);
+  fp = fopen(Temporary, "w");
+  if (fp == NULL)
+    return;
+  HostName_(Host, sizeof Host);
+  fprintf(fp, "%s %d\n", CACHE_MAGIC, CACHE_VERSION);
+  fprintf(fp, "host %s\nunits %s\n", Host, isIP() ? "IP" : "SI");
+  fprintf(fp, "range %.17g %.17g %.17g %.17g %.17g %.17g\n", c->TDryBulbMin, c->TDryBulbMax, c->HumRatioMin,
+    c->HumRatioMax, c->PressureMin, c->PressureMax);
+  fprintf(fp, "batch %zu\ntolerance %.17g %.17g\n", c->BatchSize, c->Tolerance, c->SatVapPresTolerance);
+  for (Kernel = 0; Kernel < PSYCHRO_N_KERNELS; Kernel++)
+  {
+    d = &Tuner->Report.Decisions[Kernel];
+    fprintf(fp, "%s %s %.17g %.17g %zu %zu %zu\n", KERNEL_NAMES[Kernel], BACKEND_NAMES[d->Backend], d->TimePerPoint,
+      d->MaxError, d->TableCount[0], d->TableCount[1], d->TableCount[2]);
+  }
+  Failed = ferror(fp);
+  if (fclose(fp) != 0 || Failed)
+    remove(Temporary);
+  else
+    Replace_(Temporary, CachePath);
+}
+
+// Map the table of a decision read from the cache, or build it again
+static PsychroTable *LoadTable_
+  ( const PsychroAutotune *Tuner
+  , const char *CachePath
+  , int Kernel
+  , const struct PsychroAutotuneDecision *Decision
+  )
+{
+  struct PsychroTableConfig Config;
+  char Path[FILENAME_MAX];
+  PsychroTable *Table;
+
+  TablePath_(Path, sizeof Path, CachePath, Kernel);
+  Table = PsychroTableOpen(Path);
+  if (Table != NULL)
+  {
+    PsychroTableGetConfig(Table, &Config);
+    if (Config.TDryBulb.Min == Tuner->Config.TDryBulbMin && Config.TDryBulb.Max == Tuner->Config.TDryBulbMax
+        && Config.HumRatio.Min == Tuner->Config.HumRatioMin && Config.HumRatio.Max == Tuner->Config.HumRatioMax
+        && Config.Pressure.Min == Tuner->Config.PressureMin && Config.Pressure.Max == Tuner->Config.PressureMax
+        && Config.TDryBulb.Count == Decision->TableCount[0] && Config.HumRatio.Count == Decision->TableCount[1]
+        && Config.Pressure.Count == Decision->TableCount[2]
+        && Config.Interpolation == (Decision->Backend == PSYCHRO_BACKEND_TABLE_CUBIC ? PSYCHRO_TABLE_CUBIC : PSYCHRO_TABLE_TRILINEAR)
+        && Config.Properties == 1u << (Kernel == PSYCHRO_KERNEL_TDEW_POINT ? PSYCHRO_TABLE_TDEW_POINT : PSYCHRO_TABLE_TWET_BULB))
+      return Table;
+    PsychroTableDestroy(Table);
+  }
+  return CreateTable_(Tuner, Kernel, Decision->Backend, Decision->TableCount);
+}
+
+// Read the decisions if the cache file matches the workload, the tolerances, the units and the host
+static int ReadCache_
+  ( PsychroAutotune *Tuner
+  , const char *CachePath
+  )
+{
+  const struct PsychroAutotuneConfig *c = &Tuner->Config;
+  struct PsychroAutotuneDecision *d;
+  char Magic[64], Host[256], FileHost[256], Units[8], Kernel[64], Backend[64];
+  double Range[6], Tolerance[2];
+  size_t BatchSize;
+  int Version, k, b, Ok;
+  FILE *fp = fopen(CachePath, "r");
+
+  if (fp == NULL)
+    return 0;
+  HostName_(Host, sizeof Host);
+  Ok = fscanf(fp, "%63s %d host %255s units %7s range %lf %lf %lf %lf %lf %lf batch %zu tolerance %lf %lf",
+      Magic, &Version, FileHost, Units, &Range[0], &Range[1], &Range[2], &Range[3], &Range[4], &Range[5],
+      &BatchSize, &Tolerance[0], &Tolerance[1]) == 13
+    && strcmp(Magic, CACHE_MAGIC) == 0 && Version == CACHE_VERSION && strcmp(FileHost, Host) == 0
+    && strcmp(Units, isIP() ? "IP" : "SI") == 0 && Range[0] == c->TDryBulbMin && Range[1] == c->TDryBulbMax
+    && Range[2] == c->HumRatioMin && Range[3] == c->HumRatioMax && Range[4] == c->PressureMin
+    && Range[5] == c->PressureMax && BatchSize == c->BatchSize && Tolerance[0] == c->Tolerance
+    && Tolerance[1] == c->SatVapPresTolerance;
+  for (k = 0; k < PSYCHRO_N_KERNELS && Ok; k++)
+  {
+    d = &Tuner->Report.Decisions[k];
+    Ok = fscanf(fp, "%63s %63s %lf %lf %zu %zu %zu", Kernel, Backend, &d->TimePerPoint, &d->MaxError,
+      &d->TableCount[0], &d->TableCount[1], &d->TableCount[2]) == 7 && strcmp(Kernel, KERNEL_NAMES[k]) == 0;
+    for (b = 0; b < PSYCHRO_N_BACKENDS && Ok && strcmp(Backend, BACKEND_NAMES[b]) != 0; b++)
+      ;
+    Ok = Ok && b < PSYCHRO_N_BACKENDS && !(b == PSYCHRO_BACKEND_SITE && k != PSYCHRO_KERNEL_SAT_VAP_PRES && !Tuner->FixedPressure)
+      && IsTable_(b) == (k != PSYCHRO_KERNEL_SAT_VAP_PRES && d->TableCount[0] != 0);
+    if (Ok)
+      d->Backend = b;
+  }
+  fclose(fp);
+
+  for (k = 0; k < PSYCHRO_N_KERNELS && Ok; k++)
+    if (IsTable_(Tuner->Report.Decisions[k].Backend))
+      Ok = (Tuner->Tables[k] = LoadTable_(Tuner, CachePath, k, &Tuner->Report.Decisions[k])) != NULL;
+  if (!Ok)
+  {
+    for (k = 0; k < PSYCHRO_N_KERNELS; k++)
+    {
+      PsychroTableDestroy(Tuner->Tables[k]);
+      Tuner->Tables[k] = NULL;
+    }
+    memset(&Tuner->Report, 0, sizeof Tuner->Report);
+  }
+  return Ok;
+}
+
+
+/******************************************************************************************************
+ * Tuning
+ *****************************************************************************************************/
+
+// Select the backends, from the cache file if it matches, by measuring them otherwise.
+PsychroAutotune *PsychroAutotuneCreate  // (o) Tuned kernels, NULL if the configuration is invalid or out of memory
+  ( const struct PsychroAutotuneConfig *Config // (i) Workload, tolerances and cache file
+  )
+{
+  PsychroAutotune *Tuner;
+  double Start = Now_();
+
+  if (!(Config->TDryBulbMin >= (isIP() ? -148. : -100.) && Config->TDryBulbMax <= (isIP() ? 392. : 200.)
+        && Config->TDryBulbMin < Config->TDryBulbMax && Config->HumRatioMin >= 0.
+        && Config->HumRatioMin < Config->HumRatioMax && Config->PressureMin > 0.
+        && Config->PressureMin <= Config->PressureMax && isfinite(Config->PressureMax) && Config->BatchSize > 0
+        && Config->Tolerance > 0. && Config->SatVapPresTolerance > 0.))
+    return NULL;
+
+  Tuner = calloc(1, sizeof(PsychroAutotune));
+  if (Tuner == NULL)
+    return NULL;
+  Tuner->Config = *Config;
+  Tuner->Config.CachePath = NULL;
+  Tuner->FixedPressure = Config->PressureMin == Config->PressureMax;
+  Tuner->Site = PsychroSiteCreate(Config->PressureMin);
+  if (Tuner->Site == NULL)
+  {
+    free(Tuner);
+    return NULL;
+  }
+
+  if (Config->CachePath != NULL && ReadCache_(Tuner, Config->CachePath))
+    Tuner->Report.FromCache = 1;
+  else
+  {
+    if (!Tune_(Tuner))
+    {
+      PsychroAutotuneDestroy(Tuner);
+      return NULL;
+    }
+    if (Config->CachePath != NULL)
+      WriteCache_(Tuner, Config->CachePath);
+  }
+  Tuner->Report.TuningTime = Now_() - Start;
+  return Tuner;
+}
+
+void PsychroAutotuneDestroy
+  ( PsychroAutotune *Tuner              // (i) Tuned kernels to free, may be NULL
+  )
+{
+  int Kernel;
+
+  if (Tuner == NULL)
+    return;
+  for (Kernel = 0; Kernel < PSYCHRO_N_KERNELS; Kernel++)
+    PsychroTableDestroy(Tuner->Tables[Kernel]);
+  PsychroSiteDestroy(Tuner->Site);
+  free(Tuner);
+}
+
+void PsychroAutotuneGetReport
+  ( const PsychroAutotune *Tuner        // (i) Tuned kernels
+  , struct PsychroAutotuneReport *Report // (o) Decisions and measurements
+  )
+{
+  *Report = Tuner->Report;
+}
+
+const char *PsychroGetBackendName       // (o) Name of the backend, as written in the cache file
+  ( enum PsychroBackend Backend         // (i) Backend
+  )
+{
+  return (unsigned) Backend < PSYCHRO_N_BACKENDS ? BACKEND_NAMES[Backend] : "unknown";
+}
+
+
+/******************************************************************************************************
+ * Tuned batch functions
+ *****************************************************************************************************/
+
+void PsychroAutotuneGetSatVapPres
+  ( const PsychroAutotune *Tuner        // (i) Tuned kernels
+  , size_t Count                        // (i) Number of points
+  , const double *TDryBulb              // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double *SatVapPres                  // (o) Vapor Pressure of saturated air in Psi [IP] or Pa [SI]
+  )
+{
+  Run_(Tuner, PSYCHRO_KERNEL_SAT_VAP_PRES, Tuner->Report.Decisions[PSYCHRO_KERNEL_SAT_VAP_PRES].Backend, NULL, Count,
+    TDryBulb, NULL, NULL, SatVapPres);
+}
+
+void PsychroAutotuneGetTDewPointFromHumRatio
+  ( const PsychroAutotune *Tuner        // (i) Tuned kernels
+  , size_t Count                        // (i) Number of points
+  , const double *TDryBulb              // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *HumRatio              // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *TDewPoint                   // (o) Dew point temperature in °F [IP] or °C [SI]
+  )
+{
+  Run_(Tuner, PSYCHRO_KERNEL_TDEW_POINT, Tuner->Report.Decisions[PSYCHRO_KERNEL_TDEW_POINT].Backend,
+    Tuner->Tables[PSYCHRO_KERNEL_TDEW_POINT], Count, TDryBulb, HumRatio, Pressure, TDewPoint);
+}
+
+void PsychroAutotuneGetTWetBulbFromHumRatio
+  ( const PsychroAutotune *Tuner        // (i) Tuned kernels
+  , size_t Count                        // (i) Number of points
+  , const double *TDryBulb              // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *HumRatio              // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *TWetBulb                    // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  )
+{
+  Run_(Tuner, PSYCHRO_KERNEL_TWET_BULB, Tuner->Report.Decisions[PSYCHRO_KERNEL_TWET_BULB].Backend,
+    Tuner->Tables[PSYCHRO_KERNEL_TWET_BULB], Count, TDryBulb, HumRatio, Pressure, TWetBulb);
+}
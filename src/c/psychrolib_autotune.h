@@ -0,0 +1,127 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Autotuner: selection of the fastest backend meeting an accuracy target on the host, with a
+ * cache file of the decisions.
+ * See psychrolib_autotune.c for details.
+*/
+
+#ifndef PSYCHROLIB_AUTOTUNE_H
+#define PSYCHROLIB_AUTOTUNE_H
+
+#include <stddef.h>
+
+
+/******************************************************************************************************
+ * Kernels, backends, configuration and report
+ *****************************************************************************************************/
+
+typedef struct PsychroAutotune PsychroAutotune;
+
+// Tuned functions
+enum PsychroKernel
+{
+  PSYCHRO_KERNEL_SAT_VAP_PRES,          // GetSatVapPres
+  PSYCHRO_KERNEL_TDEW_POINT,            // GetTDewPointFromHumRatio
+  PSYCHRO_KERNEL_TWET_BULB,             // GetTWetBulbFromHumRatio
+  PSYCHRO_N_KERNELS
+};
+
+// Candidate implementations of the kernels
+enum PsychroBackend
+{
+  PSYCHRO_BACKEND_GENERIC,              // Functions of psychrolib.c
+  PSYCHRO_BACKEND_BOUNDED,              // Fixed-iteration functions of psychrolib_bounded.c
+  PSYCHRO_BACKEND_SITE,                 // Site context of psychrolib_site.c, at a fixed pressure
+  PSYCHRO_BACKEND_TABLE_TRILINEAR,      // Trilinear property table of psychrolib_table.c
+  PSYCHRO_BACKEND_TABLE_CUBIC,          // Cubic property table of psychrolib_table.c
+  PSYCHRO_N_BACKENDS
+};
+
+// Workload of the caller
+struct PsychroAutotuneConfig
+{
+  double TDryBulbMin;                   // Range of dry bulb temperature in °F [IP] or °C [SI]
+  double TDryBulbMax;
+  double HumRatioMin;                   // Range of humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  double HumRatioMax;
+  double PressureMin;                   // Range of atmospheric pressure in Psi [IP] or Pa [SI], equal for a fixed pressure
+  double PressureMax;
+  size_t BatchSize;                     // Number of points per call
+  double Tolerance;                     // Maximum absolute error of the dew-point and wet-bulb temperatures in °F [IP] or °C [SI]
+  double SatVapPresTolerance;           // Maximum relative error of the saturation vapor pressure
+  const char *CachePath;                // File of the decisions, NULL to tune at every creation
+};
+
+// Decision for one kernel
+struct PsychroAutotuneDecision
+{
+  enum PsychroBackend Backend;          // Fastest backend meeting the tolerance, or most accurate if none does
+  double TimePerPoint;                  // Time per point of the backend in ns, on batches of BatchSize points
+  double MaxError;                      // Maximum error of the backend on the sample points
+  size_t TableCount[3];                 // Nodes of the table along each axis, 0 if not a table
+};
+
+struct PsychroAutotuneReport
+{
+  int FromCache;                        // 1 if the decisions were read from the cache file, 0 if measured
+  double TuningTime;                    // Time to measure or read the decisions and build the backends in s
+  struct PsychroAutotuneDecision Decisions[PSYCHRO_N_KERNELS];
+  // Time per point in ns of each candidate, 0 if unavailable, rejected or not measured (read from the cache)
+  double CandidateTime[PSYCHRO_N_KERNELS][PSYCHRO_N_BACKENDS];
+};
+
+
+/******************************************************************************************************
+ * Tuning
+ *****************************************************************************************************/
+
+PsychroAutotune *PsychroAutotuneCreate  // (o) Tuned kernels, NULL if the configuration is invalid or out of memory
+  ( const struct PsychroAutotuneConfig *Config // (i) Workload, tolerances and cache file
+  );
+
+void PsychroAutotuneDestroy
+  ( PsychroAutotune *Tuner              // (i) Tuned kernels to free, may be NULL
+  );
+
+void PsychroAutotuneGetReport
+  ( const PsychroAutotune *Tuner        // (i) Tuned kernels
+  , struct PsychroAutotuneReport *Report // (o) Decisions and measurements
+  );
+
+const char *PsychroGetBackendName       // (o) Name of the backend, as written in the cache file
+  ( enum PsychroBackend Backend         // (i) Backend
+  );
+
+
+/******************************************************************************************************
+ * Tuned batch functions
+ *****************************************************************************************************/
+
+void PsychroAutotuneGetSatVapPres
+  ( const PsychroAutotune *Tuner        // (i) Tuned kernels
+  , size_t Count                        // (i) Number of points
+  , const double *TDryBulb              // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double *SatVapPres                  // (o) Vapor Pressure of saturated air in Psi [IP] or Pa [SI]
+  );
+
+void PsychroAutotuneGetTDewPointFromHumRatio
+  ( const PsychroAutotune *Tuner        // (i) Tuned kernels
+  , size_t Count                        // (i) Number of points
+  , const double *TDryBulb              // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *HumRatio              // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *TDewPoint                   // (o) Dew point temperature in °F [IP] or °C [SI]
+  );
+
+void PsychroAutotuneGetTWetBulbFromHumRatio
+  ( const PsychroAutotune *Tuner        // (i) Tuned kernels
+  , size_t Count                        // (i) Number of points
+  , const double *TDryBulb              // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *HumRatio              // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *TWetBulb                    // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  );
+
+#endif // PSYCHROLIB_AUTOTUNE_H
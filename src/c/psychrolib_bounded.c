@@ -0,0 +1,1049 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Bounded-latency functions with a fixed operation count, for real-time control loops.
+ *
+ *  The generic functions iterate until a tolerance is reached: up to MAX_ITER_COUNT Newton-Raphson
+ *  steps for the dew-point temperature and a bisection for the wet-bulb temperature, and exit the
+ *  program when an input is invalid or the iterations do not converge. The functions of this module
+ *  instead run a fixed number of steps from an approximate solution, and return a status:
+ *   - PSYCHRO_STATUS_OK when the result is within the documented accuracy;
+ *   - PSYCHRO_STATUS_NOT_CONVERGED when the last step is larger than the documented accuracy; the
+ *     result is the last estimate, within the range of validity of the equations;
+ *   - another status when an input is invalid; the outputs are then set to INVALID (-99999).
+ *  They never loop on the data and never exit, and the latency is bounded by the path with the
+ *  largest number of operations below.
+ *
+ *  Dew-point temperature
+ *   Initial estimate from ln(Pws) = a - b / T fitted through the ends of ASHRAE eqn. 5 or 6 (the
+ *   error is below 0.1 K below the triple point and 4 K above), then DEW_POINT_STEPS Newton-Raphson
+ *   steps on ln(Pws). The result is within 1e-9 °F [IP] or °C [SI] of the exact inverse of eqn. 5
+ *   and 6 over their whole range of validity.
+ *
+ *  Wet-bulb temperature
+ *   ASHRAE eqn. 33 and 35 are rearranged as Wsstar(Tstar) = R(Tstar), where R is a smooth function
+ *   of the wet-bulb temperature. The estimate is first obtained with one Newton-Raphson step from
+ *   the dry-bulb temperature on the convex function (A - B * Tstar) * (Wsstar - R), which gives an
+ *   upper bound of the solution; it is then refined with WET_BULB_STEPS Newton-Raphson steps on
+ *   ln(Pws(Tstar)) - ln(Pw(R(Tstar))), which has no pole at the boiling point unlike the humidity
+ *   ratio. The last step is below SOLVER_TOLERANCE over the range of validity of the equations,
+ *   down to a relative humidity of 1e-6 and at pressures down to 0.2 psi [IP] or 1 kPa [SI].
+ *   When the humidity ratio is in the narrow band where eqn. 33 and 35 have a solution on each side
+ *   of the freezing point, the bracket is first bisected as in the generic function, for at most
+ *   BISECTION_STEPS steps, so that the same solution is returned.
+ *   The generic function bisects to within PSYCHROLIB_TOLERANCE, and the results of both differ by
+ *   less than that tolerance.
+ *   Above the boiling point at the pressure, the saturation humidity ratio is negative: the upper
+ *   bound is then first lowered with the dew-point solver to the temperature at which Pws is
+ *   BOILING_FRACTION of the pressure. The generic function does not exclude these temperatures, and
+ *   its bisection converges to the dry-bulb temperature when its first midpoint is above the
+ *   boiling point, and both functions differ there.
+ *
+ *  Operation count, in evaluations of log and exp:
+ *   BoundedGetSatVapPres, BoundedGetSatHumRatio,
+ *   BoundedGetHumRatioFromRelHum, BoundedGetHumRatioFromTWetBulb    1 log,  1 exp
+ *   BoundedGetTDewPointFromVapPres, BoundedGetTDewPointFromHumRatio  5 log
+ *   BoundedGetTDewPointFromRelHum                                    6 log,  1 exp
+ *   BoundedGetTWetBulbFromHumRatio                                  15 log,  1 exp
+ *   BoundedGetTWetBulbFromRelHum                                    16 log,  2 exp
+ *   BoundedCalcPsychrometricsFromTWetBulb                            7 log,  2 exp
+ *   BoundedCalcPsychrometricsFromTDewPoint                          17 log,  3 exp
+ *   BoundedCalcPsychrometricsFromRelHum                             21 log,  2 exp
+ *  In the band of two solutions of the wet-bulb temperature, the functions that solve for it take
+ *  at most 25 log and 20 exp more, and above the boiling point 6 log and 1 exp more.
+ *  The worst-case execution time of each function is measured by benchmarks/c/bench_psychrolib_bounded.c,
+ *  which is run by benchmarks/run_benchmarks.py.
+ *
+ *  Freestanding configuration
+ *   Defining PSYCHROLIB_FREESTANDING builds the module without the hosted C library and without
+ *   psychrolib.c, e.g. for microcontrollers. Only stddef.h and stdint.h are included, and errors are
+ *   only reported through the status codes.
+ *   - The system of units is fixed at compile time by defining PSYCHROLIB_UNITS_SI or
+ *     PSYCHROLIB_UNITS_IP, which removes the mutable unit system of psychrolib.c and the constants of
+ *     the other system. PSYCHRO_STATUS_UNITS_UNDEFINED is then never returned.
+ *   - exp and log are replaced by the bundled Exp_ and Log_, within 2 units in the last place of the
+ *     functions of the C library. They can also be used in hosted builds with PSYCHROLIB_BUNDLED_MATH.
+ *   - Defining PSYCHROLIB_SINGLE_PRECISION makes PsychroReal, the type of the arguments and of all
+ *     calculations, float instead of double, for processors with a single-precision FPU. The
+ *     temperatures are then within 5e-4 °F [IP] or °C [SI] of the double-precision results, the other
+ *     outputs within 5e-5 relative below 90 % of the boiling point, and SOLVER_TOLERANCE is 1e-3.
+ *   Unused functions are removed at link time with -ffunction-sections -fdata-sections -Wl,--gc-sections:
+ *     cc -ffreestanding -Os -ffunction-sections -fdata-sections -DPSYCHROLIB_FREESTANDING
+ *        -DPSYCHROLIB_UNITS_SI -DPSYCHROLIB_SINGLE_PRECISION -c psychrolib_bounded.c
+ *
+ *  Footprint budget of the freestanding build, in bytes: code of the function and of the functions it
+ *  calls, and stack of its deepest call chain, measured with gcc -Os on x86-64 as a proxy of the targets.
+ *  In single precision, the read-only data add 176 bytes for the constants of the system of units, less
+ *  than 200 bytes for the other constants, and 560 bytes for the messages of PsychroGetStatusMessage.
+ *  The budget is checked in single and double precision by tests/test_psychrolib_freestanding.py.
+ *   Function                                  Code  Stack
+ *   BoundedGetSatVapPres                       800     32
+ *   BoundedGetSatHumRatio                      900     64
+ *   BoundedGetHumRatioFromRelHum              1000     64
+ *   BoundedGetHumRatioFromTWetBulb            1000     48
+ *   BoundedGetTDewPointFromVapPres             900     64
+ *   BoundedGetTDewPointFromRelHum             1300     80
+ *   BoundedGetTDewPointFromHumRatio           1000     64
+ *   BoundedGetTWetBulbFromHumRatio            3000    160
+ *   BoundedGetTWetBulbFromRelHum              3200    192
+ *   BoundedCalcPsychrometricsFromTWetBulb     2100    128
+ *   BoundedCalcPsychrometricsFromTDewPoint    3600    256
+ *   BoundedCalcPsychrometricsFromRelHum       3700    256
+ *   PsychroGetStatusMessage                    200     16
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_bounded.h"
+ *  SetUnitSystem(SI);
+ *  if (BoundedGetTWetBulbFromRelHum(TDryBulb, RelHum, Pressure, &TWetBulb) != PSYCHRO_STATUS_OK)
+ *    ...
+ */
+
+// Configuration of the freestanding build, see the module overview
+#ifdef PSYCHROLIB_FREESTANDING
+#if !defined(PSYCHROLIB_UNITS_SI) && !defined(PSYCHROLIB_UNITS_IP)
+#error "The freestanding build requires PSYCHROLIB_UNITS_SI or PSYCHROLIB_UNITS_IP"
+#endif
+#ifndef PSYCHROLIB_BUNDLED_MATH
+#define PSYCHROLIB_BUNDLED_MATH
+#endif
+#endif
+
+// Standard C header files, all of them available in freestanding environments but math.h
+#include <stddef.h>
+#include <stdint.h>
+#ifndef PSYCHROLIB_BUNDLED_MATH
+#include <math.h>
+#endif
+
+// Header specific to this file
+#if !defined(PSYCHROLIB_UNITS_SI) && !defined(PSYCHROLIB_UNITS_IP)
+#include "psychrolib.h"
+#endif
+#include "psychrolib_bounded.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define DEW_POINT_STEPS 4               // Number of Newton-Raphson steps of the dew-point temperature solver.
+
+#define WET_BULB_STEPS 7                // Number of Newton-Raphson steps of the wet-bulb temperature solver.
+
+#define BISECTION_STEPS 20              // Maximum number of bisection steps around the freezing point.
+
+#define BOILING_FRACTION REAL_(0.999)   // Saturation vapor pressure at the upper bound of the wet-bulb temperature, as a
+                                        // fraction of the pressure, when the dry-bulb temperature is above the boiling point.
+
+#define REAL_(x) ((PsychroReal)(x))    // Floating-point constant of the precision of the functions.
+
+#ifdef PSYCHROLIB_SINGLE_PRECISION
+#define SOLVER_TOLERANCE REAL_(1e-3)    // Accuracy of the solvers in °F [IP] or °C [SI], above the rounding errors of float.
+#else
+#define SOLVER_TOLERANCE REAL_(1e-6)    // Accuracy of the solvers in °F [IP] or °C [SI].
+#endif
+
+#define MIN_HUM_RATIO REAL_(1e-7)       // Minimum acceptable humidity ratio used/returned by any functions.
+
+#define MOLAR_MASS_RATIO REAL_(0.621945) // Ratio of the molar masses of water vapor and dry air.
+
+#define INVALID -99999                  // Invalid value.
+
+
+/******************************************************************************************************
+ * Bundled math functions
+ *****************************************************************************************************/
+
+// Bit pattern of a floating-point number
+#ifdef PSYCHROLIB_SINGLE_PRECISION
+typedef uint32_t RealBits;
+#define MANTISSA_BITS 23
+#define EXPONENT_BIAS 127
+#else
+typedef uint64_t RealBits;
+#define MANTISSA_BITS 52
+#define EXPONENT_BIAS 1023
+#endif
+
+#define SIGN_BIT ((RealBits)1 << (8 * sizeof(RealBits) - 1))
+
+union RealAndBits
+{
+  PsychroReal Real;
+  RealBits Bits;
+};
+
+// Largest floating-point number below a finite Value, as nextafter(Value, -INFINITY)
+static PsychroReal NextBelow_
+  ( PsychroReal Value
+  )
+{
+  union RealAndBits x;
+
+  x.Real = Value;
+  if (Value == 0)
+    x.Bits = SIGN_BIT | 1;
+  else if (Value > 0)
+    x.Bits--;
+  else
+    x.Bits++;
+  return x.Real;
+}
+
+#ifdef PSYCHROLIB_BUNDLED_MATH
+
+// ln(2) = LN2_HI + LN2_LO, with the last bits of LN2_HI zero so that k * LN2_HI is exact
+#ifdef PSYCHROLIB_SINGLE_PRECISION
+#define LN2_HI REAL_(6.9314575195e-01)
+#define LN2_LO REAL_(1.4286067653e-06)
+#define EXP_LIMIT REAL_(87)             // Largest argument of Exp_ with a normal result
+#define EXP_TERMS 7                     // Number of terms of the series of Exp_ and Log_,
+#define LOG_TERMS 5                     // below the rounding error of the precision
+#else
+#define LN2_HI REAL_(6.93147180369123816490e-01)
+#define LN2_LO REAL_(1.90821492927058770002e-10)
+#define EXP_LIMIT REAL_(708)
+#define EXP_TERMS 13
+#define LOG_TERMS 11
+#endif
+
+// Natural logarithm of a positive normal number.
+// x = 2^k * m with m in [sqrt(2)/2, sqrt(2)), and ln(m) = 2 * atanh(s) with s = (m - 1) / (m + 1)
+// from the series of atanh, |s| being below 0.172.
+static PsychroReal Log_
+  ( PsychroReal x
+  )
+{
+  union RealAndBits m;
+  PsychroReal s, s2, Sum;
+  int k, index;
+
+  if (!(x > 0))
+    return (x - x) / (x - x);
+
+  m.Real = x;
+  k = (int)((m.Bits >> MANTISSA_BITS) & (2 * EXPONENT_BIAS + 1)) - EXPONENT_BIAS;
+  m.Bits = (m.Bits & (((RealBits)1 << MANTISSA_BITS) - 1)) | ((RealBits)EXPONENT_BIAS << MANTISSA_BITS);
+  if (m.Real > REAL_(1.41421356237309504880))
+  {
+    m.Real /= 2;
+    k++;
+  }
+
+  s = (m.Real - 1) / (m.Real + 1);
+  s2 = s * s;
+  Sum = 0;
+  for (index = LOG_TERMS - 1; index > 0; index--)
+    Sum = s2 * (REAL_(1) / (2 * index + 1) + Sum);
+  return k * LN2_HI + (2 * s * (1 + Sum) + k * LN2_LO);
+}
+
+// Exponential function.
+// exp(x) = 2^k * exp(r) with r = x - k * ln(2) in [-ln(2)/2, ln(2)/2], from the Taylor series of exp(r).
+static PsychroReal Exp_
+  ( PsychroReal x
+  )
+{
+  union RealAndBits Scale;
+  PsychroReal r, Sum;
+  int k, index;
+
+  if (!(x >= -EXP_LIMIT))
+    return x == x ? 0 : x;
+  if (x > EXP_LIMIT)
+    x = EXP_LIMIT;
+
+  k = (int)(x / LN2_HI + (x >= 0 ? REAL_(0.5) : REAL_(-0.5)));
+  r = (x - k * LN2_HI) - k * LN2_LO;
+  Sum = 1;
+  for (index = EXP_TERMS; index > 0; index--)
+    Sum = 1 + r * Sum / index;
+  Scale.Bits = (RealBits)(k + EXPONENT_BIAS) << MANTISSA_BITS;
+  return Sum * Scale.Real;
+}
+
+#endif
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+#ifndef min
+#define min(a,b)            (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifndef max
+#define max(a,b)            (((a) > (b)) ? (a) : (b))
+#endif
+
+#define ABS(a)              (((a) < 0) ? -(a) : (a))
+
+#ifdef PSYCHROLIB_BUNDLED_MATH
+#define LOG Log_
+#define EXP Exp_
+#elif defined(PSYCHROLIB_SINGLE_PRECISION)
+#define LOG logf
+#define EXP expf
+#else
+#define LOG log
+#define EXP exp
+#endif
+
+// Coefficients of ASHRAE eqn. 33 and 35:
+// HumRatio = ((A - B * TWetBulb) * Wsstar - C * (TDryBulb - TWetBulb)) / (A + D * TDryBulb - E * TWetBulb)
+struct WetBulbCoeffs
+{
+  PsychroReal A, B, C, D, E;
+};
+
+// Constants of the equations in a system of units
+struct UnitConstants
+{
+  PsychroReal TMin;                          // Range of validity of ASHRAE eqn. 5 and 6
+  PsychroReal TMax;
+  PsychroReal TTriplePoint;                  // Triple point of water, where eqn. 5 and 6 join
+  PsychroReal FreezingPoint;                 // Freezing point of water, where eqn. 33 and 35 join
+  PsychroReal TAbsolute;                     // Offset of the absolute temperature scale
+  PsychroReal Tolerance;                     // PSYCHROLIB_TOLERANCE in this system of units
+  // ln(Pws) = c[0] / T + c[1] + c[2] * T + c[3] * T² + c[4] * T³ + c[5] * T⁴ + c[6] * ln(T)
+  PsychroReal LnPwsIce[7];                   // ASHRAE eqn. 5, at or below the triple point
+  PsychroReal LnPwsLiquid[7];                // ASHRAE eqn. 6, above the triple point
+  // Initial estimate of the dew point: ln(Pws) = a - b / T, with {a, b}
+  PsychroReal GuessIce[2];
+  PsychroReal GuessLiquid[2];
+  PsychroReal PwsMin;                        // Pws at TMin
+  PsychroReal PwsMax;                        // Pws at TMax
+  PsychroReal PwsFreezing;                   // Pws at the freezing point
+  PsychroReal LnPwsTriplePoint;         // ln(Pws) at the triple point
+  struct WetBulbCoeffs WetBulbLiquid;   // Coefficients at or above the freezing point
+  struct WetBulbCoeffs WetBulbIce;      // Coefficients below the freezing point
+  // Moist air enthalpy, ASHRAE eqn. 30: (c[0] * T + W * (c[1] + c[2] * T)) * c[3]
+  PsychroReal MoistAirEnthalpy[4];
+  // Moist air specific volume, ASHRAE eqn. 26: R * T * (1 + 1.607858 * W) / (c * Pressure), with {R, c}
+  PsychroReal MoistAirVolume[2];
+};
+
+#ifndef PSYCHROLIB_UNITS_SI
+static const struct UnitConstants UNITS_IP =
+{
+  -148., 392., 32.018, 32., 459.67, 0.001 * 9. / 5.,
+  { -1.0214165E+04, -4.8932428, -5.3765794E-03, 1.9202377E-07, 3.5575832E-10, -9.0344688E-14, 4.1635019 },
+  { -1.0440397E+04, -1.1294650E+01, -2.7022355E-02, 1.2890360E-05, -2.4780681E-09, 0., 6.5459673 },
+  { 20.05688635, 11052.76862 },
+  { 16.12810087, 9121.031946 },
+  2.0379258473778719e-07, 225.54421926473844, 0.088640263528294724, -2.422345646293131,
+  { 1093., 0.556, 0.240, 0.444, 1. },
+  { 1220., 0.04, 0.240, 0.444, 0.48 },
+  { 0.240, 1061., 0.444, 1. },
+  { 53.350, 144. }
+};
+#endif
+
+#ifndef PSYCHROLIB_UNITS_IP
+static const struct UnitConstants UNITS_SI =
+{
+  -100., 200., 0.01, 0., 273.15, 0.001,
+  { -5.6745359E+03, 6.3925247, -9.677843E-03, 6.2215701E-07, 2.0747825E-09, -9.484024E-13, 4.1635019 },
+  { -5.8002206E+03, 1.3914993, -4.8640239E-02, 4.1764768E-05, -1.4452093E-08, 0., 6.5459673 },
+  { 28.89540292, 6140.426798 },
+  { 24.96661808, 5067.239931 },
+  0.0014051021238741541, 1555073.745636215, 611.15357089076792, 6.4161717077576874,
+  { 2501., 2.326, 1.006, 1.86, 4.186 },
+  { 2830., 0.24, 1.006, 1.86, 2.1 },
+  { 1.006, 2501., 1.86, 1000. },
+  { 287.042, 1. }
+};
+#endif
+
+// Constants of the system of units in use, NULL if it is not defined
+static const struct UnitConstants *GetUnitConstants_(void)
+{
+#if defined(PSYCHROLIB_UNITS_SI)
+  return &UNITS_SI;
+#elif defined(PSYCHROLIB_UNITS_IP)
+  return &UNITS_IP;
+#else
+  switch (GetUnitSystem())
+  {
+    case IP:
+      return &UNITS_IP;
+    case SI:
+      return &UNITS_SI;
+    default:
+      return NULL;
+  }
+#endif
+}
+
+static int IsTemperatureValid_
+  ( const struct UnitConstants *Units
+  , PsychroReal Temperature
+  )
+{
+  return Temperature >= Units->TMin && Temperature <= Units->TMax;
+}
+
+// Natural log of the saturation vapor pressure from ASHRAE eqn. 5 and 6, and its derivative
+static PsychroReal LnPws_
+  ( const struct UnitConstants *Units
+  , PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal *dLnPws         // (o) Derivative in °F⁻¹ [IP] or K⁻¹ [SI], may be NULL
+  )
+{
+  const PsychroReal *c = TDryBulb <= Units->TTriplePoint ? Units->LnPwsIce : Units->LnPwsLiquid;
+  PsychroReal T = TDryBulb + Units->TAbsolute;
+
+  if (dLnPws != NULL)
+    *dLnPws = -c[0] / (T * T) + c[2] + T * (2 * c[3] + T * (3 * c[4] + 4 * c[5] * T)) + c[6] / T;
+  return c[0] / T + c[1] + T * (c[2] + T * (c[3] + T * (c[4] + T * c[5]))) + c[6] * LOG(T);
+}
+
+static PsychroReal HumRatioFromVapPres_
+  ( PsychroReal VapPres
+  , PsychroReal Pressure
+  )
+{
+  return max(MOLAR_MASS_RATIO * VapPres / (Pressure - VapPres), MIN_HUM_RATIO);
+}
+
+static PsychroReal VapPresFromHumRatio_
+  ( PsychroReal HumRatio
+  , PsychroReal Pressure
+  )
+{
+  HumRatio = max(HumRatio, MIN_HUM_RATIO);
+  return Pressure * HumRatio / (MOLAR_MASS_RATIO + HumRatio);
+}
+
+// Humidity ratio from ASHRAE eqn. 33 or 35, bounded as in the generic function
+static PsychroReal HumRatioFromWsstar_
+  ( const struct WetBulbCoeffs *k
+  , PsychroReal TDryBulb
+  , PsychroReal TWetBulb
+  , PsychroReal Wsstar
+  )
+{
+  Wsstar = max(Wsstar, MIN_HUM_RATIO);
+  return ((k->A - k->B * TWetBulb) * Wsstar - k->C * (TDryBulb - TWetBulb)) / (k->A + k->D * TDryBulb - k->E * TWetBulb);
+}
+
+static PsychroReal HumRatioFromTWetBulb_
+  ( const struct UnitConstants *Units
+  , PsychroReal TDryBulb
+  , PsychroReal TWetBulb
+  , PsychroReal Pressure
+  )
+{
+  PsychroReal Pws = EXP(LnPws_(Units, TWetBulb, NULL));
+  const struct WetBulbCoeffs *k = TWetBulb >= Units->FreezingPoint ? &Units->WetBulbLiquid : &Units->WetBulbIce;
+
+  return max(HumRatioFromWsstar_(k, TDryBulb, TWetBulb, MOLAR_MASS_RATIO * Pws / (Pressure - Pws)), MIN_HUM_RATIO);
+}
+
+// Moist air enthalpy as in the generic function
+static PsychroReal MoistAirEnthalpy_
+  ( const struct UnitConstants *Units
+  , PsychroReal TDryBulb
+  , PsychroReal HumRatio
+  )
+{
+  const PsychroReal *c = Units->MoistAirEnthalpy;
+
+  HumRatio = max(HumRatio, MIN_HUM_RATIO);
+  return (c[0] * TDryBulb + HumRatio * (c[1] + c[2] * TDryBulb)) * c[3];
+}
+
+// Moist air specific volume as in the generic function
+static PsychroReal MoistAirVolume_
+  ( const struct UnitConstants *Units
+  , PsychroReal TDryBulb
+  , PsychroReal HumRatio
+  , PsychroReal Pressure
+  )
+{
+  const PsychroReal *c = Units->MoistAirVolume;
+
+  HumRatio = max(HumRatio, MIN_HUM_RATIO);
+  return c[0] * (TDryBulb + Units->TAbsolute) * (1 + REAL_(1.607858) * HumRatio) / (c[1] * Pressure);
+}
+
+static enum PsychroStatus TDewPointFromVapPres_
+  ( const struct UnitConstants *Units
+  , PsychroReal TDryBulb
+  , PsychroReal VapPres
+  , PsychroReal *TDewPoint
+  )
+{
+  const PsychroReal *Guess;
+  PsychroReal lnVP, T, dLnPws, Step = 0;
+  int index;
+
+  if (!(VapPres >= Units->PwsMin && VapPres <= Units->PwsMax))
+  {
+    *TDewPoint = INVALID;
+    return PSYCHRO_STATUS_VAP_PRES_OUT_OF_RANGE;
+  }
+
+  lnVP = LOG(VapPres);
+  Guess = lnVP <= Units->LnPwsTriplePoint ? Units->GuessIce : Units->GuessLiquid;
+  T = Guess[1] / (Guess[0] - lnVP) - Units->TAbsolute;
+
+  for (index = 0; index < DEW_POINT_STEPS; index++)
+  {
+    T = min(max(T, Units->TMin), Units->TMax);
+    Step = (LnPws_(Units, T, &dLnPws) - lnVP) / dLnPws;
+    T -= Step;
+  }
+  T = min(max(T, Units->TMin), Units->TMax);
+
+  *TDewPoint = min(T, TDryBulb);
+  return ABS(Step) <= SOLVER_TOLERANCE ? PSYCHRO_STATUS_OK : PSYCHRO_STATUS_NOT_CONVERGED;
+}
+
+// Fixed number of Newton-Raphson steps for the wet-bulb temperature between TWetBulbInf and
+// TWetBulbSup, with the coefficients k of one side of the freezing point. See the module overview.
+static enum PsychroStatus PolishTWetBulb_
+  ( const struct UnitConstants *Units
+  , const struct WetBulbCoeffs *k
+  , PsychroReal TDryBulb
+  , PsychroReal HumRatio
+  , PsychroReal Pressure
+  , PsychroReal TWetBulbInf
+  , PsychroReal TWetBulbSup
+  , PsychroReal *TWetBulb
+  )
+{
+  PsychroReal T, TNext, Pws, dLnPws, Wsstar, dWsstar, f, df, N, Den, R, dR, Step = 0;
+  int index;
+
+  // Newton-Raphson step from TWetBulbSup on (A - B * Tstar) * Wsstar - C * (TDryBulb - Tstar) - HumRatio * Den
+  T = TWetBulbSup;
+  Pws = EXP(LnPws_(Units, T, &dLnPws));
+
+  // Upper bound above the boiling point at the pressure, where Wsstar is negative: start instead
+  // from the temperature at which Pws is BOILING_FRACTION of the pressure, whose Wsstar is above 600
+  if (!(Pws < Pressure))
+  {
+    TDewPointFromVapPres_(Units, TDryBulb, BOILING_FRACTION * Pressure, &T);
+    TWetBulbSup = T;
+    Pws = EXP(LnPws_(Units, T, &dLnPws));
+  }
+  Wsstar = MOLAR_MASS_RATIO * Pws / (Pressure - Pws);
+  dWsstar = Wsstar * dLnPws * Pressure / (Pressure - Pws);
+  f = (k->A - k->B * T) * Wsstar - k->C * (TDryBulb - T) - HumRatio * (k->A + k->D * TDryBulb - k->E * T);
+  df = -k->B * Wsstar + (k->A - k->B * T) * dWsstar + k->C + HumRatio * k->E;
+
+  // Air saturated at the upper bound, or saturation humidity ratio below MIN_HUM_RATIO, where the
+  // generic function bisects up to the upper bound
+  if (!(f > 0) || Wsstar < MIN_HUM_RATIO)
+  {
+    *TWetBulb = TWetBulbSup;
+    return PSYCHRO_STATUS_OK;
+  }
+  TNext = T - f / df;
+  T = TNext >= TWetBulbInf ? TNext : TWetBulbInf;
+
+  // Newton-Raphson steps on ln(Pws(Tstar)) - ln(Pw(R(Tstar))), safeguarded by the bracket
+  for (index = 0; index < WET_BULB_STEPS; index++)
+  {
+    N = HumRatio * (k->A + k->D * TDryBulb - k->E * T) + k->C * (TDryBulb - T);
+    Den = k->A - k->B * T;
+    R = N / Den;
+    dR = (-HumRatio * k->E - k->C + R * k->B) / Den;
+
+    f = LnPws_(Units, T, &dLnPws) - LOG(Pressure * R / (MOLAR_MASS_RATIO + R));
+    df = dLnPws - dR * MOLAR_MASS_RATIO / (R * (MOLAR_MASS_RATIO + R));
+    if (f > 0)
+      TWetBulbSup = T;
+    else
+      TWetBulbInf = T;
+
+    TNext = T - f / df;
+    if (!(TNext >= TWetBulbInf && TNext <= TWetBulbSup))
+      TNext = (TWetBulbInf + TWetBulbSup) / 2;
+    Step = TNext - T;
+    T = TNext;
+  }
+
+  *TWetBulb = T;
+  return ABS(Step) <= SOLVER_TOLERANCE || TWetBulbSup - TWetBulbInf <= SOLVER_TOLERANCE
+    ? PSYCHRO_STATUS_OK : PSYCHRO_STATUS_NOT_CONVERGED;
+}
+
+// Wet-bulb temperature, after the inputs have been checked. See the module overview.
+static enum PsychroStatus TWetBulbFromHumRatio_
+  ( const struct UnitConstants *Units
+  , PsychroReal TDryBulb
+  , PsychroReal HumRatio
+  , PsychroReal Pressure
+  , PsychroReal *TWetBulb
+  )
+{
+  const struct WetBulbCoeffs *k;
+  PsychroReal VapPres, TDewPoint, TWetBulbInf, TWetBulbSup, Wsstar, WIce, WLiquid, T;
+  enum PsychroStatus Status;
+  int index;
+
+  HumRatio = max(HumRatio, MIN_HUM_RATIO);
+  VapPres = VapPresFromHumRatio_(HumRatio, Pressure);
+  if (!(VapPres >= Units->PwsMin && VapPres <= Units->PwsMax))
+  {
+    *TWetBulb = INVALID;
+    return PSYCHRO_STATUS_VAP_PRES_OUT_OF_RANGE;
+  }
+
+  // The solution is above the dew-point temperature, which is below the freezing point
+  // if and only if the vapor pressure is below its saturation value there
+  TWetBulbInf = Units->TMin;
+  TWetBulbSup = TDryBulb;
+  if (TDryBulb < Units->FreezingPoint)
+    k = &Units->WetBulbIce;
+  else if (VapPres >= Units->PwsFreezing)
+  {
+    k = &Units->WetBulbLiquid;
+    TWetBulbInf = Units->FreezingPoint;
+  }
+  else
+  {
+    // Select the side of the freezing point from the limits of eqn. 33 and 35 there
+    Wsstar = MOLAR_MASS_RATIO * Units->PwsFreezing / (Pressure - Units->PwsFreezing);
+    WIce = HumRatioFromWsstar_(&Units->WetBulbIce, TDryBulb, Units->FreezingPoint, Wsstar);
+    WLiquid = HumRatioFromWsstar_(&Units->WetBulbLiquid, TDryBulb, Units->FreezingPoint, Wsstar);
+    if (HumRatio < min(WIce, WLiquid))
+    {
+      k = &Units->WetBulbIce;
+      TWetBulbSup = NextBelow_(Units->FreezingPoint);
+    }
+    else if (HumRatio > max(WIce, WLiquid))
+    {
+      k = &Units->WetBulbLiquid;
+      TWetBulbInf = Units->FreezingPoint;
+    }
+    else
+    {
+      // A solution on each side: bisect from the dew point as the generic function does
+      Status = TDewPointFromVapPres_(Units, TDryBulb, VapPres, &TDewPoint);
+      TWetBulbInf = TDewPoint;
+      T = (TWetBulbInf + TWetBulbSup) / 2;
+      for (index = 0; index < BISECTION_STEPS && TWetBulbInf < Units->FreezingPoint && TWetBulbSup >= Units->FreezingPoint; index++)
+      {
+        if (TWetBulbSup - TWetBulbInf <= Units->Tolerance)
+          break;
+        if (HumRatioFromTWetBulb_(Units, TDryBulb, T, Pressure) > HumRatio)
+          TWetBulbSup = T;
+        else
+          TWetBulbInf = T;
+        T = (TWetBulbInf + TWetBulbSup) / 2;
+      }
+      if (TWetBulbInf < Units->FreezingPoint && TWetBulbSup >= Units->FreezingPoint)
+      {
+        *TWetBulb = T;
+        return TWetBulbSup - TWetBulbInf <= Units->Tolerance ? Status : PSYCHRO_STATUS_NOT_CONVERGED;
+      }
+      k = TWetBulbSup < Units->FreezingPoint ? &Units->WetBulbIce : &Units->WetBulbLiquid;
+    }
+  }
+
+  return PolishTWetBulb_(Units, k, TDryBulb, HumRatio, Pressure, TWetBulbInf, TWetBulbSup, TWetBulb);
+}
+
+
+/******************************************************************************************************
+ * Status codes
+ *****************************************************************************************************/
+
+const char *PsychroGetStatusMessage // (o) Description of the status
+  ( enum PsychroStatus Status       // (i) Status code
+  )
+{
+  switch (Status)
+  {
+    case PSYCHRO_STATUS_OK:
+      return "No error";
+    case PSYCHRO_STATUS_UNITS_UNDEFINED:
+      return "The system of units has not been defined";
+    case PSYCHRO_STATUS_TEMPERATURE_OUT_OF_RANGE:
+      return "Temperature is outside range of validity";
+    case PSYCHRO_STATUS_REL_HUM_OUT_OF_RANGE:
+      return "Relative humidity is outside range [0,1]";
+    case PSYCHRO_STATUS_NEGATIVE_HUM_RATIO:
+      return "Humidity ratio is negative";
+    case PSYCHRO_STATUS_NEGATIVE_VAP_PRES:
+      return "Partial pressure of water vapor in moist air is negative";
+    case PSYCHRO_STATUS_VAP_PRES_OUT_OF_RANGE:
+      return "Partial pressure of water vapor is outside range of validity of equations";
+    case PSYCHRO_STATUS_WET_BULB_ABOVE_DRY_BULB:
+      return "Wet bulb temperature is above dry bulb temperature";
+    case PSYCHRO_STATUS_DEW_POINT_ABOVE_DRY_BULB:
+      return "Dew point temperature is above dry bulb temperature";
+    case PSYCHRO_STATUS_SPECIFIC_HUM_OUT_OF_RANGE:
+      return "Specific humidity is outside range [0, 1)";
+    case PSYCHRO_STATUS_NOT_CONVERGED:
+      return "Convergence not reached within the fixed number of iterations";
+    case PSYCHRO_STATUS_PRESSURE_OUT_OF_RANGE:
+      return "Atmospheric pressure is not positive";
+    default:
+      return "Unknown status";
+  }
+}
+
+
+/******************************************************************************************************
+ * Bounded-latency functions
+ *****************************************************************************************************/
+
+// Return saturation vapor pressure given dry-bulb temperature.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 5 & 6
+enum PsychroStatus BoundedGetSatVapPres // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal *SatVapPres     // (o) Vapor Pressure of saturated air in Psi [IP] or Pa [SI]
+  )
+{
+  const struct UnitConstants *Units = GetUnitConstants_();
+
+  *SatVapPres = INVALID;
+  if (Units == NULL)
+    return PSYCHRO_STATUS_UNITS_UNDEFINED;
+  if (!IsTemperatureValid_(Units, TDryBulb))
+    return PSYCHRO_STATUS_TEMPERATURE_OUT_OF_RANGE;
+
+  *SatVapPres = EXP(LnPws_(Units, TDryBulb, NULL));
+  return PSYCHRO_STATUS_OK;
+}
+
+// Return humidity ratio of saturated air given dry-bulb temperature and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 36, solved for W
+enum PsychroStatus BoundedGetSatHumRatio // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *SatHumRatio    // (o) Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  )
+{
+  PsychroReal Pws;
+  enum PsychroStatus Status = BoundedGetSatVapPres(TDryBulb, &Pws);
+
+  *SatHumRatio = INVALID;
+  if (Status != PSYCHRO_STATUS_OK)
+    return Status;
+  if (!(Pressure > 0))
+    return PSYCHRO_STATUS_PRESSURE_OUT_OF_RANGE;
+
+  *SatHumRatio = HumRatioFromVapPres_(Pws, Pressure);
+  return PSYCHRO_STATUS_OK;
+}
+
+// Return humidity ratio given dry-bulb temperature, relative humidity, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+enum PsychroStatus BoundedGetHumRatioFromRelHum // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal RelHum          // (i) Relative humidity [0-1]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *HumRatio       // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  )
+{
+  PsychroReal Pws;
+  enum PsychroStatus Status = BoundedGetSatVapPres(TDryBulb, &Pws);
+
+  *HumRatio = INVALID;
+  if (Status != PSYCHRO_STATUS_OK)
+    return Status;
+  if (!(RelHum >= 0 && RelHum <= 1))
+    return PSYCHRO_STATUS_REL_HUM_OUT_OF_RANGE;
+  if (!(Pressure > 0))
+    return PSYCHRO_STATUS_PRESSURE_OUT_OF_RANGE;
+
+  *HumRatio = HumRatioFromVapPres_(RelHum * Pws, Pressure);
+  return PSYCHRO_STATUS_OK;
+}
+
+// Return humidity ratio given dry-bulb temperature, wet-bulb temperature, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 33 and 35
+enum PsychroStatus BoundedGetHumRatioFromTWetBulb // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal TWetBulb        // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *HumRatio       // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  )
+{
+  const struct UnitConstants *Units = GetUnitConstants_();
+
+  *HumRatio = INVALID;
+  if (Units == NULL)
+    return PSYCHRO_STATUS_UNITS_UNDEFINED;
+  if (!IsTemperatureValid_(Units, TWetBulb))
+    return PSYCHRO_STATUS_TEMPERATURE_OUT_OF_RANGE;
+  if (!(TWetBulb <= TDryBulb))
+    return PSYCHRO_STATUS_WET_BULB_ABOVE_DRY_BULB;
+  if (!(Pressure > 0))
+    return PSYCHRO_STATUS_PRESSURE_OUT_OF_RANGE;
+
+  *HumRatio = HumRatioFromTWetBulb_(Units, TDryBulb, TWetBulb, Pressure);
+  return PSYCHRO_STATUS_OK;
+}
+
+// Return dew-point temperature given dry-bulb temperature and vapor pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 5 and 6
+enum PsychroStatus BoundedGetTDewPointFromVapPres // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal VapPres         // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , PsychroReal *TDewPoint      // (o) Dew point temperature in °F [IP] or °C [SI]
+  )
+{
+  const struct UnitConstants *Units = GetUnitConstants_();
+
+  *TDewPoint = INVALID;
+  if (Units == NULL)
+    return PSYCHRO_STATUS_UNITS_UNDEFINED;
+  if (!IsTemperatureValid_(Units, TDryBulb))
+    return PSYCHRO_STATUS_TEMPERATURE_OUT_OF_RANGE;
+  if (!(VapPres >= 0))
+    return PSYCHRO_STATUS_NEGATIVE_VAP_PRES;
+
+  return TDewPointFromVapPres_(Units, TDryBulb, VapPres, TDewPoint);
+}
+
+// Return dew-point temperature given dry-bulb temperature and relative humidity.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+enum PsychroStatus BoundedGetTDewPointFromRelHum // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal RelHum          // (i) Relative humidity [0-1]
+  , PsychroReal *TDewPoint      // (o) Dew point temperature in °F [IP] or °C [SI]
+  )
+{
+  PsychroReal Pws;
+  enum PsychroStatus Status = BoundedGetSatVapPres(TDryBulb, &Pws);
+
+  *TDewPoint = INVALID;
+  if (Status != PSYCHRO_STATUS_OK)
+    return Status;
+  if (!(RelHum >= 0 && RelHum <= 1))
+    return PSYCHRO_STATUS_REL_HUM_OUT_OF_RANGE;
+
+  return TDewPointFromVapPres_(GetUnitConstants_(), TDryBulb, RelHum * Pws, TDewPoint);
+}
+
+// Return dew-point temperature given dry-bulb temperature, humidity ratio, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+enum PsychroStatus BoundedGetTDewPointFromHumRatio // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal HumRatio        // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *TDewPoint      // (o) Dew point temperature in °F [IP] or °C [SI]
+  )
+{
+  const struct UnitConstants *Units = GetUnitConstants_();
+
+  *TDewPoint = INVALID;
+  if (Units == NULL)
+    return PSYCHRO_STATUS_UNITS_UNDEFINED;
+  if (!IsTemperatureValid_(Units, TDryBulb))
+    return PSYCHRO_STATUS_TEMPERATURE_OUT_OF_RANGE;
+  if (!(HumRatio >= 0))
+    return PSYCHRO_STATUS_NEGATIVE_HUM_RATIO;
+  if (!(Pressure > 0))
+    return PSYCHRO_STATUS_PRESSURE_OUT_OF_RANGE;
+
+  return TDewPointFromVapPres_(Units, TDryBulb, VapPresFromHumRatio_(HumRatio, Pressure), TDewPoint);
+}
+
+// Return wet-bulb temperature given dry-bulb temperature, humidity ratio, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 33 and 35 solved for Tstar
+enum PsychroStatus BoundedGetTWetBulbFromHumRatio // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal HumRatio        // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *TWetBulb       // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  )
+{
+  const struct UnitConstants *Units = GetUnitConstants_();
+
+  *TWetBulb = INVALID;
+  if (Units == NULL)
+    return PSYCHRO_STATUS_UNITS_UNDEFINED;
+  if (!IsTemperatureValid_(Units, TDryBulb))
+    return PSYCHRO_STATUS_TEMPERATURE_OUT_OF_RANGE;
+  if (!(HumRatio >= 0))
+    return PSYCHRO_STATUS_NEGATIVE_HUM_RATIO;
+  if (!(Pressure > 0))
+    return PSYCHRO_STATUS_PRESSURE_OUT_OF_RANGE;
+
+  return TWetBulbFromHumRatio_(Units, TDryBulb, HumRatio, Pressure, TWetBulb);
+}
+
+// Return wet-bulb temperature given dry-bulb temperature, relative humidity, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+enum PsychroStatus BoundedGetTWetBulbFromRelHum // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal RelHum          // (i) Relative humidity [0-1]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *TWetBulb       // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  )
+{
+  PsychroReal HumRatio;
+  enum PsychroStatus Status = BoundedGetHumRatioFromRelHum(TDryBulb, RelHum, Pressure, &HumRatio);
+
+  *TWetBulb = INVALID;
+  if (Status != PSYCHRO_STATUS_OK)
+    return Status;
+  return TWetBulbFromHumRatio_(GetUnitConstants_(), TDryBulb, HumRatio, Pressure, TWetBulb);
+}
+
+
+/******************************************************************************************************
+ * Bounded-latency functions to set all psychrometric values
+ *****************************************************************************************************/
+
+// Set the outputs of the CalcPsychrometrics* functions from the humidity ratio, the vapor pressure,
+// the saturation vapor pressure at the dry-bulb temperature, and the wet-bulb or dew-point temperature
+static void SetPsychrometrics_
+  ( const struct UnitConstants *Units
+  , PsychroReal TDryBulb
+  , PsychroReal HumRatio
+  , PsychroReal Pressure
+  , PsychroReal SatVapPres
+  , PsychroReal *VapPres
+  , PsychroReal *RelHum
+  , PsychroReal *MoistAirEnthalpy
+  , PsychroReal *MoistAirVolume
+  , PsychroReal *DegreeOfSaturation
+  )
+{
+  *VapPres = VapPresFromHumRatio_(HumRatio, Pressure);
+  *RelHum = *VapPres / SatVapPres;
+  *MoistAirEnthalpy = MoistAirEnthalpy_(Units, TDryBulb, HumRatio);
+  *MoistAirVolume = MoistAirVolume_(Units, TDryBulb, HumRatio, Pressure);
+  *DegreeOfSaturation = HumRatio / HumRatioFromVapPres_(SatVapPres, Pressure);
+}
+
+static void SetInvalid_
+  ( PsychroReal *a, PsychroReal *b, PsychroReal *c, PsychroReal *d, PsychroReal *e, PsychroReal *f, PsychroReal *g
+  )
+{
+  *a = *b = *c = *d = *e = *f = *g = INVALID;
+}
+
+// Utility function to calculate humidity ratio, dew-point temperature, relative humidity,
+// vapour pressure, moist air enthalpy, moist air volume, and degree of saturation of air given
+// dry-bulb temperature, wet-bulb temperature, and pressure.
+enum PsychroStatus BoundedCalcPsychrometricsFromTWetBulb // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal TWetBulb        // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *HumRatio       // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroReal *TDewPoint      // (o) Dew point temperature in °F [IP] or °C [SI]
+  , PsychroReal *RelHum         // (o) Relative humidity [0-1]
+  , PsychroReal *VapPres        // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , PsychroReal *MoistAirEnthalpy // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , PsychroReal *MoistAirVolume // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  , PsychroReal *DegreeOfSaturation // (o) Degree of saturation [unitless]
+  )
+{
+  PsychroReal Pws;
+  enum PsychroStatus Status;
+
+  SetInvalid_(HumRatio, TDewPoint, RelHum, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation);
+  Status = BoundedGetSatVapPres(TDryBulb, &Pws);
+  if (Status == PSYCHRO_STATUS_OK)
+    Status = BoundedGetHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure, HumRatio);
+  if (Status == PSYCHRO_STATUS_OK)
+    Status = TDewPointFromVapPres_(GetUnitConstants_(), TDryBulb, VapPresFromHumRatio_(*HumRatio, Pressure), TDewPoint);
+  if (Status != PSYCHRO_STATUS_OK && Status != PSYCHRO_STATUS_NOT_CONVERGED)
+  {
+    SetInvalid_(HumRatio, TDewPoint, RelHum, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation);
+    return Status;
+  }
+
+  SetPsychrometrics_(GetUnitConstants_(), TDryBulb, *HumRatio, Pressure, Pws, VapPres, RelHum, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation);
+  return Status;
+}
+
+// Utility function to calculate humidity ratio, wet-bulb temperature, relative humidity,
+// vapour pressure, moist air enthalpy, moist air volume, and degree of saturation of air given
+// dry-bulb temperature, dew-point temperature, and pressure.
+enum PsychroStatus BoundedCalcPsychrometricsFromTDewPoint // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal TDewPoint       // (i) Dew point temperature in °F [IP] or °C [SI]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *HumRatio       // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroReal *TWetBulb       // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal *RelHum         // (o) Relative humidity [0-1]
+  , PsychroReal *VapPres        // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , PsychroReal *MoistAirEnthalpy // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , PsychroReal *MoistAirVolume // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  , PsychroReal *DegreeOfSaturation // (o) Degree of saturation [unitless]
+  )
+{
+  PsychroReal Pws, Pw;
+  enum PsychroStatus Status;
+
+  SetInvalid_(HumRatio, TWetBulb, RelHum, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation);
+  Status = BoundedGetSatVapPres(TDryBulb, &Pws);
+  if (Status == PSYCHRO_STATUS_OK)
+    Status = BoundedGetSatVapPres(TDewPoint, &Pw);
+  if (Status == PSYCHRO_STATUS_OK && !(TDewPoint <= TDryBulb))
+    Status = PSYCHRO_STATUS_DEW_POINT_ABOVE_DRY_BULB;
+  if (Status == PSYCHRO_STATUS_OK && !(Pressure > 0))
+    Status = PSYCHRO_STATUS_PRESSURE_OUT_OF_RANGE;
+  if (Status == PSYCHRO_STATUS_OK)
+  {
+    *HumRatio = HumRatioFromVapPres_(Pw, Pressure);
+    Status = TWetBulbFromHumRatio_(GetUnitConstants_(), TDryBulb, *HumRatio, Pressure, TWetBulb);
+  }
+  if (Status != PSYCHRO_STATUS_OK && Status != PSYCHRO_STATUS_NOT_CONVERGED)
+  {
+    SetInvalid_(HumRatio, TWetBulb, RelHum, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation);
+    return Status;
+  }
+
+  SetPsychrometrics_(GetUnitConstants_(), TDryBulb, *HumRatio, Pressure, Pws, VapPres, RelHum, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation);
+  return Status;
+}
+
+// Utility function to calculate humidity ratio, wet-bulb temperature, dew-point temperature,
+// vapour pressure, moist air enthalpy, moist air volume, and degree of saturation of air given
+// dry-bulb temperature, relative humidity and pressure.
+enum PsychroStatus BoundedCalcPsychrometricsFromRelHum // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal RelHum          // (i) Relative humidity [0-1]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *HumRatio       // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroReal *TWetBulb       // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal *TDewPoint      // (o) Dew point temperature in °F [IP] or °C [SI]
+  , PsychroReal *VapPres        // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , PsychroReal *MoistAirEnthalpy // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , PsychroReal *MoistAirVolume // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  , PsychroReal *DegreeOfSaturation // (o) Degree of saturation [unitless]
+  )
+{
+  PsychroReal Pws, RH;
+  enum PsychroStatus Status;
+
+  SetInvalid_(HumRatio, TWetBulb, TDewPoint, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation);
+  Status = BoundedGetSatVapPres(TDryBulb, &Pws);
+  if (Status == PSYCHRO_STATUS_OK && !(RelHum >= 0 && RelHum <= 1))
+    Status = PSYCHRO_STATUS_REL_HUM_OUT_OF_RANGE;
+  if (Status == PSYCHRO_STATUS_OK && !(Pressure > 0))
+    Status = PSYCHRO_STATUS_PRESSURE_OUT_OF_RANGE;
+  if (Status != PSYCHRO_STATUS_OK)
+    return Status;
+
+  *HumRatio = HumRatioFromVapPres_(RelHum * Pws, Pressure);
+  Status = TWetBulbFromHumRatio_(GetUnitConstants_(), TDryBulb, *HumRatio, Pressure, TWetBulb);
+  if (Status == PSYCHRO_STATUS_OK || Status == PSYCHRO_STATUS_NOT_CONVERGED)
+  {
+    enum PsychroStatus DewPointStatus = TDewPointFromVapPres_(GetUnitConstants_(), TDryBulb, VapPresFromHumRatio_(*HumRatio, Pressure), TDewPoint);
+    Status = DewPointStatus != PSYCHRO_STATUS_OK ? DewPointStatus : Status;
+  }
+  if (Status != PSYCHRO_STATUS_OK && Status != PSYCHRO_STATUS_NOT_CONVERGED)
+  {
+    SetInvalid_(HumRatio, TWetBulb, TDewPoint, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation);
+    return Status;
+  }
+
+  SetPsychrometrics_(GetUnitConstants_(), TDryBulb, *HumRatio, Pressure, Pws, VapPres, &RH, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation);
+  return Status;
+}
@@ -0,0 +1,148 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Bounded-latency functions with a fixed operation count, returning a status instead of exiting.
+ * See psychrolib_bounded.c for details.
+*/
+
+#ifndef PSYCHROLIB_BOUNDED_H
+#define PSYCHROLIB_BOUNDED_H
+
+// Floating-point type of the functions: float in the single-precision configuration of the
+// freestanding build, double otherwise. See psychrolib_bounded.c.
+#ifdef PSYCHROLIB_SINGLE_PRECISION
+typedef float PsychroReal;
+#else
+typedef double PsychroReal;
+#endif
+
+
+/******************************************************************************************************
+ * Status codes
+ *****************************************************************************************************/
+
+// Same values as the STATUS_* codes of the Fortran module, which has no code for the pressure.
+enum PsychroStatus
+{
+  PSYCHRO_STATUS_OK = 0,                        // Result within the documented accuracy
+  PSYCHRO_STATUS_UNITS_UNDEFINED = 1,           // The system of units has not been defined
+  PSYCHRO_STATUS_TEMPERATURE_OUT_OF_RANGE = 2,  // A temperature is outside the range of validity of the equations
+  PSYCHRO_STATUS_REL_HUM_OUT_OF_RANGE = 3,      // Relative humidity is outside range [0,1]
+  PSYCHRO_STATUS_NEGATIVE_HUM_RATIO = 4,        // Humidity ratio is negative
+  PSYCHRO_STATUS_NEGATIVE_VAP_PRES = 5,         // Partial pressure of water vapor is negative
+  PSYCHRO_STATUS_VAP_PRES_OUT_OF_RANGE = 6,     // Partial pressure of water vapor is outside range of validity of equations
+  PSYCHRO_STATUS_WET_BULB_ABOVE_DRY_BULB = 7,   // Wet bulb temperature is above dry bulb temperature
+  PSYCHRO_STATUS_DEW_POINT_ABOVE_DRY_BULB = 8,  // Dew point temperature is above dry bulb temperature
+  PSYCHRO_STATUS_SPECIFIC_HUM_OUT_OF_RANGE = 9, // Specific humidity is outside range [0, 1)
+  PSYCHRO_STATUS_NOT_CONVERGED = 10,            // The fixed number of iterations did not reach the documented accuracy
+  PSYCHRO_STATUS_PRESSURE_OUT_OF_RANGE = 11     // Atmospheric pressure is not positive
+};
+
+const char *PsychroGetStatusMessage // (o) Description of the status
+  ( enum PsychroStatus Status       // (i) Status code
+  );
+
+
+/******************************************************************************************************
+ * Bounded-latency functions
+ *****************************************************************************************************/
+
+enum PsychroStatus BoundedGetSatVapPres // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal *SatVapPres     // (o) Vapor Pressure of saturated air in Psi [IP] or Pa [SI]
+  );
+
+enum PsychroStatus BoundedGetSatHumRatio // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *SatHumRatio    // (o) Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  );
+
+enum PsychroStatus BoundedGetHumRatioFromRelHum // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal RelHum          // (i) Relative humidity [0-1]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *HumRatio       // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  );
+
+enum PsychroStatus BoundedGetHumRatioFromTWetBulb // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal TWetBulb        // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *HumRatio       // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  );
+
+enum PsychroStatus BoundedGetTDewPointFromVapPres // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal VapPres         // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , PsychroReal *TDewPoint      // (o) Dew point temperature in °F [IP] or °C [SI]
+  );
+
+enum PsychroStatus BoundedGetTDewPointFromRelHum // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal RelHum          // (i) Relative humidity [0-1]
+  , PsychroReal *TDewPoint      // (o) Dew point temperature in °F [IP] or °C [SI]
+  );
+
+enum PsychroStatus BoundedGetTDewPointFromHumRatio // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal HumRatio        // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *TDewPoint      // (o) Dew point temperature in °F [IP] or °C [SI]
+  );
+
+enum PsychroStatus BoundedGetTWetBulbFromHumRatio // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal HumRatio        // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *TWetBulb       // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  );
+
+enum PsychroStatus BoundedGetTWetBulbFromRelHum // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal RelHum          // (i) Relative humidity [0-1]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *TWetBulb       // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  );
+
+enum PsychroStatus BoundedCalcPsychrometricsFromTWetBulb // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal TWetBulb        // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *HumRatio       // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroReal *TDewPoint      // (o) Dew point temperature in °F [IP] or °C [SI]
+  , PsychroReal *RelHum         // (o) Relative humidity [0-1]
+  , PsychroReal *VapPres        // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , PsychroReal *MoistAirEnthalpy // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , PsychroReal *MoistAirVolume // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  , PsychroReal *DegreeOfSaturation // (o) Degree of saturation [unitless]
+  );
+
+enum PsychroStatus BoundedCalcPsychrometricsFromTDewPoint // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal TDewPoint       // (i) Dew point temperature in °F [IP] or °C [SI]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *HumRatio       // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroReal *TWetBulb       // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal *RelHum         // (o) Relative humidity [0-1]
+  , PsychroReal *VapPres        // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , PsychroReal *MoistAirEnthalpy // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , PsychroReal *MoistAirVolume // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  , PsychroReal *DegreeOfSaturation // (o) Degree of saturation [unitless]
+  );
+
+enum PsychroStatus BoundedCalcPsychrometricsFromRelHum // (o) Status
+  ( PsychroReal TDryBulb        // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal RelHum          // (i) Relative humidity [0-1]
+  , PsychroReal Pressure        // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , PsychroReal *HumRatio       // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroReal *TWetBulb       // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  , PsychroReal *TDewPoint      // (o) Dew point temperature in °F [IP] or °C [SI]
+  , PsychroReal *VapPres        // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , PsychroReal *MoistAirEnthalpy // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , PsychroReal *MoistAirVolume // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  , PsychroReal *DegreeOfSaturation // (o) Degree of saturation [unitless]
+  );
+
+#endif // PSYCHROLIB_BOUNDED_H
@@ -0,0 +1,589 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Bounded, thread-safe memoization cache in front of the CalcPsychrometrics* functions.
+ *
+ *  Inputs that repeat, for example readings of sensors with a fixed resolution, are looked up
+ *  in the cache before the psychrometric values are calculated, so that hits skip the iterative
+ *  calculation of the wet-bulb and dew-point temperatures.
+ *
+ *  The inputs are quantized to the resolutions set in the configuration of the cache: the
+ *  values are calculated with the inputs rounded to the nearest multiple of the resolution, so
+ *  that the results do not depend on the order of the calls. With a resolution of 0 the inputs
+ *  are used as they are and only identical inputs share an entry. The system of units in use
+ *  is part of the key. Inputs that are not finite, or more than 2^62 times their resolution, have
+ *  no key: they are calculated as they are, without the cache, and are not counted in the
+ *  statistics.
+ *
+ *  The entries are spread over independently locked shards, each with its own hash table and
+ *  eviction list. The psychrometric values of a miss are calculated without holding the lock.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_cache.h"
+ *  SetUnitSystem(SI);
+ *  // Sensors report temperatures at 0.1 °C and relative humidity at 0.1 %
+ *  struct PsychroCacheConfig Config = { 100000, PSYCHRO_CACHE_LRU, 0.1, 0.001, 1. };
+ *  PsychroCache *Cache = PsychroCacheCreate(&Config);
+ *  CachedCalcPsychrometricsFromRelHum(Cache, 25.0, 0.5, 101325., &HumRatio, &TWetBulb, ...);
+ *  PsychroCacheDestroy(Cache);
+ */
+
+// Standard C header files
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_cache.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define N_VALUES 7                  // Number of psychrometric values stored in each entry.
+
+#define MAX_SHARDS 16               // Maximum number of independently locked shards.
+
+#define MIN_SHARD_CAPACITY 64       // Minimum number of entries of a shard, below which fewer shards are used.
+
+#define NO_ENTRY -1                 // End of a list of entries.
+
+#define MAX_QUANTIZED 0x1p62        // Largest magnitude of a quantized input, in resolutions.
+
+// Functions whose results are cached, part of the key
+enum CachedFunction { FROM_TWETBULB = 1, FROM_TDEWPOINT, FROM_RELHUM };
+
+
+/******************************************************************************************************
+ * Locks
+ *****************************************************************************************************/
+
+#if defined(_WIN32)
+typedef SRWLOCK Lock;
+#define InitLock(lock) (InitializeSRWLock(lock), 1)
+#define DestroyLock(lock)
+#define AcquireLock(lock) AcquireSRWLockExclusive(lock)
+#define ReleaseLock(lock) ReleaseSRWLockExclusive(lock)
+#else
+typedef pthread_mutex_t Lock;
+#define InitLock(lock) (pthread_mutex_init(lock, NULL) == 0)
+#define DestroyLock(lock) pthread_mutex_destroy(lock)
+#define AcquireLock(lock) pthread_mutex_lock(lock)
+#define ReleaseLock(lock) pthread_mutex_unlock(lock)
+#endif
+
+
+/******************************************************************************************************
+ * Cache structure
+ *****************************************************************************************************/
+
+struct Key
+{
+  int64_t Function;             // Cached function and system of units
+  int64_t Inputs[3];            // Quantized inputs, or their bit patterns for exact keys
+};
+
+struct Entry
+{
+  struct Key Key;
+  double Values[N_VALUES];
+  int32_t HashNext;             // Next entry in the same bucket
+  int32_t Newer;                // Next entry towards the most recently used or inserted
+  int32_t Older;                // Next entry towards the least recently used or inserted
+};
+
+struct Shard
+{
+  Lock Lock;
+  struct Entry *Entries;
+  int32_t *Buckets;             // First entry of each bucket of the hash table
+  size_t BucketMask;            // Number of buckets - 1
+  size_t Capacity;
+  size_t Size;
+  int32_t Newest;
+  int32_t Oldest;
+  unsigned long long Hits;
+  unsigned long long Misses;
+  unsigned long long Evictions;
+};
+
+struct PsychroCache
+{
+  enum PsychroCacheEviction Eviction;
+  double Scale[3];              // Inverse of the resolutions of temperatures, humidity and pressure, 0 for exact keys
+  size_t NShards;
+  struct Shard Shards[MAX_SHARDS];
+};
+
+// Index of the scale of each kind of input
+enum Quantity { TEMPERATURE, HUMIDITY, PRESSURE };
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+// Inverse of a resolution, rounded to an integer when it is one to within rounding errors,
+// so that decimal resolutions such as 0.1 reproduce the decimal inputs exactly
+static double GetScale
+  ( double Resolution           // (i) Quantization step, 0 for exact keys
+  )
+{
+  double Scale;
+
+  if (Resolution == 0.)
+    return 0.;
+  Scale = 1. / Resolution;
+  if (fabs(Scale - round(Scale)) < 1e-9 * Scale)
+    Scale = round(Scale);
+  return Scale;
+}
+
+// Quantize an input: the key is the index of the nearest multiple of the resolution and the
+// input is replaced by that multiple. With exact keys the key is the bit pattern of the input.
+// Non-finite inputs, and inputs whose index does not fit in 62 bits, have no key: llround is
+// undefined for them.
+static int Quantize             // (o) 1, or 0 if the input has no key and is unchanged
+  ( double *Value               // (i/o) Input, replaced by its quantized value
+  , double Scale                // (i) Inverse of the resolution, 0 for exact keys
+  , int64_t *Key                // (o) Key of the input
+  )
+{
+  if (!isfinite(*Value))
+    return 0;
+  if (Scale == 0.)
+  {
+    // -0 and +0 share the same entry
+    double Zero = *Value == 0. ? 0. : *Value;
+    memcpy(Key, &Zero, sizeof *Key);
+    return 1;
+  }
+  if (!(fabs(*Value * Scale) <= MAX_QUANTIZED))
+    return 0;
+  *Key = (int64_t) llround(*Value * Scale);
+  *Value = (double) *Key / Scale;
+  return 1;
+}
+
+// Calculate the values of a function
+static void Calculate
+  ( enum CachedFunction Function
+  , double Input1               // (i) Dry bulb temperature
+  , double Input2               // (i) Wet bulb temperature, dew point temperature or relative humidity
+  , double Input3               // (i) Pressure
+  , double *Values              // (o) Psychrometric values, in the order of the outputs of the function
+  )
+{
+  if (Function == FROM_TWETBULB)
+    CalcPsychrometricsFromTWetBulb(Input1, Input2, Input3, &Values[0], &Values[1], &Values[2],
+      &Values[3], &Values[4], &Values[5], &Values[6]);
+  else if (Function == FROM_TDEWPOINT)
+    CalcPsychrometricsFromTDewPoint(Input1, Input2, Input3, &Values[0], &Values[1], &Values[2],
+      &Values[3], &Values[4], &Values[5], &Values[6]);
+  else
+    CalcPsychrometricsFromRelHum(Input1, Input2, Input3, &Values[0], &Values[1], &Values[2],
+      &Values[3], &Values[4], &Values[5], &Values[6]);
+}
+
+// Mix the words of a key (splitmix64 finalizer)
+static uint64_t Hash
+  ( const struct Key *Key       // (i) Key
+  )
+{
+  uint64_t h = (uint64_t) Key->Function;
+  int i;
+
+  for (i = 0; i < 3; i++)
+  {
+    h ^= (uint64_t) Key->Inputs[i] + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+  }
+  return h;
+}
+
+static int SameKey
+  ( const struct Key *a
+  , const struct Key *b
+  )
+{
+  return a->Function == b->Function && a->Inputs[0] == b->Inputs[0]
+    && a->Inputs[1] == b->Inputs[1] && a->Inputs[2] == b->Inputs[2];
+}
+
+// Remove an entry from the eviction list of a shard
+static void Unlink
+  ( struct Shard *Shard
+  , int32_t i
+  )
+{
+  struct Entry *e = &Shard->Entries[i];
+
+  if (e->Newer != NO_ENTRY)
+    Shard->Entries[e->Newer].Older = e->Older;
+  else
+    Shard->Newest = e->Older;
+  if (e->Older != NO_ENTRY)
+    Shard->Entries[e->Older].Newer = e->Newer;
+  else
+    Shard->Oldest = e->Newer;
+}
+
+// Insert an entry at the newest end of the eviction list of a shard
+static void PushNewest
+  ( struct Shard *Shard
+  , int32_t i
+  )
+{
+  struct Entry *e = &Shard->Entries[i];
+
+  e->Newer = NO_ENTRY;
+  e->Older = Shard->Newest;
+  if (Shard->Newest != NO_ENTRY)
+    Shard->Entries[Shard->Newest].Newer = i;
+  else
+    Shard->Oldest = i;
+  Shard->Newest = i;
+}
+
+// Find an entry in the hash table of a shard, NO_ENTRY if not found
+static int32_t Find
+  ( struct Shard *Shard
+  , const struct Key *Key
+  , size_t Bucket
+  )
+{
+  int32_t i;
+
+  for (i = Shard->Buckets[Bucket]; i != NO_ENTRY; i = Shard->Entries[i].HashNext)
+    if (SameKey(&Shard->Entries[i].Key, Key))
+      return i;
+  return NO_ENTRY;
+}
+
+// Remove the oldest entry of a full shard and return its index for reuse
+static int32_t Evict
+  ( struct Shard *Shard
+  )
+{
+  int32_t i = Shard->Oldest;
+  int32_t *Link = &Shard->Buckets[Hash(&Shard->Entries[i].Key) & Shard->BucketMask];
+
+  while (*Link != i)
+    Link = &Shard->Entries[*Link].HashNext;
+  *Link = Shard->Entries[i].HashNext;
+  Unlink(Shard, i);
+  Shard->Size--;
+  Shard->Evictions++;
+  return i;
+}
+
+// Look up the values of a key, calculating and inserting them on a miss
+static void Lookup
+  ( PsychroCache *Cache
+  , enum CachedFunction Function
+  , double Input1               // (i) Dry bulb temperature
+  , double Input2               // (i) Wet bulb temperature, dew point temperature or relative humidity
+  , double Input2Scale          // (i) Scale of the second input
+  , double Input3               // (i) Pressure
+  , double *Values              // (o) Psychrometric values, in the order of the outputs of the function
+  )
+{
+  struct Key Key;
+  struct Shard *Shard;
+  struct Entry *e;
+  uint64_t h;
+  size_t Bucket;
+  int32_t i;
+
+  Key.Function = (int64_t) Function << 8 | (int64_t) GetUnitSystem();
+  // The inputs without a key are calculated as they are, without the cache and the statistics
+  if (!(Quantize(&Input1, Cache->Scale[TEMPERATURE], &Key.Inputs[0])
+    && Quantize(&Input2, Input2Scale, &Key.Inputs[1])
+    && Quantize(&Input3, Cache->Scale[PRESSURE], &Key.Inputs[2])))
+  {
+    Calculate(Function, Input1, Input2, Input3, Values);
+    return;
+  }
+  h = Hash(&Key);
+  Shard = &Cache->Shards[(h >> 32) % Cache->NShards];
+  Bucket = h & Shard->BucketMask;
+
+  AcquireLock(&Shard->Lock);
+  i = Find(Shard, &Key, Bucket);
+  if (i != NO_ENTRY)
+  {
+    Shard->Hits++;
+    memcpy(Values, Shard->Entries[i].Values, sizeof(double) * N_VALUES);
+    if (Cache->Eviction == PSYCHRO_CACHE_LRU && Shard->Newest != i)
+    {
+      Unlink(Shard, i);
+      PushNewest(Shard, i);
+    }
+    ReleaseLock(&Shard->Lock);
+    return;
+  }
+  Shard->Misses++;
+  ReleaseLock(&Shard->Lock);
+
+  // Calculate the values without holding the lock
+  Calculate(Function, Input1, Input2, Input3, Values);
+
+  AcquireLock(&Shard->Lock);
+  // Another thread may have inserted the same key in the meantime
+  if (Find(Shard, &Key, Bucket) == NO_ENTRY)
+  {
+    i = Shard->Size < Shard->Capacity ? (int32_t) Shard->Size : Evict(Shard);
+    e = &Shard->Entries[i];
+    e->Key = Key;
+    memcpy(e->Values, Values, sizeof(double) * N_VALUES);
+    e->HashNext = Shard->Buckets[Bucket];
+    Shard->Buckets[Bucket] = i;
+    PushNewest(Shard, i);
+    Shard->Size++;
+  }
+  ReleaseLock(&Shard->Lock);
+}
+
+// Copy the values of an entry to the outputs of a CalcPsychrometrics* function
+static void CopyValues
+  ( const double *Values
+  , double *Out1, double *Out2, double *Out3, double *Out4, double *Out5, double *Out6, double *Out7
+  )
+{
+  *Out1 = Values[0];
+  *Out2 = Values[1];
+  *Out3 = Values[2];
+  *Out4 = Values[3];
+  *Out5 = Values[4];
+  *Out6 = Values[5];
+  *Out7 = Values[6];
+}
+
+
+/******************************************************************************************************
+ * Cache management
+ *****************************************************************************************************/
+
+// Create a cache.
+// The capacity must be at least 1 and the resolutions must be 0 or positive.
+// Entries are only evicted once the shard they fall in is full, so that the cache may evict
+// entries before it holds Capacity entries in total.
+PsychroCache *PsychroCacheCreate          // (o) New cache, NULL if the configuration is invalid or out of memory
+  ( const struct PsychroCacheConfig *Config // (i) Configuration of the cache
+  )
+{
+  PsychroCache *Cache;
+  size_t s, b, NShards, ShardCapacity;
+
+  if (Config == NULL || Config->Capacity < 1 || Config->Capacity > INT32_MAX
+      || (Config->Eviction != PSYCHRO_CACHE_LRU && Config->Eviction != PSYCHRO_CACHE_FIFO)
+      || !(Config->TemperatureResolution >= 0.) || !(Config->HumidityResolution >= 0.)
+      || !(Config->PressureResolution >= 0.))
+    return NULL;
+
+  Cache = calloc(1, sizeof(PsychroCache));
+  if (Cache == NULL)
+    return NULL;
+  Cache->Eviction = Config->Eviction;
+  Cache->Scale[TEMPERATURE] = GetScale(Config->TemperatureResolution);
+  Cache->Scale[HUMIDITY] = GetScale(Config->HumidityResolution);
+  Cache->Scale[PRESSURE] = GetScale(Config->PressureResolution);
+
+  NShards = 1;
+  while (NShards < MAX_SHARDS && 2 * NShards * MIN_SHARD_CAPACITY <= Config->Capacity)
+    NShards *= 2;
+
+  for (s = 0; s < NShards; s++)
+  {
+    struct Shard *Shard = &Cache->Shards[s];
+
+    ShardCapacity = Config->Capacity / NShards + (s < Config->Capacity % NShards);
+    for (b = 1; b < ShardCapacity; b *= 2)
+      ;
+    Shard->Entries = malloc(ShardCapacity * sizeof(struct Entry));
+    Shard->Buckets = malloc(b * sizeof(int32_t));
+    if (Shard->Entries == NULL || Shard->Buckets == NULL || !InitLock(&Shard->Lock))
+    {
+      free(Shard->Entries);
+      free(Shard->Buckets);
+      Cache->NShards = s;
+      PsychroCacheDestroy(Cache);
+      return NULL;
+    }
+    Shard->Capacity = ShardCapacity;
+    Shard->BucketMask = b - 1;
+    Cache->NShards = s + 1;
+  }
+  PsychroCacheClear(Cache);
+  return Cache;
+}
+
+void PsychroCacheDestroy
+  ( PsychroCache *Cache         // (i) Cache to free, may be NULL
+  )
+{
+  size_t s;
+
+  if (Cache == NULL)
+    return;
+  for (s = 0; s < Cache->NShards; s++)
+  {
+    DestroyLock(&Cache->Shards[s].Lock);
+    free(Cache->Shards[s].Entries);
+    free(Cache->Shards[s].Buckets);
+  }
+  free(Cache);
+}
+
+// Remove all entries, e.g. after the system of units has been changed if memory matters.
+void PsychroCacheClear
+  ( PsychroCache *Cache         // (i) Cache to empty, statistics are kept
+  )
+{
+  size_t s, b;
+
+  for (s = 0; s < Cache->NShards; s++)
+  {
+    struct Shard *Shard = &Cache->Shards[s];
+
+    AcquireLock(&Shard->Lock);
+    for (b = 0; b <= Shard->BucketMask; b++)
+      Shard->Buckets[b] = NO_ENTRY;
+    Shard->Size = 0;
+    Shard->Newest = NO_ENTRY;
+    Shard->Oldest = NO_ENTRY;
+    ReleaseLock(&Shard->Lock);
+  }
+}
+
+void PsychroCacheGetStats
+  ( PsychroCache *Cache              // (i) Cache
+  , struct PsychroCacheStats *Stats  // (o) Statistics since creation or the last reset
+  )
+{
+  size_t s;
+
+  memset(Stats, 0, sizeof(struct PsychroCacheStats));
+  for (s = 0; s < Cache->NShards; s++)
+  {
+    struct Shard *Shard = &Cache->Shards[s];
+
+    AcquireLock(&Shard->Lock);
+    Stats->Hits += Shard->Hits;
+    Stats->Misses += Shard->Misses;
+    Stats->Evictions += Shard->Evictions;
+    Stats->Size += Shard->Size;
+    Stats->Capacity += Shard->Capacity;
+    ReleaseLock(&Shard->Lock);
+  }
+  if (Stats->Hits + Stats->Misses > 0)
+    Stats->HitRate = (double) Stats->Hits / (double) (Stats->Hits + Stats->Misses);
+}
+
+void PsychroCacheResetStats
+  ( PsychroCache *Cache         // (i) Cache
+  )
+{
+  size_t s;
+
+  for (s = 0; s < Cache->NShards; s++)
+  {
+    struct Shard *Shard = &Cache->Shards[s];
+
+    AcquireLock(&Shard->Lock);
+    Shard->Hits = 0;
+    Shard->Misses = 0;
+    Shard->Evictions = 0;
+    ReleaseLock(&Shard->Lock);
+  }
+}
+
+
+/******************************************************************************************************
+ * Cached functions to set all psychrometric values
+ *****************************************************************************************************/
+
+// Cached version of CalcPsychrometricsFromTWetBulb.
+// The wet bulb temperature is quantized with the temperature resolution.
+void CachedCalcPsychrometricsFromTWetBulb
+  ( PsychroCache *Cache         // (i) Cache
+  , double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double TWetBulb             // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double *TDewPoint           // (o) Dew point temperature in °F [IP] or °C [SI]
+  , double *RelHum              // (o) Relative humidity [0-1]
+  , double *VapPres             // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double *MoistAirEnthalpy    // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , double *MoistAirVolume      // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  , double *DegreeOfSaturation  // (o) Degree of saturation [unitless]
+  )
+{
+  double Values[N_VALUES];
+
+  Lookup(Cache, FROM_TWETBULB, TDryBulb, TWetBulb, Cache->Scale[TEMPERATURE], Pressure, Values);
+  CopyValues(Values, HumRatio, TDewPoint, RelHum, VapPres, MoistAirEnthalpy, MoistAirVolume,
+    DegreeOfSaturation);
+}
+
+// Cached version of CalcPsychrometricsFromTDewPoint.
+// The dew point temperature is quantized with the temperature resolution.
+void CachedCalcPsychrometricsFromTDewPoint
+  ( PsychroCache *Cache         // (i) Cache
+  , double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double TDewPoint            // (i) Dew point temperature in °F [IP] or °C [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double *TWetBulb            // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  , double *RelHum              // (o) Relative humidity [0-1]
+  , double *VapPres             // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double *MoistAirEnthalpy    // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , double *MoistAirVolume      // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  , double *DegreeOfSaturation  // (o) Degree of saturation [unitless]
+  )
+{
+  double Values[N_VALUES];
+
+  Lookup(Cache, FROM_TDEWPOINT, TDryBulb, TDewPoint, Cache->Scale[TEMPERATURE], Pressure, Values);
+  CopyValues(Values, HumRatio, TWetBulb, RelHum, VapPres, MoistAirEnthalpy, MoistAirVolume,
+    DegreeOfSaturation);
+}
+
+// Cached version of CalcPsychrometricsFromRelHum.
+// The relative humidity is quantized with the humidity resolution.
+void CachedCalcPsychrometricsFromRelHum
+  ( PsychroCache *Cache         // (i) Cache
+  , double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double RelHum               // (i) Relative humidity [0-1]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double *TWetBulb            // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  , double *TDewPoint           // (o) Dew point temperature in °F [IP] or °C [SI]
+  , double *VapPres             // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double *MoistAirEnthalpy    // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , double *MoistAirVolume      // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  , double *DegreeOfSaturation  // (o) Degree of saturation [unitless]
+  )
+{
+  double Values[N_VALUES];
+
+  Lookup(Cache, FROM_RELHUM, TDryBulb, RelHum, Cache->Scale[HUMIDITY], Pressure, Values);
+  CopyValues(Values, HumRatio, TWetBulb, TDewPoint, VapPres, MoistAirEnthalpy, MoistAirVolume,
+    DegreeOfSaturation);
+}
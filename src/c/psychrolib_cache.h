@@ -0,0 +1,119 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Bounded, thread-safe memoization cache in front of the CalcPsychrometrics* functions.
+ * See psychrolib_cache.c for details.
+*/
+
+#ifndef PSYCHROLIB_CACHE_H
+#define PSYCHROLIB_CACHE_H
+
+#include <stddef.h>
+
+
+/******************************************************************************************************
+ * Cache configuration and statistics
+ *****************************************************************************************************/
+
+typedef struct PsychroCache PsychroCache;
+
+enum PsychroCacheEviction
+{
+  PSYCHRO_CACHE_LRU,            // Evict the least recently used entry
+  PSYCHRO_CACHE_FIFO            // Evict the oldest entry, regardless of its use
+};
+
+struct PsychroCacheConfig
+{
+  size_t Capacity;                      // Maximum number of entries
+  enum PsychroCacheEviction Eviction;   // Eviction policy when the cache is full
+  double TemperatureResolution;         // Quantization step of temperatures in °F [IP] or °C [SI], 0 for exact keys
+  double HumidityResolution;            // Quantization step of relative humidity [0-1], 0 for exact keys
+  double PressureResolution;            // Quantization step of pressure in Psi [IP] or Pa [SI], 0 for exact keys
+};
+
+struct PsychroCacheStats
+{
+  unsigned long long Hits;      // Number of lookups answered from the cache
+  unsigned long long Misses;    // Number of lookups that were calculated
+  unsigned long long Evictions; // Number of entries evicted to make room for new ones
+  size_t Size;                  // Current number of entries
+  size_t Capacity;              // Maximum number of entries
+  double HitRate;               // Hits / (Hits + Misses), 0 if there was no lookup
+};
+
+
+/******************************************************************************************************
+ * Cache management
+ *****************************************************************************************************/
+
+PsychroCache *PsychroCacheCreate          // (o) New cache, NULL if the configuration is invalid or out of memory
+  ( const struct PsychroCacheConfig *Config // (i) Configuration of the cache
+  );
+
+void PsychroCacheDestroy
+  ( PsychroCache *Cache         // (i) Cache to free, may be NULL
+  );
+
+void PsychroCacheClear
+  ( PsychroCache *Cache         // (i) Cache to empty, statistics are kept
+  );
+
+void PsychroCacheGetStats
+  ( PsychroCache *Cache              // (i) Cache
+  , struct PsychroCacheStats *Stats  // (o) Statistics since creation or the last reset
+  );
+
+void PsychroCacheResetStats
+  ( PsychroCache *Cache         // (i) Cache
+  );
+
+
+/******************************************************************************************************
+ * Cached functions to set all psychrometric values
+ *****************************************************************************************************/
+
+void CachedCalcPsychrometricsFromTWetBulb
+  ( PsychroCache *Cache         // (i) Cache
+  , double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double TWetBulb             // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double *TDewPoint           // (o) Dew point temperature in °F [IP] or °C [SI]
+  , double *RelHum              // (o) Relative humidity [0-1]
+  , double *VapPres             // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double *MoistAirEnthalpy    // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , double *MoistAirVolume      // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  , double *DegreeOfSaturation  // (o) Degree of saturation [unitless]
+  );
+
+void CachedCalcPsychrometricsFromTDewPoint
+  ( PsychroCache *Cache         // (i) Cache
+  , double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double TDewPoint            // (i) Dew point temperature in °F [IP] or °C [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double *TWetBulb            // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  , double *RelHum              // (o) Relative humidity [0-1]
+  , double *VapPres             // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double *MoistAirEnthalpy    // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , double *MoistAirVolume      // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  , double *DegreeOfSaturation  // (o) Degree of saturation [unitless]
+  );
+
+void CachedCalcPsychrometricsFromRelHum
+  ( PsychroCache *Cache         // (i) Cache
+  , double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double RelHum               // (i) Relative humidity [0-1]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double *TWetBulb            // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  , double *TDewPoint           // (o) Dew point temperature in °F [IP] or °C [SI]
+  , double *VapPres             // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double *MoistAirEnthalpy    // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , double *MoistAirVolume      // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  , double *DegreeOfSaturation  // (o) Degree of saturation [unitless]
+  );
+
+#endif // PSYCHROLIB_CACHE_H
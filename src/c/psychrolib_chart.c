@@ -0,0 +1,704 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Chart geometry: isolines of a psychrometric chart over a viewport of dry-bulb temperature and
+ *  humidity ratio, sampled adaptively, cached in tiles reused across viewports, and returned as
+ *  compact polyline buffers.
+ *
+ *  The chart has the dry-bulb temperature on the x axis and the humidity ratio on the y axis. Each
+ *  isoline is the humidity ratio as a function of the dry-bulb temperature at a constant relative
+ *  humidity, wet-bulb temperature, enthalpy, specific volume or dew-point temperature, between the
+ *  dry air (humidity ratio of 0) and the saturation curve, below the boiling point of water at the
+ *  pressure of the chart. The range of dry-bulb temperatures of each isoline is found once by
+ *  sampling 512 points over the range of the library and bisecting its ends, so that isolines
+ *  shorter than 1/512 of this range are left out.
+ *
+ *  The x axis is split into tiles of 1/8 of the power of 2 just above the dry-bulb temperature span
+ *  of the viewport, so that panning at a given zoom reuses the tiles already sampled, and zooming
+ *  back to a previous span as well. In each tile an isoline is sampled by bisection of the
+ *  temperature interval: an interval is split while the humidity ratio at its middle differs from
+ *  the chord by more than the tolerance times the power of 2 just above the humidity ratio span of
+ *  the viewport. The points are therefore dense only where the isolines curve at the scale of the
+ *  viewport, e.g. near saturation at high temperatures, while straight isolines (dew point) have
+ *  one segment per tile. The tiles are cached by system of units, pressure, isoline and scale of
+ *  the axes, and the least recently used ones are evicted beyond the size of the cache.
+ *
+ *  Each build joins the tiles of each isoline across the viewport, clips the resulting polyline to
+ *  the viewport and returns the points in single precision, interleaved, with one record per
+ *  polyline: first point, number of points, family and index of the isoline. The geometry is owned
+ *  by the chart and valid until its next build. The tolerance is a fraction of the viewport,
+ *  e.g. 1e-3 for about one pixel of a chart of 1000 pixels.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_chart.h"
+ *  SetUnitSystem(SI);
+ *  PsychroChart *Chart = PsychroChartCreate(0., 0);
+ *  double RelHum[10] = { 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1. };
+ *  struct PsychroChartLines Lines = { { RelHum }, { 10 } };
+ *  struct PsychroChartViewport Viewport = { -10., 50., 0., 0.03 };
+ *  struct PsychroChartGeometry Geometry;
+ *  PsychroChartBuild(Chart, 101325., &Viewport, &Lines, &Geometry);
+ *  // Geometry.Points, Geometry.Polylines; after a pan, most tiles are reused
+ *  Viewport.TDryBulbMin += 5.;
+ *  Viewport.TDryBulbMax += 5.;
+ *  PsychroChartBuild(Chart, 101325., &Viewport, &Lines, &Geometry);
+ *  PsychroChartDestroy(Chart);
+ */
+
+// Standard C header files
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_chart.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define DEFAULT_TOLERANCE 1e-3          // Default maximum distance of the polylines from the isolines, fraction of the viewport.
+
+#define DEFAULT_CACHE_SIZE 4096         // Default maximum number of cached tiles.
+
+#define TILES_PER_SCALE 8               // Number of tiles in the power of 2 above the span of the viewport.
+
+#define MIN_DEPTH 2                     // Minimum number of bisections of a tile.
+
+#define MAX_DEPTH 20                    // Maximum number of bisections of a tile.
+
+#define DOMAIN_SAMPLES 512              // Number of samples of the range of an isoline.
+
+#define EDGE_ITERATIONS 50              // Number of bisections of the ends of the range of an isoline.
+
+#define MAX_HUM_RATIO 1.                // Maximum humidity ratio of the isolines.
+
+#define DOMAIN_TILE INT64_MIN           // Tile of the cache entries of the range of an isoline.
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+// Cache entry: the points of an isoline in a tile, or the range of an isoline
+struct Entry_
+{
+  int Units;
+  int Family;
+  int LevelT;                           // Power of 2 above the spans of the viewport
+  int LevelW;
+  double Pressure;
+  double Value;
+  int64_t Tile;                         // Index of the tile, DOMAIN_TILE for the range of the isoline
+  double *Points;                       // Dry-bulb temperature and humidity ratio of each point, interleaved
+  size_t NPoints;
+  double Lo, Hi;                        // Range of the isoline, empty if Lo > Hi
+  int32_t HashNext;                     // Next entry of the hash bucket
+  int32_t Older, Newer;                 // Neighbours in the order of use
+};
+
+struct PsychroChart
+{
+  double Tolerance;
+  size_t CacheSize;
+  struct Entry_ *Entries;
+  size_t NEntries;
+  int32_t *Buckets;
+  size_t Mask;
+  int32_t Newest, Oldest;               // Ends of the list of entries in the order of use
+  double *Line;                         // Points of an isoline across the tiles of the viewport
+  size_t LineSize, LineCapacity;
+  double *Tile;                         // Points of the tile being sampled
+  size_t TileSize, TileCapacity;
+  float *Points;
+  size_t NPoints, PointCapacity;
+  struct PsychroChartPolyline *Polylines;
+  size_t NPolylines, PolylineCapacity;
+  size_t Evaluations;
+  int BoilingUnits;                     // Boiling point of the last pressure
+  double BoilingPressure, TBoiling;
+};
+
+// Grow a buffer to hold at least Count items
+static int Reserve_
+  ( void **Buffer
+  , size_t *Capacity
+  , size_t Count
+  , size_t ItemSize
+  )
+{
+  size_t NewCapacity = *Capacity > 0 ? *Capacity : 256;
+  void *Grown;
+
+  if (Count <= *Capacity)
+    return 0;
+  while (NewCapacity < Count)
+    NewCapacity *= 2;
+  Grown = realloc(*Buffer, NewCapacity * ItemSize);
+  if (Grown == NULL)
+    return -1;
+  *Buffer = Grown;
+  *Capacity = NewCapacity;
+  return 0;
+}
+
+static int AppendTile_
+  ( PsychroChart *Chart
+  , double TDryBulb
+  , double HumRatio
+  )
+{
+  if (Reserve_((void **) &Chart->Tile, &Chart->TileCapacity, 2 * Chart->TileSize + 2, sizeof(double)) != 0)
+    return -1;
+  Chart->Tile[2 * Chart->TileSize] = TDryBulb;
+  Chart->Tile[2 * Chart->TileSize + 1] = HumRatio;
+  Chart->TileSize++;
+  return 0;
+}
+
+static uint64_t Hash_
+  ( const struct Entry_ *Key
+  )
+{
+  uint64_t h, Bits[2];
+
+  memcpy(&Bits[0], &Key->Pressure, sizeof(double));
+  memcpy(&Bits[1], &Key->Value, sizeof(double));
+  h = Bits[0] ^ (Bits[1] * 0x9E3779B97F4A7C15ULL) ^ ((uint64_t) Key->Tile * 0xBF58476D1CE4E5B9ULL)
+    ^ ((uint64_t) (Key->Units + 4 * Key->Family) << 48) ^ ((uint64_t) (uint32_t) Key->LevelT << 32) ^ (uint32_t) Key->LevelW;
+  h ^= h >> 31;
+  h *= 0x94D049BB133111EBULL;
+  return h ^ (h >> 29);
+}
+
+static int Equal_
+  ( const struct Entry_ *a
+  , const struct Entry_ *b
+  )
+{
+  return a->Units == b->Units && a->Family == b->Family && a->LevelT == b->LevelT && a->LevelW == b->LevelW
+    && a->Pressure == b->Pressure && a->Value == b->Value && a->Tile == b->Tile;
+}
+
+// Move an entry to the newest end of the order of use
+static void Unlink_
+  ( PsychroChart *Chart
+  , int32_t i
+  )
+{
+  struct Entry_ *e = &Chart->Entries[i];
+
+  if (e->Older >= 0)
+    Chart->Entries[e->Older].Newer = e->Newer;
+  else
+    Chart->Oldest = e->Newer;
+  if (e->Newer >= 0)
+    Chart->Entries[e->Newer].Older = e->Older;
+  else
+    Chart->Newest = e->Older;
+}
+
+static void Touch_
+  ( PsychroChart *Chart
+  , int32_t i
+  )
+{
+  struct Entry_ *e = &Chart->Entries[i];
+
+  Unlink_(Chart, i);
+  e->Older = Chart->Newest;
+  e->Newer = -1;
+  if (Chart->Newest >= 0)
+    Chart->Entries[Chart->Newest].Newer = i;
+  Chart->Newest = i;
+  if (Chart->Oldest < 0)
+    Chart->Oldest = i;
+}
+
+// Cached entry of a key, or -1
+static int32_t Find_
+  ( PsychroChart *Chart
+  , const struct Entry_ *Key
+  )
+{
+  int32_t i;
+
+  for (i = Chart->Buckets[Hash_(Key) & Chart->Mask]; i >= 0; i = Chart->Entries[i].HashNext)
+    if (Equal_(&Chart->Entries[i], Key))
+    {
+      Touch_(Chart, i);
+      return i;
+    }
+  return -1;
+}
+
+// New entry of a key, replacing the least recently used one if the cache is full
+static int32_t Insert_
+  ( PsychroChart *Chart
+  , const struct Entry_ *Key
+  )
+{
+  int32_t i, *Link;
+  struct Entry_ *e;
+
+  if (Chart->NEntries < Chart->CacheSize)
+  {
+    i = (int32_t) Chart->NEntries++;
+    Chart->Entries[i].Older = Chart->Entries[i].Newer = -1;
+    if (Chart->Newest < 0)
+      Chart->Newest = Chart->Oldest = i;
+    else
+    {
+      Chart->Entries[i].Older = Chart->Newest;
+      Chart->Entries[Chart->Newest].Newer = i;
+      Chart->Newest = i;
+    }
+  }
+  else
+  {
+    i = Chart->Oldest;
+    for (Link = &Chart->Buckets[Hash_(&Chart->Entries[i]) & Chart->Mask]; *Link != i; Link = &Chart->Entries[*Link].HashNext)
+      ;
+    *Link = Chart->Entries[i].HashNext;
+    free(Chart->Entries[i].Points);
+    Touch_(Chart, i);
+  }
+  e = &Chart->Entries[i];
+  e->Units = Key->Units;
+  e->Family = Key->Family;
+  e->LevelT = Key->LevelT;
+  e->LevelW = Key->LevelW;
+  e->Pressure = Key->Pressure;
+  e->Value = Key->Value;
+  e->Tile = Key->Tile;
+  e->Points = NULL;
+  e->NPoints = 0;
+  e->Lo = 1.;
+  e->Hi = 0.;
+  e->HashNext = Chart->Buckets[Hash_(Key) & Chart->Mask];
+  Chart->Buckets[Hash_(Key) & Chart->Mask] = i;
+  return i;
+}
+
+// Humidity ratio of an isoline at a dry-bulb temperature within its range
+static double HumRatio_
+  ( PsychroChart *Chart
+  , int Family
+  , double Value
+  , double TDryBulb
+  , double Pressure
+  )
+{
+  double Volume0;
+
+  Chart->Evaluations++;
+  switch (Family)
+  {
+  case PSYCHRO_CHART_REL_HUM:
+    return GetHumRatioFromRelHum(TDryBulb, Value, Pressure);
+  case PSYCHRO_CHART_TWET_BULB:
+    return GetHumRatioFromTWetBulb(TDryBulb, Value, Pressure);
+  case PSYCHRO_CHART_MOIST_AIR_ENTHALPY:
+    return GetHumRatioFromEnthalpyAndTDryBulb(Value, TDryBulb);
+  case PSYCHRO_CHART_MOIST_AIR_VOLUME:
+    // The specific volume is linear in the humidity ratio
+    Volume0 = GetMoistAirVolume(TDryBulb, 0., Pressure);
+    return (Value - Volume0) / (GetMoistAirVolume(TDryBulb, 1., Pressure) - Volume0);
+  default:
+    return GetHumRatioFromTDewPoint(Value, Pressure);
+  }
+}
+
+// Whether an isoline is on the chart at a dry-bulb temperature below the boiling point
+static int Inside_
+  ( PsychroChart *Chart
+  , int Family
+  , double Value
+  , double TDryBulb
+  , double Pressure
+  )
+{
+  double HumRatio;
+
+  if ((Family == PSYCHRO_CHART_TWET_BULB || Family == PSYCHRO_CHART_TDEW_POINT) && TDryBulb < Value)
+    return 0;
+  HumRatio = HumRatio_(Chart, Family, Value, TDryBulb, Pressure);
+  return HumRatio > 2. * MIN_HUM_RATIO && HumRatio <= MAX_HUM_RATIO
+    && HumRatio <= GetSatHumRatio(TDryBulb, Pressure) * (1. + 1e-9);
+}
+
+// Boiling point of water at a pressure, within the range of the library
+static double TBoiling_
+  ( PsychroChart *Chart
+  , double Pressure
+  , double TMin
+  , double TMax
+  )
+{
+  double Lo = TMin, Hi = TMax, T;
+  int k;
+
+  if (Chart->BoilingUnits == (int) GetUnitSystem() && Chart->BoilingPressure == Pressure)
+    return Chart->TBoiling;
+  if (GetSatVapPres(TMax) < Pressure)
+    Lo = TMax;
+  else if (GetSatVapPres(TMin) >= Pressure)
+    Lo = TMin;
+  else
+    for (k = 0; k < 60; k++)
+    {
+      T = 0.5 * (Lo + Hi);
+      if (GetSatVapPres(T) < Pressure)
+        Lo = T;
+      else
+        Hi = T;
+    }
+  Chart->BoilingUnits = (int) GetUnitSystem();
+  Chart->BoilingPressure = Pressure;
+  Chart->TBoiling = Lo;
+  return Lo;
+}
+
+// Range of dry-bulb temperatures of an isoline on the chart, empty if Lo > Hi
+static void Domain_
+  ( PsychroChart *Chart
+  , const struct Entry_ *Key
+  , double *Lo
+  , double *Hi
+  )
+{
+  double TMin = isIP() ? -148. : -100., TMax = isIP() ? 392. : 200., Pressure = Key->Pressure, In, Out, T;
+  long First = -1, Last = -1, i;
+  int k;
+
+  *Lo = 1.;
+  *Hi = 0.;
+  TMax = TBoiling_(Chart, Pressure, TMin, TMax);
+  if (TMax <= TMin || ((Key->Family == PSYCHRO_CHART_TWET_BULB || Key->Family == PSYCHRO_CHART_TDEW_POINT)
+    && !(Key->Value >= TMin && Key->Value < TMax)))
+    return;
+
+  for (i = 0; i <= DOMAIN_SAMPLES; i++)
+    if (Inside_(Chart, Key->Family, Key->Value, TMin + (TMax - TMin) * i / DOMAIN_SAMPLES, Pressure))
+    {
+      if (First < 0)
+        First = i;
+      Last = i;
+    }
+  if (First < 0)
+    return;
+
+  // Ends bisected between the last sample outside and the first sample inside, kept inside
+  *Lo = TMin + (TMax - TMin) * First / DOMAIN_SAMPLES;
+  if (First > 0)
+  {
+    In = *Lo;
+    Out = TMin + (TMax - TMin) * (First - 1) / DOMAIN_SAMPLES;
+    if (Key->Family == PSYCHRO_CHART_TWET_BULB || Key->Family == PSYCHRO_CHART_TDEW_POINT)
+      Out = fmax(Out, Key->Value);
+    for (k = 0; k < EDGE_ITERATIONS; k++)
+    {
+      T = 0.5 * (In + Out);
+      if (Inside_(Chart, Key->Family, Key->Value, T, Pressure))
+        In = T;
+      else
+        Out = T;
+    }
+    *Lo = In;
+  }
+  *Hi = TMin + (TMax - TMin) * Last / DOMAIN_SAMPLES;
+  if (Last < DOMAIN_SAMPLES)
+  {
+    In = *Hi;
+    Out = TMin + (TMax - TMin) * (Last + 1) / DOMAIN_SAMPLES;
+    for (k = 0; k < EDGE_ITERATIONS; k++)
+    {
+      T = 0.5 * (In + Out);
+      if (Inside_(Chart, Key->Family, Key->Value, T, Pressure))
+        In = T;
+      else
+        Out = T;
+    }
+    *Hi = In;
+  }
+}
+
+// Points of the interval after its start, bisected while the middle is off the chord
+static int Sample_
+  ( PsychroChart *Chart
+  , const struct Entry_ *Key
+  , double T0
+  , double W0
+  , double T1
+  , double W1
+  , double Tolerance                    // Maximum distance from the chord in humidity ratio
+  , int Depth
+  )
+{
+  double Tm = 0.5 * (T0 + T1), Wm = HumRatio_(Chart, Key->Family, Key->Value, Tm, Key->Pressure);
+
+  if (Depth < MIN_DEPTH || (Depth < MAX_DEPTH && fabs(Wm - 0.5 * (W0 + W1)) > Tolerance))
+    return Sample_(Chart, Key, T0, W0, Tm, Wm, Tolerance, Depth + 1) != 0
+      || Sample_(Chart, Key, Tm, Wm, T1, W1, Tolerance, Depth + 1) != 0 ? -1 : 0;
+  return AppendTile_(Chart, T1, W1);
+}
+
+// Cached entry of the range or of a tile of an isoline, computed if missing
+static int32_t Get_
+  ( PsychroChart *Chart
+  , const struct Entry_ *Key
+  , size_t *Reused
+  , size_t *Computed
+  )
+{
+  struct Entry_ RangeKey = *Key;
+  double Width, Start, End, W0;
+  int32_t i, Range;
+
+  i = Find_(Chart, Key);
+  if (i >= 0)
+  {
+    if (Key->Tile != DOMAIN_TILE)
+      (*Reused)++;
+    return i;
+  }
+
+  if (Key->Tile == DOMAIN_TILE)
+  {
+    i = Insert_(Chart, Key);
+    Domain_(Chart, Key, &Chart->Entries[i].Lo, &Chart->Entries[i].Hi);
+    return i;
+  }
+
+  // Tile within the range of the isoline
+  RangeKey.LevelT = RangeKey.LevelW = 0;
+  RangeKey.Tile = DOMAIN_TILE;
+  Range = Get_(Chart, &RangeKey, Reused, Computed);
+  Width = ldexp(1., Key->LevelT) / TILES_PER_SCALE;
+  Start = fmax(Key->Tile * Width, Chart->Entries[Range].Lo);
+  End = fmin((Key->Tile + 1) * Width, Chart->Entries[Range].Hi);
+  Chart->TileSize = 0;
+  if (Start < End)
+  {
+    W0 = HumRatio_(Chart, Key->Family, Key->Value, Start, Key->Pressure);
+    if (AppendTile_(Chart, Start, W0) != 0 || Sample_(Chart, Key, Start, W0, End,
+      HumRatio_(Chart, Key->Family, Key->Value, End, Key->Pressure), Chart->Tolerance * ldexp(1., Key->LevelW), 0) != 0)
+      return -1;
+  }
+  i = Insert_(Chart, Key);
+  if (Chart->TileSize > 0)
+  {
+    Chart->Entries[i].Points = malloc(2 * Chart->TileSize * sizeof(double));
+    if (Chart->Entries[i].Points == NULL)
+      return -1;
+    memcpy(Chart->Entries[i].Points, Chart->Tile, 2 * Chart->TileSize * sizeof(double));
+    Chart->Entries[i].NPoints = Chart->TileSize;
+  }
+  (*Computed)++;
+  return i;
+}
+
+// Clip the points of an isoline to the viewport and add them to the geometry
+static int Emit_
+  ( PsychroChart *Chart
+  , const struct PsychroChartViewport *Viewport
+  , int Family
+  , size_t Line
+  )
+{
+  const double *p = Chart->Line;
+  double Lo[2] = { Viewport->TDryBulbMin, Viewport->HumRatioMin }, Hi[2] = { Viewport->TDryBulbMax, Viewport->HumRatioMax };
+  double t0, t1, d, q;
+  struct PsychroChartPolyline *Polyline = NULL;
+  size_t i;
+  int Axis, Open = 0, Reject;
+
+  for (i = 0; i + 1 < Chart->LineSize; i++, p += 2)
+  {
+    // Liang-Barsky clipping of the segment
+    t0 = 0.;
+    t1 = 1.;
+    Reject = 0;
+    for (Axis = 0; Axis < 2 && !Reject; Axis++)
+    {
+      d = p[2 + Axis] - p[Axis];
+      if (d == 0.)
+        Reject = p[Axis] < Lo[Axis] || p[Axis] > Hi[Axis];
+      else
+      {
+        q = ((d > 0. ? Lo[Axis] : Hi[Axis]) - p[Axis]) / d;
+        t0 = fmax(t0, q);
+        q = ((d > 0. ? Hi[Axis] : Lo[Axis]) - p[Axis]) / d;
+        t1 = fmin(t1, q);
+        Reject = t0 > t1;
+      }
+    }
+    if (Reject)
+    {
+      Open = 0;
+      continue;
+    }
+
+    if (Reserve_((void **) &Chart->Points, &Chart->PointCapacity, 2 * Chart->NPoints + 4, sizeof(float)) != 0
+      || Reserve_((void **) &Chart->Polylines, &Chart->PolylineCapacity, Chart->NPolylines + 1, sizeof(struct PsychroChartPolyline)) != 0)
+      return -1;
+    if (!Open || t0 > 0.)
+    {
+      Polyline = &Chart->Polylines[Chart->NPolylines++];
+      Polyline->First = (uint32_t) Chart->NPoints;
+      Polyline->Count = 1;
+      Polyline->Family = (uint32_t) Family;
+      Polyline->Line = (uint32_t) Line;
+      Chart->Points[2 * Chart->NPoints] = (float) (p[0] + t0 * (p[2] - p[0]));
+      Chart->Points[2 * Chart->NPoints + 1] = (float) (p[1] + t0 * (p[3] - p[1]));
+      Chart->NPoints++;
+    }
+    else
+      Polyline = &Chart->Polylines[Chart->NPolylines - 1];
+    Chart->Points[2 * Chart->NPoints] = (float) (t1 < 1. ? p[0] + t1 * (p[2] - p[0]) : p[2]);
+    Chart->Points[2 * Chart->NPoints + 1] = (float) (t1 < 1. ? p[1] + t1 * (p[3] - p[1]) : p[3]);
+    Chart->NPoints++;
+    Polyline->Count++;
+    Open = t1 == 1.;
+  }
+  return 0;
+}
+
+
+/******************************************************************************************************
+ * Charts
+ *****************************************************************************************************/
+
+PsychroChart *PsychroChartCreate        // (o) New chart with an empty cache, NULL if out of memory
+  ( double Tolerance                    // (i) Maximum distance of the polylines from the isolines, as a fraction of the viewport, 0 for 1e-3
+  , size_t CacheSize                    // (i) Maximum number of tiles of isolines cached, 0 for 4096
+  )
+{
+  PsychroChart *Chart;
+  size_t Buckets = 1, i;
+
+  if (!(Tolerance >= 0. && Tolerance < 1.) || CacheSize > INT32_MAX / 4)
+    return NULL;
+  Chart = calloc(1, sizeof(PsychroChart));
+  if (Chart == NULL)
+    return NULL;
+  Chart->Tolerance = Tolerance > 0. ? Tolerance : DEFAULT_TOLERANCE;
+  Chart->CacheSize = CacheSize > 0 ? CacheSize : DEFAULT_CACHE_SIZE;
+  while (Buckets < 2 * Chart->CacheSize)
+    Buckets *= 2;
+  Chart->Mask = Buckets - 1;
+  Chart->Entries = malloc(Chart->CacheSize * sizeof(struct Entry_));
+  Chart->Buckets = malloc(Buckets * sizeof(int32_t));
+  if (Chart->Entries == NULL || Chart->Buckets == NULL)
+  {
+    PsychroChartDestroy(Chart);
+    return NULL;
+  }
+  for (i = 0; i < Buckets; i++)
+    Chart->Buckets[i] = -1;
+  Chart->Newest = Chart->Oldest = -1;
+  Chart->BoilingUnits = UNDEFINED;
+  return Chart;
+}
+
+void PsychroChartDestroy
+  ( PsychroChart *Chart                 // (i) Chart to free, may be NULL
+  )
+{
+  size_t i;
+
+  if (Chart == NULL)
+    return;
+  for (i = 0; i < Chart->NEntries; i++)
+    free(Chart->Entries[i].Points);
+  free(Chart->Entries);
+  free(Chart->Buckets);
+  free(Chart->Line);
+  free(Chart->Tile);
+  free(Chart->Points);
+  free(Chart->Polylines);
+  free(Chart);
+}
+
+int PsychroChartBuild                   // (o) 0 on success, -1 if an input is invalid or out of memory
+  ( PsychroChart *Chart                 // (i) Chart
+  , double Pressure                     // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , const struct PsychroChartViewport *Viewport // (i) Ranges of the axes
+  , const struct PsychroChartLines *Lines // (i) Isolines
+  , struct PsychroChartGeometry *Geometry // (o) Polylines of the isolines clipped to the viewport and below saturation
+  )
+{
+  struct Entry_ Key;
+  const struct Entry_ *e;
+  double Width;
+  int64_t FirstTile, LastTile;
+  size_t Reused = 0, Computed = 0, Line, k;
+  int32_t i;
+  int Family;
+
+  memset(Geometry, 0, sizeof *Geometry);
+  Chart->NPoints = Chart->NPolylines = 0;
+  Chart->Evaluations = 0;
+  if (!(Pressure > 0.) || !isfinite(Pressure) || !(Viewport->TDryBulbMin < Viewport->TDryBulbMax)
+    || !(Viewport->HumRatioMin < Viewport->HumRatioMax) || !isfinite(Viewport->TDryBulbMax - Viewport->TDryBulbMin)
+    || !isfinite(Viewport->HumRatioMax - Viewport->HumRatioMin) || Chart->CacheSize < 2)
+    return -1;
+  for (Family = 0; Family < PSYCHRO_CHART_N_FAMILIES; Family++)
+    for (Line = 0; Line < Lines->Counts[Family]; Line++)
+      if (!isfinite(Lines->Values[Family][Line])
+        || (Family == PSYCHRO_CHART_REL_HUM && !(Lines->Values[Family][Line] > 0. && Lines->Values[Family][Line] <= 1.)))
+        return -1;
+
+  // Scales of the axes and tiles of the viewport
+  memset(&Key, 0, sizeof Key);
+  Key.Units = (int) GetUnitSystem();
+  Key.Pressure = Pressure;
+  frexp(Viewport->TDryBulbMax - Viewport->TDryBulbMin, &Key.LevelT);
+  frexp(Viewport->HumRatioMax - Viewport->HumRatioMin, &Key.LevelW);
+  Width = ldexp(1., Key.LevelT) / TILES_PER_SCALE;
+  FirstTile = (int64_t) floor(Viewport->TDryBulbMin / Width);
+  LastTile = (int64_t) floor(Viewport->TDryBulbMax / Width);
+
+  for (Family = 0; Family < PSYCHRO_CHART_N_FAMILIES; Family++)
+    for (Line = 0; Line < Lines->Counts[Family]; Line++)
+    {
+      Key.Family = Family;
+      Key.Value = Lines->Values[Family][Line];
+
+      // Tiles joined into the points of the isoline across the viewport
+      Chart->LineSize = 0;
+      for (Key.Tile = FirstTile; Key.Tile <= LastTile; Key.Tile++)
+      {
+        i = Get_(Chart, &Key, &Reused, &Computed);
+        if (i < 0)
+          return -1;
+        e = &Chart->Entries[i];
+        if (e->NPoints == 0)
+          continue;
+        if (Reserve_((void **) &Chart->Line, &Chart->LineCapacity, 2 * (Chart->LineSize + e->NPoints), sizeof(double)) != 0)
+          return -1;
+        // Tiles share their boundary points
+        k = Chart->LineSize > 0 && Chart->Line[2 * Chart->LineSize - 2] == e->Points[0] ? 1 : 0;
+        memcpy(Chart->Line + 2 * Chart->LineSize, e->Points + 2 * k, 2 * (e->NPoints - k) * sizeof(double));
+        Chart->LineSize += e->NPoints - k;
+      }
+      if (Emit_(Chart, Viewport, Family, Line) != 0)
+        return -1;
+    }
+
+  Geometry->Points = Chart->Points;
+  Geometry->NPoints = Chart->NPoints;
+  Geometry->Polylines = Chart->Polylines;
+  Geometry->NPolylines = Chart->NPolylines;
+  Geometry->TilesReused = Reused;
+  Geometry->TilesComputed = Computed;
+  Geometry->Evaluations = Chart->Evaluations;
+  return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Chart geometry: isolines of a psychrometric chart over a viewport of dry-bulb temperature and
+ * humidity ratio, sampled adaptively, cached in tiles reused across viewports, and returned as
+ * compact polyline buffers.
+ * See psychrolib_chart.c for details.
+*/
+
+#ifndef PSYCHROLIB_CHART_H
+#define PSYCHROLIB_CHART_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/******************************************************************************************************
+ * Isolines and geometry
+ *****************************************************************************************************/
+
+typedef struct PsychroChart PsychroChart;
+
+// Families of isolines, by the property constant along them
+enum PsychroChartFamily
+{
+  PSYCHRO_CHART_REL_HUM,                // Relative humidity [0-1], 1 for the saturation curve
+  PSYCHRO_CHART_TWET_BULB,              // Wet bulb temperature in °F [IP] or °C [SI]
+  PSYCHRO_CHART_MOIST_AIR_ENTHALPY,     // Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  PSYCHRO_CHART_MOIST_AIR_VOLUME,       // Specific volume of moist air in ft³ lb⁻¹ of dry air [IP] or in m³ kg⁻¹ of dry air [SI]
+  PSYCHRO_CHART_TDEW_POINT,             // Dew point temperature in °F [IP] or °C [SI]
+  PSYCHRO_CHART_N_FAMILIES
+};
+
+// Values of the isolines of each family
+struct PsychroChartLines
+{
+  const double *Values[PSYCHRO_CHART_N_FAMILIES]; // Values of the isolines, may be NULL if there are none
+  size_t Counts[PSYCHRO_CHART_N_FAMILIES]; // Number of isolines
+};
+
+struct PsychroChartViewport
+{
+  double TDryBulbMin;                   // Dry bulb temperature range of the x axis in °F [IP] or °C [SI]
+  double TDryBulbMax;
+  double HumRatioMin;                   // Humidity ratio range of the y axis in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  double HumRatioMax;
+};
+
+// Polyline of an isoline within the viewport; an isoline that leaves and reenters it has several
+struct PsychroChartPolyline
+{
+  uint32_t First;                       // Index of the first point
+  uint32_t Count;                       // Number of points
+  uint32_t Family;                      // Family of the isoline, enum PsychroChartFamily
+  uint32_t Line;                        // Index of the isoline in its family
+};
+
+// Geometry of a viewport, owned by the chart and valid until its next build
+struct PsychroChartGeometry
+{
+  const float *Points;                  // Dry bulb temperature and humidity ratio of each point, interleaved
+  size_t NPoints;                       // Number of points
+  const struct PsychroChartPolyline *Polylines;
+  size_t NPolylines;                    // Number of polylines
+  size_t TilesReused;                   // Number of tiles of isolines found in the cache
+  size_t TilesComputed;                 // Number of tiles of isolines sampled
+  size_t Evaluations;                   // Number of evaluations of the isolines
+};
+
+
+/******************************************************************************************************
+ * Charts
+ *****************************************************************************************************/
+
+PsychroChart *PsychroChartCreate        // (o) New chart with an empty cache, NULL if out of memory
+  ( double Tolerance                    // (i) Maximum distance of the polylines from the isolines, as a fraction of the viewport, 0 for 1e-3
+  , size_t CacheSize                    // (i) Maximum number of tiles of isolines cached, 0 for 4096
+  );
+
+void PsychroChartDestroy
+  ( PsychroChart *Chart                 // (i) Chart to free, may be NULL
+  );
+
+int PsychroChartBuild                   // (o) 0 on success, -1 if an input is invalid or out of memory
+  ( PsychroChart *Chart                 // (i) Chart
+  , double Pressure                     // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , const struct PsychroChartViewport *Viewport // (i) Ranges of the axes
+  , const struct PsychroChartLines *Lines // (i) Isolines
+  , struct PsychroChartGeometry *Geometry // (o) Polylines of the isolines clipped to the viewport and below saturation
+  );
+
+#endif // PSYCHROLIB_CHART_H
@@ -0,0 +1,457 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Climate statistics: streaming quantile sketches and bin-hour histograms of moist air properties
+ *  over weather records, in bounded memory and mergeable across shards.
+ *
+ *  Design conditions are percentiles of the dry-bulb, wet-bulb and dew-point temperatures and of
+ *  the enthalpy over years of hourly records, e.g. the dry-bulb temperature exceeded 0.4% of the
+ *  hours (the 0.996 quantile) or not exceeded 0.4% of the hours (the 0.004 quantile). Rather than
+ *  storing and sorting the properties of all records, the statistics read each record once: the
+ *  properties are calculated from the dry-bulb and dew-point temperatures and the pressure with
+ *  CalcPsychrometricsFromTDewPoint, and counted in a quantile sketch for each variable and in a
+ *  histogram of dry-bulb temperature and humidity ratio, whose counts are the bin hours of hourly
+ *  records.
+ *
+ *  The quantile sketches are histograms with fine uniform bins over the range of each variable,
+ *  and the exact minimum and maximum. A quantile is interpolated linearly in the bin that holds
+ *  it, so that its error is at most the width of the bins whatever the number of records: with the
+ *  default configuration, 0.01 °C (0.018 °F) for the temperatures. The memory depends on the bins
+ *  only, about 600 KB with the default configuration. Records outside the bins are counted below
+ *  or above them: the quantiles that fall there are not known and are returned as NaN.
+ *
+ *  Because the statistics are counts, merging the statistics of shards of records (e.g. one per
+ *  station, year or process) gives exactly the statistics of all the records, in any order. The
+ *  records of a call can also be split between threads, each counting its share in statistics of
+ *  its own that are merged at the end, with the same results as in the calling thread.
+ *
+ *  Weather files have missing or inconsistent records. A record is invalid, skipped and counted,
+ *  if a temperature is NaN or outside the range of the generic functions, if the dew point is
+ *  above the dry-bulb temperature, or if the saturation vapor pressure at the dew point is not
+ *  below the pressure. The system of units must not be changed while statistics are in use.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_climate.h"
+ *  SetUnitSystem(SI);
+ *  struct PsychroClimateConfig Config;
+ *  PsychroClimateGetDefaultConfig(&Config);
+ *  PsychroClimate *Stats = PsychroClimateCreate(&Config);
+ *  PsychroClimateAdd(Stats, Count, TDryBulb, TDewPoint, Pressure, 4);
+ *  double CoolingTDryBulb = PsychroClimateGetQuantile(Stats, PSYCHRO_CLIMATE_TDRY_BULB, 0.996);
+ *  double HeatingTDryBulb = PsychroClimateGetQuantile(Stats, PSYCHRO_CLIMATE_TDRY_BULB, 0.004);
+ *  const uint64_t *BinHours = PsychroClimateGetHistogram(Stats, NULL);
+ *  PsychroClimateDestroy(Stats);
+ */
+
+// Standard C header files
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_climate.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define MAX_THREADS 64              // Maximum number of threads of a call.
+
+#define MIN_RECORDS_PER_THREAD 4096 // Minimum number of records counted by a thread.
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+struct PsychroClimate
+{
+  struct PsychroClimateConfig Config;
+  uint64_t Count;
+  uint64_t Invalid;
+  // Records below the bins, in each bin, and above the bins of each variable
+  uint64_t *Bins[PSYCHRO_CLIMATE_N_VARIABLES];
+  double InvWidth[PSYCHRO_CLIMATE_N_VARIABLES];
+  double Minimum[PSYCHRO_CLIMATE_N_VARIABLES];
+  double Maximum[PSYCHRO_CLIMATE_N_VARIABLES];
+  uint64_t *Histogram;
+  uint64_t OutOfRange;
+  double HistogramInvWidth[2];
+};
+
+// Records of a call counted by a thread
+struct Worker
+{
+  PsychroClimate *Stats;        // NULL if the statistics of the thread cannot be created
+  size_t Count;
+  const double *TDryBulb;
+  const double *TDewPoint;
+  const double *Pressure;
+};
+
+static int AxisValid_
+  ( const struct PsychroClimateAxis *Axis
+  )
+{
+  return Axis->Count > 0 && Axis->Min < Axis->Max && isfinite(Axis->Min) && isfinite(Axis->Max)
+    && Axis->Count <= SIZE_MAX / sizeof(uint64_t) - 2;
+}
+
+static int AxisEqual_
+  ( const struct PsychroClimateAxis *A
+  , const struct PsychroClimateAxis *B
+  )
+{
+  return A->Min == B->Min && A->Max == B->Max && A->Count == B->Count;
+}
+
+static void SetAxis_
+  ( struct PsychroClimateAxis *Axis
+  , double Min
+  , double Max
+  , double Width
+  )
+{
+  Axis->Min = Min;
+  Axis->Max = Max;
+  Axis->Count = (size_t) ((Max - Min) / Width + 0.5);
+}
+
+// Bin of a value: 0 below the bins, 1 to Count in the bins, Count + 1 above the bins
+static size_t Bin_
+  ( const struct PsychroClimateAxis *Axis
+  , double InvWidth
+  , double Value
+  )
+{
+  double u = (Value - Axis->Min) * InvWidth;
+
+  if (!(u >= 0.))
+    return 0;
+  if (u >= (double) Axis->Count)
+    return Value <= Axis->Max ? Axis->Count : Axis->Count + 1;
+  return (size_t) u + 1;
+}
+
+// Count the valid records of a call
+static void Add_
+  ( struct Worker *Worker
+  )
+{
+  PsychroClimate *Stats = Worker->Stats;
+  double Values[PSYCHRO_CLIMATE_N_VARIABLES], RelHum, VapPres, MoistAirVolume, DegreeOfSaturation;
+  double TMin = isIP() ? -148. : -100., TMax = isIP() ? 392. : 200.;
+  size_t i, i1, i2;
+  int k;
+
+  for (i = 0; i < Worker->Count; i++)
+  {
+    double TDryBulb = Worker->TDryBulb[i], TDewPoint = Worker->TDewPoint[i], Pressure = Worker->Pressure[i];
+
+    if (!(TDryBulb >= TMin && TDryBulb <= TMax && TDewPoint >= TMin && TDewPoint <= TDryBulb
+          && Pressure > 0. && isfinite(Pressure) && GetSatVapPres(TDewPoint) < Pressure))
+    {
+      Stats->Invalid++;
+      continue;
+    }
+    Values[PSYCHRO_CLIMATE_TDRY_BULB] = TDryBulb;
+    Values[PSYCHRO_CLIMATE_TDEW_POINT] = TDewPoint;
+    CalcPsychrometricsFromTDewPoint(TDryBulb, TDewPoint, Pressure, &Values[PSYCHRO_CLIMATE_HUM_RATIO],
+      &Values[PSYCHRO_CLIMATE_TWET_BULB], &RelHum, &VapPres, &Values[PSYCHRO_CLIMATE_MOIST_AIR_ENTHALPY],
+      &MoistAirVolume, &DegreeOfSaturation);
+
+    Stats->Count++;
+    for (k = 0; k < PSYCHRO_CLIMATE_N_VARIABLES; k++)
+    {
+      Stats->Bins[k][Bin_(&Stats->Config.Quantiles[k], Stats->InvWidth[k], Values[k])]++;
+      Stats->Minimum[k] = fmin(Stats->Minimum[k], Values[k]);
+      Stats->Maximum[k] = fmax(Stats->Maximum[k], Values[k]);
+    }
+    i1 = Bin_(&Stats->Config.TDryBulb, Stats->HistogramInvWidth[0], TDryBulb);
+    i2 = Bin_(&Stats->Config.HumRatio, Stats->HistogramInvWidth[1], Values[PSYCHRO_CLIMATE_HUM_RATIO]);
+    if (i1 == 0 || i1 > Stats->Config.TDryBulb.Count || i2 == 0 || i2 > Stats->Config.HumRatio.Count)
+      Stats->OutOfRange++;
+    else
+      Stats->Histogram[(i1 - 1) * Stats->Config.HumRatio.Count + i2 - 1]++;
+  }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI Thread_(LPVOID Worker)
+{
+  Add_(Worker);
+  return 0;
+}
+#else
+static void *Thread_(void *Worker)
+{
+  Add_(Worker);
+  return NULL;
+}
+#endif
+
+
+/******************************************************************************************************
+ * Statistics management
+ *****************************************************************************************************/
+
+// Bins of 0.01 °C (0.018 °F) for the temperatures, 1e-5 for the humidity ratio and 10 J kg⁻¹
+// (0.005 Btu lb⁻¹) for the enthalpy, and a histogram of 1 °C (1.8 °F) by 0.0005.
+void PsychroClimateGetDefaultConfig
+  ( struct PsychroClimateConfig *Config // (o) Bins for terrestrial climates in the current system of units
+  )
+{
+  if (isIP())
+  {
+    SetAxis_(&Config->Quantiles[PSYCHRO_CLIMATE_TDRY_BULB], -94., 140., 0.018);
+    SetAxis_(&Config->Quantiles[PSYCHRO_CLIMATE_TWET_BULB], -94., 113., 0.018);
+    SetAxis_(&Config->Quantiles[PSYCHRO_CLIMATE_TDEW_POINT], -130., 104., 0.018);
+    SetAxis_(&Config->Quantiles[PSYCHRO_CLIMATE_MOIST_AIR_ENTHALPY], -30., 95., 0.005);
+    SetAxis_(&Config->TDryBulb, -58., 131., 1.8);
+  }
+  else
+  {
+    SetAxis_(&Config->Quantiles[PSYCHRO_CLIMATE_TDRY_BULB], -70., 60., 0.01);
+    SetAxis_(&Config->Quantiles[PSYCHRO_CLIMATE_TWET_BULB], -70., 45., 0.01);
+    SetAxis_(&Config->Quantiles[PSYCHRO_CLIMATE_TDEW_POINT], -90., 40., 0.01);
+    SetAxis_(&Config->Quantiles[PSYCHRO_CLIMATE_MOIST_AIR_ENTHALPY], -70000., 160000., 10.);
+    SetAxis_(&Config->TDryBulb, -50., 55., 1.);
+  }
+  SetAxis_(&Config->Quantiles[PSYCHRO_CLIMATE_HUM_RATIO], 0., 0.05, 1e-5);
+  SetAxis_(&Config->HumRatio, 0., 0.035, 0.0005);
+}
+
+PsychroClimate *PsychroClimateCreate    // (o) New statistics with no records, NULL if the configuration is invalid or out of memory
+  ( const struct PsychroClimateConfig *Config // (i) Bins of the quantile sketches and of the histogram
+  )
+{
+  PsychroClimate *Stats;
+  int k, Failed = 0;
+
+  for (k = 0; k < PSYCHRO_CLIMATE_N_VARIABLES; k++)
+    if (!AxisValid_(&Config->Quantiles[k]))
+      return NULL;
+  if (!AxisValid_(&Config->TDryBulb) || !AxisValid_(&Config->HumRatio)
+      || Config->TDryBulb.Count > SIZE_MAX / sizeof(uint64_t) / Config->HumRatio.Count)
+    return NULL;
+
+  Stats = calloc(1, sizeof(PsychroClimate));
+  if (Stats == NULL)
+    return NULL;
+  Stats->Config = *Config;
+  for (k = 0; k < PSYCHRO_CLIMATE_N_VARIABLES; k++)
+  {
+    Stats->Bins[k] = calloc(Config->Quantiles[k].Count + 2, sizeof(uint64_t));
+    Failed |= Stats->Bins[k] == NULL;
+    Stats->InvWidth[k] = Config->Quantiles[k].Count / (Config->Quantiles[k].Max - Config->Quantiles[k].Min);
+    Stats->Minimum[k] = INFINITY;
+    Stats->Maximum[k] = -INFINITY;
+  }
+  Stats->Histogram = calloc(Config->TDryBulb.Count * Config->HumRatio.Count, sizeof(uint64_t));
+  Stats->HistogramInvWidth[0] = Config->TDryBulb.Count / (Config->TDryBulb.Max - Config->TDryBulb.Min);
+  Stats->HistogramInvWidth[1] = Config->HumRatio.Count / (Config->HumRatio.Max - Config->HumRatio.Min);
+  if (Failed || Stats->Histogram == NULL)
+  {
+    PsychroClimateDestroy(Stats);
+    return NULL;
+  }
+  return Stats;
+}
+
+void PsychroClimateDestroy
+  ( PsychroClimate *Stats               // (i) Statistics to free, may be NULL
+  )
+{
+  int k;
+
+  if (Stats == NULL)
+    return;
+  for (k = 0; k < PSYCHRO_CLIMATE_N_VARIABLES; k++)
+    free(Stats->Bins[k]);
+  free(Stats->Histogram);
+  free(Stats);
+}
+
+int PsychroClimateMerge                 // (o) 0 on success, -1 if the configurations differ
+  ( PsychroClimate *Stats               // (i/o) Statistics to which the records of Other are added
+  , const PsychroClimate *Other         // (i) Statistics of other records, unchanged
+  )
+{
+  size_t i;
+  int k;
+
+  for (k = 0; k < PSYCHRO_CLIMATE_N_VARIABLES; k++)
+    if (!AxisEqual_(&Stats->Config.Quantiles[k], &Other->Config.Quantiles[k]))
+      return -1;
+  if (!AxisEqual_(&Stats->Config.TDryBulb, &Other->Config.TDryBulb)
+      || !AxisEqual_(&Stats->Config.HumRatio, &Other->Config.HumRatio))
+    return -1;
+
+  Stats->Count += Other->Count;
+  Stats->Invalid += Other->Invalid;
+  for (k = 0; k < PSYCHRO_CLIMATE_N_VARIABLES; k++)
+  {
+    for (i = 0; i < Stats->Config.Quantiles[k].Count + 2; i++)
+      Stats->Bins[k][i] += Other->Bins[k][i];
+    Stats->Minimum[k] = fmin(Stats->Minimum[k], Other->Minimum[k]);
+    Stats->Maximum[k] = fmax(Stats->Maximum[k], Other->Maximum[k]);
+  }
+  for (i = 0; i < Stats->Config.TDryBulb.Count * Stats->Config.HumRatio.Count; i++)
+    Stats->Histogram[i] += Other->Histogram[i];
+  Stats->OutOfRange += Other->OutOfRange;
+  return 0;
+}
+
+
+/******************************************************************************************************
+ * Records and results
+ *****************************************************************************************************/
+
+// Add weather records to the statistics, splitting them between threads if requested.
+size_t PsychroClimateAdd                // (o) Number of invalid records, skipped
+  ( PsychroClimate *Stats               // (i/o) Statistics
+  , size_t Count                        // (i) Number of records
+  , const double *TDryBulb              // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *TDewPoint             // (i) Dew point temperature in °F [IP] or °C [SI]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , unsigned Threads                    // (i) Number of threads, 0 or 1 to add in the calling thread
+  )
+{
+  struct Worker Workers[MAX_THREADS];
+  uint64_t Invalid = Stats->Invalid;
+  size_t First = 0;
+  unsigned t, NThreads;
+  int Started[MAX_THREADS] = { 0 };
+#if defined(_WIN32)
+  HANDLE Handles[MAX_THREADS];
+#else
+  pthread_t Handles[MAX_THREADS];
+#endif
+
+  NThreads = Threads < 1 ? 1 : Threads > MAX_THREADS ? MAX_THREADS : Threads;
+  if (Count / MIN_RECORDS_PER_THREAD < NThreads)
+    NThreads = Count / MIN_RECORDS_PER_THREAD > 0 ? (unsigned) (Count / MIN_RECORDS_PER_THREAD) : 1;
+
+  // The first share is counted in the calling thread, directly in the statistics
+  for (t = 0; t < NThreads; t++)
+  {
+    Workers[t].Stats = t == 0 ? Stats : PsychroClimateCreate(&Stats->Config);
+    Workers[t].Count = Count / NThreads + (t < Count % NThreads);
+    Workers[t].TDryBulb = TDryBulb + First;
+    Workers[t].TDewPoint = TDewPoint + First;
+    Workers[t].Pressure = Pressure + First;
+    First += Workers[t].Count;
+  }
+
+  // Threads that cannot be started, or whose statistics cannot be created, are run in the calling thread
+  for (t = 1; t < NThreads; t++)
+  {
+    if (Workers[t].Stats == NULL)
+      continue;
+#if defined(_WIN32)
+    Handles[t] = CreateThread(NULL, 0, Thread_, &Workers[t], 0, NULL);
+    Started[t] = Handles[t] != NULL;
+#else
+    Started[t] = pthread_create(&Handles[t], NULL, Thread_, &Workers[t]) == 0;
+#endif
+  }
+  Add_(&Workers[0]);
+  for (t = 1; t < NThreads; t++)
+  {
+    if (Workers[t].Stats == NULL)
+    {
+      Workers[t].Stats = Stats;
+      Add_(&Workers[t]);
+      continue;
+    }
+    if (!Started[t])
+      Add_(&Workers[t]);
+    else
+    {
+#if defined(_WIN32)
+      WaitForSingleObject(Handles[t], INFINITE);
+      CloseHandle(Handles[t]);
+#else
+      pthread_join(Handles[t], NULL);
+#endif
+    }
+    PsychroClimateMerge(Stats, Workers[t].Stats);
+    PsychroClimateDestroy(Workers[t].Stats);
+  }
+  return (size_t) (Stats->Invalid - Invalid);
+}
+
+uint64_t PsychroClimateGetCount         // (o) Number of valid records added
+  ( const PsychroClimate *Stats         // (i) Statistics
+  )
+{
+  return Stats->Count;
+}
+
+uint64_t PsychroClimateGetInvalidCount  // (o) Number of invalid records skipped
+  ( const PsychroClimate *Stats         // (i) Statistics
+  )
+{
+  return Stats->Invalid;
+}
+
+// Quantile of a variable, interpolated linearly in the bin of the sketch that holds it, within the
+// exact minimum and maximum.
+double PsychroClimateGetQuantile        // (o) Value not exceeded by a fraction Probability of the records, NaN if none or outside the bins
+  ( const PsychroClimate *Stats         // (i) Statistics
+  , enum PsychroClimateVariable Variable // (i) Variable
+  , double Probability                  // (i) Cumulative frequency [0-1]: 0 and 1 give the exact minimum and maximum
+  )
+{
+  const struct PsychroClimateAxis *Axis;
+  const uint64_t *Bins;
+  double Rank, Below, Value;
+  size_t b;
+
+  if ((unsigned) Variable >= PSYCHRO_CLIMATE_N_VARIABLES || Stats->Count == 0
+      || !(Probability >= 0. && Probability <= 1.))
+    return NAN;
+  if (Probability == 0.)
+    return Stats->Minimum[Variable];
+  if (Probability == 1.)
+    return Stats->Maximum[Variable];
+
+  Axis = &Stats->Config.Quantiles[Variable];
+  Bins = Stats->Bins[Variable];
+  Rank = Probability * (double) Stats->Count;
+  Below = (double) Bins[0];
+  if (Rank < Below)
+    return NAN;
+  for (b = 1; b <= Axis->Count; b++)
+  {
+    if (Bins[b] > 0 && Below + (double) Bins[b] >= Rank)
+    {
+      Value = Axis->Min + ((double) (b - 1) + (Rank - Below) / (double) Bins[b]) / Stats->InvWidth[Variable];
+      return fmin(fmax(Value, Stats->Minimum[Variable]), Stats->Maximum[Variable]);
+    }
+    Below += (double) Bins[b];
+  }
+  return NAN;
+}
+
+const uint64_t *PsychroClimateGetHistogram // (o) Number of records (bin hours of hourly records) in each bin, TDryBulb.Count rows of HumRatio.Count bins
+  ( const PsychroClimate *Stats         // (i) Statistics
+  , uint64_t *OutOfRange                // (o) Number of records outside the bins, may be NULL
+  )
+{
+  if (OutOfRange != NULL)
+    *OutOfRange = Stats->OutOfRange;
+  return Stats->Histogram;
+}
@@ -0,0 +1,104 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Climate statistics: streaming quantile sketches and bin-hour histograms of moist air properties
+ * over weather records, in bounded memory and mergeable across shards.
+ * See psychrolib_climate.c for details.
+*/
+
+#ifndef PSYCHROLIB_CLIMATE_H
+#define PSYCHROLIB_CLIMATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/******************************************************************************************************
+ * Statistics configuration
+ *****************************************************************************************************/
+
+typedef struct PsychroClimate PsychroClimate;
+
+// Variables of the quantile sketches
+enum PsychroClimateVariable
+{
+  PSYCHRO_CLIMATE_TDRY_BULB,            // Dry bulb temperature in °F [IP] or °C [SI]
+  PSYCHRO_CLIMATE_TWET_BULB,            // Wet bulb temperature in °F [IP] or °C [SI]
+  PSYCHRO_CLIMATE_TDEW_POINT,           // Dew point temperature in °F [IP] or °C [SI]
+  PSYCHRO_CLIMATE_HUM_RATIO,            // Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  PSYCHRO_CLIMATE_MOIST_AIR_ENTHALPY,   // Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  PSYCHRO_CLIMATE_N_VARIABLES
+};
+
+// Uniform bins of a variable
+struct PsychroClimateAxis
+{
+  double Min;                           // Lower edge of the first bin
+  double Max;                           // Upper edge of the last bin
+  size_t Count;                         // Number of bins
+};
+
+struct PsychroClimateConfig
+{
+  struct PsychroClimateAxis Quantiles[PSYCHRO_CLIMATE_N_VARIABLES]; // Bins of the quantile sketch of each variable
+  struct PsychroClimateAxis TDryBulb;   // Bins of dry bulb temperature of the histogram
+  struct PsychroClimateAxis HumRatio;   // Bins of humidity ratio of the histogram
+};
+
+
+/******************************************************************************************************
+ * Statistics management
+ *****************************************************************************************************/
+
+void PsychroClimateGetDefaultConfig
+  ( struct PsychroClimateConfig *Config // (o) Bins for terrestrial climates in the current system of units
+  );
+
+PsychroClimate *PsychroClimateCreate    // (o) New statistics with no records, NULL if the configuration is invalid or out of memory
+  ( const struct PsychroClimateConfig *Config // (i) Bins of the quantile sketches and of the histogram
+  );
+
+void PsychroClimateDestroy
+  ( PsychroClimate *Stats               // (i) Statistics to free, may be NULL
+  );
+
+int PsychroClimateMerge                 // (o) 0 on success, -1 if the configurations differ
+  ( PsychroClimate *Stats               // (i/o) Statistics to which the records of Other are added
+  , const PsychroClimate *Other         // (i) Statistics of other records, unchanged
+  );
+
+
+/******************************************************************************************************
+ * Records and results
+ *****************************************************************************************************/
+
+size_t PsychroClimateAdd                // (o) Number of invalid records, skipped
+  ( PsychroClimate *Stats               // (i/o) Statistics
+  , size_t Count                        // (i) Number of records
+  , const double *TDryBulb              // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *TDewPoint             // (i) Dew point temperature in °F [IP] or °C [SI]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , unsigned Threads                    // (i) Number of threads, 0 or 1 to add in the calling thread
+  );
+
+uint64_t PsychroClimateGetCount         // (o) Number of valid records added
+  ( const PsychroClimate *Stats         // (i) Statistics
+  );
+
+uint64_t PsychroClimateGetInvalidCount  // (o) Number of invalid records skipped
+  ( const PsychroClimate *Stats         // (i) Statistics
+  );
+
+double PsychroClimateGetQuantile        // (o) Value not exceeded by a fraction Probability of the records, NaN if none or outside the bins
+  ( const PsychroClimate *Stats         // (i) Statistics
+  , enum PsychroClimateVariable Variable // (i) Variable
+  , double Probability                  // (i) Cumulative frequency [0-1]: 0 and 1 give the exact minimum and maximum
+  );
+
+const uint64_t *PsychroClimateGetHistogram // (o) Number of records (bin hours of hourly records) in each bin, TDryBulb.Count rows of HumRatio.Count bins
+  ( const PsychroClimate *Stats         // (i) Statistics
+  , uint64_t *OutOfRange                // (o) Number of records outside the bins, may be NULL
+  );
+
+#endif // PSYCHROLIB_CLIMATE_H
@@ -0,0 +1,560 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Gridded fields: psychrometric properties of fields of climate-model and reanalysis data stored
+ *  in raw little-endian files, mapped and processed in tiles by several threads, with a memory use
+ *  that does not depend on the size of the fields.
+ *
+ *  Each field is an array of NPoints single or double precision values in a file, e.g. in time,
+ *  latitude and longitude order, possibly after a header of Start bytes, with a scale and an offset
+ *  to the units of the library (e.g. temperatures in K). The inputs are the dry-bulb and dew-point
+ *  temperatures and the pressure, and the outputs any of the wet-bulb temperature, relative
+ *  humidity, humidity ratio, vapor pressure, enthalpy and specific volume, calculated with
+ *  BoundedCalcPsychrometricsFromTDewPoint of psychrolib_bounded.c, which returns a status instead of
+ *  exiting: the outputs of the points outside the range of the equations, or with NaN inputs (e.g.
+ *  missing values), are NaN. Dew-point temperatures above the dry-bulb temperature, which occur in
+ *  reanalyses from interpolation, are clipped to it.
+ *
+ *  The pressure of each point is read from the pressure field as the station pressure; with an
+ *  elevation field, the pressure field is the sea level pressure, converted with GetStationPressure,
+ *  and without a pressure field the pressure is the standard atmosphere at the elevation of
+ *  GetStandardAtmPressure. Without both, all the points have the pressure of the configuration. The
+ *  elevation field has NGrid values (e.g. latitudes × longitudes), repeated along the other fields
+ *  (e.g. at each time), and is mapped whole.
+ *
+ *  The points are split into tiles of TileSize points, assigned to the threads in turn. Each
+ *  thread maps the part of each file that holds a tile, converts the tile into arrays of doubles
+ *  that stay in its cache, calculates the outputs, stores them into the mapped output files and
+ *  unmaps the files before the next tile, so that the memory of a processing is the tiles of the
+ *  threads and the elevation field, whatever the size of the fields; the pages of the files are
+ *  read and written back by the system. The output files are created or replaced, with the size of
+ *  their fields. The system of units must not be changed during a processing.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_field.h"
+ *  SetUnitSystem(SI);
+ *  // ERA5-like hourly fields in K and Pa, sea level pressure and surface elevation
+ *  struct PsychroFieldConfig Config = { 0 };
+ *  Config.NPoints = 8760ULL * 721 * 1440;
+ *  Config.NGrid = 721 * 1440;
+ *  Config.Inputs[PSYCHRO_FIELD_TDRY_BULB] = (struct PsychroFieldFile) { "t2m.f32", PSYCHRO_FIELD_FLOAT32, 0, 1., -273.15 };
+ *  Config.Inputs[PSYCHRO_FIELD_TDEW_POINT] = (struct PsychroFieldFile) { "d2m.f32", PSYCHRO_FIELD_FLOAT32, 0, 1., -273.15 };
+ *  Config.Inputs[PSYCHRO_FIELD_PRESSURE] = (struct PsychroFieldFile) { "msl.f32", PSYCHRO_FIELD_FLOAT32, 0, 1., 0. };
+ *  Config.Inputs[PSYCHRO_FIELD_ELEVATION] = (struct PsychroFieldFile) { "z.f32", PSYCHRO_FIELD_FLOAT32, 0, 1., 0. };
+ *  Config.Outputs[PSYCHRO_FIELD_TWET_BULB] = (struct PsychroFieldFile) { "tw.f32", PSYCHRO_FIELD_FLOAT32, 0, 1., 0. };
+ *  Config.Outputs[PSYCHRO_FIELD_REL_HUM] = (struct PsychroFieldFile) { "rh.f32", PSYCHRO_FIELD_FLOAT32, 0, 1., 0. };
+ *  Config.Threads = 8;
+ *  struct PsychroFieldReport Report;
+ *  PsychroFieldProcess(&Config, &Report);
+ */
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+// Standard C header files
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_bounded.h"
+#include "psychrolib_field.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define DEFAULT_TILE_SIZE 16384         // Default number of points of a tile.
+
+#define MAX_THREADS 64                  // Maximum number of threads of a processing.
+
+#define N_FILES (PSYCHRO_FIELD_N_INPUTS + PSYCHRO_FIELD_N_OUTPUTS)
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+// Open field file
+struct File_
+{
+  int Open;
+  int Write;
+  size_t ValueSize;                     // Size of the values in bytes
+  double Scale, Offset;
+  uint64_t Start;
+#if defined(_WIN32)
+  HANDLE Mapping;
+#else
+  int fd;
+#endif
+};
+
+// Part of a file mapped for a tile
+struct Window_
+{
+  void *Base;                           // Start of the mapping, aligned to the granularity of the system
+  size_t Length;
+  unsigned char *Data;                  // First value of the tile
+};
+
+// Tiles of a processing assigned to a thread
+struct Worker_
+{
+  const struct PsychroFieldConfig *Config;
+  const struct File_ *Files;            // Inputs then outputs
+  const unsigned char *Elevation;       // Elevation field, NULL if there is none
+  uint64_t FirstTile;
+  uint64_t NTiles;
+  unsigned Stride;                      // Number of threads
+  size_t TileSize;
+  size_t Granularity;                   // Alignment of the offsets of the mappings
+  double *Values;                       // Inputs then outputs of a tile, TileSize values each
+  uint64_t Points, Invalid, Tiles;
+  size_t Memory;                        // Largest mapped memory of a tile
+  int Status;
+};
+
+static size_t ValueSize_
+  ( enum PsychroFieldType Type
+  )
+{
+  return Type == PSYCHRO_FIELD_FLOAT32 ? 4 : Type == PSYCHRO_FIELD_FLOAT64 ? 8 : 0;
+}
+
+static int BigEndian_(void)
+{
+  const uint16_t One = 1;
+  return *(const unsigned char *) &One == 0;
+}
+
+// Value of a little-endian field
+static double Load_
+  ( const unsigned char *Data
+  , size_t ValueSize
+  , size_t i
+  )
+{
+  unsigned char Bytes[8];
+  float f;
+  double d;
+  size_t k;
+
+  if (BigEndian_())
+    for (k = 0; k < ValueSize; k++)
+      Bytes[k] = Data[i * ValueSize + ValueSize - 1 - k];
+  else
+    memcpy(Bytes, Data + i * ValueSize, ValueSize);
+  if (ValueSize == 4)
+  {
+    memcpy(&f, Bytes, 4);
+    return f;
+  }
+  memcpy(&d, Bytes, 8);
+  return d;
+}
+
+static void Store_
+  ( unsigned char *Data
+  , size_t ValueSize
+  , size_t i
+  , double Value
+  )
+{
+  unsigned char Bytes[8];
+  float f = (float) Value;
+  size_t k;
+
+  if (ValueSize == 4)
+    memcpy(Bytes, &f, 4);
+  else
+    memcpy(Bytes, &Value, 8);
+  if (BigEndian_())
+    for (k = 0; k < ValueSize; k++)
+      Data[i * ValueSize + k] = Bytes[ValueSize - 1 - k];
+  else
+    memcpy(Data + i * ValueSize, Bytes, ValueSize);
+}
+
+// Open an input file that holds its field, or create an output file of the size of its field
+static int OpenFile_
+  ( const struct PsychroFieldFile *Field
+  , uint64_t NPoints
+  , int Write
+  , struct File_ *File
+  )
+{
+  uint64_t Size;
+
+  File->Write = Write;
+  File->ValueSize = ValueSize_(Field->Type);
+  File->Scale = Field->Scale != 0. ? Field->Scale : 1.;
+  File->Offset = Field->Offset;
+  File->Start = Field->Start;
+  if (File->ValueSize == 0 || !isfinite(File->Scale) || !isfinite(File->Offset) || NPoints > (UINT64_MAX - Field->Start) / 8)
+    return -1;
+  Size = Field->Start + NPoints * File->ValueSize;
+
+#if defined(_WIN32)
+  {
+    HANDLE Handle;
+    LARGE_INTEGER FileSize;
+
+    Handle = CreateFileA(Field->Path, Write ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, Write ? 0 : FILE_SHARE_READ,
+      NULL, Write ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (Handle == INVALID_HANDLE_VALUE)
+      return -1;
+    if (!Write && (!GetFileSizeEx(Handle, &FileSize) || (uint64_t) FileSize.QuadPart < Size))
+    {
+      CloseHandle(Handle);
+      return -1;
+    }
+    // The mapping of an output file extends it to the size of the field
+    File->Mapping = CreateFileMappingA(Handle, NULL, Write ? PAGE_READWRITE : PAGE_READONLY,
+      Write ? (DWORD) (Size >> 32) : 0, Write ? (DWORD) Size : 0, NULL);
+    CloseHandle(Handle);
+    if (File->Mapping == NULL)
+      return -1;
+  }
+#else
+  {
+    struct stat Stat;
+
+    File->fd = Write ? open(Field->Path, O_RDWR | O_CREAT | O_TRUNC, 0644) : open(Field->Path, O_RDONLY);
+    if (File->fd < 0)
+      return -1;
+    if (Write ? ftruncate(File->fd, (off_t) Size) != 0 : fstat(File->fd, &Stat) != 0 || (uint64_t) Stat.st_size < Size)
+    {
+      close(File->fd);
+      return -1;
+    }
+  }
+#endif
+  File->Open = 1;
+  return 0;
+}
+
+static void CloseFile_
+  ( struct File_ *File
+  )
+{
+  if (!File->Open)
+    return;
+#if defined(_WIN32)
+  CloseHandle(File->Mapping);
+#else
+  close(File->fd);
+#endif
+  File->Open = 0;
+}
+
+// Map the values [First, First + Count) of a field
+static int MapWindow_
+  ( const struct File_ *File
+  , uint64_t First
+  , size_t Count
+  , size_t Granularity
+  , struct Window_ *Window
+  )
+{
+  uint64_t Offset = File->Start + First * File->ValueSize, Aligned = Offset - Offset % Granularity;
+
+  Window->Length = (size_t) (Offset - Aligned) + Count * File->ValueSize;
+#if defined(_WIN32)
+  Window->Base = MapViewOfFile(File->Mapping, File->Write ? FILE_MAP_WRITE : FILE_MAP_READ,
+    (DWORD) (Aligned >> 32), (DWORD) Aligned, Window->Length);
+  if (Window->Base == NULL)
+    return -1;
+#else
+  Window->Base = mmap(NULL, Window->Length, File->Write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED,
+    File->fd, (off_t) Aligned);
+  if (Window->Base == MAP_FAILED)
+  {
+    Window->Base = NULL;
+    return -1;
+  }
+#endif
+  Window->Data = (unsigned char *) Window->Base + (Offset - Aligned);
+  return 0;
+}
+
+static void UnmapWindow_
+  ( struct Window_ *Window
+  )
+{
+  if (Window->Base == NULL)
+    return;
+#if defined(_WIN32)
+  UnmapViewOfFile(Window->Base);
+#else
+  munmap(Window->Base, Window->Length);
+#endif
+  Window->Base = NULL;
+}
+
+// Outputs of the points of a tile from its inputs
+static void Compute_
+  ( struct Worker_ *Worker
+  , uint64_t First
+  , size_t n
+  )
+{
+  const struct PsychroFieldConfig *Config = Worker->Config;
+  double *In[PSYCHRO_FIELD_N_INPUTS], *Out[PSYCHRO_FIELD_N_OUTPUTS], TDewPoint, DegreeOfSaturation;
+  uint64_t NGrid = Config->NGrid > 0 ? Config->NGrid : Config->NPoints, g;
+  size_t j;
+  int k, HasPressure = Config->Inputs[PSYCHRO_FIELD_PRESSURE].Type != PSYCHRO_FIELD_NONE;
+
+  for (k = 0; k < PSYCHRO_FIELD_N_INPUTS; k++)
+    In[k] = Worker->Values + k * Worker->TileSize;
+  for (k = 0; k < PSYCHRO_FIELD_N_OUTPUTS; k++)
+    Out[k] = Worker->Values + (PSYCHRO_FIELD_N_INPUTS + k) * Worker->TileSize;
+
+  // Pressure of each point
+  if (Worker->Elevation != NULL)
+  {
+    const struct File_ *Elevation = &Worker->Files[PSYCHRO_FIELD_ELEVATION];
+    for (j = 0, g = First % NGrid; j < n; j++, g = g + 1 < NGrid ? g + 1 : 0)
+      In[PSYCHRO_FIELD_ELEVATION][j] = Elevation->Scale * Load_(Worker->Elevation, Elevation->ValueSize, g) + Elevation->Offset;
+    for (j = 0; j < n; j++)
+      In[PSYCHRO_FIELD_PRESSURE][j] = HasPressure
+        ? GetStationPressure(In[PSYCHRO_FIELD_PRESSURE][j], In[PSYCHRO_FIELD_ELEVATION][j], In[PSYCHRO_FIELD_TDRY_BULB][j])
+        : GetStandardAtmPressure(In[PSYCHRO_FIELD_ELEVATION][j]);
+  }
+  else if (!HasPressure)
+    for (j = 0; j < n; j++)
+      In[PSYCHRO_FIELD_PRESSURE][j] = Config->Pressure;
+
+  for (j = 0; j < n; j++)
+  {
+    TDewPoint = fmin(In[PSYCHRO_FIELD_TDEW_POINT][j], In[PSYCHRO_FIELD_TDRY_BULB][j]);
+    if (isnan(In[PSYCHRO_FIELD_TDRY_BULB][j]) || isnan(In[PSYCHRO_FIELD_TDEW_POINT][j]) || isnan(In[PSYCHRO_FIELD_PRESSURE][j])
+      || BoundedCalcPsychrometricsFromTDewPoint(In[PSYCHRO_FIELD_TDRY_BULB][j], TDewPoint, In[PSYCHRO_FIELD_PRESSURE][j],
+        &Out[PSYCHRO_FIELD_HUM_RATIO][j], &Out[PSYCHRO_FIELD_TWET_BULB][j], &Out[PSYCHRO_FIELD_REL_HUM][j],
+        &Out[PSYCHRO_FIELD_VAP_PRES][j], &Out[PSYCHRO_FIELD_MOIST_AIR_ENTHALPY][j], &Out[PSYCHRO_FIELD_MOIST_AIR_VOLUME][j],
+        &DegreeOfSaturation) != PSYCHRO_STATUS_OK)
+    {
+      for (k = 0; k < PSYCHRO_FIELD_N_OUTPUTS; k++)
+        Out[k][j] = NAN;
+      Worker->Invalid++;
+    }
+  }
+}
+
+// Tiles FirstTile, FirstTile + Stride, ... of a processing
+static void Process_
+  ( struct Worker_ *Worker
+  )
+{
+  const struct PsychroFieldConfig *Config = Worker->Config;
+  struct Window_ Windows[N_FILES];
+  uint64_t Tile, First;
+  size_t n, j, Memory;
+  int f;
+
+  memset(Windows, 0, sizeof Windows);
+  for (Tile = Worker->FirstTile; Tile < Worker->NTiles && Worker->Status == 0; Tile += Worker->Stride)
+  {
+    First = Tile * Worker->TileSize;
+    n = (size_t) (Config->NPoints - First < Worker->TileSize ? Config->NPoints - First : Worker->TileSize);
+    Memory = 0;
+    for (f = 0; f < N_FILES; f++)
+      if (Worker->Files[f].Open && f != PSYCHRO_FIELD_ELEVATION)
+      {
+        if (MapWindow_(&Worker->Files[f], First, n, Worker->Granularity, &Windows[f]) != 0)
+          Worker->Status = -1;
+        Memory += Windows[f].Length;
+      }
+
+    if (Worker->Status == 0)
+    {
+      for (f = 0; f < PSYCHRO_FIELD_N_INPUTS; f++)
+        if (Windows[f].Base != NULL)
+        {
+          const struct File_ *File = &Worker->Files[f];
+          double *In = Worker->Values + f * Worker->TileSize;
+          for (j = 0; j < n; j++)
+            In[j] = File->Scale * Load_(Windows[f].Data, File->ValueSize, j) + File->Offset;
+        }
+      Compute_(Worker, First, n);
+      for (f = PSYCHRO_FIELD_N_INPUTS; f < N_FILES; f++)
+        if (Windows[f].Base != NULL)
+        {
+          const struct File_ *File = &Worker->Files[f];
+          const double *Out = Worker->Values + f * Worker->TileSize;
+          for (j = 0; j < n; j++)
+            Store_(Windows[f].Data, File->ValueSize, j, (Out[j] - File->Offset) / File->Scale);
+        }
+      Worker->Points += n;
+      Worker->Tiles++;
+      if (Memory > Worker->Memory)
+        Worker->Memory = Memory;
+    }
+    for (f = 0; f < N_FILES; f++)
+      UnmapWindow_(&Windows[f]);
+  }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI Thread_(LPVOID Worker)
+{
+  Process_(Worker);
+  return 0;
+}
+#else
+static void *Thread_(void *Worker)
+{
+  Process_(Worker);
+  return NULL;
+}
+#endif
+
+
+/******************************************************************************************************
+ * Processing
+ *****************************************************************************************************/
+
+// Calculate the output fields from the input fields, tile by tile, splitting the tiles between
+// threads if requested.
+int PsychroFieldProcess                 // (o) 0 on success, -1 if the configuration is invalid or a file cannot be read or written
+  ( const struct PsychroFieldConfig *Config // (i) Input and output fields
+  , struct PsychroFieldReport *Report   // (o) Counters of the processing, may be NULL
+  )
+{
+  struct File_ Files[N_FILES];
+  struct Worker_ Workers[MAX_THREADS];
+  struct Window_ Elevation = { NULL, 0, NULL };
+  uint64_t NTiles, NGrid = Config->NGrid > 0 ? Config->NGrid : Config->NPoints;
+  size_t TileSize = Config->TileSize > 0 ? Config->TileSize : DEFAULT_TILE_SIZE, Granularity;
+  unsigned t, NThreads;
+  int f, Status = 0, Started[MAX_THREADS] = { 0 };
+#if defined(_WIN32)
+  HANDLE Handles[MAX_THREADS];
+  SYSTEM_INFO Info;
+
+  GetSystemInfo(&Info);
+  Granularity = Info.dwAllocationGranularity;
+#else
+  pthread_t Handles[MAX_THREADS];
+
+  Granularity = (size_t) sysconf(_SC_PAGESIZE);
+#endif
+
+  if (Report != NULL)
+    memset(Report, 0, sizeof *Report);
+  if (Config->Inputs[PSYCHRO_FIELD_TDRY_BULB].Type == PSYCHRO_FIELD_NONE
+    || Config->Inputs[PSYCHRO_FIELD_TDEW_POINT].Type == PSYCHRO_FIELD_NONE || Config->NPoints == 0
+    || (Config->Inputs[PSYCHRO_FIELD_ELEVATION].Type != PSYCHRO_FIELD_NONE && Config->NPoints % NGrid != 0)
+    || (Config->Inputs[PSYCHRO_FIELD_PRESSURE].Type == PSYCHRO_FIELD_NONE
+      && Config->Inputs[PSYCHRO_FIELD_ELEVATION].Type == PSYCHRO_FIELD_NONE && !(Config->Pressure > 0.))
+    || TileSize > SIZE_MAX / (N_FILES * sizeof(double)))
+    return -1;
+  for (f = 0; f < N_FILES; f++)
+  {
+    const struct PsychroFieldFile *Field = f < PSYCHRO_FIELD_N_INPUTS ? &Config->Inputs[f] : &Config->Outputs[f - PSYCHRO_FIELD_N_INPUTS];
+    if (Field->Type != PSYCHRO_FIELD_NONE && Field->Path == NULL)
+      return -1;
+  }
+
+  memset(Files, 0, sizeof Files);
+  for (f = 0; f < N_FILES && Status == 0; f++)
+  {
+    const struct PsychroFieldFile *Field = f < PSYCHRO_FIELD_N_INPUTS ? &Config->Inputs[f] : &Config->Outputs[f - PSYCHRO_FIELD_N_INPUTS];
+    if (Field->Type != PSYCHRO_FIELD_NONE)
+      Status = OpenFile_(Field, f == PSYCHRO_FIELD_ELEVATION ? NGrid : Config->NPoints, f >= PSYCHRO_FIELD_N_INPUTS, &Files[f]);
+  }
+  if (Status == 0 && Files[PSYCHRO_FIELD_ELEVATION].Open && NGrid > SIZE_MAX / 8)
+    Status = -1;
+  if (Status == 0 && Files[PSYCHRO_FIELD_ELEVATION].Open)
+    Status = MapWindow_(&Files[PSYCHRO_FIELD_ELEVATION], 0, (size_t) NGrid, Granularity, &Elevation);
+
+  NTiles = Config->NPoints / TileSize + (Config->NPoints % TileSize != 0);
+  NThreads = Config->Threads < 1 ? 1 : Config->Threads > MAX_THREADS ? MAX_THREADS : Config->Threads;
+  if (NTiles < NThreads)
+    NThreads = NTiles > 0 ? (unsigned) NTiles : 1;
+  for (t = 0; t < NThreads && Status == 0; t++)
+  {
+    memset(&Workers[t], 0, sizeof Workers[t]);
+    Workers[t].Config = Config;
+    Workers[t].Files = Files;
+    Workers[t].Elevation = Elevation.Data;
+    Workers[t].FirstTile = t;
+    Workers[t].NTiles = NTiles;
+    Workers[t].Stride = NThreads;
+    Workers[t].TileSize = TileSize;
+    Workers[t].Granularity = Granularity;
+    Workers[t].Values = malloc(N_FILES * TileSize * sizeof(double));
+    if (Workers[t].Values == NULL)
+    {
+      while (t-- > 0)
+        free(Workers[t].Values);
+      Status = -1;
+    }
+  }
+
+  if (Status == 0)
+  {
+    // Threads that cannot be started are run in the calling thread
+    for (t = 1; t < NThreads; t++)
+    {
+#if defined(_WIN32)
+      Handles[t] = CreateThread(NULL, 0, Thread_, &Workers[t], 0, NULL);
+      Started[t] = Handles[t] != NULL;
+#else
+      Started[t] = pthread_create(&Handles[t], NULL, Thread_, &Workers[t]) == 0;
+#endif
+    }
+    Process_(&Workers[0]);
+    for (t = 1; t < NThreads; t++)
+    {
+      if (!Started[t])
+        Process_(&Workers[t]);
+      else
+      {
+#if defined(_WIN32)
+        WaitForSingleObject(Handles[t], INFINITE);
+        CloseHandle(Handles[t]);
+#else
+        pthread_join(Handles[t], NULL);
+#endif
+      }
+    }
+    for (t = 0; t < NThreads; t++)
+    {
+      if (Workers[t].Status != 0)
+        Status = -1;
+      if (Report != NULL)
+      {
+        Report->Points += Workers[t].Points;
+        Report->Invalid += Workers[t].Invalid;
+        Report->Tiles += Workers[t].Tiles;
+        Report->Memory += Workers[t].Memory + N_FILES * TileSize * sizeof(double);
+      }
+      free(Workers[t].Values);
+    }
+    if (Report != NULL)
+      Report->Memory += Elevation.Length;
+  }
+
+  UnmapWindow_(&Elevation);
+  for (f = 0; f < N_FILES; f++)
+    CloseFile_(&Files[f]);
+  return Status;
+}
@@ -0,0 +1,83 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Gridded fields: psychrometric properties of fields of climate-model and reanalysis data stored
+ * in raw little-endian files, mapped and processed in tiles by several threads, with a memory use
+ * that does not depend on the size of the fields.
+ * See psychrolib_field.c for details.
+*/
+
+#ifndef PSYCHROLIB_FIELD_H
+#define PSYCHROLIB_FIELD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/******************************************************************************************************
+ * Fields
+ *****************************************************************************************************/
+
+enum PsychroFieldType
+{
+  PSYCHRO_FIELD_NONE,                   // No field
+  PSYCHRO_FIELD_FLOAT32,                // Little-endian IEEE 754 single precision
+  PSYCHRO_FIELD_FLOAT64                 // Little-endian IEEE 754 double precision
+};
+
+enum PsychroFieldInput
+{
+  PSYCHRO_FIELD_TDRY_BULB,              // Dry bulb temperature in °F [IP] or °C [SI], required
+  PSYCHRO_FIELD_TDEW_POINT,             // Dew point temperature in °F [IP] or °C [SI], required
+  PSYCHRO_FIELD_PRESSURE,               // Station pressure, or sea level pressure with an elevation field, in Psi [IP] or Pa [SI]
+  PSYCHRO_FIELD_ELEVATION,              // Altitude above sea level in ft [IP] or m [SI] of the points of the grid
+  PSYCHRO_FIELD_N_INPUTS
+};
+
+enum PsychroFieldOutput
+{
+  PSYCHRO_FIELD_TWET_BULB,              // Wet bulb temperature in °F [IP] or °C [SI]
+  PSYCHRO_FIELD_REL_HUM,                // Relative humidity [0-1]
+  PSYCHRO_FIELD_HUM_RATIO,              // Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  PSYCHRO_FIELD_VAP_PRES,               // Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  PSYCHRO_FIELD_MOIST_AIR_ENTHALPY,     // Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  PSYCHRO_FIELD_MOIST_AIR_VOLUME,       // Specific volume of moist air in ft³ lb⁻¹ of dry air [IP] or in m³ kg⁻¹ of dry air [SI]
+  PSYCHRO_FIELD_N_OUTPUTS
+};
+
+// Field stored in a file as an array of values, e.g. in time, latitude and longitude order
+struct PsychroFieldFile
+{
+  const char *Path;                     // Path of the file, NULL if the field is not read or written
+  enum PsychroFieldType Type;           // Type of the values
+  uint64_t Start;                       // Position of the first value in the file in bytes
+  double Scale;                         // Value in the units of the library = Scale * stored value + Offset, 0 for 1
+  double Offset;                        // e.g. Scale 1 and Offset -273.15 for temperatures in K [SI]
+};
+
+struct PsychroFieldConfig
+{
+  uint64_t NPoints;                     // Number of values of each field
+  uint64_t NGrid;                       // Number of values of the elevation field, repeated along the others, 0 for NPoints
+  struct PsychroFieldFile Inputs[PSYCHRO_FIELD_N_INPUTS];
+  struct PsychroFieldFile Outputs[PSYCHRO_FIELD_N_OUTPUTS]; // Files created or replaced
+  double Pressure;                      // Pressure of all the points without pressure and elevation fields in Psi [IP] or Pa [SI]
+  size_t TileSize;                      // Number of points processed together, 0 for 16384
+  unsigned Threads;                     // Number of threads, at least 1
+};
+
+struct PsychroFieldReport
+{
+  uint64_t Points;                      // Number of points processed
+  uint64_t Invalid;                     // Number of points outside the range of the equations, NaN in the outputs
+  uint64_t Tiles;                       // Number of tiles processed
+  size_t Memory;                        // Memory of the tiles in bytes, mapped and allocated, summed over the threads
+};
+
+int PsychroFieldProcess                 // (o) 0 on success, -1 if the configuration is invalid or a file cannot be read or written
+  ( const struct PsychroFieldConfig *Config // (i) Input and output fields
+  , struct PsychroFieldReport *Report   // (o) Counters of the processing, may be NULL
+  );
+
+#endif // PSYCHROLIB_FIELD_H
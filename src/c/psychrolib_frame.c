@@ -0,0 +1,388 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Frames: the inputs and results of the CalcPsychrometrics* functions for a batch of points, as
+ *  one column of values per property.
+ *
+ *  Calculating all the properties of a batch with the generic functions takes seven output arrays,
+ *  which are typically allocated for each batch and freed after it. A frame holds the columns of a
+ *  batch instead: the caller adds and fills the input columns, PsychroFrameCalcPsychrometrics adds
+ *  the result columns and fills them, and the columns are then read in place, e.g. handed over
+ *  to other code without a copy. Each column is a contiguous array of doubles, or of floats to
+ *  halve the memory of large batches, aligned on PSYCHRO_FRAME_ALIGNMENT bytes (a cache line, and
+ *  the width of the widest vector registers).
+ *
+ *  The columns are allocated from an arena owned by the frame: a list of aligned blocks, from which
+ *  a column is a bump of the used size of the first block with enough room, or a new block at least
+ *  twice as large as the previous ones when none has. PsychroFrameReset removes all the columns and
+ *  rewinds the arena, and the blocks are merged into one when the arena had to grow. After the
+ *  first batch of a given size, or a reset following it, the columns of every batch of the same or
+ *  a smaller size are carved out of that block: the batches make no allocation on the heap, and
+ *  the columns are at the same addresses from one batch to the next.
+ *
+ *  The results are calculated by chunks of CHUNK rows. The double columns are passed to the
+ *  functions directly, the float columns through buffers on the stack, widened before and rounded
+ *  after the calculation. With a site context, the chunks are calculated by the batch function
+ *  PsychroSiteCalcPsychrometricsFromRelHum at the pressure of the site, and the pressure column is
+ *  not used; otherwise, by the generic functions, row by row. The inputs are checked as in these
+ *  functions.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_frame.h"
+ *  SetUnitSystem(SI);
+ *  PsychroFrame *Frame = PsychroFrameCreate(0);
+ *  PsychroFrameReset(Frame, Count);
+ *  double *TDryBulb = PsychroFrameAddColumn(Frame, PSYCHRO_COLUMN_TDRY_BULB, PSYCHRO_COLUMN_FLOAT64);
+ *  ...
+ *  PsychroFrameCalcPsychrometrics(Frame, PSYCHRO_COLUMN_REL_HUM, PSYCHRO_COLUMN_FLOAT32, NULL);
+ *  const float *HumRatio = PsychroFrameGetColumn(Frame, PSYCHRO_COLUMN_HUM_RATIO);
+ *  PsychroFrameDestroy(Frame);
+ */
+
+// Standard C header files
+#include <stdint.h>
+#include <stdlib.h>
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_frame.h"
+#include "psychrolib_trace.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define ALIGNMENT PSYCHRO_FRAME_ALIGNMENT
+
+#define CHUNK 256                       // Number of rows calculated together.
+
+#define N_OUTPUTS 7                     // Number of results of the CalcPsychrometrics* functions.
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+// Block of the arena, followed by its data.
+struct Block
+{
+  struct Block *Next;
+  size_t Size;                          // Size of the data in bytes
+  size_t Used;                          // Bytes of the data allocated since the last reset
+  unsigned char *Data;                  // First aligned byte after the structure
+};
+
+struct PsychroFrame
+{
+  size_t Count;
+  struct Block *Blocks;                 // Most recent first
+  void *Columns[PSYCHRO_N_COLUMNS];     // NULL for the columns not in the frame
+  enum PsychroColumnType Types[PSYCHRO_N_COLUMNS];
+};
+
+// Return a new block of Size bytes of aligned data, or NULL if out of memory.
+static struct Block *NewBlock_
+  ( size_t Size
+  )
+{
+  struct Block *Block;
+
+  if (Size > SIZE_MAX - sizeof(struct Block) - ALIGNMENT)
+    return NULL;
+  Block = malloc(sizeof(struct Block) + Size + ALIGNMENT - 1);
+  if (Block == NULL)
+    return NULL;
+  Block->Next = NULL;
+  Block->Size = Size;
+  Block->Used = 0;
+  Block->Data = (unsigned char *) (((uintptr_t) (Block + 1) + ALIGNMENT - 1) & ~(uintptr_t) (ALIGNMENT - 1));
+  return Block;
+}
+
+// Return Size bytes of aligned data from the arena, or NULL if out of memory.
+static void *Allocate_
+  ( PsychroFrame *Frame
+  , size_t Size
+  )
+{
+  struct Block *Block;
+  size_t Total = 0;
+  void *Data;
+
+  if (Size > SIZE_MAX - ALIGNMENT)
+    return NULL;
+  // At least one alignment unit, so that a column of no rows is not NULL
+  Size = max((Size + ALIGNMENT - 1) & ~(size_t) (ALIGNMENT - 1), ALIGNMENT);
+  for (Block = Frame->Blocks; Block != NULL; Block = Block->Next)
+  {
+    if (Block->Size - Block->Used >= Size)
+    {
+      Data = Block->Data + Block->Used;
+      Block->Used += Size;
+      return Data;
+    }
+    Total += Block->Size;
+  }
+
+  Block = NewBlock_(max(Size, Total <= SIZE_MAX / 2 ? 2 * Total : Total));
+  if (Block == NULL)
+    return NULL;
+  Block->Next = Frame->Blocks;
+  Block->Used = Size;
+  Frame->Blocks = Block;
+  return Block->Data;
+}
+
+// Copy floats to doubles.
+static void Widen_
+  ( const float *x
+  , size_t n
+  , double *y
+  )
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    y[i] = x[i];
+}
+
+// Round doubles to floats.
+static void Narrow_
+  ( const double *x
+  , size_t n
+  , float *y
+  )
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    y[i] = (float) x[i];
+}
+
+
+/******************************************************************************************************
+ * Frame management
+ *****************************************************************************************************/
+
+PsychroFrame *PsychroFrameCreate        // (o) New frame with no rows, NULL if out of memory
+  ( size_t ArenaSize                    // (i) Initial size of the arena in bytes, may be 0
+  )
+{
+  PsychroFrame *Frame;
+
+  Frame = calloc(1, sizeof(PsychroFrame));
+  if (Frame == NULL)
+    return NULL;
+  if (ArenaSize > 0)
+  {
+    Frame->Blocks = NewBlock_(ArenaSize);
+    if (Frame->Blocks == NULL)
+    {
+      free(Frame);
+      return NULL;
+    }
+  }
+  return Frame;
+}
+
+void PsychroFrameDestroy
+  ( PsychroFrame *Frame                 // (i) Frame to free, may be NULL
+  )
+{
+  struct Block *Block, *Next;
+
+  if (Frame == NULL)
+    return;
+  for (Block = Frame->Blocks; Block != NULL; Block = Next)
+  {
+    Next = Block->Next;
+    free(Block);
+  }
+  free(Frame);
+}
+
+void PsychroFrameReset
+  ( PsychroFrame *Frame                 // (i) Frame, whose columns are all removed and their memory reused
+  , size_t Count                        // (i) Number of rows
+  )
+{
+  struct Block *Block, *Next, *Merged;
+  size_t Total = 0;
+  int c;
+
+  Frame->Count = Count;
+  for (c = 0; c < PSYCHRO_N_COLUMNS; c++)
+    Frame->Columns[c] = NULL;
+
+  // Merge the blocks into one, or keep them if out of memory
+  if (Frame->Blocks != NULL && Frame->Blocks->Next != NULL)
+  {
+    for (Block = Frame->Blocks; Block != NULL; Block = Block->Next)
+      Total += Block->Size;
+    Merged = NewBlock_(Total);
+    if (Merged != NULL)
+    {
+      for (Block = Frame->Blocks; Block != NULL; Block = Next)
+      {
+        Next = Block->Next;
+        free(Block);
+      }
+      Frame->Blocks = Merged;
+    }
+  }
+  for (Block = Frame->Blocks; Block != NULL; Block = Block->Next)
+    Block->Used = 0;
+}
+
+size_t PsychroFrameGetCount             // (o) Number of rows
+  ( const PsychroFrame *Frame           // (i) Frame
+  )
+{
+  return Frame->Count;
+}
+
+size_t PsychroFrameGetArenaSize         // (o) Memory held by the arena in bytes
+  ( const PsychroFrame *Frame           // (i) Frame
+  )
+{
+  const struct Block *Block;
+  size_t Size = 0;
+
+  for (Block = Frame->Blocks; Block != NULL; Block = Block->Next)
+    Size += Block->Size;
+  return Size;
+}
+
+
+/******************************************************************************************************
+ * Columns
+ *****************************************************************************************************/
+
+void *PsychroFrameAddColumn             // (o) Column of Count values, aligned on PSYCHRO_FRAME_ALIGNMENT bytes, NULL if out of memory
+  ( PsychroFrame *Frame                 // (i) Frame
+  , enum PsychroColumn Column           // (i) Column, replaced if already in the frame with another type
+  , enum PsychroColumnType Type         // (i) Type of the values
+  )
+{
+  size_t ValueSize = Type == PSYCHRO_COLUMN_FLOAT32 ? sizeof(float) : sizeof(double);
+  void *Data;
+
+  if (Frame->Columns[Column] != NULL && Frame->Types[Column] == Type)
+    return Frame->Columns[Column];
+  if (Frame->Count > (SIZE_MAX - ALIGNMENT) / ValueSize)
+    return NULL;
+  Data = Allocate_(Frame, Frame->Count * ValueSize);
+  if (Data == NULL)
+    return NULL;
+  Frame->Columns[Column] = Data;
+  Frame->Types[Column] = Type;
+  return Data;
+}
+
+void *PsychroFrameGetColumn             // (o) Values of the column, valid until the next reset, NULL if not in the frame
+  ( const PsychroFrame *Frame           // (i) Frame
+  , enum PsychroColumn Column           // (i) Column
+  )
+{
+  return Frame->Columns[Column];
+}
+
+enum PsychroColumnType PsychroFrameGetColumnType // (o) Type of the values of the column
+  ( const PsychroFrame *Frame           // (i) Frame
+  , enum PsychroColumn Column           // (i) Column in the frame
+  )
+{
+  return Frame->Types[Column];
+}
+
+
+/******************************************************************************************************
+ * Calculations
+ *****************************************************************************************************/
+
+int PsychroFrameCalcPsychrometrics      // (o) 0, or -1 if an input column is missing, the site does not apply or out of memory
+  ( PsychroFrame *Frame                 // (i) Frame with the dry-bulb temperature, pressure and input columns
+  , enum PsychroColumn Input            // (i) PSYCHRO_COLUMN_TWET_BULB, PSYCHRO_COLUMN_TDEW_POINT or PSYCHRO_COLUMN_REL_HUM
+  , enum PsychroColumnType Type         // (i) Type of the result columns
+  , const PsychroSite *Site             // (i) Site context instead of the pressure column with PSYCHRO_COLUMN_REL_HUM, or NULL
+  )
+{
+  // Results of each function, in the order of its arguments
+  static const enum PsychroColumn OUTPUTS[3][N_OUTPUTS] =
+    { { PSYCHRO_COLUMN_HUM_RATIO, PSYCHRO_COLUMN_TDEW_POINT, PSYCHRO_COLUMN_REL_HUM, PSYCHRO_COLUMN_VAP_PRES
+      , PSYCHRO_COLUMN_MOIST_AIR_ENTHALPY, PSYCHRO_COLUMN_MOIST_AIR_VOLUME, PSYCHRO_COLUMN_DEGREE_OF_SATURATION }
+    , { PSYCHRO_COLUMN_HUM_RATIO, PSYCHRO_COLUMN_TWET_BULB, PSYCHRO_COLUMN_REL_HUM, PSYCHRO_COLUMN_VAP_PRES
+      , PSYCHRO_COLUMN_MOIST_AIR_ENTHALPY, PSYCHRO_COLUMN_MOIST_AIR_VOLUME, PSYCHRO_COLUMN_DEGREE_OF_SATURATION }
+    , { PSYCHRO_COLUMN_HUM_RATIO, PSYCHRO_COLUMN_TWET_BULB, PSYCHRO_COLUMN_TDEW_POINT, PSYCHRO_COLUMN_VAP_PRES
+      , PSYCHRO_COLUMN_MOIST_AIR_ENTHALPY, PSYCHRO_COLUMN_MOIST_AIR_VOLUME, PSYCHRO_COLUMN_DEGREE_OF_SATURATION }
+    };
+  enum PsychroColumn Inputs[3] = { PSYCHRO_COLUMN_TDRY_BULB, Input, PSYCHRO_COLUMN_PRESSURE };
+  double Buffers[PSYCHRO_N_COLUMNS][CHUNK], *In[3], *Out[N_OUTPUTS];
+  const enum PsychroColumn *Outputs;
+  size_t Count = Frame->Count, First, n, i;
+  int NInputs = Site == NULL ? 3 : 2, k, c;
+
+  if (Input == PSYCHRO_COLUMN_TWET_BULB)
+    Outputs = OUTPUTS[0];
+  else if (Input == PSYCHRO_COLUMN_TDEW_POINT)
+    Outputs = OUTPUTS[1];
+  else if (Input == PSYCHRO_COLUMN_REL_HUM)
+    Outputs = OUTPUTS[2];
+  else
+    return -1;
+  if (Site != NULL && Input != PSYCHRO_COLUMN_REL_HUM)
+    return -1;
+  for (k = 0; k < NInputs; k++)
+    if (Frame->Columns[Inputs[k]] == NULL)
+      return -1;
+  for (k = 0; k < N_OUTPUTS; k++)
+    if (PsychroFrameAddColumn(Frame, Outputs[k], Type) == NULL)
+      return -1;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+
+  for (First = 0; First < Count; First += n)
+  {
+    n = min(Count - First, CHUNK);
+    for (k = 0; k < NInputs; k++)
+    {
+      c = Inputs[k];
+      if (Frame->Types[c] == PSYCHRO_COLUMN_FLOAT64)
+        In[k] = (double *) Frame->Columns[c] + First;
+      else
+      {
+        In[k] = Buffers[c];
+        Widen_((const float *) Frame->Columns[c] + First, n, In[k]);
+      }
+    }
+    for (k = 0; k < N_OUTPUTS; k++)
+      Out[k] = Type == PSYCHRO_COLUMN_FLOAT64 ? (double *) Frame->Columns[Outputs[k]] + First : Buffers[Outputs[k]];
+
+    if (Site != NULL)
+      PsychroSiteCalcPsychrometricsFromRelHum(Site, n, In[0], In[1], Out[0], Out[1], Out[2], Out[3], Out[4], Out[5], Out[6]);
+    else if (Input == PSYCHRO_COLUMN_TWET_BULB)
+      for (i = 0; i < n; i++)
+        CalcPsychrometricsFromTWetBulb(In[0][i], In[1][i], In[2][i], &Out[0][i], &Out[1][i], &Out[2][i], &Out[3][i],
+          &Out[4][i], &Out[5][i], &Out[6][i]);
+    else if (Input == PSYCHRO_COLUMN_TDEW_POINT)
+      for (i = 0; i < n; i++)
+        CalcPsychrometricsFromTDewPoint(In[0][i], In[1][i], In[2][i], &Out[0][i], &Out[1][i], &Out[2][i], &Out[3][i],
+          &Out[4][i], &Out[5][i], &Out[6][i]);
+    else
+      for (i = 0; i < n; i++)
+        CalcPsychrometricsFromRelHum(In[0][i], In[1][i], In[2][i], &Out[0][i], &Out[1][i], &Out[2][i], &Out[3][i],
+          &Out[4][i], &Out[5][i], &Out[6][i]);
+
+    if (Type == PSYCHRO_COLUMN_FLOAT32)
+      for (k = 0; k < N_OUTPUTS; k++)
+        Narrow_(Out[k], n, (float *) Frame->Columns[Outputs[k]] + First);
+  }
+
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+  return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Frames: aligned columns of inputs and results of the CalcPsychrometrics* functions, allocated
+ * from an arena that is reused from one batch to the next.
+ * See psychrolib_frame.c for details.
+*/
+
+#ifndef PSYCHROLIB_FRAME_H
+#define PSYCHROLIB_FRAME_H
+
+#include <stddef.h>
+
+#include "psychrolib_site.h"
+
+// Alignment of the columns, in bytes
+#define PSYCHRO_FRAME_ALIGNMENT 64
+
+
+/******************************************************************************************************
+ * Frame columns
+ *****************************************************************************************************/
+
+typedef struct PsychroFrame PsychroFrame;
+
+enum PsychroColumn
+{
+  PSYCHRO_COLUMN_TDRY_BULB,             // Dry bulb temperature in °F [IP] or °C [SI]
+  PSYCHRO_COLUMN_PRESSURE,              // Atmospheric pressure in Psi [IP] or Pa [SI]
+  PSYCHRO_COLUMN_TWET_BULB,             // Wet bulb temperature in °F [IP] or °C [SI]
+  PSYCHRO_COLUMN_TDEW_POINT,            // Dew point temperature in °F [IP] or °C [SI]
+  PSYCHRO_COLUMN_REL_HUM,               // Relative humidity [0-1]
+  PSYCHRO_COLUMN_HUM_RATIO,             // Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  PSYCHRO_COLUMN_VAP_PRES,              // Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  PSYCHRO_COLUMN_MOIST_AIR_ENTHALPY,    // Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  PSYCHRO_COLUMN_MOIST_AIR_VOLUME,      // Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  PSYCHRO_COLUMN_DEGREE_OF_SATURATION,  // Degree of saturation [unitless]
+  PSYCHRO_N_COLUMNS
+};
+
+enum PsychroColumnType
+{
+  PSYCHRO_COLUMN_FLOAT64,               // double
+  PSYCHRO_COLUMN_FLOAT32                // float, calculated in double and rounded
+};
+
+
+/******************************************************************************************************
+ * Frame management
+ *****************************************************************************************************/
+
+PsychroFrame *PsychroFrameCreate        // (o) New frame with no rows, NULL if out of memory
+  ( size_t ArenaSize                    // (i) Initial size of the arena in bytes, may be 0
+  );
+
+void PsychroFrameDestroy
+  ( PsychroFrame *Frame                 // (i) Frame to free, may be NULL
+  );
+
+void PsychroFrameReset
+  ( PsychroFrame *Frame                 // (i) Frame, whose columns are all removed and their memory reused
+  , size_t Count                        // (i) Number of rows
+  );
+
+size_t PsychroFrameGetCount             // (o) Number of rows
+  ( const PsychroFrame *Frame           // (i) Frame
+  );
+
+size_t PsychroFrameGetArenaSize         // (o) Memory held by the arena in bytes
+  ( const PsychroFrame *Frame           // (i) Frame
+  );
+
+
+/******************************************************************************************************
+ * Columns
+ *****************************************************************************************************/
+
+void *PsychroFrameAddColumn             // (o) Column of Count values, aligned on PSYCHRO_FRAME_ALIGNMENT bytes, NULL if out of memory
+  ( PsychroFrame *Frame                 // (i) Frame
+  , enum PsychroColumn Column           // (i) Column, replaced if already in the frame with another type
+  , enum PsychroColumnType Type         // (i) Type of the values
+  );
+
+void *PsychroFrameGetColumn             // (o) Values of the column, valid until the next reset, NULL if not in the frame
+  ( const PsychroFrame *Frame           // (i) Frame
+  , enum PsychroColumn Column           // (i) Column
+  );
+
+enum PsychroColumnType PsychroFrameGetColumnType // (o) Type of the values of the column
+  ( const PsychroFrame *Frame           // (i) Frame
+  , enum PsychroColumn Column           // (i) Column in the frame
+  );
+
+
+/******************************************************************************************************
+ * Calculations
+ *****************************************************************************************************/
+
+int PsychroFrameCalcPsychrometrics      // (o) 0, or -1 if an input column is missing, the site does not apply or out of memory
+  ( PsychroFrame *Frame                 // (i) Frame with the dry-bulb temperature, pressure and input columns
+  , enum PsychroColumn Input            // (i) PSYCHRO_COLUMN_TWET_BULB, PSYCHRO_COLUMN_TDEW_POINT or PSYCHRO_COLUMN_REL_HUM
+  , enum PsychroColumnType Type         // (i) Type of the result columns
+  , const PsychroSite *Site             // (i) Site context instead of the pressure column with PSYCHRO_COLUMN_REL_HUM, or NULL
+  );
+
+#endif // PSYCHROLIB_FRAME_H
@@ -0,0 +1,597 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Value and gradient functions: analytic partial derivatives for simulation solvers.
+ *
+ *  Newton solvers of coupled HVAC equations need derivatives such as ∂HumRatio/∂TWetBulb or
+ *  ∂RelHum/∂HumRatio. Finite differences of the generic functions cost one or two more calls per
+ *  input, each of them running the iterative wet-bulb or dew-point solver again, and their result
+ *  is only as accurate as the tolerance of the solver. The functions of this module return the
+ *  value of the generic function of the same name together with its gradient:
+ *   - the explicit equations are differentiated directly, using the analytic derivative of the
+ *     saturation vapor pressure of ASHRAE eqn. 5 and 6 (dLnPws_ in psychrolib.c);
+ *   - the dew-point and wet-bulb temperatures are defined implicitly by
+ *       LnPws(TDewPoint) = ln(VapPres)  and  HumRatio(TDryBulb, TWetBulb, Pressure) = HumRatio
+ *     with ASHRAE eqn. 33 and 35 on the right. By the implicit function theorem, their derivatives
+ *     follow from the partial derivatives of the explicit equation at the solution, e.g.
+ *       ∂TWetBulb/∂TDryBulb = -(∂HumRatio/∂TDryBulb) / (∂HumRatio/∂TWetBulb).
+ *     They cost one evaluation of the explicit equation on top of the generic solver, and are
+ *     exact for the solution returned by the solver.
+ *
+ *  Where the generic functions clip a value (humidity ratio below MIN_HUM_RATIO, dew-point
+ *  temperature above the dry-bulb temperature), the derivative of the clipped branch is
+ *  returned. At the points where the equations are not differentiable (the triple point for the
+ *  saturation vapor pressure, the freezing point for ASHRAE eqn. 33 and 35), the derivative of
+ *  the branch selected by the generic function is returned.
+ *
+ *  The batch functions evaluate the CalcPsychrometrics* functions over arrays of points, and
+ *  return the Jacobian of the seven outputs with respect to the three inputs of each point as a
+ *  dense row-major block, obtained by the chain rule through the humidity ratio.
+ *
+ *  Inputs are checked as in the generic functions.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_gradient.h"
+ *  double Gradient[3];
+ *  SetUnitSystem(SI);
+ *  double TWetBulb = GradGetTWetBulbFromHumRatio(25.0, 0.01, 101325.0, Gradient);
+ *  // Gradient[1] is the derivative of the wet-bulb temperature with respect to the humidity ratio
+ */
+
+// Standard C header files
+#include <math.h>
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_kernels.h"
+#include "psychrolib_gradient.h"
+#include "psychrolib_trace.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define MOLAR_MASS_RATIO 0.621945       // Ratio of the molar masses of water and dry air, ASHRAE eqn. 20.
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+// Absolute temperature in °R [IP] or K [SI]
+static double TAbsolute_
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  )
+{
+  return isIP() ? GetTRankineFromTFahrenheit(TDryBulb) : GetTKelvinFromTCelsius(TDryBulb);
+}
+
+// Derivative of the saturation humidity ratio, given the saturation vapor pressure and its
+// derivative with respect to the temperature
+static void SatHumRatioGradient_
+  ( double SatVapPres           // (i) Vapor Pressure of saturated air in Psi [IP] or Pa [SI]
+  , double dSatVapPres          // (i) Derivative of SatVapPres with respect to the temperature
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[2]          // (o) Partial derivatives with respect to the temperature and Pressure
+  )
+{
+  double Den = (Pressure - SatVapPres) * (Pressure - SatVapPres);
+
+  if (MOLAR_MASS_RATIO * SatVapPres / (Pressure - SatVapPres) < MIN_HUM_RATIO)
+  {
+    Gradient[0] = Gradient[1] = 0.;
+    return;
+  }
+  Gradient[0] = MOLAR_MASS_RATIO * Pressure * dSatVapPres / Den;
+  Gradient[1] = -MOLAR_MASS_RATIO * SatVapPres / Den;
+}
+
+// Partial derivatives of an output with respect to the three inputs of a point, from its partial
+// derivatives with respect to TDryBulb, HumRatio and Pressure and those of the humidity ratio
+static void Chain_
+  ( const double dOutput[3]     // (i) Partial derivatives of the output with respect to TDryBulb, HumRatio and Pressure
+  , const double dHumRatio[3]   // (i) Partial derivatives of the humidity ratio with respect to the inputs
+  , double Row[3]               // (o) Partial derivatives of the output with respect to the inputs
+  )
+{
+  Row[0] = dOutput[0] + dOutput[1] * dHumRatio[0];
+  Row[1] = dOutput[1] * dHumRatio[1];
+  Row[2] = dOutput[2] + dOutput[1] * dHumRatio[2];
+}
+
+
+/******************************************************************************************************
+ * Saturated air and humidity ratio
+ *****************************************************************************************************/
+
+// Return saturation vapor pressure and its derivative.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 5 & 6
+double GradGetSatVapPres        // (o) Vapor Pressure of saturated air in Psi [IP] or Pa [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double Gradient[1]          // (o) Partial derivative with respect to TDryBulb
+  )
+{
+  double SatVapPres = GetSatVapPres(TDryBulb);
+
+  Gradient[0] = SatVapPres * dLnPws_(TDryBulb);
+  return SatVapPres;
+}
+
+// Return humidity ratio of saturated air and its gradient.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 36, solved for W
+double GradGetSatHumRatio       // (o) Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[2]          // (o) Partial derivatives with respect to TDryBulb and Pressure
+  )
+{
+  double dSatVapPres[1];
+  double SatVapPres = GradGetSatVapPres(TDryBulb, dSatVapPres);
+
+  SatHumRatioGradient_(SatVapPres, dSatVapPres[0], Pressure, Gradient);
+  return GetSatHumRatio(TDryBulb, Pressure);
+}
+
+// Return humidity ratio and its gradient given water vapor pressure and atmospheric pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 20
+double GradGetHumRatioFromVapPres // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( double VapPres              // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[2]          // (o) Partial derivatives with respect to VapPres and Pressure
+  )
+{
+  double HumRatio = GetHumRatioFromVapPres(VapPres, Pressure);
+
+  // Same derivatives as the saturation humidity ratio with respect to the vapor pressure
+  SatHumRatioGradient_(VapPres, 1., Pressure, Gradient);
+  return HumRatio;
+}
+
+// Return vapor pressure and its gradient given humidity ratio and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 20 solved for pw
+double GradGetVapPresFromHumRatio // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  ( double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[2]          // (o) Partial derivatives with respect to HumRatio and Pressure
+  )
+{
+  double VapPres = GetVapPresFromHumRatio(HumRatio, Pressure);
+  double BoundedHumRatio = fmax(HumRatio, MIN_HUM_RATIO);
+
+  Gradient[0] = HumRatio > MIN_HUM_RATIO ?
+    Pressure * MOLAR_MASS_RATIO / ((MOLAR_MASS_RATIO + BoundedHumRatio) * (MOLAR_MASS_RATIO + BoundedHumRatio)) : 0.;
+  Gradient[1] = BoundedHumRatio / (MOLAR_MASS_RATIO + BoundedHumRatio);
+  return VapPres;
+}
+
+// Return humidity ratio and its gradient given dry-bulb temperature, relative humidity, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+double GradGetHumRatioFromRelHum // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double RelHum               // (i) Relative humidity [0-1]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, RelHum and Pressure
+  )
+{
+  double HumRatio = GetHumRatioFromRelHum(TDryBulb, RelHum, Pressure);
+  double dSatVapPres[1], dHumRatio[2];
+  double SatVapPres = GradGetSatVapPres(TDryBulb, dSatVapPres);
+
+  GradGetHumRatioFromVapPres(RelHum * SatVapPres, Pressure, dHumRatio);
+  Gradient[0] = dHumRatio[0] * RelHum * dSatVapPres[0];
+  Gradient[1] = dHumRatio[0] * SatVapPres;
+  Gradient[2] = dHumRatio[1];
+  return HumRatio;
+}
+
+// Return relative humidity and its gradient given dry-bulb temperature, humidity ratio, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+double GradGetRelHumFromHumRatio // (o) Relative humidity [0-1]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, HumRatio and Pressure
+  )
+{
+  double RelHum = GetRelHumFromHumRatio(TDryBulb, HumRatio, Pressure);
+  double SatVapPres = GetSatVapPres(TDryBulb);
+  double dVapPres[2];
+
+  GradGetVapPresFromHumRatio(HumRatio, Pressure, dVapPres);
+  Gradient[0] = -RelHum * dLnPws_(TDryBulb);
+  Gradient[1] = dVapPres[0] / SatVapPres;
+  Gradient[2] = dVapPres[1] / SatVapPres;
+  return RelHum;
+}
+
+// Return humidity ratio and its gradient given dew-point temperature and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+double GradGetHumRatioFromTDewPoint // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( double TDewPoint            // (i) Dew point temperature in °F [IP] or °C [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[2]          // (o) Partial derivatives with respect to TDewPoint and Pressure
+  )
+{
+  double HumRatio = GetHumRatioFromTDewPoint(TDewPoint, Pressure);
+  double dVapPres[1];
+  double VapPres = GradGetSatVapPres(TDewPoint, dVapPres);
+
+  SatHumRatioGradient_(VapPres, dVapPres[0], Pressure, Gradient);
+  return HumRatio;
+}
+
+
+/******************************************************************************************************
+ * Wet-bulb temperature
+ *****************************************************************************************************/
+
+// Return humidity ratio and its gradient given dry-bulb temperature, wet-bulb temperature, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 33 and 35
+double GradGetHumRatioFromTWetBulb // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double TWetBulb             // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, TWetBulb and Pressure
+  )
+{
+  const struct PsychroKernelUnits *Units = isIP() ? &PSYCHRO_KERNEL_UNITS_IP : &PSYCHRO_KERNEL_UNITS_SI;
+  double HumRatio = GetHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure);
+  double Wsstar, dWsstar[2], Den, RawHumRatio;
+  // A, B, C, D and E of ASHRAE eqn. 33 or 35:
+  // HumRatio = ((A - B * TWetBulb) * Wsstar - C * (TDryBulb - TWetBulb)) / (A + D * TDryBulb - E * TWetBulb)
+  const double *k = TWetBulb >= Units->FreezingPoint ? Units->WetBulbLiquid : Units->WetBulbIce;
+
+  Wsstar = GradGetSatHumRatio(TWetBulb, Pressure, dWsstar);
+  Den = k[0] + k[3] * TDryBulb - k[4] * TWetBulb;
+  RawHumRatio = ((k[0] - k[1] * TWetBulb) * Wsstar - k[2] * (TDryBulb - TWetBulb)) / Den;
+
+  if (RawHumRatio < MIN_HUM_RATIO)
+    Gradient[0] = Gradient[1] = Gradient[2] = 0.;
+  else
+  {
+    Gradient[0] = (-k[2] - RawHumRatio * k[3]) / Den;
+    Gradient[1] = (-k[1] * Wsstar + (k[0] - k[1] * TWetBulb) * dWsstar[0] + k[2] + RawHumRatio * k[4]) / Den;
+    Gradient[2] = (k[0] - k[1] * TWetBulb) * dWsstar[1] / Den;
+  }
+  return HumRatio;
+}
+
+// Return wet-bulb temperature and its gradient given dry-bulb temperature, humidity ratio, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 33 and 35 solved for Tstar
+// Notes: implicit function theorem on HumRatio(TDryBulb, TWetBulb, Pressure) = HumRatio at the
+// solution of the generic function.
+double GradGetTWetBulbFromHumRatio // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, HumRatio and Pressure
+  )
+{
+  double TWetBulb = GetTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure);
+  double dHumRatio[3];
+
+  GradGetHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure, dHumRatio);
+  if (dHumRatio[1] <= 0.)
+  {
+    Gradient[0] = Gradient[1] = Gradient[2] = 0.;
+    return TWetBulb;
+  }
+  Gradient[0] = -dHumRatio[0] / dHumRatio[1];
+  Gradient[1] = HumRatio > MIN_HUM_RATIO ? 1. / dHumRatio[1] : 0.;
+  Gradient[2] = -dHumRatio[2] / dHumRatio[1];
+  return TWetBulb;
+}
+
+// Return wet-bulb temperature and its gradient given dry-bulb temperature, relative humidity, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+double GradGetTWetBulbFromRelHum // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double RelHum               // (i) Relative humidity [0-1]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, RelHum and Pressure
+  )
+{
+  double dHumRatio[3], dTWetBulb[3];
+  double HumRatio = GradGetHumRatioFromRelHum(TDryBulb, RelHum, Pressure, dHumRatio);
+  double TWetBulb = GradGetTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure, dTWetBulb);
+
+  Chain_(dTWetBulb, dHumRatio, Gradient);
+  return TWetBulb;
+}
+
+
+/******************************************************************************************************
+ * Dew-point temperature
+ *****************************************************************************************************/
+
+// Return dew-point temperature and its gradient given dry-bulb temperature and vapor pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 5 and 6
+// Notes: implicit function theorem on LnPws(TDewPoint) = ln(VapPres) at the solution of the
+// generic function. The dew-point temperature is clipped to the dry-bulb temperature.
+double GradGetTDewPointFromVapPres // (o) Dew point temperature in °F [IP] or °C [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double VapPres              // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double Gradient[2]          // (o) Partial derivatives with respect to TDryBulb and VapPres
+  )
+{
+  double TDewPoint = GetTDewPointFromVapPres(TDryBulb, VapPres);
+
+  if (TDewPoint >= TDryBulb)
+  {
+    Gradient[0] = 1.;
+    Gradient[1] = 0.;
+  }
+  else
+  {
+    Gradient[0] = 0.;
+    Gradient[1] = 1. / (VapPres * dLnPws_(TDewPoint));
+  }
+  return TDewPoint;
+}
+
+// Return dew-point temperature and its gradient given dry-bulb temperature, humidity ratio, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+double GradGetTDewPointFromHumRatio // (o) Dew point temperature in °F [IP] or °C [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, HumRatio and Pressure
+  )
+{
+  double dVapPres[2], dTDewPoint[2];
+  double VapPres = GradGetVapPresFromHumRatio(HumRatio, Pressure, dVapPres);
+  double TDewPoint = GradGetTDewPointFromVapPres(TDryBulb, VapPres, dTDewPoint);
+
+  Gradient[0] = dTDewPoint[0];
+  Gradient[1] = dTDewPoint[1] * dVapPres[0];
+  Gradient[2] = dTDewPoint[1] * dVapPres[1];
+  return TDewPoint;
+}
+
+// Return dew-point temperature and its gradient given dry-bulb temperature and relative humidity.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+double GradGetTDewPointFromRelHum // (o) Dew point temperature in °F [IP] or °C [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double RelHum               // (i) Relative humidity [0-1]
+  , double Gradient[2]          // (o) Partial derivatives with respect to TDryBulb and RelHum
+  )
+{
+  double dSatVapPres[1], dTDewPoint[2];
+  double SatVapPres, TDewPoint;
+
+  ASSERT (RelHum >= 0 && RelHum <= 1, "Relative humidity is outside range [0,1]")
+
+  SatVapPres = GradGetSatVapPres(TDryBulb, dSatVapPres);
+  TDewPoint = GradGetTDewPointFromVapPres(TDryBulb, GetVapPresFromRelHum(TDryBulb, RelHum), dTDewPoint);
+  Gradient[0] = dTDewPoint[0] + dTDewPoint[1] * RelHum * dSatVapPres[0];
+  Gradient[1] = dTDewPoint[1] * SatVapPres;
+  return TDewPoint;
+}
+
+
+/******************************************************************************************************
+ * Moist air
+ *****************************************************************************************************/
+
+// Return moist air enthalpy and its gradient given dry-bulb temperature and humidity ratio.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 30
+double GradGetMoistAirEnthalpy  // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Gradient[2]          // (o) Partial derivatives with respect to TDryBulb and HumRatio
+  )
+{
+  double MoistAirEnthalpy = GetMoistAirEnthalpy(TDryBulb, HumRatio);
+  double BoundedHumRatio = fmax(HumRatio, MIN_HUM_RATIO);
+
+  if (isIP())
+  {
+    Gradient[0] = CP_DRY_AIR_IP + CP_VAPOR_IP * BoundedHumRatio;
+    Gradient[1] = H_VAPOR_IP + CP_VAPOR_IP * TDryBulb;
+  }
+  else
+  {
+    Gradient[0] = (CP_DRY_AIR_SI + CP_VAPOR_SI * BoundedHumRatio) * 1000.;
+    Gradient[1] = (H_VAPOR_SI + CP_VAPOR_SI * TDryBulb) * 1000.;
+  }
+  Gradient[1] = HumRatio > MIN_HUM_RATIO ? Gradient[1] : 0.;
+  return MoistAirEnthalpy;
+}
+
+// Return moist air specific volume and its gradient given dry-bulb temperature, humidity ratio, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 26
+// Notes: the volume is proportional to the absolute temperature and inversely proportional to the pressure.
+double GradGetMoistAirVolume    // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, HumRatio and Pressure
+  )
+{
+  double MoistAirVolume = GetMoistAirVolume(TDryBulb, HumRatio, Pressure);
+  double BoundedHumRatio = fmax(HumRatio, MIN_HUM_RATIO);
+
+  Gradient[0] = MoistAirVolume / TAbsolute_(TDryBulb);
+  Gradient[1] = HumRatio > MIN_HUM_RATIO ? MoistAirVolume * 1.607858 / (1. + 1.607858 * BoundedHumRatio) : 0.;
+  Gradient[2] = -MoistAirVolume / Pressure;
+  return MoistAirVolume;
+}
+
+// Return moist air density and its gradient given dry-bulb temperature, humidity ratio, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 11
+double GradGetMoistAirDensity   // (o) Moist air density in lb ft⁻³ [IP] or kg m⁻³ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, HumRatio and Pressure
+  )
+{
+  double MoistAirDensity = GetMoistAirDensity(TDryBulb, HumRatio, Pressure);
+  double dMoistAirVolume[3];
+  double MoistAirVolume = GradGetMoistAirVolume(TDryBulb, HumRatio, Pressure, dMoistAirVolume);
+
+  Gradient[0] = -MoistAirDensity / TAbsolute_(TDryBulb);
+  Gradient[1] = HumRatio > MIN_HUM_RATIO ? (1. - MoistAirDensity * dMoistAirVolume[1]) / MoistAirVolume : 0.;
+  Gradient[2] = MoistAirDensity / Pressure;
+  return MoistAirDensity;
+}
+
+// Return the degree of saturation and its gradient given dry-bulb temperature, humidity ratio, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2009) ch. 1 eqn. 12
+double GradGetDegreeOfSaturation // (o) Degree of saturation [unitless]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, HumRatio and Pressure
+  )
+{
+  double DegreeOfSaturation = GetDegreeOfSaturation(TDryBulb, HumRatio, Pressure);
+  double dSatHumRatio[2];
+  double SatHumRatio = GradGetSatHumRatio(TDryBulb, Pressure, dSatHumRatio);
+
+  Gradient[0] = -DegreeOfSaturation * dSatHumRatio[0] / SatHumRatio;
+  Gradient[1] = HumRatio > MIN_HUM_RATIO ? 1. / SatHumRatio : 0.;
+  Gradient[2] = -DegreeOfSaturation * dSatHumRatio[1] / SatHumRatio;
+  return DegreeOfSaturation;
+}
+
+
+/******************************************************************************************************
+ * Batch functions with dense Jacobian blocks
+ *****************************************************************************************************/
+
+// Outputs that only depend on the humidity ratio, dry-bulb temperature and pressure, i.e. the last
+// four outputs of all CalcPsychrometrics* functions, and their rows of the Jacobian
+static void CalcMoistAirProperties_
+  ( double TDryBulb
+  , double HumRatio
+  , double Pressure
+  , const double dHumRatio[3]   // (i) Partial derivatives of the humidity ratio with respect to the inputs
+  , double Values[4]            // (o) VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation
+  , double Jacobian[4][3]       // (o) Rows of the Jacobian of the outputs
+  )
+{
+  double g[2], d[3];
+
+  Values[0] = GradGetVapPresFromHumRatio(HumRatio, Pressure, g);
+  d[0] = 0.;
+  d[1] = g[0];
+  d[2] = g[1];
+  Chain_(d, dHumRatio, Jacobian[0]);
+
+  Values[1] = GradGetMoistAirEnthalpy(TDryBulb, HumRatio, g);
+  d[0] = g[0];
+  d[1] = g[1];
+  d[2] = 0.;
+  Chain_(d, dHumRatio, Jacobian[1]);
+
+  Values[2] = GradGetMoistAirVolume(TDryBulb, HumRatio, Pressure, d);
+  Chain_(d, dHumRatio, Jacobian[2]);
+
+  Values[3] = GradGetDegreeOfSaturation(TDryBulb, HumRatio, Pressure, d);
+  Chain_(d, dHumRatio, Jacobian[3]);
+}
+
+// Return the outputs of CalcPsychrometricsFromTWetBulb and their Jacobian for each point.
+void GradCalcPsychrometricsFromTWetBulb
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *TWetBulb      // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , const double *Pressure      // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *Values              // (o) HumRatio, TDewPoint, RelHum, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation
+  , double *Jacobian            // (o) Partial derivatives with respect to TDryBulb, TWetBulb and Pressure
+  )
+{
+  double (*J)[PSYCHRO_GRAD_N_INPUTS];
+  double *v, d[3];
+  size_t i;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  for (i = 0; i < Count; i++)
+  {
+    v = Values + i * PSYCHRO_GRAD_N_OUTPUTS;
+    J = (double (*)[PSYCHRO_GRAD_N_INPUTS]) (Jacobian + i * PSYCHRO_GRAD_N_OUTPUTS * PSYCHRO_GRAD_N_INPUTS);
+
+    ASSERT(TWetBulb[i] <= TDryBulb[i], "Wet bulb temperature is above dry bulb temperature")
+
+    v[0] = GradGetHumRatioFromTWetBulb(TDryBulb[i], TWetBulb[i], Pressure[i], J[0]);
+    v[1] = GradGetTDewPointFromHumRatio(TDryBulb[i], v[0], Pressure[i], d);
+    Chain_(d, J[0], J[1]);
+    v[2] = GradGetRelHumFromHumRatio(TDryBulb[i], v[0], Pressure[i], d);
+    Chain_(d, J[0], J[2]);
+    CalcMoistAirProperties_(TDryBulb[i], v[0], Pressure[i], J[0], v + 3, J + 3);
+  }
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
+
+// Return the outputs of CalcPsychrometricsFromTDewPoint and their Jacobian for each point.
+void GradCalcPsychrometricsFromTDewPoint
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *TDewPoint     // (i) Dew point temperature in °F [IP] or °C [SI]
+  , const double *Pressure      // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *Values              // (o) HumRatio, TWetBulb, RelHum, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation
+  , double *Jacobian            // (o) Partial derivatives with respect to TDryBulb, TDewPoint and Pressure
+  )
+{
+  double (*J)[PSYCHRO_GRAD_N_INPUTS];
+  double *v, d[3];
+  size_t i;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  for (i = 0; i < Count; i++)
+  {
+    v = Values + i * PSYCHRO_GRAD_N_OUTPUTS;
+    J = (double (*)[PSYCHRO_GRAD_N_INPUTS]) (Jacobian + i * PSYCHRO_GRAD_N_OUTPUTS * PSYCHRO_GRAD_N_INPUTS);
+
+    ASSERT(TDewPoint[i] <= TDryBulb[i], "Dew point temperature is above dry bulb temperature")
+
+    v[0] = GradGetHumRatioFromTDewPoint(TDewPoint[i], Pressure[i], d);
+    J[0][0] = 0.;
+    J[0][1] = d[0];
+    J[0][2] = d[1];
+    v[1] = GradGetTWetBulbFromHumRatio(TDryBulb[i], v[0], Pressure[i], d);
+    Chain_(d, J[0], J[1]);
+    v[2] = GradGetRelHumFromHumRatio(TDryBulb[i], v[0], Pressure[i], d);
+    Chain_(d, J[0], J[2]);
+    CalcMoistAirProperties_(TDryBulb[i], v[0], Pressure[i], J[0], v + 3, J + 3);
+  }
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
+
+// Return the outputs of CalcPsychrometricsFromRelHum and their Jacobian for each point.
+void GradCalcPsychrometricsFromRelHum
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *RelHum        // (i) Relative humidity [0-1]
+  , const double *Pressure      // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *Values              // (o) HumRatio, TWetBulb, TDewPoint, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation
+  , double *Jacobian            // (o) Partial derivatives with respect to TDryBulb, RelHum and Pressure
+  )
+{
+  double (*J)[PSYCHRO_GRAD_N_INPUTS];
+  double *v, d[3];
+  size_t i;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  for (i = 0; i < Count; i++)
+  {
+    v = Values + i * PSYCHRO_GRAD_N_OUTPUTS;
+    J = (double (*)[PSYCHRO_GRAD_N_INPUTS]) (Jacobian + i * PSYCHRO_GRAD_N_OUTPUTS * PSYCHRO_GRAD_N_INPUTS);
+
+    ASSERT(RelHum[i] >= 0 && RelHum[i] <= 1, "Relative humidity is outside range [0,1]")
+
+    v[0] = GradGetHumRatioFromRelHum(TDryBulb[i], RelHum[i], Pressure[i], J[0]);
+    v[1] = GradGetTWetBulbFromHumRatio(TDryBulb[i], v[0], Pressure[i], d);
+    Chain_(d, J[0], J[1]);
+    v[2] = GradGetTDewPointFromHumRatio(TDryBulb[i], v[0], Pressure[i], d);
+    Chain_(d, J[0], J[2]);
+    CalcMoistAirProperties_(TDryBulb[i], v[0], Pressure[i], J[0], v + 3, J + 3);
+  }
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
@@ -0,0 +1,171 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Value and gradient functions: analytic partial derivatives with respect to the inputs.
+ * See psychrolib_gradient.c for details.
+*/
+
+#ifndef PSYCHROLIB_GRADIENT_H
+#define PSYCHROLIB_GRADIENT_H
+
+#include <stddef.h>
+
+// Size of the Jacobian block of each point of the batch functions: outputs x inputs
+#define PSYCHRO_GRAD_N_OUTPUTS 7
+#define PSYCHRO_GRAD_N_INPUTS 3
+
+
+/******************************************************************************************************
+ * Value and gradient functions
+ * Gradient[i] is the partial derivative of the returned value with respect to the i-th input,
+ * in the order of the inputs.
+ *****************************************************************************************************/
+
+double GradGetSatVapPres        // (o) Vapor Pressure of saturated air in Psi [IP] or Pa [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double Gradient[1]          // (o) Partial derivative with respect to TDryBulb
+  );
+
+double GradGetSatHumRatio       // (o) Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[2]          // (o) Partial derivatives with respect to TDryBulb and Pressure
+  );
+
+double GradGetHumRatioFromVapPres // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( double VapPres              // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[2]          // (o) Partial derivatives with respect to VapPres and Pressure
+  );
+
+double GradGetVapPresFromHumRatio // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  ( double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[2]          // (o) Partial derivatives with respect to HumRatio and Pressure
+  );
+
+double GradGetHumRatioFromRelHum // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double RelHum               // (i) Relative humidity [0-1]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, RelHum and Pressure
+  );
+
+double GradGetRelHumFromHumRatio // (o) Relative humidity [0-1]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, HumRatio and Pressure
+  );
+
+double GradGetHumRatioFromTWetBulb // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double TWetBulb             // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, TWetBulb and Pressure
+  );
+
+double GradGetTWetBulbFromHumRatio // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, HumRatio and Pressure
+  );
+
+double GradGetTWetBulbFromRelHum // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double RelHum               // (i) Relative humidity [0-1]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, RelHum and Pressure
+  );
+
+double GradGetHumRatioFromTDewPoint // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( double TDewPoint            // (i) Dew point temperature in °F [IP] or °C [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[2]          // (o) Partial derivatives with respect to TDewPoint and Pressure
+  );
+
+double GradGetTDewPointFromVapPres // (o) Dew point temperature in °F [IP] or °C [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double VapPres              // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double Gradient[2]          // (o) Partial derivatives with respect to TDryBulb and VapPres
+  );
+
+double GradGetTDewPointFromHumRatio // (o) Dew point temperature in °F [IP] or °C [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, HumRatio and Pressure
+  );
+
+double GradGetTDewPointFromRelHum // (o) Dew point temperature in °F [IP] or °C [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double RelHum               // (i) Relative humidity [0-1]
+  , double Gradient[2]          // (o) Partial derivatives with respect to TDryBulb and RelHum
+  );
+
+double GradGetMoistAirEnthalpy  // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Gradient[2]          // (o) Partial derivatives with respect to TDryBulb and HumRatio
+  );
+
+double GradGetMoistAirVolume    // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, HumRatio and Pressure
+  );
+
+double GradGetMoistAirDensity   // (o) Moist air density in lb ft⁻³ [IP] or kg m⁻³ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, HumRatio and Pressure
+  );
+
+double GradGetDegreeOfSaturation // (o) Degree of saturation [unitless]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double Gradient[3]          // (o) Partial derivatives with respect to TDryBulb, HumRatio and Pressure
+  );
+
+
+/******************************************************************************************************
+ * Batch functions with dense Jacobian blocks
+ * Values holds PSYCHRO_GRAD_N_OUTPUTS outputs per point, in the order of the outputs of the
+ * corresponding CalcPsychrometrics* function. Jacobian holds one row-major block of
+ * PSYCHRO_GRAD_N_OUTPUTS x PSYCHRO_GRAD_N_INPUTS partial derivatives per point: the derivatives
+ * of output i with respect to the three inputs are at Jacobian[(Point * 7 + i) * 3 + j].
+ *****************************************************************************************************/
+
+void GradCalcPsychrometricsFromTWetBulb
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *TWetBulb      // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , const double *Pressure      // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *Values              // (o) HumRatio, TDewPoint, RelHum, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation
+  , double *Jacobian            // (o) Partial derivatives with respect to TDryBulb, TWetBulb and Pressure
+  );
+
+void GradCalcPsychrometricsFromTDewPoint
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *TDewPoint     // (i) Dew point temperature in °F [IP] or °C [SI]
+  , const double *Pressure      // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *Values              // (o) HumRatio, TWetBulb, RelHum, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation
+  , double *Jacobian            // (o) Partial derivatives with respect to TDryBulb, TDewPoint and Pressure
+  );
+
+void GradCalcPsychrometricsFromRelHum
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *RelHum        // (i) Relative humidity [0-1]
+  , const double *Pressure      // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *Values              // (o) HumRatio, TWetBulb, TDewPoint, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation
+  , double *Jacobian            // (o) Partial derivatives with respect to TDryBulb, RelHum and Pressure
+  );
+
+#endif // PSYCHROLIB_GRADIENT_H
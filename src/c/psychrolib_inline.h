@@ -0,0 +1,254 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Header-only build of the C library, for callers that cannot use link-time optimization.
+ *
+ * With PSYCHROLIB_STATIC_INLINE defined, all the functions of psychrolib.c are defined static inline
+ * in the translation unit, so that the compiler can inline them in the loops of the caller and
+ * hoist the checks of the system of units out of the loops. Each translation unit then has its own
+ * copy of the library, and its own system of units: SetUnitSystem must be called in each of them.
+ * The loops over these functions are not vectorized, since the checks of the inputs may exit the
+ * program at any iteration, and the functions call log, exp and pow.
+ *
+ * Without PSYCHROLIB_STATIC_INLINE, the header declares the functions, and defines them in the
+ * translation unit where PSYCHROLIB_IMPLEMENTATION is defined, which replaces compiling psychrolib.c.
+ *
+ * With gcc and clang, the temperature conversions are declared const and GetUnitSystem pure, so
+ * that repeated calls with the same inputs can be merged. The other functions are not: they may
+ * exit the program on invalid inputs, and a pure or const call would be removed with its check
+ * when its result is unused.
+ *
+ * Check-free functions
+ *  With PSYCHROLIB_STATIC_INLINE, the header also defines Unchecked* variants of the closed-form
+ *  functions and of the dew-point temperature, for loops that the compiler can vectorize. They
+ *  return NaN instead of exiting when an input is invalid or the system of units is undefined,
+ *  have no call or branch, and compute log and exp with the kernels of psychrolib_kernels.h. The
+ *  dew-point temperature takes four Newton-Raphson steps from the estimate of the
+ *  bounded-latency functions of psychrolib_bounded.c, rather than iterating to PSYCHROLIB_TOLERANCE.
+ *  The results are within a few units in the last place of the generic functions, and the dew
+ *  point well within PSYCHROLIB_TOLERANCE of them. There is no variant of the wet-bulb temperature, whose
+ *  bisection has a number of steps that depends on the point: see psychrolib_lockstep.c.
+ *  gcc vectorizes the loops over them at -O3, or at -O2 from gcc 12 when the trip count is a constant
+ *  multiple of the vector width and the output does not alias the inputs, e.g. in blocks of 16
+ *  points written through a restrict pointer.
+ *
+ * psychrolib.c and psychrolib.h must be in the include path.
+ *
+ * Example
+ *  #define PSYCHROLIB_STATIC_INLINE
+ *  #include "psychrolib_inline.h"
+ *  SetUnitSystem(SI);
+ *  for (i = 0; i < n; i++)
+ *    MoistAirEnthalpy[i] = GetMoistAirEnthalpy(TDryBulb[i], HumRatio[i]);
+ *  for (i = 0; i < n; i++)
+ *    TDewPoint[i] = UncheckedGetTDewPointFromHumRatio(TDryBulb[i], HumRatio[i], Pressure[i]);
+*/
+
+#ifndef PSYCHROLIB_INLINE_H
+#define PSYCHROLIB_INLINE_H
+
+#if defined(__GNUC__)
+#define PSYCHROLIB_PURE __attribute__((pure))
+#define PSYCHROLIB_CONST __attribute__((const))
+#endif
+
+#if defined(PSYCHROLIB_STATIC_INLINE)
+#define PSYCHROLIB_API static inline
+#include "psychrolib.c"
+#include "psychrolib_kernels.h"
+#elif defined(PSYCHROLIB_IMPLEMENTATION)
+#include "psychrolib.c"
+#else
+#include "psychrolib.h"
+#endif
+
+
+/******************************************************************************************************
+ * Check-free functions
+ *****************************************************************************************************/
+
+#if defined(PSYCHROLIB_STATIC_INLINE)
+
+// Constants indexed by the system of units, NaN if it is undefined so that the results are NaN.
+// Indexed rather than selected, so that the loops have no branch on the system of units.
+static const struct PsychroKernelUnits UNCHECKED_UNITS_UNDEFINED =
+  { NAN, NAN, NAN, { NAN, NAN }, NAN, { 0. }, { 0. }, { 0. }, { 0. }, NAN, { NAN, NAN }, { NAN, NAN } };
+
+static const struct PsychroKernelUnits *const UNCHECKED_UNITS[] =
+  { &UNCHECKED_UNITS_UNDEFINED, &PSYCHRO_KERNEL_UNITS_IP, &PSYCHRO_KERNEL_UNITS_SI };
+
+// Enthalpy = (a * TDryBulb + HumRatio * (b + c * TDryBulb)) * Scale, with {a, b, c, Scale}
+static const double UNCHECKED_ENTHALPY[][4] =
+  { { NAN, NAN, NAN, NAN }, { 0.240, 1061., 0.444, 1. }, { 1.006, 2501., 1.86, 1000. } };
+
+// Volume = R * (TDryBulb + Offset) * (1 + 1.607858 * HumRatio) / (Scale * Pressure), with {R, Offset, Scale}
+static const double UNCHECKED_VOLUME[][3] =
+  { { NAN, NAN, NAN }, { R_DA_IP, ZERO_FAHRENHEIT_AS_RANKINE, 144. }, { R_DA_SI, ZERO_CELSIUS_AS_KELVIN, 1. } };
+
+// Saturation vapor pressure, NaN outside the range of the equations.
+// See GetSatVapPres.
+PSYCHRO_KERNEL_INLINE double UncheckedGetSatVapPres // (o) Vapor Pressure of saturated air in Psi [IP] or Pa [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  )
+{
+  const struct PsychroKernelUnits *Units = UNCHECKED_UNITS[PSYCHROLIB_UNITS];
+  int Valid = (TDryBulb >= Units->Bounds[0]) & (TDryBulb <= Units->Bounds[1]);
+  double SatVapPres = PsychroKernelExp(PsychroKernelLnPws(Units, TDryBulb, NULL));
+
+  return PsychroKernelValid(SatVapPres, Valid);
+}
+
+// Saturation humidity ratio, NaN outside the range of the equations.
+// See GetSatHumRatio.
+PSYCHRO_KERNEL_INLINE double UncheckedGetSatHumRatio // (o) Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  double SatVapPres = UncheckedGetSatVapPres(TDryBulb);
+  double SatHumRatio = max(0.621945 * SatVapPres / (Pressure - SatVapPres), MIN_HUM_RATIO);
+
+  return PsychroKernelValid(SatHumRatio, SatVapPres == SatVapPres);
+}
+
+// Humidity ratio from vapor pressure, NaN if the vapor pressure is negative.
+// See GetHumRatioFromVapPres.
+PSYCHRO_KERNEL_INLINE double UncheckedGetHumRatioFromVapPres // (o) Humidity Ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( double VapPres              // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  double HumRatio = max(0.621945 * VapPres / (Pressure - VapPres), MIN_HUM_RATIO);
+
+  return PsychroKernelValid(HumRatio, VapPres >= 0.);
+}
+
+// Vapor pressure from humidity ratio, NaN if the humidity ratio is negative.
+// See GetVapPresFromHumRatio.
+PSYCHRO_KERNEL_INLINE double UncheckedGetVapPresFromHumRatio // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  ( double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  double BoundedHumRatio = PsychroKernelSelectNegative(HumRatio - MIN_HUM_RATIO, MIN_HUM_RATIO, HumRatio);
+  double VapPres = Pressure * BoundedHumRatio / (0.621945 + BoundedHumRatio);
+
+  return PsychroKernelValid(VapPres, HumRatio >= 0.);
+}
+
+// Humidity ratio from relative humidity, NaN outside the range of the equations or if the
+// relative humidity is outside [0, 1].
+// See GetHumRatioFromRelHum.
+PSYCHRO_KERNEL_INLINE double UncheckedGetHumRatioFromRelHum // (o) Humidity Ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double RelHum               // (i) Relative humidity [0-1]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  double VapPres = RelHum * UncheckedGetSatVapPres(TDryBulb);
+  double HumRatio = max(0.621945 * VapPres / (Pressure - VapPres), MIN_HUM_RATIO);
+
+  return PsychroKernelValid(HumRatio, (RelHum >= 0.) & (RelHum <= 1.) & (VapPres == VapPres));
+}
+
+// Moist air enthalpy, NaN if the humidity ratio is negative.
+// See GetMoistAirEnthalpy.
+PSYCHRO_KERNEL_INLINE double UncheckedGetMoistAirEnthalpy // (o) Moist Air Enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  )
+{
+  const double *c = UNCHECKED_ENTHALPY[PSYCHROLIB_UNITS];
+  double BoundedHumRatio = PsychroKernelSelectNegative(HumRatio - MIN_HUM_RATIO, MIN_HUM_RATIO, HumRatio);
+  double Enthalpy = (c[0] * TDryBulb + BoundedHumRatio*(c[1] + c[2] * TDryBulb)) * c[3];
+
+  return PsychroKernelValid(Enthalpy, HumRatio >= 0.);
+}
+
+// Moist air specific volume, NaN if the humidity ratio is negative.
+// See GetMoistAirVolume.
+PSYCHRO_KERNEL_INLINE double UncheckedGetMoistAirVolume // (o) Specific Volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  const double *c = UNCHECKED_VOLUME[PSYCHROLIB_UNITS];
+  double BoundedHumRatio = PsychroKernelSelectNegative(HumRatio - MIN_HUM_RATIO, MIN_HUM_RATIO, HumRatio);
+  double Volume = c[0] * (TDryBulb + c[1]) * (1. + 1.607858 * BoundedHumRatio) / (c[2] * Pressure);
+
+  return PsychroKernelValid(Volume, HumRatio >= 0.);
+}
+
+// Temperature bounded by the domain of validity of eqn. 5 and 6
+PSYCHRO_KERNEL_INLINE double UncheckedClamp_
+  ( const struct PsychroKernelUnits *Units
+  , double T
+  )
+{
+  T = PsychroKernelSelectNegative(T - Units->Bounds[0], Units->Bounds[0], T);
+  return PsychroKernelSelectNegative(Units->Bounds[1] - T, Units->Bounds[1], T);
+}
+
+// Newton-Raphson step of the dew-point temperature, from a temperature bounded by the domain of validity
+// of eqn. 5 and 6
+PSYCHRO_KERNEL_INLINE double UncheckedNewtonStep_
+  ( const struct PsychroKernelUnits *Units
+  , double T
+  , double LnVapPres
+  )
+{
+  double dLnPws;
+
+  T = UncheckedClamp_(Units, T);
+  return T - (PsychroKernelLnPws(Units, T, &dLnPws) - LnVapPres) / dLnPws;
+}
+
+// Dew-point temperature from vapor pressure, NaN if the vapor pressure is outside the range of
+// the equations.
+// See GetTDewPointFromVapPres.
+PSYCHRO_KERNEL_INLINE double UncheckedGetTDewPointFromVapPres // (o) Dew Point temperature in °F [IP] or °C [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double VapPres              // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  )
+{
+  const struct PsychroKernelUnits *Units = UNCHECKED_UNITS[PSYCHROLIB_UNITS];
+  double LnVapPres, AboveTriplePoint, T;
+  int Valid;
+
+  LnVapPres = PsychroKernelLog(VapPres);
+  Valid = (VapPres > 0.)
+    & (LnVapPres >= PsychroKernelLnPws(Units, Units->Bounds[0], NULL))
+    & (LnVapPres <= PsychroKernelLnPws(Units, Units->Bounds[1], NULL));
+
+  // Initial estimate from ln(Pws) = a - b / T, then Newton-Raphson steps bounded by the domain
+  // of validity of eqn. 5 and 6
+  AboveTriplePoint = Units->LnPwsTriplePoint - LnVapPres;
+  T = PsychroKernelSelectNegative(AboveTriplePoint, Units->GuessLiquid[1], Units->GuessIce[1])
+    / (PsychroKernelSelectNegative(AboveTriplePoint, Units->GuessLiquid[0], Units->GuessIce[0]) - LnVapPres) - Units->Offset;
+  // Four steps, written out so that the loops over the function have no inner loop
+  T = UncheckedNewtonStep_(Units, T, LnVapPres);
+  T = UncheckedNewtonStep_(Units, T, LnVapPres);
+  T = UncheckedNewtonStep_(Units, T, LnVapPres);
+  T = UncheckedNewtonStep_(Units, T, LnVapPres);
+  T = UncheckedClamp_(Units, T);
+
+  return PsychroKernelValid(min(T, TDryBulb), Valid);
+}
+
+// Dew-point temperature from humidity ratio, NaN if the humidity ratio is negative or its vapor
+// pressure outside the range of the equations.
+// See GetTDewPointFromHumRatio.
+PSYCHRO_KERNEL_INLINE double UncheckedGetTDewPointFromHumRatio // (o) Dew Point temperature in °F [IP] or °C [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  return UncheckedGetTDewPointFromVapPres(TDryBulb, UncheckedGetVapPresFromHumRatio(HumRatio, Pressure));
+}
+
+#endif
+
+#endif // PSYCHROLIB_INLINE_H
@@ -0,0 +1,86 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Constants and helpers of psychrolib.c shared with the optional modules of the C library. Not part of the
+ * interface of the library: the modules include this header after psychrolib.h.
+*/
+
+#ifndef PSYCHROLIB_INTERNAL_H
+#define PSYCHROLIB_INTERNAL_H
+
+
+/******************************************************************************************************
+ * Global constants of psychrolib.c
+ *****************************************************************************************************/
+
+#define MAX_ITER_COUNT 100              // Maximum number of iterations before exiting while loops.
+
+#define MIN_HUM_RATIO 1e-7              // Minimum acceptable humidity ratio used/returned by any functions.
+                                        // Any value above 0 or below the MIN_HUM_RATIO will be reset to this value.
+
+#define FREEZING_POINT_WATER_IP 32.0    // Freezing point of water in Fahrenheit.
+
+#define FREEZING_POINT_WATER_SI 0.0     // Freezing point of water in Celsius.
+
+#define TRIPLE_POINT_WATER_IP 32.018    // Triple point of water in Fahrenheit.
+
+#define TRIPLE_POINT_WATER_SI 0.01      // Triple point of water in Celsius.
+
+// Coefficients of the moist air enthalpy, ASHRAE eqn. 30:
+// h = CP_DRY_AIR * TDryBulb + HumRatio * (H_VAPOR + CP_VAPOR * TDryBulb), in Btu lb⁻¹ [IP] or kJ kg⁻¹ [SI]
+
+#define CP_DRY_AIR_IP 0.240             // Specific heat of dry air in Btu lb⁻¹ °F⁻¹.
+
+#define CP_DRY_AIR_SI 1.006             // Specific heat of dry air in kJ kg⁻¹ K⁻¹.
+
+#define H_VAPOR_IP 1061.                // Enthalpy of water vapor at 0 °F in Btu lb⁻¹.
+
+#define H_VAPOR_SI 2501.                // Enthalpy of water vapor at 0 °C in kJ kg⁻¹.
+
+#define CP_VAPOR_IP 0.444               // Specific heat of water vapor in Btu lb⁻¹ °F⁻¹.
+
+#define CP_VAPOR_SI 1.86                // Specific heat of water vapor in kJ kg⁻¹ K⁻¹.
+
+
+/******************************************************************************************************
+ * Helper functions defined in psychrolib.c
+ *****************************************************************************************************/
+
+// Function called if an assertion fails. Prints the message and exits.
+PSYCHROLIB_API
+void Assert
+  ( char *Msg                   // (i) message to print to screen
+  , char *FileName              // (i) name of file in which error occurred
+  , int LineNo                  // (i) number of line in which error occurred
+  );
+
+// Check whether the system in use is IP or SI.
+// The function exits in error if the system of units is undefined
+PSYCHROLIB_API
+int isIP                        // (o) 1 if IP, 0 if SI, error otherwise
+  ( void
+  );
+
+// Derivative of the natural log of the saturation vapor pressure as a function of dry-bulb temperature.
+PSYCHROLIB_API
+double dLnPws_                  // (o) Derivative of natural log of vapor pressure of saturated air in Psi [IP] or Pa [SI]
+  ( double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  );
+
+#define ASSERT(condition, msg) \
+  if (! (condition)) \
+  { \
+    Assert(msg, __FILE__, __LINE__); \
+  }
+
+// Min and max macros (in case they are not defined)
+#ifndef min
+#define min(a,b)            (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifndef max
+#define max(a,b)            (((a) > (b)) ? (a) : (b))
+#endif
+
+#endif // PSYCHROLIB_INTERNAL_H
@@ -0,0 +1,351 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Inverse functions: dry-bulb temperature from the relative humidity and the enthalpy, the wet-bulb
+ *  temperature or the specific volume, the pairs of properties measured by enthalpy sensors,
+ *  psychrometers and flow stations.
+ *
+ *  The generic library calculates the dry-bulb temperature from the enthalpy or the specific volume
+ *  and the humidity ratio in closed form, but the humidity ratio at a relative humidity depends on
+ *  the dry-bulb temperature through the saturation vapor pressure. Wrapping a root finder around
+ *  CalcPsychrometricsFromRelHum evaluates all the properties, including the wet-bulb temperature
+ *  and its own bisection, at each step of the outer loop. The functions of this module solve for
+ *  the dry-bulb temperature with Newton iterations on the residual of the one property involved,
+ *  with the analytic derivative of the humidity ratio at constant relative humidity:
+ *
+ *   dW/dT = 0.621945 P Pw / (P - Pw)² dln(Pws)/dT,  Pw = RelHum Pws(T)
+ *
+ *  The enthalpy and the specific volume are convex and increasing in the dry-bulb temperature at
+ *  constant relative humidity, and the dry-bulb temperature of dry air of the same enthalpy or
+ *  specific volume is above the solution: Newton iterations from it converge monotonically, in
+ *  typically 3 to 6 iterations. For the wet-bulb temperature, the saturation humidity ratio at the
+ *  wet-bulb temperature is calculated once, and the iterations solve for the dry-bulb temperature at
+ *  which the humidity ratio of the psychrometer equation (ASHRAE Handbook - Fundamentals (2017)
+ *  ch. 1 eqn 33 and 35, as in GetHumRatioFromTWetBulb) equals the humidity ratio at the relative
+ *  humidity, between the wet-bulb temperature (saturated air) and the temperature at which the
+ *  psychrometer equation gives dry air. The iterations keep a bracket of the solution and bisect
+ *  when a Newton step leaves it, e.g. where the vapor pressure at the relative humidity would
+ *  exceed the atmospheric pressure.
+ *
+ *  The solutions are converged to 1e-9 °F [IP] or °C [SI], so that the forward functions
+ *  (GetMoistAirEnthalpy, GetMoistAirVolume and GetHumRatioFromTWetBulb with GetHumRatioFromRelHum)
+ *  reproduce the inputs to rounding. Inputs without solution in the range of the equations of the
+ *  saturation vapor pressure stop the program, as in the generic functions. The batch functions
+ *  evaluate the scalar functions on arrays.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_inverse.h"
+ *  SetUnitSystem(SI);
+ *  double TDryBulb = GetTDryBulbFromEnthalpyAndRelHum(50000., 0.5, 101325.);
+ *  GetTDryBulbFromTWetBulbAndRelHumBatch(Count, TWetBulb, RelHum, Pressure, TDryBulbs);
+ */
+
+// Standard C header files
+#include <math.h>
+#include <stddef.h>
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_kernels.h"
+#include "psychrolib_inverse.h"
+#include "psychrolib_trace.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define R_DA_IP 53.350                  // Universal gas constant for dry air (IP version) in ft∙lbf/lb_da/R.
+                                        // Same as in psychrolib.c
+
+#define R_DA_SI 287.042                 // Universal gas constant for dry air (SI version) in J/kg_da/K.
+                                        // Same as in psychrolib.c
+
+#define INVERSE_TOLERANCE 1e-9          // Tolerance of the dry-bulb temperature in °F [IP] or °C [SI].
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+// Property solved for, with its target value and the constants of its residual
+enum InverseKind_ { ENTHALPY_, TWET_BULB_, VOLUME_ };
+
+struct Inverse_
+{
+  enum InverseKind_ Kind;
+  double Target;                        // Enthalpy or specific volume
+  double RelHum;
+  double Pressure;
+  double TWetBulb;
+  double A, B, C1, C2;                  // Psychrometer equation: W = (A - C1 (T - TWetBulb)) / (B + C2 T)
+};
+
+// Domain of validity of the equations of the saturation vapor pressure
+static void Bounds_
+  ( double *Lower
+  , double *Upper
+  )
+{
+  *Lower = isIP() ? -148. : -100.;
+  *Upper = isIP() ? 392. : 200.;
+}
+
+// Humidity ratio at the relative humidity and its derivative with respect to the dry-bulb
+// temperature; infinite where the vapor pressure would reach the atmospheric pressure
+static double HumRatio_
+  ( double TDryBulb
+  , double RelHum
+  , double Pressure
+  , double *dHumRatio
+  )
+{
+  double VapPres = RelHum * GetSatVapPres(TDryBulb), HumRatio;
+
+  if (VapPres >= Pressure)
+  {
+    *dHumRatio = 0.;
+    return HUGE_VAL;
+  }
+  HumRatio = 0.621945 * VapPres / (Pressure - VapPres);
+  if (HumRatio < MIN_HUM_RATIO)
+  {
+    *dHumRatio = 0.;
+    return MIN_HUM_RATIO;
+  }
+  *dHumRatio = 0.621945 * Pressure * VapPres * dLnPws_(TDryBulb) / ((Pressure - VapPres) * (Pressure - VapPres));
+  return HumRatio;
+}
+
+// Residual of the property solved for, increasing in the dry-bulb temperature, and its derivative
+static double Residual_
+  ( const struct Inverse_ *Inverse
+  , double T
+  , double *dResidual
+  )
+{
+  double W, dW, N, D, WetBulbHumRatio, TAbsolute, K;
+
+  W = HumRatio_(T, Inverse->RelHum, Inverse->Pressure, &dW);
+  if (W == HUGE_VAL)
+  {
+    *dResidual = 0.;
+    return HUGE_VAL;
+  }
+
+  switch (Inverse->Kind)
+  {
+  case ENTHALPY_:
+    if (isIP())
+      *dResidual = CP_DRY_AIR_IP + CP_VAPOR_IP * W + (H_VAPOR_IP + CP_VAPOR_IP * T) * dW;
+    else
+      *dResidual = (CP_DRY_AIR_SI + CP_VAPOR_SI * W + (H_VAPOR_SI + CP_VAPOR_SI * T) * dW) * 1000.;
+    return GetMoistAirEnthalpy(T, W) - Inverse->Target;
+
+  case VOLUME_:
+    TAbsolute = isIP() ? GetTRankineFromTFahrenheit(T) : GetTKelvinFromTCelsius(T);
+    K = isIP() ? R_DA_IP / (144. * Inverse->Pressure) : R_DA_SI / Inverse->Pressure;
+    *dResidual = K * (1. + 1.607858 * W + TAbsolute * 1.607858 * dW);
+    return K * TAbsolute * (1. + 1.607858 * W) - Inverse->Target;
+
+  case TWET_BULB_:
+  default:
+    N = Inverse->A - Inverse->C1 * (T - Inverse->TWetBulb);
+    D = Inverse->B + Inverse->C2 * T;
+    WetBulbHumRatio = N / D;
+    if (WetBulbHumRatio < MIN_HUM_RATIO)
+    {
+      *dResidual = dW;
+      return W - MIN_HUM_RATIO;
+    }
+    *dResidual = dW + (Inverse->C1 * D + Inverse->C2 * N) / (D * D);
+    return W - WetBulbHumRatio;
+  }
+}
+
+// Safeguarded Newton iterations on the residual within a bracket of the solution
+static double Solve_
+  ( const struct Inverse_ *Inverse
+  , double Lower                        // Dry-bulb temperature with a residual not above zero
+  , double Upper                        // Dry-bulb temperature with a residual not below zero
+  , double T                            // Initial guess within the bracket
+  , const char *Msg                     // Message if there is no solution within the range of the equations
+  )
+{
+  double BoundLower, BoundUpper, f, df, TNext;
+  int index = 1;
+
+  Bounds_(&BoundLower, &BoundUpper);
+  for (;;)
+  {
+    f = Residual_(Inverse, T, &df);
+    if (f > 0.)
+      Upper = T;
+    else if (f < 0.)
+      Lower = T;
+    else
+      return T;
+
+    // Newton step, or bisection if the step leaves the bracket
+    TNext = (f != HUGE_VAL && df > 0.) ? T - f / df : Upper;
+    if (!(TNext > Lower && TNext < Upper))
+      TNext = 0.5 * (Lower + Upper);
+    if (fabs(TNext - T) <= INVERSE_TOLERANCE || Upper - Lower <= INVERSE_TOLERANCE)
+      break;
+    T = TNext;
+
+    ASSERT (index <= MAX_ITER_COUNT, "Convergence not reached in the inverse functions. Stopping.")
+    index++;
+  }
+
+  // A solution at the end of the range of the equations is not a solution
+  ASSERT (TNext > BoundLower + 2. * INVERSE_TOLERANCE && TNext < BoundUpper - 2. * INVERSE_TOLERANCE, (char *) Msg)
+  return TNext;
+}
+
+
+/******************************************************************************************************
+ * Scalar functions
+ *****************************************************************************************************/
+
+// Return dry-bulb temperature given moist air enthalpy, relative humidity and pressure.
+double GetTDryBulbFromEnthalpyAndRelHum // (o) Dry bulb temperature in °F [IP] or °C [SI]
+  ( double MoistAirEnthalpy             // (i) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , double RelHum                       // (i) Relative humidity [0-1]
+  , double Pressure                     // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  struct Inverse_ Inverse;
+  double Lower, Upper;
+
+  ASSERT (RelHum >= 0. && RelHum <= 1., "Relative humidity is outside range [0, 1]")
+  ASSERT (Pressure > 0., "Pressure is not positive")
+  Inverse.Kind = ENTHALPY_;
+  Inverse.Target = MoistAirEnthalpy;
+  Inverse.RelHum = RelHum;
+  Inverse.Pressure = Pressure;
+
+  // Above the solution: dry air of the same enthalpy
+  Bounds_(&Lower, &Upper);
+  Upper = min(Upper, GetTDryBulbFromEnthalpyAndHumRatio(MoistAirEnthalpy, 0.));
+  ASSERT (Upper > Lower, "Enthalpy is outside the range of the equations")
+  return Solve_(&Inverse, Lower, Upper, Upper, "Enthalpy is outside the range of the equations");
+}
+
+// Return dry-bulb temperature given wet-bulb temperature, relative humidity and pressure.
+double GetTDryBulbFromTWetBulbAndRelHum // (o) Dry bulb temperature in °F [IP] or °C [SI]
+  ( double TWetBulb                     // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , double RelHum                       // (i) Relative humidity [0-1]
+  , double Pressure                     // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  const struct PsychroKernelUnits *Units = isIP() ? &PSYCHRO_KERNEL_UNITS_IP : &PSYCHRO_KERNEL_UNITS_SI;
+  struct Inverse_ Inverse;
+  const double *k;
+  double Wsstar, Lower, Upper;
+
+  ASSERT (RelHum >= 0. && RelHum <= 1., "Relative humidity is outside range [0, 1]")
+  ASSERT (Pressure > 0., "Pressure is not positive")
+  Inverse.Kind = TWET_BULB_;
+  Inverse.RelHum = RelHum;
+  Inverse.Pressure = Pressure;
+  Inverse.TWetBulb = TWetBulb;
+
+  // Constants of the psychrometer equation, from the A, B, C, D and E of ASHRAE eqn. 33 or 35
+  // as in GetHumRatioFromTWetBulb
+  Wsstar = GetSatHumRatio(TWetBulb, Pressure);
+  k = TWetBulb >= Units->FreezingPoint ? Units->WetBulbLiquid : Units->WetBulbIce;
+  Inverse.A = (k[0] - k[1] * TWetBulb) * Wsstar;
+  Inverse.B = k[0] - k[4] * TWetBulb;
+  Inverse.C1 = k[2];
+  Inverse.C2 = k[3];
+
+  // Between saturated air at the wet-bulb temperature and dry air of the psychrometer equation
+  Bounds_(&Lower, &Upper);
+  Upper = min(Upper, TWetBulb + Inverse.A / Inverse.C1);
+  Lower = TWetBulb;
+  if (Upper - Lower <= INVERSE_TOLERANCE)
+    return TWetBulb;
+  return Solve_(&Inverse, Lower, Upper, Lower, "Wet bulb temperature is outside the range of the equations");
+}
+
+// Return dry-bulb temperature given moist air specific volume, relative humidity and pressure.
+double GetTDryBulbFromMoistAirVolumeAndRelHum // (o) Dry bulb temperature in °F [IP] or °C [SI]
+  ( double MoistAirVolume               // (i) Specific volume of moist air in ft³ lb⁻¹ of dry air [IP] or in m³ kg⁻¹ of dry air [SI]
+  , double RelHum                       // (i) Relative humidity [0-1]
+  , double Pressure                     // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  struct Inverse_ Inverse;
+  double Lower, Upper;
+
+  ASSERT (RelHum >= 0. && RelHum <= 1., "Relative humidity is outside range [0, 1]")
+  ASSERT (Pressure > 0., "Pressure is not positive")
+  Inverse.Kind = VOLUME_;
+  Inverse.Target = MoistAirVolume;
+  Inverse.RelHum = RelHum;
+  Inverse.Pressure = Pressure;
+
+  // Above the solution: dry air of the same specific volume
+  Bounds_(&Lower, &Upper);
+  Upper = min(Upper, GetTDryBulbFromMoistAirVolumeAndHumRatio(MoistAirVolume, 0., Pressure));
+  ASSERT (Upper > Lower, "Specific volume is outside the range of the equations")
+  return Solve_(&Inverse, Lower, Upper, Upper, "Specific volume is outside the range of the equations");
+}
+
+
+/******************************************************************************************************
+ * Batch functions
+ *****************************************************************************************************/
+
+void GetTDryBulbFromEnthalpyAndRelHumBatch
+  ( size_t Count                        // (i) Number of points
+  , const double *MoistAirEnthalpy      // (i) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , const double *RelHum                // (i) Relative humidity [0-1]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *TDryBulb                    // (o) Dry bulb temperature in °F [IP] or °C [SI]
+  )
+{
+  size_t i;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  for (i = 0; i < Count; i++)
+    TDryBulb[i] = GetTDryBulbFromEnthalpyAndRelHum(MoistAirEnthalpy[i], RelHum[i], Pressure[i]);
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
+
+void GetTDryBulbFromTWetBulbAndRelHumBatch
+  ( size_t Count                        // (i) Number of points
+  , const double *TWetBulb              // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , const double *RelHum                // (i) Relative humidity [0-1]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *TDryBulb                    // (o) Dry bulb temperature in °F [IP] or °C [SI]
+  )
+{
+  size_t i;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  for (i = 0; i < Count; i++)
+    TDryBulb[i] = GetTDryBulbFromTWetBulbAndRelHum(TWetBulb[i], RelHum[i], Pressure[i]);
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
+
+void GetTDryBulbFromMoistAirVolumeAndRelHumBatch
+  ( size_t Count                        // (i) Number of points
+  , const double *MoistAirVolume        // (i) Specific volume of moist air in ft³ lb⁻¹ of dry air [IP] or in m³ kg⁻¹ of dry air [SI]
+  , const double *RelHum                // (i) Relative humidity [0-1]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *TDryBulb                    // (o) Dry bulb temperature in °F [IP] or °C [SI]
+  )
+{
+  size_t i;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  for (i = 0; i < Count; i++)
+    TDryBulb[i] = GetTDryBulbFromMoistAirVolumeAndRelHum(MoistAirVolume[i], RelHum[i], Pressure[i]);
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
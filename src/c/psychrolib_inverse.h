@@ -0,0 +1,67 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Inverse functions: dry-bulb temperature from the relative humidity and the enthalpy, the wet-bulb
+ * temperature or the specific volume, in scalar and batch form.
+ * See psychrolib_inverse.c for details.
+*/
+
+#ifndef PSYCHROLIB_INVERSE_H
+#define PSYCHROLIB_INVERSE_H
+
+#include <stddef.h>
+
+
+/******************************************************************************************************
+ * Scalar functions
+ *****************************************************************************************************/
+
+double GetTDryBulbFromEnthalpyAndRelHum // (o) Dry bulb temperature in °F [IP] or °C [SI]
+  ( double MoistAirEnthalpy             // (i) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , double RelHum                       // (i) Relative humidity [0-1]
+  , double Pressure                     // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+double GetTDryBulbFromTWetBulbAndRelHum // (o) Dry bulb temperature in °F [IP] or °C [SI]
+  ( double TWetBulb                     // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , double RelHum                       // (i) Relative humidity [0-1]
+  , double Pressure                     // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+double GetTDryBulbFromMoistAirVolumeAndRelHum // (o) Dry bulb temperature in °F [IP] or °C [SI]
+  ( double MoistAirVolume               // (i) Specific volume of moist air in ft³ lb⁻¹ of dry air [IP] or in m³ kg⁻¹ of dry air [SI]
+  , double RelHum                       // (i) Relative humidity [0-1]
+  , double Pressure                     // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+
+/******************************************************************************************************
+ * Batch functions
+ *****************************************************************************************************/
+
+void GetTDryBulbFromEnthalpyAndRelHumBatch
+  ( size_t Count                        // (i) Number of points
+  , const double *MoistAirEnthalpy      // (i) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , const double *RelHum                // (i) Relative humidity [0-1]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *TDryBulb                    // (o) Dry bulb temperature in °F [IP] or °C [SI]
+  );
+
+void GetTDryBulbFromTWetBulbAndRelHumBatch
+  ( size_t Count                        // (i) Number of points
+  , const double *TWetBulb              // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , const double *RelHum                // (i) Relative humidity [0-1]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *TDryBulb                    // (o) Dry bulb temperature in °F [IP] or °C [SI]
+  );
+
+void GetTDryBulbFromMoistAirVolumeAndRelHumBatch
+  ( size_t Count                        // (i) Number of points
+  , const double *MoistAirVolume        // (i) Specific volume of moist air in ft³ lb⁻¹ of dry air [IP] or in m³ kg⁻¹ of dry air [SI]
+  , const double *RelHum                // (i) Relative humidity [0-1]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *TDryBulb                    // (o) Dry bulb temperature in °F [IP] or °C [SI]
+  );
+
+#endif // PSYCHROLIB_INVERSE_H
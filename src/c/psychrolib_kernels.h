@@ -0,0 +1,197 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors for the current library implementation.
+ * Copyright (c) 2017 ASHRAE Handbook — Fundamentals for ASHRAE equations and coefficients.
+ * Licensed under the MIT License.
+ *
+ * Branch-free kernels of the C library: the coefficients of the ASHRAE equations of the saturation
+ * vapor pressure and of the wet-bulb temperature in each system of units, and natural logarithm,
+ * exponential and ln(Pws) functions without call or branch, so that the compiler can vectorize the
+ * loops that call them. Shared by psychrolib_inline.h and the optional modules of the C library; not
+ * part of the interface of the library.
+ *
+ * PsychroKernelLog and PsychroKernelExp are within 2 units in the last place of log and exp of the C
+ * library, for positive normal arguments and normal results; they return meaningless values
+ * otherwise, and the callers select NaN for them.
+*/
+
+#ifndef PSYCHROLIB_KERNELS_H
+#define PSYCHROLIB_KERNELS_H
+
+// Standard C header files
+#include <stdint.h>
+#include <string.h>
+
+
+/******************************************************************************************************
+ * Coefficients of the equations
+ *****************************************************************************************************/
+
+// Constants of a system of units.
+// ln(Pws) = c[0] / T + c[1] + c[2] * T + c[3] * T² + c[4] * T³ + c[5] * T⁴ + c[6] * ln(T), T absolute (ASHRAE eqn. 5 and 6)
+// HumRatio = ((A - B * TWetBulb) * Wsstar - C * (TDryBulb - TWetBulb)) / (A + D * TDryBulb - E * TWetBulb) (ASHRAE eqn. 33 and 35)
+struct PsychroKernelUnits
+{
+  double Offset;                        // Absolute temperature of 0 °F [IP] or °C [SI]
+  double TriplePoint;
+  double FreezingPoint;
+  double Bounds[2];                     // Domain of validity of eqn. 5 and 6
+  double Tolerance;                     // Tolerance of the generic functions
+  double Ice[7];                        // Coefficients of eqn. 5, at or below the triple point
+  double Liquid[7];                     // Coefficients of eqn. 6, above the triple point
+  double WetBulbIce[5];                 // A, B, C, D and E of eqn. 35, below the freezing point
+  double WetBulbLiquid[5];              // A, B, C, D and E of eqn. 33, at or above the freezing point
+  double LnPwsTriplePoint;              // ln(Pws) at the triple point
+  double GuessIce[2];                   // Initial estimate of the dew point: ln(Pws) = a - b / T, with {a, b}
+  double GuessLiquid[2];
+};
+
+static const struct PsychroKernelUnits PSYCHRO_KERNEL_UNITS_IP =
+  { 459.67, 32.018, 32.0, { -148., 392. }, 0.001 * 9. / 5.
+  , { -1.0214165E+04, -4.8932428, -5.3765794E-03, 1.9202377E-07, 3.5575832E-10, -9.0344688E-14, 4.1635019 }
+  , { -1.0440397E+04, -1.1294650E+01, -2.7022355E-02, 1.2890360E-05, -2.4780681E-09, 0., 6.5459673 }
+  , { 1220., 0.04, 0.240, 0.444, 0.48 }
+  , { 1093., 0.556, 0.240, 0.444, 1. }
+  , -2.422345646293131, { 20.05688635, 11052.76862 }, { 16.12810087, 9121.031946 }
+  };
+
+static const struct PsychroKernelUnits PSYCHRO_KERNEL_UNITS_SI =
+  { 273.15, 0.01, 0.0, { -100., 200. }, 0.001
+  , { -5.6745359E+03, 6.3925247, -9.677843E-03, 6.2215701E-07, 2.0747825E-09, -9.484024E-13, 4.1635019 }
+  , { -5.8002206E+03, 1.3914993, -4.8640239E-02, 4.1764768E-05, -1.4452093E-08, 0., 6.5459673 }
+  , { 2830., 0.24, 1.006, 1.86, 2.1 }
+  , { 2501., 2.326, 1.006, 1.86, 4.186 }
+  , 6.4161717077576874, { 28.89540292, 6140.426798 }, { 24.96661808, 5067.239931 }
+  };
+
+
+/******************************************************************************************************
+ * Kernels
+ *****************************************************************************************************/
+
+// Always inlined with gcc and clang, so that the loops that call the kernels can be vectorized
+#if defined(__GNUC__)
+#define PSYCHRO_KERNEL_INLINE static inline __attribute__((always_inline))
+#else
+#define PSYCHRO_KERNEL_INLINE static inline
+#endif
+
+// ln(2) = PSYCHRO_KERNEL_LN2_HI + PSYCHRO_KERNEL_LN2_LO, with the last bits of the first zero so that k * PSYCHRO_KERNEL_LN2_HI is exact
+#define PSYCHRO_KERNEL_LN2_HI 6.93147180369123816490e-01
+#define PSYCHRO_KERNEL_LN2_LO 1.90821492927058770002e-10
+#define PSYCHRO_KERNEL_INV_LN2 1.44269504088896338700e+00
+#define PSYCHRO_KERNEL_SQRT2 1.41421356237309504880
+#define PSYCHRO_KERNEL_EXPONENT_OFFSET 0x4330000000000000ULL // Bits of 2^52, whose last bits hold an integer added to it
+#define PSYCHRO_KERNEL_ROUND_SHIFT 6755399441055744. // 1.5 * 2^52, which rounds a double to an integer when added to it
+#define PSYCHRO_KERNEL_ROUND_SHIFT_BITS 0x4338000000000000ULL
+#define PSYCHRO_KERNEL_MANTISSA_MASK 0x000fffffffffffffULL
+#define PSYCHRO_KERNEL_NAN_BITS 0x7ff8000000000000ULL // Bits of a quiet NaN, which make any double a NaN when or-ed into it
+#define PSYCHRO_KERNEL_ONE_BITS 0x3ff0000000000000ULL // Bits of 1.0
+
+// x if Valid, NaN otherwise. Set with integer operations: the compiler would move the computation of a
+// selected x under a branch, and does not vectorize a loop with floating-point operations under a branch.
+PSYCHRO_KERNEL_INLINE double PsychroKernelValid
+  ( double x
+  , int Valid
+  )
+{
+  uint64_t Bits;
+
+  memcpy(&Bits, &x, sizeof Bits);
+  Bits |= Valid ? 0 : PSYCHRO_KERNEL_NAN_BITS;
+  memcpy(&x, &Bits, sizeof x);
+  return x;
+}
+
+// a if the sign bit of x is set, b otherwise. Selected with integer operations on a mask taken from the
+// sign bit, for the same reason, and so that the loads of a and b are unconditional.
+PSYCHRO_KERNEL_INLINE double PsychroKernelSelectNegative
+  ( double x
+  , double a
+  , double b
+  )
+{
+  uint64_t Mask, aBits, bBits;
+
+  memcpy(&Mask, &x, sizeof Mask);
+  Mask = (uint64_t)0 - (Mask >> 63);
+  memcpy(&aBits, &a, sizeof aBits);
+  memcpy(&bBits, &b, sizeof bBits);
+  aBits = (aBits & Mask) | (bBits & ~Mask);
+  memcpy(&a, &aBits, sizeof a);
+  return a;
+}
+
+// Natural logarithm of positive normal numbers, as Log_ of psychrolib_bounded.c without branches.
+// x = 2^k * m with m in [sqrt(2)/2, sqrt(2)), and ln(m) = 2 * atanh(s) with s = (m - 1) / (m + 1).
+PSYCHRO_KERNEL_INLINE double PsychroKernelLog
+  ( double x
+  )
+{
+  uint64_t Bits, ExponentBits;
+  double m, k, s, s2, Sum;
+
+  memcpy(&Bits, &x, sizeof Bits);
+  ExponentBits = PSYCHRO_KERNEL_EXPONENT_OFFSET | (Bits >> 52);
+  Bits = (Bits & PSYCHRO_KERNEL_MANTISSA_MASK) | PSYCHRO_KERNEL_ONE_BITS;
+  memcpy(&k, &ExponentBits, sizeof k);
+  memcpy(&m, &Bits, sizeof m);
+
+  k -= 4503599627370496. + 1023.;
+  k += PsychroKernelSelectNegative(PSYCHRO_KERNEL_SQRT2 - m, 1., 0.);
+  m *= PsychroKernelSelectNegative(PSYCHRO_KERNEL_SQRT2 - m, 0.5, 1.);
+  s = (m - 1.) / (m + 1.);
+  s2 = s * s;
+  Sum = s2 * (1. / 3 + s2 * (1. / 5 + s2 * (1. / 7 + s2 * (1. / 9 + s2 * (1. / 11 + s2 * (1. / 13
+      + s2 * (1. / 15 + s2 * (1. / 17 + s2 * (1. / 19 + s2 * (1. / 21))))))))));
+  return k * PSYCHRO_KERNEL_LN2_HI + (2. * s * (1. + Sum) + k * PSYCHRO_KERNEL_LN2_LO);
+}
+
+// Exponential function of arguments of normal results, as Exp_ of psychrolib_bounded.c without branches.
+// exp(x) = 2^k * exp(r) with r = x - k * ln(2) in [-ln(2)/2, ln(2)/2].
+PSYCHRO_KERNEL_INLINE double PsychroKernelExp
+  ( double x
+  )
+{
+  uint64_t Bits;
+  double Shifted, Scale, Sum, k, r;
+
+  Shifted = x * PSYCHRO_KERNEL_INV_LN2 + PSYCHRO_KERNEL_ROUND_SHIFT;
+  k = Shifted - PSYCHRO_KERNEL_ROUND_SHIFT;
+  r = (x - k * PSYCHRO_KERNEL_LN2_HI) - k * PSYCHRO_KERNEL_LN2_LO;
+  Sum = 1. + r * (1. + r * (1. / 2 + r * (1. / 6 + r * (1. / 24 + r * (1. / 120 + r * (1. / 720
+      + r * (1. / 5040 + r * (1. / 40320 + r * (1. / 362880 + r * (1. / 3628800 + r * (1. / 39916800
+      + r * (1. / 479001600 + r * (1. / 6227020800.)))))))))))));
+  memcpy(&Bits, &Shifted, sizeof Bits);
+  Bits = (Bits - PSYCHRO_KERNEL_ROUND_SHIFT_BITS + 1023) << 52;
+  memcpy(&Scale, &Bits, sizeof Scale);
+  return Sum * Scale;
+}
+
+// ln(Pws) from ASHRAE eqn. 5 or 6, selected at the triple point, and its derivative if dLnPws
+// is not NULL. TDryBulb must be within the domain of validity of the equations.
+PSYCHRO_KERNEL_INLINE double PsychroKernelLnPws
+  ( const struct PsychroKernelUnits *Units
+  , double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double *dLnPws              // (o) Derivative in °F⁻¹ [IP] or K⁻¹ [SI], may be NULL
+  )
+{
+  double c[7], AboveTriplePoint, T, Inv;
+
+  // Coefficients of eqn. 6 above the triple point, of eqn. 5 otherwise
+  AboveTriplePoint = Units->TriplePoint - TDryBulb;
+  c[0] = PsychroKernelSelectNegative(AboveTriplePoint, Units->Liquid[0], Units->Ice[0]);
+  c[1] = PsychroKernelSelectNegative(AboveTriplePoint, Units->Liquid[1], Units->Ice[1]);
+  c[2] = PsychroKernelSelectNegative(AboveTriplePoint, Units->Liquid[2], Units->Ice[2]);
+  c[3] = PsychroKernelSelectNegative(AboveTriplePoint, Units->Liquid[3], Units->Ice[3]);
+  c[4] = PsychroKernelSelectNegative(AboveTriplePoint, Units->Liquid[4], Units->Ice[4]);
+  c[5] = PsychroKernelSelectNegative(AboveTriplePoint, Units->Liquid[5], Units->Ice[5]);
+  c[6] = PsychroKernelSelectNegative(AboveTriplePoint, Units->Liquid[6], Units->Ice[6]);
+  T = TDryBulb + Units->Offset;
+  Inv = 1. / T;
+  if (dLnPws != NULL)
+    *dLnPws = -c[0] * Inv * Inv + c[2] + T * (2. * c[3] + T * (3. * c[4] + T * 4. * c[5])) + c[6] * Inv;
+  return c[0] * Inv + c[1] + T * (c[2] + T * (c[3] + T * (c[4] + T * c[5]))) + c[6] * PsychroKernelLog(T);
+}
+
+#endif // PSYCHROLIB_KERNELS_H
@@ -0,0 +1,387 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Lock-step solvers: the dew-point and wet-bulb temperatures of a batch of points, with the
+ *  iterations of PSYCHRO_LOCKSTEP_LANES points advanced together.
+ *
+ *  GetTDewPointFromVapPres and GetTWetBulbFromHumRatio iterate on one point at a time, with a
+ *  number of iterations that depends on the point, and call log, exp and pow, so that the compiler
+ *  cannot vectorize a loop over them. Here each point of the batch is assigned to a lane, which
+ *  holds its own iterate, bracket and phase, and one iteration updates all the lanes with the same
+ *  straight-line code:
+ *   - ln(Pws) and its derivative are evaluated on all the lanes, with the coefficients of ASHRAE
+ *     eqn. 5 or 6 selected per lane, and log and exp computed by the branch-free series of
+ *     psychrolib_kernels.h in the lanes;
+ *   - the dew point takes a Newton-Raphson step on ln(Pws) as in GetTDewPointFromVapPres, from the
+ *     dry-bulb temperature, bounded by the domain of validity of the equations;
+ *   - the wet bulb first solves for the dew point as above, then bisects between the dew-point and
+ *     dry-bulb temperatures as in GetTWetBulbFromHumRatio, the humidity ratio from ASHRAE eqn. 33
+ *     or 35 being selected per lane at the freezing point;
+ *   - the lanes that are idle, or in the other phase, are masked by selects rather than branches.
+ *  After each iteration, the lanes that have converged write their result and are refilled with
+ *  the next points of the batch, so that the lanes stay busy until the batch is exhausted
+ *  whatever the number of iterations of each point. The number of lock-step iterations is
+ *  returned: at least the number of points divided by PSYCHRO_LOCKSTEP_LANES times the average
+ *  number of iterations per point, and more only while the last lanes drain.
+ *
+ *  The lanes are arrays of PSYCHRO_LOCKSTEP_LANES doubles, and the loops over them have a fixed
+ *  trip count and no call or branch, so that the compiler maps them to its vector registers:
+ *  2 doubles per instruction with SSE2, 4 with AVX2 (-mavx2 -mfma or -march=native) and 8 with
+ *  AVX-512 (-mavx512f), several registers per iteration when the lanes are more than that. The
+ *  loops are vectorized by gcc at -O3, or at -O2 from gcc 12; other compilers run them as scalar
+ *  loops with the same results. PSYCHRO_LOCKSTEP_LANES is 8 by default, and may be defined to 4
+ *  or 16 at compile time.
+ *
+ *  The results are within PSYCHROLIB_TOLERANCE of the generic functions: the bundled log and exp
+ *  are within 2 units in the last place of those of the C library, the solvers stop on the same
+ *  criteria, and the inputs are checked as in the generic functions.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_lockstep.h"
+ *  SetUnitSystem(SI);
+ *  LockstepGetTWetBulbFromHumRatio(Count, TDryBulb, HumRatio, Pressure, TWetBulb);
+ */
+
+// Standard C header files
+#include <math.h>
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_kernels.h"
+#include "psychrolib_lockstep.h"
+#include "psychrolib_trace.h"
+
+#if PSYCHRO_LOCKSTEP_LANES != 4 && PSYCHRO_LOCKSTEP_LANES != 8 && PSYCHRO_LOCKSTEP_LANES != 16
+#error "PSYCHRO_LOCKSTEP_LANES must be 4, 8 or 16"
+#endif
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define LANES PSYCHRO_LOCKSTEP_LANES
+
+#define PHASE_IDLE 0.                   // Lane without a point.
+
+#define PHASE_NEWTON 1.                 // Lane solving for the dew-point temperature.
+
+#define PHASE_BISECTION 2.              // Lane bisecting for the wet-bulb temperature.
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+// State of the lanes. All fields are doubles, so that the selects between them are vectorized.
+struct Lanes_
+{
+  double T[LANES];                      // Newton-Raphson iterate, or middle of the bracket
+  double Inf[LANES];                    // Bracket of the wet-bulb temperature
+  double Sup[LANES];
+  double LnVapPres[LANES];              // ln(VapPres) to solve for in the Newton-Raphson phase
+  double TDryBulb[LANES];
+  double HumRatio[LANES];               // Humidity ratio, bounded by MIN_HUM_RATIO
+  double Pressure[LANES];
+  double Phase[LANES];                  // PHASE_IDLE, PHASE_NEWTON or PHASE_BISECTION
+  double Done[LANES];                   // 1 if the phase converged at the last iteration
+  double Iter[LANES];                   // Number of iterations of the phase
+  size_t Row[LANES];                    // Index of the point in the batch
+};
+
+// Natural logarithm of the lanes, positive normal numbers
+static void Log_
+  ( const double x[LANES]
+  , double y[LANES]
+  )
+{
+  int l;
+
+  for (l = 0; l < LANES; l++)
+    y[l] = PsychroKernelLog(x[l]);
+}
+
+// Exponential function of the lanes, of normal results
+static void Exp_
+  ( const double x[LANES]
+  , double y[LANES]
+  )
+{
+  int l;
+
+  for (l = 0; l < LANES; l++)
+    y[l] = PsychroKernelExp(x[l]);
+}
+
+// One lock-step iteration of all the lanes: a Newton-Raphson step on ln(Pws) in the lanes of
+// PHASE_NEWTON and, if WetBulb is not zero, a bisection step in the lanes of PHASE_BISECTION.
+static void Step_
+  ( const struct PsychroKernelUnits *Units
+  , struct Lanes_ *Lanes
+  , int WetBulb
+  )
+{
+  const struct PsychroKernelUnits U = *Units; // Constants loaded once, so that the selects below are not masked loads
+  double TAbs[LANES], LnT[LANES], LnPws[LANES], Pws[LANES], TNewton[LANES];
+  double c[7], Inv, dLnPws, w[5], SatHumRatio, HumRatio, Inf, Sup;
+  int l, Ice, Liquid, Above, Newton, Bisection;
+
+  for (l = 0; l < LANES; l++)
+    TAbs[l] = Lanes->T[l] + U.Offset;
+  Log_(TAbs, LnT);
+
+  for (l = 0; l < LANES; l++)
+  {
+    Ice = Lanes->T[l] <= U.TriplePoint;
+    c[0] = Ice ? U.Ice[0] : U.Liquid[0];
+    c[1] = Ice ? U.Ice[1] : U.Liquid[1];
+    c[2] = Ice ? U.Ice[2] : U.Liquid[2];
+    c[3] = Ice ? U.Ice[3] : U.Liquid[3];
+    c[4] = Ice ? U.Ice[4] : U.Liquid[4];
+    c[5] = Ice ? U.Ice[5] : U.Liquid[5];
+    c[6] = Ice ? U.Ice[6] : U.Liquid[6];
+    Inv = 1. / TAbs[l];
+    LnPws[l] = c[0] * Inv + c[1] + TAbs[l] * (c[2] + TAbs[l] * (c[3] + TAbs[l] * (c[4] + TAbs[l] * c[5])))
+               + c[6] * LnT[l];
+    dLnPws = -c[0] * Inv * Inv + c[2] + TAbs[l] * (2. * c[3] + TAbs[l] * (3. * c[4] + TAbs[l] * 4. * c[5]))
+             + c[6] * Inv;
+
+    // New estimate, bounded by domain of validity of eqn. 5 and 6
+    TNewton[l] = Lanes->T[l] - (LnPws[l] - Lanes->LnVapPres[l]) / dLnPws;
+    TNewton[l] = max(TNewton[l], U.Bounds[0]);
+    TNewton[l] = min(TNewton[l], U.Bounds[1]);
+  }
+
+  if (!WetBulb)
+  {
+    for (l = 0; l < LANES; l++)
+    {
+      Newton = Lanes->Phase[l] == PHASE_NEWTON;
+      Lanes->Done[l] = Newton && !(fabs(TNewton[l] - Lanes->T[l]) > U.Tolerance) ? 1. : 0.;
+      Lanes->T[l] = Newton ? TNewton[l] : Lanes->T[l];
+      Lanes->Iter[l] += 1.;
+    }
+    return;
+  }
+
+  Exp_(LnPws, Pws);
+  for (l = 0; l < LANES; l++)
+  {
+    // Humidity ratio at the middle of the bracket
+    SatHumRatio = max(0.621945 * Pws[l] / (Lanes->Pressure[l] - Pws[l]), MIN_HUM_RATIO);
+    Liquid = Lanes->T[l] >= U.FreezingPoint;
+    w[0] = Liquid ? U.WetBulbLiquid[0] : U.WetBulbIce[0];
+    w[1] = Liquid ? U.WetBulbLiquid[1] : U.WetBulbIce[1];
+    w[2] = Liquid ? U.WetBulbLiquid[2] : U.WetBulbIce[2];
+    w[3] = Liquid ? U.WetBulbLiquid[3] : U.WetBulbIce[3];
+    w[4] = Liquid ? U.WetBulbLiquid[4] : U.WetBulbIce[4];
+    HumRatio = ((w[0] - w[1] * Lanes->T[l]) * SatHumRatio - w[2] * (Lanes->TDryBulb[l] - Lanes->T[l]))
+               / (w[0] + w[3] * Lanes->TDryBulb[l] - w[4] * Lanes->T[l]);
+    Above = max(HumRatio, MIN_HUM_RATIO) > Lanes->HumRatio[l];
+    Sup = Above ? Lanes->T[l] : Lanes->Sup[l];
+    Inf = Above ? Lanes->Inf[l] : Lanes->T[l];
+
+    // Update of the lanes of each phase
+    Newton = Lanes->Phase[l] == PHASE_NEWTON;
+    Bisection = Lanes->Phase[l] == PHASE_BISECTION;
+    Lanes->Done[l] = (Newton && !(fabs(TNewton[l] - Lanes->T[l]) > U.Tolerance))
+                     || (Bisection && !(Sup - Inf > U.Tolerance)) ? 1. : 0.;
+    Lanes->Sup[l] = Bisection ? Sup : Lanes->Sup[l];
+    Lanes->Inf[l] = Bisection ? Inf : Lanes->Inf[l];
+    Lanes->T[l] = Newton ? TNewton[l] : Bisection ? (Sup + Inf) / 2. : Lanes->T[l];
+    Lanes->Iter[l] += 1.;
+  }
+}
+
+// Constants of the system of units in use, and bounds of the vapor pressure.
+static const struct PsychroKernelUnits *GetUnits_
+  ( double VapPresBounds[2]     // (o) Saturation vapor pressure at the bounds of the domain
+  )
+{
+  const struct PsychroKernelUnits *Units = isIP() ? &PSYCHRO_KERNEL_UNITS_IP : &PSYCHRO_KERNEL_UNITS_SI;
+
+  VapPresBounds[0] = GetSatVapPres(Units->Bounds[0]);
+  VapPresBounds[1] = GetSatVapPres(Units->Bounds[1]);
+  return Units;
+}
+
+// Empty the lanes. An idle lane keeps a valid temperature, so that its calculations stay finite.
+static void Clear_
+  ( struct Lanes_ *Lanes
+  )
+{
+  int l;
+
+  for (l = 0; l < LANES; l++)
+  {
+    Lanes->T[l] = Lanes->Inf[l] = Lanes->Sup[l] = Lanes->TDryBulb[l] = 20.;
+    Lanes->LnVapPres[l] = 0.;
+    Lanes->HumRatio[l] = MIN_HUM_RATIO;
+    Lanes->Pressure[l] = 1e6;
+    Lanes->Phase[l] = PHASE_IDLE;
+    Lanes->Done[l] = 0.;
+    Lanes->Iter[l] = 0.;
+    Lanes->Row[l] = 0;
+  }
+}
+
+// Load a point in a lane to solve for its dew-point temperature, from the dry-bulb temperature.
+static void LoadDewPoint_
+  ( const struct PsychroKernelUnits *Units
+  , const double VapPresBounds[2]
+  , struct Lanes_ *Lanes
+  , int l
+  , size_t Row
+  , double TDryBulb
+  , double VapPres
+  )
+{
+  ASSERT (TDryBulb >= Units->Bounds[0] && TDryBulb <= Units->Bounds[1], "Dry bulb temperature is outside range of validity of equations")
+  ASSERT (VapPres >= VapPresBounds[0] && VapPres <= VapPresBounds[1],
+          "Partial pressure of water vapor is outside range of validity of equations")
+
+  Lanes->T[l] = Lanes->TDryBulb[l] = TDryBulb;
+  Lanes->LnVapPres[l] = log(VapPres);
+  Lanes->Phase[l] = PHASE_NEWTON;
+  Lanes->Iter[l] = 0.;
+  Lanes->Row[l] = Row;
+}
+
+
+/******************************************************************************************************
+ * Lock-step batch functions
+ *****************************************************************************************************/
+
+// Return dew-point temperature given dry-bulb temperature and vapor pressure, as GetTDewPointFromVapPres.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 5 and 6
+size_t LockstepGetTDewPointFromVapPres // (o) Number of lock-step iterations
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *VapPres       // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double *TDewPoint           // (o) Dew point temperature in °F [IP] or °C [SI]
+  )
+{
+  const struct PsychroKernelUnits *Units;
+  struct Lanes_ Lanes;
+  double VapPresBounds[2];
+  size_t Next = 0, Steps = 0;
+  int l, Active = 0;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  Units = GetUnits_(VapPresBounds);
+  Clear_(&Lanes);
+  for (l = 0; l < LANES && Next < Count; l++, Next++, Active++)
+    LoadDewPoint_(Units, VapPresBounds, &Lanes, l, Next, TDryBulb[Next], VapPres[Next]);
+
+  while (Active > 0)
+  {
+    Step_(Units, &Lanes, 0);
+    Steps++;
+
+    // Write the converged lanes and refill them with the next points
+    for (l = 0; l < LANES; l++)
+    {
+      if (Lanes.Phase[l] == PHASE_IDLE)
+        continue;
+      ASSERT (Lanes.Iter[l] <= MAX_ITER_COUNT, "Convergence not reached in LockstepGetTDewPointFromVapPres. Stopping.")
+      if (Lanes.Done[l] == 0.)
+        continue;
+
+      TDewPoint[Lanes.Row[l]] = min(Lanes.T[l], Lanes.TDryBulb[l]);
+      if (Next < Count)
+      {
+        LoadDewPoint_(Units, VapPresBounds, &Lanes, l, Next, TDryBulb[Next], VapPres[Next]);
+        Next++;
+      }
+      else
+      {
+        Lanes.Phase[l] = PHASE_IDLE;
+        Active--;
+      }
+    }
+  }
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+  return Steps;
+}
+
+// Return wet-bulb temperature given dry-bulb temperature, humidity ratio, and pressure, as GetTWetBulbFromHumRatio.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 33 and 35 solved for Tstar
+size_t LockstepGetTWetBulbFromHumRatio // (o) Number of lock-step iterations
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *HumRatio      // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , const double *Pressure      // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *TWetBulb            // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  )
+{
+  const struct PsychroKernelUnits *Units;
+  struct Lanes_ Lanes;
+  double VapPresBounds[2], BoundedHumRatio;
+  size_t Next = 0, Steps = 0;
+  int l, Active = 0, Load;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  Units = GetUnits_(VapPresBounds);
+  Clear_(&Lanes);
+  for (l = 0; l < LANES; l++)
+    Lanes.Done[l] = 1.;
+
+  for (;;)
+  {
+    // Advance the lanes that have converged to their next phase, or load the next points in them
+    for (l = 0; l < LANES; l++)
+    {
+      if (Lanes.Phase[l] != PHASE_IDLE)
+        ASSERT (Lanes.Iter[l] <= MAX_ITER_COUNT, "Convergence not reached in LockstepGetTWetBulbFromHumRatio. Stopping.")
+      if (Lanes.Done[l] == 0.)
+        continue;
+
+      Load = Lanes.Phase[l] == PHASE_IDLE || Lanes.Phase[l] == PHASE_BISECTION;
+      if (Lanes.Phase[l] == PHASE_NEWTON)
+      {
+        // Initial bracket of the bisection, which may already be within the tolerance
+        Lanes.Inf[l] = min(Lanes.T[l], Lanes.TDryBulb[l]);
+        Lanes.Sup[l] = Lanes.TDryBulb[l];
+        Lanes.T[l] = (Lanes.Inf[l] + Lanes.Sup[l]) / 2.;
+        Lanes.Phase[l] = PHASE_BISECTION;
+        Lanes.Iter[l] = 0.;
+        Lanes.Done[l] = 0.;
+        if (!(Lanes.Sup[l] - Lanes.Inf[l] > Units->Tolerance))
+          Load = 1;
+      }
+      if (!Load)
+        continue;
+
+      if (Lanes.Phase[l] == PHASE_BISECTION)
+      {
+        TWetBulb[Lanes.Row[l]] = Lanes.T[l];
+        Active--;
+      }
+      Lanes.Phase[l] = PHASE_IDLE;
+      Lanes.Done[l] = 0.;
+      if (Next < Count)
+      {
+        ASSERT (HumRatio[Next] >= 0., "Humidity ratio is negative")
+        BoundedHumRatio = max(HumRatio[Next], MIN_HUM_RATIO);
+        LoadDewPoint_(Units, VapPresBounds, &Lanes, l, Next, TDryBulb[Next],
+                      Pressure[Next] * BoundedHumRatio / (0.621945 + BoundedHumRatio));
+        Lanes.HumRatio[l] = BoundedHumRatio;
+        Lanes.Pressure[l] = Pressure[Next];
+        Next++;
+        Active++;
+      }
+    }
+    if (Active == 0)
+      break;
+
+    Step_(Units, &Lanes, 1);
+    Steps++;
+  }
+
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+  return Steps;
+}
@@ -0,0 +1,40 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Lock-step solvers: batch dew-point and wet-bulb temperatures with the iterations of several
+ * points advanced together in SIMD lanes.
+ * See psychrolib_lockstep.c for details.
+*/
+
+#ifndef PSYCHROLIB_LOCKSTEP_H
+#define PSYCHROLIB_LOCKSTEP_H
+
+#include <stddef.h>
+
+// Number of points iterated in lock-step: 4, 8 or 16
+#ifndef PSYCHRO_LOCKSTEP_LANES
+#define PSYCHRO_LOCKSTEP_LANES 8
+#endif
+
+
+/******************************************************************************************************
+ * Lock-step batch functions
+ *****************************************************************************************************/
+
+size_t LockstepGetTDewPointFromVapPres // (o) Number of lock-step iterations
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *VapPres       // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double *TDewPoint           // (o) Dew point temperature in °F [IP] or °C [SI]
+  );
+
+size_t LockstepGetTWetBulbFromHumRatio // (o) Number of lock-step iterations
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *HumRatio      // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , const double *Pressure      // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *TWetBulb            // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  );
+
+#endif // PSYCHROLIB_LOCKSTEP_H
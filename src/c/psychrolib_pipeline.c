@@ -0,0 +1,757 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Streaming pipeline: stages of threads connected by bounded lock-free queues, which parse,
+ *  validate and convert sensor readings, calculate their psychrometric properties in batches and
+ *  aggregate them, with backpressure and throughput and latency counters per stage.
+ *
+ *  The queues are rings of a power of 2 items. A queue with one producer and one consumer (SPSC)
+ *  has a head and a tail index only, each written by one side, so that a batch of items is pushed
+ *  or popped with one release store. A queue with several producers or consumers (MPMC) is the
+ *  bounded queue of D. Vyukov: each cell has a sequence number that tells the producers and the
+ *  consumers whether it is free or full, and the head and tail indices are claimed with a
+ *  compare-and-swap. The indices are on separate cache lines, so that the producers and the
+ *  consumers do not write to the same line. The queues never block: a push to a full queue or a
+ *  pop from an empty one returns fewer items, and the pipeline decides how to wait.
+ *
+ *  A pipeline is a chain of stages, each with its own threads (workers) and its input queue:
+ *   - map stages call a function of the application on each reading, to parse its raw frame,
+ *     validate it or convert its units, and drop it if the function returns non-zero;
+ *   - compute stages calculate the psychrometric properties of each reading from its dry-bulb
+ *     temperature, pressure and relative humidity, wet-bulb or dew-point temperature, with the
+ *     functions of psychrolib_bounded.c: readings outside the range of the equations have NaN
+ *     properties instead of stopping the program;
+ *   - a sink stage, last, calls a function of the application on each batch of readings, to
+ *     aggregate them. Without a sink, the application pops the readings out of the last stage.
+ *  The queues between stages with one worker each are SPSC, the others MPMC, and the input queue
+ *  of the first stage is SPSC if there is one producer thread.
+ *
+ *  Each worker pops up to BatchSize readings from the input queue of its stage, waiting at most
+ *  MaxLatency after the first one for the batch to fill, processes them together and pushes them
+ *  to the next queue, so that the cost of the queues is shared by the readings of a batch while
+ *  the latency stays bounded at low rates. A worker whose output queue is full waits for it to
+ *  drain, which fills its own input queue in turn: the pushes into the pipeline then wait
+ *  (PsychroPipelinePush) or fail (PsychroPipelineTryPush), instead of the memory growing without
+ *  bound. The waits spin with yields of the thread for a short while, then sleep for 20 us.
+ *
+ *  Closing the pipeline lets the stages process the readings already pushed: the workers of a
+ *  stage stop once their input queue is closed and empty, and the last of them closes the input
+ *  queue of the next stage. The functions of the application are called concurrently by the
+ *  workers of their stage, and must not change the system of units.
+ *
+ *  The counters of each stage are updated once per batch: readings processed and dropped,
+ *  batches, waits on a full output queue, time spent processing, and the latency from the push of
+ *  each reading into the pipeline to the end of the stage.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_pipeline.h"
+ *  SetUnitSystem(SI);
+ *  struct PsychroStageConfig Stages[3] = {
+ *    { PSYCHRO_STAGE_MAP, 1, 0, 0.001, 0, 0, ParseFrame, NULL, NULL },
+ *    { PSYCHRO_STAGE_COMPUTE, 4, 256, 0.001, 0, PSYCHRO_STAGE_FROM_REL_HUM, NULL, NULL, NULL },
+ *    { PSYCHRO_STAGE_SINK, 1, 1024, 0.01, 0, 0, NULL, Aggregate, &Totals } };
+ *  PsychroPipeline *Pipeline = PsychroPipelineCreate(Stages, 3, 1);
+ *  while (ReadFrame(&Reading))
+ *    PsychroPipelinePush(Pipeline, &Reading);
+ *  PsychroPipelineFinish(Pipeline);    // Processes the readings pushed
+ *  PsychroPipelineGetStats(Pipeline, 1, &Stats);
+ *  PsychroPipelineDestroy(Pipeline);
+ */
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+// Standard C header files
+#include <math.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Header specific to this file
+#include "psychrolib_bounded.h"
+#include "psychrolib_pipeline.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define CACHE_LINE 64                   // Size of the cache lines, which separates the indices of the queues.
+
+#define DEFAULT_BATCH_SIZE 256          // Default maximum number of readings of a batch.
+
+#define DEFAULT_QUEUE_CAPACITY 4096     // Default number of readings of the input queue of a stage.
+
+#define SPIN_COUNT 64                   // Number of yields of a wait before sleeping.
+
+#define SLEEP_NS 20000                  // Sleep of a wait in ns after the yields.
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+// Monotonic time in s, not affected by changes of the time of day
+static double Now_(void)
+{
+#if defined(_WIN32)
+  LARGE_INTEGER Counter, Frequency;
+  QueryPerformanceCounter(&Counter);
+  QueryPerformanceFrequency(&Frequency);
+  return (double) Counter.QuadPart / Frequency.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+#endif
+}
+
+// Wait of a spinning thread, longer after SPIN_COUNT calls
+static void Backoff_
+  ( unsigned *Spins                     // (i/o) Number of waits so far
+  )
+{
+#if defined(_WIN32)
+  if ((*Spins)++ < SPIN_COUNT)
+    SwitchToThread();
+  else
+    Sleep(1);
+#else
+  struct timespec Sleep = { 0, SLEEP_NS };
+  if ((*Spins)++ < SPIN_COUNT)
+    sched_yield();
+  else
+    nanosleep(&Sleep, NULL);
+#endif
+}
+
+// Atomic maximum
+static void Max_
+  ( atomic_uint_least64_t *Value
+  , uint64_t Candidate
+  )
+{
+  uint_least64_t Current = atomic_load_explicit(Value, memory_order_relaxed);
+
+  while (Candidate > Current && !atomic_compare_exchange_weak_explicit(Value, &Current, Candidate,
+    memory_order_relaxed, memory_order_relaxed))
+    ;
+}
+
+
+/******************************************************************************************************
+ * Lock-free queues
+ *****************************************************************************************************/
+
+struct PsychroQueue
+{
+  enum PsychroQueueKind Kind;
+  size_t Mask;                          // Capacity - 1
+  size_t ItemSize;
+  unsigned char *Items;
+  atomic_size_t *Sequences;             // Sequence number of each cell of an MPMC queue
+  char Pad0[CACHE_LINE];
+  atomic_size_t Head;                   // Index of the next item popped
+  char Pad1[CACHE_LINE];
+  atomic_size_t Tail;                   // Index of the next item pushed
+  char Pad2[CACHE_LINE];
+};
+
+PsychroQueue *PsychroQueueCreate        // (o) New empty queue, NULL if out of memory
+  ( enum PsychroQueueKind Kind          // (i) Producers and consumers of the queue
+  , size_t Capacity                     // (i) Minimum number of items, rounded up to a power of 2
+  , size_t ItemSize                     // (i) Size of the items in bytes
+  )
+{
+  PsychroQueue *Queue;
+  size_t Size = 2, i;
+
+  if (ItemSize == 0 || Capacity > SIZE_MAX / 4 / ItemSize)
+    return NULL;
+  while (Size < Capacity)
+    Size *= 2;
+  Queue = calloc(1, sizeof(PsychroQueue));
+  if (Queue == NULL)
+    return NULL;
+  Queue->Kind = Kind;
+  Queue->Mask = Size - 1;
+  Queue->ItemSize = ItemSize;
+  Queue->Items = malloc(Size * ItemSize);
+  if (Kind == PSYCHRO_QUEUE_MPMC)
+    Queue->Sequences = malloc(Size * sizeof(atomic_size_t));
+  if (Queue->Items == NULL || (Kind == PSYCHRO_QUEUE_MPMC && Queue->Sequences == NULL))
+  {
+    PsychroQueueDestroy(Queue);
+    return NULL;
+  }
+  for (i = 0; Queue->Sequences != NULL && i < Size; i++)
+    atomic_init(&Queue->Sequences[i], i);
+  atomic_init(&Queue->Head, 0);
+  atomic_init(&Queue->Tail, 0);
+  return Queue;
+}
+
+void PsychroQueueDestroy
+  ( PsychroQueue *Queue                 // (i) Queue to free, may be NULL
+  )
+{
+  if (Queue == NULL)
+    return;
+  free(Queue->Items);
+  free(Queue->Sequences);
+  free(Queue);
+}
+
+// Copy items between a buffer and the ring, in two parts if they wrap around
+static void Copy_
+  ( PsychroQueue *Queue
+  , size_t Index
+  , unsigned char *Items
+  , size_t Count
+  , int ToRing
+  )
+{
+  size_t Start = Index & Queue->Mask, First = Queue->Mask + 1 - Start;
+  unsigned char *Ring = Queue->Items + Start * Queue->ItemSize;
+
+  if (First > Count)
+    First = Count;
+  if (ToRing)
+  {
+    memcpy(Ring, Items, First * Queue->ItemSize);
+    memcpy(Queue->Items, Items + First * Queue->ItemSize, (Count - First) * Queue->ItemSize);
+  }
+  else
+  {
+    memcpy(Items, Ring, First * Queue->ItemSize);
+    memcpy(Items + First * Queue->ItemSize, Queue->Items, (Count - First) * Queue->ItemSize);
+  }
+}
+
+size_t PsychroQueuePush                 // (o) Number of items pushed, fewer than Count if the queue is full
+  ( PsychroQueue *Queue                 // (i) Queue
+  , const void *Items                   // (i) Items to push, in order
+  , size_t Count                        // (i) Number of items
+  )
+{
+  size_t Tail, Head, Sequence, n;
+  ptrdiff_t Difference;
+
+  if (Queue->Kind == PSYCHRO_QUEUE_SPSC)
+  {
+    Tail = atomic_load_explicit(&Queue->Tail, memory_order_relaxed);
+    Head = atomic_load_explicit(&Queue->Head, memory_order_acquire);
+    if (Count > Queue->Mask + 1 - (Tail - Head))
+      Count = Queue->Mask + 1 - (Tail - Head);
+    Copy_(Queue, Tail, (unsigned char *) Items, Count, 1);
+    atomic_store_explicit(&Queue->Tail, Tail + Count, memory_order_release);
+    return Count;
+  }
+
+  for (n = 0; n < Count; n++)
+  {
+    Tail = atomic_load_explicit(&Queue->Tail, memory_order_relaxed);
+    for (;;)
+    {
+      Sequence = atomic_load_explicit(&Queue->Sequences[Tail & Queue->Mask], memory_order_acquire);
+      Difference = (ptrdiff_t) (Sequence - Tail);
+      if (Difference == 0)
+      {
+        if (atomic_compare_exchange_weak_explicit(&Queue->Tail, &Tail, Tail + 1, memory_order_relaxed, memory_order_relaxed))
+          break;
+      }
+      else if (Difference < 0)
+        return n;
+      else
+        Tail = atomic_load_explicit(&Queue->Tail, memory_order_relaxed);
+    }
+    memcpy(Queue->Items + (Tail & Queue->Mask) * Queue->ItemSize, (const unsigned char *) Items + n * Queue->ItemSize,
+      Queue->ItemSize);
+    atomic_store_explicit(&Queue->Sequences[Tail & Queue->Mask], Tail + 1, memory_order_release);
+  }
+  return Count;
+}
+
+size_t PsychroQueuePop                  // (o) Number of items popped, fewer than Count if the queue is empty
+  ( PsychroQueue *Queue                 // (i) Queue
+  , void *Items                         // (o) Items popped, in order
+  , size_t Count                        // (i) Maximum number of items
+  )
+{
+  size_t Tail, Head, Sequence, n;
+  ptrdiff_t Difference;
+
+  if (Queue->Kind == PSYCHRO_QUEUE_SPSC)
+  {
+    Head = atomic_load_explicit(&Queue->Head, memory_order_relaxed);
+    Tail = atomic_load_explicit(&Queue->Tail, memory_order_acquire);
+    if (Count > Tail - Head)
+      Count = Tail - Head;
+    Copy_(Queue, Head, Items, Count, 0);
+    atomic_store_explicit(&Queue->Head, Head + Count, memory_order_release);
+    return Count;
+  }
+
+  for (n = 0; n < Count; n++)
+  {
+    Head = atomic_load_explicit(&Queue->Head, memory_order_relaxed);
+    for (;;)
+    {
+      Sequence = atomic_load_explicit(&Queue->Sequences[Head & Queue->Mask], memory_order_acquire);
+      Difference = (ptrdiff_t) (Sequence - (Head + 1));
+      if (Difference == 0)
+      {
+        if (atomic_compare_exchange_weak_explicit(&Queue->Head, &Head, Head + 1, memory_order_relaxed, memory_order_relaxed))
+          break;
+      }
+      else if (Difference < 0)
+        return n;
+      else
+        Head = atomic_load_explicit(&Queue->Head, memory_order_relaxed);
+    }
+    memcpy((unsigned char *) Items + n * Queue->ItemSize, Queue->Items + (Head & Queue->Mask) * Queue->ItemSize,
+      Queue->ItemSize);
+    atomic_store_explicit(&Queue->Sequences[Head & Queue->Mask], Head + Queue->Mask + 1, memory_order_release);
+  }
+  return Count;
+}
+
+size_t PsychroQueueGetSize              // (o) Number of items in the queue, approximate if it is in use
+  ( PsychroQueue *Queue                 // (i) Queue
+  )
+{
+  size_t Head = atomic_load_explicit(&Queue->Head, memory_order_acquire);
+  size_t Tail = atomic_load_explicit(&Queue->Tail, memory_order_acquire);
+
+  return Tail - Head > Queue->Mask + 1 ? 0 : Tail - Head;
+}
+
+
+/******************************************************************************************************
+ * Pipelines
+ *****************************************************************************************************/
+
+struct Stage_
+{
+  struct PsychroStageConfig Config;
+  PsychroQueue *Input;
+  atomic_int Closed;                    // No more readings are pushed into the input queue
+  atomic_uint Running;                  // Number of workers not finished
+  atomic_uint_least64_t Readings, Dropped, Batches, Stalls, BusyNs, LatencyNs, MaxLatencyNs;
+};
+
+struct Worker_
+{
+  PsychroPipeline *Pipeline;
+  size_t Stage;
+  struct PsychroReading *Batch;         // Readings of the batch being processed
+  int Started;
+#if defined(_WIN32)
+  HANDLE Handle;
+#else
+  pthread_t Handle;
+#endif
+};
+
+struct PsychroPipeline
+{
+  struct Stage_ *Stages;
+  size_t NStages;
+  PsychroQueue *Output;                 // Readings out of the last stage if it is not a sink
+  atomic_int OutputClosed;
+  atomic_int Closed;                    // No more pushes into the pipeline
+  atomic_uint Running;                  // Number of workers not finished, in all the stages
+  struct Worker_ *Workers;
+  size_t NWorkers;
+  double Created;
+};
+
+// Psychrometric properties of a batch of readings, NaN outside the range of the equations
+static void Compute_
+  ( enum PsychroStageInput Input
+  , struct PsychroReading *Readings
+  , size_t Count
+  )
+{
+  struct PsychroReading *r;
+  enum PsychroStatus Status;
+  size_t i;
+
+  for (i = 0; i < Count; i++)
+  {
+    r = &Readings[i];
+    if (Input == PSYCHRO_STAGE_FROM_TWET_BULB)
+      Status = BoundedCalcPsychrometricsFromTWetBulb(r->TDryBulb, r->TWetBulb, r->Pressure, &r->HumRatio, &r->TDewPoint,
+        &r->RelHum, &r->VapPres, &r->MoistAirEnthalpy, &r->MoistAirVolume, &r->DegreeOfSaturation);
+    else if (Input == PSYCHRO_STAGE_FROM_TDEW_POINT)
+      Status = BoundedCalcPsychrometricsFromTDewPoint(r->TDryBulb, r->TDewPoint, r->Pressure, &r->HumRatio, &r->TWetBulb,
+        &r->RelHum, &r->VapPres, &r->MoistAirEnthalpy, &r->MoistAirVolume, &r->DegreeOfSaturation);
+    else
+      Status = BoundedCalcPsychrometricsFromRelHum(r->TDryBulb, r->RelHum, r->Pressure, &r->HumRatio, &r->TWetBulb,
+        &r->TDewPoint, &r->VapPres, &r->MoistAirEnthalpy, &r->MoistAirVolume, &r->DegreeOfSaturation);
+    if (Status != PSYCHRO_STATUS_OK)
+    {
+      r->HumRatio = r->VapPres = r->MoistAirEnthalpy = r->MoistAirVolume = r->DegreeOfSaturation = NAN;
+      if (Input != PSYCHRO_STAGE_FROM_REL_HUM)
+        r->RelHum = NAN;
+      if (Input != PSYCHRO_STAGE_FROM_TWET_BULB)
+        r->TWetBulb = NAN;
+      if (Input != PSYCHRO_STAGE_FROM_TDEW_POINT)
+        r->TDewPoint = NAN;
+    }
+  }
+}
+
+// Loop of a worker: pop a batch, process it, push it to the next stage, until the input is closed and empty
+static void Work_
+  ( PsychroPipeline *Pipeline
+  , size_t Index
+  , struct PsychroReading *Batch
+  )
+{
+  struct Stage_ *Stage = &Pipeline->Stages[Index];
+  const struct PsychroStageConfig *Config = &Stage->Config;
+  PsychroQueue *Next = Index + 1 < Pipeline->NStages ? Pipeline->Stages[Index + 1].Input : Pipeline->Output;
+  size_t n, Kept, Pushed, i;
+  double First = 0., Start, End, Latency, LatencySum, LatencyMax;
+  unsigned Spins;
+  int Done = 0;
+
+  while (!Done)
+  {
+    // Batch of up to BatchSize readings, within MaxLatency of the first one
+    n = 0;
+    Spins = 0;
+    for (;;)
+    {
+      if (n == 0)
+      {
+        n = PsychroQueuePop(Stage->Input, Batch, Config->BatchSize);
+        First = Now_();
+      }
+      else
+        n += PsychroQueuePop(Stage->Input, Batch + n, Config->BatchSize - n);
+      if (n == Config->BatchSize)
+        break;
+      if (atomic_load_explicit(&Stage->Closed, memory_order_acquire))
+      {
+        n += PsychroQueuePop(Stage->Input, Batch + n, Config->BatchSize - n);
+        Done = n < Config->BatchSize;
+        break;
+      }
+      if (n > 0 && Now_() - First >= Config->MaxLatency)
+        break;
+      Backoff_(&Spins);
+    }
+    if (n == 0)
+      break;
+
+    // Processing
+    Start = Now_();
+    Kept = n;
+    if (Config->Kind == PSYCHRO_STAGE_MAP)
+    {
+      for (i = 0, Kept = 0; i < n; i++)
+        if (Config->Map(Config->Context, &Batch[i]) == 0)
+          Batch[Kept++] = Batch[i];
+    }
+    else if (Config->Kind == PSYCHRO_STAGE_COMPUTE)
+      Compute_(Config->Input, Batch, n);
+    else
+      Config->Sink(Config->Context, Batch, n);
+    End = Now_();
+
+    LatencySum = LatencyMax = 0.;
+    for (i = 0; i < Kept; i++)
+    {
+      Latency = End - Batch[i].Entered;
+      LatencySum += Latency;
+      LatencyMax = fmax(LatencyMax, Latency);
+    }
+    atomic_fetch_add_explicit(&Stage->Readings, Kept, memory_order_relaxed);
+    atomic_fetch_add_explicit(&Stage->Dropped, n - Kept, memory_order_relaxed);
+    atomic_fetch_add_explicit(&Stage->Batches, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&Stage->BusyNs, (uint64_t) (1e9 * (End - Start)), memory_order_relaxed);
+    atomic_fetch_add_explicit(&Stage->LatencyNs, (uint64_t) (1e9 * LatencySum), memory_order_relaxed);
+    Max_(&Stage->MaxLatencyNs, (uint64_t) (1e9 * LatencyMax));
+
+    // Next stage, waiting while its queue is full
+    if (Next != NULL)
+    {
+      Spins = 0;
+      for (Pushed = PsychroQueuePush(Next, Batch, Kept); Pushed < Kept; Pushed += PsychroQueuePush(Next, Batch + Pushed, Kept - Pushed))
+      {
+        if (Spins == 0)
+          atomic_fetch_add_explicit(&Stage->Stalls, 1, memory_order_relaxed);
+        Backoff_(&Spins);
+      }
+    }
+  }
+
+  // The last worker of the stage closes the input of the next one
+  if (atomic_fetch_sub_explicit(&Stage->Running, 1, memory_order_acq_rel) == 1)
+  {
+    if (Index + 1 < Pipeline->NStages)
+      atomic_store_explicit(&Pipeline->Stages[Index + 1].Closed, 1, memory_order_release);
+    else
+      atomic_store_explicit(&Pipeline->OutputClosed, 1, memory_order_release);
+  }
+}
+
+static void Run_
+  ( struct Worker_ *Worker
+  )
+{
+  Work_(Worker->Pipeline, Worker->Stage, Worker->Batch);
+  atomic_fetch_sub_explicit(&Worker->Pipeline->Running, 1, memory_order_release);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI Thread_(LPVOID Worker)
+{
+  Run_(Worker);
+  return 0;
+}
+#else
+static void *Thread_(void *Worker)
+{
+  Run_(Worker);
+  return NULL;
+}
+#endif
+
+PsychroPipeline *PsychroPipelineCreate  // (o) New running pipeline, NULL if the configuration is invalid or out of resources
+  ( const struct PsychroStageConfig *Stages // (i) Configuration of each stage, in order
+  , size_t NStages                      // (i) Number of stages
+  , unsigned Producers                  // (i) Number of threads that push readings, 0 for any
+  )
+{
+  PsychroPipeline *Pipeline;
+  struct Stage_ *Stage;
+  enum PsychroQueueKind Kind;
+  size_t s, w, NWorkers = 0;
+
+  // Configuration
+  if (NStages == 0)
+    return NULL;
+  for (s = 0; s < NStages; s++)
+  {
+    if (Stages[s].Workers == 0 || (Stages[s].Kind == PSYCHRO_STAGE_MAP && Stages[s].Map == NULL)
+      || (Stages[s].Kind == PSYCHRO_STAGE_SINK && (Stages[s].Sink == NULL || s + 1 < NStages))
+      || (Stages[s].Kind != PSYCHRO_STAGE_MAP && Stages[s].Kind != PSYCHRO_STAGE_COMPUTE && Stages[s].Kind != PSYCHRO_STAGE_SINK)
+      || !(Stages[s].MaxLatency >= 0.))
+      return NULL;
+    NWorkers += Stages[s].Workers;
+  }
+
+  Pipeline = calloc(1, sizeof(PsychroPipeline));
+  if (Pipeline == NULL)
+    return NULL;
+  Pipeline->NStages = NStages;
+  Pipeline->Stages = calloc(NStages, sizeof(struct Stage_));
+  Pipeline->Workers = calloc(NWorkers, sizeof(struct Worker_));
+  if (Pipeline->Stages == NULL || Pipeline->Workers == NULL)
+  {
+    free(Pipeline->Stages);
+    free(Pipeline->Workers);
+    free(Pipeline);
+    return NULL;
+  }
+  atomic_init(&Pipeline->Closed, 0);
+  atomic_init(&Pipeline->OutputClosed, 0);
+  atomic_init(&Pipeline->Running, (unsigned) NWorkers);
+
+  // Queues: SPSC between one producer and one worker, MPMC otherwise
+  for (s = 0; s < NStages; s++)
+  {
+    Stage = &Pipeline->Stages[s];
+    Stage->Config = Stages[s];
+    if (Stage->Config.BatchSize == 0)
+      Stage->Config.BatchSize = DEFAULT_BATCH_SIZE;
+    if (Stage->Config.QueueCapacity == 0)
+      Stage->Config.QueueCapacity = DEFAULT_QUEUE_CAPACITY;
+    Kind = Stages[s].Workers == 1 && (s > 0 ? Stages[s - 1].Workers == 1 : Producers == 1) ? PSYCHRO_QUEUE_SPSC : PSYCHRO_QUEUE_MPMC;
+    Stage->Input = PsychroQueueCreate(Kind, Stage->Config.QueueCapacity, sizeof(struct PsychroReading));
+    atomic_init(&Stage->Closed, 0);
+    atomic_init(&Stage->Running, Stages[s].Workers);
+    atomic_init(&Stage->Readings, 0);
+    atomic_init(&Stage->Dropped, 0);
+    atomic_init(&Stage->Batches, 0);
+    atomic_init(&Stage->Stalls, 0);
+    atomic_init(&Stage->BusyNs, 0);
+    atomic_init(&Stage->LatencyNs, 0);
+    atomic_init(&Stage->MaxLatencyNs, 0);
+  }
+  if (Stages[NStages - 1].Kind != PSYCHRO_STAGE_SINK)
+    Pipeline->Output = PsychroQueueCreate(Stages[NStages - 1].Workers == 1 ? PSYCHRO_QUEUE_SPSC : PSYCHRO_QUEUE_MPMC,
+      Pipeline->Stages[NStages - 1].Config.QueueCapacity, sizeof(struct PsychroReading));
+  for (s = 0; s < NStages; s++)
+    if (Pipeline->Stages[s].Input == NULL || (s == NStages - 1 && Stages[s].Kind != PSYCHRO_STAGE_SINK && Pipeline->Output == NULL))
+    {
+      for (s = 0; s < NStages; s++)
+        PsychroQueueDestroy(Pipeline->Stages[s].Input);
+      PsychroQueueDestroy(Pipeline->Output);
+      free(Pipeline->Stages);
+      free(Pipeline->Workers);
+      free(Pipeline);
+      return NULL;
+    }
+
+  // Workers; if one cannot be started, those started are stopped
+  Pipeline->Created = Now_();
+  for (s = 0; s < NStages; s++)
+    for (w = 0; w < Stages[s].Workers; w++)
+    {
+      struct Worker_ *Worker = &Pipeline->Workers[Pipeline->NWorkers];
+      Worker->Pipeline = Pipeline;
+      Worker->Stage = s;
+      Worker->Batch = malloc(Pipeline->Stages[s].Config.BatchSize * sizeof(struct PsychroReading));
+      if (Worker->Batch != NULL)
+      {
+#if defined(_WIN32)
+        Worker->Handle = CreateThread(NULL, 0, Thread_, Worker, 0, NULL);
+        Worker->Started = Worker->Handle != NULL;
+#else
+        Worker->Started = pthread_create(&Worker->Handle, NULL, Thread_, Worker) == 0;
+#endif
+      }
+      if (!Worker->Started)
+      {
+        free(Worker->Batch);
+        atomic_fetch_sub_explicit(&Pipeline->Running, (unsigned) (NWorkers - Pipeline->NWorkers), memory_order_relaxed);
+        atomic_fetch_sub_explicit(&Pipeline->Stages[s].Running, (unsigned) (Stages[s].Workers - w), memory_order_relaxed);
+        PsychroPipelineDestroy(Pipeline);
+        return NULL;
+      }
+      Pipeline->NWorkers++;
+    }
+  return Pipeline;
+}
+
+int PsychroPipelineTryPush              // (o) 0 on success, 1 if the input queue of the first stage is full, -1 if the pipeline is closed
+  ( PsychroPipeline *Pipeline           // (i) Pipeline
+  , const struct PsychroReading *Reading // (i) Reading
+  )
+{
+  struct PsychroReading Entered = *Reading;
+
+  if (atomic_load_explicit(&Pipeline->Closed, memory_order_relaxed))
+    return -1;
+  Entered.Entered = Now_();
+  return PsychroQueuePush(Pipeline->Stages[0].Input, &Entered, 1) == 1 ? 0 : 1;
+}
+
+int PsychroPipelinePush                 // (o) 0 on success, -1 if the pipeline is closed
+  ( PsychroPipeline *Pipeline           // (i) Pipeline
+  , const struct PsychroReading *Reading // (i) Reading, waiting while the input queue of the first stage is full
+  )
+{
+  unsigned Spins = 0;
+  int Status;
+
+  while ((Status = PsychroPipelineTryPush(Pipeline, Reading)) == 1)
+    Backoff_(&Spins);
+  return Status;
+}
+
+int PsychroPipelinePop                  // (o) 1 if a reading is popped, 0 if none is ready, -1 once the pipeline is closed and drained
+  ( PsychroPipeline *Pipeline           // (i) Pipeline whose last stage is not a sink, popped by one thread
+  , struct PsychroReading *Reading      // (o) Reading out of the last stage
+  )
+{
+  if (Pipeline->Output == NULL)
+    return -1;
+  if (PsychroQueuePop(Pipeline->Output, Reading, 1) == 1)
+    return 1;
+  if (!atomic_load_explicit(&Pipeline->OutputClosed, memory_order_acquire))
+    return 0;
+  return PsychroQueuePop(Pipeline->Output, Reading, 1) == 1 ? 1 : -1;
+}
+
+void PsychroPipelineClose
+  ( PsychroPipeline *Pipeline           // (i) Pipeline, which processes the readings pushed before and accepts no more
+  )
+{
+  atomic_store_explicit(&Pipeline->Closed, 1, memory_order_relaxed);
+  atomic_store_explicit(&Pipeline->Stages[0].Closed, 1, memory_order_release);
+}
+
+void PsychroPipelineGetStats
+  ( PsychroPipeline *Pipeline           // (i) Pipeline
+  , size_t Stage                        // (i) Index of the stage
+  , struct PsychroStageStats *Stats     // (o) Counters of the stage since the creation of the pipeline
+  )
+{
+  struct Stage_ *s;
+  double Elapsed = Now_() - Pipeline->Created;
+
+  memset(Stats, 0, sizeof *Stats);
+  if (Stage >= Pipeline->NStages)
+    return;
+  s = &Pipeline->Stages[Stage];
+  Stats->Readings = atomic_load_explicit(&s->Readings, memory_order_relaxed);
+  Stats->Dropped = atomic_load_explicit(&s->Dropped, memory_order_relaxed);
+  Stats->Batches = atomic_load_explicit(&s->Batches, memory_order_relaxed);
+  Stats->Stalls = atomic_load_explicit(&s->Stalls, memory_order_relaxed);
+  Stats->QueueSize = PsychroQueueGetSize(s->Input);
+  Stats->BusyTime = 1e-9 * atomic_load_explicit(&s->BusyNs, memory_order_relaxed);
+  Stats->Throughput = Elapsed > 0. ? Stats->Readings / Elapsed : 0.;
+  Stats->MeanLatency = Stats->Readings > 0 ? 1e-9 * atomic_load_explicit(&s->LatencyNs, memory_order_relaxed) / Stats->Readings : 0.;
+  Stats->MaxLatency = 1e-9 * atomic_load_explicit(&s->MaxLatencyNs, memory_order_relaxed);
+}
+
+void PsychroPipelineFinish
+  ( PsychroPipeline *Pipeline           // (i) Pipeline to close, waiting until its stages have processed the readings pushed; readings not popped are discarded
+  )
+{
+  struct PsychroReading Reading;
+  unsigned Spins = 0;
+
+  PsychroPipelineClose(Pipeline);
+  while (atomic_load_explicit(&Pipeline->Running, memory_order_acquire) > 0)
+  {
+    if (Pipeline->Output != NULL && PsychroQueuePop(Pipeline->Output, &Reading, 1) == 1)
+      continue;
+    Backoff_(&Spins);
+  }
+}
+
+void PsychroPipelineDestroy
+  ( PsychroPipeline *Pipeline           // (i) Pipeline to finish and free, may be NULL
+  )
+{
+  size_t s, w;
+
+  if (Pipeline == NULL)
+    return;
+  PsychroPipelineFinish(Pipeline);
+  for (w = 0; w < Pipeline->NWorkers; w++)
+  {
+#if defined(_WIN32)
+    WaitForSingleObject(Pipeline->Workers[w].Handle, INFINITE);
+    CloseHandle(Pipeline->Workers[w].Handle);
+#else
+    pthread_join(Pipeline->Workers[w].Handle, NULL);
+#endif
+    free(Pipeline->Workers[w].Batch);
+  }
+  for (s = 0; s < Pipeline->NStages; s++)
+    PsychroQueueDestroy(Pipeline->Stages[s].Input);
+  PsychroQueueDestroy(Pipeline->Output);
+  free(Pipeline->Stages);
+  free(Pipeline->Workers);
+  free(Pipeline);
+}
@@ -0,0 +1,170 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Streaming pipeline: stages of threads connected by bounded lock-free queues, which parse,
+ * validate and convert sensor readings, calculate their psychrometric properties in batches and
+ * aggregate them, with backpressure and throughput and latency counters per stage.
+ * See psychrolib_pipeline.c for details.
+*/
+
+#ifndef PSYCHROLIB_PIPELINE_H
+#define PSYCHROLIB_PIPELINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/******************************************************************************************************
+ * Lock-free queues
+ *****************************************************************************************************/
+
+typedef struct PsychroQueue PsychroQueue;
+
+enum PsychroQueueKind
+{
+  PSYCHRO_QUEUE_SPSC,                   // One producer thread and one consumer thread
+  PSYCHRO_QUEUE_MPMC                    // Any number of producer and consumer threads
+};
+
+PsychroQueue *PsychroQueueCreate        // (o) New empty queue, NULL if out of memory
+  ( enum PsychroQueueKind Kind          // (i) Producers and consumers of the queue
+  , size_t Capacity                     // (i) Minimum number of items, rounded up to a power of 2
+  , size_t ItemSize                     // (i) Size of the items in bytes
+  );
+
+void PsychroQueueDestroy
+  ( PsychroQueue *Queue                 // (i) Queue to free, may be NULL
+  );
+
+size_t PsychroQueuePush                 // (o) Number of items pushed, fewer than Count if the queue is full
+  ( PsychroQueue *Queue                 // (i) Queue
+  , const void *Items                   // (i) Items to push, in order
+  , size_t Count                        // (i) Number of items
+  );
+
+size_t PsychroQueuePop                  // (o) Number of items popped, fewer than Count if the queue is empty
+  ( PsychroQueue *Queue                 // (i) Queue
+  , void *Items                         // (o) Items popped, in order
+  , size_t Count                        // (i) Maximum number of items
+  );
+
+size_t PsychroQueueGetSize              // (o) Number of items in the queue, approximate if it is in use
+  ( PsychroQueue *Queue                 // (i) Queue
+  );
+
+
+/******************************************************************************************************
+ * Readings and stages
+ *****************************************************************************************************/
+
+enum { PSYCHRO_READING_FRAME_SIZE = 32 };
+
+// Reading of a sensor through the pipeline. The raw frame is parsed by a map stage into the
+// properties, the compute stage calculates the properties that are not inputs of its function.
+struct PsychroReading
+{
+  uint64_t Sensor;                      // Identifier of the sensor
+  double Time;                          // Time of the reading, free for the stages
+  unsigned char Frame[PSYCHRO_READING_FRAME_SIZE]; // Raw frame of the sensor, free for the stages
+  double TDryBulb;                      // Dry bulb temperature in °F [IP] or °C [SI]
+  double RelHum;                        // Relative humidity [0-1]
+  double TWetBulb;                      // Wet bulb temperature in °F [IP] or °C [SI]
+  double TDewPoint;                     // Dew point temperature in °F [IP] or °C [SI]
+  double Pressure;                      // Atmospheric pressure in Psi [IP] or Pa [SI]
+  double HumRatio;                      // Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  double VapPres;                       // Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  double MoistAirEnthalpy;              // Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  double MoistAirVolume;                // Specific volume of moist air in ft³ lb⁻¹ of dry air [IP] or in m³ kg⁻¹ of dry air [SI]
+  double DegreeOfSaturation;            // Degree of saturation [unitless]
+  double Entered;                       // Time of the push into the pipeline in s on a monotonic clock, set by the pipeline
+};
+
+enum PsychroStageKind
+{
+  PSYCHRO_STAGE_MAP,                    // Callback on each reading, which can drop it (parsing, validation, conversion)
+  PSYCHRO_STAGE_COMPUTE,                // Psychrometric properties of each reading, NaN outside the range of the equations
+  PSYCHRO_STAGE_SINK                    // Callback on each batch of readings, last stage (aggregation)
+};
+
+// Inputs of the compute stage, with the dry bulb temperature and the pressure
+enum PsychroStageInput
+{
+  PSYCHRO_STAGE_FROM_REL_HUM,           // Relative humidity
+  PSYCHRO_STAGE_FROM_TWET_BULB,         // Wet bulb temperature
+  PSYCHRO_STAGE_FROM_TDEW_POINT         // Dew point temperature
+};
+
+struct PsychroStageConfig
+{
+  enum PsychroStageKind Kind;
+  unsigned Workers;                     // Number of threads of the stage, at least 1
+  size_t BatchSize;                     // Maximum number of readings processed together, 0 for 256
+  double MaxLatency;                    // Maximum time in s to wait for a batch to fill before processing it
+  size_t QueueCapacity;                 // Number of readings of the input queue of the stage, 0 for 4096
+  enum PsychroStageInput Input;         // Inputs of a compute stage
+  int (*Map)(void *Context, struct PsychroReading *Reading); // Map stage: 0 to pass the reading on, other values to drop it
+  void (*Sink)(void *Context, const struct PsychroReading *Readings, size_t Count); // Sink stage
+  void *Context;                        // First argument of the callbacks, shared by the workers of the stage
+};
+
+struct PsychroStageStats
+{
+  uint64_t Readings;                    // Number of readings processed
+  uint64_t Dropped;                     // Number of readings dropped by a map stage
+  uint64_t Batches;                     // Number of batches processed
+  uint64_t Stalls;                      // Number of waits on a full output queue (backpressure)
+  size_t QueueSize;                     // Number of readings in the input queue of the stage
+  double BusyTime;                      // Time in s spent processing batches, summed over the workers
+  double Throughput;                    // Readings processed per second since the creation of the pipeline
+  double MeanLatency;                   // Mean time in s from the push of a reading into the pipeline to the end of the stage
+  double MaxLatency;                    // Maximum time in s from the push of a reading to the end of the stage
+};
+
+
+/******************************************************************************************************
+ * Pipelines
+ *****************************************************************************************************/
+
+typedef struct PsychroPipeline PsychroPipeline;
+
+PsychroPipeline *PsychroPipelineCreate  // (o) New running pipeline, NULL if the configuration is invalid or out of resources
+  ( const struct PsychroStageConfig *Stages // (i) Configuration of each stage, in order
+  , size_t NStages                      // (i) Number of stages
+  , unsigned Producers                  // (i) Number of threads that push readings, 0 for any
+  );
+
+int PsychroPipelinePush                 // (o) 0 on success, -1 if the pipeline is closed
+  ( PsychroPipeline *Pipeline           // (i) Pipeline
+  , const struct PsychroReading *Reading // (i) Reading, waiting while the input queue of the first stage is full
+  );
+
+int PsychroPipelineTryPush              // (o) 0 on success, 1 if the input queue of the first stage is full, -1 if the pipeline is closed
+  ( PsychroPipeline *Pipeline           // (i) Pipeline
+  , const struct PsychroReading *Reading // (i) Reading
+  );
+
+int PsychroPipelinePop                  // (o) 1 if a reading is popped, 0 if none is ready, -1 once the pipeline is closed and drained
+  ( PsychroPipeline *Pipeline           // (i) Pipeline whose last stage is not a sink, popped by one thread
+  , struct PsychroReading *Reading      // (o) Reading out of the last stage
+  );
+
+void PsychroPipelineClose
+  ( PsychroPipeline *Pipeline           // (i) Pipeline, which processes the readings pushed before and accepts no more
+  );
+
+void PsychroPipelineGetStats
+  ( PsychroPipeline *Pipeline           // (i) Pipeline
+  , size_t Stage                        // (i) Index of the stage
+  , struct PsychroStageStats *Stats     // (o) Counters of the stage since the creation of the pipeline
+  );
+
+void PsychroPipelineFinish
+  ( PsychroPipeline *Pipeline           // (i) Pipeline to close, waiting until its stages have processed the readings pushed; readings not popped are discarded
+  );
+
+void PsychroPipelineDestroy
+  ( PsychroPipeline *Pipeline           // (i) Pipeline to finish and free, may be NULL
+  );
+
+#endif // PSYCHROLIB_PIPELINE_H
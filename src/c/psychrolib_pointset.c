@@ -0,0 +1,398 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Point sets: persistent inputs and outputs of CalcPsychrometricsFromRelHum for many points,
+ *  recomputed incrementally from a bitmap of the rows whose inputs changed.
+ *
+ *  Building management systems poll large sets of sensors whose readings mostly do not change
+ *  between polls. A point set keeps the dry-bulb temperature, relative humidity and pressure of
+ *  each row, and the outputs of CalcPsychrometricsFromRelHum calculated from them. Updating the
+ *  inputs of a row marks it dirty in a bitmap only if they differ from the stored inputs, so that
+ *  a whole poll can be written to the point set. Recomputing then calculates the dirty rows only,
+ *  found a word of the bitmap at a time, in the calling thread or split between threads by their
+ *  number of dirty rows.
+ *
+ *  The recomputation returns the rows whose outputs changed, for change data capture: a row is
+ *  reported when any of its outputs differs by more than its threshold from the value of the
+ *  output when the row was last reported, or when it is computed for the first time. Comparing
+ *  with the reported values rather than with the previous ones reports slow drifts once they
+ *  add up to the threshold. The point set therefore holds the inputs, the outputs and the last
+ *  reported outputs: 17 doubles per row.
+ *
+ *  The inputs are checked when they are updated, against the ranges of the generic functions:
+ *  invalid inputs are rejected and leave the row unchanged, so that a faulty sensor does not stop
+ *  the program when the point set is recomputed. The outputs are those of the generic function.
+ *  Updates and recomputations of a point set must not run concurrently; the point sets are
+ *  independent of each other. The system of units must not be changed while a point set is in
+ *  use.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_pointset.h"
+ *  SetUnitSystem(SI);
+ *  struct PsychroPointSetConfig Config = { 500000, { 1e-5, 0.05, 0.05, 1., 100., 1e-3, 1e-3 } };
+ *  PsychroPointSet *Set = PsychroPointSetCreate(&Config);
+ *  size_t *ChangedRows = malloc(Config.Count * sizeof(size_t));
+ *  PsychroPointSetUpdateRange(Set, 0, Config.Count, TDryBulb, RelHum, Pressure, NULL);
+ *  size_t NChanged = PsychroPointSetRecompute(Set, 4, ChangedRows);
+ *  const double *TWetBulb = PsychroPointSetGetOutput(Set, PSYCHRO_POINT_TWET_BULB);
+ *  PsychroPointSetDestroy(Set);
+ */
+
+// Standard C header files
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_pointset.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define MAX_THREADS 64              // Maximum number of threads of a recomputation.
+
+#define N_INPUTS 3                  // Dry-bulb temperature, relative humidity and pressure.
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+struct PsychroPointSet
+{
+  size_t Count;
+  size_t NWords;                                // Number of words of the bitmaps
+  size_t DirtyCount;
+  double Thresholds[PSYCHRO_POINT_N_OUTPUTS];
+  double *Inputs[N_INPUTS];                     // NaN until the row is updated
+  double *Outputs[PSYCHRO_POINT_N_OUTPUTS];     // NaN until the row is computed
+  double *Reported[PSYCHRO_POINT_N_OUTPUTS];    // Outputs when the row was last reported, NaN until then
+  uint64_t *Dirty;                              // Rows whose inputs changed since the last recomputation
+  uint64_t *Changed;                            // Rows reported by the last recomputation
+};
+
+// Words of the bitmaps recomputed by a thread
+struct Worker
+{
+  PsychroPointSet *Set;
+  size_t FirstWord;
+  size_t LastWord;
+};
+
+static int CountBits_
+  ( uint64_t Word
+  )
+{
+#if defined(__GNUC__)
+  return __builtin_popcountll(Word);
+#else
+  int n = 0;
+  for (; Word != 0; Word &= Word - 1)
+    n++;
+  return n;
+#endif
+}
+
+static int LowestBit_
+  ( uint64_t Word               // (i) Nonzero word
+  )
+{
+#if defined(__GNUC__)
+  return __builtin_ctzll(Word);
+#else
+  int n = 0;
+  for (; !(Word & 1); Word >>= 1)
+    n++;
+  return n;
+#endif
+}
+
+// Update the inputs of a row and mark it dirty if they changed
+static int Update_
+  ( PsychroPointSet *Set
+  , size_t Row
+  , double TDryBulb
+  , double RelHum
+  , double Pressure
+  )
+{
+  uint64_t Bit = (uint64_t) 1 << (Row % 64);
+
+  if (!(TDryBulb >= (isIP() ? -148. : -100.) && TDryBulb <= (isIP() ? 392. : 200.) && RelHum >= 0. && RelHum <= 1.
+        && Pressure > 0. && isfinite(Pressure)))
+    return -1;
+  if (TDryBulb == Set->Inputs[0][Row] && RelHum == Set->Inputs[1][Row] && Pressure == Set->Inputs[2][Row])
+    return 0;
+  Set->Inputs[0][Row] = TDryBulb;
+  Set->Inputs[1][Row] = RelHum;
+  Set->Inputs[2][Row] = Pressure;
+  if (!(Set->Dirty[Row / 64] & Bit))
+  {
+    Set->Dirty[Row / 64] |= Bit;
+    Set->DirtyCount++;
+  }
+  return 1;
+}
+
+// Recompute the dirty rows of a range of words of the bitmaps
+static void Recompute_
+  ( struct Worker *Worker
+  )
+{
+  PsychroPointSet *Set = Worker->Set;
+  double Values[PSYCHRO_POINT_N_OUTPUTS];
+  uint64_t Bits, Changed;
+  size_t w, Row;
+  int k, Report;
+
+  for (w = Worker->FirstWord; w < Worker->LastWord; w++)
+  {
+    Changed = 0;
+    for (Bits = Set->Dirty[w]; Bits != 0; Bits &= Bits - 1)
+    {
+      Row = w * 64 + LowestBit_(Bits);
+      CalcPsychrometricsFromRelHum(Set->Inputs[0][Row], Set->Inputs[1][Row], Set->Inputs[2][Row], &Values[0],
+        &Values[1], &Values[2], &Values[3], &Values[4], &Values[5], &Values[6]);
+      Report = 0;
+      for (k = 0; k < PSYCHRO_POINT_N_OUTPUTS; k++)
+      {
+        Set->Outputs[k][Row] = Values[k];
+        // Also true for rows never reported, whose reported values are NaN
+        Report |= !(fabs(Values[k] - Set->Reported[k][Row]) <= Set->Thresholds[k]);
+      }
+      if (Report)
+      {
+        for (k = 0; k < PSYCHRO_POINT_N_OUTPUTS; k++)
+          Set->Reported[k][Row] = Values[k];
+        Changed |= Bits & -Bits;
+      }
+    }
+    Set->Dirty[w] = 0;
+    Set->Changed[w] = Changed;
+  }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI Thread_(LPVOID Worker)
+{
+  Recompute_(Worker);
+  return 0;
+}
+#else
+static void *Thread_(void *Worker)
+{
+  Recompute_(Worker);
+  return NULL;
+}
+#endif
+
+
+/******************************************************************************************************
+ * Point set management
+ *****************************************************************************************************/
+
+PsychroPointSet *PsychroPointSetCreate  // (o) New point set with no inputs, NULL if the configuration is invalid or out of memory
+  ( const struct PsychroPointSetConfig *Config // (i) Number of rows and thresholds of the reported changes
+  )
+{
+  const size_t N_COLUMNS = N_INPUTS + 2 * PSYCHRO_POINT_N_OUTPUTS;
+  PsychroPointSet *Set;
+  double *Columns;
+  size_t i;
+  int k;
+
+  if (Config->Count == 0 || Config->Count > SIZE_MAX / sizeof(double) / N_COLUMNS)
+    return NULL;
+  for (k = 0; k < PSYCHRO_POINT_N_OUTPUTS; k++)
+    if (!(Config->Thresholds[k] >= 0.))
+      return NULL;
+
+  Set = calloc(1, sizeof(PsychroPointSet));
+  if (Set == NULL)
+    return NULL;
+  Set->Count = Config->Count;
+  Set->NWords = (Config->Count + 63) / 64;
+  Columns = malloc(N_COLUMNS * Config->Count * sizeof(double));
+  Set->Dirty = calloc(Set->NWords, sizeof(uint64_t));
+  Set->Changed = calloc(Set->NWords, sizeof(uint64_t));
+  if (Columns == NULL || Set->Dirty == NULL || Set->Changed == NULL)
+  {
+    free(Columns);
+    free(Set->Dirty);
+    free(Set->Changed);
+    free(Set);
+    return NULL;
+  }
+  for (i = 0; i < N_COLUMNS * Config->Count; i++)
+    Columns[i] = NAN;
+  for (k = 0; k < N_INPUTS; k++)
+    Set->Inputs[k] = Columns + k * Config->Count;
+  for (k = 0; k < PSYCHRO_POINT_N_OUTPUTS; k++)
+  {
+    Set->Thresholds[k] = Config->Thresholds[k];
+    Set->Outputs[k] = Columns + (N_INPUTS + k) * Config->Count;
+    Set->Reported[k] = Columns + (N_INPUTS + PSYCHRO_POINT_N_OUTPUTS + k) * Config->Count;
+  }
+  return Set;
+}
+
+void PsychroPointSetDestroy
+  ( PsychroPointSet *Set                // (i) Point set to free, may be NULL
+  )
+{
+  if (Set == NULL)
+    return;
+  free(Set->Inputs[0]);
+  free(Set->Dirty);
+  free(Set->Changed);
+  free(Set);
+}
+
+size_t PsychroPointSetGetDirtyCount     // (o) Number of rows whose inputs changed since the last recomputation
+  ( const PsychroPointSet *Set          // (i) Point set
+  )
+{
+  return Set->DirtyCount;
+}
+
+const double *PsychroPointSetGetOutput  // (o) Output of each row at the last recomputation, NaN for rows never computed
+  ( const PsychroPointSet *Set          // (i) Point set
+  , enum PsychroPointOutput Output      // (i) Output
+  )
+{
+  return (unsigned) Output < PSYCHRO_POINT_N_OUTPUTS ? Set->Outputs[Output] : NULL;
+}
+
+
+/******************************************************************************************************
+ * Updates and recomputation
+ *****************************************************************************************************/
+
+// Update the inputs of a row, marking it dirty if they changed.
+int PsychroPointSetUpdate               // (o) 1 if the inputs changed, 0 if not, -1 if they or the row are invalid and the row is unchanged
+  ( PsychroPointSet *Set                // (i) Point set
+  , size_t Row                          // (i) Row
+  , double TDryBulb                     // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double RelHum                       // (i) Relative humidity [0-1]
+  , double Pressure                     // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  if (Row >= Set->Count)
+    return -1;
+  return Update_(Set, Row, TDryBulb, RelHum, Pressure);
+}
+
+// Update the inputs of consecutive rows, marking dirty those whose inputs changed.
+size_t PsychroPointSetUpdateRange       // (o) Number of rows whose inputs changed
+  ( PsychroPointSet *Set                // (i) Point set
+  , size_t First                        // (i) First row
+  , size_t Count                        // (i) Number of rows
+  , const double *TDryBulb              // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *RelHum                // (i) Relative humidity [0-1]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , size_t *InvalidCount                // (o) Number of rows with invalid inputs, left unchanged, may be NULL; all if the range is invalid
+  )
+{
+  size_t i, NChanged = 0, NInvalid = 0;
+  int Status;
+
+  if (First > Set->Count || Count > Set->Count - First)
+  {
+    if (InvalidCount != NULL)
+      *InvalidCount = Count;
+    return 0;
+  }
+  for (i = 0; i < Count; i++)
+  {
+    Status = Update_(Set, First + i, TDryBulb[i], RelHum[i], Pressure[i]);
+    NChanged += Status == 1;
+    NInvalid += Status == -1;
+  }
+  if (InvalidCount != NULL)
+    *InvalidCount = NInvalid;
+  return NChanged;
+}
+
+// Recompute the dirty rows, and list the rows whose outputs changed beyond the thresholds since
+// they were last reported.
+size_t PsychroPointSetRecompute         // (o) Number of rows whose outputs changed beyond the thresholds
+  ( PsychroPointSet *Set                // (i) Point set
+  , unsigned Threads                    // (i) Number of threads, 0 or 1 to recompute in the calling thread
+  , size_t *ChangedRows                 // (o) Rows whose outputs changed beyond the thresholds, in increasing order, room for all rows; may be NULL
+  )
+{
+  struct Worker Workers[MAX_THREADS];
+  size_t w, Done, Target, NChanged = 0;
+  uint64_t Bits;
+  unsigned t, NThreads;
+  int Started[MAX_THREADS] = { 0 };
+#if defined(_WIN32)
+  HANDLE Handles[MAX_THREADS];
+#else
+  pthread_t Handles[MAX_THREADS];
+#endif
+
+  NThreads = Threads < 1 ? 1 : Threads > MAX_THREADS ? MAX_THREADS : Threads;
+  if (Set->DirtyCount < 64 * (size_t) NThreads)
+    NThreads = 1;
+
+  // Split the words between the threads by their number of dirty rows
+  for (t = 0, w = 0, Done = 0; t < NThreads; t++)
+  {
+    Workers[t].Set = Set;
+    Workers[t].FirstWord = w;
+    Target = t + 1 == NThreads ? Set->DirtyCount : Set->DirtyCount / NThreads * (t + 1);
+    while (w < Set->NWords && (Done < Target || t + 1 == NThreads))
+      Done += CountBits_(Set->Dirty[w++]);
+    Workers[t].LastWord = w;
+  }
+
+  // Threads that cannot be started are run in the calling thread
+  for (t = 1; t < NThreads; t++)
+  {
+#if defined(_WIN32)
+    Handles[t] = CreateThread(NULL, 0, Thread_, &Workers[t], 0, NULL);
+    Started[t] = Handles[t] != NULL;
+#else
+    Started[t] = pthread_create(&Handles[t], NULL, Thread_, &Workers[t]) == 0;
+#endif
+  }
+  Recompute_(&Workers[0]);
+  for (t = 1; t < NThreads; t++)
+  {
+    if (!Started[t])
+      Recompute_(&Workers[t]);
+    else
+    {
+#if defined(_WIN32)
+      WaitForSingleObject(Handles[t], INFINITE);
+      CloseHandle(Handles[t]);
+#else
+      pthread_join(Handles[t], NULL);
+#endif
+    }
+  }
+  Set->DirtyCount = 0;
+
+  for (w = 0; w < Set->NWords; w++)
+    for (Bits = Set->Changed[w]; Bits != 0; Bits &= Bits - 1)
+    {
+      if (ChangedRows != NULL)
+        ChangedRows[NChanged] = w * 64 + LowestBit_(Bits);
+      NChanged++;
+    }
+  return NChanged;
+}
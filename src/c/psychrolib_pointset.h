@@ -0,0 +1,92 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Point sets: persistent inputs and outputs of CalcPsychrometricsFromRelHum for many points,
+ * recomputed incrementally from a bitmap of the rows whose inputs changed.
+ * See psychrolib_pointset.c for details.
+*/
+
+#ifndef PSYCHROLIB_POINTSET_H
+#define PSYCHROLIB_POINTSET_H
+
+#include <stddef.h>
+
+
+/******************************************************************************************************
+ * Point set configuration
+ *****************************************************************************************************/
+
+typedef struct PsychroPointSet PsychroPointSet;
+
+// Outputs of CalcPsychrometricsFromRelHum, in the order of its arguments
+enum PsychroPointOutput
+{
+  PSYCHRO_POINT_HUM_RATIO,              // Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  PSYCHRO_POINT_TWET_BULB,              // Wet bulb temperature in °F [IP] or °C [SI]
+  PSYCHRO_POINT_TDEW_POINT,             // Dew point temperature in °F [IP] or °C [SI]
+  PSYCHRO_POINT_VAP_PRES,               // Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  PSYCHRO_POINT_MOIST_AIR_ENTHALPY,     // Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  PSYCHRO_POINT_MOIST_AIR_VOLUME,       // Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  PSYCHRO_POINT_DEGREE_OF_SATURATION,   // Degree of saturation [unitless]
+  PSYCHRO_POINT_N_OUTPUTS
+};
+
+struct PsychroPointSetConfig
+{
+  size_t Count;                         // Number of rows
+  double Thresholds[PSYCHRO_POINT_N_OUTPUTS]; // Change of each output since it was last reported above which a row is reported
+};
+
+
+/******************************************************************************************************
+ * Point set management
+ *****************************************************************************************************/
+
+PsychroPointSet *PsychroPointSetCreate  // (o) New point set with no inputs, NULL if the configuration is invalid or out of memory
+  ( const struct PsychroPointSetConfig *Config // (i) Number of rows and thresholds of the reported changes
+  );
+
+void PsychroPointSetDestroy
+  ( PsychroPointSet *Set                // (i) Point set to free, may be NULL
+  );
+
+size_t PsychroPointSetGetDirtyCount     // (o) Number of rows whose inputs changed since the last recomputation
+  ( const PsychroPointSet *Set          // (i) Point set
+  );
+
+const double *PsychroPointSetGetOutput  // (o) Output of each row at the last recomputation, NaN for rows never computed
+  ( const PsychroPointSet *Set          // (i) Point set
+  , enum PsychroPointOutput Output      // (i) Output
+  );
+
+
+/******************************************************************************************************
+ * Updates and recomputation
+ *****************************************************************************************************/
+
+int PsychroPointSetUpdate               // (o) 1 if the inputs changed, 0 if not, -1 if they or the row are invalid and the row is unchanged
+  ( PsychroPointSet *Set                // (i) Point set
+  , size_t Row                          // (i) Row
+  , double TDryBulb                     // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double RelHum                       // (i) Relative humidity [0-1]
+  , double Pressure                     // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+size_t PsychroPointSetUpdateRange       // (o) Number of rows whose inputs changed
+  ( PsychroPointSet *Set                // (i) Point set
+  , size_t First                        // (i) First row
+  , size_t Count                        // (i) Number of rows
+  , const double *TDryBulb              // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *RelHum                // (i) Relative humidity [0-1]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , size_t *InvalidCount                // (o) Number of rows with invalid inputs, left unchanged, may be NULL; all if the range is invalid
+  );
+
+size_t PsychroPointSetRecompute         // (o) Number of rows whose outputs changed beyond the thresholds
+  ( PsychroPointSet *Set                // (i) Point set
+  , unsigned Threads                    // (i) Number of threads, 0 or 1 to recompute in the calling thread
+  , size_t *ChangedRows                 // (o) Rows whose outputs changed beyond the thresholds, in increasing order, room for all rows; may be NULL
+  );
+
+#endif // PSYCHROLIB_POINTSET_H
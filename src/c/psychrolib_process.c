@@ -0,0 +1,422 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Air processes: mixing, heating, cooling and humidification of moist air on a state of dry-bulb
+ *  temperature, humidity ratio, pressure and enthalpy, without converting through relative humidity.
+ *
+ *  Simulations of air handlers chain processes whose balances are linear in the humidity ratio and
+ *  the enthalpy: mixing averages them weighted by the mass flow rates of dry air, heating adds to
+ *  the enthalpy, humidification adds to the humidity ratio and to the enthalpy the enthalpy of the
+ *  water. Written with the functions of relative humidity or wet-bulb temperature, each step
+ *  converts the state back and forth, with saturation pressures and iterative solutions. The state
+ *  of this module holds the dry-bulb temperature, humidity ratio and pressure, and the enthalpy
+ *  calculated from them, so that each process updates the humidity ratio and the enthalpy and
+ *  calculates the dry-bulb temperature from them in closed form with
+ *  GetTDryBulbFromEnthalpyAndHumRatio.
+ *
+ *  The saturation humidity ratio is calculated only where the air can reach saturation: when
+ *  mixing, removing heat, cooling and humidifying. Supersaturated air (e.g. the mixture of two
+ *  streams near saturation, or humidification beyond saturation) is clipped to the saturated state
+ *  of the same enthalpy, the water in excess being condensed (for humidifiers, the saturated state
+ *  reached with the water that evaporates, the rest not being added): this is the only iterative solution,
+ *  a Newton iteration with the analytic derivative of the saturation humidity ratio, and it runs
+ *  only for supersaturated air. Heating to a temperature needs no saturation at all.
+ *
+ *  The heats removed by cooling include the enthalpy of the condensate, taken as liquid water at
+ *  the temperature of the air leaving the process (or of the apparatus dew point for a coil). The
+ *  enthalpies of liquid water and steam are consistent with GetMoistAirEnthalpy: 4.186 T kJ kg⁻¹
+ *  (T - 32 Btu lb⁻¹) and 2501 + 1.86 T kJ kg⁻¹ (1061 + 0.444 T Btu lb⁻¹). Invalid inputs stop the
+ *  program, as in the generic functions.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_process.h"
+ *  SetUnitSystem(SI);
+ *  struct PsychroAirState Outdoor, Return, Supply;
+ *  double Condensate;
+ *  PsychroAirSetStateFromRelHum(&Outdoor, 32., 0.55, 101325.);
+ *  PsychroAirSetStateFromRelHum(&Return, 24., 0.50, 101325.);
+ *  PsychroAirMix(&Outdoor, 0.3, &Return, 0.7, &Supply);
+ *  double CoolingLoad = PsychroAirCoolTo(&Supply, 12., &Condensate);
+ *  double ReheatLoad = PsychroAirHeatTo(&Supply, 16.);
+ *  PsychroAirHeat(&Supply, 1000.);     // Fan heat
+ */
+
+// Standard C header files
+#include <math.h>
+#include <stddef.h>
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_process.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define SATURATION_TOLERANCE 1e-9       // Tolerance of the temperature of saturation in °F [IP] or °C [SI].
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+// Enthalpy of liquid water in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+static double WaterEnthalpy_
+  ( double TWater
+  )
+{
+  return isIP() ? TWater - 32. : 4186. * TWater;
+}
+
+// Enthalpy of water vapor in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+static double SteamEnthalpy_
+  ( double TSteam
+  )
+{
+  return isIP() ? H_VAPOR_IP + CP_VAPOR_IP * TSteam : (H_VAPOR_SI + CP_VAPOR_SI * TSteam) * 1000.;
+}
+
+// Update the temperature from the humidity ratio and the enthalpy
+static void UpdateTDryBulb_
+  ( struct PsychroAirState *State
+  )
+{
+  State->TDryBulb = GetTDryBulbFromEnthalpyAndHumRatio(State->MoistAirEnthalpy, State->HumRatio);
+}
+
+// Clip the state to saturation if it is supersaturated, the water in excess leaving with the given
+// enthalpy: the water that does not evaporate in a humidifier, or zero for condensate neglected
+static int ClipToSaturation_
+  ( struct PsychroAirState *State
+  , double WaterEnthalpy
+  )
+{
+  double T, Pws, SatHumRatio, dSatHumRatio, f, df, dT;
+  int index = 1;
+
+  if (State->HumRatio <= GetSatHumRatio(State->TDryBulb, State->Pressure))
+    return 0;
+
+  // Newton iteration on the temperature of the saturated air, which is above the temperature of the
+  // supersaturated air
+  T = State->TDryBulb;
+  do
+  {
+    Pws = GetSatVapPres(T);
+    SatHumRatio = 0.621945 * Pws / (State->Pressure - Pws);
+    dSatHumRatio = 0.621945 * State->Pressure * Pws * dLnPws_(T) / ((State->Pressure - Pws) * (State->Pressure - Pws));
+    f = GetMoistAirEnthalpy(T, SatHumRatio) - State->MoistAirEnthalpy
+      - (SatHumRatio - State->HumRatio) * WaterEnthalpy;
+    df = (isIP() ? CP_DRY_AIR_IP + CP_VAPOR_IP * SatHumRatio : (CP_DRY_AIR_SI + CP_VAPOR_SI * SatHumRatio) * 1000.)
+      + (SteamEnthalpy_(T) - WaterEnthalpy) * dSatHumRatio;
+    dT = f / df;
+    T -= dT;
+    ASSERT (index <= MAX_ITER_COUNT, "Convergence not reached in PsychroAirClipToSaturation. Stopping.")
+    index++;
+  }
+  while (fabs(dT) > SATURATION_TOLERANCE);
+
+  State->TDryBulb = T;
+  State->HumRatio = GetSatHumRatio(T, State->Pressure);
+  State->MoistAirEnthalpy = GetMoistAirEnthalpy(T, State->HumRatio);
+  return 1;
+}
+
+
+/******************************************************************************************************
+ * Air state
+ *****************************************************************************************************/
+
+void PsychroAirSetState
+  ( struct PsychroAirState *State       // (o) Air state
+  , double TDryBulb                     // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio                     // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure                     // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  ASSERT (HumRatio >= 0., "Humidity ratio is negative")
+  ASSERT (Pressure > 0., "Pressure is not positive")
+  State->TDryBulb = TDryBulb;
+  State->HumRatio = HumRatio;
+  State->Pressure = Pressure;
+  State->MoistAirEnthalpy = GetMoistAirEnthalpy(TDryBulb, HumRatio);
+}
+
+void PsychroAirSetStateFromRelHum
+  ( struct PsychroAirState *State       // (o) Air state
+  , double TDryBulb                     // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double RelHum                       // (i) Relative humidity [0-1]
+  , double Pressure                     // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  PsychroAirSetState(State, TDryBulb, GetHumRatioFromRelHum(TDryBulb, RelHum, Pressure), Pressure);
+}
+
+double PsychroAirGetRelHum              // (o) Relative humidity [0-1]
+  ( const struct PsychroAirState *State // (i) Air state
+  )
+{
+  return GetRelHumFromHumRatio(State->TDryBulb, State->HumRatio, State->Pressure);
+}
+
+// Condense the water in excess of saturation at constant enthalpy, neglecting the enthalpy of the
+// condensate.
+int PsychroAirClipToSaturation          // (o) 1 if the air was supersaturated and water condensed, 0 otherwise
+  ( struct PsychroAirState *State       // (i/o) Air state, saturated at the same enthalpy if it was supersaturated
+  )
+{
+  return ClipToSaturation_(State, 0.);
+}
+
+
+/******************************************************************************************************
+ * Processes
+ *****************************************************************************************************/
+
+// Adiabatic mixing of two streams, with the humidity ratio, the enthalpy and the pressure averaged
+// with the mass flow rates of dry air.
+int PsychroAirMix                       // (o) 1 if the mixture was supersaturated and clipped to saturation, 0 otherwise
+  ( const struct PsychroAirState *A     // (i) First stream
+  , double MassFlowA                    // (i) Mass flow rate of dry air of the first stream, in any unit
+  , const struct PsychroAirState *B     // (i) Second stream
+  , double MassFlowB                    // (i) Mass flow rate of dry air of the second stream, in the same unit
+  , struct PsychroAirState *Mixture     // (o) Mixed stream, may be A or B
+  )
+{
+  double FractionA;
+
+  ASSERT (MassFlowA >= 0. && MassFlowB >= 0. && MassFlowA + MassFlowB > 0., "Mass flow rates are negative or zero")
+  FractionA = MassFlowA / (MassFlowA + MassFlowB);
+  Mixture->HumRatio = FractionA * A->HumRatio + (1. - FractionA) * B->HumRatio;
+  Mixture->MoistAirEnthalpy = FractionA * A->MoistAirEnthalpy + (1. - FractionA) * B->MoistAirEnthalpy;
+  Mixture->Pressure = FractionA * A->Pressure + (1. - FractionA) * B->Pressure;
+  UpdateTDryBulb_(Mixture);
+  return ClipToSaturation_(Mixture, 0.);
+}
+
+// Heating or cooling at constant humidity ratio.
+int PsychroAirHeat                      // (o) 1 if the air was clipped to saturation, 0 otherwise
+  ( struct PsychroAirState *State       // (i/o) Air state
+  , double Heat                         // (i) Heat added at constant humidity ratio, e.g. the heat of a fan; negative to remove heat
+  )
+{
+  State->MoistAirEnthalpy += Heat;
+  UpdateTDryBulb_(State);
+  return Heat < 0. ? ClipToSaturation_(State, 0.) : 0;
+}
+
+// Sensible heating to a dry-bulb temperature.
+double PsychroAirHeatTo                 // (o) Heat added
+  ( struct PsychroAirState *State       // (i/o) Air state
+  , double TDryBulb                     // (i) Dry bulb temperature after heating, not below that of the state
+  )
+{
+  double MoistAirEnthalpy = State->MoistAirEnthalpy;
+
+  ASSERT (TDryBulb >= State->TDryBulb, "Temperature after heating is below the temperature of the air")
+  State->TDryBulb = TDryBulb;
+  State->MoistAirEnthalpy = GetMoistAirEnthalpy(TDryBulb, State->HumRatio);
+  return State->MoistAirEnthalpy - MoistAirEnthalpy;
+}
+
+// Cooling to a dry-bulb temperature, with the air saturated at that temperature if it is below
+// the dew point.
+double PsychroAirCoolTo                 // (o) Heat removed, including the enthalpy of the condensate
+  ( struct PsychroAirState *State       // (i/o) Air state, saturated if cooled below its dew point
+  , double TDryBulb                     // (i) Dry bulb temperature after cooling, not above that of the state
+  , double *Condensate                  // (o) Water condensed, may be NULL
+  )
+{
+  double MoistAirEnthalpy = State->MoistAirEnthalpy, HumRatio = State->HumRatio;
+
+  ASSERT (TDryBulb <= State->TDryBulb, "Temperature after cooling is above the temperature of the air")
+  State->TDryBulb = TDryBulb;
+  State->HumRatio = min(HumRatio, GetSatHumRatio(TDryBulb, State->Pressure));
+  State->MoistAirEnthalpy = GetMoistAirEnthalpy(TDryBulb, State->HumRatio);
+  if (Condensate != NULL)
+    *Condensate = HumRatio - State->HumRatio;
+  return MoistAirEnthalpy - State->MoistAirEnthalpy - (HumRatio - State->HumRatio) * WaterEnthalpy_(TDryBulb);
+}
+
+// Cooling coil of apparatus dew point and bypass factor: the air leaving the coil is the mixture of
+// the air that bypasses it and of the air that leaves it at the apparatus dew point, saturated if
+// the coil is wet.
+double PsychroAirCoolCoil               // (o) Heat removed, including the enthalpy of the condensate
+  ( struct PsychroAirState *State       // (i/o) Air state
+  , double TApparatusDewPoint           // (i) Apparatus dew point (temperature of the surface of the coil) in °F [IP] or °C [SI]
+  , double BypassFactor                 // (i) Fraction of the air that bypasses the coil [0-1]
+  , double *Condensate                  // (o) Water condensed, may be NULL
+  )
+{
+  double MoistAirEnthalpy = State->MoistAirEnthalpy, HumRatio = State->HumRatio, SurfaceHumRatio;
+
+  ASSERT (TApparatusDewPoint <= State->TDryBulb, "Apparatus dew point is above the temperature of the air")
+  ASSERT (BypassFactor >= 0. && BypassFactor <= 1., "Bypass factor is outside range [0, 1]")
+  SurfaceHumRatio = min(HumRatio, GetSatHumRatio(TApparatusDewPoint, State->Pressure));
+  State->HumRatio = BypassFactor * HumRatio + (1. - BypassFactor) * SurfaceHumRatio;
+  State->MoistAirEnthalpy = BypassFactor * MoistAirEnthalpy
+    + (1. - BypassFactor) * GetMoistAirEnthalpy(TApparatusDewPoint, SurfaceHumRatio);
+  UpdateTDryBulb_(State);
+  if (Condensate != NULL)
+    *Condensate = HumRatio - State->HumRatio;
+  return MoistAirEnthalpy - State->MoistAirEnthalpy - (HumRatio - State->HumRatio) * WaterEnthalpy_(TApparatusDewPoint);
+}
+
+// Humidification with steam to a humidity ratio, limited to saturation: the steam in excess is not
+// added.
+int PsychroAirHumidifySteam             // (o) 1 if the humidity ratio was limited by saturation, 0 otherwise
+  ( struct PsychroAirState *State       // (i/o) Air state
+  , double HumRatio                     // (i) Humidity ratio after humidification, not below that of the state
+  , double TSteam                       // (i) Temperature of the steam in °F [IP] or °C [SI]
+  )
+{
+  double SteamEnthalpy = SteamEnthalpy_(TSteam);
+
+  ASSERT (HumRatio >= State->HumRatio, "Humidity ratio after humidification is below the humidity ratio of the air")
+  State->MoistAirEnthalpy += (HumRatio - State->HumRatio) * SteamEnthalpy;
+  State->HumRatio = HumRatio;
+  UpdateTDryBulb_(State);
+  return ClipToSaturation_(State, SteamEnthalpy);
+}
+
+// Adiabatic humidification (evaporative cooling) with liquid water to a humidity ratio, limited to
+// saturation: the water in excess does not evaporate.
+int PsychroAirHumidifyAdiabatic         // (o) 1 if the humidity ratio was limited by saturation, 0 otherwise
+  ( struct PsychroAirState *State       // (i/o) Air state
+  , double HumRatio                     // (i) Humidity ratio after humidification, not below that of the state
+  , double TWater                       // (i) Temperature of the water evaporated in °F [IP] or °C [SI]
+  )
+{
+  double WaterEnthalpy = WaterEnthalpy_(TWater);
+
+  ASSERT (HumRatio >= State->HumRatio, "Humidity ratio after humidification is below the humidity ratio of the air")
+  State->MoistAirEnthalpy += (HumRatio - State->HumRatio) * WaterEnthalpy;
+  State->HumRatio = HumRatio;
+  UpdateTDryBulb_(State);
+  return ClipToSaturation_(State, WaterEnthalpy);
+}
+
+
+/******************************************************************************************************
+ * Batch processes over many air handlers
+ *****************************************************************************************************/
+
+size_t PsychroAirMixBatch               // (o) Number of mixtures clipped to saturation
+  ( size_t Count                        // (i) Number of air handlers
+  , const struct PsychroAirState *A     // (i) First streams
+  , const double *MassFlowA             // (i) Mass flow rates of dry air of the first streams
+  , const struct PsychroAirState *B     // (i) Second streams
+  , const double *MassFlowB             // (i) Mass flow rates of dry air of the second streams
+  , struct PsychroAirState *Mixture     // (o) Mixed streams, may be A or B
+  )
+{
+  size_t i, Clipped = 0;
+
+  for (i = 0; i < Count; i++)
+    Clipped += PsychroAirMix(&A[i], MassFlowA[i], &B[i], MassFlowB[i], &Mixture[i]);
+  return Clipped;
+}
+
+size_t PsychroAirHeatBatch              // (o) Number of states clipped to saturation
+  ( size_t Count                        // (i) Number of air handlers
+  , struct PsychroAirState *States      // (i/o) Air states
+  , const double *Heat                  // (i) Heats added
+  )
+{
+  size_t i, Clipped = 0;
+
+  for (i = 0; i < Count; i++)
+    Clipped += PsychroAirHeat(&States[i], Heat[i]);
+  return Clipped;
+}
+
+void PsychroAirHeatToBatch
+  ( size_t Count                        // (i) Number of air handlers
+  , struct PsychroAirState *States      // (i/o) Air states
+  , const double *TDryBulb              // (i) Dry bulb temperatures after heating
+  , double *Heat                        // (o) Heats added
+  )
+{
+  double Added;
+  size_t i;
+
+  for (i = 0; i < Count; i++)
+  {
+    Added = PsychroAirHeatTo(&States[i], TDryBulb[i]);
+    if (Heat != NULL)
+      Heat[i] = Added;
+  }
+}
+
+void PsychroAirCoolToBatch
+  ( size_t Count                        // (i) Number of air handlers
+  , struct PsychroAirState *States      // (i/o) Air states
+  , const double *TDryBulb              // (i) Dry bulb temperatures after cooling
+  , double *Heat                        // (o) Heats removed
+  , double *Condensate                  // (o) Water condensed
+  )
+{
+  double Removed;
+  size_t i;
+
+  for (i = 0; i < Count; i++)
+  {
+    Removed = PsychroAirCoolTo(&States[i], TDryBulb[i], Condensate != NULL ? &Condensate[i] : NULL);
+    if (Heat != NULL)
+      Heat[i] = Removed;
+  }
+}
+
+void PsychroAirCoolCoilBatch
+  ( size_t Count                        // (i) Number of air handlers
+  , struct PsychroAirState *States      // (i/o) Air states
+  , const double *TApparatusDewPoint    // (i) Apparatus dew points
+  , const double *BypassFactor          // (i) Bypass factors
+  , double *Heat                        // (o) Heats removed
+  , double *Condensate                  // (o) Water condensed
+  )
+{
+  double Removed;
+  size_t i;
+
+  for (i = 0; i < Count; i++)
+  {
+    Removed = PsychroAirCoolCoil(&States[i], TApparatusDewPoint[i], BypassFactor[i],
+      Condensate != NULL ? &Condensate[i] : NULL);
+    if (Heat != NULL)
+      Heat[i] = Removed;
+  }
+}
+
+size_t PsychroAirHumidifySteamBatch     // (o) Number of humidity ratios limited by saturation
+  ( size_t Count                        // (i) Number of air handlers
+  , struct PsychroAirState *States      // (i/o) Air states
+  , const double *HumRatio              // (i) Humidity ratios after humidification
+  , const double *TSteam                // (i) Temperatures of the steam
+  )
+{
+  size_t i, Clipped = 0;
+
+  for (i = 0; i < Count; i++)
+    Clipped += PsychroAirHumidifySteam(&States[i], HumRatio[i], TSteam[i]);
+  return Clipped;
+}
+
+size_t PsychroAirHumidifyAdiabaticBatch // (o) Number of humidity ratios limited by saturation
+  ( size_t Count                        // (i) Number of air handlers
+  , struct PsychroAirState *States      // (i/o) Air states
+  , const double *HumRatio              // (i) Humidity ratios after humidification
+  , const double *TWater                // (i) Temperatures of the water evaporated
+  )
+{
+  size_t i, Clipped = 0;
+
+  for (i = 0; i < Count; i++)
+    Clipped += PsychroAirHumidifyAdiabatic(&States[i], HumRatio[i], TWater[i]);
+  return Clipped;
+}
@@ -0,0 +1,160 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Air processes: mixing, heating, cooling and humidification of moist air on a state of dry-bulb
+ * temperature, humidity ratio, pressure and enthalpy, without converting through relative humidity.
+ * See psychrolib_process.c for details.
+*/
+
+#ifndef PSYCHROLIB_PROCESS_H
+#define PSYCHROLIB_PROCESS_H
+
+#include <stddef.h>
+
+
+/******************************************************************************************************
+ * Air state
+ *****************************************************************************************************/
+
+struct PsychroAirState
+{
+  double TDryBulb;                      // Dry bulb temperature in °F [IP] or °C [SI]
+  double HumRatio;                      // Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  double Pressure;                      // Atmospheric pressure in Psi [IP] or Pa [SI]
+  double MoistAirEnthalpy;              // Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI], consistent with the other members
+};
+
+void PsychroAirSetState
+  ( struct PsychroAirState *State       // (o) Air state
+  , double TDryBulb                     // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio                     // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure                     // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+void PsychroAirSetStateFromRelHum
+  ( struct PsychroAirState *State       // (o) Air state
+  , double TDryBulb                     // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double RelHum                       // (i) Relative humidity [0-1]
+  , double Pressure                     // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+double PsychroAirGetRelHum              // (o) Relative humidity [0-1]
+  ( const struct PsychroAirState *State // (i) Air state
+  );
+
+int PsychroAirClipToSaturation          // (o) 1 if the air was supersaturated and water condensed, 0 otherwise
+  ( struct PsychroAirState *State       // (i/o) Air state, saturated at the same enthalpy if it was supersaturated
+  );
+
+
+/******************************************************************************************************
+ * Processes
+ * Heats, condensates and water are per unit mass of dry air: heats in Btu lb⁻¹ [IP] or J kg⁻¹ [SI],
+ * condensates and water in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI].
+ *****************************************************************************************************/
+
+int PsychroAirMix                       // (o) 1 if the mixture was supersaturated and clipped to saturation, 0 otherwise
+  ( const struct PsychroAirState *A     // (i) First stream
+  , double MassFlowA                    // (i) Mass flow rate of dry air of the first stream, in any unit
+  , const struct PsychroAirState *B     // (i) Second stream
+  , double MassFlowB                    // (i) Mass flow rate of dry air of the second stream, in the same unit
+  , struct PsychroAirState *Mixture     // (o) Mixed stream, may be A or B
+  );
+
+int PsychroAirHeat                      // (o) 1 if the air was clipped to saturation, 0 otherwise
+  ( struct PsychroAirState *State       // (i/o) Air state
+  , double Heat                         // (i) Heat added at constant humidity ratio, e.g. the heat of a fan; negative to remove heat
+  );
+
+double PsychroAirHeatTo                 // (o) Heat added
+  ( struct PsychroAirState *State       // (i/o) Air state
+  , double TDryBulb                     // (i) Dry bulb temperature after heating, not below that of the state
+  );
+
+double PsychroAirCoolTo                 // (o) Heat removed, including the enthalpy of the condensate
+  ( struct PsychroAirState *State       // (i/o) Air state, saturated if cooled below its dew point
+  , double TDryBulb                     // (i) Dry bulb temperature after cooling, not above that of the state
+  , double *Condensate                  // (o) Water condensed, may be NULL
+  );
+
+double PsychroAirCoolCoil               // (o) Heat removed, including the enthalpy of the condensate
+  ( struct PsychroAirState *State       // (i/o) Air state
+  , double TApparatusDewPoint           // (i) Apparatus dew point (temperature of the surface of the coil) in °F [IP] or °C [SI]
+  , double BypassFactor                 // (i) Fraction of the air that bypasses the coil [0-1]
+  , double *Condensate                  // (o) Water condensed, may be NULL
+  );
+
+int PsychroAirHumidifySteam             // (o) 1 if the humidity ratio was limited by saturation, 0 otherwise
+  ( struct PsychroAirState *State       // (i/o) Air state
+  , double HumRatio                     // (i) Humidity ratio after humidification, not below that of the state
+  , double TSteam                       // (i) Temperature of the steam in °F [IP] or °C [SI]
+  );
+
+int PsychroAirHumidifyAdiabatic         // (o) 1 if the humidity ratio was limited by saturation, 0 otherwise
+  ( struct PsychroAirState *State       // (i/o) Air state
+  , double HumRatio                     // (i) Humidity ratio after humidification, not below that of the state
+  , double TWater                       // (i) Temperature of the water evaporated in °F [IP] or °C [SI]
+  );
+
+
+/******************************************************************************************************
+ * Batch processes over many air handlers
+ * Each element of the arrays belongs to one air handler. The output arrays of heats and
+ * condensates may be NULL.
+ *****************************************************************************************************/
+
+size_t PsychroAirMixBatch               // (o) Number of mixtures clipped to saturation
+  ( size_t Count                        // (i) Number of air handlers
+  , const struct PsychroAirState *A     // (i) First streams
+  , const double *MassFlowA             // (i) Mass flow rates of dry air of the first streams
+  , const struct PsychroAirState *B     // (i) Second streams
+  , const double *MassFlowB             // (i) Mass flow rates of dry air of the second streams
+  , struct PsychroAirState *Mixture     // (o) Mixed streams, may be A or B
+  );
+
+size_t PsychroAirHeatBatch              // (o) Number of states clipped to saturation
+  ( size_t Count                        // (i) Number of air handlers
+  , struct PsychroAirState *States      // (i/o) Air states
+  , const double *Heat                  // (i) Heats added
+  );
+
+void PsychroAirHeatToBatch
+  ( size_t Count                        // (i) Number of air handlers
+  , struct PsychroAirState *States      // (i/o) Air states
+  , const double *TDryBulb              // (i) Dry bulb temperatures after heating
+  , double *Heat                        // (o) Heats added
+  );
+
+void PsychroAirCoolToBatch
+  ( size_t Count                        // (i) Number of air handlers
+  , struct PsychroAirState *States      // (i/o) Air states
+  , const double *TDryBulb              // (i) Dry bulb temperatures after cooling
+  , double *Heat                        // (o) Heats removed
+  , double *Condensate                  // (o) Water condensed
+  );
+
+void PsychroAirCoolCoilBatch
+  ( size_t Count                        // (i) Number of air handlers
+  , struct PsychroAirState *States      // (i/o) Air states
+  , const double *TApparatusDewPoint    // (i) Apparatus dew points
+  , const double *BypassFactor          // (i) Bypass factors
+  , double *Heat                        // (o) Heats removed
+  , double *Condensate                  // (o) Water condensed
+  );
+
+size_t PsychroAirHumidifySteamBatch     // (o) Number of humidity ratios limited by saturation
+  ( size_t Count                        // (i) Number of air handlers
+  , struct PsychroAirState *States      // (i/o) Air states
+  , const double *HumRatio              // (i) Humidity ratios after humidification
+  , const double *TSteam                // (i) Temperatures of the steam
+  );
+
+size_t PsychroAirHumidifyAdiabaticBatch // (o) Number of humidity ratios limited by saturation
+  ( size_t Count                        // (i) Number of air handlers
+  , struct PsychroAirState *States      // (i/o) Air states
+  , const double *HumRatio              // (i) Humidity ratios after humidification
+  , const double *TWater                // (i) Temperatures of the water evaporated
+  );
+
+#endif // PSYCHROLIB_PROCESS_H
@@ -0,0 +1,443 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Reference functions: the ASHRAE equations of the generic functions of psychrolib.c, evaluated in
+ *  long double, or in __float128 when compiled with PSYCHROLIB_REFERENCE_FLOAT128 (GCC and
+ *  libquadmath, link with -lquadmath), with the solvers converged to the precision of the type
+ *  instead of PSYCHROLIB_TOLERANCE. The error of a function of the library, or of a faster
+ *  implementation of it, is its difference to the reference function at the same inputs; the
+ *  difference of the equations to the measured properties of moist air is not part of it.
+ *
+ *  The equations, constants and clamps to MIN_HUM_RATIO are those of psychrolib.c, with the
+ *  constants written as literals of the type. The dew-point temperature is solved with Newton
+ *  iterations on the logarithm of the saturation vapor pressure, as in GetTDewPointFromVapPres,
+ *  inside a bracket of the solution that is bisected when a step leaves it. The wet-bulb
+ *  temperature is solved with the bisection of GetTWetBulbFromHumRatio between the dew-point and
+ *  the dry-bulb temperatures, continued until the bracket is a few units in the last place wide.
+ *  The upper bound is lowered to the boiling point at the pressure when the dry-bulb temperature
+ *  is above it: the saturation humidity ratio is negative there, clamped to MIN_HUM_RATIO, and the
+ *  humidity ratio of eqn 33 and 35 is no longer increasing, so that the generic bisection converges
+ *  to the dry-bulb temperature whenever its first midpoint is above the boiling point.
+ *  Inputs outside the range of the equations return NaN instead of stopping the program, so that
+ *  a harness can evaluate dense grids up to the bounds of the domain.
+ *
+ *  benchmarks/c/bench_psychrolib_accuracy.c uses these functions to report the error and the time
+ *  per call of the generic, bounded and tabulated functions over grids of the domain.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_reference.h"
+ *  SetUnitSystem(SI);
+ *  double Error = GetTWetBulbFromRelHum(25., 0.5, 101325.)
+ *    - (double) ReferenceGetTWetBulbFromRelHum(25.L, 0.5L, 101325.L);
+ */
+
+// Standard C header files
+#include <float.h>
+#include <math.h>
+#ifdef PSYCHROLIB_REFERENCE_FLOAT128
+#include <quadmath.h>
+#endif
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_reference.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#ifdef PSYCHROLIB_REFERENCE_FLOAT128
+#define R_(x) x##Q                      // Literal of the reference type
+#define EXP_ expq
+#define LOG_ logq
+#define EPSILON_ FLT128_EPSILON
+#else
+#define R_(x) x##L
+#define EXP_ expl
+#define LOG_ logl
+#define EPSILON_ LDBL_EPSILON
+#endif
+
+#define R_DA_IP R_(53.350)              // Universal gas constant for dry air (IP version) in ft∙lbf/lb_da/R.
+                                        // Same as in psychrolib.c
+
+#define R_DA_SI R_(287.042)             // Universal gas constant for dry air (SI version) in J/kg_da/K.
+                                        // Same as in psychrolib.c
+
+// Constants of psychrolib_internal.h as literals of the reference type
+#undef MIN_HUM_RATIO
+#undef TRIPLE_POINT_WATER_SI
+#undef TRIPLE_POINT_WATER_IP
+#undef FREEZING_POINT_WATER_SI
+#undef FREEZING_POINT_WATER_IP
+#undef MAX_ITER_COUNT
+
+#define MIN_HUM_RATIO R_(1e-7)          // Minimum acceptable humidity ratio used/returned by any functions.
+                                        // Same as in psychrolib.c
+
+#define TRIPLE_POINT_WATER_SI R_(0.01)  // Triple point of water in °C. Same as in psychrolib.c
+#define TRIPLE_POINT_WATER_IP R_(32.018) // Triple point of water in °F. Same as in psychrolib.c
+#define FREEZING_POINT_WATER_SI R_(0.)  // Freezing point of water in °C. Same as in psychrolib.c
+#define FREEZING_POINT_WATER_IP R_(32.) // Freezing point of water in °F. Same as in psychrolib.c
+
+#define MAX_ITER_COUNT 400              // Maximum number of iterations of the solvers, beyond the
+                                        // about 120 bisections of a bracket to __float128 precision.
+
+#define REFERENCE_TOLERANCE (R_(8.) * EPSILON_) // Relative tolerance of the solutions, in units of
+                                        // max(1, |T|) in °F [IP] or °C [SI].
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+#define NAN_ ((PsychroRefReal) NAN)
+
+static int IsNaN_(PsychroRefReal x)
+{
+  return x != x;
+}
+
+// Maximum, NaN if a is NaN
+static PsychroRefReal Max_(PsychroRefReal a, PsychroRefReal b)
+{
+  return a > b || IsNaN_(a) ? a : b;
+}
+
+static PsychroRefReal Abs_(PsychroRefReal a)
+{
+  return a < 0 ? -a : a;
+}
+
+// Bounds of the range of the equations of the saturation vapor pressure in °F [IP] or °C [SI]
+static void Bounds_(PsychroRefReal *Low, PsychroRefReal *High)
+{
+  *Low = isIP() ? R_(-148.) : R_(-100.);
+  *High = isIP() ? R_(392.) : R_(200.);
+}
+
+// Tolerance of a solution near the temperature T
+static PsychroRefReal Tolerance_(PsychroRefReal T)
+{
+  return REFERENCE_TOLERANCE * Max_(R_(1.), Abs_(T));
+}
+
+// Natural logarithm of the saturation vapor pressure and its derivative, ASHRAE Handbook -
+// Fundamentals (2017) ch. 1 eqn 5 and 6, without range check
+static PsychroRefReal LnPws_(PsychroRefReal TDryBulb, PsychroRefReal *dLnPws)
+{
+  PsychroRefReal T, LnPws;
+
+  if (isIP())
+  {
+    T = TDryBulb + R_(459.67);
+    if (TDryBulb <= TRIPLE_POINT_WATER_IP)
+    {
+      LnPws = R_(-1.0214165E+04) / T - R_(4.8932428) - R_(5.3765794E-03) * T + R_(1.9202377E-07) * T * T
+        + R_(3.5575832E-10) * T * T * T - R_(9.0344688E-14) * T * T * T * T + R_(4.1635019) * LOG_(T);
+      *dLnPws = R_(1.0214165E+04) / (T * T) - R_(5.3765794E-03) + R_(2.) * R_(1.9202377E-07) * T
+        + R_(3.) * R_(3.5575832E-10) * T * T - R_(4.) * R_(9.0344688E-14) * T * T * T + R_(4.1635019) / T;
+    }
+    else
+    {
+      LnPws = R_(-1.0440397E+04) / T - R_(1.1294650E+01) - R_(2.7022355E-02) * T + R_(1.2890360E-05) * T * T
+        - R_(2.4780681E-09) * T * T * T + R_(6.5459673) * LOG_(T);
+      *dLnPws = R_(1.0440397E+04) / (T * T) - R_(2.7022355E-02) + R_(2.) * R_(1.2890360E-05) * T
+        - R_(3.) * R_(2.4780681E-09) * T * T + R_(6.5459673) / T;
+    }
+  }
+  else
+  {
+    T = TDryBulb + R_(273.15);
+    if (TDryBulb <= TRIPLE_POINT_WATER_SI)
+    {
+      LnPws = R_(-5.6745359E+03) / T + R_(6.3925247) - R_(9.677843E-03) * T + R_(6.2215701E-07) * T * T
+        + R_(2.0747825E-09) * T * T * T - R_(9.484024E-13) * T * T * T * T + R_(4.1635019) * LOG_(T);
+      *dLnPws = R_(5.6745359E+03) / (T * T) - R_(9.677843E-03) + R_(2.) * R_(6.2215701E-07) * T
+        + R_(3.) * R_(2.0747825E-09) * T * T - R_(4.) * R_(9.484024E-13) * T * T * T + R_(4.1635019) / T;
+    }
+    else
+    {
+      LnPws = R_(-5.8002206E+03) / T + R_(1.3914993) - R_(4.8640239E-02) * T + R_(4.1764768E-05) * T * T
+        - R_(1.4452093E-08) * T * T * T + R_(6.5459673) * LOG_(T);
+      *dLnPws = R_(5.8002206E+03) / (T * T) - R_(4.8640239E-02) + R_(2.) * R_(4.1764768E-05) * T
+        - R_(3.) * R_(1.4452093E-08) * T * T + R_(6.5459673) / T;
+    }
+  }
+  return LnPws;
+}
+
+static PsychroRefReal HumRatioFromVapPres_(PsychroRefReal VapPres, PsychroRefReal Pressure)
+{
+  return Max_(R_(0.621945) * VapPres / (Pressure - VapPres), MIN_HUM_RATIO);
+}
+
+
+/******************************************************************************************************
+ * Reference functions
+ *****************************************************************************************************/
+
+// Return saturation vapor pressure given dry-bulb temperature.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 5 & 6
+PsychroRefReal ReferenceGetSatVapPres   // (o) Vapor Pressure of saturated air in Psi [IP] or Pa [SI], NaN outside the range of the equations
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  )
+{
+  PsychroRefReal Low, High, dLnPws;
+
+  Bounds_(&Low, &High);
+  if (!(TDryBulb >= Low && TDryBulb <= High))
+    return NAN_;
+  return EXP_(LnPws_(TDryBulb, &dLnPws));
+}
+
+// Return humidity ratio of saturated air given dry-bulb temperature and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 36, solved for W
+PsychroRefReal ReferenceGetSatHumRatio  // (o) Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  return HumRatioFromVapPres_(ReferenceGetSatVapPres(TDryBulb), Pressure);
+}
+
+// Return humidity ratio given dry-bulb temperature, relative humidity, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+PsychroRefReal ReferenceGetHumRatioFromRelHum // (o) Humidity Ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal RelHum               // (i) Relative humidity [0-1]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  if (!(RelHum >= 0 && RelHum <= 1))
+    return NAN_;
+  return HumRatioFromVapPres_(RelHum * ReferenceGetSatVapPres(TDryBulb), Pressure);
+}
+
+// Return humidity ratio given dry-bulb temperature, wet-bulb temperature, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 33 and 35
+PsychroRefReal ReferenceGetHumRatioFromTWetBulb // (o) Humidity Ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal TWetBulb             // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  PsychroRefReal Wsstar, HumRatio;
+
+  if (!(TWetBulb <= TDryBulb))
+    return NAN_;
+
+  Wsstar = ReferenceGetSatHumRatio(TWetBulb, Pressure);
+
+  if (isIP())
+  {
+    if (TWetBulb >= FREEZING_POINT_WATER_IP)
+      HumRatio = ((R_(1093.) - R_(0.556) * TWetBulb) * Wsstar - R_(0.240) * (TDryBulb - TWetBulb))
+      / (R_(1093.) + R_(0.444) * TDryBulb - TWetBulb);
+    else
+      HumRatio = ((R_(1220.) - R_(0.04) * TWetBulb) * Wsstar - R_(0.240) * (TDryBulb - TWetBulb))
+      / (R_(1220.) + R_(0.444) * TDryBulb - R_(0.48) * TWetBulb);
+  }
+  else
+  {
+    if (TWetBulb >= FREEZING_POINT_WATER_SI)
+      HumRatio = ((R_(2501.) - R_(2.326) * TWetBulb) * Wsstar - R_(1.006) * (TDryBulb - TWetBulb))
+         / (R_(2501.) + R_(1.86) * TDryBulb - R_(4.186) * TWetBulb);
+    else
+      HumRatio = ((R_(2830.) - R_(0.24) * TWetBulb) * Wsstar - R_(1.006) * (TDryBulb - TWetBulb))
+         / (R_(2830.) + R_(1.86) * TDryBulb - R_(2.1) * TWetBulb);
+  }
+  return Max_(HumRatio, MIN_HUM_RATIO);
+}
+
+// Return dew-point temperature given dry-bulb temperature and vapor pressure, converged to the
+// precision of the type.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 5 and 6
+PsychroRefReal ReferenceGetTDewPointFromVapPres // (o) Dew Point temperature in °F [IP] or °C [SI], NaN outside the range of the equations
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal VapPres              // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  )
+{
+  PsychroRefReal Low, High, LnVP, LnPws, dLnPws, TDewPoint, Step;
+  int index;
+
+  Bounds_(&Low, &High);
+  if (IsNaN_(TDryBulb) || !(VapPres >= ReferenceGetSatVapPres(Low) && VapPres <= ReferenceGetSatVapPres(High)))
+    return NAN_;
+
+  // Newton iterations from the dry-bulb temperature, as in GetTDewPointFromVapPres, keeping
+  // [Low, High] around the solution since the logarithm of Pws is increasing
+  LnVP = LOG_(VapPres);
+  TDewPoint = TDryBulb < Low ? Low : (TDryBulb > High ? High : TDryBulb);
+  for (index = 0; index < MAX_ITER_COUNT; index++)
+  {
+    LnPws = LnPws_(TDewPoint, &dLnPws);
+    if (LnPws == LnVP)
+      break;
+    if (LnPws > LnVP)
+      High = TDewPoint;
+    else
+      Low = TDewPoint;
+    Step = (LnPws - LnVP) / dLnPws;
+    if (!(TDewPoint - Step > Low && TDewPoint - Step < High))
+      Step = TDewPoint - (Low + High) / 2;
+    TDewPoint -= Step;
+    if (Abs_(Step) <= Tolerance_(TDewPoint) || High - Low <= Tolerance_(TDewPoint))
+      break;
+  }
+  return TDewPoint < TDryBulb ? TDewPoint : TDryBulb;
+}
+
+// Return dew-point temperature given dry-bulb temperature and relative humidity.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+PsychroRefReal ReferenceGetTDewPointFromRelHum // (o) Dew Point temperature in °F [IP] or °C [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal RelHum               // (i) Relative humidity [0-1]
+  )
+{
+  if (!(RelHum >= 0 && RelHum <= 1))
+    return NAN_;
+  return ReferenceGetTDewPointFromVapPres(TDryBulb, RelHum * ReferenceGetSatVapPres(TDryBulb));
+}
+
+// Return dew-point temperature given dry-bulb temperature, humidity ratio, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+PsychroRefReal ReferenceGetTDewPointFromHumRatio // (o) Dew Point temperature in °F [IP] or °C [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  PsychroRefReal BoundedHumRatio;
+
+  if (!(HumRatio >= 0))
+    return NAN_;
+  BoundedHumRatio = Max_(HumRatio, MIN_HUM_RATIO);
+  return ReferenceGetTDewPointFromVapPres(TDryBulb, Pressure * BoundedHumRatio / (R_(0.621945) + BoundedHumRatio));
+}
+
+// Return wet-bulb temperature given dry-bulb temperature, humidity ratio, and pressure, converged
+// to the precision of the type.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 33 and 35 solved for Tstar
+PsychroRefReal ReferenceGetTWetBulbFromHumRatio // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  PsychroRefReal BoundedHumRatio, TWetBulb, TWetBulbSup, TWetBulbInf, Low, High, Tolerance;
+  int index;
+
+  Bounds_(&Low, &High);
+  if (!(HumRatio >= 0 && TDryBulb >= Low && TDryBulb <= High))
+    return NAN_;
+  BoundedHumRatio = Max_(HumRatio, MIN_HUM_RATIO);
+
+  // Same bisection as GetTWetBulbFromHumRatio, to a bracket of a few units in the last place,
+  // below the boiling point
+  TWetBulbSup = TDryBulb;
+  if (ReferenceGetSatVapPres(TDryBulb) >= Pressure)
+    TWetBulbSup = ReferenceGetTDewPointFromVapPres(TDryBulb, Pressure);
+  TWetBulbInf = ReferenceGetTDewPointFromHumRatio(TDryBulb, BoundedHumRatio, Pressure);
+  if (IsNaN_(TWetBulbInf))
+    return NAN_;
+  Tolerance = Tolerance_(Max_(Abs_(TWetBulbSup), Abs_(TWetBulbInf)));
+  TWetBulb = (TWetBulbInf + TWetBulbSup) / 2;
+  for (index = 0; index < MAX_ITER_COUNT && TWetBulbSup - TWetBulbInf > Tolerance; index++)
+  {
+    if (ReferenceGetHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure) > BoundedHumRatio)
+      TWetBulbSup = TWetBulb;
+    else
+      TWetBulbInf = TWetBulb;
+    TWetBulb = (TWetBulbSup + TWetBulbInf) / 2;
+  }
+  return TWetBulb;
+}
+
+// Return wet-bulb temperature given dry-bulb temperature, relative humidity, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+PsychroRefReal ReferenceGetTWetBulbFromRelHum // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal RelHum               // (i) Relative humidity [0-1]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  return ReferenceGetTWetBulbFromHumRatio(TDryBulb, ReferenceGetHumRatioFromRelHum(TDryBulb, RelHum, Pressure), Pressure);
+}
+
+// Return relative humidity given dry-bulb temperature, wet bulb temperature and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+PsychroRefReal ReferenceGetRelHumFromTWetBulb // (o) Relative humidity [0-1]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal TWetBulb             // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  PsychroRefReal HumRatio;
+
+  HumRatio = ReferenceGetHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure);
+  return Pressure * HumRatio / (R_(0.621945) + HumRatio) / ReferenceGetSatVapPres(TDryBulb);
+}
+
+// Return moist air enthalpy given dry-bulb temperature and humidity ratio.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 30
+PsychroRefReal ReferenceGetMoistAirEnthalpy // (o) Moist Air Enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  )
+{
+  PsychroRefReal BoundedHumRatio;
+
+  if (!(HumRatio >= 0))
+    return NAN_;
+  BoundedHumRatio = Max_(HumRatio, MIN_HUM_RATIO);
+
+  if (isIP())
+    return R_(0.240) * TDryBulb + BoundedHumRatio * (R_(1061.) + R_(0.444) * TDryBulb);
+  else
+    return (R_(1.006) * TDryBulb + BoundedHumRatio * (R_(2501.) + R_(1.86) * TDryBulb)) * R_(1000.);
+}
+
+// Return moist air specific volume given dry-bulb temperature, humidity ratio, and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 26
+PsychroRefReal ReferenceGetMoistAirVolume // (o) Specific Volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  PsychroRefReal BoundedHumRatio;
+
+  if (!(HumRatio >= 0))
+    return NAN_;
+  BoundedHumRatio = Max_(HumRatio, MIN_HUM_RATIO);
+
+  if (isIP())
+    return R_DA_IP * (TDryBulb + R_(459.67)) * (R_(1.) + R_(1.607858) * BoundedHumRatio) / (R_(144.) * Pressure);
+  else
+    return R_DA_SI * (TDryBulb + R_(273.15)) * (R_(1.) + R_(1.607858) * BoundedHumRatio) / Pressure;
+}
+
+// Return dry-bulb temperature given moist air enthalpy and humidity ratio.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 30
+PsychroRefReal ReferenceGetTDryBulbFromEnthalpyAndHumRatio // (o) Dry-bulb temperature in °F [IP] or °C [SI]
+  ( PsychroRefReal MoistAirEnthalpy     // (i) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹
+  , PsychroRefReal HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  )
+{
+  PsychroRefReal BoundedHumRatio;
+
+  if (!(HumRatio >= 0))
+    return NAN_;
+  BoundedHumRatio = Max_(HumRatio, MIN_HUM_RATIO);
+
+  if (isIP())
+    return (MoistAirEnthalpy - R_(1061.0) * BoundedHumRatio) / (R_(0.240) + R_(0.444) * BoundedHumRatio);
+  else
+    return (MoistAirEnthalpy / R_(1000.0) - R_(2501.0) * BoundedHumRatio) / (R_(1.006) + R_(1.86) * BoundedHumRatio);
+}
@@ -0,0 +1,97 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Reference functions: the ASHRAE equations of psychrolib.c in extended precision, with solvers
+ * converged to the precision of the type, to measure the error of the functions of the library.
+ * See psychrolib_reference.c for details.
+*/
+
+#ifndef PSYCHROLIB_REFERENCE_H
+#define PSYCHROLIB_REFERENCE_H
+
+// Floating-point type of the reference: __float128 with PSYCHROLIB_REFERENCE_FLOAT128 (GCC and
+// libquadmath), long double otherwise.
+#ifdef PSYCHROLIB_REFERENCE_FLOAT128
+typedef __float128 PsychroRefReal;
+#else
+typedef long double PsychroRefReal;
+#endif
+
+
+/******************************************************************************************************
+ * Reference functions
+ *****************************************************************************************************/
+
+PsychroRefReal ReferenceGetSatVapPres   // (o) Vapor Pressure of saturated air in Psi [IP] or Pa [SI], NaN outside the range of the equations
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  );
+
+PsychroRefReal ReferenceGetSatHumRatio  // (o) Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+PsychroRefReal ReferenceGetHumRatioFromRelHum // (o) Humidity Ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal RelHum               // (i) Relative humidity [0-1]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+PsychroRefReal ReferenceGetHumRatioFromTWetBulb // (o) Humidity Ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal TWetBulb             // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+PsychroRefReal ReferenceGetTDewPointFromVapPres // (o) Dew Point temperature in °F [IP] or °C [SI], NaN outside the range of the equations
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal VapPres              // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  );
+
+PsychroRefReal ReferenceGetTDewPointFromRelHum // (o) Dew Point temperature in °F [IP] or °C [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal RelHum               // (i) Relative humidity [0-1]
+  );
+
+PsychroRefReal ReferenceGetTDewPointFromHumRatio // (o) Dew Point temperature in °F [IP] or °C [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+PsychroRefReal ReferenceGetTWetBulbFromHumRatio // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+PsychroRefReal ReferenceGetTWetBulbFromRelHum // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal RelHum               // (i) Relative humidity [0-1]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+PsychroRefReal ReferenceGetRelHumFromTWetBulb // (o) Relative humidity [0-1]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal TWetBulb             // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+PsychroRefReal ReferenceGetMoistAirEnthalpy // (o) Moist Air Enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  );
+
+PsychroRefReal ReferenceGetMoistAirVolume // (o) Specific Volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  ( PsychroRefReal TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , PsychroRefReal HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , PsychroRefReal Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+PsychroRefReal ReferenceGetTDryBulbFromEnthalpyAndHumRatio // (o) Dry-bulb temperature in °F [IP] or °C [SI]
+  ( PsychroRefReal MoistAirEnthalpy     // (i) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹
+  , PsychroRefReal HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  );
+
+#endif // PSYCHROLIB_REFERENCE_H
@@ -0,0 +1,328 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Regime-partitioned batch functions: the saturation vapor pressure, the saturation humidity
+ *  ratio and the humidity ratio from the wet-bulb temperature of a batch of points, with the
+ *  points grouped by the regime of the equations that apply to them.
+ *
+ *  GetSatVapPres branches at the triple point between ASHRAE eqn. 5 (over ice) and 6 (over liquid
+ *  water), and GetHumRatioFromTWetBulb, in addition, at the freezing point between eqn. 35 and 33.
+ *  A batch of points from a mixed climate alternates between the regimes in no particular order,
+ *  so that these branches are mispredicted about as often as the regime changes. With the
+ *  PSYCHRO_REGIME_PARTITIONED schedule, the batch is processed in blocks of PSYCHRO_REGIME_BLOCK
+ *  points:
+ *   - a first pass checks the inputs as the generic functions do, and classifies each point;
+ *   - a counting sort builds the permutation of the indices of the block by regime, stable so
+ *     that the points of a regime keep their order;
+ *   - each regime is then calculated by its own kernel, with the coefficients of its equations
+ *     fixed: the inputs of CHUNK points of the regime are gathered through the permutation, the
+ *     kernel calculates them in a loop of CHUNK iterations without call or branch, which the
+ *     compiler vectorizes, and the results are scattered back to the index of their point. The
+ *     last chunk of a regime is padded with its first point.
+ *  The regimes are: below the freezing point (ice, eqn. 35), between the freezing and triple points
+ *  (ice, eqn. 33) and above the triple point (liquid, eqn. 33); the saturation functions calculate
+ *  the first two alike. The kernels take the coefficients of the equations, the logarithm and the
+ *  exponential of psychrolib_kernels.h, and bound the humidity ratio at MIN_HUM_RATIO with a select
+ *  on integers. With PSYCHRO_REGIME_INTERLEAVED, the points are calculated in their order by the
+ *  generic functions, for comparison.
+ *
+ *  The logarithm and exponential of the kernels are within 2 units in the last place of those of
+ *  the C library, so that the results of both schedules agree to within about 1e-14 relative,
+ *  and 1e-12 for the humidity ratios near the boiling point, where the pressure minus the
+ *  saturation vapor pressure cancels. The loops of the kernels are vectorized by gcc at -O3, or at
+ *  -O2 from gcc 12; add -march=native for the widest vectors.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_regime.h"
+ *  SetUnitSystem(SI);
+ *  RegimeGetHumRatioFromTWetBulb(Count, TDryBulb, TWetBulb, Pressure, HumRatio, PSYCHRO_REGIME_PARTITIONED);
+ */
+
+// Standard C header files
+#include <math.h>
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_kernels.h"
+#include "psychrolib_regime.h"
+#include "psychrolib_trace.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define BLOCK PSYCHRO_REGIME_BLOCK
+
+#define CHUNK 8                         // Points calculated together by a kernel, the trip count of its loops.
+
+#define REGIME_BELOW_FREEZING 0         // Ice, wet-bulb temperature below the freezing point.
+
+#define REGIME_ICE 1                    // Ice, at or below the triple point.
+
+#define REGIME_LIQUID 2                 // Liquid water, above the triple point.
+
+#define N_REGIMES 3
+
+// Functions calculated by the kernels, each from the result of the previous one
+#define SAT_VAP_PRES 0
+
+#define SAT_HUM_RATIO 1
+
+#define HUM_RATIO_FROM_TWET_BULB 2
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+// Constants of the system of units in use, and message of the generic functions outside the
+// domain of validity of the equations.
+static const struct PsychroKernelUnits *GetUnits_
+  ( char **RangeMsg
+  )
+{
+  if (isIP())
+  {
+    *RangeMsg = "Dry bulb temperature is outside range [-148, 392]";
+    return &PSYCHRO_KERNEL_UNITS_IP;
+  }
+  *RangeMsg = "Dry bulb temperature is outside range [-100, 200]";
+  return &PSYCHRO_KERNEL_UNITS_SI;
+}
+
+// Check a temperature as GetSatVapPres, and return its regime.
+static unsigned char Regime_
+  ( const struct PsychroKernelUnits *Units
+  , char *RangeMsg
+  , double T
+  )
+{
+  ASSERT (T >= Units->Bounds[0] && T <= Units->Bounds[1], RangeMsg)
+
+  return (T >= Units->FreezingPoint) + (T > Units->TriplePoint);
+}
+
+// Stable counting sort of the indices First to First + n - 1 by regime. The indices of regime r
+// are stored in Index[Start[r]] to Index[Start[r + 1] - 1].
+static void Partition_
+  ( size_t First
+  , size_t n
+  , const unsigned char *Regime
+  , size_t *Start
+  , size_t *Index
+  )
+{
+  size_t Next[N_REGIMES] = { 0 }, i;
+  int r;
+
+  for (i = 0; i < n; i++)
+    Next[Regime[i]]++;
+  Start[0] = 0;
+  for (r = 0; r < N_REGIMES; r++)
+  {
+    Start[r + 1] = Start[r] + Next[r];
+    Next[r] = Start[r];
+  }
+  for (i = 0; i < n; i++)
+    Index[Next[Regime[i]]++] = First + i;
+}
+
+// Calculate a function at the n points of Index, all of one regime, by chunks of CHUNK points.
+// The saturation functions take the temperature T and the pressure; the humidity ratio from the
+// wet-bulb temperature T also takes the dry-bulb temperature.
+static void Kernel_
+  ( const struct PsychroKernelUnits *Units
+  , int Regime
+  , int Function
+  , const size_t *Index
+  , size_t n
+  , const double *T
+  , const double *TDryBulb
+  , const double *Pressure
+  , double *Out
+  )
+{
+  double c[7], e[5], t[CHUNK], Td[CHUNK], P[CHUNK], Pws[CHUNK], W[CHUNK], TAbs;
+  size_t k, m, Row;
+  int l;
+
+  // Coefficients of the regime, fixed for all the points
+  for (l = 0; l < 7; l++)
+    c[l] = Regime == REGIME_LIQUID ? Units->Liquid[l] : Units->Ice[l];
+  for (l = 0; l < 5; l++)
+    e[l] = Regime == REGIME_BELOW_FREEZING ? Units->WetBulbIce[l] : Units->WetBulbLiquid[l];
+
+  for (k = 0; k < n; k += CHUNK)
+  {
+    m = min(n - k, CHUNK);
+    for (l = 0; l < CHUNK; l++)
+    {
+      Row = Index[k + ((size_t) l < m ? (size_t) l : 0)];
+      t[l] = T[Row];
+      Td[l] = Function == HUM_RATIO_FROM_TWET_BULB ? TDryBulb[Row] : 0.;
+      P[l] = Function != SAT_VAP_PRES ? Pressure[Row] : 0.;
+    }
+
+    // ASHRAE eqn. 5 or 6
+    for (l = 0; l < CHUNK; l++)
+    {
+      TAbs = t[l] + Units->Offset;
+      Pws[l] = PsychroKernelExp(c[0] / TAbs + c[1] + TAbs * (c[2] + TAbs * (c[3] + TAbs * (c[4] + TAbs * c[5])))
+        + c[6] * PsychroKernelLog(TAbs));
+    }
+    if (Function == SAT_VAP_PRES)
+    {
+      for (l = 0; l < (int) m; l++)
+        Out[Index[k + l]] = Pws[l];
+      continue;
+    }
+
+    // ASHRAE eqn. 36, solved for W
+    for (l = 0; l < CHUNK; l++)
+    {
+      W[l] = 0.621945 * Pws[l] / (P[l] - Pws[l]);
+      W[l] = PsychroKernelSelectNegative(W[l] - MIN_HUM_RATIO, MIN_HUM_RATIO, W[l]);
+    }
+
+    // ASHRAE eqn. 33 or 35
+    if (Function == HUM_RATIO_FROM_TWET_BULB)
+      for (l = 0; l < CHUNK; l++)
+      {
+        W[l] = ((e[0] - e[1] * t[l]) * W[l] - e[2] * (Td[l] - t[l])) / (e[0] + e[3] * Td[l] - e[4] * t[l]);
+        W[l] = PsychroKernelSelectNegative(W[l] - MIN_HUM_RATIO, MIN_HUM_RATIO, W[l]);
+      }
+    for (l = 0; l < (int) m; l++)
+      Out[Index[k + l]] = W[l];
+  }
+}
+
+// Calculate a function at the points of a block of n points from First, partitioned by regime.
+static void Block_
+  ( const struct PsychroKernelUnits *Units
+  , int Function
+  , size_t First
+  , size_t n
+  , const unsigned char *Regime
+  , const double *T
+  , const double *TDryBulb
+  , const double *Pressure
+  , double *Out
+  )
+{
+  size_t Index[BLOCK], Start[N_REGIMES + 1];
+  int r;
+
+  Partition_(First, n, Regime, Start, Index);
+  for (r = 0; r < N_REGIMES; r++)
+    Kernel_(Units, r, Function, Index + Start[r], Start[r + 1] - Start[r], T, TDryBulb, Pressure, Out);
+}
+
+
+/******************************************************************************************************
+ * Batch functions
+ *****************************************************************************************************/
+
+// Return the saturation vapor pressure of a batch of points.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 5 & 6
+void RegimeGetSatVapPres
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double *SatVapPres          // (o) Vapor Pressure of saturated air in Psi [IP] or Pa [SI]
+  , enum PsychroRegimeSchedule Schedule // (i) Order of the calculations
+  )
+{
+  char *RangeMsg;
+  const struct PsychroKernelUnits *Units = GetUnits_(&RangeMsg);
+  unsigned char Regime[BLOCK];
+  size_t First, n, i;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+
+  if (Schedule == PSYCHRO_REGIME_INTERLEAVED)
+    for (i = 0; i < Count; i++)
+      SatVapPres[i] = GetSatVapPres(TDryBulb[i]);
+  else
+    for (First = 0; First < Count; First += n)
+    {
+      n = min(Count - First, BLOCK);
+      for (i = 0; i < n; i++)
+        Regime[i] = Regime_(Units, RangeMsg, TDryBulb[First + i]);
+      Block_(Units, SAT_VAP_PRES, First, n, Regime, TDryBulb, NULL, NULL, SatVapPres);
+    }
+
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
+
+// Return the humidity ratio of saturated air of a batch of points.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 36, solved for W
+void RegimeGetSatHumRatio
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *Pressure      // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *SatHumRatio         // (o) Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , enum PsychroRegimeSchedule Schedule // (i) Order of the calculations
+  )
+{
+  char *RangeMsg;
+  const struct PsychroKernelUnits *Units = GetUnits_(&RangeMsg);
+  unsigned char Regime[BLOCK];
+  size_t First, n, i;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+
+  if (Schedule == PSYCHRO_REGIME_INTERLEAVED)
+    for (i = 0; i < Count; i++)
+      SatHumRatio[i] = GetSatHumRatio(TDryBulb[i], Pressure[i]);
+  else
+    for (First = 0; First < Count; First += n)
+    {
+      n = min(Count - First, BLOCK);
+      for (i = 0; i < n; i++)
+        Regime[i] = Regime_(Units, RangeMsg, TDryBulb[First + i]);
+      Block_(Units, SAT_HUM_RATIO, First, n, Regime, TDryBulb, NULL, Pressure, SatHumRatio);
+    }
+
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
+
+// Return the humidity ratio of a batch of points given dry-bulb temperature, wet-bulb temperature,
+// and pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 33 and 35
+void RegimeGetHumRatioFromTWetBulb
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *TWetBulb      // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , const double *Pressure      // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , enum PsychroRegimeSchedule Schedule // (i) Order of the calculations
+  )
+{
+  char *RangeMsg;
+  const struct PsychroKernelUnits *Units = GetUnits_(&RangeMsg);
+  unsigned char Regime[BLOCK];
+  size_t First, n, i;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+
+  if (Schedule == PSYCHRO_REGIME_INTERLEAVED)
+    for (i = 0; i < Count; i++)
+      HumRatio[i] = GetHumRatioFromTWetBulb(TDryBulb[i], TWetBulb[i], Pressure[i]);
+  else
+    for (First = 0; First < Count; First += n)
+    {
+      n = min(Count - First, BLOCK);
+      for (i = 0; i < n; i++)
+      {
+        ASSERT (TWetBulb[First + i] <= TDryBulb[First + i], "Wet bulb temperature is above dry bulb temperature")
+        Regime[i] = Regime_(Units, RangeMsg, TWetBulb[First + i]);
+      }
+      Block_(Units, HUM_RATIO_FROM_TWET_BULB, First, n, Regime, TWetBulb, TDryBulb, Pressure, HumRatio);
+    }
+
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
@@ -0,0 +1,56 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Regime-partitioned batch functions: batches of points split by regime of the equations (ice or
+ * liquid, below or above freezing), each regime calculated by a kernel without branches.
+ * See psychrolib_regime.c for details.
+*/
+
+#ifndef PSYCHROLIB_REGIME_H
+#define PSYCHROLIB_REGIME_H
+
+#include <stddef.h>
+
+// Number of points partitioned together: the index permutation of a block is kept on the stack
+#ifndef PSYCHRO_REGIME_BLOCK
+#define PSYCHRO_REGIME_BLOCK 1024
+#endif
+
+// Order in which the points of a batch are calculated
+enum PsychroRegimeSchedule
+{
+  PSYCHRO_REGIME_INTERLEAVED,   // In their order, as the generic functions
+  PSYCHRO_REGIME_PARTITIONED    // By regime, in blocks of PSYCHRO_REGIME_BLOCK points
+};
+
+
+/******************************************************************************************************
+ * Batch functions
+ *****************************************************************************************************/
+
+void RegimeGetSatVapPres
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double *SatVapPres          // (o) Vapor Pressure of saturated air in Psi [IP] or Pa [SI]
+  , enum PsychroRegimeSchedule Schedule // (i) Order of the calculations
+  );
+
+void RegimeGetSatHumRatio
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *Pressure      // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *SatHumRatio         // (o) Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , enum PsychroRegimeSchedule Schedule // (i) Order of the calculations
+  );
+
+void RegimeGetHumRatioFromTWetBulb
+  ( size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *TWetBulb      // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , const double *Pressure      // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , enum PsychroRegimeSchedule Schedule // (i) Order of the calculations
+  );
+
+#endif // PSYCHROLIB_REGIME_H
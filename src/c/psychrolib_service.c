@@ -0,0 +1,1194 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Compute service: a local server of batch psychrometric calculations over a Unix domain socket,
+ *  with the arrays passed through shared memory, and its client library.
+ *
+ *  Processes in other languages that need psychrometrics connect to one service built on the C
+ *  library instead of embedding a port each. The client library creates a ring of doubles in
+ *  shared memory and passes its file descriptor to the service over the socket when it connects.
+ *  A request copies the input arrays to a free slot of the ring and sends a message of 40 bytes:
+ *  function, ticket, number of points and offset of the slot. The service calculates the outputs
+ *  into the same slot and answers with the number of invalid points, so that the arrays are never
+ *  serialized or copied through the socket. The slot of a request holds the input arrays followed
+ *  by the output arrays, each of the number of points of the request:
+ *
+ *   Offset: In[0] ... In[NInputs - 1] Out[0] ... Out[NOutputs - 1]
+ *
+ *  Slots are allocated in the order of the requests and freed in the same order when the client
+ *  waits for them, so that the ring holds up to 256 requests in flight. The clients may submit
+ *  several requests before waiting for them.
+ *
+ *  The service waits for the messages of all its clients with poll. The requests received in one
+ *  wake-up are grouped by function: the small ones are gathered into batches of up to
+ *  CoalescedPoints points (65536 by default), and the large ones are calculated in place in the
+ *  ring. Each batch is split between the threads of the configuration, with at least 1024 points
+ *  per thread, so that many small requests of many clients are calculated as few large batches.
+ *  The functions are those of psychrolib_bounded.c, in the system of units of the service when it
+ *  starts: points outside the range of the equations have NaN outputs and are counted in the
+ *  response, instead of stopping the service. The offsets and sizes of the requests are checked
+ *  against the size of the ring of the client, and requests outside of it are rejected.
+ *
+ *  The statistics of the service (requests, points, batches, throughput and latency from the
+ *  receipt of a request to its response, with quantiles from a histogram of powers of 2) are
+ *  available to the process of the service and to the clients. The service runs in the thread that
+ *  calls PsychroServiceRun, and PsychroServiceStop wakes it through a pipe, so that it can be
+ *  called from a signal handler. The program psychrolib_serviced.c runs the service as a daemon.
+ *
+ *  The module requires POSIX sockets, shared memory and threads; on other platforms the service
+ *  and the clients cannot be created.
+ *
+ * Example
+ *  // Service, e.g. in its own thread or process
+ *  struct PsychroServiceConfig Config = { "/tmp/psychrolib.sock", 4, 0 };
+ *  SetUnitSystem(SI);
+ *  PsychroService *Service = PsychroServiceCreate(&Config);
+ *  PsychroServiceRun(Service);
+ *  PsychroServiceDestroy(Service);
+ *
+ *  // Client
+ *  PsychroClient *Client = PsychroClientConnect("/tmp/psychrolib.sock", 1 << 20);
+ *  const double *Inputs[3] = { TDryBulb, RelHum, Pressure };
+ *  double *Outputs[1] = { TWetBulb };
+ *  long Invalid = PsychroClientCall(Client, PSYCHRO_SERVICE_TWET_BULB_FROM_REL_HUM, Count, Inputs, Outputs);
+ *  PsychroClientClose(Client);
+ */
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+#endif
+
+// Standard C header files
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_bounded.h"
+#include "psychrolib_service.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define MAX_THREADS 64                  // Maximum number of threads of a batch.
+
+#define MIN_POINTS_PER_THREAD 1024      // Minimum number of points of each thread of a batch.
+
+#define DEFAULT_COALESCED_POINTS 65536  // Default maximum number of points of a batch of coalesced requests.
+
+#define MAX_PENDING 256                 // Maximum number of requests in flight of a client.
+
+#define MAX_INPUTS 3                    // Maximum number of inputs of the functions.
+
+#define MAX_OUTPUTS 7                   // Maximum number of outputs of the functions.
+
+#define LATENCY_BUCKETS 64              // Number of buckets of powers of 2 ns of the histogram of the latency.
+
+// Number of inputs and outputs of the functions
+static const int SHAPES[PSYCHRO_SERVICE_N_FUNCTIONS][2] = { { 3, 7 }, { 3, 7 }, { 3, 7 }, { 3, 1 }, { 3, 1 }, { 2, 1 } };
+
+int PsychroServiceGetShape              // (o) 0 on success, -1 if the function is invalid
+  ( enum PsychroServiceFunction Function // (i) Function
+  , int *NInputs                        // (o) Number of input arrays
+  , int *NOutputs                       // (o) Number of output arrays
+  )
+{
+  if ((unsigned) Function >= PSYCHRO_SERVICE_N_FUNCTIONS)
+    return -1;
+  *NInputs = SHAPES[Function][0];
+  *NOutputs = SHAPES[Function][1];
+  return 0;
+}
+
+
+#if defined(_WIN32)
+
+/******************************************************************************************************
+ * Unsupported platform
+ *****************************************************************************************************/
+
+PsychroService *PsychroServiceCreate(const struct PsychroServiceConfig *Config) { (void) Config; return NULL; }
+int PsychroServiceRun(PsychroService *Service) { (void) Service; return -1; }
+void PsychroServiceStop(PsychroService *Service) { (void) Service; }
+void PsychroServiceGetStats(PsychroService *Service, struct PsychroServiceStats *Stats) { (void) Service; memset(Stats, 0, sizeof *Stats); }
+void PsychroServiceDestroy(PsychroService *Service) { (void) Service; }
+PsychroClient *PsychroClientConnect(const char *SocketPath, size_t Capacity) { (void) SocketPath; (void) Capacity; return NULL; }
+void PsychroClientClose(PsychroClient *Client) { (void) Client; }
+int PsychroClientGetUnitSystem(const PsychroClient *Client) { (void) Client; return UNDEFINED; }
+int64_t PsychroClientSubmit(PsychroClient *Client, enum PsychroServiceFunction Function, size_t Count, const double *const *Inputs)
+  { (void) Client; (void) Function; (void) Count; (void) Inputs; return -1; }
+int64_t PsychroClientWait(PsychroClient *Client, int64_t Ticket, double *const *Outputs) { (void) Client; (void) Ticket; (void) Outputs; return -1; }
+int64_t PsychroClientCall(PsychroClient *Client, enum PsychroServiceFunction Function, size_t Count, const double *const *Inputs, double *const *Outputs)
+  { (void) Client; (void) Function; (void) Count; (void) Inputs; (void) Outputs; return -1; }
+int PsychroClientGetStats(PsychroClient *Client, struct PsychroServiceStats *Stats) { (void) Client; (void) Stats; return -1; }
+
+#else
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0                  // SO_NOSIGPIPE is set on the sockets instead
+#endif
+
+// Types of the messages
+enum { HELLO_ = 1, REQUEST_, RESPONSE_, STATS_ };
+
+// Message between the clients and the service. HELLO_: Offset is the capacity of the ring, whose
+// file descriptor is attached, and Status the system of units in the answer. REQUEST_ and
+// RESPONSE_: Status is the number of invalid points, -1 if the request is rejected. STATS_: the
+// answer is followed by a struct PsychroServiceStats.
+struct Message_
+{
+  uint32_t Type;
+  uint32_t Function;
+  int64_t Ticket;
+  uint64_t Count;
+  uint64_t Offset;
+  int64_t Status;
+};
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+static double Now_(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static void NoSigPipe_
+  ( int Fd
+  )
+{
+#ifdef SO_NOSIGPIPE
+  int On = 1;
+  setsockopt(Fd, SOL_SOCKET, SO_NOSIGPIPE, &On, sizeof On);
+#else
+  (void) Fd;
+#endif
+}
+
+// Send all the bytes on a blocking socket
+static int SendAll_
+  ( int Fd
+  , const void *Buffer
+  , size_t Size
+  )
+{
+  const char *p = Buffer;
+  ssize_t n;
+
+  while (Size > 0)
+  {
+    n = send(Fd, p, Size, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return -1;
+    p += n;
+    Size -= (size_t) n;
+  }
+  return 0;
+}
+
+// Receive all the bytes on a blocking socket
+static int ReceiveAll_
+  ( int Fd
+  , void *Buffer
+  , size_t Size
+  )
+{
+  char *p = Buffer;
+  ssize_t n;
+
+  while (Size > 0)
+  {
+    n = recv(Fd, p, Size, 0);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return -1;
+    p += n;
+    Size -= (size_t) n;
+  }
+  return 0;
+}
+
+// Calculate a function on arrays, with NaN outputs for the points outside the range of the equations
+struct Worker_
+{
+  int Function;
+  size_t Count;
+  const double *In[MAX_INPUTS];
+  double *Out[MAX_OUTPUTS];
+};
+
+static void Evaluate_
+  ( struct Worker_ *Worker
+  )
+{
+  const double *const *In = Worker->In;
+  double *const *Out = Worker->Out;
+  enum PsychroStatus Status;
+  size_t i;
+  int j;
+
+  for (i = 0; i < Worker->Count; i++)
+  {
+    switch (Worker->Function)
+    {
+    case PSYCHRO_SERVICE_CALC_FROM_TWET_BULB:
+      Status = BoundedCalcPsychrometricsFromTWetBulb(In[0][i], In[1][i], In[2][i], &Out[0][i], &Out[1][i], &Out[2][i],
+        &Out[3][i], &Out[4][i], &Out[5][i], &Out[6][i]);
+      break;
+    case PSYCHRO_SERVICE_CALC_FROM_TDEW_POINT:
+      Status = BoundedCalcPsychrometricsFromTDewPoint(In[0][i], In[1][i], In[2][i], &Out[0][i], &Out[1][i], &Out[2][i],
+        &Out[3][i], &Out[4][i], &Out[5][i], &Out[6][i]);
+      break;
+    case PSYCHRO_SERVICE_CALC_FROM_REL_HUM:
+      Status = BoundedCalcPsychrometricsFromRelHum(In[0][i], In[1][i], In[2][i], &Out[0][i], &Out[1][i], &Out[2][i],
+        &Out[3][i], &Out[4][i], &Out[5][i], &Out[6][i]);
+      break;
+    case PSYCHRO_SERVICE_HUM_RATIO_FROM_REL_HUM:
+      Status = BoundedGetHumRatioFromRelHum(In[0][i], In[1][i], In[2][i], &Out[0][i]);
+      break;
+    case PSYCHRO_SERVICE_TWET_BULB_FROM_REL_HUM:
+      Status = BoundedGetTWetBulbFromRelHum(In[0][i], In[1][i], In[2][i], &Out[0][i]);
+      break;
+    case PSYCHRO_SERVICE_TDEW_POINT_FROM_REL_HUM:
+    default:
+      Status = BoundedGetTDewPointFromRelHum(In[0][i], In[1][i], &Out[0][i]);
+      break;
+    }
+    if (Status != PSYCHRO_STATUS_OK)
+      for (j = 0; j < SHAPES[Worker->Function][1]; j++)
+        Out[j][i] = NAN;
+  }
+}
+
+static void *Thread_(void *Worker)
+{
+  Evaluate_(Worker);
+  return NULL;
+}
+
+// Calculate a batch, split between threads
+static void Compute_
+  ( int Function
+  , size_t Count
+  , const double *const *In
+  , double *const *Out
+  , unsigned Threads
+  )
+{
+  struct Worker_ Workers[MAX_THREADS];
+  pthread_t Handles[MAX_THREADS];
+  int Started[MAX_THREADS];
+  size_t Start = 0;
+  unsigned t, NThreads;
+  int k;
+
+  NThreads = Threads < 1 ? 1 : Threads > MAX_THREADS ? MAX_THREADS : Threads;
+  if (Count / MIN_POINTS_PER_THREAD < NThreads)
+    NThreads = Count / MIN_POINTS_PER_THREAD > 0 ? (unsigned) (Count / MIN_POINTS_PER_THREAD) : 1;
+  for (t = 0; t < NThreads; t++)
+  {
+    Workers[t].Function = Function;
+    Workers[t].Count = Count / NThreads + (t < Count % NThreads);
+    for (k = 0; k < SHAPES[Function][0]; k++)
+      Workers[t].In[k] = In[k] + Start;
+    for (k = 0; k < SHAPES[Function][1]; k++)
+      Workers[t].Out[k] = Out[k] + Start;
+    Start += Workers[t].Count;
+  }
+
+  // Threads that cannot be started are run in the calling thread
+  for (t = 1; t < NThreads; t++)
+    Started[t] = pthread_create(&Handles[t], NULL, Thread_, &Workers[t]) == 0;
+  Evaluate_(&Workers[0]);
+  for (t = 1; t < NThreads; t++)
+  {
+    if (Started[t])
+      pthread_join(Handles[t], NULL);
+    else
+      Evaluate_(&Workers[t]);
+  }
+}
+
+
+/******************************************************************************************************
+ * Server
+ *****************************************************************************************************/
+
+struct Client_
+{
+  int Fd;                               // Socket, -1 once disconnected
+  double *Ring;                         // Shared ring of the client, NULL until its HELLO_ message
+  size_t Capacity;                      // Size of the ring in doubles
+  struct Message_ Buffer;               // Message being received
+  size_t Filled;                        // Number of bytes of the message received
+};
+
+struct Request_
+{
+  size_t Client;                        // Index of the client
+  struct Message_ Message;
+  double Received;                      // Time of receipt
+  size_t Staged;                        // Offset of the request in the staging batch, or SIZE_MAX if calculated in place
+};
+
+struct PsychroService
+{
+  int Listen;                           // Listening socket
+  int Wake[2];                          // Pipe to stop the service
+  char Path[sizeof(((struct sockaddr_un *) 0)->sun_path)];
+  unsigned Threads;
+  size_t CoalescedPoints;
+  struct Client_ *Clients;
+  size_t NClients, ClientCapacity;
+  struct Request_ *Requests;            // Requests received in one wake-up
+  size_t NRequests, RequestCapacity;
+  double *Staging[MAX_INPUTS + MAX_OUTPUTS]; // Inputs and outputs of the batches of coalesced requests
+
+  pthread_mutex_t Lock;                 // Lock of the statistics
+  double Start;
+  uint64_t Connected, Requested, Rejected, Points, Invalid, Batches;
+  double LatencySum, LatencyMax;
+  uint64_t Latencies[LATENCY_BUCKETS];
+};
+
+// Close the connection of a client and unmap its ring
+static void Disconnect_
+  ( struct Client_ *Client
+  )
+{
+  if (Client->Fd >= 0)
+    close(Client->Fd);
+  if (Client->Ring != NULL)
+    munmap(Client->Ring, Client->Capacity * sizeof(double));
+  Client->Fd = -1;
+  Client->Ring = NULL;
+}
+
+// Send a message without blocking; a client whose socket is full is disconnected, as it does not
+// read the responses to the requests it can have in flight
+static void Reply_
+  ( struct Client_ *Client
+  , const void *Buffer
+  , size_t Size
+  )
+{
+  if (Client->Fd >= 0 && send(Client->Fd, Buffer, Size, MSG_DONTWAIT | MSG_NOSIGNAL) != (ssize_t) Size)
+    Disconnect_(Client);
+}
+
+static void Stats_
+  ( PsychroService *Service
+  , struct PsychroServiceStats *Stats
+  )
+{
+  uint64_t Total = 0, Cumulative = 0;
+  int b;
+
+  memset(Stats, 0, sizeof *Stats);
+  pthread_mutex_lock(&Service->Lock);
+  Stats->Clients = Service->Connected;
+  Stats->Requests = Service->Requested;
+  Stats->RejectedRequests = Service->Rejected;
+  Stats->Points = Service->Points;
+  Stats->InvalidPoints = Service->Invalid;
+  Stats->Batches = Service->Batches;
+  Stats->Uptime = Now_() - Service->Start;
+  Stats->PointsPerSecond = Stats->Uptime > 0. ? Service->Points / Stats->Uptime : 0.;
+  Stats->MeanLatency = Service->Requested > 0 ? Service->LatencySum / Service->Requested : 0.;
+  Stats->MaxLatency = Service->LatencyMax;
+  for (b = 0; b < LATENCY_BUCKETS; b++)
+    Total += Service->Latencies[b];
+  for (b = 0; b < LATENCY_BUCKETS && Total > 0; b++)
+  {
+    Cumulative += Service->Latencies[b];
+    if (Stats->MedianLatency == 0. && 2 * Cumulative >= Total)
+      Stats->MedianLatency = ldexp(1e-9, b + 1);
+    if (Stats->P99Latency == 0. && 100 * Cumulative >= 99 * Total)
+      Stats->P99Latency = ldexp(1e-9, b + 1);
+  }
+  pthread_mutex_unlock(&Service->Lock);
+}
+
+// Handle a complete message of a client
+static void Handle_
+  ( PsychroService *Service
+  , size_t Index
+  , int Fd                              // File descriptor attached to the message, or -1
+  )
+{
+  struct Client_ *Client = &Service->Clients[Index];
+  struct Message_ Answer = Client->Buffer;
+  struct PsychroServiceStats Stats;
+  struct stat Info;
+  struct Request_ *Requests;
+  void *Ring;
+
+  switch (Client->Buffer.Type)
+  {
+  case HELLO_:
+    if (Client->Ring != NULL || Fd < 0 || Client->Buffer.Offset == 0 || Client->Buffer.Offset > SIZE_MAX / sizeof(double)
+      || fstat(Fd, &Info) != 0 || (uint64_t) Info.st_size < Client->Buffer.Offset * sizeof(double))
+    {
+      Disconnect_(Client);
+      break;
+    }
+    Ring = mmap(NULL, Client->Buffer.Offset * sizeof(double), PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+    if (Ring == MAP_FAILED)
+    {
+      Disconnect_(Client);
+      break;
+    }
+    Client->Ring = Ring;
+    Client->Capacity = (size_t) Client->Buffer.Offset;
+    Answer.Status = GetUnitSystem();
+    Reply_(Client, &Answer, sizeof Answer);
+    break;
+
+  case REQUEST_:
+    if (Client->Ring == NULL)
+    {
+      Disconnect_(Client);
+      break;
+    }
+    if (Service->NRequests == Service->RequestCapacity)
+    {
+      Requests = realloc(Service->Requests, 2 * Service->RequestCapacity * sizeof(struct Request_));
+      if (Requests == NULL)
+      {
+        Disconnect_(Client);
+        break;
+      }
+      Service->Requests = Requests;
+      Service->RequestCapacity *= 2;
+    }
+    Service->Requests[Service->NRequests].Client = Index;
+    Service->Requests[Service->NRequests].Message = Client->Buffer;
+    Service->Requests[Service->NRequests].Received = Now_();
+    Service->NRequests++;
+    break;
+
+  case STATS_:
+    Stats_(Service, &Stats);
+    {
+      char Buffer[sizeof(struct Message_) + sizeof(struct PsychroServiceStats)];
+      memcpy(Buffer, &Answer, sizeof Answer);
+      memcpy(Buffer + sizeof Answer, &Stats, sizeof Stats);
+      Reply_(Client, Buffer, sizeof Buffer);
+    }
+    break;
+
+  default:
+    Disconnect_(Client);
+    break;
+  }
+}
+
+// Receive the messages available from a client
+static void Receive_
+  ( PsychroService *Service
+  , size_t Index
+  )
+{
+  struct Client_ *Client = &Service->Clients[Index];
+  union { char Buffer[CMSG_SPACE(sizeof(int))]; struct cmsghdr Align; } Control;
+  struct msghdr Header;
+  struct cmsghdr *Message;
+  struct iovec Vector;
+  ssize_t n;
+  int Fd;
+
+  while (Client->Fd >= 0)
+  {
+    Fd = -1;
+    Vector.iov_base = (char *) &Client->Buffer + Client->Filled;
+    Vector.iov_len = sizeof(struct Message_) - Client->Filled;
+    memset(&Header, 0, sizeof Header);
+    Header.msg_iov = &Vector;
+    Header.msg_iovlen = 1;
+    Header.msg_control = Control.Buffer;
+    Header.msg_controllen = sizeof Control.Buffer;
+    n = recvmsg(Client->Fd, &Header, MSG_DONTWAIT);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      return;
+    for (Message = CMSG_FIRSTHDR(&Header); Message != NULL; Message = CMSG_NXTHDR(&Header, Message))
+      if (Message->cmsg_level == SOL_SOCKET && Message->cmsg_type == SCM_RIGHTS)
+        memcpy(&Fd, CMSG_DATA(Message), sizeof(int));
+    if (n <= 0)
+    {
+      if (Fd >= 0)
+        close(Fd);
+      Disconnect_(Client);
+      return;
+    }
+    Client->Filled += (size_t) n;
+    if (Client->Filled == sizeof(struct Message_))
+    {
+      Client->Filled = 0;
+      Handle_(Service, Index, Fd);
+    }
+    if (Fd >= 0)
+      close(Fd);
+  }
+}
+
+// Check a request against the ring of its client
+static int Valid_
+  ( const struct Client_ *Client
+  , const struct Message_ *Message
+  )
+{
+  uint64_t Size;
+
+  if (Message->Function >= PSYCHRO_SERVICE_N_FUNCTIONS || Client->Ring == NULL)
+    return 0;
+  Size = (uint64_t) (SHAPES[Message->Function][0] + SHAPES[Message->Function][1]);
+  return Message->Count <= Client->Capacity / Size && Message->Offset <= Client->Capacity - Message->Count * Size;
+}
+
+// Arrays of a request in the ring of its client
+static void Arrays_
+  ( const PsychroService *Service
+  , const struct Request_ *Request
+  , const double **In
+  , double **Out
+  )
+{
+  double *Slot = Service->Clients[Request->Client].Ring + Request->Message.Offset;
+  size_t Count = (size_t) Request->Message.Count;
+  int k, NIn = SHAPES[Request->Message.Function][0];
+
+  for (k = 0; k < NIn; k++)
+    In[k] = Slot + k * Count;
+  for (k = 0; k < SHAPES[Request->Message.Function][1]; k++)
+    Out[k] = Slot + (NIn + k) * Count;
+}
+
+// Calculate the requests of a function staged in a batch, and copy their outputs to the rings
+static void Flush_
+  ( PsychroService *Service
+  , int Function
+  , size_t First
+  , size_t Last
+  , size_t Points
+  )
+{
+  const double *In[MAX_INPUTS];
+  double *Out[MAX_OUTPUTS];
+  size_t r, Count;
+  int k;
+
+  if (Points == 0)
+    return;
+  Compute_(Function, Points, (const double *const *) Service->Staging, Service->Staging + MAX_INPUTS, Service->Threads);
+  Service->Batches++;
+  for (r = First; r < Last; r++)
+  {
+    struct Request_ *Request = &Service->Requests[r];
+    if (Request->Staged == SIZE_MAX || (int) Request->Message.Function != Function || Request->Message.Status != 0)
+      continue;
+    Count = (size_t) Request->Message.Count;
+    Arrays_(Service, Request, In, Out);
+    for (k = 0; k < SHAPES[Function][1]; k++)
+      memcpy(Out[k], Service->Staging[MAX_INPUTS + k] + Request->Staged, Count * sizeof(double));
+  }
+}
+
+// Calculate the requests received in one wake-up and answer them in the order of receipt
+static void Process_
+  ( PsychroService *Service
+  )
+{
+  const double *In[MAX_INPUTS];
+  double *Out[MAX_OUTPUTS];
+  size_t r, i, Points, First, Count, Invalid;
+  double Now, Latency;
+  int Function, k, b;
+
+  for (r = 0; r < Service->NRequests; r++)
+  {
+    struct Request_ *Request = &Service->Requests[r];
+    Request->Message.Status = Valid_(&Service->Clients[Request->Client], &Request->Message) ? 0 : -1;
+    Request->Staged = SIZE_MAX;
+  }
+
+  // Requests grouped by function: small ones gathered into batches, large ones calculated in place
+  for (Function = 0; Function < PSYCHRO_SERVICE_N_FUNCTIONS; Function++)
+  {
+    Points = 0;
+    First = 0;
+    for (r = 0; r < Service->NRequests; r++)
+    {
+      struct Request_ *Request = &Service->Requests[r];
+      if ((int) Request->Message.Function != Function || Request->Message.Status != 0)
+        continue;
+      Count = (size_t) Request->Message.Count;
+      Arrays_(Service, Request, In, Out);
+      if (Count >= Service->CoalescedPoints)
+      {
+        Compute_(Function, Count, In, Out, Service->Threads);
+        Service->Batches++;
+        continue;
+      }
+      if (Points + Count > Service->CoalescedPoints)
+      {
+        Flush_(Service, Function, First, r, Points);
+        Points = 0;
+        First = r;
+      }
+      for (k = 0; k < SHAPES[Function][0]; k++)
+        memcpy(Service->Staging[k] + Points, In[k], Count * sizeof(double));
+      Request->Staged = Points;
+      Points += Count;
+    }
+    Flush_(Service, Function, First, Service->NRequests, Points);
+  }
+
+  // Invalid points, counted before any response can disconnect a client and unmap its ring
+  for (r = 0; r < Service->NRequests; r++)
+  {
+    struct Request_ *Request = &Service->Requests[r];
+    if (Request->Message.Status != 0)
+      continue;
+    Arrays_(Service, Request, In, Out);
+    for (i = 0, Invalid = 0; i < Request->Message.Count; i++)
+      Invalid += isnan(Out[0][i]) != 0;
+    Request->Message.Status = (int64_t) Invalid;
+  }
+
+  // Responses and statistics
+  Now = Now_();
+  pthread_mutex_lock(&Service->Lock);
+  for (r = 0; r < Service->NRequests; r++)
+  {
+    struct Request_ *Request = &Service->Requests[r];
+    if (Request->Message.Status >= 0)
+    {
+      Service->Requested++;
+      Service->Points += Request->Message.Count;
+      Service->Invalid += (uint64_t) Request->Message.Status;
+      Latency = Now - Request->Received;
+      Service->LatencySum += Latency;
+      Service->LatencyMax = fmax(Service->LatencyMax, Latency);
+      b = Latency > 1e-9 ? (int) log2(Latency * 1e9) : 0;
+      Service->Latencies[b < LATENCY_BUCKETS ? b : LATENCY_BUCKETS - 1]++;
+    }
+    else
+      Service->Rejected++;
+    Request->Message.Type = RESPONSE_;
+    Reply_(&Service->Clients[Request->Client], &Request->Message, sizeof(struct Message_));
+  }
+  pthread_mutex_unlock(&Service->Lock);
+  Service->NRequests = 0;
+}
+
+PsychroService *PsychroServiceCreate    // (o) New service listening on the socket, NULL on error (e.g. unsupported platform, path too long)
+  ( const struct PsychroServiceConfig *Config // (i) Socket, threads and coalescing of the service
+  )
+{
+  PsychroService *Service;
+  struct sockaddr_un Address;
+  int k;
+
+  if (Config->SocketPath == NULL || strlen(Config->SocketPath) >= sizeof Address.sun_path)
+    return NULL;
+  Service = calloc(1, sizeof(PsychroService));
+  if (Service == NULL)
+    return NULL;
+  Service->Listen = Service->Wake[0] = Service->Wake[1] = -1;
+  strcpy(Service->Path, Config->SocketPath);
+  Service->Threads = Config->Threads;
+  Service->CoalescedPoints = Config->CoalescedPoints > 0 ? Config->CoalescedPoints : DEFAULT_COALESCED_POINTS;
+  Service->ClientCapacity = Service->RequestCapacity = 16;
+  Service->Clients = malloc(Service->ClientCapacity * sizeof(struct Client_));
+  Service->Requests = malloc(Service->RequestCapacity * sizeof(struct Request_));
+  if (Service->Clients == NULL || Service->Requests == NULL || pthread_mutex_init(&Service->Lock, NULL) != 0)
+  {
+    free(Service->Clients);
+    free(Service->Requests);
+    free(Service);
+    return NULL;
+  }
+  for (k = 0; k < MAX_INPUTS + MAX_OUTPUTS; k++)
+    if ((Service->Staging[k] = malloc(Service->CoalescedPoints * sizeof(double))) == NULL)
+    {
+      PsychroServiceDestroy(Service);
+      return NULL;
+    }
+
+  memset(&Address, 0, sizeof Address);
+  Address.sun_family = AF_UNIX;
+  strcpy(Address.sun_path, Config->SocketPath);
+  unlink(Config->SocketPath);
+  Service->Listen = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (Service->Listen < 0 || bind(Service->Listen, (struct sockaddr *) &Address, sizeof Address) != 0
+    || listen(Service->Listen, SOMAXCONN) != 0 || pipe(Service->Wake) != 0)
+  {
+    PsychroServiceDestroy(Service);
+    return NULL;
+  }
+  fcntl(Service->Listen, F_SETFL, O_NONBLOCK);
+  fcntl(Service->Listen, F_SETFD, FD_CLOEXEC);
+  fcntl(Service->Wake[0], F_SETFL, O_NONBLOCK);
+  fcntl(Service->Wake[1], F_SETFL, O_NONBLOCK);
+  Service->Start = Now_();
+  return Service;
+}
+
+int PsychroServiceRun                   // (o) 0 when stopped, -1 on error
+  ( PsychroService *Service             // (i) Service, run in the system of units set by SetUnitSystem
+  )
+{
+  struct pollfd *Polled = NULL, *Resized;
+  struct Client_ *Clients;
+  size_t i, j, PolledCapacity = 0;
+  char Drain[64];
+  int Fd, Status = 0;
+
+  for (;;)
+  {
+    // Wake pipe, listening socket and clients
+    if (PolledCapacity < Service->NClients + 2)
+    {
+      PolledCapacity = 2 * (Service->NClients + 2);
+      Resized = realloc(Polled, PolledCapacity * sizeof(struct pollfd));
+      if (Resized == NULL)
+      {
+        Status = -1;
+        break;
+      }
+      Polled = Resized;
+    }
+    Polled[0].fd = Service->Wake[0];
+    Polled[1].fd = Service->Listen;
+    for (i = 0; i < Service->NClients; i++)
+      Polled[2 + i].fd = Service->Clients[i].Fd;
+    for (i = 0; i < Service->NClients + 2; i++)
+    {
+      Polled[i].events = POLLIN;
+      Polled[i].revents = 0;
+    }
+    if (poll(Polled, (nfds_t) (Service->NClients + 2), -1) < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      Status = -1;
+      break;
+    }
+    if (Polled[0].revents != 0)
+    {
+      while (read(Service->Wake[0], Drain, sizeof Drain) > 0)
+        ;
+      break;
+    }
+
+    // Messages of the clients, then new clients
+    for (i = 0; i < Service->NClients; i++)
+      if (Polled[2 + i].revents != 0)
+        Receive_(Service, i);
+    Process_(Service);
+    while (Polled[1].revents != 0 && (Fd = accept(Service->Listen, NULL, NULL)) >= 0)
+    {
+      if (Service->NClients == Service->ClientCapacity)
+      {
+        Clients = realloc(Service->Clients, 2 * Service->ClientCapacity * sizeof(struct Client_));
+        if (Clients == NULL)
+        {
+          close(Fd);
+          continue;
+        }
+        Service->Clients = Clients;
+        Service->ClientCapacity *= 2;
+      }
+      fcntl(Fd, F_SETFD, FD_CLOEXEC);
+      NoSigPipe_(Fd);
+      memset(&Service->Clients[Service->NClients], 0, sizeof(struct Client_));
+      Service->Clients[Service->NClients].Fd = Fd;
+      Service->Clients[Service->NClients].Ring = NULL;
+      Service->NClients++;
+    }
+
+    // Disconnected clients
+    for (i = 0, j = 0; i < Service->NClients; i++)
+      if (Service->Clients[i].Fd >= 0)
+        Service->Clients[j++] = Service->Clients[i];
+      else
+        Disconnect_(&Service->Clients[i]);
+    Service->NClients = j;
+    pthread_mutex_lock(&Service->Lock);
+    Service->Connected = j;
+    pthread_mutex_unlock(&Service->Lock);
+  }
+  free(Polled);
+  return Status;
+}
+
+void PsychroServiceStop
+  ( PsychroService *Service             // (i) Service to stop; safe to call from another thread or a signal handler
+  )
+{
+  ssize_t Written = write(Service->Wake[1], "", 1);
+  (void) Written;
+}
+
+void PsychroServiceGetStats
+  ( PsychroService *Service             // (i) Service
+  , struct PsychroServiceStats *Stats   // (o) Statistics since the start of the service
+  )
+{
+  Stats_(Service, Stats);
+}
+
+void PsychroServiceDestroy
+  ( PsychroService *Service             // (i) Service to free, not running, may be NULL; the socket is removed
+  )
+{
+  size_t i;
+  int k;
+
+  if (Service == NULL)
+    return;
+  for (i = 0; i < Service->NClients; i++)
+    Disconnect_(&Service->Clients[i]);
+  if (Service->Listen >= 0)
+  {
+    close(Service->Listen);
+    unlink(Service->Path);
+  }
+  for (k = 0; k < 2; k++)
+    if (Service->Wake[k] >= 0)
+      close(Service->Wake[k]);
+  for (k = 0; k < MAX_INPUTS + MAX_OUTPUTS; k++)
+    free(Service->Staging[k]);
+  pthread_mutex_destroy(&Service->Lock);
+  free(Service->Clients);
+  free(Service->Requests);
+  free(Service);
+}
+
+
+/******************************************************************************************************
+ * Client
+ *****************************************************************************************************/
+
+struct Pending_
+{
+  int64_t Ticket;
+  int Function;
+  size_t Count;
+  size_t Offset;                        // Slot in the ring
+  size_t Size;
+  int Done;                             // Response received
+  int Waited;                           // Outputs collected, slot to free
+  int64_t Status;
+};
+
+struct PsychroClient
+{
+  int Fd;
+  double *Ring;
+  size_t Capacity;
+  size_t Head;                          // Next free double of the ring
+  struct Pending_ Pending[MAX_PENDING]; // Requests in flight, in the order of submission
+  size_t First, NPending;
+  int64_t NextTicket;
+  int Units;
+  struct PsychroServiceStats Stats;
+  int HaveStats;
+};
+
+// Receive one message from the service and record it
+static int ReceiveMessage_
+  ( PsychroClient *Client
+  )
+{
+  struct Message_ Message;
+  struct Pending_ *Pending;
+  uint64_t Index;
+
+  if (ReceiveAll_(Client->Fd, &Message, sizeof Message) != 0)
+    return -1;
+  if (Message.Type == STATS_)
+  {
+    if (ReceiveAll_(Client->Fd, &Client->Stats, sizeof Client->Stats) != 0)
+      return -1;
+    Client->HaveStats = 1;
+    return 0;
+  }
+  if (Message.Type != RESPONSE_ || Client->NPending == 0)
+    return -1;
+  Index = (uint64_t) (Message.Ticket - Client->Pending[Client->First].Ticket);
+  if (Index >= Client->NPending)
+    return -1;
+  Pending = &Client->Pending[(Client->First + Index) % MAX_PENDING];
+  Pending->Done = 1;
+  Pending->Status = Message.Status;
+  return 0;
+}
+
+PsychroClient *PsychroClientConnect     // (o) New client, NULL on error
+  ( const char *SocketPath              // (i) Path of the Unix domain socket of the service
+  , size_t Capacity                     // (i) Size of the shared ring of inputs and outputs, in doubles
+  )
+{
+  static unsigned long Counter = 0;
+  PsychroClient *Client;
+  struct sockaddr_un Address;
+  struct Message_ Message;
+  union { char Buffer[CMSG_SPACE(sizeof(int))]; struct cmsghdr Align; } Control;
+  struct msghdr Header;
+  struct cmsghdr *Attached;
+  struct iovec Vector;
+  char Name[64];
+  void *Ring;
+  int Memory;
+
+  if (SocketPath == NULL || strlen(SocketPath) >= sizeof Address.sun_path || Capacity == 0
+    || Capacity > SIZE_MAX / sizeof(double))
+    return NULL;
+  Client = calloc(1, sizeof(PsychroClient));
+  if (Client == NULL)
+    return NULL;
+
+  // Shared ring, unlinked once created so that it is freed with its last mapping
+  snprintf(Name, sizeof Name, "/psychrolib-%ld-%lu-%lx", (long) getpid(), Counter++, (unsigned long) (uintptr_t) Client);
+  Memory = shm_open(Name, O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (Memory < 0)
+  {
+    free(Client);
+    return NULL;
+  }
+  shm_unlink(Name);
+  Ring = MAP_FAILED;
+  if (ftruncate(Memory, (off_t) (Capacity * sizeof(double))) == 0)
+    Ring = mmap(NULL, Capacity * sizeof(double), PROT_READ | PROT_WRITE, MAP_SHARED, Memory, 0);
+  if (Ring == MAP_FAILED)
+  {
+    close(Memory);
+    free(Client);
+    return NULL;
+  }
+  Client->Ring = Ring;
+  Client->Capacity = Capacity;
+
+  // Connection, with the file descriptor of the ring attached to the HELLO_ message
+  memset(&Address, 0, sizeof Address);
+  Address.sun_family = AF_UNIX;
+  strcpy(Address.sun_path, SocketPath);
+  Client->Fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (Client->Fd < 0 || connect(Client->Fd, (struct sockaddr *) &Address, sizeof Address) != 0)
+  {
+    close(Memory);
+    PsychroClientClose(Client);
+    return NULL;
+  }
+  NoSigPipe_(Client->Fd);
+  memset(&Message, 0, sizeof Message);
+  Message.Type = HELLO_;
+  Message.Offset = Capacity;
+  Vector.iov_base = &Message;
+  Vector.iov_len = sizeof Message;
+  memset(&Header, 0, sizeof Header);
+  memset(&Control, 0, sizeof Control);
+  Header.msg_iov = &Vector;
+  Header.msg_iovlen = 1;
+  Header.msg_control = Control.Buffer;
+  Header.msg_controllen = sizeof Control.Buffer;
+  Attached = CMSG_FIRSTHDR(&Header);
+  Attached->cmsg_level = SOL_SOCKET;
+  Attached->cmsg_type = SCM_RIGHTS;
+  Attached->cmsg_len = CMSG_LEN(sizeof(int));
+  memcpy(CMSG_DATA(Attached), &Memory, sizeof(int));
+  if (sendmsg(Client->Fd, &Header, MSG_NOSIGNAL) != (ssize_t) sizeof Message
+    || ReceiveAll_(Client->Fd, &Message, sizeof Message) != 0 || Message.Type != HELLO_)
+  {
+    close(Memory);
+    PsychroClientClose(Client);
+    return NULL;
+  }
+  close(Memory);
+  Client->Units = (int) Message.Status;
+  return Client;
+}
+
+void PsychroClientClose
+  ( PsychroClient *Client               // (i) Client to disconnect and free, may be NULL
+  )
+{
+  if (Client == NULL)
+    return;
+  if (Client->Fd >= 0)
+    close(Client->Fd);
+  if (Client->Ring != NULL)
+    munmap(Client->Ring, Client->Capacity * sizeof(double));
+  free(Client);
+}
+
+int PsychroClientGetUnitSystem          // (o) System of units of the service, as the values of enum UnitSystem
+  ( const PsychroClient *Client         // (i) Client
+  )
+{
+  return Client->Units;
+}
+
+int64_t PsychroClientSubmit             // (o) Ticket of the request, -1 if the request is invalid or does not fit in the ring
+  ( PsychroClient *Client               // (i) Client
+  , enum PsychroServiceFunction Function // (i) Function calculated
+  , size_t Count                        // (i) Number of points
+  , const double *const *Inputs         // (i) Arrays of the inputs of the function, copied to the ring
+  )
+{
+  struct Pending_ *Pending;
+  struct Message_ Message;
+  size_t Size, Offset, Tail;
+  int k;
+
+  if ((unsigned) Function >= PSYCHRO_SERVICE_N_FUNCTIONS || Client->NPending == MAX_PENDING)
+    return -1;
+  Size = (size_t) (SHAPES[Function][0] + SHAPES[Function][1]);
+  if (Count > Client->Capacity / Size)
+    return -1;
+  Size *= Count;
+
+  // Slot after the last one, or at the start of the ring if it does not fit before its end
+  if (Client->NPending == 0)
+    Client->Head = 0;
+  Tail = Client->NPending > 0 ? Client->Pending[Client->First].Offset : 0;
+  if (Client->NPending == 0 || Client->Head > Tail)
+  {
+    if (Client->Capacity - Client->Head >= Size)
+      Offset = Client->Head;
+    else if (Tail >= Size)
+      Offset = 0;
+    else
+      return -1;
+  }
+  else if (Tail - Client->Head >= Size)
+    Offset = Client->Head;
+  else
+    return -1;
+
+  for (k = 0; k < SHAPES[Function][0]; k++)
+    memcpy(Client->Ring + Offset + k * Count, Inputs[k], Count * sizeof(double));
+  memset(&Message, 0, sizeof Message);
+  Message.Type = REQUEST_;
+  Message.Function = (uint32_t) Function;
+  Message.Ticket = Client->NextTicket;
+  Message.Count = Count;
+  Message.Offset = Offset;
+  if (SendAll_(Client->Fd, &Message, sizeof Message) != 0)
+    return -1;
+
+  Pending = &Client->Pending[(Client->First + Client->NPending) % MAX_PENDING];
+  memset(Pending, 0, sizeof *Pending);
+  Pending->Ticket = Client->NextTicket;
+  Pending->Function = Function;
+  Pending->Count = Count;
+  Pending->Offset = Offset;
+  Pending->Size = Size;
+  Client->NPending++;
+  Client->Head = Offset + Size;
+  return Client->NextTicket++;
+}
+
+int64_t PsychroClientWait               // (o) Number of invalid points of the request, -1 on error
+  ( PsychroClient *Client               // (i) Client
+  , int64_t Ticket                      // (i) Ticket of a request submitted and not waited for
+  , double *const *Outputs              // (o) Arrays of the outputs of the function, copied from the ring; may be NULL
+  )
+{
+  struct Pending_ *Pending;
+  uint64_t Index;
+  int64_t Status;
+  int k, NIn;
+
+  if (Client->NPending == 0)
+    return -1;
+  Index = (uint64_t) (Ticket - Client->Pending[Client->First].Ticket);
+  if (Index >= Client->NPending)
+    return -1;
+  Pending = &Client->Pending[(Client->First + Index) % MAX_PENDING];
+  if (Pending->Waited)
+    return -1;
+  while (!Pending->Done)
+    if (ReceiveMessage_(Client) != 0)
+      return -1;
+
+  NIn = SHAPES[Pending->Function][0];
+  if (Outputs != NULL && Pending->Status >= 0)
+    for (k = 0; k < SHAPES[Pending->Function][1]; k++)
+      memcpy(Outputs[k], Client->Ring + Pending->Offset + (NIn + k) * Pending->Count, Pending->Count * sizeof(double));
+  Pending->Waited = 1;
+  Status = Pending->Status;
+
+  // Free the slots of the requests waited for, in the order of submission
+  while (Client->NPending > 0 && Client->Pending[Client->First].Waited)
+  {
+    Client->First = (Client->First + 1) % MAX_PENDING;
+    Client->NPending--;
+  }
+  return Status;
+}
+
+int64_t PsychroClientCall               // (o) Number of invalid points, -1 on error
+  ( PsychroClient *Client               // (i) Client
+  , enum PsychroServiceFunction Function // (i) Function calculated
+  , size_t Count                        // (i) Number of points
+  , const double *const *Inputs         // (i) Arrays of the inputs of the function
+  , double *const *Outputs              // (o) Arrays of the outputs of the function
+  )
+{
+  int64_t Ticket = PsychroClientSubmit(Client, Function, Count, Inputs);
+
+  return Ticket < 0 ? -1 : PsychroClientWait(Client, Ticket, Outputs);
+}
+
+int PsychroClientGetStats               // (o) 0 on success, -1 on error
+  ( PsychroClient *Client               // (i) Client
+  , struct PsychroServiceStats *Stats   // (o) Statistics of the service
+  )
+{
+  struct Message_ Message;
+
+  memset(&Message, 0, sizeof Message);
+  Message.Type = STATS_;
+  if (SendAll_(Client->Fd, &Message, sizeof Message) != 0)
+    return -1;
+  Client->HaveStats = 0;
+  while (!Client->HaveStats)
+    if (ReceiveMessage_(Client) != 0)
+      return -1;
+  *Stats = Client->Stats;
+  return 0;
+}
+
+#endif
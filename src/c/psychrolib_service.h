@@ -0,0 +1,137 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Compute service: a local server of batch psychrometric calculations over a Unix domain socket,
+ * with the arrays passed through shared memory, and its client library.
+ * See psychrolib_service.c for details.
+*/
+
+#ifndef PSYCHROLIB_SERVICE_H
+#define PSYCHROLIB_SERVICE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/******************************************************************************************************
+ * Functions and statistics
+ *****************************************************************************************************/
+
+// Batch functions of the service, with their inputs and outputs in the order of the arguments of
+// the functions of the same name of psychrolib_bounded.c
+enum PsychroServiceFunction
+{
+  PSYCHRO_SERVICE_CALC_FROM_TWET_BULB,  // TDryBulb, TWetBulb, Pressure -> HumRatio, TDewPoint, RelHum, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation
+  PSYCHRO_SERVICE_CALC_FROM_TDEW_POINT, // TDryBulb, TDewPoint, Pressure -> HumRatio, TWetBulb, RelHum, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation
+  PSYCHRO_SERVICE_CALC_FROM_REL_HUM,    // TDryBulb, RelHum, Pressure -> HumRatio, TWetBulb, TDewPoint, VapPres, MoistAirEnthalpy, MoistAirVolume, DegreeOfSaturation
+  PSYCHRO_SERVICE_HUM_RATIO_FROM_REL_HUM, // TDryBulb, RelHum, Pressure -> HumRatio
+  PSYCHRO_SERVICE_TWET_BULB_FROM_REL_HUM, // TDryBulb, RelHum, Pressure -> TWetBulb
+  PSYCHRO_SERVICE_TDEW_POINT_FROM_REL_HUM, // TDryBulb, RelHum -> TDewPoint
+  PSYCHRO_SERVICE_N_FUNCTIONS
+};
+
+int PsychroServiceGetShape              // (o) 0 on success, -1 if the function is invalid
+  ( enum PsychroServiceFunction Function // (i) Function
+  , int *NInputs                        // (o) Number of input arrays
+  , int *NOutputs                       // (o) Number of output arrays
+  );
+
+struct PsychroServiceStats
+{
+  uint64_t Clients;                     // Number of clients connected
+  uint64_t Requests;                    // Number of requests served
+  uint64_t RejectedRequests;            // Number of requests rejected as invalid (function, size or offset)
+  uint64_t Points;                      // Number of points calculated
+  uint64_t InvalidPoints;               // Number of points outside the range of the equations, NaN outputs
+  uint64_t Batches;                     // Number of batches calculated, after coalescing of the requests
+  double Uptime;                        // Time since the start of the service in s
+  double PointsPerSecond;               // Points calculated per second of uptime
+  double MeanLatency;                   // Mean time from the receipt of a request to its response in s
+  double MedianLatency;                 // Median latency in s, upper bound within a factor of 2
+  double P99Latency;                    // 99th percentile of the latency in s, upper bound within a factor of 2
+  double MaxLatency;                    // Maximum latency in s
+};
+
+
+/******************************************************************************************************
+ * Server
+ *****************************************************************************************************/
+
+typedef struct PsychroService PsychroService;
+
+struct PsychroServiceConfig
+{
+  const char *SocketPath;               // Path of the Unix domain socket, replaced if it exists
+  unsigned Threads;                     // Number of threads of the calculations, 0 or 1 for the thread of the server
+  size_t CoalescedPoints;               // Maximum number of points of a batch of coalesced requests, 0 for the default
+};
+
+PsychroService *PsychroServiceCreate    // (o) New service listening on the socket, NULL on error (e.g. unsupported platform, path too long)
+  ( const struct PsychroServiceConfig *Config // (i) Socket, threads and coalescing of the service
+  );
+
+int PsychroServiceRun                   // (o) 0 when stopped, -1 on error
+  ( PsychroService *Service             // (i) Service, run in the system of units set by SetUnitSystem
+  );
+
+void PsychroServiceStop
+  ( PsychroService *Service             // (i) Service to stop; safe to call from another thread or a signal handler
+  );
+
+void PsychroServiceGetStats
+  ( PsychroService *Service             // (i) Service
+  , struct PsychroServiceStats *Stats   // (o) Statistics since the start of the service
+  );
+
+void PsychroServiceDestroy
+  ( PsychroService *Service             // (i) Service to free, not running, may be NULL; the socket is removed
+  );
+
+
+/******************************************************************************************************
+ * Client
+ *****************************************************************************************************/
+
+typedef struct PsychroClient PsychroClient;
+
+PsychroClient *PsychroClientConnect     // (o) New client, NULL on error
+  ( const char *SocketPath              // (i) Path of the Unix domain socket of the service
+  , size_t Capacity                     // (i) Size of the shared ring of inputs and outputs, in doubles
+  );
+
+void PsychroClientClose
+  ( PsychroClient *Client               // (i) Client to disconnect and free, may be NULL
+  );
+
+int PsychroClientGetUnitSystem          // (o) System of units of the service, as the values of enum UnitSystem
+  ( const PsychroClient *Client         // (i) Client
+  );
+
+int64_t PsychroClientSubmit             // (o) Ticket of the request, -1 if the request is invalid or does not fit in the ring
+  ( PsychroClient *Client               // (i) Client
+  , enum PsychroServiceFunction Function // (i) Function calculated
+  , size_t Count                        // (i) Number of points
+  , const double *const *Inputs         // (i) Arrays of the inputs of the function, copied to the ring
+  );
+
+int64_t PsychroClientWait               // (o) Number of invalid points of the request, -1 on error
+  ( PsychroClient *Client               // (i) Client
+  , int64_t Ticket                      // (i) Ticket of a request submitted and not waited for
+  , double *const *Outputs              // (o) Arrays of the outputs of the function, copied from the ring; may be NULL
+  );
+
+int64_t PsychroClientCall               // (o) Number of invalid points, -1 on error
+  ( PsychroClient *Client               // (i) Client
+  , enum PsychroServiceFunction Function // (i) Function calculated
+  , size_t Count                        // (i) Number of points
+  , const double *const *Inputs         // (i) Arrays of the inputs of the function
+  , double *const *Outputs              // (o) Arrays of the outputs of the function
+  );
+
+int PsychroClientGetStats               // (o) 0 on success, -1 on error
+  ( PsychroClient *Client               // (i) Client
+  , struct PsychroServiceStats *Stats   // (o) Statistics of the service
+  );
+
+#endif // PSYCHROLIB_SERVICE_H
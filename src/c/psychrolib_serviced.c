@@ -0,0 +1,61 @@
+/**
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Daemon of the compute service of psychrolib_service.c: serves the clients on a Unix domain socket
+ * until SIGINT or SIGTERM, then prints the statistics of the service.
+ * Build: cc -O2 psychrolib_serviced.c psychrolib_service.c psychrolib_bounded.c psychrolib.c -lm -pthread
+ * Usage: psychrolib_serviced <socket-path> <SI|IP> [threads]
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "psychrolib.h"
+#include "psychrolib_service.h"
+
+static PsychroService *Service;
+
+static void Stop(int Signal)
+{
+  (void) Signal;
+  PsychroServiceStop(Service);
+}
+
+int main(int argc, char *argv[])
+{
+  struct PsychroServiceConfig Config = { NULL, 1, 0 };
+  struct PsychroServiceStats Stats;
+  int Status;
+
+  if (argc < 3 || argc > 4)
+  {
+    fprintf(stderr, "Usage: %s <socket-path> <SI|IP> [threads]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  SetUnitSystem(strcmp(argv[2], "IP") == 0 ? IP : SI);
+  Config.SocketPath = argv[1];
+  if (argc == 4)
+    Config.Threads = (unsigned) atoi(argv[3]);
+
+  Service = PsychroServiceCreate(&Config);
+  if (Service == NULL)
+  {
+    fprintf(stderr, "Cannot listen on %s\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+  signal(SIGINT, Stop);
+  signal(SIGTERM, Stop);
+  fprintf(stderr, "Listening on %s\n", argv[1]);
+  Status = PsychroServiceRun(Service);
+
+  PsychroServiceGetStats(Service, &Stats);
+  printf("Requests: %llu (%llu rejected), points: %llu (%llu invalid), batches: %llu\n",
+    (unsigned long long) Stats.Requests, (unsigned long long) Stats.RejectedRequests, (unsigned long long) Stats.Points,
+    (unsigned long long) Stats.InvalidPoints, (unsigned long long) Stats.Batches);
+  printf("Uptime: %.1f s, throughput: %.0f points/s, latency: mean %.3g s, median < %.3g s, p99 < %.3g s, max %.3g s\n",
+    Stats.Uptime, Stats.PointsPerSecond, Stats.MeanLatency, Stats.MedianLatency, Stats.P99Latency, Stats.MaxLatency);
+  PsychroServiceDestroy(Service);
+  return Status == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,576 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Site context: batch functions at a fixed atmospheric pressure.
+ *
+ *  Installations at a given site run at an essentially constant pressure, e.g. the standard
+ *  atmosphere pressure at the altitude of the site. A site context fixes the pressure and the
+ *  system of units once and precomputes what only depends on them:
+ *   - the saturation vapor pressure curve, as piecewise cubic Hermite polynomials on a grid of
+ *     about 0.1 K over the whole domain of validity of ASHRAE eqn. 5 and 6, split at the triple
+ *     point of water where the equations change. Evaluating the curve, and from it the humidity
+ *     ratio at saturation, then takes a handful of multiplications instead of exp, log and pow.
+ *     The interpolation error is below 1e-9 relative to the equations;
+ *   - the coefficients of ASHRAE eqn. 33 and 35 for the wet-bulb temperature in the system of units.
+ *
+ *  The wet-bulb temperature is solved with Newton-Raphson steps safeguarded by bisection, using
+ *  the analytic derivative of the curve, and converges in a few iterations to within 1e-6 °F [IP]
+ *  or °C [SI]; the generic function uses bisection to within PSYCHROLIB_TOLERANCE. The dew-point
+ *  temperature is found by inverting the interpolated curve directly.
+ *
+ *  The batch functions take the dry-bulb temperature and a humidity input for each point. Their
+ *  inputs are checked as in the generic functions. The system of units must not be changed while
+ *  the site context is in use.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_site.h"
+ *  SetUnitSystem(SI);
+ *  PsychroSite *Site = PsychroSiteCreate(GetStandardAtmPressure(1500.));
+ *  PsychroSiteGetTWetBulbFromHumRatio(Site, Count, TDryBulb, HumRatio, TWetBulb);
+ *  PsychroSiteDestroy(Site);
+ */
+
+// Standard C header files
+#include <math.h>
+#include <stdlib.h>
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_kernels.h"
+#include "psychrolib_site.h"
+#include "psychrolib_trace.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define N_ICE_CELLS 1000                // Number of cells of the saturation curve below the triple point.
+
+#define N_LIQUID_CELLS 2000             // Number of cells of the saturation curve above the triple point.
+
+#define SOLVER_TOLERANCE 1e-6           // Tolerance of the wet-bulb temperature solver in °F [IP] or °C [SI].
+
+
+/******************************************************************************************************
+ * Site context structure
+ *****************************************************************************************************/
+
+// Piecewise cubic polynomials of the saturation vapor pressure on a uniform grid.
+// On cell k, Pws = c[0] + u * (c[1] + u * (c[2] + u * c[3])) with u = (T - TMin) / Step - k in [0, 1].
+struct SatVapPresCurve
+{
+  double TMin;
+  double TMax;
+  double InvStep;
+  size_t NCells;
+  double (*Coeffs)[4];
+};
+
+struct PsychroSite
+{
+  enum UnitSystem Units;
+  double Pressure;
+  struct SatVapPresCurve Ice;           // Curve below the triple point
+  struct SatVapPresCurve Liquid;        // Curve above the triple point
+  double FreezingPoint;
+  double Tolerance;                     // Tolerance of the generic wet-bulb temperature function
+  const double *WetBulbLiquid;          // A, B, C, D and E of ASHRAE eqn. 33, at or above the freezing point
+  const double *WetBulbIce;             // A, B, C, D and E of ASHRAE eqn. 35, below the freezing point
+  double Cells[N_ICE_CELLS + N_LIQUID_CELLS][4];
+};
+
+// Tabulate the saturation vapor pressure between TMin and TMax as cubic Hermite polynomials,
+// from the values and analytic derivatives of ASHRAE eqn. 5 or 6 at the nodes.
+// The first or last node is moved inside the interval if necessary, so that the equation
+// used at the triple point is the one that applies to the side of the curve.
+static void InitCurve
+  ( struct SatVapPresCurve *Curve
+  , double TMin
+  , double TMax
+  , size_t NCells
+  , double (*Coeffs)[4]
+  , int AboveTriplePoint
+  )
+{
+  double Step = (TMax - TMin) / NCells;
+  double T0, T1, P0, P1, D0, D1;
+  size_t k;
+
+  Curve->TMin = TMin;
+  Curve->TMax = TMax;
+  Curve->InvStep = NCells / (TMax - TMin);
+  Curve->NCells = NCells;
+  Curve->Coeffs = Coeffs;
+
+  T0 = AboveTriplePoint ? nextafter(TMin, TMax) : TMin;
+  P0 = GetSatVapPres(T0);
+  D0 = P0 * dLnPws_(T0) * Step;
+  for (k = 0; k < NCells; k++)
+  {
+    T1 = TMin + (k + 1) * Step;
+    T1 = k + 1 == NCells ? TMax : T1;
+    P1 = GetSatVapPres(T1);
+    D1 = P1 * dLnPws_(T1) * Step;
+
+    Coeffs[k][0] = P0;
+    Coeffs[k][1] = D0;
+    Coeffs[k][2] = 3. * (P1 - P0) - 2. * D0 - D1;
+    Coeffs[k][3] = 2. * (P0 - P1) + D0 + D1;
+
+    P0 = P1;
+    D0 = D1;
+  }
+}
+
+// Saturation vapor pressure and its derivative with respect to temperature from the curves
+static double SatVapPres_
+  ( const PsychroSite *Site
+  , double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double *dSatVapPres         // (o) Derivative in Psi °F⁻¹ [IP] or Pa K⁻¹ [SI], may be NULL
+  )
+{
+  const struct SatVapPresCurve *Curve = TDryBulb <= Site->Ice.TMax ? &Site->Ice : &Site->Liquid;
+  const double *c;
+  double x, u;
+  size_t k;
+
+  ASSERT(TDryBulb >= Site->Ice.TMin && TDryBulb <= Site->Liquid.TMax, "Dry bulb temperature is outside range of validity")
+
+  x = (TDryBulb - Curve->TMin) * Curve->InvStep;
+  k = min((size_t) x, Curve->NCells - 1);
+  u = x - k;
+  c = Curve->Coeffs[k];
+
+  if (dSatVapPres != NULL)
+    *dSatVapPres = (c[1] + u * (2. * c[2] + 3. * u * c[3])) * Curve->InvStep;
+  return c[0] + u * (c[1] + u * (c[2] + u * c[3]));
+}
+
+// Temperature at which the interpolated saturation vapor pressure equals VapPres
+static double TSatFromVapPres_
+  ( const PsychroSite *Site
+  , double VapPres              // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  )
+{
+  const struct SatVapPresCurve *Curve;
+  const double *c;
+  size_t Lo, Hi, Mid;
+  double u, f, df, du;
+  int index;
+
+  Curve = VapPres <= Site->Liquid.Coeffs[0][0] ? &Site->Ice : &Site->Liquid;
+
+  // The curve is increasing: find the cell by bisection on the values at the nodes
+  Lo = 0;
+  Hi = Curve->NCells;
+  while (Hi - Lo > 1)
+  {
+    Mid = (Lo + Hi) / 2;
+    if (Curve->Coeffs[Mid][0] <= VapPres)
+      Lo = Mid;
+    else
+      Hi = Mid;
+  }
+  c = Curve->Coeffs[Lo];
+
+  // Newton-Raphson on the cubic of the cell, starting from linear interpolation
+  f = c[0] + c[1] + c[2] + c[3];
+  u = f > c[0] ? (VapPres - c[0]) / (f - c[0]) : 0.;
+  for (index = 0; index < MAX_ITER_COUNT; index++)
+  {
+    f = c[0] + u * (c[1] + u * (c[2] + u * c[3])) - VapPres;
+    df = c[1] + u * (2. * c[2] + 3. * u * c[3]);
+    du = f / df;
+    u = min(max(u - du, 0.), 1.);
+    if (fabs(du) < 1e-14)
+      break;
+  }
+  return Curve->TMin + (Lo + u) / Curve->InvStep;
+}
+
+static double HumRatioFromVapPres_
+  ( const PsychroSite *Site
+  , double VapPres
+  )
+{
+  ASSERT (VapPres >= 0., "Partial pressure of water vapor in moist air is negative")
+  return max(0.621945 * VapPres / (Site->Pressure - VapPres), MIN_HUM_RATIO);
+}
+
+static double VapPresFromHumRatio_
+  ( const PsychroSite *Site
+  , double HumRatio
+  )
+{
+  ASSERT (HumRatio >= 0., "Humidity ratio is negative")
+  HumRatio = max(HumRatio, MIN_HUM_RATIO);
+  return Site->Pressure * HumRatio / (0.621945 + HumRatio);
+}
+
+static double TDewPointFromHumRatio_
+  ( const PsychroSite *Site
+  , double TDryBulb
+  , double HumRatio
+  )
+{
+  double VapPres = VapPresFromHumRatio_(Site, HumRatio);
+
+  ASSERT (VapPres >= Site->Ice.Coeffs[0][0] && VapPres <= SatVapPres_(Site, Site->Liquid.TMax, NULL),
+          "Partial pressure of water vapor is outside range of validity of equations")
+  return min(TSatFromVapPres_(Site, VapPres), TDryBulb);
+}
+
+// Humidity ratio from ASHRAE eqn. 33 or 35 and its derivative with respect to the wet-bulb temperature:
+// HumRatio = ((A - B * TWetBulb) * Wsstar - C * (TDryBulb - TWetBulb)) / (A + D * TDryBulb - E * TWetBulb)
+static double HumRatioFromTWetBulbCoeffs_
+  ( const PsychroSite *Site
+  , const double *k             // (i) A, B, C, D and E
+  , double TDryBulb
+  , double TWetBulb
+  , double *dHumRatio           // (o) Derivative, may be NULL
+  )
+{
+  double dPws, Pws, Wsstar, dWsstar, Num, Den, HumRatio;
+
+  Pws = SatVapPres_(Site, TWetBulb, &dPws);
+  Wsstar = 0.621945 * Pws / (Site->Pressure - Pws);
+  dWsstar = 0.621945 * Site->Pressure * dPws / ((Site->Pressure - Pws) * (Site->Pressure - Pws));
+  if (Wsstar < MIN_HUM_RATIO)
+  {
+    Wsstar = MIN_HUM_RATIO;
+    dWsstar = 0.;
+  }
+
+  Num = (k[0] - k[1] * TWetBulb) * Wsstar - k[2] * (TDryBulb - TWetBulb);
+  Den = k[0] + k[3] * TDryBulb - k[4] * TWetBulb;
+  HumRatio = Num / Den;
+  if (dHumRatio != NULL)
+    *dHumRatio = (-k[1] * Wsstar + (k[0] - k[1] * TWetBulb) * dWsstar + k[2] + HumRatio * k[4]) / Den;
+  return HumRatio;
+}
+
+// Humidity ratio from ASHRAE eqn. 33 and 35 and its derivative with respect to the wet-bulb temperature
+static double HumRatioFromTWetBulb_
+  ( const PsychroSite *Site
+  , double TDryBulb
+  , double TWetBulb
+  , double *dHumRatio           // (o) Derivative, may be NULL
+  )
+{
+  ASSERT (TWetBulb <= TDryBulb, "Wet bulb temperature is above dry bulb temperature")
+
+  return HumRatioFromTWetBulbCoeffs_(Site, TWetBulb >= Site->FreezingPoint ? Site->WetBulbLiquid : Site->WetBulbIce,
+    TDryBulb, TWetBulb, dHumRatio);
+}
+
+// Wet-bulb temperature between the dew-point and dry-bulb temperatures.
+// ASHRAE eqn. 33 and 35 do not join at the freezing point. When the bracket contains the freezing
+// point, the humidity ratio at the target is compared with the limits of both equations there to
+// select the side of the solution. If there is a solution on each side, the bracket is bisected as
+// in the generic function, which then selects the same solution. Newton-Raphson steps are used once
+// the bracket is on one side of the freezing point, falling back to bisection when they leave it.
+static double TWetBulbFromHumRatio_
+  ( const PsychroSite *Site
+  , double TDryBulb
+  , double HumRatio
+  , double TDewPoint
+  )
+{
+  double TWetBulb, TWetBulbSup, TWetBulbInf, TNext, W, dW, WIce, WLiquid;
+  int index = 1;
+
+  ASSERT (HumRatio >= 0., "Humidity ratio is negative")
+  HumRatio = max(HumRatio, MIN_HUM_RATIO);
+
+  TWetBulbSup = TDryBulb;
+  TWetBulbInf = TDewPoint;
+
+  if (TWetBulbInf < Site->FreezingPoint && TWetBulbSup >= Site->FreezingPoint)
+  {
+    WIce = HumRatioFromTWetBulbCoeffs_(Site, Site->WetBulbIce, TDryBulb, Site->FreezingPoint, NULL);
+    WLiquid = HumRatioFromTWetBulbCoeffs_(Site, Site->WetBulbLiquid, TDryBulb, Site->FreezingPoint, NULL);
+    if (HumRatio < min(WIce, WLiquid))
+      TWetBulbSup = nextafter(Site->FreezingPoint, TWetBulbInf);
+    else if (HumRatio > max(WIce, WLiquid))
+      TWetBulbInf = Site->FreezingPoint;
+  }
+  TWetBulb = (TWetBulbInf + TWetBulbSup) / 2.;
+
+  // Bisection while the bracket contains the freezing point
+  while (TWetBulbInf < Site->FreezingPoint && TWetBulbSup >= Site->FreezingPoint)
+  {
+    if (TWetBulbSup - TWetBulbInf <= Site->Tolerance)
+      return TWetBulb;
+
+    if (HumRatioFromTWetBulb_(Site, TDryBulb, TWetBulb, NULL) > HumRatio)
+      TWetBulbSup = TWetBulb;
+    else
+      TWetBulbInf = TWetBulb;
+    TWetBulb = (TWetBulbInf + TWetBulbSup) / 2.;
+
+    ASSERT (index <= MAX_ITER_COUNT, "Convergence not reached in PsychroSiteGetTWetBulbFromHumRatio. Stopping.")
+    index++;
+  }
+
+  // Safeguarded Newton-Raphson
+  for (;;)
+  {
+    W = HumRatioFromTWetBulb_(Site, TDryBulb, TWetBulb, &dW);
+    if (W > HumRatio)
+      TWetBulbSup = TWetBulb;
+    else
+      TWetBulbInf = TWetBulb;
+
+    TNext = dW > 0. ? TWetBulb - (W - HumRatio) / dW : TWetBulbInf;
+    if (!(TNext > TWetBulbInf && TNext < TWetBulbSup))
+      TNext = (TWetBulbInf + TWetBulbSup) / 2.;
+
+    if (fabs(TNext - TWetBulb) < SOLVER_TOLERANCE || TWetBulbSup - TWetBulbInf < SOLVER_TOLERANCE)
+      return TNext;
+    TWetBulb = TNext;
+
+    ASSERT (index <= MAX_ITER_COUNT, "Convergence not reached in PsychroSiteGetTWetBulbFromHumRatio. Stopping.")
+    index++;
+  }
+}
+
+static void CheckUnitSystem
+  ( const PsychroSite *Site
+  )
+{
+  ASSERT (GetUnitSystem() == Site->Units, "The system of units has changed since the site context was created")
+}
+
+
+/******************************************************************************************************
+ * Site context management
+ *****************************************************************************************************/
+
+// Create a site context at the given pressure, in the system of units in use.
+// The context takes about 100 kB of memory.
+PsychroSite *PsychroSiteCreate  // (o) New site context, NULL if the pressure is not positive or out of memory
+  ( double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  PsychroSite *Site;
+  const struct PsychroKernelUnits *Units;
+
+  if (!(Pressure > 0.))
+    return NULL;
+  Site = malloc(sizeof(PsychroSite));
+  if (Site == NULL)
+    return NULL;
+
+  Units = isIP() ? &PSYCHRO_KERNEL_UNITS_IP : &PSYCHRO_KERNEL_UNITS_SI;
+  Site->Units = GetUnitSystem();
+  Site->Pressure = Pressure;
+  Site->FreezingPoint = Units->FreezingPoint;
+  Site->Tolerance = Units->Tolerance;
+  Site->WetBulbLiquid = Units->WetBulbLiquid;
+  Site->WetBulbIce = Units->WetBulbIce;
+  InitCurve(&Site->Ice, Units->Bounds[0], Units->TriplePoint, N_ICE_CELLS, &Site->Cells[0], 0);
+  InitCurve(&Site->Liquid, Units->TriplePoint, Units->Bounds[1], N_LIQUID_CELLS, &Site->Cells[N_ICE_CELLS], 1);
+  return Site;
+}
+
+void PsychroSiteDestroy
+  ( PsychroSite *Site           // (i) Site context to free, may be NULL
+  )
+{
+  free(Site);
+}
+
+double PsychroSiteGetPressure   // (o) Atmospheric pressure of the site in Psi [IP] or Pa [SI]
+  ( const PsychroSite *Site     // (i) Site context
+  )
+{
+  return Site->Pressure;
+}
+
+
+/******************************************************************************************************
+ * Batch functions at the pressure of the site
+ *****************************************************************************************************/
+
+// Return saturation vapor pressure given dry-bulb temperature.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 5 & 6
+void PsychroSiteGetSatVapPres
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double *SatVapPres          // (o) Vapor Pressure of saturated air in Psi [IP] or Pa [SI]
+  )
+{
+  size_t i;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  CheckUnitSystem(Site);
+  for (i = 0; i < Count; i++)
+    SatVapPres[i] = SatVapPres_(Site, TDryBulb[i], NULL);
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
+
+// Return humidity ratio of saturated air given dry-bulb temperature.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 36, solved for W
+void PsychroSiteGetSatHumRatio
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double *SatHumRatio         // (o) Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  )
+{
+  size_t i;
+  double Pws;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  CheckUnitSystem(Site);
+  for (i = 0; i < Count; i++)
+  {
+    Pws = SatVapPres_(Site, TDryBulb[i], NULL);
+    SatHumRatio[i] = max(0.621945 * Pws / (Site->Pressure - Pws), MIN_HUM_RATIO);
+  }
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
+
+// Return humidity ratio given water vapor pressure.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 20
+void PsychroSiteGetHumRatioFromVapPres
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *VapPres       // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  )
+{
+  size_t i;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  for (i = 0; i < Count; i++)
+    HumRatio[i] = HumRatioFromVapPres_(Site, VapPres[i]);
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
+
+// Return humidity ratio given dry-bulb temperature and relative humidity.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+void PsychroSiteGetHumRatioFromRelHum
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *RelHum        // (i) Relative humidity [0-1]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  )
+{
+  size_t i;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  CheckUnitSystem(Site);
+  for (i = 0; i < Count; i++)
+  {
+    ASSERT (RelHum[i] >= 0. && RelHum[i] <= 1., "Relative humidity is outside range [0,1]")
+    HumRatio[i] = HumRatioFromVapPres_(Site, RelHum[i] * SatVapPres_(Site, TDryBulb[i], NULL));
+  }
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
+
+// Return humidity ratio given dry-bulb temperature and wet-bulb temperature.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 33 and 35
+void PsychroSiteGetHumRatioFromTWetBulb
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *TWetBulb      // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  )
+{
+  size_t i;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  CheckUnitSystem(Site);
+  for (i = 0; i < Count; i++)
+    HumRatio[i] = max(HumRatioFromTWetBulb_(Site, TDryBulb[i], TWetBulb[i], NULL), MIN_HUM_RATIO);
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
+
+// Return wet-bulb temperature given dry-bulb temperature and humidity ratio.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 33 and 35 solved for Tstar
+void PsychroSiteGetTWetBulbFromHumRatio
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *HumRatio      // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double *TWetBulb            // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  )
+{
+  size_t i;
+  double TDewPoint;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  CheckUnitSystem(Site);
+  for (i = 0; i < Count; i++)
+  {
+    TDewPoint = TDewPointFromHumRatio_(Site, TDryBulb[i], HumRatio[i]);
+    TWetBulb[i] = TWetBulbFromHumRatio_(Site, TDryBulb[i], HumRatio[i], TDewPoint);
+  }
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
+
+// Return dew-point temperature given dry-bulb temperature and humidity ratio.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 5 and 6
+void PsychroSiteGetTDewPointFromHumRatio
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *HumRatio      // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double *TDewPoint           // (o) Dew point temperature in °F [IP] or °C [SI]
+  )
+{
+  size_t i;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  CheckUnitSystem(Site);
+  for (i = 0; i < Count; i++)
+    TDewPoint[i] = TDewPointFromHumRatio_(Site, TDryBulb[i], HumRatio[i]);
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
+
+// Calculate psychrometric values of moist air given dry-bulb temperature and relative humidity.
+// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+void PsychroSiteCalcPsychrometricsFromRelHum
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *RelHum        // (i) Relative humidity [0-1]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double *TWetBulb            // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  , double *TDewPoint           // (o) Dew point temperature in °F [IP] or °C [SI]
+  , double *VapPres             // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double *MoistAirEnthalpy    // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , double *MoistAirVolume      // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  , double *DegreeOfSaturation  // (o) Degree of saturation [unitless]
+  )
+{
+  size_t i;
+  double Pws, W;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  CheckUnitSystem(Site);
+  for (i = 0; i < Count; i++)
+  {
+    ASSERT (RelHum[i] >= 0. && RelHum[i] <= 1., "Relative humidity is outside range [0,1]")
+
+    Pws = SatVapPres_(Site, TDryBulb[i], NULL);
+    W = HumRatioFromVapPres_(Site, RelHum[i] * Pws);
+    HumRatio[i] = W;
+    TDewPoint[i] = TDewPointFromHumRatio_(Site, TDryBulb[i], W);
+    TWetBulb[i] = TWetBulbFromHumRatio_(Site, TDryBulb[i], W, TDewPoint[i]);
+    VapPres[i] = VapPresFromHumRatio_(Site, W);
+    MoistAirEnthalpy[i] = GetMoistAirEnthalpy(TDryBulb[i], W);
+    MoistAirVolume[i] = GetMoistAirVolume(TDryBulb[i], W, Site->Pressure);
+    DegreeOfSaturation[i] = W / max(0.621945 * Pws / (Site->Pressure - Pws), MIN_HUM_RATIO);
+  }
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+}
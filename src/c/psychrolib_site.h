@@ -0,0 +1,105 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Site context: batch functions at a fixed atmospheric pressure.
+ * See psychrolib_site.c for details.
+*/
+
+#ifndef PSYCHROLIB_SITE_H
+#define PSYCHROLIB_SITE_H
+
+#include <stddef.h>
+
+
+/******************************************************************************************************
+ * Site context management
+ *****************************************************************************************************/
+
+typedef struct PsychroSite PsychroSite;
+
+PsychroSite *PsychroSiteCreate  // (o) New site context, NULL if the pressure is not positive or out of memory
+  ( double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+void PsychroSiteDestroy
+  ( PsychroSite *Site           // (i) Site context to free, may be NULL
+  );
+
+double PsychroSiteGetPressure   // (o) Atmospheric pressure of the site in Psi [IP] or Pa [SI]
+  ( const PsychroSite *Site     // (i) Site context
+  );
+
+
+/******************************************************************************************************
+ * Batch functions at the pressure of the site
+ *****************************************************************************************************/
+
+void PsychroSiteGetSatVapPres
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double *SatVapPres          // (o) Vapor Pressure of saturated air in Psi [IP] or Pa [SI]
+  );
+
+void PsychroSiteGetSatHumRatio
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double *SatHumRatio         // (o) Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  );
+
+void PsychroSiteGetHumRatioFromVapPres
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *VapPres       // (i) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  );
+
+void PsychroSiteGetHumRatioFromRelHum
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *RelHum        // (i) Relative humidity [0-1]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  );
+
+void PsychroSiteGetHumRatioFromTWetBulb
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *TWetBulb      // (i) Wet bulb temperature in °F [IP] or °C [SI]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  );
+
+void PsychroSiteGetTWetBulbFromHumRatio
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *HumRatio      // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double *TWetBulb            // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  );
+
+void PsychroSiteGetTDewPointFromHumRatio
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *HumRatio      // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double *TDewPoint           // (o) Dew point temperature in °F [IP] or °C [SI]
+  );
+
+void PsychroSiteCalcPsychrometricsFromRelHum
+  ( const PsychroSite *Site     // (i) Site context
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *RelHum        // (i) Relative humidity [0-1]
+  , double *HumRatio            // (o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double *TWetBulb            // (o) Wet bulb temperature in °F [IP] or °C [SI]
+  , double *TDewPoint           // (o) Dew point temperature in °F [IP] or °C [SI]
+  , double *VapPres             // (o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  , double *MoistAirEnthalpy    // (o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  , double *MoistAirVolume      // (o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  , double *DegreeOfSaturation  // (o) Degree of saturation [unitless]
+  );
+
+#endif // PSYCHROLIB_SITE_H
@@ -0,0 +1,852 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Property tables: interpolation of moist air properties over a box of dry-bulb temperature,
+ *  humidity ratio and pressure, with exact fallback outside the box and beyond a tolerance.
+ *
+ *  Solvers that evaluate the properties of every cell of a mesh at every iteration call the
+ *  same functions millions of times over a bounded range of states. A table samples the exact
+ *  functions of the library once, on a uniform grid over a box chosen by the caller, and answers
+ *  lookups by interpolation:
+ *   - trilinear interpolation reads the 8 nodes around the point;
+ *   - cubic interpolation evaluates the Lagrange polynomials on 4 nodes in each dimension (64
+ *     nodes), shifted inside the box at its faces. An axis with fewer than 4 nodes is
+ *     interpolated linearly, and an axis with a single node (e.g. a fixed pressure) is not
+ *     interpolated.
+ *  Points outside the box, and properties that are not tabulated, are calculated with the exact
+ *  functions. A lookup costs the same whatever the property, so the tables pay off for the
+ *  wet-bulb and dew-point temperatures, which are solved iteratively, and not for the density or
+ *  enthalpy, which are cheaper to calculate than to interpolate; the benchmarks report both. Large
+ *  tables are bound by the latency of the memory: lookups of neighbouring states, such as the
+ *  cells of a mesh in order, are faster than lookups of states in random order.
+ *
+ *  When the table is created, the interpolation error is measured against the exact functions at
+ *  the centers of the cells, where it is largest for smooth functions: at every cell of tables
+ *  with up to MAX_ERROR_SAMPLES cells, otherwise at MAX_ERROR_SAMPLES cells spread over the box.
+ *  The wet-bulb temperature is only as smooth as the bisection of the generic function, to within
+ *  PSYCHROLIB_TOLERANCE. The dew-point temperature changes from saturation over ice to saturation
+ *  over liquid water at freezing, and varies as the logarithm of the humidity ratio in dry air.
+ *  The wet-bulb and dew-point temperatures are clipped to the dry-bulb temperature above
+ *  saturation. The errors are larger along these curves, and not necessarily at the centers of
+ *  the cells.
+ *
+ *  The caller can bound the error of each property with a tolerance: when the table is created,
+ *  the error is measured on a grid of PROBES_PER_AXIS³ points inside every cell, and the cells
+ *  where it exceeds half the tolerance at one of them are calculated with the exact function,
+ *  which leaves room for the larger errors between the points. This keeps the tables of the
+ *  dew-point temperature in dry air, where it varies as the logarithm of the humidity ratio, and
+ *  of the temperatures near saturation, within the tolerance, at the cost of PROBES_PER_AXIS³
+ *  exact calculations per cell when the table is created. The error report then covers the lookups as they are answered, and counts
+ *  the cells calculated with the exact function.
+ *
+ *  A table can be saved to a file, and the file mapped in memory by other processes instead of
+ *  being built again. The file holds a header, the nodes of each tabulated property in native
+ *  byte order and a bit per cell of each property with a tolerance; files written on a machine
+ *  of another byte order, or in the other system of units, are rejected. The table, once created or mapped, is read-only and can be shared by
+ *  threads. The system of units must not be changed while the table is in use.
+ *
+ *  The inputs of the exact functions are checked as in the generic functions: the box must lie
+ *  within their domain of validity.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_table.h"
+ *  SetUnitSystem(SI);
+ *  struct PsychroTableConfig Config = { { 10., 40., 301 }, { 0.001, 0.025, 97 }, { 101325., 101325., 1 },
+ *    1 << PSYCHRO_TABLE_MOIST_AIR_DENSITY | 1 << PSYCHRO_TABLE_TWET_BULB, PSYCHRO_TABLE_CUBIC };
+ *  Config.Tolerance[PSYCHRO_TABLE_TWET_BULB] = 0.01;
+ *  PsychroTable *Table = PsychroTableCreate(&Config);
+ *  PsychroTableLookupBatch(Table, PSYCHRO_TABLE_TWET_BULB, Count, TDryBulb, HumRatio, Pressure, TWetBulb);
+ *  PsychroTableDestroy(Table);
+ */
+
+// Standard C header files
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Header specific to this file
+#include "psychrolib.h"
+#include "psychrolib_internal.h"
+#include "psychrolib_table.h"
+#include "psychrolib_trace.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define MAX_ERROR_SAMPLES 20000     // Maximum number of cells at which the error is measured.
+#define PROBES_PER_AXIS 4           // Points along each axis of a cell at which the error is checked against the tolerance.
+
+#define FILE_MAGIC "PSYCHTBL"       // First 8 bytes of a table file.
+
+#define FILE_VERSION 2              // Version of the format of the table files.
+
+#define BYTE_ORDER_MARK 0x01020304u // Written in native byte order, to reject files of another byte order.
+
+#define DATA_ALIGNMENT 64           // Alignment of the nodes in a table file, in bytes.
+
+#define N_AXES 3                    // Dry-bulb temperature, humidity ratio and pressure.
+
+
+/******************************************************************************************************
+ * Table structure and file format
+ *****************************************************************************************************/
+
+struct PsychroTable
+{
+  struct PsychroTableConfig Config;
+  struct PsychroTableErrorReport Report;
+  enum UnitSystem Units;
+  double Min[N_AXES];
+  double InvStep[N_AXES];                       // Number of cells / (Max - Min), 0 for a single node
+  size_t Count[N_AXES];
+  size_t LastCell[N_AXES];                      // First node of the last cell, 0 for a single node
+  size_t Next[N_AXES];                          // Offset of the next node along the axis, 0 for a single node
+  size_t NCells[N_AXES];                        // Number of cells, 1 for a single node
+  const double *Values[PSYCHRO_TABLE_N_PROPERTIES]; // Nodes of each property, NULL if not tabulated
+  const uint8_t *ExactCells[PSYCHRO_TABLE_N_PROPERTIES]; // Bit of each cell calculated with the exact function, NULL without tolerance
+  void *Memory;                                 // Allocated nodes, or mapped file
+  size_t MappedSize;                            // Size of the mapped file, 0 if the nodes are allocated
+#if defined(_WIN32)
+  HANDLE Mapping;
+#endif
+};
+
+// Header of a table file. The nodes of the tabulated properties follow at DataOffset, in the
+// order of enum PsychroTableProperty, with the dry-bulb temperature varying fastest, then the
+// bits of the cells calculated with the exact function of the properties with a tolerance.
+struct FileHeader
+{
+  char Magic[8];
+  uint32_t Version;
+  uint32_t ByteOrderMark;
+  int32_t Units;
+  int32_t Interpolation;
+  uint32_t Properties;
+  uint32_t Reserved;
+  double Min[N_AXES];
+  double Max[N_AXES];
+  uint64_t Count[N_AXES];
+  uint64_t Samples;
+  double MaxAbsError[PSYCHRO_TABLE_N_PROPERTIES];
+  double RmsError[PSYCHRO_TABLE_N_PROPERTIES];
+  double Tolerance[PSYCHRO_TABLE_N_PROPERTIES];
+  uint64_t ExactCells[PSYCHRO_TABLE_N_PROPERTIES];
+  uint64_t DataOffset;
+  uint64_t DataSize;
+};
+
+// Exact value of a property
+static double Exact_
+  ( enum PsychroTableProperty Property
+  , double TDryBulb
+  , double HumRatio
+  , double Pressure
+  )
+{
+  switch (Property)
+  {
+    case PSYCHRO_TABLE_MOIST_AIR_DENSITY: return GetMoistAirDensity(TDryBulb, HumRatio, Pressure);
+    case PSYCHRO_TABLE_MOIST_AIR_ENTHALPY: return GetMoistAirEnthalpy(TDryBulb, HumRatio);
+    case PSYCHRO_TABLE_MOIST_AIR_VOLUME: return GetMoistAirVolume(TDryBulb, HumRatio, Pressure);
+    case PSYCHRO_TABLE_TWET_BULB: return GetTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure);
+    case PSYCHRO_TABLE_TDEW_POINT: return GetTDewPointFromHumRatio(TDryBulb, HumRatio, Pressure);
+    default: return GetRelHumFromHumRatio(TDryBulb, HumRatio, Pressure);
+  }
+}
+
+static const struct PsychroTableAxis *Axis_
+  ( const struct PsychroTableConfig *Config
+  , int a
+  )
+{
+  return a == 0 ? &Config->TDryBulb : a == 1 ? &Config->HumRatio : &Config->Pressure;
+}
+
+// Number of nodes of the table, 0 if the configuration is invalid
+static size_t CountNodes_
+  ( const struct PsychroTableConfig *Config
+  )
+{
+  const struct PsychroTableAxis *Axis;
+  size_t NNodes = 1;
+  int a, p;
+
+  if (Config->Properties == 0 || Config->Properties >= 1u << PSYCHRO_TABLE_N_PROPERTIES
+      || (Config->Interpolation != PSYCHRO_TABLE_TRILINEAR && Config->Interpolation != PSYCHRO_TABLE_CUBIC))
+    return 0;
+  for (p = 0; p < PSYCHRO_TABLE_N_PROPERTIES; p++)
+    if (!(Config->Tolerance[p] >= 0.) || isinf(Config->Tolerance[p]))
+      return 0;
+  if (Config->TDryBulb.Min < (isIP() ? -148. : -100.) || Config->TDryBulb.Max > (isIP() ? 392. : 200.)
+      || Config->HumRatio.Min < 0. || Config->Pressure.Min <= 0.)
+    return 0;
+  for (a = 0; a < N_AXES; a++)
+  {
+    Axis = Axis_(Config, a);
+    if (Axis->Count == 0 || !isfinite(Axis->Min) || !isfinite(Axis->Max)
+        || (Axis->Count == 1 ? Axis->Max != Axis->Min : Axis->Max <= Axis->Min)
+        || Axis->Count > SIZE_MAX / sizeof(double) / PSYCHRO_TABLE_N_PROPERTIES / NNodes)
+      return 0;
+    NNodes *= Axis->Count;
+  }
+  return NNodes;
+}
+
+// Grid of the table from its configuration
+static void InitGrid_
+  ( PsychroTable *Table
+  , const struct PsychroTableConfig *Config
+  )
+{
+  const struct PsychroTableAxis *Axis;
+  int a;
+
+  Table->Config = *Config;
+  Table->Units = GetUnitSystem();
+  for (a = 0; a < N_AXES; a++)
+  {
+    Axis = Axis_(Config, a);
+    Table->Min[a] = Axis->Min;
+    Table->Count[a] = Axis->Count;
+    Table->InvStep[a] = Axis->Count == 1 ? 0. : (Axis->Count - 1) / (Axis->Max - Axis->Min);
+    Table->LastCell[a] = Axis->Count == 1 ? 0 : Axis->Count - 2;
+    Table->NCells[a] = Table->LastCell[a] + 1;
+  }
+  Table->Next[0] = Table->Count[0] > 1;
+  Table->Next[1] = Table->Count[1] > 1 ? Table->Count[0] : 0;
+  Table->Next[2] = Table->Count[2] > 1 ? Table->Count[0] * Table->Count[1] : 0;
+}
+
+// Whether a property has cells calculated with the exact function
+static int HasExactCells_
+  ( const struct PsychroTableConfig *Config
+  , int Property
+  )
+{
+  return ((Config->Properties >> Property) & 1) && Config->Tolerance[Property] > 0.;
+}
+
+// Size in bytes of the bits of the cells of a property
+static size_t ExactCellsSize_
+  ( const PsychroTable *Table
+  )
+{
+  return (Table->NCells[0] * Table->NCells[1] * Table->NCells[2] + 7) / 8;
+}
+
+// Size in bytes of the nodes of the tabulated properties, followed by the bits of the cells of
+// the properties with a tolerance
+static size_t DataSize_
+  ( const PsychroTable *Table
+  )
+{
+  size_t NNodes = Table->Count[0] * Table->Count[1] * Table->Count[2], Size = 0;
+  int Property;
+
+  for (Property = 0; Property < PSYCHRO_TABLE_N_PROPERTIES; Property++)
+  {
+    if ((Table->Config.Properties >> Property) & 1)
+      Size += NNodes * sizeof(double);
+    if (HasExactCells_(&Table->Config, Property))
+      Size += ExactCellsSize_(Table);
+  }
+  return Size;
+}
+
+// Coordinate of node k of axis a, exactly Max for the last node
+static double Node_
+  ( const PsychroTable *Table
+  , int a
+  , size_t k
+  )
+{
+  const struct PsychroTableAxis *Axis = Axis_(&Table->Config, a);
+
+  return k + 1 == Axis->Count ? Axis->Max : Axis->Min + (Axis->Max - Axis->Min) * k / max(Axis->Count - 1, 1);
+}
+
+static int InBounds_
+  ( const PsychroTable *Table
+  , double TDryBulb
+  , double HumRatio
+  , double Pressure
+  )
+{
+  const struct PsychroTableConfig *c = &Table->Config;
+
+  return TDryBulb >= c->TDryBulb.Min && TDryBulb <= c->TDryBulb.Max && HumRatio >= c->HumRatio.Min
+    && HumRatio <= c->HumRatio.Max && Pressure >= c->Pressure.Min && Pressure <= c->Pressure.Max;
+}
+
+// Index of the cell of a point within the box, with the dry-bulb temperature varying fastest
+static size_t Cell_
+  ( const PsychroTable *Table
+  , double TDryBulb
+  , double HumRatio
+  , double Pressure
+  )
+{
+  size_t i0 = min((size_t) ((TDryBulb - Table->Min[0]) * Table->InvStep[0]), Table->LastCell[0]);
+  size_t i1 = min((size_t) ((HumRatio - Table->Min[1]) * Table->InvStep[1]), Table->LastCell[1]);
+  size_t i2 = min((size_t) ((Pressure - Table->Min[2]) * Table->InvStep[2]), Table->LastCell[2]);
+
+  return i0 + Table->NCells[0] * (i1 + Table->NCells[1] * i2);
+}
+
+// Whether a property is interpolated at a point: tabulated, within the box, and not in a cell
+// calculated with the exact function
+static int Interpolated_
+  ( const PsychroTable *Table
+  , const double *Values
+  , const uint8_t *ExactCells
+  , double TDryBulb
+  , double HumRatio
+  , double Pressure
+  )
+{
+  size_t Cell;
+
+  if (Values == NULL || !InBounds_(Table, TDryBulb, HumRatio, Pressure))
+    return 0;
+  if (ExactCells == NULL)
+    return 1;
+  Cell = Cell_(Table, TDryBulb, HumRatio, Pressure);
+  return !((ExactCells[Cell >> 3] >> (Cell & 7)) & 1);
+}
+
+// First node and weights of the nodes used to interpolate along axis a, return the number of nodes
+static int Weights_
+  ( const PsychroTable *Table
+  , int a
+  , double x                    // (i) Coordinate within the bounds of the axis
+  , size_t *Start               // (o) First node
+  , double w[4]                 // (o) Weights of the nodes
+  )
+{
+  size_t n = Table->Count[a], i;
+  double u, t;
+
+  if (n == 1)
+  {
+    *Start = 0;
+    w[0] = 1.;
+    return 1;
+  }
+  u = (x - Table->Min[a]) * Table->InvStep[a];
+  i = min((size_t) u, n - 2);
+  if (Table->Config.Interpolation == PSYCHRO_TABLE_CUBIC && n >= 4)
+  {
+    // Lagrange polynomials on nodes i - 1 to i + 2, shifted inside the axis at its ends
+    i = i == 0 ? 0 : min(i - 1, n - 4);
+    t = u - i;
+    w[0] = (t - 1.) * (t - 2.) * (3. - t) * (1. / 6.);
+    w[1] = t * (t - 2.) * (t - 3.) * 0.5;
+    w[2] = t * (t - 1.) * (3. - t) * 0.5;
+    w[3] = t * (t - 1.) * (t - 2.) * (1. / 6.);
+    *Start = i;
+    return 4;
+  }
+  u -= i;
+  w[0] = 1. - u;
+  w[1] = u;
+  *Start = i;
+  return 2;
+}
+
+// Trilinear interpolation at a point within the box, without branches: an axis with a single
+// node has a step of 0 and a next node at offset 0
+static double Trilinear_
+  ( const PsychroTable *Table
+  , const double *Values
+  , double TDryBulb
+  , double HumRatio
+  , double Pressure
+  )
+{
+  double u0 = (TDryBulb - Table->Min[0]) * Table->InvStep[0];
+  double u1 = (HumRatio - Table->Min[1]) * Table->InvStep[1];
+  double u2 = (Pressure - Table->Min[2]) * Table->InvStep[2];
+  size_t i0 = min((size_t) u0, Table->LastCell[0]);
+  size_t i1 = min((size_t) u1, Table->LastCell[1]);
+  size_t i2 = min((size_t) u2, Table->LastCell[2]);
+  size_t d0 = Table->Next[0], d1 = Table->Next[1], d2 = Table->Next[2];
+  const double *v = Values + i0 + i1 * d1 + i2 * d2;
+  double f0 = u0 - i0, f1 = u1 - i1, f2 = u2 - i2, c00, c10, c01, c11, c0, c1;
+  c00 = v[0] + f0 * (v[d0] - v[0]);
+  c10 = v[d1] + f0 * (v[d1 + d0] - v[d1]);
+  c01 = v[d2] + f0 * (v[d2 + d0] - v[d2]);
+  c11 = v[d2 + d1] + f0 * (v[d2 + d1 + d0] - v[d2 + d1]);
+  c0 = c00 + f1 * (c10 - c00);
+  c1 = c01 + f1 * (c11 - c01);
+  return c0 + f2 * (c1 - c0);
+}
+
+// Interpolation with the Lagrange polynomials of each axis
+static double Lagrange_
+  ( const PsychroTable *Table
+  , const double *Values
+  , double TDryBulb
+  , double HumRatio
+  , double Pressure
+  )
+{
+  size_t s[N_AXES];
+  double w[N_AXES][4], Sum = 0., Plane, Line;
+  const double *Row;
+  int m[N_AXES], i, j, k;
+
+  m[0] = Weights_(Table, 0, TDryBulb, &s[0], w[0]);
+  m[1] = Weights_(Table, 1, HumRatio, &s[1], w[1]);
+  m[2] = Weights_(Table, 2, Pressure, &s[2], w[2]);
+  for (k = 0; k < m[2]; k++)
+  {
+    Plane = 0.;
+    for (j = 0; j < m[1]; j++)
+    {
+      Row = Values + s[0] + (s[1] + j) * Table->Next[1] + (s[2] + k) * Table->Next[2];
+      if (m[0] == 4)
+        Line = w[0][0] * Row[0] + w[0][1] * Row[1] + w[0][2] * Row[2] + w[0][3] * Row[3];
+      else
+        for (Line = 0., i = 0; i < m[0]; i++)
+          Line += w[0][i] * Row[i];
+      Plane += w[1][j] * Line;
+    }
+    Sum += w[2][k] * Plane;
+  }
+  return Sum;
+}
+
+// Interpolated value of a tabulated property at a point within the box
+static double Interpolate_
+  ( const PsychroTable *Table
+  , const double *Values
+  , double TDryBulb
+  , double HumRatio
+  , double Pressure
+  )
+{
+  if (Table->Config.Interpolation == PSYCHRO_TABLE_TRILINEAR)
+    return Trilinear_(Table, Values, TDryBulb, HumRatio, Pressure);
+  return Lagrange_(Table, Values, TDryBulb, HumRatio, Pressure);
+}
+
+// Mark the cells of a property where the error exceeds half the tolerance at one of the
+// PROBES_PER_AXIS³ points of a uniform grid inside the cell, and return their number
+static size_t MarkExactCells_
+  ( PsychroTable *Table
+  , int Property
+  , uint8_t *ExactCells         // (o) Bit of each cell, zeroed
+  )
+{
+  double x[N_AXES], Lower[N_AXES], Step[N_AXES], HalfTolerance = Table->Config.Tolerance[Property] / 2.;
+  size_t c[N_AXES], Cell = 0, NExact = 0;
+  int a, k, Exact;
+
+  for (c[2] = 0; c[2] < Table->NCells[2]; c[2]++)
+    for (c[1] = 0; c[1] < Table->NCells[1]; c[1]++)
+      for (c[0] = 0; c[0] < Table->NCells[0]; c[0]++, Cell++)
+      {
+        for (a = 0; a < N_AXES; a++)
+        {
+          Lower[a] = Node_(Table, a, c[a]);
+          Step[a] = Table->Count[a] == 1 ? 0. : (Node_(Table, a, c[a] + 1) - Lower[a]) / PROBES_PER_AXIS;
+        }
+        for (k = 0, Exact = 0; k < PROBES_PER_AXIS * PROBES_PER_AXIS * PROBES_PER_AXIS && !Exact; k++)
+        {
+          x[0] = Lower[0] + Step[0] * (k % PROBES_PER_AXIS + 0.5);
+          x[1] = Lower[1] + Step[1] * (k / PROBES_PER_AXIS % PROBES_PER_AXIS + 0.5);
+          x[2] = Lower[2] + Step[2] * (k / PROBES_PER_AXIS / PROBES_PER_AXIS + 0.5);
+          Exact = !(fabs(Interpolate_(Table, Table->Values[Property], x[0], x[1], x[2])
+            - Exact_(Property, x[0], x[1], x[2])) <= HalfTolerance);
+        }
+        if (Exact)
+        {
+          ExactCells[Cell >> 3] |= (uint8_t) (1u << (Cell & 7));
+          NExact++;
+        }
+      }
+  return NExact;
+}
+
+// Measure the error of the lookups at the centers of the cells: all of them, or
+// MAX_ERROR_SAMPLES cells chosen along an additive recurrence with irrational steps
+static void MeasureError_
+  ( PsychroTable *Table
+  )
+{
+  static const double STEPS[N_AXES] = { 0.41421356237309505, 0.7320508075688772, 0.2360679774997897 };
+  double x[N_AXES], Error, SumSquares[PSYCHRO_TABLE_N_PROPERTIES] = { 0. };
+  size_t NCells[N_AXES], Total = 1, Samples, Cell, k;
+  int a, p;
+
+  for (a = 0; a < N_AXES; a++)
+  {
+    NCells[a] = max(Table->Count[a] - 1, 1);
+    Total = Total > MAX_ERROR_SAMPLES / NCells[a] ? MAX_ERROR_SAMPLES + 1 : Total * NCells[a];
+  }
+  Samples = min(Total, MAX_ERROR_SAMPLES);
+  Table->Report.Samples = Samples;
+
+  for (k = 0; k < Samples; k++)
+  {
+    Cell = k;
+    for (a = 0; a < N_AXES; a++)
+    {
+      size_t c;
+      if (Total <= MAX_ERROR_SAMPLES)
+      {
+        c = Cell % NCells[a];
+        Cell /= NCells[a];
+      }
+      else
+        c = min((size_t) (fmod((k + 1) * STEPS[a], 1.) * NCells[a]), NCells[a] - 1);
+      x[a] = Table->Count[a] == 1 ? Table->Min[a] : (Node_(Table, a, c) + Node_(Table, a, c + 1)) / 2.;
+    }
+    for (p = 0; p < PSYCHRO_TABLE_N_PROPERTIES; p++)
+      if (Interpolated_(Table, Table->Values[p], Table->ExactCells[p], x[0], x[1], x[2]))
+      {
+        Error = fabs(Interpolate_(Table, Table->Values[p], x[0], x[1], x[2]) - Exact_(p, x[0], x[1], x[2]));
+        Table->Report.MaxAbsError[p] = fmax(Table->Report.MaxAbsError[p], Error);
+        SumSquares[p] += Error * Error;
+      }
+  }
+  for (p = 0; p < PSYCHRO_TABLE_N_PROPERTIES; p++)
+    Table->Report.RmsError[p] = sqrt(SumSquares[p] / Samples);
+}
+
+
+/******************************************************************************************************
+ * Table management
+ *****************************************************************************************************/
+
+// Sample the exact functions on the grid of the configuration and measure the error.
+PsychroTable *PsychroTableCreate          // (o) New table, NULL if the configuration is invalid or out of memory
+  ( const struct PsychroTableConfig *Config // (i) Box, resolution, properties and interpolation of the table
+  )
+{
+  PsychroTable *Table;
+  size_t NNodes = CountNodes_(Config), t, w, p, n;
+  double *Nodes, TDryBulb, HumRatio, Pressure;
+  uint8_t *ExactCells;
+  int Property;
+
+  if (NNodes == 0)
+    return NULL;
+  Table = calloc(1, sizeof(PsychroTable));
+  if (Table == NULL)
+    return NULL;
+  InitGrid_(Table, Config);
+  Nodes = calloc(1, DataSize_(Table));
+  if (Nodes == NULL)
+  {
+    free(Table);
+    return NULL;
+  }
+  Table->Memory = Nodes;
+
+  for (Property = 0; Property < PSYCHRO_TABLE_N_PROPERTIES; Property++)
+  {
+    if (!((Config->Properties >> Property) & 1))
+      continue;
+    Table->Values[Property] = Nodes;
+    n = 0;
+    for (p = 0; p < Table->Count[2]; p++)
+    {
+      Pressure = Node_(Table, 2, p);
+      for (w = 0; w < Table->Count[1]; w++)
+      {
+        HumRatio = Node_(Table, 1, w);
+        for (t = 0; t < Table->Count[0]; t++)
+        {
+          TDryBulb = Node_(Table, 0, t);
+          Nodes[n++] = Exact_(Property, TDryBulb, HumRatio, Pressure);
+        }
+      }
+    }
+    Nodes += NNodes;
+  }
+
+  ExactCells = (uint8_t *) Nodes;
+  for (Property = 0; Property < PSYCHRO_TABLE_N_PROPERTIES; Property++)
+    if (HasExactCells_(Config, Property))
+    {
+      Table->Report.ExactCells[Property] = MarkExactCells_(Table, Property, ExactCells);
+      Table->ExactCells[Property] = ExactCells;
+      ExactCells += ExactCellsSize_(Table);
+    }
+
+  MeasureError_(Table);
+  return Table;
+}
+
+// Map a table file in memory, read-only.
+PsychroTable *PsychroTableOpen  // (o) Table mapped in memory, NULL if the file cannot be mapped, is invalid, or is in another system of units
+  ( const char *Path            // (i) File written by PsychroTableSave
+  )
+{
+  struct PsychroTableConfig Config;
+  const struct FileHeader *Header;
+  PsychroTable *Table;
+  size_t Size, NNodes;
+  const double *Nodes;
+  const uint8_t *ExactCells;
+  void *Memory;
+  int Property, a;
+
+#if defined(_WIN32)
+  HANDLE File, Mapping;
+  LARGE_INTEGER FileSize;
+
+  File = CreateFileA(Path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (File == INVALID_HANDLE_VALUE)
+    return NULL;
+  if (!GetFileSizeEx(File, &FileSize) || FileSize.QuadPart < (LONGLONG) sizeof(struct FileHeader)
+      || (Mapping = CreateFileMappingA(File, NULL, PAGE_READONLY, 0, 0, NULL)) == NULL)
+  {
+    CloseHandle(File);
+    return NULL;
+  }
+  CloseHandle(File);
+  Size = (size_t) FileSize.QuadPart;
+  Memory = MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+  if (Memory == NULL)
+  {
+    CloseHandle(Mapping);
+    return NULL;
+  }
+#else
+  struct stat Stat;
+  int fd = open(Path, O_RDONLY);
+
+  if (fd < 0)
+    return NULL;
+  if (fstat(fd, &Stat) != 0 || Stat.st_size < (off_t) sizeof(struct FileHeader))
+  {
+    close(fd);
+    return NULL;
+  }
+  Size = (size_t) Stat.st_size;
+  Memory = mmap(NULL, Size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (Memory == MAP_FAILED)
+    return NULL;
+#endif
+
+  // Check the header against the configuration it describes and the size of the file
+  Header = Memory;
+  memset(&Config, 0, sizeof Config);
+  Config.Properties = Header->Properties;
+  Config.Interpolation = (enum PsychroTableInterpolation) Header->Interpolation;
+  Config.TDryBulb = (struct PsychroTableAxis) { Header->Min[0], Header->Max[0], (size_t) Header->Count[0] };
+  Config.HumRatio = (struct PsychroTableAxis) { Header->Min[1], Header->Max[1], (size_t) Header->Count[1] };
+  Config.Pressure = (struct PsychroTableAxis) { Header->Min[2], Header->Max[2], (size_t) Header->Count[2] };
+  Table = NULL;
+  if (memcmp(Header->Magic, FILE_MAGIC, 8) == 0 && Header->Version == FILE_VERSION
+      && Header->ByteOrderMark == BYTE_ORDER_MARK && Header->Units == (int32_t) GetUnitSystem())
+  {
+    for (Property = 0; Property < PSYCHRO_TABLE_N_PROPERTIES; Property++)
+      Config.Tolerance[Property] = Header->Tolerance[Property];
+    if ((NNodes = CountNodes_(&Config)) != 0 && Header->DataOffset % sizeof(double) == 0
+        && Header->DataOffset <= Size && Header->DataSize <= Size - Header->DataOffset
+        && (Table = calloc(1, sizeof(PsychroTable))) != NULL)
+    {
+      InitGrid_(Table, &Config);
+      if (Header->DataSize != DataSize_(Table))
+      {
+        free(Table);
+        Table = NULL;
+      }
+    }
+  }
+  if (Table == NULL)
+  {
+#if defined(_WIN32)
+    UnmapViewOfFile(Memory);
+    CloseHandle(Mapping);
+#else
+    munmap(Memory, Size);
+#endif
+    return NULL;
+  }
+
+  Table->Memory = Memory;
+  Table->MappedSize = Size;
+#if defined(_WIN32)
+  Table->Mapping = Mapping;
+#endif
+  Table->Report.Samples = (size_t) Header->Samples;
+  for (a = 0; a < PSYCHRO_TABLE_N_PROPERTIES; a++)
+  {
+    Table->Report.MaxAbsError[a] = Header->MaxAbsError[a];
+    Table->Report.RmsError[a] = Header->RmsError[a];
+    Table->Report.ExactCells[a] = (size_t) Header->ExactCells[a];
+  }
+  Nodes = (const double *) ((const char *) Memory + Header->DataOffset);
+  for (Property = 0; Property < PSYCHRO_TABLE_N_PROPERTIES; Property++)
+    if ((Config.Properties >> Property) & 1)
+    {
+      Table->Values[Property] = Nodes;
+      Nodes += NNodes;
+    }
+  ExactCells = (const uint8_t *) Nodes;
+  for (Property = 0; Property < PSYCHRO_TABLE_N_PROPERTIES; Property++)
+    if (HasExactCells_(&Config, Property))
+    {
+      Table->ExactCells[Property] = ExactCells;
+      ExactCells += ExactCellsSize_(Table);
+    }
+  return Table;
+}
+
+// Write the table to a file that PsychroTableOpen can map.
+int PsychroTableSave            // (o) 0 on success, -1 if the file cannot be written
+  ( const PsychroTable *Table   // (i) Table
+  , const char *Path            // (i) File to write
+  )
+{
+  static const char PADDING[DATA_ALIGNMENT] = { 0 };
+  struct FileHeader Header;
+  size_t NNodes = Table->Count[0] * Table->Count[1] * Table->Count[2], Padding;
+  int Property, a, Failed;
+  FILE *fp;
+
+  memset(&Header, 0, sizeof Header);
+  memcpy(Header.Magic, FILE_MAGIC, 8);
+  Header.Version = FILE_VERSION;
+  Header.ByteOrderMark = BYTE_ORDER_MARK;
+  Header.Units = (int32_t) Table->Units;
+  Header.Interpolation = (int32_t) Table->Config.Interpolation;
+  Header.Properties = Table->Config.Properties;
+  for (a = 0; a < N_AXES; a++)
+  {
+    Header.Min[a] = Axis_(&Table->Config, a)->Min;
+    Header.Max[a] = Axis_(&Table->Config, a)->Max;
+    Header.Count[a] = Table->Count[a];
+  }
+  Header.Samples = Table->Report.Samples;
+  for (a = 0; a < PSYCHRO_TABLE_N_PROPERTIES; a++)
+  {
+    Header.MaxAbsError[a] = Table->Report.MaxAbsError[a];
+    Header.RmsError[a] = Table->Report.RmsError[a];
+    Header.Tolerance[a] = Table->Config.Tolerance[a];
+    Header.ExactCells[a] = Table->Report.ExactCells[a];
+  }
+  Padding = (DATA_ALIGNMENT - sizeof Header % DATA_ALIGNMENT) % DATA_ALIGNMENT;
+  Header.DataOffset = sizeof Header + Padding;
+  Header.DataSize = DataSize_(Table);
+
+  fp = fopen(Path, "wb");
+  if (fp == NULL)
+    return -1;
+  Failed = fwrite(&Header, sizeof Header, 1, fp) != 1 || fwrite(PADDING, 1, Padding, fp) != Padding;
+  for (Property = 0; Property < PSYCHRO_TABLE_N_PROPERTIES && !Failed; Property++)
+    if (Table->Values[Property] != NULL)
+      Failed = fwrite(Table->Values[Property], sizeof(double), NNodes, fp) != NNodes;
+  for (Property = 0; Property < PSYCHRO_TABLE_N_PROPERTIES && !Failed; Property++)
+    if (Table->ExactCells[Property] != NULL)
+      Failed = fwrite(Table->ExactCells[Property], 1, ExactCellsSize_(Table), fp) != ExactCellsSize_(Table);
+  Failed |= fclose(fp) != 0;
+  return Failed ? -1 : 0;
+}
+
+void PsychroTableDestroy
+  ( PsychroTable *Table         // (i) Table to free or unmap, may be NULL
+  )
+{
+  if (Table == NULL)
+    return;
+  if (Table->MappedSize == 0)
+    free(Table->Memory);
+  else
+  {
+#if defined(_WIN32)
+    UnmapViewOfFile(Table->Memory);
+    CloseHandle(Table->Mapping);
+#else
+    munmap(Table->Memory, Table->MappedSize);
+#endif
+  }
+  free(Table);
+}
+
+void PsychroTableGetConfig
+  ( const PsychroTable *Table           // (i) Table
+  , struct PsychroTableConfig *Config   // (o) Configuration of the table
+  )
+{
+  *Config = Table->Config;
+}
+
+void PsychroTableGetErrorReport
+  ( const PsychroTable *Table               // (i) Table
+  , struct PsychroTableErrorReport *Report  // (o) Error measured when the table was created
+  )
+{
+  *Report = Table->Report;
+}
+
+
+/******************************************************************************************************
+ * Lookups
+ *****************************************************************************************************/
+
+// Return a property, interpolated within the box of the table, exact otherwise.
+double PsychroTableLookup       // (o) Interpolated property, or exact outside the box, beyond the tolerance or if not tabulated
+  ( const PsychroTable *Table   // (i) Table
+  , enum PsychroTableProperty Property // (i) Property
+  , double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  )
+{
+  const double *Values = (unsigned) Property < PSYCHRO_TABLE_N_PROPERTIES ? Table->Values[Property] : NULL;
+  const uint8_t *ExactCells = (unsigned) Property < PSYCHRO_TABLE_N_PROPERTIES ? Table->ExactCells[Property] : NULL;
+
+  if (Interpolated_(Table, Values, ExactCells, TDryBulb, HumRatio, Pressure))
+    return Interpolate_(Table, Values, TDryBulb, HumRatio, Pressure);
+  return Exact_(Property, TDryBulb, HumRatio, Pressure);
+}
+
+// Return a property at each point, interpolated within the box of the table, exact otherwise.
+size_t PsychroTableLookupBatch  // (o) Number of points calculated with the exact function
+  ( const PsychroTable *Table   // (i) Table
+  , enum PsychroTableProperty Property // (i) Property
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *HumRatio      // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , const double *Pressure      // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *Value               // (o) Property of each point
+  )
+{
+  const double *Values = (unsigned) Property < PSYCHRO_TABLE_N_PROPERTIES ? Table->Values[Property] : NULL;
+  const uint8_t *ExactCells = (unsigned) Property < PSYCHRO_TABLE_N_PROPERTIES ? Table->ExactCells[Property] : NULL;
+  size_t i, NExact = 0;
+
+  PSYCHRO_PROBE_BATCH_ENTRY(Count);
+  for (i = 0; i < Count; i++)
+    if (Interpolated_(Table, Values, ExactCells, TDryBulb[i], HumRatio[i], Pressure[i]))
+      Value[i] = Interpolate_(Table, Values, TDryBulb[i], HumRatio[i], Pressure[i]);
+    else
+    {
+      Value[i] = Exact_(Property, TDryBulb[i], HumRatio[i], Pressure[i]);
+      NExact++;
+    }
+  PSYCHRO_PROBE_BATCH_RETURN(Count);
+  return NExact;
+}
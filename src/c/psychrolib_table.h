@@ -0,0 +1,122 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Property tables: interpolation of moist air properties over a box of dry-bulb temperature,
+ * humidity ratio and pressure, with exact fallback outside the box and beyond a tolerance.
+ * See psychrolib_table.c for details.
+*/
+
+#ifndef PSYCHROLIB_TABLE_H
+#define PSYCHROLIB_TABLE_H
+
+#include <stddef.h>
+
+
+/******************************************************************************************************
+ * Table configuration and error report
+ *****************************************************************************************************/
+
+typedef struct PsychroTable PsychroTable;
+
+// Tabulated properties, functions of dry-bulb temperature, humidity ratio and pressure
+enum PsychroTableProperty
+{
+  PSYCHRO_TABLE_MOIST_AIR_DENSITY,      // GetMoistAirDensity
+  PSYCHRO_TABLE_MOIST_AIR_ENTHALPY,     // GetMoistAirEnthalpy
+  PSYCHRO_TABLE_MOIST_AIR_VOLUME,       // GetMoistAirVolume
+  PSYCHRO_TABLE_TWET_BULB,              // GetTWetBulbFromHumRatio
+  PSYCHRO_TABLE_TDEW_POINT,             // GetTDewPointFromHumRatio
+  PSYCHRO_TABLE_REL_HUM,                // GetRelHumFromHumRatio
+  PSYCHRO_TABLE_N_PROPERTIES
+};
+
+enum PsychroTableInterpolation
+{
+  PSYCHRO_TABLE_TRILINEAR,              // Linear in each dimension, 8 nodes
+  PSYCHRO_TABLE_CUBIC                   // Cubic Lagrange polynomials on 4 nodes in each dimension, 64 nodes
+};
+
+// Uniform grid of an input
+struct PsychroTableAxis
+{
+  double Min;                           // First node
+  double Max;                           // Last node, equal to Min for a single node
+  size_t Count;                         // Number of nodes
+};
+
+struct PsychroTableConfig
+{
+  struct PsychroTableAxis TDryBulb;     // Dry bulb temperature in °F [IP] or °C [SI]
+  struct PsychroTableAxis HumRatio;     // Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  struct PsychroTableAxis Pressure;     // Atmospheric pressure in Psi [IP] or Pa [SI]
+  unsigned Properties;                  // Tabulated properties: bitwise or of 1 << PSYCHRO_TABLE_*
+  enum PsychroTableInterpolation Interpolation;
+  double Tolerance[PSYCHRO_TABLE_N_PROPERTIES]; // Maximum error of each property, beyond which its cells are calculated with the exact function; 0 for no limit
+};
+
+// Error of the lookups against the exact functions, measured at the centers of the cells
+struct PsychroTableErrorReport
+{
+  size_t Samples;                                   // Number of cells measured
+  double MaxAbsError[PSYCHRO_TABLE_N_PROPERTIES];   // Maximum absolute error, 0 if not tabulated
+  double RmsError[PSYCHRO_TABLE_N_PROPERTIES];      // Root mean square error, 0 if not tabulated
+  size_t ExactCells[PSYCHRO_TABLE_N_PROPERTIES];    // Number of cells calculated with the exact function
+};
+
+
+/******************************************************************************************************
+ * Table management
+ *****************************************************************************************************/
+
+PsychroTable *PsychroTableCreate          // (o) New table, NULL if the configuration is invalid or out of memory
+  ( const struct PsychroTableConfig *Config // (i) Box, resolution, properties and interpolation of the table
+  );
+
+PsychroTable *PsychroTableOpen  // (o) Table mapped in memory, NULL if the file cannot be mapped, is invalid, or is in another system of units
+  ( const char *Path            // (i) File written by PsychroTableSave
+  );
+
+int PsychroTableSave            // (o) 0 on success, -1 if the file cannot be written
+  ( const PsychroTable *Table   // (i) Table
+  , const char *Path            // (i) File to write
+  );
+
+void PsychroTableDestroy
+  ( PsychroTable *Table         // (i) Table to free or unmap, may be NULL
+  );
+
+void PsychroTableGetConfig
+  ( const PsychroTable *Table           // (i) Table
+  , struct PsychroTableConfig *Config   // (o) Configuration of the table
+  );
+
+void PsychroTableGetErrorReport
+  ( const PsychroTable *Table               // (i) Table
+  , struct PsychroTableErrorReport *Report  // (o) Error measured when the table was created
+  );
+
+
+/******************************************************************************************************
+ * Lookups
+ *****************************************************************************************************/
+
+double PsychroTableLookup       // (o) Interpolated property, or exact outside the box, beyond the tolerance or if not tabulated
+  ( const PsychroTable *Table   // (i) Table
+  , enum PsychroTableProperty Property // (i) Property
+  , double TDryBulb             // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , double HumRatio             // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , double Pressure             // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  );
+
+size_t PsychroTableLookupBatch  // (o) Number of points calculated with the exact function
+  ( const PsychroTable *Table   // (i) Table
+  , enum PsychroTableProperty Property // (i) Property
+  , size_t Count                // (i) Number of points
+  , const double *TDryBulb      // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *HumRatio      // (i) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  , const double *Pressure      // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , double *Value               // (o) Property of each point
+  );
+
+#endif // PSYCHROLIB_TABLE_H
@@ -0,0 +1,99 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Static tracepoints (USDT probes) of the C library, compiled in with PSYCHROLIB_USDT.
+ *
+ * With PSYCHROLIB_USDT defined, the solvers, the CalcPsychrometrics* functions and the batch
+ * functions of the library have SystemTap/DTrace-compatible probes of provider psychrolib, which
+ * perf, bpftrace or any other USDT consumer can attach to without rebuilding. Each probe is guarded
+ * by a semaphore, that the kernel sets while a consumer is attached: a probe that is not attached
+ * costs a load and a predicted branch, and its arguments are not computed. Building with
+ * PSYCHROLIB_USDT requires sys/sdt.h (systemtap-sdt-dev or systemtap-sdt-devel).
+ *
+ * Without PSYCHROLIB_USDT, the probes expand to nothing and the library is unchanged.
+ *
+ * bpftrace cannot read floating-point arguments, so temperatures, pressures and humidity ratios
+ * are passed as integers in billionths of their unit (nano-units), INT64_MIN if not finite or out
+ * of range. Functions are passed by name, as strings.
+ *
+ * Probes
+ *  tdew_point_entry(TDryBulb, VapPres)                   GetTDewPointFromVapPres
+ *  tdew_point_return(TDewPoint, Iterations)
+ *  twet_bulb_entry(TDryBulb, HumRatio, Pressure)         GetTWetBulbFromHumRatio
+ *  twet_bulb_return(TWetBulb, Iterations)
+ *  calc_entry(Function, TDryBulb, Input, Pressure)       CalcPsychrometricsFrom*
+ *  calc_return(Function, HumRatio)
+ *  batch_entry(Function, Count)                          Batch functions of the site, inverse,
+ *  batch_return(Function, Count)                         table, gradient, lock-step, regime and
+ *                                                        frame modules
+ *  assert_failed(Message, FileName, LineNo)              Before the program exits on an error
+ *
+ * In the header-only build, the compiler may merge or remove calls to the pure functions, and
+ * their probes with them.
+ *
+ * Example
+ *  cc -O2 -DPSYCHROLIB_USDT -c psychrolib.c
+ *  bpftrace -e 'usdt:./app:psychrolib:twet_bulb_return { @iterations = hist(arg1); }'
+ *  perf buildid-cache --add ./app && perf probe sdt_psychrolib:calc_entry && perf record -e sdt_psychrolib:calc_entry ./app
+*/
+
+#ifndef PSYCHROLIB_TRACE_H
+#define PSYCHROLIB_TRACE_H
+
+#ifdef PSYCHROLIB_USDT
+
+#define _SDT_HAS_SEMAPHORES 1
+#include <stdint.h>
+#include <sys/sdt.h>
+
+// Semaphores of the probes, set by the kernel while a consumer is attached. They are weak, so that
+// every translation unit of the library can define them.
+#define PSYCHRO_SEMAPHORE_(Name) \
+  __extension__ volatile unsigned short psychrolib_##Name##_semaphore \
+  __attribute__((weak, used, section(".probes"))) = 0;
+
+PSYCHRO_SEMAPHORE_(tdew_point_entry)
+PSYCHRO_SEMAPHORE_(tdew_point_return)
+PSYCHRO_SEMAPHORE_(twet_bulb_entry)
+PSYCHRO_SEMAPHORE_(twet_bulb_return)
+PSYCHRO_SEMAPHORE_(calc_entry)
+PSYCHRO_SEMAPHORE_(calc_return)
+PSYCHRO_SEMAPHORE_(batch_entry)
+PSYCHRO_SEMAPHORE_(batch_return)
+PSYCHRO_SEMAPHORE_(assert_failed)
+
+// Value in nano-units, INT64_MIN if not finite or out of range
+static inline int64_t PsychroTraceValue_(double Value)
+{
+  Value *= 1e9;
+  return (Value > -9.2e18 && Value < 9.2e18) ? (int64_t) Value : INT64_MIN;
+}
+
+#define PSYCHRO_PROBE_ENABLED_(Name) __builtin_expect(psychrolib_##Name##_semaphore != 0, 0)
+
+#define PSYCHRO_PROBE1(Name, a) \
+  do { if (PSYCHRO_PROBE_ENABLED_(Name)) STAP_PROBE1(psychrolib, Name, a); } while (0)
+#define PSYCHRO_PROBE2(Name, a, b) \
+  do { if (PSYCHRO_PROBE_ENABLED_(Name)) STAP_PROBE2(psychrolib, Name, a, b); } while (0)
+#define PSYCHRO_PROBE3(Name, a, b, c) \
+  do { if (PSYCHRO_PROBE_ENABLED_(Name)) STAP_PROBE3(psychrolib, Name, a, b, c); } while (0)
+#define PSYCHRO_PROBE4(Name, a, b, c, d) \
+  do { if (PSYCHRO_PROBE_ENABLED_(Name)) STAP_PROBE4(psychrolib, Name, a, b, c, d); } while (0)
+
+#define PSYCHRO_TRACE_VALUE(Value)  PsychroTraceValue_(Value)
+
+#else
+
+#define PSYCHRO_PROBE1(Name, a)           do {} while (0)
+#define PSYCHRO_PROBE2(Name, a, b)        do {} while (0)
+#define PSYCHRO_PROBE3(Name, a, b, c)     do {} while (0)
+#define PSYCHRO_PROBE4(Name, a, b, c, d)  do {} while (0)
+
+#endif
+
+// Probes at the boundaries of a batch function
+#define PSYCHRO_PROBE_BATCH_ENTRY(Count)   PSYCHRO_PROBE2(batch_entry, (const char *) __func__, (uint64_t) (Count))
+#define PSYCHRO_PROBE_BATCH_RETURN(Count)  PSYCHRO_PROBE2(batch_return, (const char *) __func__, (uint64_t) (Count))
+
+#endif // PSYCHROLIB_TRACE_H
@@ -0,0 +1,498 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Module overview
+ *  Uncertainty propagation: Monte Carlo propagation of correlated sensor uncertainties through
+ *  the calculation of the psychrometric properties from relative humidity.
+ *
+ *  The dry-bulb temperature, relative humidity and pressure of each point are perturbed by
+ *  normally distributed errors with the standard uncertainties of the sensors and their
+ *  correlation matrix, from the Cholesky factor of the covariance. Specifications given as limits
+ *  (e.g. ±0.2 °C) must be converted to standard uncertainties by the caller: divided by √3 for a
+ *  rectangular distribution, or by the coverage factor for a normal one. Perturbed relative
+ *  humidities are clipped to [0, 1], and the samples are evaluated with
+ *  BoundedCalcPsychrometricsFromRelHum of psychrolib_bounded.c, which agrees with the generic
+ *  function to within its documented accuracy, runs in a fixed time and returns a status instead of
+ *  exiting: samples outside the range of the equations are counted as rejected and left out of
+ *  the statistics.
+ *
+ *  The samples of a point are generated and evaluated in blocks of BLOCK_SIZE, whose inputs and
+ *  outputs fit in the L1 cache, and reduced as they are evaluated: the mean and standard deviation
+ *  with Welford's updates, and each quantile with the P² algorithm of Jain and Chlamtac (1985),
+ *  which tracks five markers whatever the number of samples. The memory therefore does not depend
+ *  on the number of samples; the P² estimates converge to the quantiles as the number of samples
+ *  grows, e.g. to within a few percent of the standard deviation for the 2.5% and 97.5% quantiles
+ *  with 10⁴ samples of a smooth distribution.
+ *
+ *  Each point has its own random stream, a xoshiro256** generator seeded from the seed of the
+ *  configuration and the index of the point with SplitMix64. The results are therefore
+ *  reproducible, and do not depend on the number of threads between which the points are split.
+ *  The system of units must not be changed during a propagation.
+ *
+ * Example
+ *  #include "psychrolib.h"
+ *  #include "psychrolib_uncertainty.h"
+ *  SetUnitSystem(SI);
+ *  // ±0.2 °C, ±2% and ±100 Pa rectangular, uncorrelated; 95% interval and median
+ *  struct PsychroUncertaintyConfig Config = { { 0.2 / 1.732, 0.02 / 1.732, 100. / 1.732 },
+ *    { { 1., 0., 0. }, { 0., 1., 0. }, { 0., 0., 1. } }, 10000, 3, { 0.025, 0.5, 0.975 }, 42, 4 };
+ *  struct PsychroUncertaintyResult *Results = malloc(Count * sizeof(struct PsychroUncertaintyResult));
+ *  PsychroUncertaintyPropagate(&Config, Count, TDryBulb, RelHum, Pressure, Results);
+ *  double TWetBulbHigh = Results[0].Quantiles[PSYCHRO_UNC_TWET_BULB][2];
+ */
+
+// Standard C header files
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// Header specific to this file
+#include "psychrolib_bounded.h"
+#include "psychrolib_uncertainty.h"
+
+
+/******************************************************************************************************
+ * Global constants
+ *****************************************************************************************************/
+
+#define BLOCK_SIZE 256              // Number of samples generated and evaluated together.
+
+#define MAX_THREADS 64              // Maximum number of threads of a propagation.
+
+#define PI 3.141592653589793
+
+
+/******************************************************************************************************
+ * Helper functions
+ *****************************************************************************************************/
+
+// xoshiro256** generator
+struct Rng
+{
+  uint64_t s[4];
+};
+
+// P² estimator of a quantile, from the sixth sample: heights and actual and desired positions of the markers
+struct P2
+{
+  double q[5];
+  double n[5];
+  double np[5];
+  double dn[5];
+};
+
+// Statistics of the outputs of a point
+struct Stats
+{
+  size_t Count;
+  double Mean[PSYCHRO_UNC_N_OUTPUTS];
+  double M2[PSYCHRO_UNC_N_OUTPUTS];
+  double First[PSYCHRO_UNC_N_OUTPUTS][5];       // First five samples, to initialize the markers
+  struct P2 Quantiles[PSYCHRO_UNC_N_OUTPUTS][PSYCHRO_UNC_MAX_QUANTILES];
+};
+
+// Points of a propagation evaluated by a thread
+struct Worker
+{
+  const struct PsychroUncertaintyConfig *Config;
+  const double *L;              // Lower Cholesky factor of the covariance, row-major
+  size_t First;
+  size_t Count;
+  const double *TDryBulb;
+  const double *RelHum;
+  const double *Pressure;
+  struct PsychroUncertaintyResult *Results;
+};
+
+static uint64_t SplitMix_
+  ( uint64_t *State
+  )
+{
+  uint64_t z = (*State += 0x9E3779B97F4A7C15u);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+  return z ^ (z >> 31);
+}
+
+static uint64_t Rotl_
+  ( uint64_t x
+  , int k
+  )
+{
+  return (x << k) | (x >> (64 - k));
+}
+
+// Generator of the stream of a point
+static void Seed_
+  ( struct Rng *Rng
+  , uint64_t Seed
+  , uint64_t Stream
+  )
+{
+  uint64_t State = Seed ^ SplitMix_(&Stream);
+  int i;
+
+  for (i = 0; i < 4; i++)
+    Rng->s[i] = SplitMix_(&State);
+}
+
+static uint64_t Next_
+  ( struct Rng *Rng
+  )
+{
+  uint64_t *s = Rng->s;
+  uint64_t Result = Rotl_(s[1] * 5, 7) * 9;
+  uint64_t t = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = Rotl_(s[3], 45);
+  return Result;
+}
+
+// Standard normal variates, in pairs with the Box-Muller transform
+static void Normals_
+  ( struct Rng *Rng
+  , size_t Count                // (i) Even number of variates
+  , double *z
+  )
+{
+  double u1, u2, r;
+  size_t i;
+
+  for (i = 0; i < Count; i += 2)
+  {
+    u1 = ((Next_(Rng) >> 11) + 1.) * (1. / 9007199254740992.);    // (0, 1]
+    u2 = (Next_(Rng) >> 11) * (1. / 9007199254740992.);           // [0, 1)
+    r = sqrt(-2. * log(u1));
+    z[i] = r * cos(2. * PI * u2);
+    z[i + 1] = r * sin(2. * PI * u2);
+  }
+}
+
+static int CompareDoubles_
+  ( const void *a
+  , const void *b
+  )
+{
+  double x = *(const double *) a, y = *(const double *) b;
+  return (x > y) - (x < y);
+}
+
+static void InitP2_
+  ( struct P2 *P2
+  , const double First[5]       // (i) First five samples
+  , double p                    // (i) Cumulative frequency of the quantile
+  )
+{
+  int i;
+
+  memcpy(P2->q, First, sizeof P2->q);
+  qsort(P2->q, 5, sizeof(double), CompareDoubles_);
+  for (i = 0; i < 5; i++)
+    P2->n[i] = i;
+  P2->np[0] = 0.;
+  P2->np[1] = 2. * p;
+  P2->np[2] = 4. * p;
+  P2->np[3] = 2. + 2. * p;
+  P2->np[4] = 4.;
+  P2->dn[0] = 0.;
+  P2->dn[1] = p / 2.;
+  P2->dn[2] = p;
+  P2->dn[3] = (1. + p) / 2.;
+  P2->dn[4] = 1.;
+}
+
+static void UpdateP2_
+  ( struct P2 *P2
+  , double x
+  )
+{
+  double *q = P2->q, *n = P2->n, d, qp;
+  int i, k;
+
+  // Cell of the sample, extending the extreme markers
+  if (x < q[0])
+  {
+    q[0] = x;
+    k = 0;
+  }
+  else if (x >= q[4])
+  {
+    q[4] = x;
+    k = 3;
+  }
+  else
+    for (k = 0; x >= q[k + 1]; k++)
+      ;
+  for (i = k + 1; i < 5; i++)
+    n[i] += 1.;
+  for (i = 0; i < 5; i++)
+    P2->np[i] += P2->dn[i];
+
+  // Move the middle markers towards their desired positions, with a parabolic or linear prediction of their heights
+  for (i = 1; i < 4; i++)
+  {
+    d = P2->np[i] - n[i];
+    if ((d >= 1. && n[i + 1] - n[i] > 1.) || (d <= -1. && n[i - 1] - n[i] < -1.))
+    {
+      d = d > 0. ? 1. : -1.;
+      qp = q[i] + d / (n[i + 1] - n[i - 1]) * ((n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (n[i + 1] - n[i])
+        + (n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+      if (!(q[i - 1] < qp && qp < q[i + 1]))
+        qp = q[i] + d * (q[i + (int) d] - q[i]) / (n[i + (int) d] - n[i]);
+      q[i] = qp;
+      n[i] += d;
+    }
+  }
+}
+
+// Add a valid sample to the statistics
+static void Reduce_
+  ( struct Stats *Stats
+  , const struct PsychroUncertaintyConfig *Config
+  , const double Values[PSYCHRO_UNC_N_OUTPUTS]
+  )
+{
+  double Delta;
+  size_t j;
+  int k;
+
+  Stats->Count++;
+  for (k = 0; k < PSYCHRO_UNC_N_OUTPUTS; k++)
+  {
+    Delta = Values[k] - Stats->Mean[k];
+    Stats->Mean[k] += Delta / Stats->Count;
+    Stats->M2[k] += Delta * (Values[k] - Stats->Mean[k]);
+    if (Stats->Count <= 5)
+    {
+      Stats->First[k][Stats->Count - 1] = Values[k];
+      if (Stats->Count == 5)
+        for (j = 0; j < Config->NQuantiles; j++)
+          InitP2_(&Stats->Quantiles[k][j], Stats->First[k], Config->Probabilities[j]);
+    }
+    else
+      for (j = 0; j < Config->NQuantiles; j++)
+        UpdateP2_(&Stats->Quantiles[k][j], Values[k]);
+  }
+}
+
+static void Finish_
+  ( const struct Stats *Stats
+  , const struct PsychroUncertaintyConfig *Config
+  , struct PsychroUncertaintyResult *Result
+  )
+{
+  double Sorted[5], Rank;
+  size_t j, r;
+  int k;
+
+  for (k = 0; k < PSYCHRO_UNC_N_OUTPUTS; k++)
+  {
+    Result->Mean[k] = Stats->Count > 0 ? Stats->Mean[k] : NAN;
+    Result->StdDev[k] = Stats->Count > 1 ? sqrt(Stats->M2[k] / (Stats->Count - 1)) : Stats->Count > 0 ? 0. : NAN;
+    for (j = 0; j < PSYCHRO_UNC_MAX_QUANTILES; j++)
+      Result->Quantiles[k][j] = NAN;
+    if (Stats->Count >= 5)
+      for (j = 0; j < Config->NQuantiles; j++)
+        Result->Quantiles[k][j] = Stats->Quantiles[k][j].q[2];
+    else if (Stats->Count > 0)
+    {
+      // Too few samples for the markers: interpolate between the sorted samples
+      memcpy(Sorted, Stats->First[k], Stats->Count * sizeof(double));
+      qsort(Sorted, Stats->Count, sizeof(double), CompareDoubles_);
+      for (j = 0; j < Config->NQuantiles; j++)
+      {
+        Rank = Config->Probabilities[j] * (Stats->Count - 1);
+        r = (size_t) Rank;
+        Result->Quantiles[k][j] = r + 1 < Stats->Count ? Sorted[r] + (Rank - r) * (Sorted[r + 1] - Sorted[r]) : Sorted[r];
+      }
+    }
+  }
+}
+
+// Propagate the uncertainties of the points of a thread
+static void Propagate_
+  ( struct Worker *Worker
+  )
+{
+  const struct PsychroUncertaintyConfig *Config = Worker->Config;
+  const double *L = Worker->L;
+  double z[3 * BLOCK_SIZE], Values[PSYCHRO_UNC_N_OUTPUTS];
+  PsychroReal T[BLOCK_SIZE], RH[BLOCK_SIZE], P[BLOCK_SIZE], Out[PSYCHRO_UNC_N_OUTPUTS][BLOCK_SIZE];
+  enum PsychroStatus Status[BLOCK_SIZE];
+  struct Stats Stats;
+  struct Rng Rng;
+  size_t i, s, b, m;
+  int k;
+
+  for (i = 0; i < Worker->Count; i++)
+  {
+    struct PsychroUncertaintyResult *Result = &Worker->Results[i];
+
+    memset(&Stats, 0, sizeof(struct Stats));
+    Seed_(&Rng, Config->Seed, Worker->First + i);
+    for (s = 0; s < Config->Samples; s += m)
+    {
+      m = Config->Samples - s < BLOCK_SIZE ? Config->Samples - s : BLOCK_SIZE;
+      Normals_(&Rng, 3 * m + (m & 1), z);
+      for (b = 0; b < m; b++)
+      {
+        const double *n = &z[3 * b];
+        T[b] = Worker->TDryBulb[i] + Config->StdDev[0] * (L[0] * n[0]);
+        RH[b] = Worker->RelHum[i] + Config->StdDev[1] * (L[3] * n[0] + L[4] * n[1]);
+        RH[b] = RH[b] < 0. ? 0. : RH[b] > 1. ? 1. : RH[b];
+        P[b] = Worker->Pressure[i] + Config->StdDev[2] * (L[6] * n[0] + L[7] * n[1] + L[8] * n[2]);
+      }
+      for (b = 0; b < m; b++)
+        Status[b] = BoundedCalcPsychrometricsFromRelHum(T[b], RH[b], P[b], &Out[0][b], &Out[1][b], &Out[2][b],
+          &Out[3][b], &Out[4][b], &Out[5][b], &Out[6][b]);
+      for (b = 0; b < m; b++)
+      {
+        if (Status[b] != PSYCHRO_STATUS_OK)
+          continue;
+        for (k = 0; k < PSYCHRO_UNC_N_OUTPUTS; k++)
+          Values[k] = Out[k][b];
+        Reduce_(&Stats, Config, Values);
+      }
+    }
+    Finish_(&Stats, Config, Result);
+    Result->Rejected = Config->Samples - Stats.Count;
+  }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI Thread_(LPVOID Worker)
+{
+  Propagate_(Worker);
+  return 0;
+}
+#else
+static void *Thread_(void *Worker)
+{
+  Propagate_(Worker);
+  return NULL;
+}
+#endif
+
+// Lower Cholesky factor of the correlation matrix, which may be singular
+static int Cholesky_            // (o) 0 on success, -1 if the matrix is not a correlation matrix
+  ( const double C[3][3]
+  , double L[9]
+  )
+{
+  const double EPSILON = 1e-9;
+  double d;
+  int i, j;
+
+  for (i = 0; i < 3; i++)
+    for (j = 0; j < 3; j++)
+      if (!(fabs(C[i][j]) <= 1.) || C[i][j] != C[j][i] || (i == j && C[i][j] != 1.))
+        return -1;
+  memset(L, 0, 9 * sizeof(double));
+  L[0] = 1.;
+  L[3] = C[1][0];
+  L[6] = C[2][0];
+  d = 1. - L[3] * L[3];
+  L[4] = sqrt(fmax(d, 0.));
+  if (L[4] > EPSILON)
+    L[7] = (C[2][1] - L[6] * L[3]) / L[4];
+  else if (fabs(C[2][1] - L[6] * L[3]) > EPSILON)
+    return -1;
+  d = 1. - L[6] * L[6] - L[7] * L[7];
+  if (d < -EPSILON)
+    return -1;
+  L[8] = sqrt(fmax(d, 0.));
+  return 0;
+}
+
+
+/******************************************************************************************************
+ * Propagation
+ *****************************************************************************************************/
+
+// Propagate the uncertainties of the sensors to the outputs of CalcPsychrometricsFromRelHum at
+// each point, splitting the points between threads if requested.
+int PsychroUncertaintyPropagate         // (o) 0 on success, -1 if the configuration is invalid
+  ( const struct PsychroUncertaintyConfig *Config // (i) Uncertainties of the sensors, samples and quantiles
+  , size_t Count                        // (i) Number of points
+  , const double *TDryBulb              // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *RelHum                // (i) Relative humidity [0-1]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , struct PsychroUncertaintyResult *Results // (o) Statistics of the outputs of each point
+  )
+{
+  struct Worker Workers[MAX_THREADS];
+  double L[9];
+  size_t j, First = 0;
+  unsigned t, NThreads;
+  int i, Started[MAX_THREADS] = { 0 };
+#if defined(_WIN32)
+  HANDLE Handles[MAX_THREADS];
+#else
+  pthread_t Handles[MAX_THREADS];
+#endif
+
+  if (Config->Samples == 0 || Config->NQuantiles > PSYCHRO_UNC_MAX_QUANTILES || Cholesky_(Config->Correlation, L) != 0)
+    return -1;
+  for (i = 0; i < 3; i++)
+    if (!(Config->StdDev[i] >= 0. && isfinite(Config->StdDev[i])))
+      return -1;
+  for (j = 0; j < Config->NQuantiles; j++)
+    if (!(Config->Probabilities[j] > 0. && Config->Probabilities[j] < 1.))
+      return -1;
+
+  NThreads = Config->Threads < 1 ? 1 : Config->Threads > MAX_THREADS ? MAX_THREADS : Config->Threads;
+  if (Count < NThreads)
+    NThreads = Count > 0 ? (unsigned) Count : 1;
+  for (t = 0; t < NThreads; t++)
+  {
+    Workers[t].Config = Config;
+    Workers[t].L = L;
+    Workers[t].First = First;
+    Workers[t].Count = Count / NThreads + (t < Count % NThreads);
+    Workers[t].TDryBulb = TDryBulb + First;
+    Workers[t].RelHum = RelHum + First;
+    Workers[t].Pressure = Pressure + First;
+    Workers[t].Results = Results + First;
+    First += Workers[t].Count;
+  }
+
+  // Threads that cannot be started are run in the calling thread
+  for (t = 1; t < NThreads; t++)
+  {
+#if defined(_WIN32)
+    Handles[t] = CreateThread(NULL, 0, Thread_, &Workers[t], 0, NULL);
+    Started[t] = Handles[t] != NULL;
+#else
+    Started[t] = pthread_create(&Handles[t], NULL, Thread_, &Workers[t]) == 0;
+#endif
+  }
+  Propagate_(&Workers[0]);
+  for (t = 1; t < NThreads; t++)
+  {
+    if (!Started[t])
+      Propagate_(&Workers[t]);
+    else
+    {
+#if defined(_WIN32)
+      WaitForSingleObject(Handles[t], INFINITE);
+      CloseHandle(Handles[t]);
+#else
+      pthread_join(Handles[t], NULL);
+#endif
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,70 @@
+/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+ *
+ * Uncertainty propagation: Monte Carlo propagation of correlated sensor uncertainties through
+ * the calculation of the psychrometric properties from relative humidity.
+ * See psychrolib_uncertainty.c for details.
+*/
+
+#ifndef PSYCHROLIB_UNCERTAINTY_H
+#define PSYCHROLIB_UNCERTAINTY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Maximum number of quantiles estimated for each output
+enum { PSYCHRO_UNC_MAX_QUANTILES = 8 };
+
+
+/******************************************************************************************************
+ * Configuration and results
+ *****************************************************************************************************/
+
+// Outputs of CalcPsychrometricsFromRelHum, in the order of its arguments
+enum PsychroUncertaintyOutput
+{
+  PSYCHRO_UNC_HUM_RATIO,                // Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+  PSYCHRO_UNC_TWET_BULB,                // Wet bulb temperature in °F [IP] or °C [SI]
+  PSYCHRO_UNC_TDEW_POINT,               // Dew point temperature in °F [IP] or °C [SI]
+  PSYCHRO_UNC_VAP_PRES,                 // Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+  PSYCHRO_UNC_MOIST_AIR_ENTHALPY,       // Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+  PSYCHRO_UNC_MOIST_AIR_VOLUME,         // Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+  PSYCHRO_UNC_DEGREE_OF_SATURATION,     // Degree of saturation [unitless]
+  PSYCHRO_UNC_N_OUTPUTS
+};
+
+struct PsychroUncertaintyConfig
+{
+  double StdDev[3];                     // Standard uncertainty of TDryBulb, RelHum and Pressure, in their units
+  double Correlation[3][3];             // Correlation matrix of the errors of the three sensors
+  size_t Samples;                       // Number of samples per point
+  size_t NQuantiles;                    // Number of quantiles estimated for each output
+  double Probabilities[PSYCHRO_UNC_MAX_QUANTILES]; // Cumulative frequencies of the quantiles, in (0, 1)
+  uint64_t Seed;                        // Seed of the random streams of the points
+  unsigned Threads;                     // Number of threads, 0 or 1 to run in the calling thread
+};
+
+struct PsychroUncertaintyResult
+{
+  double Mean[PSYCHRO_UNC_N_OUTPUTS];   // Mean of each output over the samples
+  double StdDev[PSYCHRO_UNC_N_OUTPUTS]; // Standard deviation of each output over the samples
+  double Quantiles[PSYCHRO_UNC_N_OUTPUTS][PSYCHRO_UNC_MAX_QUANTILES]; // Estimated quantiles of each output
+  size_t Rejected;                      // Number of samples outside the range of the equations, not included
+};
+
+
+/******************************************************************************************************
+ * Propagation
+ *****************************************************************************************************/
+
+int PsychroUncertaintyPropagate         // (o) 0 on success, -1 if the configuration is invalid
+  ( const struct PsychroUncertaintyConfig *Config // (i) Uncertainties of the sensors, samples and quantiles
+  , size_t Count                        // (i) Number of points
+  , const double *TDryBulb              // (i) Dry bulb temperature in °F [IP] or °C [SI]
+  , const double *RelHum                // (i) Relative humidity [0-1]
+  , const double *Pressure              // (i) Atmospheric pressure in Psi [IP] or Pa [SI]
+  , struct PsychroUncertaintyResult *Results // (o) Statistics of the outputs of each point
+  );
+
+#endif // PSYCHROLIB_UNCERTAINTY_H
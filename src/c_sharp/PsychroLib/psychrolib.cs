@@ -12,7 +12,7 @@ namespace PsychroLib
     /// <summary>
     /// Class of functions to enable the calculation of psychrometric properties of moist and dry air.
     /// </summary>
-    public class Psychrometrics
+    public partial class Psychrometrics
     {
         /******************************************************************************************************
          * Global constants
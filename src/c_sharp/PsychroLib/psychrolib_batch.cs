@@ -0,0 +1,857 @@
+﻿/*
+ * PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+ * Copyright (c) 2018-2020 The PsychroLib Contributors for the current library implementation.
+ * Copyright (c) 2017 ASHRAE Handbook — Fundamentals for ASHRAE equations and coefficients.
+ * Licensed under the MIT License.
+*/
+
+#if NETSTANDARD2_0_OR_GREATER
+using System;
+using System.Numerics;
+using System.Runtime.InteropServices;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace PsychroLib
+{
+    /// <summary>
+    /// Batch functions operating on spans of values.
+    /// Contrary to the scalar functions, the batch functions do not throw on invalid inputs:
+    /// the outcome of each row is reported in a status span and the outputs of invalid rows are set to NaN.
+    /// The arithmetic parts of the saturation and humidity ratio equations are evaluated with
+    /// <see cref="Vector{T}"/>; logarithms, exponentials and the iterative solvers are evaluated row by row.
+    /// </summary>
+    public partial class Psychrometrics
+    {
+        /// <summary>
+        /// Gets or Sets the minimum number of rows from which the parallel versions of the batch functions
+        /// (e.g. CalcPsychrometricsFromRelHumParallel) split the work across threads.
+        /// Below this size, they run sequentially on the calling thread.
+        /// </summary>
+        public int ParallelThreshold { get; set; } = 1 << 16;
+
+        /// <summary>
+        /// Number of rows processed by each parallel work item.
+        /// </summary>
+        private const int PARALLEL_CHUNK_SIZE = 4096;
+
+
+        /******************************************************************************************************
+         * Saturated Air Calculations
+         *****************************************************************************************************/
+
+        /// <summary>
+        /// Return saturation vapor pressure given dry-bulb temperature, for each row.
+        /// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn. 5 &amp; 6
+        /// </summary>
+        /// <param name="tDryBulb">Dry bulb temperature in °F [IP] or °C [SI]</param>
+        /// <param name="satVapPres">(o) Vapor pressure of saturated air in Psi [IP] or Pa [SI]</param>
+        /// <param name="status">(o) Status of each row</param>
+        /// <returns>Number of invalid rows</returns>
+        public int GetSatVapPres(ReadOnlySpan<double> tDryBulb, Span<double> satVapPres, Span<BatchStatus> status)
+        {
+            CheckLengths(tDryBulb.Length, satVapPres.Length, status.Length);
+            status.Fill(BatchStatus.Ok);
+
+            SatVapPresKernel(tDryBulb, satVapPres, status);
+            return FinalizeRows(status, satVapPres);
+        }
+
+        /// <summary>
+        /// Return humidity ratio of saturated air given dry-bulb temperature and pressure, for each row.
+        /// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 36, solved for W
+        /// </summary>
+        /// <param name="tDryBulb">Dry bulb temperature in °F [IP] or °C [SI]</param>
+        /// <param name="pressure">Atmospheric pressure in Psi [IP] or Pa [SI]</param>
+        /// <param name="satHumRatio">(o) Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]</param>
+        /// <param name="status">(o) Status of each row</param>
+        /// <returns>Number of invalid rows</returns>
+        public int GetSatHumRatio(ReadOnlySpan<double> tDryBulb, ReadOnlySpan<double> pressure,
+            Span<double> satHumRatio, Span<BatchStatus> status)
+        {
+            CheckLengths(tDryBulb.Length, pressure.Length, satHumRatio.Length, status.Length);
+            status.Fill(BatchStatus.Ok);
+
+            SatVapPresKernel(tDryBulb, satHumRatio, status);
+            HumRatioFromVapPresKernel(satHumRatio, pressure, satHumRatio);
+            return FinalizeRows(status, satHumRatio);
+        }
+
+
+        /******************************************************************************************************
+         * Conversions to humidity ratio
+         *****************************************************************************************************/
+
+        /// <summary>
+        /// Return humidity ratio given water vapor pressure and atmospheric pressure, for each row.
+        /// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 20
+        /// </summary>
+        /// <param name="vapPres">Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]</param>
+        /// <param name="pressure">Atmospheric pressure in Psi [IP] or Pa [SI]</param>
+        /// <param name="humRatio">(o) Humidity Ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]</param>
+        /// <param name="status">(o) Status of each row</param>
+        /// <returns>Number of invalid rows</returns>
+        public int GetHumRatioFromVapPres(ReadOnlySpan<double> vapPres, ReadOnlySpan<double> pressure,
+            Span<double> humRatio, Span<BatchStatus> status)
+        {
+            CheckLengths(vapPres.Length, pressure.Length, humRatio.Length, status.Length);
+
+            for (var i = 0; i < vapPres.Length; i++)
+                status[i] = vapPres[i] >= 0.0 ? BatchStatus.Ok : BatchStatus.NegativeVapPres;
+
+            HumRatioFromVapPresKernel(vapPres, pressure, humRatio);
+            return FinalizeRows(status, humRatio);
+        }
+
+        /// <summary>
+        /// Return humidity ratio given dry-bulb temperature, relative humidity, and pressure, for each row.
+        /// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+        /// </summary>
+        /// <param name="tDryBulb">Dry bulb temperature in °F [IP] or °C [SI]</param>
+        /// <param name="relHum">Relative humidity [0-1]</param>
+        /// <param name="pressure">Atmospheric pressure in Psi [IP] or Pa [SI]</param>
+        /// <param name="humRatio">(o) Humidity Ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]</param>
+        /// <param name="status">(o) Status of each row</param>
+        /// <returns>Number of invalid rows</returns>
+        public int GetHumRatioFromRelHum(ReadOnlySpan<double> tDryBulb, ReadOnlySpan<double> relHum,
+            ReadOnlySpan<double> pressure, Span<double> humRatio, Span<BatchStatus> status)
+        {
+            CheckLengths(tDryBulb.Length, relHum.Length, pressure.Length, humRatio.Length, status.Length);
+            CheckRelHum(relHum, status);
+
+            SatVapPresKernel(tDryBulb, humRatio, status);
+            MultiplyKernel(humRatio, relHum, humRatio);
+            HumRatioFromVapPresKernel(humRatio, pressure, humRatio);
+            return FinalizeRows(status, humRatio);
+        }
+
+        /// <summary>
+        /// Return humidity ratio given dry-bulb temperature, wet-bulb temperature, and pressure, for each row.
+        /// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 33 and 35
+        /// </summary>
+        /// <param name="tDryBulb">Dry bulb temperature in °F [IP] or °C [SI]</param>
+        /// <param name="tWetBulb">Wet bulb temperature in °F [IP] or °C [SI]</param>
+        /// <param name="pressure">Atmospheric pressure in Psi [IP] or Pa [SI]</param>
+        /// <param name="humRatio">(o) Humidity Ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]</param>
+        /// <param name="status">(o) Status of each row</param>
+        /// <returns>Number of invalid rows</returns>
+        public int GetHumRatioFromTWetBulb(ReadOnlySpan<double> tDryBulb, ReadOnlySpan<double> tWetBulb,
+            ReadOnlySpan<double> pressure, Span<double> humRatio, Span<BatchStatus> status)
+        {
+            CheckLengths(tDryBulb.Length, tWetBulb.Length, pressure.Length, humRatio.Length, status.Length);
+            CheckWetBulb(tDryBulb, tWetBulb, status);
+
+            SatVapPresKernel(tWetBulb, humRatio, status);
+            HumRatioFromVapPresKernel(humRatio, pressure, humRatio);
+            HumRatioFromTWetBulbKernel(tDryBulb, tWetBulb, humRatio, humRatio);
+            return FinalizeRows(status, humRatio);
+        }
+
+        /// <summary>
+        /// Return wet-bulb temperature given dry-bulb temperature, humidity ratio, and pressure, for each row.
+        /// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 33 and 35 solved for Tstar
+        /// </summary>
+        /// <param name="tDryBulb">Dry bulb temperature in °F [IP] or °C [SI]</param>
+        /// <param name="humRatio">Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]</param>
+        /// <param name="pressure">Atmospheric pressure in Psi [IP] or Pa [SI]</param>
+        /// <param name="tWetBulb">(o) Wet bulb temperature in °F [IP] or °C [SI]</param>
+        /// <param name="status">(o) Status of each row</param>
+        /// <returns>Number of invalid rows</returns>
+        public int GetTWetBulbFromHumRatio(ReadOnlySpan<double> tDryBulb, ReadOnlySpan<double> humRatio,
+            ReadOnlySpan<double> pressure, Span<double> tWetBulb, Span<BatchStatus> status)
+        {
+            CheckLengths(tDryBulb.Length, humRatio.Length, pressure.Length, tWetBulb.Length, status.Length);
+
+            var bounds = new DewPointBounds(this);
+            for (var i = 0; i < tDryBulb.Length; i++)
+                status[i] = TryGetTWetBulbFromHumRatio(bounds, tDryBulb[i], humRatio[i], pressure[i],
+                    out tWetBulb[i]);
+
+            return FinalizeRows(status, tWetBulb);
+        }
+
+        /// <summary>
+        /// Return dew-point temperature given dry-bulb temperature, humidity ratio, and pressure, for each row.
+        /// Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1
+        /// </summary>
+        /// <param name="tDryBulb">Dry bulb temperature in °F [IP] or °C [SI]</param>
+        /// <param name="humRatio">Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]</param>
+        /// <param name="pressure">Atmospheric pressure in Psi [IP] or Pa [SI]</param>
+        /// <param name="tDewPoint">(o) Dew Point temperature in °F [IP] or °C [SI]</param>
+        /// <param name="status">(o) Status of each row</param>
+        /// <returns>Number of invalid rows</returns>
+        public int GetTDewPointFromHumRatio(ReadOnlySpan<double> tDryBulb, ReadOnlySpan<double> humRatio,
+            ReadOnlySpan<double> pressure, Span<double> tDewPoint, Span<BatchStatus> status)
+        {
+            CheckLengths(tDryBulb.Length, humRatio.Length, pressure.Length, tDewPoint.Length, status.Length);
+
+            var bounds = new DewPointBounds(this);
+            for (var i = 0; i < tDryBulb.Length; i++)
+            {
+                if (!(humRatio[i] >= 0.0))
+                {
+                    status[i] = BatchStatus.NegativeHumRatio;
+                    continue;
+                }
+                var vapPres = GetVapPresFromHumRatio(humRatio[i], pressure[i]);
+                status[i] = TryGetTDewPointFromVapPres(bounds, tDryBulb[i], vapPres, out tDewPoint[i]);
+            }
+
+            return FinalizeRows(status, tDewPoint);
+        }
+
+
+        /******************************************************************************************************
+         * Functions to set all psychrometric values
+         *****************************************************************************************************/
+
+        /// <summary>
+        /// Utility function to calculate humidity ratio, dew-point temperature, relative humidity,
+        /// vapour pressure, moist air enthalpy, moist air volume, and degree of saturation of air given
+        /// dry-bulb temperature, wet-bulb temperature, and pressure, for each row.
+        /// </summary>
+        /// <param name="tDryBulb">Dry bulb temperature in °F [IP] or °C [SI]</param>
+        /// <param name="tWetBulb">Wet bulb temperature in °F [IP] or °C [SI]</param>
+        /// <param name="pressure">Atmospheric pressure in Psi [IP] or Pa [SI]</param>
+        /// <param name="humRatio">(o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]</param>
+        /// <param name="tDewPoint">(o) Dew point temperature in °F [IP] or °C [SI]</param>
+        /// <param name="relHum">(o) Relative humidity [0-1]</param>
+        /// <param name="vapPres">(o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]</param>
+        /// <param name="moistAirEnthalpy">(o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]</param>
+        /// <param name="moistAirVolume">(o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]</param>
+        /// <param name="degreeOfSaturation">(o) Degree of saturation [unitless]</param>
+        /// <param name="status">(o) Status of each row</param>
+        /// <returns>Number of invalid rows</returns>
+        public int CalcPsychrometricsFromTWetBulb(ReadOnlySpan<double> tDryBulb, ReadOnlySpan<double> tWetBulb,
+            ReadOnlySpan<double> pressure, Span<double> humRatio, Span<double> tDewPoint, Span<double> relHum,
+            Span<double> vapPres, Span<double> moistAirEnthalpy, Span<double> moistAirVolume,
+            Span<double> degreeOfSaturation, Span<BatchStatus> status)
+        {
+            CheckLengths(tDryBulb.Length, tWetBulb.Length, pressure.Length, humRatio.Length, tDewPoint.Length,
+                relHum.Length, vapPres.Length, moistAirEnthalpy.Length, moistAirVolume.Length,
+                degreeOfSaturation.Length, status.Length);
+            CheckWetBulb(tDryBulb, tWetBulb, status);
+
+            // Humidity ratio from the saturation humidity ratio at the wet bulb temperature
+            SatVapPresKernel(tWetBulb, humRatio, status);
+            HumRatioFromVapPresKernel(humRatio, pressure, humRatio);
+            HumRatioFromTWetBulbKernel(tDryBulb, tWetBulb, humRatio, humRatio);
+
+            // Saturation vapor pressure at the dry bulb temperature, stored temporarily in degreeOfSaturation
+            SatVapPresKernel(tDryBulb, degreeOfSaturation, status);
+            MoistAirKernel(tDryBulb, pressure, humRatio, degreeOfSaturation, relHum, vapPres, moistAirEnthalpy,
+                moistAirVolume, degreeOfSaturation);
+
+            var bounds = new DewPointBounds(this);
+            for (var i = 0; i < tDryBulb.Length; i++)
+                if (status[i] == BatchStatus.Ok)
+                    status[i] = TryGetTDewPointFromVapPres(bounds, tDryBulb[i], vapPres[i], out tDewPoint[i]);
+
+            return FinalizeRows(status, humRatio, tDewPoint, relHum, vapPres, moistAirEnthalpy, moistAirVolume,
+                degreeOfSaturation);
+        }
+
+        /// <summary>
+        /// Utility function to calculate humidity ratio, wet-bulb temperature, relative humidity,
+        /// vapour pressure, moist air enthalpy, moist air volume, and degree of saturation of air given
+        /// dry-bulb temperature, dew-point temperature, and pressure, for each row.
+        /// </summary>
+        /// <param name="tDryBulb">Dry bulb temperature in °F [IP] or °C [SI]</param>
+        /// <param name="tDewPoint">Dew point temperature in °F [IP] or °C [SI]</param>
+        /// <param name="pressure">Atmospheric pressure in Psi [IP] or Pa [SI]</param>
+        /// <param name="humRatio">(o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]</param>
+        /// <param name="tWetBulb">(o) Wet bulb temperature in °F [IP] or °C [SI]</param>
+        /// <param name="relHum">(o) Relative humidity [0-1]</param>
+        /// <param name="vapPres">(o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]</param>
+        /// <param name="moistAirEnthalpy">(o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]</param>
+        /// <param name="moistAirVolume">(o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]</param>
+        /// <param name="degreeOfSaturation">(o) Degree of saturation [unitless]</param>
+        /// <param name="status">(o) Status of each row</param>
+        /// <returns>Number of invalid rows</returns>
+        public int CalcPsychrometricsFromTDewPoint(ReadOnlySpan<double> tDryBulb, ReadOnlySpan<double> tDewPoint,
+            ReadOnlySpan<double> pressure, Span<double> humRatio, Span<double> tWetBulb, Span<double> relHum,
+            Span<double> vapPres, Span<double> moistAirEnthalpy, Span<double> moistAirVolume,
+            Span<double> degreeOfSaturation, Span<BatchStatus> status)
+        {
+            CheckLengths(tDryBulb.Length, tDewPoint.Length, pressure.Length, humRatio.Length, tWetBulb.Length,
+                relHum.Length, vapPres.Length, moistAirEnthalpy.Length, moistAirVolume.Length,
+                degreeOfSaturation.Length, status.Length);
+
+            for (var i = 0; i < tDryBulb.Length; i++)
+                status[i] = tDewPoint[i] <= tDryBulb[i] ? BatchStatus.Ok : BatchStatus.DewPointAboveDryBulb;
+
+            // Humidity ratio from the saturation vapor pressure at the dew point temperature
+            SatVapPresKernel(tDewPoint, humRatio, status);
+            HumRatioFromVapPresKernel(humRatio, pressure, humRatio);
+
+            // Saturation vapor pressure at the dry bulb temperature, stored temporarily in degreeOfSaturation
+            SatVapPresKernel(tDryBulb, degreeOfSaturation, status);
+            MoistAirKernel(tDryBulb, pressure, humRatio, degreeOfSaturation, relHum, vapPres, moistAirEnthalpy,
+                moistAirVolume, degreeOfSaturation);
+
+            var bounds = new DewPointBounds(this);
+            for (var i = 0; i < tDryBulb.Length; i++)
+                if (status[i] == BatchStatus.Ok)
+                    status[i] = TryGetTWetBulbFromHumRatio(bounds, tDryBulb[i], humRatio[i], pressure[i],
+                        out tWetBulb[i]);
+
+            return FinalizeRows(status, humRatio, tWetBulb, relHum, vapPres, moistAirEnthalpy, moistAirVolume,
+                degreeOfSaturation);
+        }
+
+        /// <summary>
+        /// Utility function to calculate humidity ratio, wet-bulb temperature, dew-point temperature,
+        /// vapour pressure, moist air enthalpy, moist air volume, and degree of saturation of air given
+        /// dry-bulb temperature, relative humidity and pressure, for each row.
+        /// </summary>
+        /// <param name="tDryBulb">Dry bulb temperature in °F [IP] or °C [SI]</param>
+        /// <param name="relHum">Relative humidity [0-1]</param>
+        /// <param name="pressure">Atmospheric pressure in Psi [IP] or Pa [SI]</param>
+        /// <param name="humRatio">(o) Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]</param>
+        /// <param name="tWetBulb">(o) Wet bulb temperature in °F [IP] or °C [SI]</param>
+        /// <param name="tDewPoint">(o) Dew point temperature in °F [IP] or °C [SI]</param>
+        /// <param name="vapPres">(o) Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]</param>
+        /// <param name="moistAirEnthalpy">(o) Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]</param>
+        /// <param name="moistAirVolume">(o) Specific volume ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]</param>
+        /// <param name="degreeOfSaturation">(o) Degree of saturation [unitless]</param>
+        /// <param name="status">(o) Status of each row</param>
+        /// <returns>Number of invalid rows</returns>
+        public int CalcPsychrometricsFromRelHum(ReadOnlySpan<double> tDryBulb, ReadOnlySpan<double> relHum,
+            ReadOnlySpan<double> pressure, Span<double> humRatio, Span<double> tWetBulb, Span<double> tDewPoint,
+            Span<double> vapPres, Span<double> moistAirEnthalpy, Span<double> moistAirVolume,
+            Span<double> degreeOfSaturation, Span<BatchStatus> status)
+        {
+            CheckLengths(tDryBulb.Length, relHum.Length, pressure.Length, humRatio.Length, tWetBulb.Length,
+                tDewPoint.Length, vapPres.Length, moistAirEnthalpy.Length, moistAirVolume.Length,
+                degreeOfSaturation.Length, status.Length);
+            CheckRelHum(relHum, status);
+
+            // Saturation vapor pressure at the dry bulb temperature, stored temporarily in degreeOfSaturation
+            SatVapPresKernel(tDryBulb, degreeOfSaturation, status);
+            MultiplyKernel(degreeOfSaturation, relHum, humRatio);
+            HumRatioFromVapPresKernel(humRatio, pressure, humRatio);
+
+            // The relative humidity output is not needed here: tWetBulb is used as scratch space for it
+            MoistAirKernel(tDryBulb, pressure, humRatio, degreeOfSaturation, tWetBulb, vapPres, moistAirEnthalpy,
+                moistAirVolume, degreeOfSaturation);
+
+            var bounds = new DewPointBounds(this);
+            for (var i = 0; i < tDryBulb.Length; i++)
+            {
+                if (status[i] != BatchStatus.Ok)
+                    continue;
+                status[i] = TryGetTWetBulbFromHumRatio(bounds, tDryBulb[i], humRatio[i], pressure[i],
+                    out tWetBulb[i]);
+                if (status[i] == BatchStatus.Ok)
+                    status[i] = TryGetTDewPointFromVapPres(bounds, tDryBulb[i], vapPres[i], out tDewPoint[i]);
+            }
+
+            return FinalizeRows(status, humRatio, tWetBulb, tDewPoint, vapPres, moistAirEnthalpy, moistAirVolume,
+                degreeOfSaturation);
+        }
+
+
+        /******************************************************************************************************
+         * Parallel versions of the functions to set all psychrometric values
+         *****************************************************************************************************/
+
+        /// <summary>
+        /// Same as <see cref="CalcPsychrometricsFromTWetBulb(ReadOnlySpan{double}, ReadOnlySpan{double}, ReadOnlySpan{double}, Span{double}, Span{double}, Span{double}, Span{double}, Span{double}, Span{double}, Span{double}, Span{BatchStatus})"/>,
+        /// evaluated in parallel chunks when the number of rows is at least <see cref="ParallelThreshold"/>.
+        /// </summary>
+        /// <returns>Number of invalid rows</returns>
+        public int CalcPsychrometricsFromTWetBulbParallel(ReadOnlyMemory<double> tDryBulb, ReadOnlyMemory<double> tWetBulb,
+            ReadOnlyMemory<double> pressure, Memory<double> humRatio, Memory<double> tDewPoint, Memory<double> relHum,
+            Memory<double> vapPres, Memory<double> moistAirEnthalpy, Memory<double> moistAirVolume,
+            Memory<double> degreeOfSaturation, Memory<BatchStatus> status)
+        {
+            return RunInChunks(CalcPsychrometricsFromTWetBulb, tDryBulb, tWetBulb, pressure, humRatio, tDewPoint,
+                relHum, vapPres, moistAirEnthalpy, moistAirVolume, degreeOfSaturation, status);
+        }
+
+        /// <summary>
+        /// Same as <see cref="CalcPsychrometricsFromTDewPoint(ReadOnlySpan{double}, ReadOnlySpan{double}, ReadOnlySpan{double}, Span{double}, Span{double}, Span{double}, Span{double}, Span{double}, Span{double}, Span{double}, Span{BatchStatus})"/>,
+        /// evaluated in parallel chunks when the number of rows is at least <see cref="ParallelThreshold"/>.
+        /// </summary>
+        /// <returns>Number of invalid rows</returns>
+        public int CalcPsychrometricsFromTDewPointParallel(ReadOnlyMemory<double> tDryBulb, ReadOnlyMemory<double> tDewPoint,
+            ReadOnlyMemory<double> pressure, Memory<double> humRatio, Memory<double> tWetBulb, Memory<double> relHum,
+            Memory<double> vapPres, Memory<double> moistAirEnthalpy, Memory<double> moistAirVolume,
+            Memory<double> degreeOfSaturation, Memory<BatchStatus> status)
+        {
+            return RunInChunks(CalcPsychrometricsFromTDewPoint, tDryBulb, tDewPoint, pressure, humRatio, tWetBulb,
+                relHum, vapPres, moistAirEnthalpy, moistAirVolume, degreeOfSaturation, status);
+        }
+
+        /// <summary>
+        /// Same as <see cref="CalcPsychrometricsFromRelHum(ReadOnlySpan{double}, ReadOnlySpan{double}, ReadOnlySpan{double}, Span{double}, Span{double}, Span{double}, Span{double}, Span{double}, Span{double}, Span{double}, Span{BatchStatus})"/>,
+        /// evaluated in parallel chunks when the number of rows is at least <see cref="ParallelThreshold"/>.
+        /// </summary>
+        /// <returns>Number of invalid rows</returns>
+        public int CalcPsychrometricsFromRelHumParallel(ReadOnlyMemory<double> tDryBulb, ReadOnlyMemory<double> relHum,
+            ReadOnlyMemory<double> pressure, Memory<double> humRatio, Memory<double> tWetBulb, Memory<double> tDewPoint,
+            Memory<double> vapPres, Memory<double> moistAirEnthalpy, Memory<double> moistAirVolume,
+            Memory<double> degreeOfSaturation, Memory<BatchStatus> status)
+        {
+            return RunInChunks(CalcPsychrometricsFromRelHum, tDryBulb, relHum, pressure, humRatio, tWetBulb,
+                tDewPoint, vapPres, moistAirEnthalpy, moistAirVolume, degreeOfSaturation, status);
+        }
+
+        private delegate int CalcPsychrometricsKernel(ReadOnlySpan<double> in1, ReadOnlySpan<double> in2,
+            ReadOnlySpan<double> in3, Span<double> out1, Span<double> out2, Span<double> out3, Span<double> out4,
+            Span<double> out5, Span<double> out6, Span<double> out7, Span<BatchStatus> status);
+
+        private int RunInChunks(CalcPsychrometricsKernel kernel, ReadOnlyMemory<double> in1,
+            ReadOnlyMemory<double> in2, ReadOnlyMemory<double> in3, Memory<double> out1, Memory<double> out2,
+            Memory<double> out3, Memory<double> out4, Memory<double> out5, Memory<double> out6, Memory<double> out7,
+            Memory<BatchStatus> status)
+        {
+            var length = in1.Length;
+            CheckLengths(length, in2.Length, in3.Length, out1.Length, out2.Length, out3.Length, out4.Length,
+                out5.Length, out6.Length, out7.Length, status.Length);
+
+            if (length < ParallelThreshold)
+                return kernel(in1.Span, in2.Span, in3.Span, out1.Span, out2.Span, out3.Span, out4.Span, out5.Span,
+                    out6.Span, out7.Span, status.Span);
+
+            var invalid = 0;
+            var chunkCount = (length + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+            Parallel.For(0, chunkCount, chunk =>
+            {
+                var start = chunk * PARALLEL_CHUNK_SIZE;
+                var count = Math.Min(PARALLEL_CHUNK_SIZE, length - start);
+                var chunkInvalid = kernel(in1.Span.Slice(start, count), in2.Span.Slice(start, count),
+                    in3.Span.Slice(start, count), out1.Span.Slice(start, count), out2.Span.Slice(start, count),
+                    out3.Span.Slice(start, count), out4.Span.Slice(start, count), out5.Span.Slice(start, count),
+                    out6.Span.Slice(start, count), out7.Span.Slice(start, count), status.Span.Slice(start, count));
+                if (chunkInvalid != 0)
+                    Interlocked.Add(ref invalid, chunkInvalid);
+            });
+            return invalid;
+        }
+
+
+        /******************************************************************************************************
+         * Vector kernels
+         *****************************************************************************************************/
+
+        // Saturation vapor pressure. Rows whose temperature is outside the domain of validity of the equations
+        // are flagged in status. The output span must not alias the input span.
+        private void SatVapPresKernel(ReadOnlySpan<double> tDryBulb, Span<double> satVapPres,
+            Span<BatchStatus> status)
+        {
+            double tMin, tMax, triplePoint, zero;
+            double a, b, c, d, e, f, g;     // Coefficients of eqn. 5 (ice)
+            double la, lb, lc, ld, le, lg;  // Coefficients of eqn. 6 (liquid water)
+
+            if (UnitSystem == UnitSystem.IP)
+            {
+                tMin = -148.0; tMax = 392.0; triplePoint = TRIPLE_POINT_WATER_IP; zero = ZERO_FAHRENHEIT_AS_RANKINE;
+                a = -1.0214165E+04; b = -4.8932428; c = -5.3765794E-03; d = 1.9202377E-07; e = 3.5575832E-10;
+                f = -9.0344688E-14; g = 4.1635019;
+                la = -1.0440397E+04; lb = -1.1294650E+01; lc = -2.7022355E-02; ld = 1.2890360E-05;
+                le = -2.4780681E-09; lg = 6.5459673;
+            }
+            else
+            {
+                tMin = -100.0; tMax = 200.0; triplePoint = TRIPLE_POINT_WATER_SI; zero = ZERO_CELSIUS_AS_KELVIN;
+                a = -5.6745359E+03; b = 6.3925247; c = -9.677843E-03; d = 6.2215701E-07; e = 2.0747825E-09;
+                f = -9.484024E-13; g = 4.1635019;
+                la = -5.8002206E+03; lb = 1.3914993; lc = -4.8640239E-02; ld = 4.1764768E-05;
+                le = -1.4452093E-08; lg = 6.5459673;
+            }
+
+            // First pass: range check and natural logarithm of the absolute temperature
+            for (var i = 0; i < tDryBulb.Length; i++)
+            {
+                if (!(tDryBulb[i] >= tMin && tDryBulb[i] <= tMax))
+                    status[i] = BatchStatus.TemperatureOutOfRange;
+                satVapPres[i] = Math.Log(Math.Max(tDryBulb[i] + zero, double.Epsilon));
+            }
+
+            // Second pass: polynomial part of eqn. 5 and 6, evaluated on both sides of the triple point
+            var width = Vector<double>.Count;
+            var vectorEnd = tDryBulb.Length - tDryBulb.Length % width;
+            var tVec = MemoryMarshal.Cast<double, Vector<double>>(tDryBulb.Slice(0, vectorEnd));
+            var outVec = MemoryMarshal.Cast<double, Vector<double>>(satVapPres.Slice(0, vectorEnd));
+            var vZero = new Vector<double>(zero);
+            var vTriple = new Vector<double>(triplePoint);
+            for (var i = 0; i < tVec.Length; i++)
+            {
+                var t = tVec[i];
+                var T = t + vZero;
+                var lnT = outVec[i];
+                var ice = new Vector<double>(a) / T + new Vector<double>(b)
+                          + T * (new Vector<double>(c) + T * (new Vector<double>(d)
+                          + T * (new Vector<double>(e) + T * new Vector<double>(f))))
+                          + new Vector<double>(g) * lnT;
+                var liquid = new Vector<double>(la) / T + new Vector<double>(lb)
+                             + T * (new Vector<double>(lc) + T * (new Vector<double>(ld) + T * new Vector<double>(le)))
+                             + new Vector<double>(lg) * lnT;
+                outVec[i] = Vector.ConditionalSelect(Vector.LessThanOrEqual(t, vTriple), ice, liquid);
+            }
+            for (var i = vectorEnd; i < tDryBulb.Length; i++)
+            {
+                var T = tDryBulb[i] + zero;
+                var lnT = satVapPres[i];
+                satVapPres[i] = tDryBulb[i] <= triplePoint
+                    ? a / T + b + T * (c + T * (d + T * (e + T * f))) + g * lnT
+                    : la / T + lb + T * (lc + T * (ld + T * le)) + lg * lnT;
+            }
+
+            // Third pass: exponential
+            for (var i = 0; i < satVapPres.Length; i++)
+                satVapPres[i] = Math.Exp(satVapPres[i]);
+        }
+
+        // Humidity ratio from vapor pressure and pressure, bounded by MIN_HUM_RATIO.
+        // The output span may alias the vapor pressure span.
+        private static void HumRatioFromVapPresKernel(ReadOnlySpan<double> vapPres, ReadOnlySpan<double> pressure,
+            Span<double> humRatio)
+        {
+            var width = Vector<double>.Count;
+            var vectorEnd = vapPres.Length - vapPres.Length % width;
+            var pwVec = MemoryMarshal.Cast<double, Vector<double>>(vapPres.Slice(0, vectorEnd));
+            var pVec = MemoryMarshal.Cast<double, Vector<double>>(pressure.Slice(0, vectorEnd));
+            var wVec = MemoryMarshal.Cast<double, Vector<double>>(humRatio.Slice(0, vectorEnd));
+            var vRatio = new Vector<double>(0.621945);
+            var vMin = new Vector<double>(MIN_HUM_RATIO);
+            for (var i = 0; i < pwVec.Length; i++)
+                wVec[i] = Vector.Max(vRatio * pwVec[i] / (pVec[i] - pwVec[i]), vMin);
+            for (var i = vectorEnd; i < vapPres.Length; i++)
+                humRatio[i] = Math.Max(0.621945 * vapPres[i] / (pressure[i] - vapPres[i]), MIN_HUM_RATIO);
+        }
+
+        // Humidity ratio from dry-bulb temperature, wet-bulb temperature and the saturation humidity ratio
+        // at the wet-bulb temperature (ASHRAE eqn 33 and 35). The output span may alias satHumRatio.
+        private void HumRatioFromTWetBulbKernel(ReadOnlySpan<double> tDryBulb, ReadOnlySpan<double> tWetBulb,
+            ReadOnlySpan<double> satHumRatio, Span<double> humRatio)
+        {
+            double freezingPoint, cp, l0, l0i, cwb, cwbi, cdb, cdenwb, cdenwbi;
+
+            if (UnitSystem == UnitSystem.IP)
+            {
+                freezingPoint = FREEZING_POINT_WATER_IP; cp = 0.240;
+                l0 = 1093.0; cwb = 0.556; cdenwb = 1.0; l0i = 1220.0; cwbi = 0.04; cdenwbi = 0.48;
+                cdb = 0.444;
+            }
+            else
+            {
+                freezingPoint = FREEZING_POINT_WATER_SI; cp = 1.006;
+                l0 = 2501.0; cwb = 2.326; cdenwb = 4.186; l0i = 2830.0; cwbi = 0.24; cdenwbi = 2.1;
+                cdb = 1.86;
+            }
+
+            var width = Vector<double>.Count;
+            var vectorEnd = tDryBulb.Length - tDryBulb.Length % width;
+            var tdbVec = MemoryMarshal.Cast<double, Vector<double>>(tDryBulb.Slice(0, vectorEnd));
+            var twbVec = MemoryMarshal.Cast<double, Vector<double>>(tWetBulb.Slice(0, vectorEnd));
+            var wsVec = MemoryMarshal.Cast<double, Vector<double>>(satHumRatio.Slice(0, vectorEnd));
+            var wVec = MemoryMarshal.Cast<double, Vector<double>>(humRatio.Slice(0, vectorEnd));
+            var vFreezing = new Vector<double>(freezingPoint);
+            var vMin = new Vector<double>(MIN_HUM_RATIO);
+            for (var i = 0; i < tdbVec.Length; i++)
+            {
+                var tdb = tdbVec[i];
+                var twb = twbVec[i];
+                var sensible = new Vector<double>(cp) * (tdb - twb);
+                var liquid = ((new Vector<double>(l0) - new Vector<double>(cwb) * twb) * wsVec[i] - sensible)
+                             / (new Vector<double>(l0) + new Vector<double>(cdb) * tdb
+                                - new Vector<double>(cdenwb) * twb);
+                var ice = ((new Vector<double>(l0i) - new Vector<double>(cwbi) * twb) * wsVec[i] - sensible)
+                          / (new Vector<double>(l0i) + new Vector<double>(cdb) * tdb
+                             - new Vector<double>(cdenwbi) * twb);
+                wVec[i] = Vector.Max(
+                    Vector.ConditionalSelect(Vector.GreaterThanOrEqual(twb, vFreezing), liquid, ice), vMin);
+            }
+            for (var i = vectorEnd; i < tDryBulb.Length; i++)
+            {
+                var tdb = tDryBulb[i];
+                var twb = tWetBulb[i];
+                var w = twb >= freezingPoint
+                    ? ((l0 - cwb * twb) * satHumRatio[i] - cp * (tdb - twb)) / (l0 + cdb * tdb - cdenwb * twb)
+                    : ((l0i - cwbi * twb) * satHumRatio[i] - cp * (tdb - twb)) / (l0i + cdb * tdb - cdenwbi * twb);
+                humRatio[i] = Math.Max(w, MIN_HUM_RATIO);
+            }
+        }
+
+        // Vapor pressure, relative humidity, enthalpy, specific volume and degree of saturation from
+        // dry-bulb temperature, pressure, humidity ratio and the saturation vapor pressure at the dry-bulb
+        // temperature. The degree of saturation span may alias satVapPres.
+        private void MoistAirKernel(ReadOnlySpan<double> tDryBulb, ReadOnlySpan<double> pressure,
+            ReadOnlySpan<double> humRatio, ReadOnlySpan<double> satVapPres, Span<double> relHum,
+            Span<double> vapPres, Span<double> moistAirEnthalpy, Span<double> moistAirVolume,
+            Span<double> degreeOfSaturation)
+        {
+            double zero, rda, pFactor, cpa, hfg, cpv, hFactor;
+
+            if (UnitSystem == UnitSystem.IP)
+            {
+                zero = ZERO_FAHRENHEIT_AS_RANKINE; rda = R_DA_IP; pFactor = 144.0;
+                cpa = 0.240; hfg = 1061.0; cpv = 0.444; hFactor = 1.0;
+            }
+            else
+            {
+                zero = ZERO_CELSIUS_AS_KELVIN; rda = R_DA_SI; pFactor = 1.0;
+                cpa = 1.006; hfg = 2501.0; cpv = 1.86; hFactor = 1000.0;
+            }
+
+            var width = Vector<double>.Count;
+            var vectorEnd = tDryBulb.Length - tDryBulb.Length % width;
+            var tVec = MemoryMarshal.Cast<double, Vector<double>>(tDryBulb.Slice(0, vectorEnd));
+            var pVec = MemoryMarshal.Cast<double, Vector<double>>(pressure.Slice(0, vectorEnd));
+            var wVec = MemoryMarshal.Cast<double, Vector<double>>(humRatio.Slice(0, vectorEnd));
+            var pwsVec = MemoryMarshal.Cast<double, Vector<double>>(satVapPres.Slice(0, vectorEnd));
+            var rhVec = MemoryMarshal.Cast<double, Vector<double>>(relHum.Slice(0, vectorEnd));
+            var pwVec = MemoryMarshal.Cast<double, Vector<double>>(vapPres.Slice(0, vectorEnd));
+            var hVec = MemoryMarshal.Cast<double, Vector<double>>(moistAirEnthalpy.Slice(0, vectorEnd));
+            var vVec = MemoryMarshal.Cast<double, Vector<double>>(moistAirVolume.Slice(0, vectorEnd));
+            var musVec = MemoryMarshal.Cast<double, Vector<double>>(degreeOfSaturation.Slice(0, vectorEnd));
+            var vRatio = new Vector<double>(0.621945);
+            var vMin = new Vector<double>(MIN_HUM_RATIO);
+            var vOne = Vector<double>.One;
+            for (var i = 0; i < tVec.Length; i++)
+            {
+                var t = tVec[i];
+                var p = pVec[i];
+                var w = Vector.Max(wVec[i], vMin);
+                var pws = pwsVec[i];
+                var pw = p * w / (vRatio + w);
+                var ws = Vector.Max(vRatio * pws / (p - pws), vMin);
+                pwVec[i] = pw;
+                rhVec[i] = pw / pws;
+                hVec[i] = (new Vector<double>(cpa) * t + w * (new Vector<double>(hfg) + new Vector<double>(cpv) * t))
+                          * new Vector<double>(hFactor);
+                vVec[i] = new Vector<double>(rda) * (t + new Vector<double>(zero)) * (vOne + new Vector<double>(1.607858) * w)
+                          / (new Vector<double>(pFactor) * p);
+                musVec[i] = w / ws;
+            }
+            for (var i = vectorEnd; i < tDryBulb.Length; i++)
+            {
+                var t = tDryBulb[i];
+                var p = pressure[i];
+                var w = Math.Max(humRatio[i], MIN_HUM_RATIO);
+                var pws = satVapPres[i];
+                var pw = p * w / (0.621945 + w);
+                var ws = Math.Max(0.621945 * pws / (p - pws), MIN_HUM_RATIO);
+                vapPres[i] = pw;
+                relHum[i] = pw / pws;
+                moistAirEnthalpy[i] = (cpa * t + w * (hfg + cpv * t)) * hFactor;
+                moistAirVolume[i] = rda * (t + zero) * (1.0 + 1.607858 * w) / (pFactor * p);
+                degreeOfSaturation[i] = w / ws;
+            }
+        }
+
+        // Element-wise product. The output span may alias either input span.
+        private static void MultiplyKernel(ReadOnlySpan<double> x, ReadOnlySpan<double> y, Span<double> product)
+        {
+            var width = Vector<double>.Count;
+            var vectorEnd = x.Length - x.Length % width;
+            var xVec = MemoryMarshal.Cast<double, Vector<double>>(x.Slice(0, vectorEnd));
+            var yVec = MemoryMarshal.Cast<double, Vector<double>>(y.Slice(0, vectorEnd));
+            var pVec = MemoryMarshal.Cast<double, Vector<double>>(product.Slice(0, vectorEnd));
+            for (var i = 0; i < xVec.Length; i++)
+                pVec[i] = xVec[i] * yVec[i];
+            for (var i = vectorEnd; i < x.Length; i++)
+                product[i] = x[i] * y[i];
+        }
+
+
+        /******************************************************************************************************
+         * Row solvers reporting errors through a status instead of exceptions
+         *****************************************************************************************************/
+
+        // Temperature bounds of the equations and saturation vapor pressures at these bounds,
+        // evaluated once per batch call for the dew point solver.
+        private readonly struct DewPointBounds
+        {
+            public readonly double Lower, Upper, MinVapPres, MaxVapPres;
+
+            public DewPointBounds(Psychrometrics psy)
+            {
+                Lower = psy.UnitSystem == UnitSystem.IP ? -148.0 : -100.0;
+                Upper = psy.UnitSystem == UnitSystem.IP ? 392.0 : 200.0;
+                MinVapPres = psy.GetSatVapPres(Lower);
+                MaxVapPres = psy.GetSatVapPres(Upper);
+            }
+        }
+
+        // Same algorithm as GetTDewPointFromVapPres, without exceptions.
+        // A dry bulb temperature outside the bounds is reported as TemperatureOutOfRange: GetTDewPointFromVapPres
+        // does not check it, but throws from GetSatVapPres at its first guess, the dry bulb temperature.
+        private BatchStatus TryGetTDewPointFromVapPres(in DewPointBounds bounds, double tDryBulb, double vapPres,
+            out double tDewPoint)
+        {
+            tDewPoint = double.NaN;
+            if (!(vapPres >= bounds.MinVapPres && vapPres <= bounds.MaxVapPres))
+                return BatchStatus.VapPresOutOfRange;
+            if (!(tDryBulb >= bounds.Lower && tDryBulb <= bounds.Upper))
+                return BatchStatus.TemperatureOutOfRange;
+
+            var tDewPointNew = tDryBulb;
+            var lnVP = Math.Log(vapPres);
+            double tDewPointIter;
+            var index = 1;
+            do
+            {
+                if (index > MAX_ITER_COUNT)
+                    return BatchStatus.NotConverged;
+
+                tDewPointIter = tDewPointNew;
+                var lnVPIter = Math.Log(GetSatVapPres(tDewPointIter));
+                var d_lnVP = dLnPws_(tDewPointIter);
+
+                tDewPointNew = tDewPointIter - (lnVPIter - lnVP) / d_lnVP;
+                tDewPointNew = Math.Max(tDewPointNew, bounds.Lower);
+                tDewPointNew = Math.Min(tDewPointNew, bounds.Upper);
+
+                index++;
+            } while (Math.Abs(tDewPointNew - tDewPointIter) > PSYCHROLIB_TOLERANCE);
+
+            tDewPoint = Math.Min(tDewPointNew, tDryBulb);
+            return BatchStatus.Ok;
+        }
+
+        // Same algorithm as GetTWetBulbFromHumRatio, without exceptions.
+        private BatchStatus TryGetTWetBulbFromHumRatio(in DewPointBounds bounds, double tDryBulb, double humRatio,
+            double pressure, out double tWetBulb)
+        {
+            tWetBulb = double.NaN;
+            if (!(humRatio >= 0.0))
+                return BatchStatus.NegativeHumRatio;
+            var boundedHumRatio = Math.Max(humRatio, MIN_HUM_RATIO);
+
+            var vapPres = GetVapPresFromHumRatio(boundedHumRatio, pressure);
+            var status = TryGetTDewPointFromVapPres(bounds, tDryBulb, vapPres, out var tDewPoint);
+            if (status != BatchStatus.Ok)
+                return status;
+
+            var tWetBulbSup = tDryBulb;
+            var tWetBulbInf = tDewPoint;
+            var tWetBulbNew = (tWetBulbInf + tWetBulbSup) / 2.0;
+            var index = 1;
+            while ((tWetBulbSup - tWetBulbInf) > PSYCHROLIB_TOLERANCE)
+            {
+                if (index > MAX_ITER_COUNT)
+                    return BatchStatus.NotConverged;
+
+                var wStar = GetHumRatioFromTWetBulb(tDryBulb, tWetBulbNew, pressure);
+                if (wStar > boundedHumRatio)
+                    tWetBulbSup = tWetBulbNew;
+                else
+                    tWetBulbInf = tWetBulbNew;
+                tWetBulbNew = (tWetBulbSup + tWetBulbInf) / 2.0;
+
+                index++;
+            }
+
+            tWetBulb = tWetBulbNew;
+            return BatchStatus.Ok;
+        }
+
+
+        /******************************************************************************************************
+         * Helpers
+         *****************************************************************************************************/
+
+        private static void CheckLengths(int length, params int[] others)
+        {
+            foreach (var other in others)
+                if (other != length)
+                    throw new ArgumentException("All input and output spans must have the same length.");
+        }
+
+        private static void CheckRelHum(ReadOnlySpan<double> relHum, Span<BatchStatus> status)
+        {
+            for (var i = 0; i < relHum.Length; i++)
+                status[i] = relHum[i] >= 0.0 && relHum[i] <= 1.0 ? BatchStatus.Ok : BatchStatus.RelHumOutOfRange;
+        }
+
+        private static void CheckWetBulb(ReadOnlySpan<double> tDryBulb, ReadOnlySpan<double> tWetBulb,
+            Span<BatchStatus> status)
+        {
+            for (var i = 0; i < tDryBulb.Length; i++)
+                status[i] = tWetBulb[i] <= tDryBulb[i] ? BatchStatus.Ok : BatchStatus.WetBulbAboveDryBulb;
+        }
+
+        // Set the outputs of invalid rows to NaN and return the number of invalid rows.
+        private static int FinalizeRows(Span<BatchStatus> status, Span<double> out1)
+        {
+            var invalid = 0;
+            for (var i = 0; i < status.Length; i++)
+            {
+                if (status[i] == BatchStatus.Ok)
+                    continue;
+                out1[i] = double.NaN;
+                invalid++;
+            }
+            return invalid;
+        }
+
+        private static int FinalizeRows(Span<BatchStatus> status, Span<double> out1, Span<double> out2,
+            Span<double> out3, Span<double> out4, Span<double> out5, Span<double> out6, Span<double> out7)
+        {
+            var invalid = 0;
+            for (var i = 0; i < status.Length; i++)
+            {
+                if (status[i] == BatchStatus.Ok)
+                    continue;
+                out1[i] = out2[i] = out3[i] = out4[i] = out5[i] = out6[i] = out7[i] = double.NaN;
+                invalid++;
+            }
+            return invalid;
+        }
+    }
+
+    /// <summary>
+    /// Outcome of the calculation of one row by the batch functions.
+    /// </summary>
+    public enum BatchStatus : byte
+    {
+        /// <summary>
+        /// The row was calculated successfully.
+        /// </summary>
+        Ok = 0,
+
+        /// <summary>
+        /// A temperature is outside the range of validity of the equations.
+        /// </summary>
+        TemperatureOutOfRange = 1,
+
+        /// <summary>
+        /// Relative humidity is outside range [0,1].
+        /// </summary>
+        RelHumOutOfRange = 2,
+
+        /// <summary>
+        /// Humidity ratio is negative.
+        /// </summary>
+        NegativeHumRatio = 3,
+
+        /// <summary>
+        /// Partial pressure of water vapor in moist air is negative.
+        /// </summary>
+        NegativeVapPres = 4,
+
+        /// <summary>
+        /// Partial pressure of water vapor is outside range of validity of equations.
+        /// </summary>
+        VapPresOutOfRange = 5,
+
+        /// <summary>
+        /// Wet bulb temperature is above dry bulb temperature.
+        /// </summary>
+        WetBulbAboveDryBulb = 6,
+
+        /// <summary>
+        /// Dew point temperature is above dry bulb temperature.
+        /// </summary>
+        DewPointAboveDryBulb = 7,
+
+        /// <summary>
+        /// An iterative solver did not converge within the maximum number of iterations.
+        /// </summary>
+        NotConverged = 8
+    }
+}
+#endif
@@ -92,6 +92,55 @@ module psychrolib
   public :: CalcPsychrometricsFromTDewPoint
   public :: CalcPsychrometricsFromRelHum
   public :: dLnPws_
+  public :: INVALID
+  public :: STATUS_OK
+  public :: STATUS_UNITS_UNDEFINED
+  public :: STATUS_TEMPERATURE_OUT_OF_RANGE
+  public :: STATUS_REL_HUM_OUT_OF_RANGE
+  public :: STATUS_NEGATIVE_HUM_RATIO
+  public :: STATUS_NEGATIVE_VAP_PRES
+  public :: STATUS_VAP_PRES_OUT_OF_RANGE
+  public :: STATUS_WET_BULB_ABOVE_DRY_BULB
+  public :: STATUS_DEW_POINT_ABOVE_DRY_BULB
+  public :: STATUS_SPECIFIC_HUM_OUT_OF_RANGE
+  public :: STATUS_NOT_CONVERGED
+  public :: GetStatusMessage
+  public :: CalcTWetBulbFromTDewPoint
+  public :: CalcTWetBulbFromRelHum
+  public :: CalcRelHumFromTDewPoint
+  public :: CalcRelHumFromTWetBulb
+  public :: CalcTDewPointFromRelHum
+  public :: CalcTDewPointFromTWetBulb
+  public :: CalcVapPresFromRelHum
+  public :: CalcRelHumFromVapPres
+  public :: CalcTDewPointFromVapPres
+  public :: CalcVapPresFromTDewPoint
+  public :: CalcTWetBulbFromHumRatio
+  public :: CalcHumRatioFromTWetBulb
+  public :: CalcHumRatioFromRelHum
+  public :: CalcRelHumFromHumRatio
+  public :: CalcHumRatioFromTDewPoint
+  public :: CalcTDewPointFromHumRatio
+  public :: CalcHumRatioFromVapPres
+  public :: CalcVapPresFromHumRatio
+  public :: CalcTDryBulbFromEnthalpyAndHumRatio
+  public :: CalcSatVapPres
+  public :: CalcSatHumRatio
+  public :: CalcSatAirEnthalpy
+  public :: CalcVaporPressureDeficit
+  public :: CalcDegreeOfSaturation
+  public :: CalcMoistAirEnthalpy
+  public :: CalcMoistAirVolume
+  public :: CalcTDryBulbFromMoistAirVolumeAndHumRatio
+  public :: CalcMoistAirDensity
+  public :: CalcSpecificHumFromHumRatio
+  public :: CalcHumRatioFromSpecificHum
+  public :: CalcPsychrometricsFromTWetBulbElemental
+  public :: CalcPsychrometricsFromTDewPointElemental
+  public :: CalcPsychrometricsFromRelHumElemental
+  public :: CalcPsychrometricsFromTWetBulbArray
+  public :: CalcPsychrometricsFromTDewPointArray
+  public :: CalcPsychrometricsFromRelHumArray
 
 
   !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -146,6 +195,169 @@ module psychrolib
   real, parameter  :: TRIPLE_POINT_WATER_SI = 0.01
     !+ float: Triple point of water in Celsius.
 
+  real, parameter  :: INVALID = -99999.0
+    !+ Invalid value returned by the elemental routines when Status is not STATUS_OK.
+
+  integer, parameter  :: MIN_PARALLEL_ARRAY_SIZE = 1024
+    !+ Arrays smaller than this are processed serially by the *Array routines,
+    !+ the OpenMP overhead outweighing the gain.
+
+  integer, parameter :: STATUS_OK = 0
+  integer, parameter :: STATUS_UNITS_UNDEFINED = 1
+  integer, parameter :: STATUS_TEMPERATURE_OUT_OF_RANGE = 2
+  integer, parameter :: STATUS_REL_HUM_OUT_OF_RANGE = 3
+  integer, parameter :: STATUS_NEGATIVE_HUM_RATIO = 4
+  integer, parameter :: STATUS_NEGATIVE_VAP_PRES = 5
+  integer, parameter :: STATUS_VAP_PRES_OUT_OF_RANGE = 6
+  integer, parameter :: STATUS_WET_BULB_ABOVE_DRY_BULB = 7
+  integer, parameter :: STATUS_DEW_POINT_ABOVE_DRY_BULB = 8
+  integer, parameter :: STATUS_SPECIFIC_HUM_OUT_OF_RANGE = 9
+  integer, parameter :: STATUS_NOT_CONVERGED = 10
+    !+ Status codes returned by the elemental routines. Use GetStatusMessage to get a description.
+
+
+  !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+  ! Elemental routines
+  !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+  ! Each Get* function that can fail on its inputs has an elemental Calc* counterpart which returns
+  ! its result as an intent(out) argument and reports errors through an optional Status argument
+  ! instead of stopping: on error the result is set to INVALID. The Calc* routines are pure, hence
+  ! safe to call from OpenMP parallel regions and do concurrent loops, and accept arrays of any rank.
+  ! f2py cannot wrap elemental procedures, so the specific procedures are private and exposed
+  ! through generic interfaces.
+
+  interface CalcTWetBulbFromTDewPoint
+    module procedure CalcTWetBulbFromTDewPoint_
+  end interface CalcTWetBulbFromTDewPoint
+
+  interface CalcTWetBulbFromRelHum
+    module procedure CalcTWetBulbFromRelHum_
+  end interface CalcTWetBulbFromRelHum
+
+  interface CalcRelHumFromTDewPoint
+    module procedure CalcRelHumFromTDewPoint_
+  end interface CalcRelHumFromTDewPoint
+
+  interface CalcRelHumFromTWetBulb
+    module procedure CalcRelHumFromTWetBulb_
+  end interface CalcRelHumFromTWetBulb
+
+  interface CalcTDewPointFromRelHum
+    module procedure CalcTDewPointFromRelHum_
+  end interface CalcTDewPointFromRelHum
+
+  interface CalcTDewPointFromTWetBulb
+    module procedure CalcTDewPointFromTWetBulb_
+  end interface CalcTDewPointFromTWetBulb
+
+  interface CalcVapPresFromRelHum
+    module procedure CalcVapPresFromRelHum_
+  end interface CalcVapPresFromRelHum
+
+  interface CalcRelHumFromVapPres
+    module procedure CalcRelHumFromVapPres_
+  end interface CalcRelHumFromVapPres
+
+  interface CalcTDewPointFromVapPres
+    module procedure CalcTDewPointFromVapPres_
+  end interface CalcTDewPointFromVapPres
+
+  interface CalcVapPresFromTDewPoint
+    module procedure CalcVapPresFromTDewPoint_
+  end interface CalcVapPresFromTDewPoint
+
+  interface CalcTWetBulbFromHumRatio
+    module procedure CalcTWetBulbFromHumRatio_
+  end interface CalcTWetBulbFromHumRatio
+
+  interface CalcHumRatioFromTWetBulb
+    module procedure CalcHumRatioFromTWetBulb_
+  end interface CalcHumRatioFromTWetBulb
+
+  interface CalcHumRatioFromRelHum
+    module procedure CalcHumRatioFromRelHum_
+  end interface CalcHumRatioFromRelHum
+
+  interface CalcRelHumFromHumRatio
+    module procedure CalcRelHumFromHumRatio_
+  end interface CalcRelHumFromHumRatio
+
+  interface CalcHumRatioFromTDewPoint
+    module procedure CalcHumRatioFromTDewPoint_
+  end interface CalcHumRatioFromTDewPoint
+
+  interface CalcTDewPointFromHumRatio
+    module procedure CalcTDewPointFromHumRatio_
+  end interface CalcTDewPointFromHumRatio
+
+  interface CalcHumRatioFromVapPres
+    module procedure CalcHumRatioFromVapPres_
+  end interface CalcHumRatioFromVapPres
+
+  interface CalcVapPresFromHumRatio
+    module procedure CalcVapPresFromHumRatio_
+  end interface CalcVapPresFromHumRatio
+
+  interface CalcSpecificHumFromHumRatio
+    module procedure CalcSpecificHumFromHumRatio_
+  end interface CalcSpecificHumFromHumRatio
+
+  interface CalcHumRatioFromSpecificHum
+    module procedure CalcHumRatioFromSpecificHum_
+  end interface CalcHumRatioFromSpecificHum
+
+  interface CalcTDryBulbFromEnthalpyAndHumRatio
+    module procedure CalcTDryBulbFromEnthalpyAndHumRatio_
+  end interface CalcTDryBulbFromEnthalpyAndHumRatio
+
+  interface CalcSatVapPres
+    module procedure CalcSatVapPres_
+  end interface CalcSatVapPres
+
+  interface CalcSatHumRatio
+    module procedure CalcSatHumRatio_
+  end interface CalcSatHumRatio
+
+  interface CalcSatAirEnthalpy
+    module procedure CalcSatAirEnthalpy_
+  end interface CalcSatAirEnthalpy
+
+  interface CalcVaporPressureDeficit
+    module procedure CalcVaporPressureDeficit_
+  end interface CalcVaporPressureDeficit
+
+  interface CalcDegreeOfSaturation
+    module procedure CalcDegreeOfSaturation_
+  end interface CalcDegreeOfSaturation
+
+  interface CalcMoistAirEnthalpy
+    module procedure CalcMoistAirEnthalpy_
+  end interface CalcMoistAirEnthalpy
+
+  interface CalcMoistAirVolume
+    module procedure CalcMoistAirVolume_
+  end interface CalcMoistAirVolume
+
+  interface CalcTDryBulbFromMoistAirVolumeAndHumRatio
+    module procedure CalcTDryBulbFromMoistAirVolumeAndHumRatio_
+  end interface CalcTDryBulbFromMoistAirVolumeAndHumRatio
+
+  interface CalcMoistAirDensity
+    module procedure CalcMoistAirDensity_
+  end interface CalcMoistAirDensity
+
+  interface CalcPsychrometricsFromTWetBulbElemental
+    module procedure CalcPsychrometricsFromTWetBulb_
+  end interface CalcPsychrometricsFromTWetBulbElemental
+
+  interface CalcPsychrometricsFromTDewPointElemental
+    module procedure CalcPsychrometricsFromTDewPoint_
+  end interface CalcPsychrometricsFromTDewPointElemental
+
+  interface CalcPsychrometricsFromRelHumElemental
+    module procedure CalcPsychrometricsFromRelHum_
+  end interface CalcPsychrometricsFromRelHumElemental
+
 
   contains
 
@@ -176,13 +388,13 @@ module psychrolib
     end if
   end subroutine SetUnitSystem
 
-  function GetUnitSystem() result(UnitSystem)
+  pure function GetUnitSystem() result(UnitSystem)
     !+ Return the system of units in use.
     integer :: UnitSystem
     UnitSystem = PSYCHROLIB_UNITS
   end function GetUnitSystem
 
-  function isIP()
+  pure function isIP()
     !+ Check whether the system in use is IP or SI
     logical :: isIP
     if (PSYCHROLIB_UNITS == IP) then
@@ -194,12 +406,75 @@ module psychrolib
     end if
   end function isIP
 
+  pure function UnitSystemStatus() result(Status)
+    !+ Return STATUS_UNITS_UNDEFINED if the system of units has not been defined, STATUS_OK otherwise.
+    !+ Called by the elemental routines before isIP, which stops if the system of units is undefined.
+    integer :: Status
+    if (PSYCHROLIB_UNITS == IP .or. PSYCHROLIB_UNITS == SI) then
+      Status = STATUS_OK
+    else
+      Status = STATUS_UNITS_UNDEFINED
+    end if
+  end function UnitSystemStatus
+
+  pure function GetStatusMessage(Status) result(Message)
+    !+ Return the error message corresponding to a status code returned by the elemental routines.
+
+    integer, intent(in) :: Status
+      !+ Status code returned by an elemental routine
+    character(len=80)   :: Message
+      !+ Error message
+
+    select case (Status)
+    case (STATUS_OK)
+      Message = "No error."
+    case (STATUS_UNITS_UNDEFINED)
+      Message = "The system of units has not been defined."
+    case (STATUS_TEMPERATURE_OUT_OF_RANGE)
+      if (PSYCHROLIB_UNITS == IP) then
+        Message = "Error: dry bulb temperature must be in range [-148, 392]°F"
+      else
+        Message = "Error: dry bulb temperature must be in range [-100, 200]°C"
+      end if
+    case (STATUS_REL_HUM_OUT_OF_RANGE)
+      Message = "Error: relative humidity is outside range [0,1]"
+    case (STATUS_NEGATIVE_HUM_RATIO)
+      Message = "Error: humidity ratio cannot be negative"
+    case (STATUS_NEGATIVE_VAP_PRES)
+      Message = "Error: partial pressure of water vapor in moist air cannot be negative"
+    case (STATUS_VAP_PRES_OUT_OF_RANGE)
+      Message = "Error: partial pressure of water vapor is outside range of validity of equations"
+    case (STATUS_WET_BULB_ABOVE_DRY_BULB)
+      Message = "Error: wet bulb temperature is above dry bulb temperature"
+    case (STATUS_DEW_POINT_ABOVE_DRY_BULB)
+      Message = "Error: dew point temperature is above dry bulb temperature"
+    case (STATUS_SPECIFIC_HUM_OUT_OF_RANGE)
+      Message = "Error: specific humidity is outside range [0, 1)"
+    case (STATUS_NOT_CONVERGED)
+      Message = "Convergence not reached. Stopping."
+    case default
+      Message = "Error: unknown status code"
+    end select
+  end function GetStatusMessage
+
+  subroutine StopOnError(Status)
+    !+ Stop with the corresponding error message if Status is not STATUS_OK.
+    !+ Used by the Get* functions to keep their behaviour on invalid inputs.
+
+    integer, intent(in) :: Status
+      !+ Status code returned by an elemental routine
+
+    if (Status /= STATUS_OK) then
+      error stop trim(GetStatusMessage(Status))
+    end if
+  end subroutine StopOnError
+
 
   !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
   ! Conversion between temperature units
   !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
-  function GetTRankineFromTFahrenheit(TFahrenheit) result(TRankine)
+  pure function GetTRankineFromTFahrenheit(TFahrenheit) result(TRankine)
     !+ Utility function to convert temperature to degree Rankine (°R)
     !+ given temperature in degree Fahrenheit (°F).
     !+ Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 section 3
@@ -212,7 +487,7 @@ module psychrolib
     TRankine = TFahrenheit + ZERO_FAHRENHEIT_AS_RANKINE
   end function GetTRankineFromTFahrenheit
 
-  function GetTFahrenheitFromTRankine(TRankine) result(TFahrenheit)
+  pure function GetTFahrenheitFromTRankine(TRankine) result(TFahrenheit)
     !+ Utility function to convert temperature to degree Fahrenheit (°F)
     !+ given temperature in degree Rankine (°R).
     !+ Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 section 3
@@ -225,7 +500,7 @@ module psychrolib
     TFahrenheit = TRankine - ZERO_FAHRENHEIT_AS_RANKINE
   end function GetTFahrenheitFromTRankine
 
-  function GetTKelvinFromTCelsius(TCelsius) result(TKelvin)
+  pure function GetTKelvinFromTCelsius(TCelsius) result(TKelvin)
     !+ Utility function to convert temperature to Kelvin (K)
     !+ given temperature in degree Celsius (°C).
     !+ Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 section 3
@@ -238,7 +513,7 @@ module psychrolib
     TKelvin = TCelsius + ZERO_CELSIUS_AS_KELVIN
   end function GetTKelvinFromTCelsius
 
-  function GetTCelsiusFromTKelvin(TKelvin) result(TCelsius)
+  pure function GetTCelsiusFromTKelvin(TKelvin) result(TCelsius)
     !+ Utility function to convert temperature to degree Celsius (°C)
     !+ given temperature in Kelvin (K).
     !+ Reference: ASHRAE Handbook - Fundamentals (2017) ch. 1 section 3
@@ -269,16 +544,40 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              :: TWetBulb
       !+ Wet-bulb temperature in °F [IP] or °C [SI]
+    integer           :: Status
+      !+ Status code of the calculation
+
+    call CalcTWetBulbFromTDewPoint(TDryBulb, TDewPoint, Pressure, TWetBulb, Status)
+    call StopOnError(Status)
+  end function GetTWetBulbFromTDewPoint
+
+  elemental subroutine CalcTWetBulbFromTDewPoint_(TDryBulb, TDewPoint, Pressure, TWetBulb, Status)
+    !+ Elemental version of GetTWetBulbFromTDewPoint reporting errors through Status.
+
+    real, intent(in)  :: TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  :: TDewPoint
+      !+ Dew-point temperature in °F [IP] or °C [SI]
+    real, intent(in)  :: Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) :: TWetBulb
+      !+ Wet-bulb temperature in °F [IP] or °C [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              :: HumRatio
       !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    integer           :: Stat
+      !+ Status code of the calculation
 
+    TWetBulb = INVALID
     if (TDewPoint > TDryBulb) then
-      error stop "Error: dew point temperature is above dry bulb temperature"
+      Stat = STATUS_DEW_POINT_ABOVE_DRY_BULB
+    else
+      call CalcHumRatioFromTDewPoint(TDewPoint, Pressure, HumRatio, Stat)
+      if (Stat == STATUS_OK) call CalcTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure, TWetBulb, Stat)
     end if
-
-    HumRatio = GetHumRatioFromTDewPoint(TDewPoint, Pressure)
-    TWetBulb = GetTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure)
-  end function GetTWetBulbFromTDewPoint
+    if (present(Status)) Status = Stat
+  end subroutine CalcTWetBulbFromTDewPoint_
 
   function GetTWetBulbFromRelHum(TDryBulb, RelHum, Pressure) result(TWetBulb)
     !+ Return wet-bulb temperature given dry-bulb temperature, relative humidity, and pressure.
@@ -293,16 +592,40 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  TWetBulb
       !+ Wet-bulb temperature in °F [IP] or °C [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcTWetBulbFromRelHum(TDryBulb, RelHum, Pressure, TWetBulb, Status)
+    call StopOnError(Status)
+  end function GetTWetBulbFromRelHum
+
+  elemental subroutine CalcTWetBulbFromRelHum_(TDryBulb, RelHum, Pressure, TWetBulb, Status)
+    !+ Elemental version of GetTWetBulbFromRelHum reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  RelHum
+      !+ Relative humidity in range [0, 1]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  TWetBulb
+      !+ Wet-bulb temperature in °F [IP] or °C [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  HumRatio
       !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
 
+    TWetBulb = INVALID
     if (RelHum < 0.0 .or. RelHum > 1.0) then
-      error stop "Error: relative humidity is outside range [0,1]"
+      Stat = STATUS_REL_HUM_OUT_OF_RANGE
+    else
+      call CalcHumRatioFromRelHum(TDryBulb, RelHum, Pressure, HumRatio, Stat)
+      if (Stat == STATUS_OK) call CalcTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure, TWetBulb, Stat)
     end if
-
-    HumRatio = GetHumRatioFromRelHum(TDryBulb, RelHum, Pressure)
-    TWetBulb = GetTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure)
-  end function GetTWetBulbFromRelHum
+    if (present(Status)) Status = Stat
+  end subroutine CalcTWetBulbFromRelHum_
 
   function GetRelHumFromTDewPoint(TDryBulb, TDewPoint) result(RelHum)
     !+ Return relative humidity given dry-bulb temperature and dew-point temperature.
@@ -315,19 +638,41 @@ module psychrolib
       !+ Dew-point temperature in °F [IP] or °C [SI]
     real              ::  RelHum
       !+ Relative humidity in range [0, 1]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcRelHumFromTDewPoint(TDryBulb, TDewPoint, RelHum, Status)
+    call StopOnError(Status)
+  end function GetRelHumFromTDewPoint
+
+  elemental subroutine CalcRelHumFromTDewPoint_(TDryBulb, TDewPoint, RelHum, Status)
+    !+ Elemental version of GetRelHumFromTDewPoint reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  TDewPoint
+      !+ Dew-point temperature in °F [IP] or °C [SI]
+    real, intent(out) ::  RelHum
+      !+ Relative humidity in range [0, 1], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  VapPres
       !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
     real              ::  SatVapPres
       !+ Vapor pressure of saturated air in Psi [IP] or Pa [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
 
+    RelHum = INVALID
     if (TDewPoint > TDryBulb) then
-      error stop "Error: dew point temperature is above dry bulb temperature"
+      Stat = STATUS_DEW_POINT_ABOVE_DRY_BULB
+    else
+      call CalcSatVapPres(TDewPoint, VapPres, Stat)
+      if (Stat == STATUS_OK) call CalcSatVapPres(TDryBulb, SatVapPres, Stat)
+      if (Stat == STATUS_OK) RelHum = VapPres / SatVapPres
     end if
-
-    VapPres     = GetSatVapPres(TDewPoint)
-    SatVapPres  = GetSatVapPres(TDryBulb)
-    RelHum      = VapPres / SatVapPres
-  end function GetRelHumFromTDewPoint
+    if (present(Status)) Status = Stat
+  end subroutine CalcRelHumFromTDewPoint_
 
   function GetRelHumFromTWetBulb(TDryBulb, TWetBulb, Pressure) result(RelHum)
     !+ Return relative humidity given dry-bulb temperature, wet bulb temperature and pressure.
@@ -342,16 +687,40 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  RelHum
       !+ Relative humidity in range [0, 1]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcRelHumFromTWetBulb(TDryBulb, TWetBulb, Pressure, RelHum, Status)
+    call StopOnError(Status)
+  end function GetRelHumFromTWetBulb
+
+  elemental subroutine CalcRelHumFromTWetBulb_(TDryBulb, TWetBulb, Pressure, RelHum, Status)
+    !+ Elemental version of GetRelHumFromTWetBulb reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  TWetBulb
+      !+ Wet-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  RelHum
+      !+ Relative humidity in range [0, 1], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  HumRatio
       !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
 
+    RelHum = INVALID
     if (TWetBulb > TDryBulb) then
-      error stop "Error: wet bulb temperature is above dry bulb temperature"
+      Stat = STATUS_WET_BULB_ABOVE_DRY_BULB
+    else
+      call CalcHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure, HumRatio, Stat)
+      if (Stat == STATUS_OK) call CalcRelHumFromHumRatio(TDryBulb, HumRatio, Pressure, RelHum, Stat)
     end if
-
-    HumRatio = GetHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure)
-    RelHum   = GetRelHumFromHumRatio(TDryBulb, HumRatio, Pressure)
-  end function GetRelHumFromTWetBulb
+    if (present(Status)) Status = Stat
+  end subroutine CalcRelHumFromTWetBulb_
 
   function GetTDewPointFromRelHum(TDryBulb, RelHum) result(TDewPoint)
     !+ Return dew-point temperature given dry-bulb temperature and relative humidity.
@@ -364,16 +733,34 @@ module psychrolib
       !+ Relative humidity in range [0, 1]
     real              ::  TDewPoint
       !+ Dew-point temperature in °F [IP] or °C [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcTDewPointFromRelHum(TDryBulb, RelHum, TDewPoint, Status)
+    call StopOnError(Status)
+  end function GetTDewPointFromRelHum
+
+  elemental subroutine CalcTDewPointFromRelHum_(TDryBulb, RelHum, TDewPoint, Status)
+    !+ Elemental version of GetTDewPointFromRelHum reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  RelHum
+      !+ Relative humidity in range [0, 1]
+    real, intent(out) ::  TDewPoint
+      !+ Dew-point temperature in °F [IP] or °C [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  VapPres
       !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
 
-    if (RelHum < 0.0 .or. RelHum > 1.0) then
-      error stop "Error: relative humidity is outside range [0,1]"
-    end if
-
-    VapPres   = GetVapPresFromRelHum(TDryBulb, RelHum)
-    TDewPoint = GetTDewPointFromVapPres(TDryBulb, VapPres)
-  end function GetTDewPointFromRelHum
+    TDewPoint = INVALID
+    call CalcVapPresFromRelHum(TDryBulb, RelHum, VapPres, Stat)
+    if (Stat == STATUS_OK) call CalcTDewPointFromVapPres(TDryBulb, VapPres, TDewPoint, Stat)
+    if (present(Status)) Status = Stat
+  end subroutine CalcTDewPointFromRelHum_
 
   function GetTDewPointFromTWetBulb(TDryBulb, TWetBulb, Pressure) result(TDewPoint)
     !+ Return dew-point temperature given dry-bulb temperature, wet-bulb temperature, and pressure.
@@ -388,16 +775,41 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  TDewPoint
       !+ Dew-point temperature in °F [IP] or °C [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcTDewPointFromTWetBulb(TDryBulb, TWetBulb, Pressure, TDewPoint, Status)
+    call StopOnError(Status)
+  end function GetTDewPointFromTWetBulb
+
+  elemental subroutine CalcTDewPointFromTWetBulb_(TDryBulb, TWetBulb, Pressure, TDewPoint, Status)
+    !+ Elemental version of GetTDewPointFromTWetBulb reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  TWetBulb
+      !+ Wet-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  TDewPoint
+      !+ Dew-point temperature in °F [IP] or °C [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  HumRatio
       !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
 
+    TDewPoint = INVALID
     if (TWetBulb > TDryBulb) then
-      error stop "Error: wet bulb temperature is above dry bulb temperature"
+      Stat = STATUS_WET_BULB_ABOVE_DRY_BULB
+    else
+      call CalcHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure, HumRatio, Stat)
+      if (Stat == STATUS_OK) call CalcTDewPointFromHumRatio(TDryBulb, HumRatio, Pressure, TDewPoint, Stat)
     end if
+    if (present(Status)) Status = Stat
+  end subroutine CalcTDewPointFromTWetBulb_
 
-    HumRatio  = GetHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure)
-    TDewPoint = GetTDewPointFromHumRatio(TDryBulb, HumRatio, Pressure)
-  end function GetTDewPointFromTWetBulb
 
 
   !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -415,13 +827,38 @@ module psychrolib
       !+ Relative humidity in range [0, 1]
     real              ::  VapPres
       !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcVapPresFromRelHum(TDryBulb, RelHum, VapPres, Status)
+    call StopOnError(Status)
+  end function GetVapPresFromRelHum
+
+  elemental subroutine CalcVapPresFromRelHum_(TDryBulb, RelHum, VapPres, Status)
+    !+ Elemental version of GetVapPresFromRelHum reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  RelHum
+      !+ Relative humidity in range [0, 1]
+    real, intent(out) ::  VapPres
+      !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
+    real              ::  SatVapPres
+      !+ Vapor pressure of saturated air in Psi [IP] or Pa [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
 
+    VapPres = INVALID
     if (RelHum < 0.0 .or. RelHum > 1.0) then
-      error stop "Error: relative humidity is outside range [0,1]"
+      Stat = STATUS_REL_HUM_OUT_OF_RANGE
+    else
+      call CalcSatVapPres(TDryBulb, SatVapPres, Stat)
+      if (Stat == STATUS_OK) VapPres = RelHum * SatVapPres
     end if
-
-    VapPres = RelHum * GetSatVapPres(TDryBulb)
-  end function GetVapPresFromRelHum
+    if (present(Status)) Status = Stat
+  end subroutine CalcVapPresFromRelHum_
 
   function GetRelHumFromVapPres(TDryBulb, VapPres) result(RelHum)
     !+ Return relative humidity given dry-bulb temperature and vapor pressure.
@@ -434,15 +871,40 @@ module psychrolib
       !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
     real              ::  RelHum
       !+ Relative humidity in range [0, 1]
+    integer           ::  Status
+      !+ Status code of the calculation
 
+    call CalcRelHumFromVapPres(TDryBulb, VapPres, RelHum, Status)
+    call StopOnError(Status)
+  end function GetRelHumFromVapPres
+
+  elemental subroutine CalcRelHumFromVapPres_(TDryBulb, VapPres, RelHum, Status)
+    !+ Elemental version of GetRelHumFromVapPres reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  VapPres
+      !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    real, intent(out) ::  RelHum
+      !+ Relative humidity in range [0, 1], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
+    real              ::  SatVapPres
+      !+ Vapor pressure of saturated air in Psi [IP] or Pa [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
+
+    RelHum = INVALID
     if (VapPres < 0.0) then
-      error stop "Error: partial pressure of water vapor in moist air cannot be negative"
+      Stat = STATUS_NEGATIVE_VAP_PRES
+    else
+      call CalcSatVapPres(TDryBulb, SatVapPres, Stat)
+      if (Stat == STATUS_OK) RelHum = VapPres / SatVapPres
     end if
+    if (present(Status)) Status = Stat
+  end subroutine CalcRelHumFromVapPres_
 
-    RelHum = VapPres / GetSatVapPres(TDryBulb)
-  end function GetRelHumFromVapPres
-
-  function dLnPws_(TDryBulb) result(dLnPws)
+  pure function dLnPws_(TDryBulb) result(dLnPws)
     !+ Helper function returning the derivative of the natural log of the saturation vapor pressure
     !+ as a function of dry-bulb temperature.
     !+ Reference:
@@ -501,6 +963,32 @@ module psychrolib
       !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
     real                ::  TDewPoint
       !+ Dew-point temperature in °F [IP] or °C [SI]
+    integer             ::  Status
+      !+ Status code of the calculation
+
+    call CalcTDewPointFromVapPres(TDryBulb, VapPres, TDewPoint, Status)
+    call StopOnError(Status)
+  end function GetTDewPointFromVapPres
+
+  elemental subroutine CalcTDewPointFromVapPres_(TDryBulb, VapPres, TDewPoint, Status)
+    !+ Elemental version of GetTDewPointFromVapPres reporting errors through Status.
+
+    real, intent(in)    ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)    ::  VapPres
+      !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    real, intent(out)   ::  TDewPoint
+      !+ Dew-point temperature in °F [IP] or °C [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
+    real                ::  SatVapPres
+      !+ Vapor pressure of saturated air in Psi [IP] or Pa [SI]
+    real                ::  SatVapPresMin
+      !+ Vapor pressure of saturated air at the lower bound of the valid temperature range
+    real                ::  SatVapPresMax
+      !+ Vapor pressure of saturated air at the upper bound of the valid temperature range
+    integer             ::  Stat
+      !+ Status code of the calculation
     real                ::  lnVP
       !+ Natural logarithm of partial pressure of water vapor pressure in moist air
     real                ::  d_lnVP
@@ -514,6 +1002,13 @@ module psychrolib
     integer             :: index
       !+ Index used in the calculation
 
+    TDewPoint = INVALID
+    Stat = UnitSystemStatus()
+    if (Stat /= STATUS_OK) then
+      if (present(Status)) Status = Stat
+      return
+    end if
+
     ! Bounds and step size as a function of the system of units
     if (isIP()) then
         BOUNDS(1) = -148.0
@@ -524,8 +1019,11 @@ module psychrolib
     end if
 
     ! Validity check -- bounds outside which a solution cannot be found
-    if (VapPres < GetSatVapPres(BOUNDS(1)) .or. VapPres > GetSatVapPres(BOUNDS(2))) then
-      error stop "Error: partial pressure of water vapor is outside range of validity of equations"
+    call CalcSatVapPres(BOUNDS(1), SatVapPresMin)
+    call CalcSatVapPres(BOUNDS(2), SatVapPresMax)
+    if (VapPres < SatVapPresMin .or. VapPres > SatVapPresMax) then
+      if (present(Status)) Status = STATUS_VAP_PRES_OUT_OF_RANGE
+      return
     end if
 
     ! We use NR to approximate the solution.
@@ -535,7 +1033,8 @@ module psychrolib
 
     do while (.true.)
       TDewPoint_iter = TDewPoint ! TDewPoint_iter used in NR calculation
-      lnVP_iter = log(GetSatVapPres(TDewPoint_iter))
+      call CalcSatVapPres(TDewPoint_iter, SatVapPres)
+      lnVP_iter = log(SatVapPres)
 
       ! Derivative of function, calculated analytically
       d_lnVP = dLnPws_(TDewPoint_iter)
@@ -550,14 +1049,17 @@ module psychrolib
       end if
 
       if (index > MAX_ITER_COUNT) then
-        error stop "Convergence not reached in GetTDewPointFromVapPres. Stopping."
+        TDewPoint = INVALID
+        if (present(Status)) Status = STATUS_NOT_CONVERGED
+        return
       end if
 
       index = index + 1
     end do
 
   TDewPoint = min(TDewPoint, TDryBulb)
-  end function GetTDewPointFromVapPres
+  if (present(Status)) Status = STATUS_OK
+  end subroutine CalcTDewPointFromVapPres_
 
   function GetVapPresFromTDewPoint(TDewPoint) result(VapPres)
     !+ Return vapor pressure given dew point temperature.
@@ -568,10 +1070,27 @@ module psychrolib
       !+ Dew-point temperature in °F [IP] or °C [SI]
     real              ::  VapPres
       !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
 
-    VapPres = GetSatVapPres(TDewPoint)
+    call CalcVapPresFromTDewPoint(TDewPoint, VapPres, Status)
+    call StopOnError(Status)
   end function GetVapPresFromTDewPoint
 
+  elemental subroutine CalcVapPresFromTDewPoint_(TDewPoint, VapPres, Status)
+    !+ Elemental version of GetVapPresFromTDewPoint reporting errors through Status.
+
+    real, intent(in)  ::  TDewPoint
+      !+ Dew-point temperature in °F [IP] or °C [SI]
+    real, intent(out) ::  VapPres
+      !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
+
+    call CalcSatVapPres(TDewPoint, VapPres, Status)
+  end subroutine CalcVapPresFromTDewPoint_
+
+
 
   !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
   ! Conversions from wet-bulb temperature, dew-point temperature, or relative humidity to humidity ratio
@@ -590,6 +1109,28 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  TWetBulb
       !+ Wet-bulb temperature in °F [IP] or °C [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure, TWetBulb, Status)
+    call StopOnError(Status)
+  end function GetTWetBulbFromHumRatio
+
+  elemental subroutine CalcTWetBulbFromHumRatio_(TDryBulb, HumRatio, Pressure, TWetBulb, Status)
+    !+ Elemental version of GetTWetBulbFromHumRatio reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  TWetBulb
+      !+ Wet-bulb temperature in °F [IP] or °C [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
+    integer           ::  Stat
+      !+ Status code of the calculation
     real              ::  TDewPoint
       !+ TDewPoint : Dew-point temperature in °F [IP] or °C [SI]
     real              ::  TWetBulbSup
@@ -603,12 +1144,18 @@ module psychrolib
     integer           ::  index
       !+ index used in iteration
 
+    TWetBulb = INVALID
     if (HumRatio < 0.0) then
-      error stop "Error: humidity ratio cannot be negative"
+      if (present(Status)) Status = STATUS_NEGATIVE_HUM_RATIO
+      return
     end if
     BoundedHumRatio = max(HumRatio, MIN_HUM_RATIO)
 
-    TDewPoint = GetTDewPointFromHumRatio(TDryBulb, BoundedHumRatio, Pressure)
+    call CalcTDewPointFromHumRatio(TDryBulb, BoundedHumRatio, Pressure, TDewPoint, Stat)
+    if (Stat /= STATUS_OK) then
+      if (present(Status)) Status = Stat
+      return
+    end if
 
     ! Initial guesses
     TWetBulbSup = TDryBulb
@@ -620,7 +1167,8 @@ module psychrolib
     do while ((TWetBulbSup - TWetBulbInf) > PSYCHROLIB_TOLERANCE)
 
     ! Compute humidity ratio at temperature Tstar
-    Wstar = GetHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure)
+    call CalcHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure, Wstar, Stat)
+    if (Stat /= STATUS_OK) exit
 
     ! Get new bounds
     if (Wstar > BoundedHumRatio) then
@@ -633,12 +1181,16 @@ module psychrolib
     TWetBulb = (TWetBulbSup + TWetBulbInf) / 2.0
 
       if (index > MAX_ITER_COUNT) then
-        error stop "Convergence not reached in GetTWetBulbFromHumRatio. Stopping."
+        Stat = STATUS_NOT_CONVERGED
+        exit
       end if
 
     index = index + 1
     end do
-  end function GetTWetBulbFromHumRatio
+
+    if (Stat /= STATUS_OK) TWetBulb = INVALID
+    if (present(Status)) Status = Stat
+  end subroutine CalcTWetBulbFromHumRatio_
 
   function GetHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure) result(HumRatio)
     !+ Return humidity ratio given dry-bulb temperature, wet-bulb temperature, and pressure.
@@ -653,14 +1205,39 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  HumRatio
       !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure, HumRatio, Status)
+    call StopOnError(Status)
+  end function GetHumRatioFromTWetBulb
+
+  elemental subroutine CalcHumRatioFromTWetBulb_(TDryBulb, TWetBulb, Pressure, HumRatio, Status)
+    !+ Elemental version of GetHumRatioFromTWetBulb reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  TWetBulb
+      !+ Wet-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  Wsstar
       !+ Humidity ratio at temperature Tstar in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
 
+    HumRatio = INVALID
     if (TWetBulb > TDryBulb) then
-      error stop "Error: wet bulb temperature is above dry bulb temperature"
+      Stat = STATUS_WET_BULB_ABOVE_DRY_BULB
+    else
+      call CalcSatHumRatio(TWetBulb, Pressure, Wsstar, Stat)
     end if
-
-    Wsstar = GetSatHumRatio(TWetBulb, Pressure)
+    if (present(Status)) Status = Stat
+    if (Stat /= STATUS_OK) return
 
     if (isIP()) then
       if (TWetBulb >= FREEZING_POINT_WATER_IP) then
@@ -682,7 +1259,7 @@ module psychrolib
 
     ! Validity check.
     HumRatio = max(HumRatio, MIN_HUM_RATIO)
-  end function GetHumRatioFromTWetBulb
+  end subroutine CalcHumRatioFromTWetBulb_
 
   function GetHumRatioFromRelHum(TDryBulb, RelHum, Pressure) result(HumRatio)
     !+ Return humidity ratio given dry-bulb temperature, relative humidity, and pressure.
@@ -697,16 +1274,36 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  HumRatio
       !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcHumRatioFromRelHum(TDryBulb, RelHum, Pressure, HumRatio, Status)
+    call StopOnError(Status)
+  end function GetHumRatioFromRelHum
+
+  elemental subroutine CalcHumRatioFromRelHum_(TDryBulb, RelHum, Pressure, HumRatio, Status)
+    !+ Elemental version of GetHumRatioFromRelHum reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  RelHum
+      !+ Relative humidity in range [0, 1]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  VapPres
       !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
 
-    if (RelHum < 0.0 .or. RelHum > 1.0) then
-      error stop "Error: relative humidity is outside range [0,1]"
-    end if
-
-    VapPres   = GetVapPresFromRelHum(TDryBulb, RelHum)
-    HumRatio  = GetHumRatioFromVapPres(VapPres, Pressure)
-  end function GetHumRatioFromRelHum
+    HumRatio = INVALID
+    call CalcVapPresFromRelHum(TDryBulb, RelHum, VapPres, Stat)
+    if (Stat == STATUS_OK) call CalcHumRatioFromVapPres(VapPres, Pressure, HumRatio, Stat)
+    if (present(Status)) Status = Stat
+  end subroutine CalcHumRatioFromRelHum_
 
   function GetRelHumFromHumRatio(TDryBulb, HumRatio, Pressure) result(RelHum)
   !+ Return relative humidity given dry-bulb temperature, humidity ratio, and pressure.
@@ -721,16 +1318,36 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  RelHum
       !+ Relative humidity in range [0, 1]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcRelHumFromHumRatio(TDryBulb, HumRatio, Pressure, RelHum, Status)
+    call StopOnError(Status)
+  end function GetRelHumFromHumRatio
+
+  elemental subroutine CalcRelHumFromHumRatio_(TDryBulb, HumRatio, Pressure, RelHum, Status)
+    !+ Elemental version of GetRelHumFromHumRatio reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  RelHum
+      !+ Relative humidity in range [0, 1], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  VapPres
       !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
 
-    if (HumRatio < 0.0) then
-      error stop "Error: humidity ratio cannot be negative"
-    end if
-
-    VapPres = GetVapPresFromHumRatio(HumRatio, Pressure)
-    RelHum  = GetRelHumFromVapPres(TDryBulb, VapPres)
-  end function GetRelHumFromHumRatio
+    RelHum = INVALID
+    call CalcVapPresFromHumRatio(HumRatio, Pressure, VapPres, Stat)
+    if (Stat == STATUS_OK) call CalcRelHumFromVapPres(TDryBulb, VapPres, RelHum, Stat)
+    if (present(Status)) Status = Stat
+  end subroutine CalcRelHumFromHumRatio_
 
   function GetHumRatioFromTDewPoint(TDewPoint, Pressure) result(HumRatio)
     !+ Return humidity ratio given dew-point temperature and pressure.
@@ -743,12 +1360,34 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  HumRatio
       !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcHumRatioFromTDewPoint(TDewPoint, Pressure, HumRatio, Status)
+    call StopOnError(Status)
+  end function GetHumRatioFromTDewPoint
+
+  elemental subroutine CalcHumRatioFromTDewPoint_(TDewPoint, Pressure, HumRatio, Status)
+    !+ Elemental version of GetHumRatioFromTDewPoint reporting errors through Status.
+
+    real, intent(in)  ::  TDewPoint
+      !+ Dew-point temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  VapPres
       !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
 
-    VapPres   = GetSatVapPres(TDewPoint)
-    HumRatio  = GetHumRatioFromVapPres(VapPres, Pressure)
-  end function GetHumRatioFromTDewPoint
+    HumRatio = INVALID
+    call CalcSatVapPres(TDewPoint, VapPres, Stat)
+    if (Stat == STATUS_OK) call CalcHumRatioFromVapPres(VapPres, Pressure, HumRatio, Stat)
+    if (present(Status)) Status = Stat
+  end subroutine CalcHumRatioFromTDewPoint_
 
   function GetTDewPointFromHumRatio(TDryBulb, HumRatio, Pressure) result(TDewPoint)
     !+ Return dew-point temperature given dry-bulb temperature, humidity ratio, and pressure.
@@ -763,16 +1402,37 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  TDewPoint
       !+ Dew-point temperature in °F [IP] or °C [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcTDewPointFromHumRatio(TDryBulb, HumRatio, Pressure, TDewPoint, Status)
+    call StopOnError(Status)
+  end function GetTDewPointFromHumRatio
+
+  elemental subroutine CalcTDewPointFromHumRatio_(TDryBulb, HumRatio, Pressure, TDewPoint, Status)
+    !+ Elemental version of GetTDewPointFromHumRatio reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  TDewPoint
+      !+ Dew-point temperature in °F [IP] or °C [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  VapPres
       !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
 
-    if (HumRatio < 0.0) then
-      error stop "Error: humidity ratio cannot be negative"
-    end if
+    TDewPoint = INVALID
+    call CalcVapPresFromHumRatio(HumRatio, Pressure, VapPres, Stat)
+    if (Stat == STATUS_OK) call CalcTDewPointFromVapPres(TDryBulb, VapPres, TDewPoint, Stat)
+    if (present(Status)) Status = Stat
+  end subroutine CalcTDewPointFromHumRatio_
 
-    VapPres   = GetVapPresFromHumRatio(HumRatio, Pressure)
-    TDewPoint = GetTDewPointFromVapPres(TDryBulb, VapPres)
-  end function GetTDewPointFromHumRatio
 
 
   !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -791,16 +1451,37 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  HumRatio
       !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcHumRatioFromVapPres(VapPres, Pressure, HumRatio, Status)
+    call StopOnError(Status)
+  end function GetHumRatioFromVapPres
+
+  elemental subroutine CalcHumRatioFromVapPres_(VapPres, Pressure, HumRatio, Status)
+    !+ Elemental version of GetHumRatioFromVapPres reporting errors through Status.
+
+    real, intent(in)  ::  VapPres
+      !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
 
     if (VapPres < 0.0) then
-      error stop "Error: partial pressure of water vapor in moist air cannot be negative"
+      HumRatio = INVALID
+      if (present(Status)) Status = STATUS_NEGATIVE_VAP_PRES
+      return
     end if
 
     HumRatio = 0.621945 * VapPres / (Pressure-VapPres)
 
     ! Validity check.
     HumRatio = max(HumRatio, MIN_HUM_RATIO)
-  end function GetHumRatioFromVapPres
+    if (present(Status)) Status = STATUS_OK
+  end subroutine CalcHumRatioFromVapPres_
 
   function GetVapPresFromHumRatio(HumRatio, Pressure) result(VapPres)
     !+ Return vapor pressure given humidity ratio and pressure.
@@ -813,16 +1494,37 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  VapPres
       !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcVapPresFromHumRatio(HumRatio, Pressure, VapPres, Status)
+    call StopOnError(Status)
+  end function GetVapPresFromHumRatio
+
+  elemental subroutine CalcVapPresFromHumRatio_(HumRatio, Pressure, VapPres, Status)
+    !+ Elemental version of GetVapPresFromHumRatio reporting errors through Status.
+
+    real, intent(in)  ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  VapPres
+      !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  BoundedHumRatio
       !+ Humidity ratio bounded to MIN_HUM_RATIO
 
     if (HumRatio < 0.0) then
-      error stop "Error: humidity ratio is negative"
+      VapPres = INVALID
+      if (present(Status)) Status = STATUS_NEGATIVE_HUM_RATIO
+      return
     end if
     BoundedHumRatio = max(HumRatio, MIN_HUM_RATIO)
 
     VapPres = Pressure * BoundedHumRatio / (0.621945 + BoundedHumRatio)
-  end function GetVapPresFromHumRatio
+    if (present(Status)) Status = STATUS_OK
+  end subroutine CalcVapPresFromHumRatio_
 
 
   !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -838,16 +1540,35 @@ module psychrolib
       !+ Humidity ratio in lb_H₂O lb_Dry_Air⁻¹ [IP] or kg_H₂O kg_Dry_Air⁻¹ [SI]
     real             :: SpecificHum
       !+ Specific humidity in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    integer          :: Status
+      !+ Status code of the calculation
+
+    call CalcSpecificHumFromHumRatio(HumRatio, SpecificHum, Status)
+    call StopOnError(Status)
+  end function GetSpecificHumFromHumRatio
+
+  elemental subroutine CalcSpecificHumFromHumRatio_(HumRatio, SpecificHum, Status)
+    !+ Elemental version of GetSpecificHumFromHumRatio reporting errors through Status.
+
+    real, intent(in)  :: HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Dry_Air⁻¹ [IP] or kg_H₂O kg_Dry_Air⁻¹ [SI]
+    real, intent(out) :: SpecificHum
+      !+ Specific humidity in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  BoundedHumRatio
       !+ Humidity ratio bounded to MIN_HUM_RATIO
 
     if (HumRatio < 0.0) then
-      error stop "Error: humidity ratio cannot be negative"
+      SpecificHum = INVALID
+      if (present(Status)) Status = STATUS_NEGATIVE_HUM_RATIO
+      return
     end if
     BoundedHumRatio = max(HumRatio, MIN_HUM_RATIO)
 
     SpecificHum = BoundedHumRatio / (1.0 + BoundedHumRatio)
-  end function GetSpecificHumFromHumRatio
+    if (present(Status)) Status = STATUS_OK
+  end subroutine CalcSpecificHumFromHumRatio_
 
   function GetHumRatioFromSpecificHum(SpecificHum) result(HumRatio)
     !+ Return the humidity ratio (aka mixing ratio) from specific humidity.
@@ -858,23 +1579,42 @@ module psychrolib
       !+ Specific humidity in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
     real              :: HumRatio
       !+ Humidity ratio in lb_H₂O lb_Dry_Air⁻¹ [IP] or kg_H₂O kg_Dry_Air⁻¹ [SI]
+    integer           :: Status
+      !+ Status code of the calculation
+
+    call CalcHumRatioFromSpecificHum(SpecificHum, HumRatio, Status)
+    call StopOnError(Status)
+  end function GetHumRatioFromSpecificHum
+
+  elemental subroutine CalcHumRatioFromSpecificHum_(SpecificHum, HumRatio, Status)
+    !+ Elemental version of GetHumRatioFromSpecificHum reporting errors through Status.
+
+    real, intent(in)  :: SpecificHum
+      !+ Specific humidity in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(out) :: HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Dry_Air⁻¹ [IP] or kg_H₂O kg_Dry_Air⁻¹ [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
 
     if (SpecificHum < 0.0 .or. SpecificHum >= 1.0) then
-      error stop "Error: specific humidity is outside range [0, 1)"
+      HumRatio = INVALID
+      if (present(Status)) Status = STATUS_SPECIFIC_HUM_OUT_OF_RANGE
+      return
     end if
 
     HumRatio = SpecificHum / (1.0 - SpecificHum)
 
     ! Validity check.
     HumRatio = max(HumRatio, MIN_HUM_RATIO)
-  end function GetHumRatioFromSpecificHum
+    if (present(Status)) Status = STATUS_OK
+  end subroutine CalcHumRatioFromSpecificHum_
 
 
   !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
   ! Dry Air Calculations
   !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
-  function GetDryAirEnthalpy(TDryBulb) result(DryAirEnthalpy)
+  pure function GetDryAirEnthalpy(TDryBulb) result(DryAirEnthalpy)
     !+ Return dry-air enthalpy given dry-bulb temperature.
     !+ Reference:
     !+ ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 28
@@ -891,7 +1631,7 @@ module psychrolib
     end if
   end function GetDryAirEnthalpy
 
-  function GetDryAirDensity(TDryBulb, Pressure) result(DryAirDensity)
+  pure function GetDryAirDensity(TDryBulb, Pressure) result(DryAirDensity)
     !+ Return dry-air density given dry-bulb temperature and pressure.
     !+ Reference:
     !+ ASHRAE Handbook - Fundamentals (2017) ch. 1
@@ -914,7 +1654,7 @@ module psychrolib
     end if
   end function GetDryAirDensity
 
-  function GetDryAirVolume(TDryBulb, Pressure) result(DryAirVolume)
+  pure function GetDryAirVolume(TDryBulb, Pressure) result(DryAirVolume)
     !+ Return dry-air volume given dry-bulb temperature and pressure.
     !+ Reference:
     !+ ASHRAE Handbook - Fundamentals (2017) ch. 1
@@ -950,12 +1690,34 @@ module psychrolib
       !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
     real              ::  TDryBulb
       !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcTDryBulbFromEnthalpyAndHumRatio(MoistAirEnthalpy, HumRatio, TDryBulb, Status)
+    call StopOnError(Status)
+  end function GetTDryBulbFromEnthalpyAndHumRatio
+
+  elemental subroutine CalcTDryBulbFromEnthalpyAndHumRatio_(MoistAirEnthalpy, HumRatio, TDryBulb, Status)
+    !+ Elemental version of GetTDryBulbFromEnthalpyAndHumRatio reporting errors through Status.
+
+    real, intent(in)  ::  MoistAirEnthalpy
+      !+ Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹
+    real, intent(in)  ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(out) ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  BoundedHumRatio
       !+ Humidity ratio bounded to MIN_HUM_RATIO
-
-    if (HumRatio < 0.0) then
-      error stop "Error: humidity ratio is negative"
-    end if
+    integer           ::  Stat
+      !+ Status code of the calculation
+
+    TDryBulb = INVALID
+    Stat = UnitSystemStatus()
+    if (HumRatio < 0.0) Stat = STATUS_NEGATIVE_HUM_RATIO
+    if (present(Status)) Status = Stat
+    if (Stat /= STATUS_OK) return
     BoundedHumRatio = max(HumRatio, MIN_HUM_RATIO)
 
     if (isIP()) then
@@ -963,9 +1725,10 @@ module psychrolib
     else
       TDryBulb  = (MoistAirEnthalpy / 1000.0 - 2501.0 * BoundedHumRatio) / (1.006 + 1.86 * BoundedHumRatio)
     end if
-  end function GetTDryBulbFromEnthalpyAndHumRatio
+  end subroutine CalcTDryBulbFromEnthalpyAndHumRatio_
+
 
-  function GetHumRatioFromEnthalpyAndTDryBulb(MoistAirEnthalpy, TDryBulb) result(HumRatio)
+  pure function GetHumRatioFromEnthalpyAndTDryBulb(MoistAirEnthalpy, TDryBulb) result(HumRatio)
     !+ Return humidity ratio from enthalpy and dry-bulb temperature.
     !+ Reference:
     !+ ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 30
@@ -1009,14 +1772,40 @@ module psychrolib
       !+ Dry-bulb temperature in °F [IP] or °C [SI]
     real              ::  SatVapPres
       !+ Vapor pressure of saturated air in Psi [IP] or Pa [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcSatVapPres(TDryBulb, SatVapPres, Status)
+    call StopOnError(Status)
+  end function GetSatVapPres
+
+  elemental subroutine CalcSatVapPres_(TDryBulb, SatVapPres, Status)
+    !+ Elemental version of GetSatVapPres reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(out) ::  SatVapPres
+      !+ Vapor pressure of saturated air in Psi [IP] or Pa [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  LnPws
       !+ Log of Vapor Pressure of saturated air (dimensionless)
     real              ::  T
       !+ Dry bulb temperature in R [IP] or K [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
+
+    SatVapPres = INVALID
+    Stat = UnitSystemStatus()
+    if (Stat /= STATUS_OK) then
+      if (present(Status)) Status = Stat
+      return
+    end if
 
     if (isIP()) then
       if (TDryBulb < -148.0 .or. TDryBulb > 392.0) then
-        error stop "Error: dry bulb temperature must be in range [-148, 392]°F"
+        if (present(Status)) Status = STATUS_TEMPERATURE_OUT_OF_RANGE
+        return
       end if
 
       T = GetTRankineFromTFahrenheit(TDryBulb)
@@ -1031,7 +1820,8 @@ module psychrolib
 
       else
         if (TDryBulb < -100.0 .or. TDryBulb > 200.0) then
-          error stop "Error: dry bulb temperature must be in range [-100, 200]°C"
+          if (present(Status)) Status = STATUS_TEMPERATURE_OUT_OF_RANGE
+          return
         end if
 
         T = GetTKelvinFromTCelsius(TDryBulb)
@@ -1046,7 +1836,8 @@ module psychrolib
       end if
 
     SatVapPres = exp(LnPws)
-  end function GetSatVapPres
+    if (present(Status)) Status = STATUS_OK
+  end subroutine CalcSatVapPres_
 
   function GetSatHumRatio(TDryBulb, Pressure) result(SatHumRatio)
     !+ Return humidity ratio of saturated air given dry-bulb temperature and pressure.
@@ -1059,15 +1850,39 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  SatHumRatio
       !+ Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcSatHumRatio(TDryBulb, Pressure, SatHumRatio, Status)
+    call StopOnError(Status)
+  end function GetSatHumRatio
+
+  elemental subroutine CalcSatHumRatio_(TDryBulb, Pressure, SatHumRatio, Status)
+    !+ Elemental version of GetSatHumRatio reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  SatHumRatio
+      !+ Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  SatVaporPres
       !+ Vapor pressure of saturated air in in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
+
+    SatHumRatio = INVALID
+    call CalcSatVapPres(TDryBulb, SatVaporPres, Stat)
+    if (present(Status)) Status = Stat
+    if (Stat /= STATUS_OK) return
 
-    SatVaporPres  = GetSatVapPres(TDryBulb)
     SatHumRatio   = 0.621945 * SatVaporPres / (Pressure-SatVaporPres)
 
     ! Validity check.
     SatHumRatio = max(SatHumRatio, MIN_HUM_RATIO)
-  end function GetSatHumRatio
+  end subroutine CalcSatHumRatio_
 
   function GetSatAirEnthalpy(TDryBulb, Pressure) result(SatAirEnthalpy)
     !+ Return saturated air enthalpy given dry-bulb temperature and pressure.
@@ -1080,10 +1895,35 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  SatAirEnthalpy
       !+ Saturated air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
 
-    SatAirEnthalpy = GetMoistAirEnthalpy(TDryBulb, GetSatHumRatio(TDryBulb, Pressure))
+    call CalcSatAirEnthalpy(TDryBulb, Pressure, SatAirEnthalpy, Status)
+    call StopOnError(Status)
   end function GetSatAirEnthalpy
 
+  elemental subroutine CalcSatAirEnthalpy_(TDryBulb, Pressure, SatAirEnthalpy, Status)
+    !+ Elemental version of GetSatAirEnthalpy reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  SatAirEnthalpy
+      !+ Saturated air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
+    real              ::  SatHumRatio
+      !+ Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
+
+    SatAirEnthalpy = INVALID
+    call CalcSatHumRatio(TDryBulb, Pressure, SatHumRatio, Stat)
+    if (Stat == STATUS_OK) call CalcMoistAirEnthalpy(TDryBulb, SatHumRatio, SatAirEnthalpy, Stat)
+    if (present(Status)) Status = Stat
+  end subroutine CalcSatAirEnthalpy_
+
 
   !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
   ! Moist Air Calculations
@@ -1102,16 +1942,39 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  VaporPressureDeficit
       !+ Vapor pressure deficit in Psi [IP] or Pa [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcVaporPressureDeficit(TDryBulb, HumRatio, Pressure, VaporPressureDeficit, Status)
+    call StopOnError(Status)
+  end function GetVaporPressureDeficit
+
+  elemental subroutine CalcVaporPressureDeficit_(TDryBulb, HumRatio, Pressure, VaporPressureDeficit, Status)
+    !+ Elemental version of GetVaporPressureDeficit reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  VaporPressureDeficit
+      !+ Vapor pressure deficit in Psi [IP] or Pa [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  RelHum
       !+ Relative humidity in range [0, 1]
+    real              ::  SatVapPres
+      !+ Vapor pressure of saturated air in Psi [IP] or Pa [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
 
-    if (HumRatio < 0.0) then
-      error stop "Error: humidity ratio is negative"
-    end if
-
-    RelHum = GetRelHumFromHumRatio(TDryBulb, HumRatio, Pressure)
-    VaporPressureDeficit = GetSatVapPres(TDryBulb) * (1.0 - RelHum)
-  end function GetVaporPressureDeficit
+    VaporPressureDeficit = INVALID
+    call CalcRelHumFromHumRatio(TDryBulb, HumRatio, Pressure, RelHum, Stat)
+    if (Stat == STATUS_OK) call CalcSatVapPres(TDryBulb, SatVapPres, Stat)
+    if (Stat == STATUS_OK) VaporPressureDeficit = SatVapPres * (1.0 - RelHum)
+    if (present(Status)) Status = Stat
+  end subroutine CalcVaporPressureDeficit_
 
   function GetDegreeOfSaturation(TDryBulb, HumRatio, Pressure) result(DegreeOfSaturation)
     !+ Return the degree of saturation (i.e humidity ratio of the air / humidity ratio of the air at saturation
@@ -1129,16 +1992,40 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  DegreeOfSaturation
       !+ Degree of saturation in arbitrary unit
-    real              ::  BoundedHumRatio
-      !+ Humidity ratio bounded to MIN_HUM_RATIO
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcDegreeOfSaturation(TDryBulb, HumRatio, Pressure, DegreeOfSaturation, Status)
+    call StopOnError(Status)
+  end function GetDegreeOfSaturation
+
+  elemental subroutine CalcDegreeOfSaturation_(TDryBulb, HumRatio, Pressure, DegreeOfSaturation, Status)
+    !+ Elemental version of GetDegreeOfSaturation reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  DegreeOfSaturation
+      !+ Degree of saturation in arbitrary unit, INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
+    real              ::  SatHumRatio
+      !+ Humidity ratio of saturated air in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
 
+    DegreeOfSaturation = INVALID
     if (HumRatio < 0.0) then
-      error stop "Error: humidity ratio is negative"
+      Stat = STATUS_NEGATIVE_HUM_RATIO
+    else
+      call CalcSatHumRatio(TDryBulb, Pressure, SatHumRatio, Stat)
+      if (Stat == STATUS_OK) DegreeOfSaturation = max(HumRatio, MIN_HUM_RATIO) / SatHumRatio
     end if
-    BoundedHumRatio = max(HumRatio, MIN_HUM_RATIO)
-
-    DegreeOfSaturation = BoundedHumRatio / GetSatHumRatio(TDryBulb, Pressure)
-  end function GetDegreeOfSaturation
+    if (present(Status)) Status = Stat
+  end subroutine CalcDegreeOfSaturation_
 
   function GetMoistAirEnthalpy(TDryBulb, HumRatio) result(MoistAirEnthalpy)
     !+ Return moist air enthalpy given dry-bulb temperature and humidity ratio.
@@ -1151,12 +2038,34 @@ module psychrolib
       !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
     real              ::  MoistAirEnthalpy
       !+ Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcMoistAirEnthalpy(TDryBulb, HumRatio, MoistAirEnthalpy, Status)
+    call StopOnError(Status)
+  end function GetMoistAirEnthalpy
+
+  elemental subroutine CalcMoistAirEnthalpy_(TDryBulb, HumRatio, MoistAirEnthalpy, Status)
+    !+ Elemental version of GetMoistAirEnthalpy reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(out) ::  MoistAirEnthalpy
+      !+ Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹, INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  BoundedHumRatio
       !+ Humidity ratio bounded to MIN_HUM_RATIO
-
-    if (HumRatio < 0.0) then
-      error stop "Error: humidity ratio is negative"
-    end if
+    integer           ::  Stat
+      !+ Status code of the calculation
+
+    MoistAirEnthalpy = INVALID
+    Stat = UnitSystemStatus()
+    if (HumRatio < 0.0) Stat = STATUS_NEGATIVE_HUM_RATIO
+    if (present(Status)) Status = Stat
+    if (Stat /= STATUS_OK) return
     BoundedHumRatio = max(HumRatio, MIN_HUM_RATIO)
 
     if (isIP()) then
@@ -1164,7 +2073,7 @@ module psychrolib
     else
         MoistAirEnthalpy = (1.006 * TDryBulb + BoundedHumRatio * (2501.0 + 1.86 * TDryBulb)) * 1000.0
     end if
-  end function GetMoistAirEnthalpy
+  end subroutine CalcMoistAirEnthalpy_
 
   function GetMoistAirVolume(TDryBulb, HumRatio, Pressure) result(MoistAirVolume)
     !+ Return moist air specific volume given dry-bulb temperature, humidity ratio, and pressure.
@@ -1182,12 +2091,36 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  MoistAirVolume
       !+ Specific volume of moist air in ft³ lb⁻¹ of dry air [IP] or in m³ kg⁻¹ of dry air [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcMoistAirVolume(TDryBulb, HumRatio, Pressure, MoistAirVolume, Status)
+    call StopOnError(Status)
+  end function GetMoistAirVolume
+
+  elemental subroutine CalcMoistAirVolume_(TDryBulb, HumRatio, Pressure, MoistAirVolume, Status)
+    !+ Elemental version of GetMoistAirVolume reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  MoistAirVolume
+      !+ Specific volume of moist air in ft³ lb⁻¹ of dry air [IP] or in m³ kg⁻¹ of dry air [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  BoundedHumRatio
       !+ Humidity ratio bounded to MIN_HUM_RATIO
-
-    if (HumRatio < 0.0) then
-      error stop "Error: humidity ratio is negative"
-    end if
+    integer           ::  Stat
+      !+ Status code of the calculation
+
+    MoistAirVolume = INVALID
+    Stat = UnitSystemStatus()
+    if (HumRatio < 0.0) Stat = STATUS_NEGATIVE_HUM_RATIO
+    if (present(Status)) Status = Stat
+    if (Stat /= STATUS_OK) return
     BoundedHumRatio = max(HumRatio, MIN_HUM_RATIO)
 
     if (isIP()) then
@@ -1195,7 +2128,7 @@ module psychrolib
     else
         MoistAirVolume = R_DA_SI * GetTKelvinFromTCelsius(TDryBulb) * (1.0 + 1.607858 * BoundedHumRatio) / Pressure
     end if
-  end function GetMoistAirVolume
+  end subroutine CalcMoistAirVolume_
 
   function GetTDryBulbFromMoistAirVolumeAndHumRatio(MoistAirVolume, HumRatio, Pressure) result(TDryBulb)
     !+ Return dry-bulb temperature given moist air specific volume, humidity ratio, and pressure.
@@ -1214,12 +2147,36 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  TDryBulb
       !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcTDryBulbFromMoistAirVolumeAndHumRatio(MoistAirVolume, HumRatio, Pressure, TDryBulb, Status)
+    call StopOnError(Status)
+  end function GetTDryBulbFromMoistAirVolumeAndHumRatio
+
+  elemental subroutine CalcTDryBulbFromMoistAirVolumeAndHumRatio_(MoistAirVolume, HumRatio, Pressure, TDryBulb, Status)
+    !+ Elemental version of GetTDryBulbFromMoistAirVolumeAndHumRatio reporting errors through Status.
+
+    real, intent(in)  ::  MoistAirVolume
+      !+ Specific volume of moist air in ft³ lb⁻¹ of dry air [IP] or in m³ kg⁻¹ of dry air [SI]
+    real, intent(in)  ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  BoundedHumRatio
       !+ Humidity ratio bounded to MIN_HUM_RATIO
-
-    if (HumRatio < 0.0) then
-      error stop "Error: humidity ratio is negative"
-    end if
+    integer           ::  Stat
+      !+ Status code of the calculation
+
+    TDryBulb = INVALID
+    Stat = UnitSystemStatus()
+    if (HumRatio < 0.0) Stat = STATUS_NEGATIVE_HUM_RATIO
+    if (present(Status)) Status = Stat
+    if (Stat /= STATUS_OK) return
     BoundedHumRatio = max(HumRatio, MIN_HUM_RATIO)
 
     if (isIP()) then
@@ -1229,7 +2186,7 @@ module psychrolib
       TDryBulb = GetTCelsiusFromTKelvin(MoistAirVolume * Pressure &
                                 / (R_DA_SI * (1 + 1.607858 * BoundedHumRatio)))
     end if
-  end function GetTDryBulbFromMoistAirVolumeAndHumRatio
+  end subroutine CalcTDryBulbFromMoistAirVolumeAndHumRatio_
 
   function GetMoistAirDensity(TDryBulb, HumRatio, Pressure) result(MoistAirDensity)
     !+ Return moist air density given humidity ratio, dry bulb temperature, and pressure.
@@ -1244,23 +2201,51 @@ module psychrolib
       !+ Atmospheric pressure in Psi [IP] or Pa [SI]
     real              ::  MoistAirDensity
       !+ Moist air density in lb ft⁻³ [IP] or kg m⁻³ [SI]
+    integer           ::  Status
+      !+ Status code of the calculation
+
+    call CalcMoistAirDensity(TDryBulb, HumRatio, Pressure, MoistAirDensity, Status)
+    call StopOnError(Status)
+  end function GetMoistAirDensity
+
+  elemental subroutine CalcMoistAirDensity_(TDryBulb, HumRatio, Pressure, MoistAirDensity, Status)
+    !+ Elemental version of GetMoistAirDensity reporting errors through Status.
+
+    real, intent(in)  ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)  ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(in)  ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out) ::  MoistAirDensity
+      !+ Moist air density in lb ft⁻³ [IP] or kg m⁻³ [SI], INVALID on error
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
     real              ::  BoundedHumRatio
       !+ Humidity ratio bounded to MIN_HUM_RATIO
+    real              ::  MoistAirVolume
+      !+ Specific volume of moist air in ft³ lb⁻¹ of dry air [IP] or in m³ kg⁻¹ of dry air [SI]
+    integer           ::  Stat
+      !+ Status code of the calculation
 
+    MoistAirDensity = INVALID
     if (HumRatio < 0.0) then
-      error stop "Error: humidity ratio is negative"
+      Stat = STATUS_NEGATIVE_HUM_RATIO
+    else
+      BoundedHumRatio = max(HumRatio, MIN_HUM_RATIO)
+      call CalcMoistAirVolume(TDryBulb, BoundedHumRatio, Pressure, MoistAirVolume, Stat)
+      if (Stat == STATUS_OK) MoistAirDensity = (1.0 + BoundedHumRatio) / MoistAirVolume
     end if
-    BoundedHumRatio = max(HumRatio, MIN_HUM_RATIO)
+    if (present(Status)) Status = Stat
+  end subroutine CalcMoistAirDensity_
 
-    MoistAirDensity = (1.0 + BoundedHumRatio) / GetMoistAirVolume(TDryBulb, BoundedHumRatio, Pressure)
-  end function GetMoistAirDensity
 
 
   !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
   ! Standard atmosphere
   !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
-  function GetStandardAtmPressure(Altitude) result(StandardAtmPressure)
+  pure function GetStandardAtmPressure(Altitude) result(StandardAtmPressure)
     !+ Return standard atmosphere barometric pressure, given the elevation (altitude).
     !+ Reference:
     !+ ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 3
@@ -1277,7 +2262,7 @@ module psychrolib
     end if
   end function GetStandardAtmPressure
 
-  function GetStandardAtmTemperature(Altitude) result(StandardAtmTemperature)
+  pure function GetStandardAtmTemperature(Altitude) result(StandardAtmTemperature)
     !+ Return standard atmosphere temperature, given the elevation (altitude).
     !+ Reference:
     !+ ASHRAE Handbook - Fundamentals (2017) ch. 1 eqn 4
@@ -1294,7 +2279,7 @@ module psychrolib
     end if
   end function GetStandardAtmTemperature
 
-  function GetSeaLevelPressure(StnPressure, Altitude, TDryBulb) result(SeaLevelPressure)
+  pure function GetSeaLevelPressure(StnPressure, Altitude, TDryBulb) result(SeaLevelPressure)
     !+ Return sea level pressure given dry-bulb temperature, altitude above sea level and pressure.
     !+ Reference:
     !+ Hess SL, Introduction to theoretical meteorology, Holt Rinehart and Winston, NY 1959,
@@ -1337,7 +2322,7 @@ module psychrolib
     SeaLevelPressure = StnPressure * exp(Altitude / H)
   end function GetSeaLevelPressure
 
-  function GetStationPressure(SeaLevelPressure, Altitude, TDryBulb) result(StationPressure)
+  pure function GetStationPressure(SeaLevelPressure, Altitude, TDryBulb) result(StationPressure)
     !+ Return station pressure from sea level pressure.
     !+ Reference:
     !+ See 'GetSeaLevelPressure'
@@ -1396,16 +2381,145 @@ module psychrolib
       !+ Specific volume of moist air in ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
     real, intent(out)   ::  DegreeOfSaturation
       !+ Degree of saturation [unitless]
-
-    HumRatio            = GetHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure)
-    TDewPoint           = GetTDewPointFromHumRatio(TDryBulb, HumRatio, Pressure)
-    RelHum              = GetRelHumFromHumRatio(TDryBulb, HumRatio, Pressure)
-    VapPres             = GetVapPresFromHumRatio(HumRatio, Pressure)
-    MoistAirEnthalpy    = GetMoistAirEnthalpy(TDryBulb, HumRatio)
-    MoistAirVolume      = GetMoistAirVolume(TDryBulb, HumRatio, Pressure)
-    DegreeOfSaturation  = GetDegreeOfSaturation(TDryBulb, HumRatio, Pressure)
+    integer             ::  Status
+      !+ Status code of the calculation
+
+    call CalcPsychrometricsFromTWetBulb_(TDryBulb,           &
+                                         TWetBulb,           &
+                                         Pressure,           &
+                                         HumRatio,           &
+                                         TDewPoint,          &
+                                         RelHum,             &
+                                         VapPres,            &
+                                         MoistAirEnthalpy,   &
+                                         MoistAirVolume,     &
+                                         DegreeOfSaturation, &
+                                         Status)
+    call StopOnError(Status)
   end subroutine CalcPsychrometricsFromTWetBulb
 
+  elemental subroutine CalcPsychrometricsFromTWetBulb_(TDryBulb,           &
+                                                       TWetBulb,           &
+                                                       Pressure,           &
+                                                       HumRatio,           &
+                                                       TDewPoint,          &
+                                                       RelHum,             &
+                                                       VapPres,            &
+                                                       MoistAirEnthalpy,   &
+                                                       MoistAirVolume,     &
+                                                       DegreeOfSaturation, &
+                                                       Status)
+
+    !+ Elemental version of CalcPsychrometricsFromTWetBulb reporting errors through Status.
+    !+ On error all the outputs are set to INVALID.
+
+    real, intent(in)    ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)    ::  TWetBulb
+      !+ Wet-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)    ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out)   ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(out)   ::  TDewPoint
+      !+ Dew-point temperature in °F [IP] or °C [SI]
+    real, intent(out)   ::  RelHum
+      !+ Relative humidity in range [0, 1]
+    real, intent(out)   ::  VapPres
+      !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    real, intent(out)   ::  MoistAirEnthalpy
+      !+ Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+    real, intent(out)   ::  MoistAirVolume
+      !+ Specific volume of moist air in ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+    real, intent(out)   ::  DegreeOfSaturation
+      !+ Degree of saturation [unitless]
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
+    integer             ::  Stat
+      !+ Status code of the calculation
+
+    call CalcHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure, HumRatio, Stat)
+    if (Stat == STATUS_OK) call CalcTDewPointFromHumRatio(TDryBulb, HumRatio, Pressure, TDewPoint, Stat)
+    if (Stat == STATUS_OK) call CalcRelHumFromHumRatio(TDryBulb, HumRatio, Pressure, RelHum, Stat)
+    if (Stat == STATUS_OK) call CalcVapPresFromHumRatio(HumRatio, Pressure, VapPres, Stat)
+    if (Stat == STATUS_OK) call CalcMoistAirEnthalpy(TDryBulb, HumRatio, MoistAirEnthalpy, Stat)
+    if (Stat == STATUS_OK) call CalcMoistAirVolume(TDryBulb, HumRatio, Pressure, MoistAirVolume, Stat)
+    if (Stat == STATUS_OK) call CalcDegreeOfSaturation(TDryBulb, HumRatio, Pressure, DegreeOfSaturation, Stat)
+
+    if (Stat /= STATUS_OK) then
+      HumRatio = INVALID
+      TDewPoint = INVALID
+      RelHum = INVALID
+      VapPres = INVALID
+      MoistAirEnthalpy = INVALID
+      MoistAirVolume = INVALID
+      DegreeOfSaturation = INVALID
+    end if
+    if (present(Status)) Status = Stat
+  end subroutine CalcPsychrometricsFromTWetBulb_
+
+  subroutine CalcPsychrometricsFromTWetBulbArray(n,                  &
+                                                 TDryBulb,           &
+                                                 TWetBulb,           &
+                                                 Pressure,           &
+                                                 HumRatio,           &
+                                                 TDewPoint,          &
+                                                 RelHum,             &
+                                                 VapPres,            &
+                                                 MoistAirEnthalpy,   &
+                                                 MoistAirVolume,     &
+                                                 DegreeOfSaturation, &
+                                                 Status)
+
+    !+ Array version of CalcPsychrometricsFromTWetBulb, processing n elements in parallel when OpenMP is enabled.
+    !+ Errors are reported element by element through Status instead of stopping, the outputs
+    !+ of the invalid elements being set to INVALID. Arrays of any rank can be passed as they are
+    !+ associated with the rank-1 dummy arguments element by element.
+
+    integer, intent(in)               ::  n
+      !+ Number of elements
+    real, dimension(n), intent(in)    ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, dimension(n), intent(in)    ::  TWetBulb
+      !+ Wet-bulb temperature in °F [IP] or °C [SI]
+    real, dimension(n), intent(in)    ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, dimension(n), intent(out)   ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, dimension(n), intent(out)   ::  TDewPoint
+      !+ Dew-point temperature in °F [IP] or °C [SI]
+    real, dimension(n), intent(out)   ::  RelHum
+      !+ Relative humidity in range [0, 1]
+    real, dimension(n), intent(out)   ::  VapPres
+      !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    real, dimension(n), intent(out)   ::  MoistAirEnthalpy
+      !+ Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+    real, dimension(n), intent(out)   ::  MoistAirVolume
+      !+ Specific volume of moist air in ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+    real, dimension(n), intent(out)   ::  DegreeOfSaturation
+      !+ Degree of saturation [unitless]
+    integer, dimension(n), intent(out) ::  Status
+      !+ STATUS_OK, or the reason why the calculation of the element failed
+    integer                           ::  i
+      !+ Index of the element
+
+    !$omp parallel do if (n >= MIN_PARALLEL_ARRAY_SIZE) schedule(static)
+    do i = 1, n
+      call CalcPsychrometricsFromTWetBulb_(TDryBulb(i),           &
+                                           TWetBulb(i),           &
+                                           Pressure(i),           &
+                                           HumRatio(i),           &
+                                           TDewPoint(i),          &
+                                           RelHum(i),             &
+                                           VapPres(i),            &
+                                           MoistAirEnthalpy(i),   &
+                                           MoistAirVolume(i),     &
+                                           DegreeOfSaturation(i), &
+                                           Status(i))
+    end do
+    !$omp end parallel do
+  end subroutine CalcPsychrometricsFromTWetBulbArray
+
   subroutine CalcPsychrometricsFromTDewPoint(TDryBulb,           &
                                              TDewPoint,          &
                                              Pressure,           &
@@ -1441,16 +2555,145 @@ module psychrolib
       !+ Specific volume of moist air in ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
     real, intent(out)   ::  DegreeOfSaturation
       !+ Degree of saturation [unitless]
+    integer             ::  Status
+      !+ Status code of the calculation
 
-    HumRatio            = GetHumRatioFromTDewPoint(TDewPoint, Pressure)
-    TWetBulb            = GetTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure)
-    RelHum              = GetRelHumFromHumRatio(TDryBulb, HumRatio, Pressure)
-    VapPres             = GetVapPresFromHumRatio(HumRatio, Pressure)
-    MoistAirEnthalpy    = GetMoistAirEnthalpy(TDryBulb, HumRatio)
-    MoistAirVolume      = GetMoistAirVolume(TDryBulb, HumRatio, Pressure)
-    DegreeOfSaturation  = GetDegreeOfSaturation(TDryBulb, HumRatio, Pressure)
+    call CalcPsychrometricsFromTDewPoint_(TDryBulb,           &
+                                          TDewPoint,          &
+                                          Pressure,           &
+                                          HumRatio,           &
+                                          TWetBulb,           &
+                                          RelHum,             &
+                                          VapPres,            &
+                                          MoistAirEnthalpy,   &
+                                          MoistAirVolume,     &
+                                          DegreeOfSaturation, &
+                                          Status)
+    call StopOnError(Status)
   end subroutine CalcPsychrometricsFromTDewPoint
 
+  elemental subroutine CalcPsychrometricsFromTDewPoint_(TDryBulb,           &
+                                                        TDewPoint,          &
+                                                        Pressure,           &
+                                                        HumRatio,           &
+                                                        TWetBulb,           &
+                                                        RelHum,             &
+                                                        VapPres,            &
+                                                        MoistAirEnthalpy,   &
+                                                        MoistAirVolume,     &
+                                                        DegreeOfSaturation, &
+                                                        Status)
+
+    !+ Elemental version of CalcPsychrometricsFromTDewPoint reporting errors through Status.
+    !+ On error all the outputs are set to INVALID.
+
+    real, intent(in)    ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)    ::  TDewPoint
+      !+ Dew-point temperature in °F [IP] or °C [SI]
+    real, intent(in)    ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out)   ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(out)   ::  TWetBulb
+      !+ Wet-bulb temperature in °F [IP] or °C [SI]
+    real, intent(out)   ::  RelHum
+      !+ Relative humidity in range [0, 1]
+    real, intent(out)   ::  VapPres
+      !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    real, intent(out)   ::  MoistAirEnthalpy
+      !+ Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+    real, intent(out)   ::  MoistAirVolume
+      !+ Specific volume of moist air in ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+    real, intent(out)   ::  DegreeOfSaturation
+      !+ Degree of saturation [unitless]
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
+    integer             ::  Stat
+      !+ Status code of the calculation
+
+    call CalcHumRatioFromTDewPoint(TDewPoint, Pressure, HumRatio, Stat)
+    if (Stat == STATUS_OK) call CalcTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure, TWetBulb, Stat)
+    if (Stat == STATUS_OK) call CalcRelHumFromHumRatio(TDryBulb, HumRatio, Pressure, RelHum, Stat)
+    if (Stat == STATUS_OK) call CalcVapPresFromHumRatio(HumRatio, Pressure, VapPres, Stat)
+    if (Stat == STATUS_OK) call CalcMoistAirEnthalpy(TDryBulb, HumRatio, MoistAirEnthalpy, Stat)
+    if (Stat == STATUS_OK) call CalcMoistAirVolume(TDryBulb, HumRatio, Pressure, MoistAirVolume, Stat)
+    if (Stat == STATUS_OK) call CalcDegreeOfSaturation(TDryBulb, HumRatio, Pressure, DegreeOfSaturation, Stat)
+
+    if (Stat /= STATUS_OK) then
+      HumRatio = INVALID
+      TWetBulb = INVALID
+      RelHum = INVALID
+      VapPres = INVALID
+      MoistAirEnthalpy = INVALID
+      MoistAirVolume = INVALID
+      DegreeOfSaturation = INVALID
+    end if
+    if (present(Status)) Status = Stat
+  end subroutine CalcPsychrometricsFromTDewPoint_
+
+  subroutine CalcPsychrometricsFromTDewPointArray(n,                  &
+                                                  TDryBulb,           &
+                                                  TDewPoint,          &
+                                                  Pressure,           &
+                                                  HumRatio,           &
+                                                  TWetBulb,           &
+                                                  RelHum,             &
+                                                  VapPres,            &
+                                                  MoistAirEnthalpy,   &
+                                                  MoistAirVolume,     &
+                                                  DegreeOfSaturation, &
+                                                  Status)
+
+    !+ Array version of CalcPsychrometricsFromTDewPoint, processing n elements in parallel when OpenMP is enabled.
+    !+ Errors are reported element by element through Status instead of stopping, the outputs
+    !+ of the invalid elements being set to INVALID. Arrays of any rank can be passed as they are
+    !+ associated with the rank-1 dummy arguments element by element.
+
+    integer, intent(in)               ::  n
+      !+ Number of elements
+    real, dimension(n), intent(in)    ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, dimension(n), intent(in)    ::  TDewPoint
+      !+ Dew-point temperature in °F [IP] or °C [SI]
+    real, dimension(n), intent(in)    ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, dimension(n), intent(out)   ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, dimension(n), intent(out)   ::  TWetBulb
+      !+ Wet-bulb temperature in °F [IP] or °C [SI]
+    real, dimension(n), intent(out)   ::  RelHum
+      !+ Relative humidity in range [0, 1]
+    real, dimension(n), intent(out)   ::  VapPres
+      !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    real, dimension(n), intent(out)   ::  MoistAirEnthalpy
+      !+ Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+    real, dimension(n), intent(out)   ::  MoistAirVolume
+      !+ Specific volume of moist air in ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+    real, dimension(n), intent(out)   ::  DegreeOfSaturation
+      !+ Degree of saturation [unitless]
+    integer, dimension(n), intent(out) ::  Status
+      !+ STATUS_OK, or the reason why the calculation of the element failed
+    integer                           ::  i
+      !+ Index of the element
+
+    !$omp parallel do if (n >= MIN_PARALLEL_ARRAY_SIZE) schedule(static)
+    do i = 1, n
+      call CalcPsychrometricsFromTDewPoint_(TDryBulb(i),           &
+                                            TDewPoint(i),          &
+                                            Pressure(i),           &
+                                            HumRatio(i),           &
+                                            TWetBulb(i),           &
+                                            RelHum(i),             &
+                                            VapPres(i),            &
+                                            MoistAirEnthalpy(i),   &
+                                            MoistAirVolume(i),     &
+                                            DegreeOfSaturation(i), &
+                                            Status(i))
+    end do
+    !$omp end parallel do
+  end subroutine CalcPsychrometricsFromTDewPointArray
+
   subroutine CalcPsychrometricsFromRelHum(TDryBulb,           &
                                           RelHum,             &
                                           Pressure,           &
@@ -1486,15 +2729,144 @@ module psychrolib
       !+ Specific volume of moist air in ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
     real, intent(out)   ::  DegreeOfSaturation
       !+ Degree of saturation [unitless]
-
-    HumRatio            = GetHumRatioFromRelHum(TDryBulb, RelHum, Pressure)
-    TWetBulb            = GetTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure)
-    TDewPoint           = GetTDewPointFromHumRatio(TDryBulb, HumRatio, Pressure)
-    VapPres             = GetVapPresFromHumRatio(HumRatio, Pressure)
-    MoistAirEnthalpy    = GetMoistAirEnthalpy(TDryBulb, HumRatio)
-    MoistAirVolume      = GetMoistAirVolume(TDryBulb, HumRatio, Pressure)
-    DegreeOfSaturation  = GetDegreeOfSaturation(TDryBulb, HumRatio, Pressure)
+    integer             ::  Status
+      !+ Status code of the calculation
+
+    call CalcPsychrometricsFromRelHum_(TDryBulb,           &
+                                       RelHum,             &
+                                       Pressure,           &
+                                       HumRatio,           &
+                                       TWetBulb,           &
+                                       TDewPoint,          &
+                                       VapPres,            &
+                                       MoistAirEnthalpy,   &
+                                       MoistAirVolume,     &
+                                       DegreeOfSaturation, &
+                                       Status)
+    call StopOnError(Status)
   end subroutine CalcPsychrometricsFromRelHum
 
+  elemental subroutine CalcPsychrometricsFromRelHum_(TDryBulb,           &
+                                                     RelHum,             &
+                                                     Pressure,           &
+                                                     HumRatio,           &
+                                                     TWetBulb,           &
+                                                     TDewPoint,          &
+                                                     VapPres,            &
+                                                     MoistAirEnthalpy,   &
+                                                     MoistAirVolume,     &
+                                                     DegreeOfSaturation, &
+                                                     Status)
+
+    !+ Elemental version of CalcPsychrometricsFromRelHum reporting errors through Status.
+    !+ On error all the outputs are set to INVALID.
+
+    real, intent(in)    ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, intent(in)    ::  RelHum
+      !+ Relative humidity in range [0, 1]
+    real, intent(in)    ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, intent(out)   ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, intent(out)   ::  TWetBulb
+      !+ Wet-bulb temperature in °F [IP] or °C [SI]
+    real, intent(out)   ::  TDewPoint
+      !+ Dew-point temperature in °F [IP] or °C [SI]
+    real, intent(out)   ::  VapPres
+      !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    real, intent(out)   ::  MoistAirEnthalpy
+      !+ Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+    real, intent(out)   ::  MoistAirVolume
+      !+ Specific volume of moist air in ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+    real, intent(out)   ::  DegreeOfSaturation
+      !+ Degree of saturation [unitless]
+    integer, intent(out), optional :: Status
+      !+ STATUS_OK, or the reason why the calculation failed
+    integer             ::  Stat
+      !+ Status code of the calculation
+
+    call CalcHumRatioFromRelHum(TDryBulb, RelHum, Pressure, HumRatio, Stat)
+    if (Stat == STATUS_OK) call CalcTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure, TWetBulb, Stat)
+    if (Stat == STATUS_OK) call CalcTDewPointFromHumRatio(TDryBulb, HumRatio, Pressure, TDewPoint, Stat)
+    if (Stat == STATUS_OK) call CalcVapPresFromHumRatio(HumRatio, Pressure, VapPres, Stat)
+    if (Stat == STATUS_OK) call CalcMoistAirEnthalpy(TDryBulb, HumRatio, MoistAirEnthalpy, Stat)
+    if (Stat == STATUS_OK) call CalcMoistAirVolume(TDryBulb, HumRatio, Pressure, MoistAirVolume, Stat)
+    if (Stat == STATUS_OK) call CalcDegreeOfSaturation(TDryBulb, HumRatio, Pressure, DegreeOfSaturation, Stat)
+
+    if (Stat /= STATUS_OK) then
+      HumRatio = INVALID
+      TWetBulb = INVALID
+      TDewPoint = INVALID
+      VapPres = INVALID
+      MoistAirEnthalpy = INVALID
+      MoistAirVolume = INVALID
+      DegreeOfSaturation = INVALID
+    end if
+    if (present(Status)) Status = Stat
+  end subroutine CalcPsychrometricsFromRelHum_
+
+  subroutine CalcPsychrometricsFromRelHumArray(n,                  &
+                                               TDryBulb,           &
+                                               RelHum,             &
+                                               Pressure,           &
+                                               HumRatio,           &
+                                               TWetBulb,           &
+                                               TDewPoint,          &
+                                               VapPres,            &
+                                               MoistAirEnthalpy,   &
+                                               MoistAirVolume,     &
+                                               DegreeOfSaturation, &
+                                               Status)
+
+    !+ Array version of CalcPsychrometricsFromRelHum, processing n elements in parallel when OpenMP is enabled.
+    !+ Errors are reported element by element through Status instead of stopping, the outputs
+    !+ of the invalid elements being set to INVALID. Arrays of any rank can be passed as they are
+    !+ associated with the rank-1 dummy arguments element by element.
+
+    integer, intent(in)               ::  n
+      !+ Number of elements
+    real, dimension(n), intent(in)    ::  TDryBulb
+      !+ Dry-bulb temperature in °F [IP] or °C [SI]
+    real, dimension(n), intent(in)    ::  RelHum
+      !+ Relative humidity in range [0, 1]
+    real, dimension(n), intent(in)    ::  Pressure
+      !+ Atmospheric pressure in Psi [IP] or Pa [SI]
+    real, dimension(n), intent(out)   ::  HumRatio
+      !+ Humidity ratio in lb_H₂O lb_Air⁻¹ [IP] or kg_H₂O kg_Air⁻¹ [SI]
+    real, dimension(n), intent(out)   ::  TWetBulb
+      !+ Wet-bulb temperature in °F [IP] or °C [SI]
+    real, dimension(n), intent(out)   ::  TDewPoint
+      !+ Dew-point temperature in °F [IP] or °C [SI]
+    real, dimension(n), intent(out)   ::  VapPres
+      !+ Partial pressure of water vapor in moist air in Psi [IP] or Pa [SI]
+    real, dimension(n), intent(out)   ::  MoistAirEnthalpy
+      !+ Moist air enthalpy in Btu lb⁻¹ [IP] or J kg⁻¹ [SI]
+    real, dimension(n), intent(out)   ::  MoistAirVolume
+      !+ Specific volume of moist air in ft³ lb⁻¹ [IP] or in m³ kg⁻¹ [SI]
+    real, dimension(n), intent(out)   ::  DegreeOfSaturation
+      !+ Degree of saturation [unitless]
+    integer, dimension(n), intent(out) ::  Status
+      !+ STATUS_OK, or the reason why the calculation of the element failed
+    integer                           ::  i
+      !+ Index of the element
+
+    !$omp parallel do if (n >= MIN_PARALLEL_ARRAY_SIZE) schedule(static)
+    do i = 1, n
+      call CalcPsychrometricsFromRelHum_(TDryBulb(i),           &
+                                         RelHum(i),             &
+                                         Pressure(i),           &
+                                         HumRatio(i),           &
+                                         TWetBulb(i),           &
+                                         TDewPoint(i),          &
+                                         VapPres(i),            &
+                                         MoistAirEnthalpy(i),   &
+                                         MoistAirVolume(i),     &
+                                         DegreeOfSaturation(i), &
+                                         Status(i))
+    end do
+    !$omp end parallel do
+  end subroutine CalcPsychrometricsFromRelHumArray
+
 
 end module psychrolib
\ No newline at end of file
@@ -0,0 +1,166 @@
+﻿// PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+// Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+using System;
+using NUnit.Framework;
+
+namespace PsychroLib.Tests
+{
+    public class PsychroLibBatchTests
+    {
+        private static double[] Range(double start, double stop, int count)
+        {
+            var values = new double[count];
+            for (var i = 0; i < count; i++)
+                values[i] = start + (stop - start) * i / (count - 1);
+            return values;
+        }
+
+        private static double[] Fill(double value, int count)
+        {
+            var values = new double[count];
+            Array.Fill(values, value);
+            return values;
+        }
+
+        /// <summary>
+        /// The batch functions are tested against the scalar functions over a range of temperatures spanning
+        /// both sides of the triple point. The number of rows is not a multiple of the vector width so that
+        /// the scalar remainder is exercised too.
+        /// </summary>
+        [TestCase(UnitSystem.SI, -50, 90, 101325)]
+        [TestCase(UnitSystem.IP, -58, 194, 14.696)]
+        public void GetSatHumRatio_MatchesScalar(UnitSystem system, double tMin, double tMax, double pressure)
+        {
+            var psy = new Psychrometrics(system);
+            const int count = 1001;
+            var tDryBulb = Range(tMin, tMax, count);
+            var satHumRatio = new double[count];
+            var status = new BatchStatus[count];
+
+            var invalid = psy.GetSatHumRatio(tDryBulb, Fill(pressure, count), satHumRatio, status);
+
+            Assert.That(invalid, Is.EqualTo(0));
+            for (var i = 0; i < count; i++)
+                Assert.That(satHumRatio[i], Is.EqualTo(psy.GetSatHumRatio(tDryBulb[i], pressure)).Within(1e-12).Percent);
+        }
+
+        [TestCase(UnitSystem.SI, -20, 45, 101325)]
+        [TestCase(UnitSystem.IP, -4, 113, 14.696)]
+        public void CalcPsychrometricsFromRelHum_MatchesScalar(UnitSystem system, double tMin, double tMax, double pressure)
+        {
+            var psy = new Psychrometrics(system);
+            const int count = 517;
+            var tDryBulb = Range(tMin, tMax, count);
+            var relHum = Range(0.05, 1.0, count);
+            var outputs = new double[7][];
+            for (var k = 0; k < outputs.Length; k++)
+                outputs[k] = new double[count];
+            var status = new BatchStatus[count];
+
+            var invalid = psy.CalcPsychrometricsFromRelHum(tDryBulb, relHum, Fill(pressure, count), outputs[0],
+                outputs[1], outputs[2], outputs[3], outputs[4], outputs[5], outputs[6], status);
+
+            Assert.That(invalid, Is.EqualTo(0));
+            for (var i = 0; i < count; i++)
+            {
+                var expected = psy.CalcPsychrometricsFromRelHum(tDryBulb[i], relHum[i], pressure);
+                Assert.That(outputs[0][i], Is.EqualTo(expected.HumRatio).Within(1e-9).Percent, "HumRatio");
+                Assert.That(outputs[1][i], Is.EqualTo(expected.TWetBulb).Within(1e-9), "TWetBulb");
+                Assert.That(outputs[2][i], Is.EqualTo(expected.TDewPoint).Within(1e-9), "TDewPoint");
+                Assert.That(outputs[3][i], Is.EqualTo(expected.VapPres).Within(1e-9).Percent, "VapPres");
+                Assert.That(outputs[4][i], Is.EqualTo(expected.MoistAirEnthalpy).Within(1e-9).Percent, "MoistAirEnthalpy");
+                Assert.That(outputs[5][i], Is.EqualTo(expected.MoistAirVolume).Within(1e-9).Percent, "MoistAirVolume");
+                Assert.That(outputs[6][i], Is.EqualTo(expected.DegreeOfSaturation).Within(1e-9).Percent, "DegreeOfSaturation");
+            }
+        }
+
+        /// <summary>
+        /// Invalid rows are reported through the status span instead of exceptions, and the other rows
+        /// are still calculated.
+        /// </summary>
+        [Test]
+        public void CalcPsychrometricsFromRelHum_InvalidRows()
+        {
+            var psy = new Psychrometrics(UnitSystem.SI);
+            var tDryBulb = new[] { 25.0, 25.0, 250.0, 25.0 };
+            var relHum = new[] { 0.5, 1.5, 0.5, -0.1 };
+            var pressure = Fill(101325, 4);
+            var outputs = new double[7][];
+            for (var k = 0; k < outputs.Length; k++)
+                outputs[k] = new double[4];
+            var status = new BatchStatus[4];
+
+            var invalid = psy.CalcPsychrometricsFromRelHum(tDryBulb, relHum, pressure, outputs[0], outputs[1],
+                outputs[2], outputs[3], outputs[4], outputs[5], outputs[6], status);
+
+            Assert.That(invalid, Is.EqualTo(3));
+            Assert.That(status, Is.EqualTo(new[] { BatchStatus.Ok, BatchStatus.RelHumOutOfRange,
+                BatchStatus.TemperatureOutOfRange, BatchStatus.RelHumOutOfRange }));
+            Assert.That(outputs[0][0], Is.EqualTo(psy.GetHumRatioFromRelHum(25, 0.5, 101325)).Within(1e-12));
+            foreach (var output in outputs)
+                Assert.That(double.IsNaN(output[1]) && double.IsNaN(output[2]) && double.IsNaN(output[3]));
+        }
+
+        /// <summary>
+        /// GetTDewPointFromHumRatio does not check the dry bulb temperature, but throws from GetSatVapPres
+        /// when it is outside the bounds of the equations: the batch function reports TemperatureOutOfRange.
+        /// </summary>
+        [Test]
+        public void GetTDewPointFromHumRatio_DryBulbOutOfRange()
+        {
+            var psy = new Psychrometrics(UnitSystem.SI);
+            var tDryBulb = new[] { 25.0, 250.0, -150.0, double.NaN };
+            var humRatio = Fill(0.01, 4);
+            var tDewPoint = new double[4];
+            var status = new BatchStatus[4];
+
+            var invalid = psy.GetTDewPointFromHumRatio(tDryBulb, humRatio, Fill(101325, 4), tDewPoint, status);
+
+            Assert.That(invalid, Is.EqualTo(3));
+            Assert.That(status, Is.EqualTo(new[] { BatchStatus.Ok, BatchStatus.TemperatureOutOfRange,
+                BatchStatus.TemperatureOutOfRange, BatchStatus.TemperatureOutOfRange }));
+            Assert.That(tDewPoint[0], Is.EqualTo(psy.GetTDewPointFromHumRatio(25, 0.01, 101325)).Within(1e-9));
+            for (var i = 1; i < 4; i++)
+            {
+                Assert.That(double.IsNaN(tDewPoint[i]));
+                Assert.Throws<InvalidOperationException>(() =>
+                    psy.GetTDewPointFromHumRatio(tDryBulb[i], humRatio[i], 101325));
+            }
+        }
+
+        [Test]
+        public void CalcPsychrometricsFromTWetBulbParallel_MatchesSequential()
+        {
+            var psy = new Psychrometrics(UnitSystem.SI) { ParallelThreshold = 1000 };
+            const int count = 20000;
+            var tDryBulb = Range(-10, 45, count);
+            var tWetBulb = new double[count];
+            for (var i = 0; i < count; i++)
+                tWetBulb[i] = tDryBulb[i] - 8.0 * i / count;
+            var pressure = Fill(101325, count);
+
+            var sequential = new double[7][];
+            var parallel = new double[7][];
+            for (var k = 0; k < 7; k++)
+            {
+                sequential[k] = new double[count];
+                parallel[k] = new double[count];
+            }
+            var sequentialStatus = new BatchStatus[count];
+            var parallelStatus = new BatchStatus[count];
+
+            var sequentialInvalid = psy.CalcPsychrometricsFromTWetBulb(tDryBulb, tWetBulb, pressure, sequential[0],
+                sequential[1], sequential[2], sequential[3], sequential[4], sequential[5], sequential[6],
+                sequentialStatus);
+            var parallelInvalid = psy.CalcPsychrometricsFromTWetBulbParallel(tDryBulb, tWetBulb, pressure,
+                parallel[0], parallel[1], parallel[2], parallel[3], parallel[4], parallel[5], parallel[6],
+                parallelStatus);
+
+            Assert.That(parallelInvalid, Is.EqualTo(sequentialInvalid));
+            Assert.That(parallelStatus, Is.EqualTo(sequentialStatus));
+            for (var k = 0; k < 7; k++)
+                Assert.That(parallel[k], Is.EqualTo(sequential[k]));
+        }
+    }
+}
@@ -1,6 +1,8 @@
 # PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
 # Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
 
+import importlib.util
+import re
 import sys
 from pathlib import Path
 
@@ -33,14 +35,45 @@ psyf = psychrolib_fortran.psychrolib
 PATH_TO_C = Path(__file__).parents[1] / 'src' / 'c'
 PATH_TO_HEADER = PATH_TO_C / 'psychrolib.h'
 PATH_TO_SRC = PATH_TO_C / 'psychrolib.c'
+# Optional modules of the C library, compiled in the same extension
+C_MODULES = ['psychrolib_cache', 'psychrolib_site', 'psychrolib_bounded', 'psychrolib_gradient',
+             'psychrolib_table', 'psychrolib_autotune', 'psychrolib_pointset',
+             'psychrolib_climate', 'psychrolib_uncertainty', 'psychrolib_process',
+             'psychrolib_inverse', 'psychrolib_service', 'psychrolib_pipeline', 'psychrolib_chart',
+             'psychrolib_field', 'psychrolib_reference', 'psychrolib_lockstep',
+             'psychrolib_regime', 'psychrolib_frame']
+
+def ReadDeclarations(path, defines = ()):
+    # cffi does not run the preprocessor: drop the directives, the branches of the
+    # #ifdef/#ifndef blocks that do not apply given the macros in defines, and the
+    # macros defined empty (e.g. PSYCHROLIB_API)
+    declarations, skipped, empty = [], [], set()
+    with open(path) as f:
+        for line in f:
+            directive = line.split()[:2] if line.lstrip().startswith('#') else []
+            if directive[:1] == ['#ifdef'] or directive[:1] == ['#ifndef']:
+                skipped.append((directive[0] == '#ifdef') != (directive[1] in defines))
+            elif directive[:1] == ['#if']:
+                skipped.append(False)
+            elif directive[:1] == ['#else']:
+                skipped[-1] = not skipped[-1]
+            elif directive[:1] == ['#endif']:
+                skipped.pop()
+            elif directive[:1] == ['#define'] and len(line.split()) == 2 and not any(skipped):
+                empty.add(directive[1])
+            elif not directive and not any(skipped):
+                declarations.append(line)
+    return ''.join(re.sub(r'\b(%s)\b ?' % '|'.join(empty), '', line) if empty else line for line in declarations)
 
 ffi = cffi.FFI()
 
-with open(PATH_TO_HEADER) as f:
-    ffi.cdef(f.read())
+ffi.cdef(ReadDeclarations(PATH_TO_HEADER))
+for module in C_MODULES:
+    ffi.cdef(ReadDeclarations(PATH_TO_C / (module + '.h')))
 
 with open(PATH_TO_SRC) as f:
-    ffi.set_source("psychroc", f.read(),
+    ffi.set_source("psychroc", f.read() + ''.join('\n#include "%s.h"' % module for module in C_MODULES),
+        sources=[str(PATH_TO_C / (module + '.c')) for module in C_MODULES],
         include_dirs=[str(PATH_TO_C)])
 
 ffi.compile()
@@ -68,6 +101,14 @@ def SetUnitSystem_SI():
     psyf.setunitsystem(2)
     psyc.SetUnitSystem(2)
 
+# Fixture running a test of the optional modules of the C library in SI and in IP units,
+# returning the name of the system of units and setting the C library back to SI afterwards
+@pytest.fixture(params = ['SI', 'IP'])
+def units(request):
+    psyc.SetUnitSystem(getattr(psyc, request.param))
+    yield request.param
+    psyc.SetUnitSystem(psyc.SI)
+
 class CaseInsensitiveFortran(object):
     def __getattribute__(self, name: str):
         return getattr(psyf, name.lower())
@@ -107,6 +148,36 @@ class PythonicC(object):
     def __getattr__(self, name: str):
         return getattr(psyc, name)
 
+# Fixture for the tests of the optional modules of the C library, giving access
+# to both the functions (lib) and the cffi instance (ffi)
+@pytest.fixture(scope = 'module')
+def psycmodule():
+    return psychroc
+
+# Fixture building the bounded-latency functions of the C library in the freestanding
+# configuration, as a separate extension module: returns a function taking the macros
+# to define and returning the module, with the functions (lib) and the cffi instance (ffi)
+@pytest.fixture(scope = 'module')
+def BuildFreestanding(tmp_path_factory):
+    def build(defines):
+        name = 'psychroc_' + '_'.join(define.replace('PSYCHROLIB_', '').lower() for define in defines)
+        tmpdir = tmp_path_factory.mktemp(name)
+        ffi = cffi.FFI()
+        ffi.cdef(ReadDeclarations(PATH_TO_C / 'psychrolib_bounded.h', defines))
+        ffi.set_source(name, '#include "psychrolib_bounded.h"',
+            sources=[str(PATH_TO_C / 'psychrolib_bounded.c')], include_dirs=[str(PATH_TO_C)],
+            define_macros=[('PSYCHROLIB_FREESTANDING', None)] + [(define, None) for define in defines])
+        spec = importlib.util.spec_from_file_location(name, ffi.compile(tmpdir=str(tmpdir)))
+        module = importlib.util.module_from_spec(spec)
+        spec.loader.exec_module(module)
+        return module
+    return build
+
+# Fixture for the tests of Fortran-only routines (elemental and array versions)
+@pytest.fixture(scope = 'module')
+def psyfortran():
+    return CaseInsensitiveFortran()
+
 @pytest.fixture(scope = 'module', params=["C", "Fortran", "Python"])
 def psy(request):
     lang = request.param
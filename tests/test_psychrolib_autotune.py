@@ -0,0 +1,160 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the autotuner of the C library, in SI and IP units: tuned functions within the
+# tolerance of the generic functions, selection of the fastest candidate, and cache file.
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+# Unsaturated range of dry-bulb temperature, humidity ratio and pressure in each system of units
+RANGES = {'SI': (20., 30., 0.002, 0.008, 95000., 101325.),
+          'IP': (68., 86., 0.002, 0.008, 13.8, 14.696)}
+
+def config(psycmodule, units, fixed_pressure = True, tolerance = 0.05, cache = None):
+    ffi = psycmodule.ffi
+    TMin, TMax, WMin, WMax, PMin, PMax = RANGES[units]
+    c = ffi.new('struct PsychroAutotuneConfig *')
+    c.TDryBulbMin, c.TDryBulbMax, c.HumRatioMin, c.HumRatioMax = TMin, TMax, WMin, WMax
+    c.PressureMin, c.PressureMax = (PMax, PMax) if fixed_pressure else (PMin, PMax)
+    c.BatchSize = 256
+    c.Tolerance = tolerance
+    c.SatVapPresTolerance = 1e-6
+    # Keep the string alive with the configuration
+    path = ffi.new('char[]', str(cache).encode()) if cache is not None else ffi.NULL
+    c.CachePath = path
+    return c, path
+
+def report(psycmodule, tuner):
+    r = psycmodule.ffi.new('struct PsychroAutotuneReport *')
+    psycmodule.lib.PsychroAutotuneGetReport(tuner, r)
+    return r
+
+def points(units, n, fixed_pressure):
+    TMin, TMax, WMin, WMax, PMin, PMax = RANGES[units]
+    rng = np.random.default_rng(36)
+    P = [PMax] * n if fixed_pressure else list(rng.uniform(PMin, PMax, n))
+    return list(rng.uniform(TMin, TMax, n)), list(rng.uniform(WMin, WMax, n)), P
+
+@pytest.mark.parametrize('fixed_pressure', [True, False])
+def test_PsychroAutotuneWithinTolerance(psycmodule, units, fixed_pressure):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    c, _ = config(psycmodule, units, fixed_pressure)
+    tuner = lib.PsychroAutotuneCreate(c)
+    assert tuner != ffi.NULL
+    T, W, P = points(units, 300, fixed_pressure)
+    out = ffi.new('double[300]')
+    lib.PsychroAutotuneGetSatVapPres(tuner, 300, T, out)
+    for i in range(300):
+        assert out[i] == pytest.approx(lib.GetSatVapPres(T[i]), rel = 1e-6)
+    # The generic solvers are accurate to within PSYCHROLIB_TOLERANCE of the reference
+    tolerance = c.Tolerance + (0.001 if units == 'SI' else 0.0018)
+    lib.PsychroAutotuneGetTDewPointFromHumRatio(tuner, 300, T, W, P, out)
+    for i in range(300):
+        assert out[i] == pytest.approx(lib.GetTDewPointFromHumRatio(T[i], W[i], P[i]), abs = tolerance)
+    lib.PsychroAutotuneGetTWetBulbFromHumRatio(tuner, 300, T, W, P, out)
+    for i in range(300):
+        assert out[i] == pytest.approx(lib.GetTWetBulbFromHumRatio(T[i], W[i], P[i]), abs = tolerance)
+    lib.PsychroAutotuneDestroy(tuner)
+
+def test_PsychroAutotuneSelectsFastest(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    c, _ = config(psycmodule, units, fixed_pressure = False)
+    tuner = lib.PsychroAutotuneCreate(c)
+    r = report(psycmodule, tuner)
+    assert r.FromCache == 0
+    assert r.TuningTime > 0
+    for k in range(lib.PSYCHRO_N_KERNELS):
+        d = r.Decisions[k]
+        times = [t for t in r.CandidateTime[k] if t > 0]
+        assert d.TimePerPoint == min(times)
+        assert r.CandidateTime[k][d.Backend] == d.TimePerPoint
+        assert d.MaxError <= (c.SatVapPresTolerance if k == lib.PSYCHRO_KERNEL_SAT_VAP_PRES else c.Tolerance)
+        assert (d.TableCount[0] > 0) == (d.Backend in (lib.PSYCHRO_BACKEND_TABLE_TRILINEAR, lib.PSYCHRO_BACKEND_TABLE_CUBIC))
+    # The site context is not a candidate for the temperatures at a variable pressure, and the
+    # tables are not candidates for the saturation vapor pressure
+    assert r.CandidateTime[lib.PSYCHRO_KERNEL_TWET_BULB][lib.PSYCHRO_BACKEND_SITE] == 0
+    assert r.CandidateTime[lib.PSYCHRO_KERNEL_SAT_VAP_PRES][lib.PSYCHRO_BACKEND_SITE] > 0
+    assert r.CandidateTime[lib.PSYCHRO_KERNEL_SAT_VAP_PRES][lib.PSYCHRO_BACKEND_TABLE_CUBIC] == 0
+    lib.PsychroAutotuneDestroy(tuner)
+
+def test_PsychroAutotuneTightTolerance(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    c, _ = config(psycmodule, 'SI', tolerance = 1e-5)
+    tuner = lib.PsychroAutotuneCreate(c)
+    r = report(psycmodule, tuner)
+    # The bisection of the generic wet-bulb temperature is rejected, the converged solvers are not
+    assert r.CandidateTime[lib.PSYCHRO_KERNEL_TWET_BULB][lib.PSYCHRO_BACKEND_GENERIC] == 0
+    for k in [lib.PSYCHRO_KERNEL_TDEW_POINT, lib.PSYCHRO_KERNEL_TWET_BULB]:
+        assert r.CandidateTime[k][lib.PSYCHRO_BACKEND_BOUNDED] > 0
+        assert r.Decisions[k].MaxError <= 1e-5
+    lib.PsychroAutotuneDestroy(tuner)
+
+def test_PsychroAutotuneFallbackAtOtherPressure(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    c, _ = config(psycmodule, 'SI')
+    tuner = lib.PsychroAutotuneCreate(c)
+    T, W = [25., 25., 25., 45.], [0.005, 0.005, 0.005, 0.02]
+    P = [101325., 80000., 101325., 101325.]
+    out = ffi.new('double[4]')
+    lib.PsychroAutotuneGetTWetBulbFromHumRatio(tuner, 4, T, W, P, out)
+    for i in range(4):
+        assert out[i] == pytest.approx(lib.GetTWetBulbFromHumRatio(T[i], W[i], P[i]), abs = 0.051)
+    assert out[1] < out[0]
+    lib.PsychroAutotuneDestroy(tuner)
+
+def test_PsychroAutotuneCache(psycmodule, units, tmp_path):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    cache = tmp_path / 'autotune'
+    c, path = config(psycmodule, units, cache = cache)
+    first = lib.PsychroAutotuneCreate(c)
+    r1 = report(psycmodule, first)
+    assert r1.FromCache == 0
+    assert cache.exists()
+    assert cache.read_text().startswith('psychrolib-autotune 1\n')
+
+    second = lib.PsychroAutotuneCreate(c)
+    r2 = report(psycmodule, second)
+    assert r2.FromCache == 1
+    for k in range(lib.PSYCHRO_N_KERNELS):
+        assert r2.Decisions[k].Backend == r1.Decisions[k].Backend
+        assert r2.Decisions[k].TimePerPoint == r1.Decisions[k].TimePerPoint
+        assert list(r2.Decisions[k].TableCount) == list(r1.Decisions[k].TableCount)
+        assert list(r2.CandidateTime[k]) == [0.] * lib.PSYCHRO_N_BACKENDS
+    T, W, P = points(units, 100, True)
+    out1, out2 = ffi.new('double[100]'), ffi.new('double[100]')
+    lib.PsychroAutotuneGetTWetBulbFromHumRatio(first, 100, T, W, P, out1)
+    lib.PsychroAutotuneGetTWetBulbFromHumRatio(second, 100, T, W, P, out2)
+    assert list(out1) == list(out2)
+    lib.PsychroAutotuneDestroy(first)
+    lib.PsychroAutotuneDestroy(second)
+
+    # Another workload, or a damaged file, is tuned again and replaces the file
+    c.BatchSize = 512
+    third = lib.PsychroAutotuneCreate(c)
+    assert report(psycmodule, third).FromCache == 0
+    assert 'batch 512\n' in cache.read_text()
+    lib.PsychroAutotuneDestroy(third)
+    cache.write_text(cache.read_text().replace('batch 512', 'batch'))
+    fourth = lib.PsychroAutotuneCreate(c)
+    assert report(psycmodule, fourth).FromCache == 0
+    lib.PsychroAutotuneDestroy(fourth)
+    fifth = lib.PsychroAutotuneCreate(c)
+    assert report(psycmodule, fifth).FromCache == 1
+    lib.PsychroAutotuneDestroy(fifth)
+
+def test_PsychroAutotuneCreateInvalidConfig(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    for field, value in [('TDryBulbMax', 10.), ('TDryBulbMin', -120.), ('HumRatioMin', -0.001), ('PressureMin', 0.),
+                         ('BatchSize', 0), ('Tolerance', 0.), ('SatVapPresTolerance', -1.)]:
+        c, _ = config(psycmodule, 'SI', fixed_pressure = False)
+        setattr(c, field, value)
+        assert lib.PsychroAutotuneCreate(c) == ffi.NULL
+
+def test_PsychroGetBackendName(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    names = [ffi.string(lib.PsychroGetBackendName(b)).decode() for b in range(lib.PSYCHRO_N_BACKENDS)]
+    assert names == ['generic', 'bounded', 'site', 'table-trilinear', 'table-cubic']
+    assert ffi.string(lib.PsychroGetBackendName(lib.PSYCHRO_N_BACKENDS)) == b'unknown'
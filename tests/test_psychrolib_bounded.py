@@ -0,0 +1,185 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the bounded-latency functions of the C library against the generic functions, in SI and IP units.
+
+import math
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+# Dry-bulb temperature range, relative humidity range and pressure range in each system of units
+DOMAINS = {'SI': (-60., 90., 0.01, 1., 60000., 110000.), 'IP': (-76., 194., 0.01, 1., 8.7, 16.)}
+
+@pytest.fixture
+def points(units):
+    TMin, TMax, RHMin, RHMax, PMin, PMax = DOMAINS[units]
+    rng = np.random.default_rng(31)
+    return rng.uniform(TMin, TMax, 500), rng.uniform(RHMin, RHMax, 500), rng.uniform(PMin, PMax, 500)
+
+def bounded(psycmodule, function, *inputs, outputs = 1):
+    ffi = psycmodule.ffi
+    out = [ffi.new("double *") for _ in range(outputs)]
+    status = function(*inputs, *out)
+    return (status, out[0][0]) if outputs == 1 else (status, [o[0] for o in out])
+
+def tolerance(lib):
+    return 0.001 * (9. / 5. if lib.GetUnitSystem() == lib.IP else 1.)
+
+def test_BoundedGetSatVapPresAndHumRatio(psycmodule, points):
+    lib = psycmodule.lib
+    for TDryBulb, RelHum, Pressure in zip(*points):
+        TWetBulb = lib.GetTWetBulbFromRelHum(TDryBulb, RelHum, Pressure)
+        assert bounded(psycmodule, lib.BoundedGetSatVapPres, TDryBulb) == \
+            (lib.PSYCHRO_STATUS_OK, pytest.approx(lib.GetSatVapPres(TDryBulb), rel = 1e-12))
+        assert bounded(psycmodule, lib.BoundedGetSatHumRatio, TDryBulb, Pressure) == \
+            (lib.PSYCHRO_STATUS_OK, pytest.approx(lib.GetSatHumRatio(TDryBulb, Pressure), rel = 1e-12))
+        assert bounded(psycmodule, lib.BoundedGetHumRatioFromRelHum, TDryBulb, RelHum, Pressure) == \
+            (lib.PSYCHRO_STATUS_OK, pytest.approx(lib.GetHumRatioFromRelHum(TDryBulb, RelHum, Pressure), rel = 1e-12))
+        assert bounded(psycmodule, lib.BoundedGetHumRatioFromTWetBulb, TDryBulb, TWetBulb, Pressure) == \
+            (lib.PSYCHRO_STATUS_OK, pytest.approx(lib.GetHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure), rel = 1e-12))
+
+# The generic functions solve the temperatures to within PSYCHROLIB_TOLERANCE
+def test_BoundedGetTWetBulbAndTDewPoint(psycmodule, points):
+    lib = psycmodule.lib
+    for TDryBulb, RelHum, Pressure in zip(*points):
+        HumRatio = lib.GetHumRatioFromRelHum(TDryBulb, RelHum, Pressure)
+        status, TWetBulb = bounded(psycmodule, lib.BoundedGetTWetBulbFromHumRatio, TDryBulb, HumRatio, Pressure)
+        assert status == lib.PSYCHRO_STATUS_OK
+        assert TWetBulb == pytest.approx(lib.GetTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure), abs = tolerance(lib))
+        assert bounded(psycmodule, lib.BoundedGetTWetBulbFromRelHum, TDryBulb, RelHum, Pressure) == \
+            (lib.PSYCHRO_STATUS_OK, pytest.approx(TWetBulb, abs = 1e-9))
+        status, TDewPoint = bounded(psycmodule, lib.BoundedGetTDewPointFromHumRatio, TDryBulb, HumRatio, Pressure)
+        assert status == lib.PSYCHRO_STATUS_OK
+        assert TDewPoint == pytest.approx(lib.GetTDewPointFromHumRatio(TDryBulb, HumRatio, Pressure), abs = tolerance(lib))
+        assert bounded(psycmodule, lib.BoundedGetTDewPointFromRelHum, TDryBulb, RelHum) == \
+            (lib.PSYCHRO_STATUS_OK, pytest.approx(lib.GetTDewPointFromRelHum(TDryBulb, RelHum), abs = tolerance(lib)))
+        # The fixed number of steps converges to a much tighter tolerance
+        assert lib.GetHumRatioFromTWetBulb(TDryBulb, TWetBulb, Pressure) == pytest.approx(HumRatio, rel = 1e-6, abs = 1e-9)
+        assert lib.GetSatVapPres(TDewPoint) == pytest.approx(lib.GetVapPresFromHumRatio(HumRatio, Pressure), rel = 1e-9)
+
+def test_BoundedCalcPsychrometrics(psycmodule, points):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    expected = [ffi.new("double *") for _ in range(7)]
+    for TDryBulb, RelHum, Pressure in list(zip(*points))[::10]:
+        lib.CalcPsychrometricsFromRelHum(TDryBulb, RelHum, Pressure, *expected)
+        HumRatio, TWetBulb, TDewPoint, VapPres, *others = [e[0] for e in expected]
+        status, outputs = bounded(psycmodule, lib.BoundedCalcPsychrometricsFromRelHum, TDryBulb, RelHum, Pressure, outputs = 7)
+        assert status == lib.PSYCHRO_STATUS_OK
+        assert outputs[1:3] == pytest.approx([TWetBulb, TDewPoint], abs = tolerance(lib))
+        assert outputs[0:1] + outputs[3:] == pytest.approx([HumRatio, VapPres] + others, rel = 1e-9)
+
+        status, outputs = bounded(psycmodule, lib.BoundedCalcPsychrometricsFromTWetBulb, TDryBulb, TWetBulb, Pressure, outputs = 7)
+        assert status == lib.PSYCHRO_STATUS_OK
+        lib.CalcPsychrometricsFromTWetBulb(TDryBulb, TWetBulb, Pressure, *expected)
+        assert outputs[1] == pytest.approx(expected[1][0], abs = tolerance(lib))
+        assert outputs[:1] + outputs[2:] == pytest.approx([e[0] for e in expected[:1] + expected[2:]], rel = 1e-9)
+
+        status, outputs = bounded(psycmodule, lib.BoundedCalcPsychrometricsFromTDewPoint, TDryBulb, TDewPoint, Pressure, outputs = 7)
+        assert status == lib.PSYCHRO_STATUS_OK
+        lib.CalcPsychrometricsFromTDewPoint(TDryBulb, TDewPoint, Pressure, *expected)
+        assert outputs[1] == pytest.approx(expected[1][0], abs = tolerance(lib))
+        assert outputs[:1] + outputs[2:] == pytest.approx([e[0] for e in expected[:1] + expected[2:]], rel = 1e-9)
+
+# Humidity ratios between the limits of ASHRAE eqn. 33 and 35 at the freezing point, where there is
+# a solution on each side of it: the generic bisection is followed
+def test_BoundedGetTWetBulbAroundFreezingPoint(psycmodule, units):
+    lib = psycmodule.lib
+    Pressure = lib.GetStandardAtmPressure(0.)
+    FreezingPoint = 32. if lib.GetUnitSystem() == lib.IP else 0.
+    for TDryBulb in FreezingPoint + np.linspace(0.01, 40., 200):
+        WLiquid = lib.GetHumRatioFromTWetBulb(TDryBulb, FreezingPoint, Pressure)
+        WIce = lib.GetHumRatioFromTWetBulb(TDryBulb, math.nextafter(FreezingPoint, -math.inf), Pressure)
+        for HumRatio in np.linspace(min(WLiquid, WIce), max(WLiquid, WIce), 5):
+            status, TWetBulb = bounded(psycmodule, lib.BoundedGetTWetBulbFromHumRatio, TDryBulb, HumRatio, Pressure)
+            assert status == lib.PSYCHRO_STATUS_OK
+            assert TWetBulb == pytest.approx(lib.GetTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure), abs = tolerance(lib))
+
+# Very dry air, close to the boiling point and close to saturation
+def test_BoundedGetTWetBulbExtremes(psycmodule, units):
+    lib = psycmodule.lib
+    Pressure = 30000. if lib.GetUnitSystem() == lib.SI else 4.
+    TBoiling = lib.GetTDewPointFromVapPres(0., Pressure)
+    for TDryBulb in np.linspace(TBoiling - 30., TBoiling - 0.5, 30):
+        for RelHum in [1e-6, 1e-4, 0.999999, 1.]:
+            HumRatio = lib.GetHumRatioFromRelHum(TDryBulb, RelHum, Pressure)
+            status, TWetBulb = bounded(psycmodule, lib.BoundedGetTWetBulbFromHumRatio, TDryBulb, HumRatio, Pressure)
+            assert status == lib.PSYCHRO_STATUS_OK
+            assert TWetBulb == pytest.approx(lib.GetTWetBulbFromHumRatio(TDryBulb, HumRatio, Pressure), abs = tolerance(lib))
+
+# Dry-bulb temperature above the boiling point, where the bisection of the generic function may
+# converge to the dry-bulb temperature: the humidity ratio of the result brackets the input
+def test_BoundedGetTWetBulbAboveBoilingPoint(psycmodule, units):
+    lib = psycmodule.lib
+    Pressure, TMax = (101325., 200.) if lib.GetUnitSystem() == lib.SI else (14.696, 392.)
+    TBoiling = lib.GetTDewPointFromVapPres(TMax, Pressure)
+    for TDryBulb in np.linspace(TBoiling + 0.5, TBoiling + 90., 30):
+        for RelHum in [1e-4, 0.01, 0.1]:
+            HumRatio = lib.GetHumRatioFromRelHum(TDryBulb, RelHum, Pressure)
+            status, TWetBulb = bounded(psycmodule, lib.BoundedGetTWetBulbFromHumRatio, TDryBulb, HumRatio, Pressure)
+            assert status == lib.PSYCHRO_STATUS_OK
+            assert TWetBulb + tolerance(lib) < TBoiling
+            assert lib.GetHumRatioFromTWetBulb(TDryBulb, TWetBulb - tolerance(lib), Pressure) <= HumRatio
+            assert lib.GetHumRatioFromTWetBulb(TDryBulb, TWetBulb + tolerance(lib), Pressure) >= HumRatio
+
+def test_BoundedInvalidInputs(psycmodule, units):
+    lib = psycmodule.lib
+    TMax = 392. if lib.GetUnitSystem() == lib.IP else 200.
+    Pressure = lib.GetStandardAtmPressure(0.)
+    cases = [
+        (lib.BoundedGetSatVapPres, (TMax + 1.,), lib.PSYCHRO_STATUS_TEMPERATURE_OUT_OF_RANGE),
+        (lib.BoundedGetSatVapPres, (math.nan,), lib.PSYCHRO_STATUS_TEMPERATURE_OUT_OF_RANGE),
+        (lib.BoundedGetHumRatioFromRelHum, (20., 1.5, Pressure), lib.PSYCHRO_STATUS_REL_HUM_OUT_OF_RANGE),
+        (lib.BoundedGetHumRatioFromTWetBulb, (20., 25., Pressure), lib.PSYCHRO_STATUS_WET_BULB_ABOVE_DRY_BULB),
+        (lib.BoundedGetTDewPointFromVapPres, (20., -1.), lib.PSYCHRO_STATUS_NEGATIVE_VAP_PRES),
+        (lib.BoundedGetTDewPointFromVapPres, (20., 0.), lib.PSYCHRO_STATUS_VAP_PRES_OUT_OF_RANGE),
+        (lib.BoundedGetTDewPointFromHumRatio, (20., -0.01, Pressure), lib.PSYCHRO_STATUS_NEGATIVE_HUM_RATIO),
+        (lib.BoundedGetTDewPointFromRelHum, (20., -0.1), lib.PSYCHRO_STATUS_REL_HUM_OUT_OF_RANGE),
+        (lib.BoundedGetTWetBulbFromHumRatio, (20., math.nan, Pressure), lib.PSYCHRO_STATUS_NEGATIVE_HUM_RATIO),
+        (lib.BoundedGetTWetBulbFromRelHum, (TMax + 1., 0.5, Pressure), lib.PSYCHRO_STATUS_TEMPERATURE_OUT_OF_RANGE),
+        (lib.BoundedGetTDewPointFromVapPres, (math.nan, 1.), lib.PSYCHRO_STATUS_TEMPERATURE_OUT_OF_RANGE),
+        (lib.BoundedGetTDewPointFromHumRatio, (TMax + 1., 0.01, Pressure), lib.PSYCHRO_STATUS_TEMPERATURE_OUT_OF_RANGE),
+    ]
+    for function, inputs, expected in cases:
+        assert bounded(psycmodule, function, *inputs) == (expected, -99999.)
+
+def test_BoundedInvalidPressure(psycmodule, units):
+    lib = psycmodule.lib
+    cases = [
+        (lib.BoundedGetSatHumRatio, (20.,)),
+        (lib.BoundedGetHumRatioFromRelHum, (20., 0.5)),
+        (lib.BoundedGetHumRatioFromTWetBulb, (20., 15.)),
+        (lib.BoundedGetTDewPointFromHumRatio, (20., 0.01)),
+        (lib.BoundedGetTWetBulbFromHumRatio, (20., 0.01)),
+        (lib.BoundedGetTWetBulbFromRelHum, (20., 0.5)),
+    ]
+    for Pressure in (0., -101325., math.nan):
+        for function, inputs in cases:
+            assert bounded(psycmodule, function, *inputs, Pressure) == (lib.PSYCHRO_STATUS_PRESSURE_OUT_OF_RANGE, -99999.)
+        for function, inputs in [(lib.BoundedCalcPsychrometricsFromTWetBulb, (20., 15.)),
+                                 (lib.BoundedCalcPsychrometricsFromTDewPoint, (20., 10.)),
+                                 (lib.BoundedCalcPsychrometricsFromRelHum, (20., 0.5))]:
+            status, outputs = bounded(psycmodule, function, *inputs, Pressure, outputs = 7)
+            assert (status, outputs) == (lib.PSYCHRO_STATUS_PRESSURE_OUT_OF_RANGE, [-99999.] * 7)
+    status, outputs = bounded(psycmodule, lib.BoundedCalcPsychrometricsFromTDewPoint, 20., 25., Pressure, outputs = 7)
+    assert (status, outputs) == (lib.PSYCHRO_STATUS_DEW_POINT_ABOVE_DRY_BULB, [-99999.] * 7)
+    status, outputs = bounded(psycmodule, lib.BoundedCalcPsychrometricsFromRelHum, 20., 1.5, Pressure, outputs = 7)
+    assert (status, outputs) == (lib.PSYCHRO_STATUS_REL_HUM_OUT_OF_RANGE, [-99999.] * 7)
+
+def test_BoundedUnitsUndefined(psycmodule):
+    lib = psycmodule.lib
+    lib.SetUnitSystem(lib.UNDEFINED)
+    try:
+        assert bounded(psycmodule, lib.BoundedGetSatVapPres, 20.) == (lib.PSYCHRO_STATUS_UNITS_UNDEFINED, -99999.)
+        assert bounded(psycmodule, lib.BoundedGetTWetBulbFromRelHum, 20., 0.5, 101325.) == \
+            (lib.PSYCHRO_STATUS_UNITS_UNDEFINED, -99999.)
+    finally:
+        lib.SetUnitSystem(lib.SI)
+
+def test_PsychroGetStatusMessage(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    assert ffi.string(lib.PsychroGetStatusMessage(lib.PSYCHRO_STATUS_OK)) == b'No error'
+    messages = {ffi.string(lib.PsychroGetStatusMessage(status)) for status in range(12)}
+    assert len(messages) == 12
@@ -0,0 +1,141 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the memoization cache of the C library in SI units.
+
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+@pytest.fixture
+def cache(psycmodule):
+    ffi, lib = psycmodule.ffi, psycmodule.lib
+    def create(Capacity = 1000, Eviction = None, TemperatureResolution = 0.1, HumidityResolution = 0.001,
+               PressureResolution = 1.):
+        config = ffi.new("struct PsychroCacheConfig *")
+        config.Capacity = Capacity
+        config.Eviction = lib.PSYCHRO_CACHE_LRU if Eviction is None else Eviction
+        config.TemperatureResolution = TemperatureResolution
+        config.HumidityResolution = HumidityResolution
+        config.PressureResolution = PressureResolution
+        return ffi.gc(lib.PsychroCacheCreate(config), lib.PsychroCacheDestroy)
+    return create
+
+def stats(psycmodule, cache):
+    out = psycmodule.ffi.new("struct PsychroCacheStats *")
+    psycmodule.lib.PsychroCacheGetStats(cache, out)
+    return out
+
+def cached_from_relhum(psycmodule, cache, TDryBulb, RelHum, Pressure):
+    out = [psycmodule.ffi.new("double *") for _ in range(7)]
+    psycmodule.lib.CachedCalcPsychrometricsFromRelHum(cache, TDryBulb, RelHum, Pressure, *out)
+    return tuple(o[0] for o in out)
+
+def test_CachedCalcPsychrometricsFromRelHum(psycmodule, cache):
+    ffi, lib = psycmodule.ffi, psycmodule.lib
+    expected = [ffi.new("double *") for _ in range(7)]
+    lib.CalcPsychrometricsFromRelHum(25.0, 0.5, 101325., *expected)
+    c = cache()
+    first = cached_from_relhum(psycmodule, c, 25.0, 0.5, 101325.)
+    second = cached_from_relhum(psycmodule, c, 25.0, 0.5, 101325.)
+    assert first == second
+    assert list(first) == [e[0] for e in expected]
+    s = stats(psycmodule, c)
+    assert (s.Hits, s.Misses, s.Size, s.Capacity) == (1, 1, 1, 1000)
+    assert s.HitRate == 0.5
+
+def test_CachedCalcPsychrometricsFromTWetBulbAndTDewPoint(psycmodule, cache):
+    ffi, lib = psycmodule.ffi, psycmodule.lib
+    c = cache()
+    for cached, direct, x in [(lib.CachedCalcPsychrometricsFromTWetBulb, lib.CalcPsychrometricsFromTWetBulb, 20.),
+                              (lib.CachedCalcPsychrometricsFromTDewPoint, lib.CalcPsychrometricsFromTDewPoint, 15.)]:
+        expected = [ffi.new("double *") for _ in range(7)]
+        direct(30.0, x, 101325., *expected)
+        for _ in range(2):
+            out = [ffi.new("double *") for _ in range(7)]
+            cached(c, 30.0, x, 101325., *out)
+            assert [o[0] for o in out] == [e[0] for e in expected]
+    s = stats(psycmodule, c)
+    assert (s.Hits, s.Misses) == (2, 2)
+
+# Inputs that round to the same multiple of the resolutions share an entry, whose values are
+# calculated with the rounded inputs so that they do not depend on the order of the calls
+def test_Quantization(psycmodule, cache):
+    c = cache()
+    rounded = cached_from_relhum(psycmodule, c, 25.0, 0.5, 101325.)
+    assert cached_from_relhum(psycmodule, c, 25.04, 0.5004, 101325.3) == rounded
+    assert cached_from_relhum(psycmodule, c, 25.06, 0.5, 101325.) != rounded
+    s = stats(psycmodule, c)
+    assert (s.Hits, s.Misses) == (1, 2)
+
+def test_ExactKeys(psycmodule, cache):
+    c = cache(TemperatureResolution = 0., HumidityResolution = 0., PressureResolution = 0.)
+    cached_from_relhum(psycmodule, c, 25.0, 0.5, 101325.)
+    cached_from_relhum(psycmodule, c, 25.0 + 1e-12, 0.5, 101325.)
+    assert stats(psycmodule, c).Misses == 2
+
+# Inputs too large for their resolution are calculated without the cache
+def test_UnquantizableInputs(psycmodule, cache):
+    ffi, lib = psycmodule.ffi, psycmodule.lib
+    expected = [ffi.new("double *") for _ in range(7)]
+    lib.CalcPsychrometricsFromRelHum(25.0, 0.5, 101325., *expected)
+    c = cache(TemperatureResolution = 1e-20)
+    for _ in range(2):
+        assert list(cached_from_relhum(psycmodule, c, 25.0, 0.5, 101325.)) == [e[0] for e in expected]
+    s = stats(psycmodule, c)
+    assert (s.Hits, s.Misses, s.Size) == (0, 0, 0)
+
+def test_UnitSystemIsPartOfKey(psycmodule, cache):
+    lib = psycmodule.lib
+    c = cache()
+    si = cached_from_relhum(psycmodule, c, 25.0, 0.5, 101325.)
+    lib.SetUnitSystem(lib.IP)
+    try:
+        ip = cached_from_relhum(psycmodule, c, 25.0, 0.5, 101325.)
+    finally:
+        lib.SetUnitSystem(lib.SI)
+    assert si != ip
+    assert stats(psycmodule, c).Misses == 2
+
+@pytest.mark.parametrize("eviction", ["PSYCHRO_CACHE_LRU", "PSYCHRO_CACHE_FIFO"])
+def test_Eviction(psycmodule, cache, eviction):
+    c = cache(Capacity = 2, Eviction = getattr(psycmodule.lib, eviction))
+    cached_from_relhum(psycmodule, c, 20.0, 0.5, 101325.)
+    cached_from_relhum(psycmodule, c, 21.0, 0.5, 101325.)
+    cached_from_relhum(psycmodule, c, 20.0, 0.5, 101325.)
+    # Evicts 21 with LRU (least recently used), 20 with FIFO (oldest)
+    cached_from_relhum(psycmodule, c, 22.0, 0.5, 101325.)
+    psycmodule.lib.PsychroCacheResetStats(c)
+    cached_from_relhum(psycmodule, c, 20.0, 0.5, 101325.)
+    s = stats(psycmodule, c)
+    assert s.Size == 2
+    assert s.Hits == (1 if eviction == "PSYCHRO_CACHE_LRU" else 0)
+
+def test_Bounded(psycmodule, cache):
+    c = cache(Capacity = 500)
+    for T in np.arange(0, 200, 0.1):
+        cached_from_relhum(psycmodule, c, T / 5, 0.5, 101325.)
+    s = stats(psycmodule, c)
+    assert s.Size <= 500
+    assert s.Evictions == s.Misses - s.Size
+    psycmodule.lib.PsychroCacheClear(c)
+    assert stats(psycmodule, c).Size == 0
+
+def test_InvalidConfig(psycmodule, cache):
+    assert cache(Capacity = 0) == psycmodule.ffi.NULL
+    assert cache(TemperatureResolution = -0.1) == psycmodule.ffi.NULL
+
+# cffi releases the GIL during the calls, so that the threads use the cache concurrently
+def test_Concurrency(psycmodule, cache):
+    c = cache(Capacity = 200)
+    inputs = [(20.0 + 0.1 * (i % 300), 0.5, 101325.) for i in range(6000)]
+    expected = {x: cached_from_relhum(psycmodule, cache(), *x) for x in set(inputs)}
+    with ThreadPoolExecutor(max_workers = 8) as executor:
+        results = list(executor.map(lambda x: cached_from_relhum(psycmodule, c, *x), inputs))
+    assert results == [expected[x] for x in inputs]
+    s = stats(psycmodule, c)
+    assert s.Hits + s.Misses == len(inputs)
+    assert s.Size <= 200
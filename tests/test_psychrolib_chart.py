@@ -0,0 +1,172 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the chart geometry of the C library, in SI and IP units: isolines within the tolerance
+# and below saturation, clipping to the viewport, reuse of the cached tiles on pan and zoom,
+# invalidation by the pressure and the system of units, eviction and invalid inputs.
+
+import math
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+TOLERANCE = 1e-3
+
+# Viewport, pressure and values of each family of isolines
+CHARTS = {'SI': ((-10., 50., 0., 0.03), 101325.,
+                 ([0.2, 0.5, 1.], [10., 20.], [30000., 60000.], [0.82, 0.86], [5., 15.])),
+          'IP': ((14., 122., 0., 0.03), 14.696,
+                 ([0.2, 0.5, 1.], [50., 68.], [15., 25.], [13., 14.], [41., 59.]))}
+
+FAMILIES = ['PSYCHRO_CHART_REL_HUM', 'PSYCHRO_CHART_TWET_BULB', 'PSYCHRO_CHART_MOIST_AIR_ENTHALPY',
+            'PSYCHRO_CHART_MOIST_AIR_VOLUME', 'PSYCHRO_CHART_TDEW_POINT']
+
+@pytest.fixture
+def chart(psycmodule):
+    chart = psycmodule.lib.PsychroChartCreate(TOLERANCE, 0)
+    yield chart
+    psycmodule.lib.PsychroChartDestroy(chart)
+
+def build(psycmodule, chart, pressure, viewport, values):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    lines = ffi.new('struct PsychroChartLines *')
+    arrays = [ffi.new('double[]', v) for v in values]
+    for family, array in enumerate(arrays):
+        lines.Values[family] = array
+        lines.Counts[family] = len(values[family])
+    geometry = ffi.new('struct PsychroChartGeometry *')
+    status = lib.PsychroChartBuild(chart, pressure, ffi.new('struct PsychroChartViewport *', viewport), lines, geometry)
+    if status != 0:
+        return status, None, []
+    points = np.frombuffer(ffi.buffer(geometry.Points, 8 * geometry.NPoints), dtype = np.float32).reshape(-1, 2)
+    polylines = [(p.Family, p.Line, points[p.First:p.First + p.Count].astype(float))
+                 for p in geometry.Polylines[0:geometry.NPolylines]]
+    return status, geometry, polylines
+
+def HumRatio(lib, family, value, T, pressure):
+    if family == lib.PSYCHRO_CHART_REL_HUM:
+        return lib.GetHumRatioFromRelHum(T, value, pressure)
+    if family == lib.PSYCHRO_CHART_TWET_BULB:
+        return lib.GetHumRatioFromTWetBulb(max(T, value), value, pressure)
+    if family == lib.PSYCHRO_CHART_MOIST_AIR_ENTHALPY:
+        return lib.GetHumRatioFromEnthalpyAndTDryBulb(value, T)
+    if family == lib.PSYCHRO_CHART_MOIST_AIR_VOLUME:
+        v0 = lib.GetMoistAirVolume(T, 0., pressure)
+        return (value - v0) / (lib.GetMoistAirVolume(T, 1., pressure) - v0)
+    return lib.GetHumRatioFromTDewPoint(value, pressure)
+
+def test_Isolines(psycmodule, chart, units):
+    lib = psycmodule.lib
+    viewport, pressure, values = CHARTS[units]
+    status, geometry, polylines = build(psycmodule, chart, pressure, viewport, values)
+    assert status == 0
+    assert geometry.TilesReused == 0 and geometry.TilesComputed > 0
+    assert sorted({(family, line) for family, line, _ in polylines}) == \
+        [(family, line) for family in range(len(FAMILIES)) for line in range(len(values[family]))]
+    scale = 2. ** math.ceil(math.log2(viewport[3] - viewport[2]))
+    for family, line, points in polylines:
+        value = values[family][line]
+        assert len(points) >= 2
+        assert np.all(np.diff(points[:, 0]) >= 0.)
+        assert np.all(points[:, 0] >= viewport[0] - 1e-4) and np.all(points[:, 0] <= viewport[1] + 1e-4)
+        assert np.all(points[:, 1] >= viewport[2] - 1e-6) and np.all(points[:, 1] <= viewport[3] + 1e-6)
+        # Points and middles of the segments on the isoline and below saturation
+        middles = 0.5 * (points[1:] + points[:-1])
+        for T, W in np.concatenate([points, middles]):
+            assert abs(W - HumRatio(lib, family, value, T, pressure)) <= 2. * TOLERANCE * scale + 1e-6
+            assert W <= lib.GetSatHumRatio(T, pressure) + 2. * TOLERANCE * scale + 1e-6
+
+def test_Saturation(psycmodule, chart, units):
+    lib = psycmodule.lib
+    viewport, pressure, values = CHARTS[units]
+    _, _, polylines = build(psycmodule, chart, pressure, viewport, values)
+    saturation = [points for family, line, points in polylines
+                  if family == lib.PSYCHRO_CHART_REL_HUM and values[family][line] == 1.]
+    assert len(saturation) == 1
+    # Sampled points on the curve, and the ends clipped to the viewport on chords
+    scale = 2. ** math.ceil(math.log2(viewport[3] - viewport[2]))
+    for T, W in saturation[0][1:-1]:
+        assert W == pytest.approx(lib.GetSatHumRatio(T, pressure), rel = 1e-5, abs = 1e-6)
+    for T, W in saturation[0][[0, -1]]:
+        assert abs(W - lib.GetSatHumRatio(T, pressure)) <= 2. * TOLERANCE * scale
+    assert saturation[0][-1][1] == pytest.approx(viewport[3], abs = 1e-6)
+
+def test_PanAndZoom(psycmodule, chart, units):
+    viewport, pressure, values = CHARTS[units]
+    _, first, _ = build(psycmodule, chart, pressure, viewport, values)
+    first = first.Evaluations
+    span = viewport[1] - viewport[0]
+    panned = (viewport[0] + 0.1 * span, viewport[1] + 0.1 * span, viewport[2], viewport[3])
+    status, geometry, polylines = build(psycmodule, chart, pressure, panned, values)
+    assert status == 0
+    assert geometry.TilesReused > geometry.TilesComputed > 0
+    assert geometry.Evaluations < first / 2
+
+    # Same geometry as a chart without the cached tiles
+    other = psycmodule.lib.PsychroChartCreate(TOLERANCE, 0)
+    try:
+        _, _, expected = build(psycmodule, other, pressure, panned, values)
+    finally:
+        psycmodule.lib.PsychroChartDestroy(other)
+    assert len(polylines) == len(expected)
+    for a, b in zip(polylines, expected):
+        assert a[:2] == b[:2] and np.array_equal(a[2], b[2])
+
+    # Zoomed in then back out to the first span
+    zoomed = (viewport[0] + 0.25 * span, viewport[1] - 0.25 * span, viewport[2], 0.5 * viewport[3])
+    _, geometry, _ = build(psycmodule, chart, pressure, zoomed, values)
+    assert geometry.TilesComputed > 0
+    _, geometry, _ = build(psycmodule, chart, pressure, viewport, values)
+    assert geometry.TilesComputed == 0 and geometry.TilesReused > 0
+
+def test_Invalidation(psycmodule, chart):
+    lib = psycmodule.lib
+    viewport, pressure, values = CHARTS['SI']
+    build(psycmodule, chart, pressure, viewport, values)
+    _, geometry, _ = build(psycmodule, chart, 0.9 * pressure, viewport, values)
+    assert geometry.TilesReused == 0 and geometry.TilesComputed > 0
+    lib.SetUnitSystem(lib.IP)
+    _, geometry, _ = build(psycmodule, chart, 0.9 * pressure / 6894.76, viewport, ([0.5], [], [], [], []))
+    assert geometry.TilesReused == 0 and geometry.TilesComputed > 0
+
+def test_Eviction(psycmodule, units):
+    lib = psycmodule.lib
+    viewport, pressure, values = CHARTS[units]
+    small = lib.PsychroChartCreate(TOLERANCE, 4)
+    large = lib.PsychroChartCreate(TOLERANCE, 0)
+    try:
+        for k in range(3):
+            _, _, a = build(psycmodule, small, pressure, viewport, values)
+            _, _, b = build(psycmodule, large, pressure, viewport, values)
+            assert len(a) == len(b)
+            for x, y in zip(a, b):
+                assert x[:2] == y[:2] and np.array_equal(x[2], y[2])
+    finally:
+        lib.PsychroChartDestroy(small)
+        lib.PsychroChartDestroy(large)
+
+def test_Adaptive(psycmodule, chart, units):
+    lib = psycmodule.lib
+    viewport, pressure, values = CHARTS[units]
+    _, _, polylines = build(psycmodule, chart, pressure, viewport, values)
+    count = lambda family: max(len(points) for f, _, points in polylines if f == family)
+    assert count(lib.PSYCHRO_CHART_TDEW_POINT) <= 40
+    assert count(lib.PSYCHRO_CHART_REL_HUM) > count(lib.PSYCHRO_CHART_TDEW_POINT)
+
+def test_Outside(psycmodule, chart):
+    viewport, pressure, _ = CHARTS['SI']
+    # Wet-bulb temperature above the boiling point, enthalpy of dry air below the viewport
+    status, geometry, polylines = build(psycmodule, chart, pressure, viewport, ([], [150.], [-50000.], [], []))
+    assert status == 0 and polylines == []
+
+def test_Invalid(psycmodule, chart):
+    viewport, pressure, values = CHARTS['SI']
+    assert build(psycmodule, chart, pressure, viewport, ([0.], [], [], [], []))[0] == -1
+    assert build(psycmodule, chart, pressure, viewport, ([1.5], [], [], [], []))[0] == -1
+    assert build(psycmodule, chart, pressure, viewport, ([], [float('nan')], [], [], []))[0] == -1
+    assert build(psycmodule, chart, 0., viewport, values)[0] == -1
+    assert build(psycmodule, chart, pressure, (50., -10., 0., 0.03), values)[0] == -1
+    assert build(psycmodule, chart, pressure, (-10., 50., 0.03, 0.03), values)[0] == -1
+    assert psycmodule.lib.PsychroChartCreate(-1., 0) == psycmodule.ffi.NULL
@@ -0,0 +1,169 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the climate statistics of the C library, in SI and IP units: quantiles against the
+# sorted properties, bin-hour histogram, merge of shards, threads and invalid records.
+
+import math
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+N = 10000
+
+def default_config(psycmodule):
+    c = psycmodule.ffi.new('struct PsychroClimateConfig *')
+    psycmodule.lib.PsychroClimateGetDefaultConfig(c)
+    return c
+
+def records(units, n = N, seed = 38):
+    # Hourly records of a temperate climate
+    rng = np.random.default_rng(seed)
+    T = rng.normal(12., 9., n)
+    Tdew = T - rng.exponential(6., n)
+    P = rng.normal(100000., 800., n)
+    if units == 'IP':
+        T, Tdew, P = T * 1.8 + 32., Tdew * 1.8 + 32., P / 6894.757
+    return list(T), list(Tdew), list(P)
+
+def properties(psycmodule, T, Tdew, P):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    out = ffi.new('double[7]')
+    values = {k: [] for k in ['TDryBulb', 'TWetBulb', 'TDewPoint', 'HumRatio', 'MoistAirEnthalpy']}
+    for i in range(len(T)):
+        lib.CalcPsychrometricsFromTDewPoint(T[i], Tdew[i], P[i], *[out + k for k in range(7)])
+        for name, value in zip(values, [T[i], out[1], Tdew[i], out[0], out[4]]):
+            values[name].append(value)
+    return [np.array(v) for v in values.values()]
+
+def histogram(psycmodule, stats, config):
+    ffi = psycmodule.ffi
+    out_of_range = ffi.new('uint64_t *')
+    h = psycmodule.lib.PsychroClimateGetHistogram(stats, out_of_range)
+    counts = np.array(ffi.unpack(h, config.TDryBulb.Count * config.HumRatio.Count))
+    return counts.reshape(config.TDryBulb.Count, config.HumRatio.Count), out_of_range[0]
+
+def test_PsychroClimateQuantiles(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    config = default_config(psycmodule)
+    stats = lib.PsychroClimateCreate(config)
+    T, Tdew, P = records(units)
+    assert lib.PsychroClimateAdd(stats, N, T, Tdew, P, 1) == 0
+    assert lib.PsychroClimateGetCount(stats) == N
+    for k, values in enumerate(properties(psycmodule, T, Tdew, P)):
+        axis = config.Quantiles[k]
+        width = (axis.Max - axis.Min) / axis.Count
+        assert lib.PsychroClimateGetQuantile(stats, k, 0.) == values.min()
+        assert lib.PsychroClimateGetQuantile(stats, k, 1.) == values.max()
+        for p in [0.004, 0.01, 0.02, 0.5, 0.98, 0.99, 0.996]:
+            # Between the sorted values around the rank, to within the width of the bins
+            low, high = np.quantile(values, p, method = 'lower'), np.quantile(values, p, method = 'higher')
+            q = lib.PsychroClimateGetQuantile(stats, k, p)
+            assert low - width <= q <= high + width
+    lib.PsychroClimateDestroy(stats)
+
+def test_PsychroClimateHistogram(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    config = default_config(psycmodule)
+    stats = lib.PsychroClimateCreate(config)
+    T, Tdew, P = records(units)
+    lib.PsychroClimateAdd(stats, N, T, Tdew, P, 1)
+    counts, out_of_range = histogram(psycmodule, stats, config)
+    TDryBulb, _, _, HumRatio, _ = properties(psycmodule, T, Tdew, P)
+    expected, _, _ = np.histogram2d(TDryBulb, HumRatio,
+        bins = [config.TDryBulb.Count, config.HumRatio.Count],
+        range = [[config.TDryBulb.Min, config.TDryBulb.Max], [config.HumRatio.Min, config.HumRatio.Max]])
+    # Records on the edges of the bins may fall on either side
+    assert np.abs(counts - expected).sum() <= 2
+    assert counts.sum() + out_of_range == N
+    assert out_of_range == N - expected.sum()
+    lib.PsychroClimateDestroy(stats)
+
+def test_PsychroClimateMergeShards(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    config = default_config(psycmodule)
+    T, Tdew, P = records(units)
+    whole = lib.PsychroClimateCreate(config)
+    lib.PsychroClimateAdd(whole, N, T, Tdew, P, 1)
+    # Shards of uneven sizes, merged in reverse order
+    bounds = [0, 1234, 1235, 6000, N]
+    shards = []
+    for first, last in zip(bounds[:-1], bounds[1:]):
+        shards.append(lib.PsychroClimateCreate(config))
+        lib.PsychroClimateAdd(shards[-1], last - first, T[first:last], Tdew[first:last], P[first:last], 1)
+    merged = lib.PsychroClimateCreate(config)
+    for shard in reversed(shards):
+        assert lib.PsychroClimateMerge(merged, shard) == 0
+        lib.PsychroClimateDestroy(shard)
+    assert lib.PsychroClimateGetCount(merged) == N
+    for k in range(lib.PSYCHRO_CLIMATE_N_VARIABLES):
+        for p in [0., 0.004, 0.5, 0.996, 1.]:
+            assert lib.PsychroClimateGetQuantile(merged, k, p) == lib.PsychroClimateGetQuantile(whole, k, p)
+    assert (histogram(psycmodule, merged, config)[0] == histogram(psycmodule, whole, config)[0]).all()
+
+    # Statistics with other bins cannot be merged
+    config.HumRatio.Count += 1
+    other = lib.PsychroClimateCreate(config)
+    assert lib.PsychroClimateMerge(merged, other) == -1
+    assert lib.PsychroClimateGetCount(merged) == N
+    for stats in [whole, merged, other]:
+        lib.PsychroClimateDestroy(stats)
+
+@pytest.mark.parametrize('threads', [2, 4])
+def test_PsychroClimateThreads(psycmodule, threads):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    config = default_config(psycmodule)
+    T, Tdew, P = records('SI', 30000, seed = 39)
+    T[100] = float('nan')
+    serial, parallel = lib.PsychroClimateCreate(config), lib.PsychroClimateCreate(config)
+    assert lib.PsychroClimateAdd(serial, 30000, T, Tdew, P, 1) == 1
+    assert lib.PsychroClimateAdd(parallel, 30000, T, Tdew, P, threads) == 1
+    assert lib.PsychroClimateGetCount(parallel) == lib.PsychroClimateGetCount(serial) == 29999
+    for k in range(lib.PSYCHRO_CLIMATE_N_VARIABLES):
+        for p in [0., 0.01, 0.5, 0.99, 1.]:
+            assert lib.PsychroClimateGetQuantile(parallel, k, p) == lib.PsychroClimateGetQuantile(serial, k, p)
+    assert (histogram(psycmodule, parallel, config)[0] == histogram(psycmodule, serial, config)[0]).all()
+    lib.PsychroClimateDestroy(serial)
+    lib.PsychroClimateDestroy(parallel)
+
+def test_PsychroClimateInvalidRecords(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    stats = lib.PsychroClimateCreate(default_config(psycmodule))
+    nan = float('nan')
+    T = [20., nan, 20., 20., 250., 20., 20., 120.]
+    Tdew = [10., 10., nan, 25., 10., 10., 10., 110.]
+    P = [101325., 101325., 101325., 101325., 101325., -1., nan, 101325.]
+    assert lib.PsychroClimateAdd(stats, 8, T, Tdew, P, 1) == 7
+    assert lib.PsychroClimateGetCount(stats) == 1
+    assert lib.PsychroClimateGetInvalidCount(stats) == 7
+    lib.PsychroClimateDestroy(stats)
+
+def test_PsychroClimateOutsideBins(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    config = default_config(psycmodule)
+    stats = lib.PsychroClimateCreate(config)
+    assert math.isnan(lib.PsychroClimateGetQuantile(stats, lib.PSYCHRO_CLIMATE_TDRY_BULB, 0.5))
+    # Half of the records above the bins of dry-bulb temperature
+    T, Tdew, P = [20.] * 5 + [80.] * 5, [10.] * 10, [101325.] * 10
+    lib.PsychroClimateAdd(stats, 10, T, Tdew, P, 1)
+    assert lib.PsychroClimateGetQuantile(stats, lib.PSYCHRO_CLIMATE_TDRY_BULB, 0.4) == pytest.approx(20., abs = 0.01)
+    assert math.isnan(lib.PsychroClimateGetQuantile(stats, lib.PSYCHRO_CLIMATE_TDRY_BULB, 0.6))
+    assert lib.PsychroClimateGetQuantile(stats, lib.PSYCHRO_CLIMATE_TDRY_BULB, 1.) == 80.
+    assert lib.PsychroClimateGetQuantile(stats, lib.PSYCHRO_CLIMATE_TDEW_POINT, 0.6) == pytest.approx(10., abs = 0.01)
+    assert math.isnan(lib.PsychroClimateGetQuantile(stats, lib.PSYCHRO_CLIMATE_TDRY_BULB, 1.5))
+    assert math.isnan(lib.PsychroClimateGetQuantile(stats, lib.PSYCHRO_CLIMATE_N_VARIABLES, 0.5))
+    assert histogram(psycmodule, stats, config)[1] == 5
+    lib.PsychroClimateDestroy(stats)
+
+def test_PsychroClimateCreateInvalidConfig(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    for field, value in [('Count', 0), ('Max', -100.), ('Min', float('nan'))]:
+        config = default_config(psycmodule)
+        setattr(config.Quantiles[lib.PSYCHRO_CLIMATE_HUM_RATIO], field, value)
+        assert lib.PsychroClimateCreate(config) == ffi.NULL
+        config = default_config(psycmodule)
+        setattr(config.TDryBulb, field, value)
+        assert lib.PsychroClimateCreate(config) == ffi.NULL
+    lib.PsychroClimateDestroy(ffi.NULL)
@@ -0,0 +1,190 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the gridded fields of the C library, in SI and IP units: single and double precision
+# files against the bounded functions, tiles and threads, pressure from the elevation, scales,
+# offsets and headers, missing values, invalid configurations and the memory of the tiles.
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+# Ranges of dry-bulb temperature and pressure, and of elevation
+DOMAINS = {'SI': ((-40., 90.), (60000., 105000.), (0., 3000.)),
+           'IP': ((-40., 194.), (8.7, 15.2), (0., 10000.))}
+
+OUTPUTS = ['PSYCHRO_FIELD_TWET_BULB', 'PSYCHRO_FIELD_REL_HUM', 'PSYCHRO_FIELD_HUM_RATIO', 'PSYCHRO_FIELD_VAP_PRES',
+           'PSYCHRO_FIELD_MOIST_AIR_ENTHALPY', 'PSYCHRO_FIELD_MOIST_AIR_VOLUME']
+
+def fields(units, n, seed = 45):
+    rng = np.random.default_rng(seed)
+    (TLow, THigh), (PLow, PHigh), _ = DOMAINS[units]
+    T = rng.uniform(TLow, THigh, n)
+    return T, T - rng.uniform(0., 30., n), rng.uniform(PLow, PHigh, n)
+
+class Config:
+    def __init__(self, psycmodule, tmp_path, n):
+        self.lib, self.ffi, self.tmp_path = psycmodule.lib, psycmodule.ffi, tmp_path
+        self.config = self.ffi.new('struct PsychroFieldConfig *')
+        self.config.NPoints = n
+        self.keep = []
+
+    def file(self, field, name, dtype, values = None, start = 0, scale = 0., offset = 0.):
+        path = str(self.tmp_path / name)
+        if values is not None:
+            with open(path, 'wb') as f:
+                f.write(b'\x7f' * start)
+                f.write(np.asarray(values).astype(dtype).tobytes())
+        self.keep.append(self.ffi.new('char[]', path.encode()))
+        field.Path = self.keep[-1]
+        field.Type = self.lib.PSYCHRO_FIELD_FLOAT32 if dtype == '<f4' else self.lib.PSYCHRO_FIELD_FLOAT64
+        field.Start, field.Scale, field.Offset = start, scale, offset
+        return path
+
+    def input(self, name, values, dtype = '<f8', **kwargs):
+        return self.file(self.config.Inputs[getattr(self.lib, 'PSYCHRO_FIELD_' + name)], name, dtype, values, **kwargs)
+
+    def outputs(self, dtype = '<f8', **kwargs):
+        return {name: self.file(self.config.Outputs[getattr(self.lib, name)], name, dtype, **kwargs) for name in OUTPUTS}
+
+    def process(self):
+        report = self.ffi.new('struct PsychroFieldReport *')
+        return self.lib.PsychroFieldProcess(self.config, report), report
+
+def expected(psycmodule, T, TDewPoint, P):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    out = {name: np.full(len(T), np.nan) for name in OUTPUTS}
+    p = [ffi.new('double *') for _ in range(7)]
+    for i in range(len(T)):
+        if lib.BoundedCalcPsychrometricsFromTDewPoint(T[i], min(TDewPoint[i], T[i]), P[i], *p) == lib.PSYCHRO_STATUS_OK:
+            HumRatio, TWetBulb, RelHum, VapPres, h, v, _ = (x[0] for x in p)
+            for name, value in zip(OUTPUTS, (TWetBulb, RelHum, HumRatio, VapPres, h, v)):
+                out[name][i] = value
+    return out
+
+@pytest.mark.parametrize('dtype', ['<f4', '<f8'])
+@pytest.mark.parametrize('threads', [1, 3])
+def test_Fields(psycmodule, tmp_path, units, dtype, threads):
+    n = 2500
+    T, TDewPoint, P = fields(units, n)
+    c = Config(psycmodule, tmp_path, n)
+    c.input('TDRY_BULB', T, dtype)
+    c.input('TDEW_POINT', TDewPoint, dtype)
+    c.input('PRESSURE', P, dtype)
+    paths = c.outputs(dtype)
+    c.config.TileSize = 1000
+    c.config.Threads = threads
+    status, report = c.process()
+    assert status == 0
+    assert (report.Points, report.Invalid, report.Tiles) == (n, 0, 3)
+    rounded = [x.astype(dtype).astype(float) for x in (T, TDewPoint, P)]
+    reference = expected(psycmodule, *rounded)
+    for name, path in paths.items():
+        assert np.array_equal(np.fromfile(path, dtype = dtype), reference[name].astype(dtype))
+
+def test_Elevation(psycmodule, tmp_path, units):
+    lib = psycmodule.lib
+    nGrid, nTimes = 40, 30
+    T, TDewPoint, P = fields(units, nGrid * nTimes)
+    elevation = np.random.default_rng(46).uniform(*DOMAINS[units][2], nGrid)
+    z = np.tile(elevation.astype('<f4').astype(float), nTimes)
+    SeaLevel = P + 0.5 * (DOMAINS[units][1][1] - P)
+
+    # Sea level pressure and elevation, elevation only, constant pressure
+    for case in ('SeaLevel', 'Elevation', 'Constant'):
+        c = Config(psycmodule, tmp_path, len(T))
+        c.config.NGrid = nGrid
+        c.config.TileSize = 64
+        c.input('TDRY_BULB', T)
+        c.input('TDEW_POINT', TDewPoint)
+        if case == 'SeaLevel':
+            c.input('PRESSURE', SeaLevel)
+            reference = [lib.GetStationPressure(p, h, t) for p, h, t in zip(SeaLevel, z, T)]
+        if case == 'Elevation':
+            reference = [lib.GetStandardAtmPressure(h) for h in z]
+        if case == 'Constant':
+            c.config.Pressure = P[0]
+            reference = [P[0]] * len(T)
+        else:
+            c.input('ELEVATION', elevation, '<f4')
+        paths = c.outputs()
+        status, _ = c.process()
+        assert status == 0
+        ref = expected(psycmodule, T, TDewPoint, np.array(reference))
+        for name, path in paths.items():
+            assert np.array_equal(np.fromfile(path), ref[name], equal_nan = True)
+
+def test_ScaleOffsetStart(psycmodule, tmp_path):
+    n = 300
+    T, TDewPoint, P = fields('SI', n)
+    c = Config(psycmodule, tmp_path, n)
+    c.input('TDRY_BULB', T + 273.15, start = 24, offset = -273.15)
+    c.input('TDEW_POINT', TDewPoint + 273.15, offset = -273.15)
+    c.input('PRESSURE', P / 100., '<f8', start = 8, scale = 100.)
+    path = c.file(c.config.Outputs[c.lib.PSYCHRO_FIELD_REL_HUM], 'rh', '<f8', start = 16, scale = 0.01)
+    status, _ = c.process()
+    assert status == 0
+    data = open(path, 'rb').read()
+    assert len(data) == 16 + 8 * n and data[:16] == bytes(16)
+    reference = expected(psycmodule, T + 273.15 - 273.15, TDewPoint + 273.15 - 273.15, P / 100. * 100.)
+    assert np.allclose(np.frombuffer(data[16:]), reference['PSYCHRO_FIELD_REL_HUM'] / 0.01, rtol = 1e-12)
+
+def test_MissingValues(psycmodule, tmp_path):
+    T, TDewPoint, P = np.array([20., np.nan, 25., 20., 30.]), np.array([10., 10., np.nan, 21., 10.]), \
+        np.array([101325., 101325., 101325., 101325., -5.])
+    c = Config(psycmodule, tmp_path, len(T))
+    c.input('TDRY_BULB', T)
+    c.input('TDEW_POINT', TDewPoint)
+    c.input('PRESSURE', P)
+    paths = c.outputs()
+    status, report = c.process()
+    assert status == 0 and report.Invalid == 3
+    RelHum = np.fromfile(paths['PSYCHRO_FIELD_REL_HUM'])
+    assert not np.isnan(RelHum[0]) and np.all(np.isnan(RelHum[[1, 2, 4]]))
+    # Dew point above the dry bulb temperature clipped to it
+    assert RelHum[3] == pytest.approx(1.)
+
+def test_Invalid(psycmodule, tmp_path):
+    T, TDewPoint, P = fields('SI', 100)
+
+    def config(n = 100):
+        c = Config(psycmodule, tmp_path, n)
+        c.input('TDRY_BULB', T)
+        c.input('TDEW_POINT', TDewPoint)
+        c.input('PRESSURE', P)
+        c.outputs()
+        return c
+
+    c = config(200)                     # Input files shorter than the fields
+    assert c.process()[0] == -1
+    c = config()
+    c.config.Inputs[c.lib.PSYCHRO_FIELD_TDEW_POINT].Type = c.lib.PSYCHRO_FIELD_NONE
+    assert c.process()[0] == -1
+    c = config()
+    c.config.Inputs[c.lib.PSYCHRO_FIELD_TDRY_BULB].Path = c.ffi.new('char[]', str(tmp_path / 'missing').encode())
+    assert c.process()[0] == -1
+    c = config()
+    c.input('ELEVATION', np.zeros(30))
+    c.config.NGrid = 30
+    assert c.process()[0] == -1
+    c = config()
+    c.config.Inputs[c.lib.PSYCHRO_FIELD_PRESSURE].Type = c.lib.PSYCHRO_FIELD_NONE
+    assert c.process()[0] == -1
+    assert config().process()[0] == 0
+
+def test_Memory(psycmodule, tmp_path):
+    memory = []
+    for n in (10000, 100000):
+        T, TDewPoint, P = fields('SI', n)
+        c = Config(psycmodule, tmp_path, n)
+        c.input('TDRY_BULB', T, '<f4')
+        c.input('TDEW_POINT', TDewPoint, '<f4')
+        c.config.Pressure = 101325.
+        c.file(c.config.Outputs[c.lib.PSYCHRO_FIELD_TWET_BULB], 'tw', '<f4')
+        c.config.TileSize = 1024
+        c.config.Threads = 2
+        status, report = c.process()
+        assert status == 0 and report.Points == n
+        memory.append(report.Memory)
+    assert memory[0] == memory[1] < 2 * (10 * 8 * 1024 + 3 * (4 * 1024 + 4096))
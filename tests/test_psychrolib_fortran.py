@@ -0,0 +1,168 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the array routines of the Fortran library in SI units.
+# The array routines call the elemental routines, which also implement the scalar functions.
+
+import importlib.util
+import shutil
+import subprocess
+import sys
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+INVALID = -99999.
+
+def as_real(values):
+    return np.asarray(values, dtype=np.float32)
+
+# Large enough to go through the OpenMP loop when the library is compiled with OpenMP
+N = 5000
+TDryBulb = as_real(np.linspace(-20, 45, N))
+Pressure = as_real(np.full(N, 101325))
+
+def test_CalcPsychrometricsFromRelHumArray(psyfortran):
+    RelHum = as_real(np.linspace(0.05, 1, N))
+    *outputs, Status = psyfortran.CalcPsychrometricsFromRelHumArray(TDryBulb, RelHum, Pressure)
+    assert np.all(Status == psyfortran.STATUS_OK)
+    for i in range(0, N, 97):
+        expected = psyfortran.CalcPsychrometricsFromRelHum(TDryBulb[i], RelHum[i], Pressure[i])
+        assert [output[i] for output in outputs] == pytest.approx(expected, rel = 1e-6)
+
+def test_CalcPsychrometricsFromTWetBulbArray(psyfortran):
+    TWetBulb = as_real(TDryBulb - np.linspace(0, 8, N))
+    *outputs, Status = psyfortran.CalcPsychrometricsFromTWetBulbArray(TDryBulb, TWetBulb, Pressure)
+    assert np.all(Status == psyfortran.STATUS_OK)
+    for i in range(0, N, 97):
+        expected = psyfortran.CalcPsychrometricsFromTWetBulb(TDryBulb[i], TWetBulb[i], Pressure[i])
+        assert [output[i] for output in outputs] == pytest.approx(expected, rel = 1e-6)
+
+def test_CalcPsychrometricsFromTDewPointArray(psyfortran):
+    TDewPoint = as_real(TDryBulb - np.linspace(0, 15, N))
+    *outputs, Status = psyfortran.CalcPsychrometricsFromTDewPointArray(TDryBulb, TDewPoint, Pressure)
+    assert np.all(Status == psyfortran.STATUS_OK)
+    for i in range(0, N, 97):
+        expected = psyfortran.CalcPsychrometricsFromTDewPoint(TDryBulb[i], TDewPoint[i], Pressure[i])
+        assert [output[i] for output in outputs] == pytest.approx(expected, rel = 1e-6)
+
+# Invalid elements are reported through Status, the other elements are still calculated
+def test_InvalidElements(psyfortran):
+    *outputs, Status = psyfortran.CalcPsychrometricsFromRelHumArray(
+        as_real([25, 25, 250, 25]), as_real([0.5, 1.5, 0.5, -0.1]), as_real([101325] * 4))
+    assert list(Status) == [psyfortran.STATUS_OK, psyfortran.STATUS_REL_HUM_OUT_OF_RANGE,
+                            psyfortran.STATUS_TEMPERATURE_OUT_OF_RANGE, psyfortran.STATUS_REL_HUM_OUT_OF_RANGE]
+    assert outputs[0][0] == pytest.approx(psyfortran.GetHumRatioFromRelHum(25, 0.5, 101325), rel = 1e-6)
+    for output in outputs:
+        assert list(output[1:]) == [INVALID] * 3
+
+    *outputs, Status = psyfortran.CalcPsychrometricsFromTWetBulbArray(
+        as_real([25, 25]), as_real([20, 26]), as_real([101325] * 2))
+    assert list(Status) == [psyfortran.STATUS_OK, psyfortran.STATUS_WET_BULB_ABOVE_DRY_BULB]
+
+    *outputs, Status = psyfortran.CalcPsychrometricsFromTDewPointArray(
+        as_real([25, 25]), as_real([20, -150]), as_real([101325] * 2))
+    assert list(Status) == [psyfortran.STATUS_OK, psyfortran.STATUS_TEMPERATURE_OUT_OF_RANGE]
+
+def test_GetStatusMessage(psyfortran):
+    Message = psyfortran.GetStatusMessage(psyfortran.STATUS_REL_HUM_OUT_OF_RANGE)
+    assert Message.decode().strip() == "Error: relative humidity is outside range [0,1]"
+
+#########################################################
+# OpenMP build
+#########################################################
+
+PATH_TO_LIB = Path(__file__).parents[1] / 'src' / 'fortran' / 'psychrolib.f90'
+
+# Whole-array calls of the elemental routines, which f2py cannot wrap, and control of the OpenMP threads
+ELEMENTAL_CHECK = """
+module psychrolib_elemental_check
+  use psychrolib
+  !$ use omp_lib
+  implicit none
+
+  contains
+
+  subroutine SetNumThreads(n, OpenMP)
+    integer, intent(in)  :: n
+    logical, intent(out) :: OpenMP
+    OpenMP = .false.
+    !$ call omp_set_num_threads(n)
+    !$ OpenMP = .true.
+  end subroutine SetNumThreads
+
+  subroutine CalcPsychrometricsFromTWetBulbElementalArray(n, TDryBulb, TWetBulb, Pressure, Outputs, Status)
+    integer, intent(in)                 :: n
+    real, dimension(n), intent(in)      :: TDryBulb, TWetBulb, Pressure
+    real, dimension(n, 7), intent(out)  :: Outputs
+    integer, dimension(n), intent(out)  :: Status
+    call CalcPsychrometricsFromTWetBulbElemental(TDryBulb, TWetBulb, Pressure, Outputs(:, 1), Outputs(:, 2), &
+      Outputs(:, 3), Outputs(:, 4), Outputs(:, 5), Outputs(:, 6), Outputs(:, 7), Status)
+  end subroutine CalcPsychrometricsFromTWetBulbElementalArray
+
+  subroutine CalcPsychrometricsFromTDewPointElementalArray(n, TDryBulb, TDewPoint, Pressure, Outputs, Status)
+    integer, intent(in)                 :: n
+    real, dimension(n), intent(in)      :: TDryBulb, TDewPoint, Pressure
+    real, dimension(n, 7), intent(out)  :: Outputs
+    integer, dimension(n), intent(out)  :: Status
+    call CalcPsychrometricsFromTDewPointElemental(TDryBulb, TDewPoint, Pressure, Outputs(:, 1), Outputs(:, 2), &
+      Outputs(:, 3), Outputs(:, 4), Outputs(:, 5), Outputs(:, 6), Outputs(:, 7), Status)
+  end subroutine CalcPsychrometricsFromTDewPointElementalArray
+
+  subroutine CalcPsychrometricsFromRelHumElementalArray(n, TDryBulb, RelHum, Pressure, Outputs, Status)
+    integer, intent(in)                 :: n
+    real, dimension(n), intent(in)      :: TDryBulb, RelHum, Pressure
+    real, dimension(n, 7), intent(out)  :: Outputs
+    integer, dimension(n), intent(out)  :: Status
+    call CalcPsychrometricsFromRelHumElemental(TDryBulb, RelHum, Pressure, Outputs(:, 1), Outputs(:, 2), &
+      Outputs(:, 3), Outputs(:, 4), Outputs(:, 5), Outputs(:, 6), Outputs(:, 7), Status)
+  end subroutine CalcPsychrometricsFromRelHumElementalArray
+end module psychrolib_elemental_check
+"""
+
+# Above MIN_PARALLEL_ARRAY_SIZE (1024) in psychrolib.f90, with invalid elements spread over the threads
+N_OPENMP = 3 * 1024 + 1
+
+# Fortran library and the helpers above compiled with -fopenmp as a separate extension module
+@pytest.fixture(scope = 'module')
+def psyopenmp(tmp_path_factory):
+    if shutil.which('gfortran') is None:
+        pytest.skip('requires gfortran')
+    tmpdir = tmp_path_factory.mktemp('psychrolib_openmp')
+    (tmpdir / 'psychrolib_elemental_check.f90').write_text(ELEMENTAL_CHECK)
+    result = subprocess.run([sys.executable, '-m', 'numpy.f2py', '-c', '-m', 'psychrolib_openmp', '--fcompiler=gnu95',
+                             '--f90flags=-fopenmp', '-lgomp', str(PATH_TO_LIB), 'psychrolib_elemental_check.f90'],
+                            cwd = tmpdir, capture_output = True, text = True)
+    if result.returncode != 0 and 'omp' in result.stdout + result.stderr:
+        pytest.skip('requires OpenMP')
+    assert result.returncode == 0, result.stdout + result.stderr
+    spec = importlib.util.spec_from_file_location('psychrolib_openmp', next(tmpdir.glob('psychrolib_openmp*.so')))
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    module.psychrolib.setunitsystem(module.psychrolib.si)
+    OpenMP = module.psychrolib_elemental_check.setnumthreads(4)
+    assert OpenMP
+    return module
+
+@pytest.mark.parametrize('name', ['TWetBulb', 'TDewPoint', 'RelHum'])
+def test_OpenMPArrayMatchesElemental(psyopenmp, name):
+    TDryBulb = as_real(np.linspace(-20, 45, N_OPENMP))
+    Second = {'TWetBulb': TDryBulb - np.linspace(0, 8, N_OPENMP), 'TDewPoint': TDryBulb - np.linspace(0, 15, N_OPENMP),
+              'RelHum': np.linspace(0.05, 1, N_OPENMP)}[name]
+    Second = as_real(Second)
+    Pressure = as_real(np.full(N_OPENMP, 101325))
+    # Invalid elements in each chunk of the static schedule
+    TDryBulb[::500] = 250
+    function = 'calcpsychrometricsfrom%s' % name.lower()
+
+    *outputs, Status = getattr(psyopenmp.psychrolib, function + 'array')(TDryBulb, Second, Pressure)
+    expected, ExpectedStatus = getattr(psyopenmp.psychrolib_elemental_check, function + 'elementalarray')(
+        TDryBulb, Second, Pressure)
+
+    assert np.array_equal(Status, ExpectedStatus)
+    assert np.count_nonzero(Status == psyopenmp.psychrolib.status_temperature_out_of_range) == len(TDryBulb[::500])
+    for k, output in enumerate(outputs):
+        assert np.array_equal(output, expected[:, k])
@@ -0,0 +1,144 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the frames of the C library, in SI and IP units: results equal to the generic functions
+# in double and float columns, alignment of the columns, and reuse of the arena between batches.
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+# Range of dry-bulb temperature and pressure in each system of units
+RANGES = {'SI': (-10., 45., 80000., 101325.),
+          'IP': (14., 113., 11.6, 14.696)}
+
+# Results of each function, in the order of its arguments
+OUTPUTS = {'TWET_BULB': ['HUM_RATIO', 'TDEW_POINT', 'REL_HUM', 'VAP_PRES', 'MOIST_AIR_ENTHALPY', 'MOIST_AIR_VOLUME', 'DEGREE_OF_SATURATION'],
+           'TDEW_POINT': ['HUM_RATIO', 'TWET_BULB', 'REL_HUM', 'VAP_PRES', 'MOIST_AIR_ENTHALPY', 'MOIST_AIR_VOLUME', 'DEGREE_OF_SATURATION'],
+           'REL_HUM': ['HUM_RATIO', 'TWET_BULB', 'TDEW_POINT', 'VAP_PRES', 'MOIST_AIR_ENTHALPY', 'MOIST_AIR_VOLUME', 'DEGREE_OF_SATURATION']}
+
+FUNCTIONS = {'TWET_BULB': 'CalcPsychrometricsFromTWetBulb', 'TDEW_POINT': 'CalcPsychrometricsFromTDewPoint',
+             'REL_HUM': 'CalcPsychrometricsFromRelHum'}
+
+@pytest.fixture
+def frame(psycmodule):
+    frame = psycmodule.lib.PsychroFrameCreate(0)
+    yield frame
+    psycmodule.lib.PsychroFrameDestroy(frame)
+
+def points(psycmodule, units, n, seed = 50):
+    lib = psycmodule.lib
+    TMin, TMax, PMin, PMax = RANGES[units]
+    rng = np.random.default_rng(seed)
+    TDryBulb, RelHum, Pressure = rng.uniform(TMin, TMax, n), rng.uniform(0.05, 1., n), rng.uniform(PMin, PMax, n)
+    TWetBulb = np.array([lib.GetTWetBulbFromRelHum(*args) for args in zip(TDryBulb, RelHum, Pressure)])
+    TDewPoint = np.array([lib.GetTDewPointFromRelHum(T, RH) for T, RH in zip(TDryBulb, RelHum)])
+    return {'TDRY_BULB': TDryBulb, 'PRESSURE': Pressure, 'TWET_BULB': TWetBulb, 'TDEW_POINT': TDewPoint, 'REL_HUM': RelHum}
+
+def calc(psycmodule, function, *inputs):
+    # Results of a CalcPsychrometrics* function at each point, one column per result
+    expected = psycmodule.ffi.new('double[7]')
+    rows = []
+    for args in zip(*inputs):
+        getattr(psycmodule.lib, function)(*map(float, args), *[expected + k for k in range(7)])
+        rows.append(list(expected))
+    return np.array(rows).reshape(-1, 7)
+
+def column(psycmodule, frame, name):
+    # Values of a column in place, without a copy
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    data = lib.PsychroFrameGetColumn(frame, getattr(lib, 'PSYCHRO_COLUMN_' + name))
+    if data == ffi.NULL:
+        return None
+    dtype = np.float32 if lib.PsychroFrameGetColumnType(frame, getattr(lib, 'PSYCHRO_COLUMN_' + name)) == lib.PSYCHRO_COLUMN_FLOAT32 else np.float64
+    return np.frombuffer(ffi.buffer(data, lib.PsychroFrameGetCount(frame) * np.dtype(dtype).itemsize), dtype)
+
+def fill(psycmodule, frame, inputs, dtype = np.float64):
+    lib = psycmodule.lib
+    lib.PsychroFrameReset(frame, len(inputs['TDRY_BULB']))
+    for name, values in inputs.items():
+        type = lib.PSYCHRO_COLUMN_FLOAT32 if dtype == np.float32 else lib.PSYCHRO_COLUMN_FLOAT64
+        assert lib.PsychroFrameAddColumn(frame, getattr(lib, 'PSYCHRO_COLUMN_' + name), type) != psycmodule.ffi.NULL
+        column(psycmodule, frame, name)[:] = values
+
+@pytest.mark.parametrize('input', ['TWET_BULB', 'TDEW_POINT', 'REL_HUM'])
+def test_FrameCalcPsychrometrics(psycmodule, units, frame, input):
+    lib = psycmodule.lib
+    inputs = points(psycmodule, units, 600)
+    fill(psycmodule, frame, {name: inputs[name] for name in ('TDRY_BULB', input, 'PRESSURE')})
+    assert lib.PsychroFrameCalcPsychrometrics(frame, getattr(lib, 'PSYCHRO_COLUMN_' + input), lib.PSYCHRO_COLUMN_FLOAT64, psycmodule.ffi.NULL) == 0
+    expected = calc(psycmodule, FUNCTIONS[input], inputs['TDRY_BULB'], inputs[input], inputs['PRESSURE'])
+    for k, name in enumerate(OUTPUTS[input]):
+        assert np.array_equal(column(psycmodule, frame, name), expected[:, k])
+        assert int(psycmodule.ffi.cast('uintptr_t', lib.PsychroFrameGetColumn(frame, getattr(lib, 'PSYCHRO_COLUMN_' + name)))) % 64 == 0
+
+def test_FrameFloat32(psycmodule, units, frame):
+    # Float inputs are widened and the results rounded
+    lib = psycmodule.lib
+    inputs = {name: values.astype(np.float32) for name, values in points(psycmodule, units, 300).items() if name in ('TDRY_BULB', 'REL_HUM', 'PRESSURE')}
+    fill(psycmodule, frame, inputs, np.float32)
+    assert lib.PsychroFrameCalcPsychrometrics(frame, lib.PSYCHRO_COLUMN_REL_HUM, lib.PSYCHRO_COLUMN_FLOAT32, psycmodule.ffi.NULL) == 0
+    expected = calc(psycmodule, 'CalcPsychrometricsFromRelHum', inputs['TDRY_BULB'], inputs['REL_HUM'], inputs['PRESSURE'])
+    for k, name in enumerate(OUTPUTS['REL_HUM']):
+        assert column(psycmodule, frame, name).dtype == np.float32
+        assert np.array_equal(column(psycmodule, frame, name), expected[:, k].astype(np.float32))
+
+def test_FrameSite(psycmodule, units, frame):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    inputs = points(psycmodule, units, 300)
+    site = lib.PsychroSiteCreate(RANGES[units][3])
+    fill(psycmodule, frame, {name: inputs[name] for name in ('TDRY_BULB', 'TWET_BULB')})
+    assert lib.PsychroFrameCalcPsychrometrics(frame, lib.PSYCHRO_COLUMN_TWET_BULB, lib.PSYCHRO_COLUMN_FLOAT64, site) == -1
+    fill(psycmodule, frame, {name: inputs[name] for name in ('TDRY_BULB', 'REL_HUM')})
+    assert lib.PsychroFrameCalcPsychrometrics(frame, lib.PSYCHRO_COLUMN_REL_HUM, lib.PSYCHRO_COLUMN_FLOAT64, site) == 0
+    expected = [np.empty(300) for _ in range(7)]
+    lib.PsychroSiteCalcPsychrometricsFromRelHum(site, 300, *[ffi.from_buffer('double[]', x) for x in (inputs['TDRY_BULB'], inputs['REL_HUM'])],
+                                                *[ffi.from_buffer('double[]', x) for x in expected])
+    for k, name in enumerate(OUTPUTS['REL_HUM']):
+        assert np.array_equal(column(psycmodule, frame, name), expected[k])
+    lib.PsychroSiteDestroy(site)
+
+def test_FrameMissingColumns(psycmodule, frame):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    inputs = points(psycmodule, 'SI', 10)
+    fill(psycmodule, frame, {name: inputs[name] for name in ('TDRY_BULB', 'REL_HUM')})
+    assert lib.PsychroFrameCalcPsychrometrics(frame, lib.PSYCHRO_COLUMN_REL_HUM, lib.PSYCHRO_COLUMN_FLOAT64, ffi.NULL) == -1
+    assert lib.PsychroFrameCalcPsychrometrics(frame, lib.PSYCHRO_COLUMN_HUM_RATIO, lib.PSYCHRO_COLUMN_FLOAT64, ffi.NULL) == -1
+    assert column(psycmodule, frame, 'HUM_RATIO') is None
+
+def test_FrameArena(psycmodule, frame):
+    # After the first batches, the batches of the same or a smaller size reuse the same memory
+    lib = psycmodule.lib
+    inputs = points(psycmodule, 'SI', 5000)
+
+    def run(n):
+        fill(psycmodule, frame, {name: inputs[name][:n] for name in ('TDRY_BULB', 'REL_HUM', 'PRESSURE')})
+        assert lib.PsychroFrameCalcPsychrometrics(frame, lib.PSYCHRO_COLUMN_REL_HUM, lib.PSYCHRO_COLUMN_FLOAT64, psycmodule.ffi.NULL) == 0
+        return [lib.PsychroFrameGetColumn(frame, c) for c in range(lib.PSYCHRO_N_COLUMNS)], lib.PsychroFrameGetArenaSize(frame)
+
+    run(100)
+    _, size = run(5000)
+    assert size >= 10 * 5000 * 8
+    # The blocks of the arena are merged at the next reset, after which the columns are at the
+    # same addresses and the arena no longer grows
+    warm = run(5000)
+    assert warm[1] == size
+    assert run(5000) == warm
+    assert run(2000)[1] == size
+    # The columns of no rows are not NULL
+    assert psycmodule.ffi.NULL not in run(0)[0]
+    assert run(5000) == warm
+
+def test_FrameCreate(psycmodule):
+    lib = psycmodule.lib
+    frame = lib.PsychroFrameCreate(4096)
+    assert lib.PsychroFrameGetArenaSize(frame) == 4096
+    assert lib.PsychroFrameGetCount(frame) == 0
+    lib.PsychroFrameReset(frame, 100)
+    first = lib.PsychroFrameAddColumn(frame, lib.PSYCHRO_COLUMN_TDRY_BULB, lib.PSYCHRO_COLUMN_FLOAT32)
+    assert lib.PsychroFrameAddColumn(frame, lib.PSYCHRO_COLUMN_TDRY_BULB, lib.PSYCHRO_COLUMN_FLOAT32) == first
+    assert lib.PsychroFrameAddColumn(frame, lib.PSYCHRO_COLUMN_TDRY_BULB, lib.PSYCHRO_COLUMN_FLOAT64) != first
+    assert lib.PsychroFrameGetArenaSize(frame) == 4096
+    lib.PsychroFrameDestroy(frame)
+    lib.PsychroFrameDestroy(psycmodule.ffi.NULL)
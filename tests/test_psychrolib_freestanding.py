@@ -0,0 +1,125 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the freestanding configuration of the bounded-latency functions of the C library:
+# host-side build with -ffreestanding checked against the footprint budget documented in
+# psychrolib_bounded.c, and accuracy of the single-precision build with the bundled math functions.
+
+import os
+import re
+import shutil
+import subprocess
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+PATH_TO_SRC = Path(__file__).parents[1] / 'src' / 'c' / 'psychrolib_bounded.c'
+
+CONFIGURATIONS = [['PSYCHROLIB_UNITS_SI', 'PSYCHROLIB_SINGLE_PRECISION'], ['PSYCHROLIB_UNITS_IP', 'PSYCHROLIB_SINGLE_PRECISION'],
+                  ['PSYCHROLIB_UNITS_SI'], ['PSYCHROLIB_UNITS_IP']]
+
+# Dry-bulb temperature range, relative humidity range and pressure range in each system of units
+DOMAINS = {'SI': (-60., 90., 0.01, 1., 60000., 110000.), 'IP': (-76., 194., 0.01, 1., 8.7, 16.)}
+
+def ReadBudget():
+    # Rows "Function Code Stack" of the footprint budget in the module overview
+    with open(PATH_TO_SRC) as f:
+        return {m[1]: (int(m[2]), int(m[3])) for m in re.finditer(r'^ \*   (\w+) +(\d+) +(\d+)$', f.read(), re.MULTILINE)}
+
+def Compile(tmp_path, defines):
+    # Compile with the host compiler as for a bare-metal target, with the call graph and the stack
+    # usage of each function (gcc 10 or later), and return the object file and the call graph
+    obj = tmp_path / 'psychrolib_bounded.o'
+    command = [os.environ.get('CC', 'cc'), '-ffreestanding', '-nostdlib', '-Os', '-ffunction-sections', '-fdata-sections',
+               '-fcallgraph-info=su', '-Wall', '-Wextra', '-Wdouble-promotion', '-Werror', '-DPSYCHROLIB_FREESTANDING'] + \
+              ['-D' + define for define in defines] + ['-c', str(PATH_TO_SRC), '-o', str(obj)]
+    if shutil.which(command[0]) is None or shutil.which('nm') is None:
+        pytest.skip('requires a C compiler and nm')
+    result = subprocess.run(command, cwd = tmp_path, capture_output = True, text = True)
+    if 'callgraph-info' in result.stderr:
+        pytest.skip('requires gcc 10 or later')
+    assert result.returncode == 0, result.stderr
+    return obj, (tmp_path / 'psychrolib_bounded.ci').read_text()
+
+@pytest.mark.parametrize('defines', CONFIGURATIONS)
+def test_FreestandingBuildIsSelfContained(tmp_path, defines):
+    obj, _ = Compile(tmp_path, defines)
+    undefined = subprocess.run(['nm', '-u', str(obj)], capture_output = True, text = True, check = True).stdout.split()
+    assert undefined == []
+
+@pytest.mark.parametrize('defines', CONFIGURATIONS)
+def test_FreestandingFootprintBudget(tmp_path, defines):
+    obj, graph = Compile(tmp_path, defines)
+    budget = ReadBudget()
+    assert len(budget) == 13
+
+    frames = {title.split(':')[-1]: int(size) for title, size in
+              re.findall(r'node: \{ title: "([^"]+)" label: "[^"]*?(\d+) bytes', graph)}
+    calls = {}
+    for source, target in re.findall(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"', graph):
+        calls.setdefault(source.split(':')[-1], set()).add(target.split(':')[-1])
+    sizes = {}
+    for line in subprocess.run(['nm', '-S', str(obj)], capture_output = True, text = True, check = True).stdout.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in 'tT':
+            sizes[fields[3]] = int(fields[1], 16)
+
+    def Callees(function):
+        reached, pending = set(), [function]
+        while pending:
+            f = pending.pop()
+            if f not in reached:
+                reached.add(f)
+                pending.extend(calls.get(f, ()))
+        return reached
+
+    def Stack(function):
+        return frames[function] + max([Stack(f) for f in calls.get(function, ())], default = 0)
+
+    for function, (code, stack) in budget.items():
+        assert sum(sizes[f] for f in Callees(function)) <= code, function
+        assert Stack(function) <= stack, function
+
+@pytest.mark.parametrize('units', ['SI', 'IP'])
+def test_FreestandingSinglePrecision(psycmodule, BuildFreestanding, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    single = BuildFreestanding(['PSYCHROLIB_UNITS_' + units, 'PSYCHROLIB_SINGLE_PRECISION'])
+    lib.SetUnitSystem(getattr(lib, units))
+    TMin, TMax, RHMin, RHMax, PMin, PMax = DOMAINS[units]
+    rng = np.random.default_rng(32)
+    Double, Float = ffi.new('double *'), single.ffi.new('float *')
+    try:
+        for TDryBulb, RelHum, Pressure in zip(rng.uniform(TMin, TMax, 500), rng.uniform(RHMin, RHMax, 500), rng.uniform(PMin, PMax, 500)):
+            if lib.GetSatVapPres(TDryBulb) > 0.9 * Pressure:
+                continue
+            for function, inputs, relative in [('BoundedGetSatVapPres', (TDryBulb,), 2e-5),
+                                               ('BoundedGetHumRatioFromRelHum', (TDryBulb, RelHum, Pressure), 5e-5)]:
+                assert getattr(single.lib, function)(*inputs, Float) == getattr(lib, function)(*inputs, Double) == lib.PSYCHRO_STATUS_OK
+                assert Float[0] == pytest.approx(Double[0], rel = relative)
+            for function, inputs in [('BoundedGetTWetBulbFromRelHum', (TDryBulb, RelHum, Pressure)),
+                                     ('BoundedGetTDewPointFromRelHum', (TDryBulb, RelHum))]:
+                assert getattr(single.lib, function)(*inputs, Float) == getattr(lib, function)(*inputs, Double) == lib.PSYCHRO_STATUS_OK
+                assert Float[0] == pytest.approx(Double[0], abs = 5e-4)
+    finally:
+        lib.SetUnitSystem(lib.SI)
+
+# The bundled math functions in double precision give the same results as the C library
+@pytest.mark.parametrize('units', ['SI', 'IP'])
+def test_FreestandingDoublePrecision(psycmodule, BuildFreestanding, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    bundled = BuildFreestanding(['PSYCHROLIB_UNITS_' + units])
+    lib.SetUnitSystem(getattr(lib, units))
+    TMin, TMax, RHMin, RHMax, PMin, PMax = DOMAINS[units]
+    rng = np.random.default_rng(32)
+    expected = [ffi.new('double *') for _ in range(7)]
+    outputs = [bundled.ffi.new('double *') for _ in range(7)]
+    try:
+        for TDryBulb, RelHum, Pressure in zip(rng.uniform(TMin, TMax, 200), rng.uniform(RHMin, RHMax, 200), rng.uniform(PMin, PMax, 200)):
+            assert bundled.lib.BoundedCalcPsychrometricsFromRelHum(TDryBulb, RelHum, Pressure, *outputs) == \
+                lib.BoundedCalcPsychrometricsFromRelHum(TDryBulb, RelHum, Pressure, *expected)
+            assert [o[0] for o in outputs] == pytest.approx([e[0] for e in expected], rel = 1e-11, abs = 1e-11)
+    finally:
+        lib.SetUnitSystem(lib.SI)
@@ -0,0 +1,154 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the value and gradient functions of the C library, in SI and IP units: values equal to
+# the generic functions, gradients of the explicit equations against central finite differences,
+# and gradients of the implicit dew-point and wet-bulb temperatures against the explicit equations
+# they invert.
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+# Dry-bulb temperature range, relative humidity range, pressure range, and finite difference
+# steps of temperature and pressure in each system of units
+DOMAINS = {'SI': (-60., 90., 0.05, 1., 60000., 110000., 1e-4, 1e-1),
+           'IP': (-76., 194., 0.05, 1., 8.7, 16., 1.8e-4, 1.5e-5)}
+
+@pytest.fixture
+def points(psycmodule, units):
+    lib = psycmodule.lib
+    TMin, TMax, RHMin, RHMax, PMin, PMax, dT, dP = DOMAINS[units]
+    rng = np.random.default_rng(34)
+    points = [(T, RH, P) for T, RH, P in zip(rng.uniform(TMin, TMax, 300), rng.uniform(RHMin, RHMax, 300), rng.uniform(PMin, PMax, 300))
+              if lib.GetSatVapPres(T) < 0.9 * P]
+    return points, dT, dP
+
+def gradient(psycmodule, name, *inputs):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    g = ffi.new('double[3]')
+    value = getattr(lib, 'Grad' + name)(*inputs, g)
+    assert value == getattr(lib, name)(*inputs)
+    return [g[i] for i in range(len(inputs))]
+
+def difference(function, inputs, steps):
+    result = []
+    for i, h in enumerate(steps):
+        up, down = list(inputs), list(inputs)
+        up[i] += h
+        down[i] -= h
+        result.append((function(*up) - function(*down)) / (2 * h))
+    return result
+
+def test_GradExplicitFunctions(psycmodule, points):
+    lib = psycmodule.lib
+    points, dT, dP = points
+    for T, RH, P in points:
+        W = lib.GetHumRatioFromRelHum(T, RH, P)
+        VapPres = lib.GetVapPresFromRelHum(T, RH)
+        dW = 1e-3 * W
+        for name, inputs, steps in [('GetSatVapPres', (T,), (dT,)),
+                                    ('GetSatHumRatio', (T, P), (dT, dP)),
+                                    ('GetHumRatioFromVapPres', (VapPres, P), (1e-3 * VapPres, dP)),
+                                    ('GetVapPresFromHumRatio', (W, P), (dW, dP)),
+                                    ('GetHumRatioFromRelHum', (T, RH, P), (dT, 1e-4, dP)),
+                                    ('GetRelHumFromHumRatio', (T, W, P), (dT, dW, dP)),
+                                    ('GetHumRatioFromTDewPoint', (T, P), (dT, dP)),
+                                    ('GetMoistAirEnthalpy', (T, W), (dT, dW)),
+                                    ('GetMoistAirVolume', (T, W, P), (dT, dW, dP)),
+                                    ('GetMoistAirDensity', (T, W, P), (dT, dW, dP)),
+                                    ('GetDegreeOfSaturation', (T, W, P), (dT, dW, dP))]:
+            assert gradient(psycmodule, name, *inputs) == \
+                pytest.approx(difference(getattr(lib, name), inputs, steps), rel = 1e-5, abs = 1e-12), name
+        TWetBulb = lib.GetTWetBulbFromRelHum(T, RH, P)
+        # Away from the freezing point, where eqn. 33 and 35 do not join
+        if abs(TWetBulb - (32. if lib.GetUnitSystem() == lib.IP else 0.)) > 10 * dT:
+            assert gradient(psycmodule, 'GetHumRatioFromTWetBulb', T, TWetBulb, P) == \
+                pytest.approx(difference(lib.GetHumRatioFromTWetBulb, (T, TWetBulb, P), (dT, dT, dP)), rel = 1e-5, abs = 1e-12)
+
+def test_GradImplicitFunctions(psycmodule, points):
+    lib = psycmodule.lib
+    points, dT, dP = points
+    for T, RH, P in points:
+        W = lib.GetHumRatioFromRelHum(T, RH, P)
+        VapPres = lib.GetVapPresFromRelHum(T, RH)
+
+        # Dew point: inverse of the saturation vapor pressure
+        TDewPoint = lib.GetTDewPointFromVapPres(T, VapPres)
+        dTDewPoint = gradient(psycmodule, 'GetTDewPointFromVapPres', T, VapPres)
+        if TDewPoint < T:
+            assert dTDewPoint[0] == 0.
+            dLnPws = gradient(psycmodule, 'GetSatVapPres', TDewPoint)[0] / lib.GetSatVapPres(TDewPoint)
+            assert dTDewPoint[1] * VapPres * dLnPws == pytest.approx(1., rel = 1e-12)
+
+        # Wet bulb: inverse of eqn. 33 and 35 with respect to the wet-bulb temperature
+        TWetBulb = lib.GetTWetBulbFromHumRatio(T, W, P)
+        dTWetBulb = gradient(psycmodule, 'GetTWetBulbFromHumRatio', T, W, P)
+        dHumRatio = gradient(psycmodule, 'GetHumRatioFromTWetBulb', T, TWetBulb, P)
+        assert dTWetBulb[1] * dHumRatio[1] == pytest.approx(1., rel = 1e-12)
+        assert dTWetBulb[0] * dHumRatio[1] + dHumRatio[0] == pytest.approx(0., abs = 1e-12)
+        assert dTWetBulb[2] * dHumRatio[1] + dHumRatio[2] == pytest.approx(0., abs = 1e-12)
+
+        # Chain rule through the humidity ratio
+        dW = gradient(psycmodule, 'GetHumRatioFromRelHum', T, RH, P)
+        assert gradient(psycmodule, 'GetTWetBulbFromRelHum', T, RH, P) == pytest.approx(
+            [dTWetBulb[0] + dTWetBulb[1] * dW[0], dTWetBulb[1] * dW[1], dTWetBulb[2] + dTWetBulb[1] * dW[2]], rel = 1e-12)
+        dTDewPoint = gradient(psycmodule, 'GetTDewPointFromHumRatio', T, W, P)
+        assert gradient(psycmodule, 'GetTDewPointFromRelHum', T, RH) == pytest.approx(
+            [dTDewPoint[0] + dTDewPoint[1] * dW[0], dTDewPoint[1] * dW[1]], rel = 1e-9, abs = 1e-12)
+
+# The bisection of the wet-bulb temperature stops within PSYCHROLIB_TOLERANCE of the solution:
+# central differences with large steps h agree with the derivative to within the truncation
+# error and PSYCHROLIB_TOLERANCE / h
+def test_GradImplicitFunctionsFiniteDifferences(psycmodule, points):
+    lib = psycmodule.lib
+    points, dT, dP = points
+    tolerance = 10 * dT                 # PSYCHROLIB_TOLERANCE
+    for T, RH, P in points[:100]:
+        W = lib.GetHumRatioFromRelHum(T, RH, P)
+        TWetBulb = lib.GetTWetBulbFromHumRatio(T, W, P)
+        if abs(TWetBulb - (32. if lib.GetUnitSystem() == lib.IP else 0.)) < 3e4 * dT or RH > 0.9:
+            continue
+        steps = (1e4 * dT, 0.05 * W, 0.1 * P)
+        expected = difference(lib.GetTWetBulbFromHumRatio, (T, W, P), steps)
+        for g, e, h in zip(gradient(psycmodule, 'GetTWetBulbFromHumRatio', T, W, P), expected, steps):
+            assert g == pytest.approx(e, rel = 0.05, abs = tolerance / h)
+
+@pytest.mark.parametrize('function, humidity', [('CalcPsychrometricsFromTWetBulb', 'TWetBulb'),
+                                                ('CalcPsychrometricsFromTDewPoint', 'TDewPoint'),
+                                                ('CalcPsychrometricsFromRelHum', 'RelHum')])
+def test_GradCalcPsychrometrics(psycmodule, points, function, humidity):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    points, _, _ = points
+    TDryBulb = np.array([p[0] for p in points])
+    Pressure = np.array([p[2] for p in points])
+    Humidity = np.array([{'TWetBulb': lib.GetTWetBulbFromRelHum(*p), 'TDewPoint': lib.GetTDewPointFromRelHum(*p[:2]),
+                          'RelHum': p[1]}[humidity] for p in points])
+    Values = np.empty((len(points), 7))
+    Jacobian = np.empty((len(points), 7, 3))
+    getattr(lib, 'Grad' + function)(len(points), *[ffi.from_buffer('double[]', x) for x in (TDryBulb, Humidity, Pressure)],
+                                    ffi.from_buffer('double[]', Values), ffi.from_buffer('double[]', Jacobian))
+
+    outputs = [ffi.new('double *') for _ in range(7)]
+    for i in range(len(points)):
+        getattr(lib, function)(TDryBulb[i], Humidity[i], Pressure[i], *outputs)
+        assert list(Values[i]) == [o[0] for o in outputs]
+
+    # Rows of the Jacobian from the scalar gradients and the chain rule through the humidity ratio
+    for i in range(len(points)):
+        T, H, P = TDryBulb[i], Humidity[i], Pressure[i]
+        W = Values[i][0]
+        dW = {'TWetBulb': lambda: gradient(psycmodule, 'GetHumRatioFromTWetBulb', T, H, P),
+              'TDewPoint': lambda: [0.] + gradient(psycmodule, 'GetHumRatioFromTDewPoint', H, P),
+              'RelHum': lambda: gradient(psycmodule, 'GetHumRatioFromRelHum', T, H, P)}[humidity]()
+        assert list(Jacobian[i][0]) == pytest.approx(dW, rel = 1e-12, abs = 1e-15)
+        names = {'TWetBulb': ['GetTDewPointFromHumRatio', 'GetRelHumFromHumRatio'],
+                 'TDewPoint': ['GetTWetBulbFromHumRatio', 'GetRelHumFromHumRatio'],
+                 'RelHum': ['GetTWetBulbFromHumRatio', 'GetTDewPointFromHumRatio']}[humidity]
+        rows = [gradient(psycmodule, name, T, W, P) for name in names]
+        rows.append([0.] + gradient(psycmodule, 'GetVapPresFromHumRatio', W, P))
+        rows.append(gradient(psycmodule, 'GetMoistAirEnthalpy', T, W) + [0.])
+        rows += [gradient(psycmodule, name, T, W, P) for name in ('GetMoistAirVolume', 'GetDegreeOfSaturation')]
+        for row, d in zip(Jacobian[i][1:], rows):
+            assert list(row) == pytest.approx([d[0] + d[1] * dW[0], d[1] * dW[1], d[2] + d[1] * dW[2]], rel = 1e-12, abs = 1e-15)
@@ -0,0 +1,128 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the header-only build of the C library: a program with a static-inline copy of the
+# library in one source file, and the library compiled from the header in another one.
+
+import math
+import os
+import shutil
+import subprocess
+from pathlib import Path
+
+import pytest
+
+PATH_TO_SRC = Path(__file__).parents[1] / 'src' / 'c'
+
+# Static-inline copy in IP units, library compiled in impl.c and used from linked.c in SI units
+MAIN = r'''
+#include <stdio.h>
+#define PSYCHROLIB_STATIC_INLINE
+#include "psychrolib_inline.h"
+void LinkedSetUnitSystem(void);
+double LinkedSatVapPres(double TDryBulb);
+double LinkedTWetBulb(double TDryBulb, double RelHum, double Pressure);
+int main(void)
+{
+  SetUnitSystem(IP);
+  LinkedSetUnitSystem();
+  printf("%.17g %.17g\n", GetSatVapPres(77.), GetTWetBulbFromRelHum(77., 0.8, 14.696));
+  printf("%.17g %.17g\n", LinkedSatVapPres(25.), LinkedTWetBulb(25., 0.8, 101325.));
+  printf("%d\n", GetUnitSystem() == IP);
+  return 0;
+}
+'''
+
+IMPL = r'''
+#define PSYCHROLIB_IMPLEMENTATION
+#include "psychrolib_inline.h"
+'''
+
+LINKED = r'''
+#include "psychrolib_inline.h"
+void LinkedSetUnitSystem(void) { SetUnitSystem(SI); }
+double LinkedSatVapPres(double TDryBulb) { return GetSatVapPres(TDryBulb); }
+double LinkedTWetBulb(double TDryBulb, double RelHum, double Pressure) { return GetTWetBulbFromRelHum(TDryBulb, RelHum, Pressure); }
+'''
+
+def test_HeaderOnlyBuild(psycmodule, tmp_path):
+    lib = psycmodule.lib
+    compiler = os.environ.get('CC', 'cc')
+    if shutil.which(compiler) is None:
+        pytest.skip('requires a C compiler')
+    sources = []
+    for name, text in [('main.c', MAIN), ('impl.c', IMPL), ('linked.c', LINKED)]:
+        (tmp_path / name).write_text(text)
+        sources.append(str(tmp_path / name))
+    exe = tmp_path / 'inline'
+    result = subprocess.run([compiler, '-O2', '-std=c11', '-Wall', '-Wextra', '-Werror', '-I', str(PATH_TO_SRC)]
+                            + sources + ['-lm', '-o', str(exe)], capture_output = True, text = True)
+    assert result.returncode == 0, result.stderr
+    lines = subprocess.run([str(exe)], capture_output = True, text = True, check = True).stdout.splitlines()
+
+    try:
+        lib.SetUnitSystem(lib.IP)
+        assert [float(x) for x in lines[0].split()] == [lib.GetSatVapPres(77.), lib.GetTWetBulbFromRelHum(77., 0.8, 14.696)]
+        lib.SetUnitSystem(lib.SI)
+        assert [float(x) for x in lines[1].split()] == [lib.GetSatVapPres(25.), lib.GetTWetBulbFromRelHum(25., 0.8, 101325.)]
+    finally:
+        lib.SetUnitSystem(lib.SI)
+    # The system of units of the static-inline copy is not changed by the linked library
+    assert lines[2] == '1'
+
+# Check-free functions in IP and SI units, on valid points and on invalid inputs
+UNCHECKED = r'''
+#include <stdio.h>
+#define PSYCHROLIB_STATIC_INLINE
+#include "psychrolib_inline.h"
+static void Print(double TDryBulb, double HumRatio, double RelHum, double Pressure)
+{
+  printf("%.17g %.17g %.17g %.17g %.17g %.17g %.17g\n", UncheckedGetSatVapPres(TDryBulb),
+    UncheckedGetSatHumRatio(TDryBulb, Pressure), UncheckedGetHumRatioFromRelHum(TDryBulb, RelHum, Pressure),
+    UncheckedGetMoistAirEnthalpy(TDryBulb, HumRatio), UncheckedGetMoistAirVolume(TDryBulb, HumRatio, Pressure),
+    UncheckedGetVapPresFromHumRatio(HumRatio, Pressure), UncheckedGetTDewPointFromHumRatio(TDryBulb, HumRatio, Pressure));
+}
+int main(void)
+{
+  Print(77., 0., 0.5, 14.696);
+  SetUnitSystem(IP);
+  Print(-40., 0.0001, 0.2, 14.696);
+  Print(77., 0.01, 0.8, 14.696);
+  Print(400., -0.01, 1.5, 14.696);
+  SetUnitSystem(SI);
+  Print(-40., 0.0001, 0.2, 101325.);
+  Print(25., 0.01, 0.8, 101325.);
+  Print(250., -0.01, 1.5, 101325.);
+  return 0;
+}
+'''
+
+def test_HeaderOnlyUncheckedFunctions(psycmodule, tmp_path):
+    lib = psycmodule.lib
+    compiler = os.environ.get('CC', 'cc')
+    if shutil.which(compiler) is None:
+        pytest.skip('requires a C compiler')
+    (tmp_path / 'unchecked.c').write_text(UNCHECKED)
+    exe = tmp_path / 'unchecked'
+    result = subprocess.run([compiler, '-O2', '-std=c11', '-Wall', '-Wextra', '-Werror', '-I', str(PATH_TO_SRC),
+                             str(tmp_path / 'unchecked.c'), '-lm', '-o', str(exe)], capture_output = True, text = True)
+    assert result.returncode == 0, result.stderr
+    lines = subprocess.run([str(exe)], capture_output = True, text = True, check = True).stdout.splitlines()
+    values = [[float(x) for x in line.split()] for line in lines]
+
+    # NaN while the system of units is undefined, but for the vapor pressure, which does not depend on it
+    assert all(math.isnan(x) for x in values[0][:5] + values[0][6:])
+    # NaN outside the range of the equations or for invalid humidity
+    assert all(math.isnan(x) for x in values[3] + values[6])
+    try:
+        for units, points in [(lib.IP, [(-40., 0.0001, 0.2, 14.696), (77., 0.01, 0.8, 14.696)]),
+                              (lib.SI, [(-40., 0.0001, 0.2, 101325.), (25., 0.01, 0.8, 101325.)])]:
+            lib.SetUnitSystem(units)
+            for (TDryBulb, HumRatio, RelHum, Pressure), Unchecked in zip(points, values[1:3] if units == lib.IP else values[4:6]):
+                Expected = [lib.GetSatVapPres(TDryBulb), lib.GetSatHumRatio(TDryBulb, Pressure),
+                            lib.GetHumRatioFromRelHum(TDryBulb, RelHum, Pressure), lib.GetMoistAirEnthalpy(TDryBulb, HumRatio),
+                            lib.GetMoistAirVolume(TDryBulb, HumRatio, Pressure), lib.GetVapPresFromHumRatio(HumRatio, Pressure)]
+                assert Unchecked[:6] == pytest.approx(Expected, rel = 1e-13)
+                assert Unchecked[6] == pytest.approx(lib.GetTDewPointFromHumRatio(TDryBulb, HumRatio, Pressure), abs = 1e-6)
+    finally:
+        lib.SetUnitSystem(lib.SI)
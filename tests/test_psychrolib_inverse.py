@@ -0,0 +1,72 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the inverse functions of the C library, in SI and IP units: round trips through the
+# forward functions, edge cases of the relative humidity and batches against the scalar functions.
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+# Ranges of dry-bulb temperature and pressure, and a temperature step
+DOMAINS = {'SI': ((-40., 90.), (60000., 105000.), 1.),
+           'IP': ((-40., 194.), (8.7, 15.2), 1.8)}
+
+def points(units, n = 200, seed = 41):
+    rng = np.random.default_rng(seed)
+    (TLow, THigh), (PLow, PHigh), _ = DOMAINS[units]
+    T, RH, P = rng.uniform(TLow, THigh, n), rng.uniform(0., 1., n), rng.uniform(PLow, PHigh, n)
+    RH[:4] = [0., 1e-4, 0.999, 1.]
+    return list(T), list(RH), list(P)
+
+def test_GetTDryBulbFromEnthalpyAndRelHum(psycmodule, units):
+    lib = psycmodule.lib
+    for T, RH, P in zip(*points(units)):
+        if lib.GetSatVapPres(T) * RH >= 0.9 * P:
+            continue
+        h = lib.GetMoistAirEnthalpy(T, lib.GetHumRatioFromRelHum(T, RH, P))
+        assert lib.GetTDryBulbFromEnthalpyAndRelHum(h, RH, P) == pytest.approx(T, abs = 1e-8)
+
+def test_GetTDryBulbFromMoistAirVolumeAndRelHum(psycmodule, units):
+    lib = psycmodule.lib
+    for T, RH, P in zip(*points(units)):
+        if lib.GetSatVapPres(T) * RH >= 0.9 * P:
+            continue
+        v = lib.GetMoistAirVolume(T, lib.GetHumRatioFromRelHum(T, RH, P), P)
+        assert lib.GetTDryBulbFromMoistAirVolumeAndRelHum(v, RH, P) == pytest.approx(T, abs = 1e-8)
+
+def test_GetTDryBulbFromTWetBulbAndRelHum(psycmodule, units):
+    lib = psycmodule.lib
+    dT = DOMAINS[units][2]
+    for T, RH, P in zip(*points(units)):
+        if lib.GetSatVapPres(T) * RH >= 0.9 * P:
+            continue
+        TWetBulb = lib.GetTWetBulbFromRelHum(T, RH, P)
+        TDryBulb = lib.GetTDryBulbFromTWetBulbAndRelHum(TWetBulb, RH, P)
+        # The psychrometer equation and the relative humidity agree at the solution
+        HumRatio = lib.GetHumRatioFromRelHum(TDryBulb, RH, P)
+        assert lib.GetHumRatioFromTWetBulb(TDryBulb, TWetBulb, P) == pytest.approx(HumRatio, rel = 1e-8, abs = 1e-12)
+        # Within the tolerance of the bisection of GetTWetBulbFromRelHum, amplified at low humidity
+        assert TDryBulb == pytest.approx(T, abs = 0.02 * dT)
+
+    # Saturated air: the dry-bulb temperature is the wet-bulb temperature
+    TWetBulb = 20. * dT
+    P = DOMAINS[units][1][1]
+    assert lib.GetTDryBulbFromTWetBulbAndRelHum(TWetBulb, 1., P) == pytest.approx(TWetBulb, abs = 1e-9)
+
+def test_InverseBatch(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    T, RH, P = points(units, n = 50, seed = 7)
+    T = [min(t, 50. * DOMAINS[units][2]) for t in T]
+    n = len(T)
+    W = [lib.GetHumRatioFromRelHum(*x) for x in zip(T, RH, P)]
+    h = [lib.GetMoistAirEnthalpy(t, w) for t, w in zip(T, W)]
+    v = [lib.GetMoistAirVolume(t, w, p) for t, w, p in zip(T, W, P)]
+    TWetBulb = [lib.GetTWetBulbFromRelHum(*x) for x in zip(T, RH, P)]
+    out = ffi.new('double[]', n)
+    for batch, scalar, values in [(lib.GetTDryBulbFromEnthalpyAndRelHumBatch, lib.GetTDryBulbFromEnthalpyAndRelHum, h),
+                                  (lib.GetTDryBulbFromTWetBulbAndRelHumBatch, lib.GetTDryBulbFromTWetBulbAndRelHum, TWetBulb),
+                                  (lib.GetTDryBulbFromMoistAirVolumeAndRelHumBatch, lib.GetTDryBulbFromMoistAirVolumeAndRelHum, v)]:
+        batch(n, values, RH, P, out)
+        assert list(out) == [scalar(x, rh, p) for x, rh, p in zip(values, RH, P)]
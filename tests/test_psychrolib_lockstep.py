@@ -0,0 +1,88 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the lock-step solvers of the C library against the generic functions, in SI and IP
+# units, on batches mixing points of very different numbers of iterations.
+
+import os
+import shutil
+import subprocess
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+PATH_TO_SRC = Path(__file__).parents[1] / 'src' / 'c'
+
+# Dry-bulb temperature range, pressure range and tolerance of the generic functions in each system of units
+DOMAINS = {'SI': (-60., 90., 60000., 101325., 0.001), 'IP': (-76., 194., 8.7, 14.696, 0.0018)}
+
+# Number of lanes of the default build
+LANES = 8
+
+@pytest.fixture
+def points(psycmodule, units):
+    lib = psycmodule.lib
+    TMin, TMax, PMin, PMax, tolerance = DOMAINS[units]
+    rng = np.random.default_rng(48)
+    TDryBulb = rng.uniform(TMin, TMax, 2001)
+    Pressure = rng.uniform(PMin, PMax, 2001)
+    # Very dry, intermediate and nearly saturated points in turn, with both sides of the freezing point
+    RelHum = np.resize([0.01, 0.3, 0.999, 0.05, 1.], 2001)
+    HumRatio = np.array([lib.GetHumRatioFromRelHum(*args) for args in zip(TDryBulb, RelHum, Pressure)])
+    return TDryBulb, HumRatio, Pressure, tolerance
+
+def batch(psycmodule, function, *inputs):
+    ffi = psycmodule.ffi
+    out = np.empty(len(inputs[0]))
+    steps = function(len(inputs[0]), *[ffi.from_buffer("double[]", np.ascontiguousarray(x)) for x in inputs],
+                     ffi.from_buffer("double[]", out))
+    return out, steps
+
+def test_LockstepGetTDewPointFromVapPres(psycmodule, points):
+    lib = psycmodule.lib
+    TDryBulb, HumRatio, Pressure, tolerance = points
+    VapPres = np.array([lib.GetVapPresFromHumRatio(W, P) for W, P in zip(HumRatio, Pressure)])
+    TDewPoint, steps = batch(psycmodule, lib.LockstepGetTDewPointFromVapPres, TDryBulb, VapPres)
+    assert TDewPoint == pytest.approx([lib.GetTDewPointFromVapPres(*args) for args in zip(TDryBulb, VapPres)], abs = tolerance)
+    # The lanes are refilled as they converge: the batch takes about the average number of
+    # iterations per point, not the largest
+    assert steps * LANES < 6 * len(TDryBulb)
+
+def test_LockstepGetTWetBulbFromHumRatio(psycmodule, points):
+    lib = psycmodule.lib
+    TDryBulb, HumRatio, Pressure, tolerance = points
+    TWetBulb, steps = batch(psycmodule, lib.LockstepGetTWetBulbFromHumRatio, TDryBulb, HumRatio, Pressure)
+    assert TWetBulb == pytest.approx([lib.GetTWetBulbFromHumRatio(*args) for args in zip(TDryBulb, HumRatio, Pressure)], abs = tolerance)
+    assert np.all(TWetBulb <= TDryBulb)
+
+def test_LockstepOrderAndBatchSize(psycmodule, points):
+    # Each point has the same result whatever its lane, its neighbours and the size of the batch
+    lib = psycmodule.lib
+    TDryBulb, HumRatio, Pressure, _ = points
+    TWetBulb, _ = batch(psycmodule, lib.LockstepGetTWetBulbFromHumRatio, TDryBulb, HumRatio, Pressure)
+    order = np.random.default_rng(1).permutation(len(TDryBulb))
+    shuffled, _ = batch(psycmodule, lib.LockstepGetTWetBulbFromHumRatio, TDryBulb[order], HumRatio[order], Pressure[order])
+    assert np.array_equal(shuffled, TWetBulb[order])
+    for n in (1, LANES - 1, LANES, LANES + 1):
+        assert np.array_equal(batch(psycmodule, lib.LockstepGetTWetBulbFromHumRatio, TDryBulb[:n], HumRatio[:n], Pressure[:n])[0], TWetBulb[:n])
+
+def test_LockstepSteps(psycmodule):
+    lib = psycmodule.lib
+    empty = np.empty(0)
+    assert batch(psycmodule, lib.LockstepGetTWetBulbFromHumRatio, empty, empty, empty)[1] == 0
+    # Identical points converge together, by groups of LANES
+    _, single = batch(psycmodule, lib.LockstepGetTDewPointFromVapPres, [25.], [1000.])
+    for n in (LANES, 3 * LANES + 1):
+        assert batch(psycmodule, lib.LockstepGetTDewPointFromVapPres, np.full(n, 25.), np.full(n, 1000.))[1] == single * -(-n // LANES)
+
+@pytest.mark.parametrize('lanes', [4, 16])
+def test_LockstepLanes(tmp_path, lanes):
+    command = [os.environ.get('CC', 'cc'), '-O2', '-Wall', '-Wextra', '-Werror', '-DPSYCHRO_LOCKSTEP_LANES=%d' % lanes,
+               '-c', str(PATH_TO_SRC / 'psychrolib_lockstep.c'), '-o', str(tmp_path / 'psychrolib_lockstep.o')]
+    if shutil.which(command[0]) is None:
+        pytest.skip('requires a C compiler')
+    result = subprocess.run(command, capture_output = True, text = True)
+    assert result.returncode == 0, result.stderr
@@ -0,0 +1,237 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the streaming pipeline of the C library, in SI and IP units: SPSC and MPMC queues, compute
+# stages against the bounded functions, map and sink stages, backpressure, several producer threads
+# and the counters of the stages.
+
+import struct
+import threading
+import time
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+# Ranges of dry-bulb temperature and pressure
+DOMAINS = {'SI': ((-40., 90.), (60000., 105000.)),
+           'IP': ((-40., 194.), (8.7, 15.2))}
+
+def readings(ffi, units, n, seed = 43):
+    rng = np.random.default_rng(seed)
+    (TLow, THigh), (PLow, PHigh) = DOMAINS[units]
+    result = []
+    for i in range(n):
+        r = ffi.new('struct PsychroReading *')
+        r.Sensor = i
+        r.TDryBulb, r.RelHum, r.Pressure = rng.uniform(TLow, THigh), rng.uniform(0.05, 1.), rng.uniform(PLow, PHigh)
+        result.append(r)
+    return result
+
+def stage(ffi, lib, kind, workers = 1, **kwargs):
+    config = ffi.new('struct PsychroStageConfig *')
+    config.Kind = kind
+    config.Workers = workers
+    for name, value in kwargs.items():
+        setattr(config, name, value)
+    return config[0]
+
+def drain(lib, ffi, pipeline):
+    out, r = [], ffi.new('struct PsychroReading *')
+    while True:
+        status = lib.PsychroPipelinePop(pipeline, r)
+        if status < 0:
+            return out
+        if status == 1:
+            out.append(ffi.new('struct PsychroReading *', r[0]))
+
+@pytest.mark.parametrize('kind', ['PSYCHRO_QUEUE_SPSC', 'PSYCHRO_QUEUE_MPMC'])
+def test_Queue(psycmodule, kind):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    queue = lib.PsychroQueueCreate(getattr(lib, kind), 5, 8)
+    try:
+        items, out = ffi.new('uint64_t[]', list(range(100))), ffi.new('uint64_t[]', 100)
+        # Capacity rounded up to 8; items in order across the wrap-around of the ring
+        assert lib.PsychroQueuePush(queue, items, 10) == 8
+        assert lib.PsychroQueueGetSize(queue) == 8
+        assert lib.PsychroQueuePop(queue, out, 5) == 5
+        assert list(out[0:5]) == [0, 1, 2, 3, 4]
+        assert lib.PsychroQueuePush(queue, items + 8, 6) == 5
+        assert lib.PsychroQueuePop(queue, out, 100) == 8
+        assert list(out[0:8]) == [5, 6, 7, 8, 9, 10, 11, 12]
+        assert lib.PsychroQueuePop(queue, out, 1) == 0
+        assert lib.PsychroQueueGetSize(queue) == 0
+    finally:
+        lib.PsychroQueueDestroy(queue)
+
+def test_PipelineCompute(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    stages = ffi.new('struct PsychroStageConfig[]', [stage(ffi, lib, lib.PSYCHRO_STAGE_COMPUTE, 2, BatchSize = 16, MaxLatency = 1e-3)])
+    pipeline = lib.PsychroPipelineCreate(stages, 1, 1)
+    assert pipeline != ffi.NULL
+    inputs = readings(ffi, units, 500)
+    inputs[7].RelHum = 1.5
+    try:
+        for r in inputs:
+            assert lib.PsychroPipelinePush(pipeline, r) == 0
+        lib.PsychroPipelineClose(pipeline)
+        assert lib.PsychroPipelinePush(pipeline, inputs[0]) == -1
+        out = sorted(drain(lib, ffi, pipeline), key = lambda r: r.Sensor)
+        assert [r.Sensor for r in out] == list(range(500))
+        values = [ffi.new('double *') for _ in range(7)]
+        for r in out:
+            status = lib.BoundedCalcPsychrometricsFromRelHum(r.TDryBulb, r.RelHum, r.Pressure, *values)
+            if r.Sensor == 7:
+                assert status != lib.PSYCHRO_STATUS_OK
+                assert np.isnan(r.HumRatio) and np.isnan(r.TWetBulb) and np.isnan(r.DegreeOfSaturation)
+                continue
+            assert [r.HumRatio, r.TWetBulb, r.TDewPoint, r.VapPres, r.MoistAirEnthalpy, r.MoistAirVolume,
+                    r.DegreeOfSaturation] == [v[0] for v in values]
+        stats = ffi.new('struct PsychroStageStats *')
+        lib.PsychroPipelineGetStats(pipeline, 0, stats)
+        assert stats.Readings == 500 and stats.Dropped == 0
+        assert 500 / 16 <= stats.Batches <= 500
+        assert 0. < stats.MeanLatency <= stats.MaxLatency
+    finally:
+        lib.PsychroPipelineDestroy(pipeline)
+
+def test_PipelineComputeInputs(psycmodule, units):
+    # Readings from the wet-bulb or dew-point temperature
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    for field, inp, scalar in [('TWetBulb', lib.PSYCHRO_STAGE_FROM_TWET_BULB, lib.BoundedCalcPsychrometricsFromTWetBulb),
+                               ('TDewPoint', lib.PSYCHRO_STAGE_FROM_TDEW_POINT, lib.BoundedCalcPsychrometricsFromTDewPoint)]:
+        stages = ffi.new('struct PsychroStageConfig[]', [stage(ffi, lib, lib.PSYCHRO_STAGE_COMPUTE, Input = inp)])
+        pipeline = lib.PsychroPipelineCreate(stages, 1, 1)
+        inputs = readings(ffi, units, 50)
+        for r in inputs:
+            setattr(r, field, lib.GetTWetBulbFromRelHum(r.TDryBulb, r.RelHum, r.Pressure) if field == 'TWetBulb'
+                    else lib.GetTDewPointFromRelHum(r.TDryBulb, r.RelHum))
+            r.RelHum = float('nan')
+            assert lib.PsychroPipelinePush(pipeline, r) == 0
+        lib.PsychroPipelineClose(pipeline)
+        out = drain(lib, ffi, pipeline)
+        lib.PsychroPipelineDestroy(pipeline)
+        assert [r.Sensor for r in out] == list(range(50))
+        values = [ffi.new('double *') for _ in range(7)]
+        for r in out:
+            assert scalar(r.TDryBulb, getattr(r, field), r.Pressure, *values) == lib.PSYCHRO_STATUS_OK
+            other = r.TDewPoint if field == 'TWetBulb' else r.TWetBulb
+            assert [r.HumRatio, other, r.RelHum, r.VapPres, r.MoistAirEnthalpy, r.MoistAirVolume,
+                    r.DegreeOfSaturation] == [v[0] for v in values]
+
+def test_PipelineMapAndSink(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    collected = []
+    lock = threading.Lock()
+
+    # Parse the dry-bulb temperature and relative humidity from the frame, drop the odd sensors
+    @ffi.callback('int(void *, struct PsychroReading *)')
+    def parse(context, r):
+        if r.Sensor % 2:
+            return 1
+        r.TDryBulb, r.RelHum = struct.unpack('<dd', bytes(ffi.buffer(r.Frame, 16)))
+        return 0
+
+    @ffi.callback('void(void *, const struct PsychroReading *, size_t)')
+    def sink(context, r, n):
+        with lock:
+            collected.extend((r[i].Sensor, r[i].HumRatio) for i in range(n))
+
+    stages = ffi.new('struct PsychroStageConfig[]', [
+        stage(ffi, lib, lib.PSYCHRO_STAGE_MAP, 1, Map = parse, BatchSize = 8, MaxLatency = 1e-3),
+        stage(ffi, lib, lib.PSYCHRO_STAGE_COMPUTE, 3, BatchSize = 32, MaxLatency = 1e-3),
+        stage(ffi, lib, lib.PSYCHRO_STAGE_SINK, 1, Sink = sink, BatchSize = 64, MaxLatency = 1e-2)])
+    pipeline = lib.PsychroPipelineCreate(stages, 3, 1)
+    assert pipeline != ffi.NULL
+    inputs = readings(ffi, units, 400)
+    for r in inputs:
+        frame = struct.pack('<dd', r.TDryBulb, r.RelHum)
+        ffi.memmove(r.Frame, frame, 16)
+        T, RH = r.TDryBulb, r.RelHum
+        r.TDryBulb = r.RelHum = float('nan')
+        assert lib.PsychroPipelinePush(pipeline, r) == 0
+        r.TDryBulb, r.RelHum = T, RH
+    lib.PsychroPipelineFinish(pipeline)
+    # The sink stage has no output: Pop reports the end at once
+    assert lib.PsychroPipelinePop(pipeline, ffi.new('struct PsychroReading *')) == -1
+    stats = [ffi.new('struct PsychroStageStats *') for _ in range(3)]
+    for k in range(3):
+        lib.PsychroPipelineGetStats(pipeline, k, stats[k])
+    lib.PsychroPipelineDestroy(pipeline)
+    assert stats[2].Readings == 200
+    W = ffi.new('double *')
+    expected = []
+    for r in inputs[::2]:
+        assert lib.BoundedGetHumRatioFromRelHum(r.TDryBulb, r.RelHum, r.Pressure, W) == lib.PSYCHRO_STATUS_OK
+        expected.append((r.Sensor, W[0]))
+    assert sorted(collected) == expected
+    assert (stats[0].Readings, stats[0].Dropped) == (200, 200)
+    assert (stats[1].Readings, stats[1].Dropped) == (200, 0)
+    assert stats[0].MaxLatency <= stats[2].MaxLatency
+    assert stats[2].QueueSize == 0
+
+def test_PipelineBackpressure(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    stages = ffi.new('struct PsychroStageConfig[]', [stage(ffi, lib, lib.PSYCHRO_STAGE_COMPUTE, BatchSize = 2, QueueCapacity = 4)])
+    pipeline = lib.PsychroPipelineCreate(stages, 1, 1)
+    inputs = readings(ffi, 'SI', 100)
+    try:
+        # The output queue is not popped: the worker stalls and the input queue fills up
+        pushed, full = 0, 0
+        while full < 20 and pushed < len(inputs):
+            status = lib.PsychroPipelineTryPush(pipeline, inputs[pushed])
+            assert status in (0, 1)
+            if status == 1:
+                full += 1
+                time.sleep(0.005)
+            else:
+                pushed, full = pushed + 1, 0
+        # Input and output queues and the batch of the stalled worker
+        assert full == 20
+        assert pushed <= 4 + 4 + 2
+        stats = ffi.new('struct PsychroStageStats *')
+        lib.PsychroPipelineGetStats(pipeline, 0, stats)
+        assert stats.Stalls >= 1
+        lib.PsychroPipelineClose(pipeline)
+        assert lib.PsychroPipelineTryPush(pipeline, inputs[0]) == -1
+        assert [r.Sensor for r in drain(lib, ffi, pipeline)] == list(range(pushed))
+    finally:
+        lib.PsychroPipelineDestroy(pipeline)
+
+def test_PipelineProducers(psycmodule):
+    # Several threads push concurrently: cffi releases the GIL during PsychroPipelinePush
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    stages = ffi.new('struct PsychroStageConfig[]', [stage(ffi, lib, lib.PSYCHRO_STAGE_COMPUTE, 2, QueueCapacity = 64),
+                                                     stage(ffi, lib, lib.PSYCHRO_STAGE_COMPUTE, 2, QueueCapacity = 64)])
+    pipeline = lib.PsychroPipelineCreate(stages, 2, 0)
+    n, producers = 1500, 3
+    inputs = readings(ffi, 'SI', n * producers)
+
+    def produce(k):
+        for r in inputs[k * n:(k + 1) * n]:
+            lib.PsychroPipelinePush(pipeline, r)
+
+    out = []
+    threads = [threading.Thread(target = produce, args = (k,)) for k in range(producers)]
+    for t in threads:
+        t.start()
+    r = ffi.new('struct PsychroReading *')
+    while len(out) < n * producers:
+        if lib.PsychroPipelinePop(pipeline, r) == 1:
+            out.append(r.Sensor)
+    for t in threads:
+        t.join()
+    lib.PsychroPipelineClose(pipeline)
+    assert drain(lib, ffi, pipeline) == []
+    lib.PsychroPipelineDestroy(pipeline)
+    assert sorted(out) == list(range(n * producers))
+
+def test_PipelineInvalidConfig(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    compute = stage(ffi, lib, lib.PSYCHRO_STAGE_COMPUTE)
+    for configs in [[stage(ffi, lib, lib.PSYCHRO_STAGE_COMPUTE, 0)], [stage(ffi, lib, lib.PSYCHRO_STAGE_MAP)],
+                    [stage(ffi, lib, lib.PSYCHRO_STAGE_SINK)], [stage(ffi, lib, lib.PSYCHRO_STAGE_COMPUTE, MaxLatency = -1.)]]:
+        assert lib.PsychroPipelineCreate(ffi.new('struct PsychroStageConfig[]', configs), 1, 1) == ffi.NULL
+    assert lib.PsychroPipelineCreate(ffi.new('struct PsychroStageConfig[]', [compute]), 0, 1) == ffi.NULL
+    lib.PsychroPipelineDestroy(ffi.NULL)
@@ -0,0 +1,158 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the point sets of the C library, in SI and IP units: outputs equal to the generic
+# function, recomputation of the dirty rows only, reported changes and threads.
+
+import math
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+# Range of dry-bulb temperature and pressure in each system of units
+RANGES = {'SI': (-10., 45., 80000., 101325.),
+          'IP': (14., 113., 11.6, 14.696)}
+
+def create(psycmodule, count, thresholds = (0.,) * 7):
+    c = psycmodule.ffi.new('struct PsychroPointSetConfig *')
+    c.Count = count
+    c.Thresholds = list(thresholds)
+    return psycmodule.lib.PsychroPointSetCreate(c)
+
+def points(units, n, seed = 37):
+    TMin, TMax, PMin, PMax = RANGES[units]
+    rng = np.random.default_rng(seed)
+    return list(rng.uniform(TMin, TMax, n)), list(rng.uniform(0., 1., n)), list(rng.uniform(PMin, PMax, n))
+
+def recompute(psycmodule, pointset, count, threads = 1):
+    rows = psycmodule.ffi.new('size_t[]', count)
+    n = psycmodule.lib.PsychroPointSetRecompute(pointset, threads, rows)
+    return list(rows)[:n]
+
+def outputs(psycmodule, pointset, count):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    return [list(ffi.unpack(lib.PsychroPointSetGetOutput(pointset, k), count))
+            for k in range(lib.PSYCHRO_POINT_N_OUTPUTS)]
+
+def test_PsychroPointSetEqualsGeneric(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    n = 500
+    pointset = create(psycmodule, n)
+    assert all(math.isnan(x) for x in outputs(psycmodule, pointset, n)[0])
+    T, RH, P = points(units, n)
+    assert lib.PsychroPointSetUpdateRange(pointset, 0, n, T, RH, P, ffi.NULL) == n
+    assert lib.PsychroPointSetGetDirtyCount(pointset) == n
+    assert recompute(psycmodule, pointset, n) == list(range(n))
+    assert lib.PsychroPointSetGetDirtyCount(pointset) == 0
+    values = outputs(psycmodule, pointset, n)
+    expected = ffi.new('double[7]')
+    for i in range(n):
+        lib.CalcPsychrometricsFromRelHum(T[i], RH[i], P[i], *[expected + k for k in range(7)])
+        assert [values[k][i] for k in range(7)] == list(expected)
+    lib.PsychroPointSetDestroy(pointset)
+
+def test_PsychroPointSetRecomputesDirtyRowsOnly(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    n = 200
+    pointset = create(psycmodule, n)
+    T, RH, P = points('SI', n)
+    lib.PsychroPointSetUpdateRange(pointset, 0, n, T, RH, P, ffi.NULL)
+    recompute(psycmodule, pointset, n)
+    before = outputs(psycmodule, pointset, n)
+
+    # Writing the same inputs again does not mark the rows dirty
+    assert lib.PsychroPointSetUpdateRange(pointset, 0, n, T, RH, P, ffi.NULL) == 0
+    assert lib.PsychroPointSetUpdate(pointset, 5, T[5], RH[5], P[5]) == 0
+    assert lib.PsychroPointSetGetDirtyCount(pointset) == 0
+    assert recompute(psycmodule, pointset, n) == []
+
+    # Updating a row twice counts it once
+    assert lib.PsychroPointSetUpdate(pointset, 130, T[130] + 1., RH[130], P[130]) == 1
+    assert lib.PsychroPointSetUpdate(pointset, 130, T[130] + 2., RH[130], P[130]) == 1
+    assert lib.PsychroPointSetUpdate(pointset, 7, T[7], RH[7] / 2., P[7]) == 1
+    assert lib.PsychroPointSetGetDirtyCount(pointset) == 2
+    assert recompute(psycmodule, pointset, n) == [7, 130]
+    after = outputs(psycmodule, pointset, n)
+    for i in range(n):
+        if i not in (7, 130):
+            assert [after[k][i] for k in range(7)] == [before[k][i] for k in range(7)]
+    assert after[lib.PSYCHRO_POINT_HUM_RATIO][130] > before[lib.PSYCHRO_POINT_HUM_RATIO][130]
+    assert after[lib.PSYCHRO_POINT_TWET_BULB][130] > before[lib.PSYCHRO_POINT_TWET_BULB][130]
+    assert after[lib.PSYCHRO_POINT_HUM_RATIO][7] < before[lib.PSYCHRO_POINT_HUM_RATIO][7]
+    lib.PsychroPointSetDestroy(pointset)
+
+def test_PsychroPointSetThresholds(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    thresholds = [1e-3, 0.5, 0.5, 100., 1000., 1e-2, 1e-2]
+    pointset = create(psycmodule, 1, thresholds)
+    T = 25.
+    lib.PsychroPointSetUpdate(pointset, 0, T, 0.5, 101325.)
+    # Computed for the first time
+    assert recompute(psycmodule, pointset, 1) == [0]
+
+    # Changes below the thresholds are not reported, until they add up
+    reported = []
+    for step in range(10):
+        T += 0.1
+        lib.PsychroPointSetUpdate(pointset, 0, T, 0.5, 101325.)
+        reported.append(recompute(psycmodule, pointset, 1) == [0])
+    assert reported[0] is False
+    assert 0 < sum(reported) < 10
+    # The enthalpy, the first output to drift beyond its threshold, needs several steps
+    first = reported.index(True)
+    assert first >= 2
+    lib.PsychroPointSetDestroy(pointset)
+
+def test_PsychroPointSetInvalidInputs(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    TMin, TMax, PMin, PMax = RANGES[units]
+    n = 4
+    pointset = create(psycmodule, n)
+    T, RH, P = [TMin, TMax + 1000., TMin, TMin], [0.5, 0.5, 1.5, 0.5], [PMax, PMax, PMax, -1.]
+    invalid = ffi.new('size_t *')
+    assert lib.PsychroPointSetUpdateRange(pointset, 0, n, T, RH, P, invalid) == 1
+    assert invalid[0] == 3
+    assert lib.PsychroPointSetUpdate(pointset, 0, float('nan'), 0.5, PMax) == -1
+    assert lib.PsychroPointSetUpdate(pointset, n, TMin, 0.5, PMax) == -1
+    assert lib.PsychroPointSetUpdateRange(pointset, 2, 3, T, RH, P, invalid) == 0
+    assert invalid[0] == 3
+    assert recompute(psycmodule, pointset, n) == [0]
+    values = outputs(psycmodule, pointset, n)
+    assert not math.isnan(values[0][0])
+    assert all(math.isnan(values[k][i]) for k in range(7) for i in range(1, n))
+    lib.PsychroPointSetDestroy(pointset)
+
+@pytest.mark.parametrize('threads', [2, 3, 8])
+def test_PsychroPointSetThreads(psycmodule, units, threads):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    n = 5000
+    T, RH, P = points(units, n)
+    serial, parallel = create(psycmodule, n, [1e-4] * 7), create(psycmodule, n, [1e-4] * 7)
+    for pointset, t in [(serial, 1), (parallel, threads)]:
+        lib.PsychroPointSetUpdateRange(pointset, 0, n, T, RH, P, ffi.NULL)
+        assert recompute(psycmodule, pointset, n, t) == list(range(n))
+    # Change a random subset of the rows, clustered at the start to unbalance the words
+    rng = np.random.default_rng(38)
+    rows = sorted(set(rng.integers(0, n // 4, 1500)) | set(rng.integers(0, n, 200)))
+    for pointset in [serial, parallel]:
+        for i in rows:
+            lib.PsychroPointSetUpdate(pointset, int(i), T[i] + 0.5, RH[i], P[i])
+    changed = recompute(psycmodule, serial, n, 1)
+    assert changed == recompute(psycmodule, parallel, n, threads)
+    assert changed == sorted(changed)
+    assert set(changed) <= set(int(i) for i in rows)
+    assert outputs(psycmodule, serial, n) == outputs(psycmodule, parallel, n)
+    lib.PsychroPointSetDestroy(serial)
+    lib.PsychroPointSetDestroy(parallel)
+
+def test_PsychroPointSetCreateInvalidConfig(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    assert create(psycmodule, 0) == ffi.NULL
+    assert create(psycmodule, 10, [0., -1., 0., 0., 0., 0., 0.]) == ffi.NULL
+    assert create(psycmodule, 10, [float('nan')] + [0.] * 6) == ffi.NULL
+    pointset = create(psycmodule, 10)
+    assert lib.PsychroPointSetGetOutput(pointset, lib.PSYCHRO_POINT_N_OUTPUTS) == ffi.NULL
+    lib.PsychroPointSetDestroy(pointset)
+    lib.PsychroPointSetDestroy(ffi.NULL)
@@ -0,0 +1,181 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the air processes of the C library, in SI and IP units: balances of water and energy,
+# saturation clipping and batches against the generic functions.
+
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+# Pressure, outdoor and return air (dry-bulb temperature and relative humidity) and a temperature step
+CASES = {'SI': (101325., (32., 0.55), (24., 0.5), 1.),
+         'IP': (14.696, (89.6, 0.55), (75.2, 0.5), 1.8)}
+
+def state(psycmodule, T, RH, P):
+    s = psycmodule.ffi.new('struct PsychroAirState *')
+    psycmodule.lib.PsychroAirSetStateFromRelHum(s, T, RH, P)
+    return s
+
+def water_enthalpy(units, T):
+    return 4186. * T if units == 'SI' else T - 32.
+
+def test_PsychroAirSetState(psycmodule, units):
+    lib = psycmodule.lib
+    P, (T, RH), _, _ = CASES[units]
+    s = state(psycmodule, T, RH, P)
+    assert s.HumRatio == lib.GetHumRatioFromRelHum(T, RH, P)
+    assert s.MoistAirEnthalpy == lib.GetMoistAirEnthalpy(T, s.HumRatio)
+    assert lib.PsychroAirGetRelHum(s) == pytest.approx(RH, rel = 1e-12)
+    assert lib.PsychroAirClipToSaturation(s) == 0
+    assert s.TDryBulb == T
+
+def test_PsychroAirMix(psycmodule, units):
+    lib = psycmodule.lib
+    P, (TA, RHA), (TB, RHB), _ = CASES[units]
+    a, b = state(psycmodule, TA, RHA, P), state(psycmodule, TB, RHB, P)
+    m = psycmodule.ffi.new('struct PsychroAirState *')
+    assert lib.PsychroAirMix(a, 0.3, b, 0.7, m) == 0
+    assert m.HumRatio == pytest.approx(0.3 * a.HumRatio + 0.7 * b.HumRatio, rel = 1e-12)
+    assert m.MoistAirEnthalpy == pytest.approx(0.3 * a.MoistAirEnthalpy + 0.7 * b.MoistAirEnthalpy, rel = 1e-12)
+    assert m.MoistAirEnthalpy == pytest.approx(lib.GetMoistAirEnthalpy(m.TDryBulb, m.HumRatio), rel = 1e-12)
+    assert TB < m.TDryBulb < TA
+
+    # Mixing two saturated streams at different temperatures supersaturates the mixture, clipped to
+    # saturation at the same enthalpy, warmer than the mixture because water condenses
+    cold, warm = state(psycmodule, TB - 20. * CASES[units][3], 1., P), state(psycmodule, TA, 1., P)
+    enthalpy = 0.5 * cold.MoistAirEnthalpy + 0.5 * warm.MoistAirEnthalpy
+    assert lib.PsychroAirMix(cold, 1., warm, 1., cold) == 1
+    assert cold.MoistAirEnthalpy == pytest.approx(enthalpy, rel = 1e-9)
+    assert cold.HumRatio < 0.5 * (lib.GetHumRatioFromRelHum(TB - 20. * CASES[units][3], 1., P) + warm.HumRatio)
+    assert lib.PsychroAirGetRelHum(cold) == pytest.approx(1., abs = 1e-9)
+
+def test_PsychroAirHeat(psycmodule, units):
+    lib = psycmodule.lib
+    P, _, (T, RH), dT = CASES[units]
+    s = state(psycmodule, T, RH, P)
+    HumRatio = s.HumRatio
+    heat = lib.PsychroAirHeatTo(s, T + 10. * dT)
+    assert heat > 0.
+    assert s.TDryBulb == T + 10. * dT
+    assert s.HumRatio == HumRatio
+    assert lib.PsychroAirHeat(s, -heat) == 0
+    assert s.TDryBulb == pytest.approx(T, abs = 1e-9)
+    # Removing more heat than above the dew point condenses water
+    assert lib.PsychroAirHeat(s, -2. * heat) == 1
+    assert s.HumRatio < HumRatio
+    assert lib.PsychroAirGetRelHum(s) == pytest.approx(1., abs = 1e-9)
+
+def test_PsychroAirCoolTo(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    P, _, (T, RH), dT = CASES[units]
+    condensate = ffi.new('double *')
+    TDewPoint = lib.GetTDewPointFromRelHum(T, RH)
+
+    # Above the dew point: sensible cooling only
+    s = state(psycmodule, T, RH, P)
+    HumRatio, enthalpy = s.HumRatio, s.MoistAirEnthalpy
+    heat = lib.PsychroAirCoolTo(s, TDewPoint + dT, condensate)
+    assert condensate[0] == 0.
+    assert s.HumRatio == HumRatio
+    assert heat == pytest.approx(enthalpy - lib.GetMoistAirEnthalpy(TDewPoint + dT, HumRatio), rel = 1e-12)
+
+    # Below the dew point: saturated air and condensate
+    s = state(psycmodule, T, RH, P)
+    heat = lib.PsychroAirCoolTo(s, TDewPoint - 5. * dT, condensate)
+    assert s.HumRatio == pytest.approx(lib.GetSatHumRatio(TDewPoint - 5. * dT, P), rel = 1e-12)
+    assert condensate[0] == pytest.approx(HumRatio - s.HumRatio, rel = 1e-12)
+    assert heat == pytest.approx(enthalpy - s.MoistAirEnthalpy - condensate[0] * water_enthalpy(units, TDewPoint - 5. * dT), rel = 1e-12)
+    assert lib.PsychroAirCoolTo(s, s.TDryBulb, ffi.NULL) == 0.
+
+def test_PsychroAirCoolCoil(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    P, _, (T, RH), dT = CASES[units]
+    condensate = ffi.new('double *')
+    TApparatusDewPoint = lib.GetTDewPointFromRelHum(T, RH) - 6. * dT
+
+    # No bypass: saturated at the apparatus dew point; full bypass: unchanged
+    s = state(psycmodule, T, RH, P)
+    lib.PsychroAirCoolCoil(s, TApparatusDewPoint, 0., condensate)
+    assert s.TDryBulb == pytest.approx(TApparatusDewPoint, abs = 1e-9)
+    assert s.HumRatio == pytest.approx(lib.GetSatHumRatio(TApparatusDewPoint, P), rel = 1e-12)
+    s = state(psycmodule, T, RH, P)
+    assert lib.PsychroAirCoolCoil(s, TApparatusDewPoint, 1., condensate) == 0.
+    assert s.TDryBulb == pytest.approx(T, abs = 1e-12)
+    assert condensate[0] == 0.
+
+    # Wet coil: on the line between the entering air and the apparatus dew point, below saturation
+    s = state(psycmodule, T, RH, P)
+    HumRatio, enthalpy = s.HumRatio, s.MoistAirEnthalpy
+    heat = lib.PsychroAirCoolCoil(s, TApparatusDewPoint, 0.15, condensate)
+    assert condensate[0] == pytest.approx(0.85 * (HumRatio - lib.GetSatHumRatio(TApparatusDewPoint, P)), rel = 1e-12)
+    assert heat == pytest.approx(enthalpy - s.MoistAirEnthalpy - condensate[0] * water_enthalpy(units, TApparatusDewPoint), rel = 1e-12)
+    assert s.TDryBulb == pytest.approx(0.15 * T + 0.85 * TApparatusDewPoint, abs = 0.05 * dT)
+    assert lib.PsychroAirGetRelHum(s) < 1.
+
+    # Dry coil: surface above the dew point
+    s = state(psycmodule, T, RH, P)
+    lib.PsychroAirCoolCoil(s, T - 3. * dT, 0.2, condensate)
+    assert condensate[0] == 0.
+    assert s.HumRatio == HumRatio
+
+def test_PsychroAirHumidifySteam(psycmodule, units):
+    lib = psycmodule.lib
+    P, _, (T, RH), dT = CASES[units]
+    s = state(psycmodule, T, RH, P)
+    HumRatio = s.HumRatio
+    enthalpy = s.MoistAirEnthalpy
+    # Steam at 100 °C: nearly isothermal
+    assert lib.PsychroAirHumidifySteam(s, 1.2 * HumRatio, 100. if units == 'SI' else 212.) == 0
+    assert s.HumRatio == 1.2 * HumRatio
+    assert s.TDryBulb == pytest.approx(T, abs = 0.5 * dT)
+    steam_enthalpy = 2687.e3 if units == 'SI' else 1061. + 0.444 * 212.
+    assert s.MoistAirEnthalpy == pytest.approx(enthalpy + 0.2 * HumRatio * steam_enthalpy, rel = 1e-12)
+    # Beyond saturation: limited
+    assert lib.PsychroAirHumidifySteam(s, 3. * HumRatio, 100. if units == 'SI' else 212.) == 1
+    assert s.HumRatio < 3. * HumRatio
+    assert lib.PsychroAirGetRelHum(s) == pytest.approx(1., abs = 1e-9)
+
+def test_PsychroAirHumidifyAdiabatic(psycmodule, units):
+    lib = psycmodule.lib
+    P, (T, RH), _, dT = CASES[units]
+    s = state(psycmodule, T, RH, P)
+    HumRatio = s.HumRatio
+    TWetBulb = lib.GetTWetBulbFromRelHum(T, RH, P)
+    assert lib.PsychroAirHumidifyAdiabatic(s, HumRatio + 0.001, TWetBulb) == 0
+    assert s.TDryBulb < T
+    # Evaporation to saturation with water at the wet-bulb temperature: the thermodynamic wet-bulb
+    # temperature, within the tolerance of its solution
+    assert lib.PsychroAirHumidifyAdiabatic(s, 2. * HumRatio, TWetBulb) == 1
+    assert s.TDryBulb == pytest.approx(TWetBulb, abs = 2e-3 * dT)
+    assert s.HumRatio == pytest.approx(lib.GetSatHumRatio(TWetBulb, P), rel = 1e-3)
+
+def test_PsychroAirBatch(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    P, (TA, RHA), (TB, RHB), dT = CASES[units]
+    n = 8
+    a = ffi.new('struct PsychroAirState[]', n)
+    b = ffi.new('struct PsychroAirState[]', n)
+    for i in range(n):
+        lib.PsychroAirSetStateFromRelHum(a + i, TA + i * dT, RHA, P)
+        lib.PsychroAirSetStateFromRelHum(b + i, TB, RHB + 0.05 * i, P)
+    fractions = [0.1 * i for i in range(n)]
+    expected = [state(psycmodule, TA + i * dT, RHA, P) for i in range(n)]
+    assert lib.PsychroAirMixBatch(n, a, fractions, b, [1. - f for f in fractions], a) == 0
+    for i in range(n):
+        lib.PsychroAirMix(expected[i], fractions[i], b + i, 1. - fractions[i], expected[i])
+
+    heat, condensate = ffi.new('double[]', n), ffi.new('double[]', n)
+    lib.PsychroAirCoolCoilBatch(n, a, [TB - 12. * dT] * n, [0.1] * n, heat, condensate)
+    lib.PsychroAirHeatToBatch(n, a, [TB - 6. * dT] * n, ffi.NULL)
+    assert lib.PsychroAirHeatBatch(n, a, [500. if units == 'SI' else 0.2] * n) == 0
+    assert lib.PsychroAirHumidifySteamBatch(n, a, [s.HumRatio + 0.0005 for s in a], [100. if units == 'SI' else 212.] * n) == 0
+    for i in range(n):
+        c = ffi.new('double *')
+        assert lib.PsychroAirCoolCoil(expected[i], TB - 12. * dT, 0.1, c) == heat[i]
+        assert c[0] == condensate[i]
+        lib.PsychroAirHeatTo(expected[i], TB - 6. * dT)
+        lib.PsychroAirHeat(expected[i], 500. if units == 'SI' else 0.2)
+        lib.PsychroAirHumidifySteam(expected[i], expected[i].HumRatio + 0.0005, 100. if units == 'SI' else 212.)
+        for field in ['TDryBulb', 'HumRatio', 'Pressure', 'MoistAirEnthalpy']:
+            assert getattr(a[i], field) == getattr(expected[i], field)
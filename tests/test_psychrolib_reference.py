@@ -0,0 +1,95 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the extended-precision reference functions of the C library, in SI and IP units: the
+# closed forms against the generic functions to rounding, the solvers against the generic
+# functions to their tolerance and to the precision of the type on the equations they solve,
+# the values of the ASHRAE tables, and NaN outside the range of the equations.
+
+import math
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+# Range of the equations of the saturation vapor pressure, dry-bulb temperatures and pressures of
+# the test points, and tolerance of the generic functions
+DOMAINS = {'SI': ((-100., 200.), (-60., 90.), (60000., 101325.), 0.001),
+           'IP': ((-148., 392.), (-76., 194.), (8.7, 14.696), 0.0018)}
+
+def points(units, n, seed = 46):
+    # Dry-bulb temperatures, relative humidities and pressures with dew points in the range of the
+    # equations and vapor pressures below the pressure
+    rng = np.random.default_rng(seed)
+    _, (TLow, THigh), (PLow, PHigh), _ = DOMAINS[units]
+    return rng.uniform(TLow, THigh, n), rng.uniform(0.01, 1., n), rng.uniform(PLow, PHigh, n)
+
+def test_ClosedForms(psycmodule, units):
+    lib = psycmodule.lib
+    for T, RelHum, P in zip(*points(units, 200)):
+        W = lib.GetHumRatioFromRelHum(T, RelHum, P)
+        for reference, generic in ((lib.ReferenceGetSatVapPres(T), lib.GetSatVapPres(T)),
+                                   (lib.ReferenceGetSatHumRatio(T, P), lib.GetSatHumRatio(T, P)),
+                                   (lib.ReferenceGetHumRatioFromRelHum(T, RelHum, P), W),
+                                   (lib.ReferenceGetMoistAirEnthalpy(T, W), lib.GetMoistAirEnthalpy(T, W)),
+                                   (lib.ReferenceGetMoistAirVolume(T, W, P), lib.GetMoistAirVolume(T, W, P))):
+            assert float(reference) == pytest.approx(generic, rel = 1e-12, abs = 1e-12)
+        h = lib.GetMoistAirEnthalpy(T, W)
+        assert float(lib.ReferenceGetTDryBulbFromEnthalpyAndHumRatio(h, W)) == pytest.approx(T, abs = 1e-9)
+
+def test_Solvers(psycmodule, units):
+    lib = psycmodule.lib
+    tolerance = DOMAINS[units][3]
+    for T, RelHum, P in zip(*points(units, 200)):
+        W = lib.GetHumRatioFromRelHum(T, RelHum, P)
+        TDewPoint = float(lib.ReferenceGetTDewPointFromRelHum(T, RelHum))
+        TWetBulb = float(lib.ReferenceGetTWetBulbFromHumRatio(T, W, P))
+        assert TDewPoint == pytest.approx(lib.GetTDewPointFromRelHum(T, RelHum), abs = tolerance)
+        assert float(lib.ReferenceGetTDewPointFromHumRatio(T, W, P)) == pytest.approx(lib.GetTDewPointFromHumRatio(T, W, P), abs = tolerance)
+        assert TWetBulb == pytest.approx(lib.GetTWetBulbFromHumRatio(T, W, P), abs = tolerance)
+        assert float(lib.ReferenceGetTWetBulbFromRelHum(T, RelHum, P)) == pytest.approx(TWetBulb, abs = 1e-12)
+        assert float(lib.ReferenceGetRelHumFromTWetBulb(T, TWetBulb, P)) == pytest.approx(RelHum, abs = 1e-9)
+
+        # Converged beyond double precision on the equations solved, away from the discontinuity
+        # of the equations of the humidity ratio at freezing
+        assert float(lib.ReferenceGetSatVapPres(TDewPoint)) == pytest.approx(RelHum * lib.GetSatVapPres(T), rel = 1e-12)
+        if abs(TWetBulb - (0. if units == 'SI' else 32.)) > 1e-6:
+            assert float(lib.ReferenceGetHumRatioFromTWetBulb(T, TWetBulb, P)) == pytest.approx(W, rel = 1e-12)
+
+# Table 3 of ch. 1 of the 2017 ASHRAE Handbook - Fundamentals, as in test_psychrolib_si.py and
+# test_psychrolib_ip.py, and dew-point and wet-bulb temperatures of the tests of the generic functions
+TABLES = {'SI': (((-20, 103.24), (-5, 401.74), (5, 872.6), (25, 3169.7), (50, 12351.3), (100, 101418.0)),
+                 ((15., -20.), (15., 5.), (60., 50.)), (30., 25., 95461.)),
+          'IP': (((-4, 0.014974), (23, 0.058268), (41, 0.12656), (77, 0.45973), (122, 1.79140), (212, 14.7094)),
+                 ((59., -4.), (59., 41.), (140., 122.)), (86., 77., 14.175))}
+
+def test_Tables(psycmodule, units):
+    lib = psycmodule.lib
+    SatVapPres, DewPoints, (T, TWetBulb, P) = TABLES[units]
+    for t, Pws in SatVapPres:
+        assert float(lib.ReferenceGetSatVapPres(t)) == pytest.approx(Pws, rel = 0.0003)
+    for t, TDewPoint in DewPoints:
+        assert float(lib.ReferenceGetTDewPointFromVapPres(t, lib.GetSatVapPres(TDewPoint))) == pytest.approx(TDewPoint, abs = 1e-10)
+    W = lib.GetHumRatioFromTWetBulb(T, TWetBulb, P)
+    assert float(lib.ReferenceGetHumRatioFromTWetBulb(T, TWetBulb, P)) == pytest.approx(W, rel = 1e-12)
+    assert float(lib.ReferenceGetTWetBulbFromHumRatio(T, W, P)) == pytest.approx(TWetBulb, abs = 1e-10)
+
+def test_OutsideRange(psycmodule, units):
+    lib = psycmodule.lib
+    (TLow, THigh), _, (_, P), _ = DOMAINS[units]
+    for value in (lib.ReferenceGetSatVapPres(TLow - 1.),
+                  lib.ReferenceGetSatVapPres(THigh + 1.),
+                  lib.ReferenceGetSatVapPres(math.nan),
+                  lib.ReferenceGetTDewPointFromVapPres(20., -1.),
+                  lib.ReferenceGetTDewPointFromVapPres(20., 1e9),
+                  lib.ReferenceGetTDewPointFromRelHum(20., 1.5),
+                  lib.ReferenceGetHumRatioFromRelHum(20., -0.1, P),
+                  lib.ReferenceGetHumRatioFromTWetBulb(20., 25., P),
+                  lib.ReferenceGetTWetBulbFromHumRatio(20., -0.01, P),
+                  lib.ReferenceGetTWetBulbFromHumRatio(THigh + 1., 0.01, P),
+                  lib.ReferenceGetMoistAirEnthalpy(20., -0.01),
+                  lib.ReferenceGetMoistAirVolume(20., -0.01, P)):
+        assert math.isnan(float(value))
+    # Same clamp of the humidity ratio as the generic functions
+    assert float(lib.ReferenceGetTWetBulbFromHumRatio(25., 1e-9, P)) == float(lib.ReferenceGetTWetBulbFromHumRatio(25., 1e-7, P))
+    assert float(lib.ReferenceGetMoistAirEnthalpy(25., 0.)) == pytest.approx(lib.GetMoistAirEnthalpy(25., 0.), rel = 1e-12)
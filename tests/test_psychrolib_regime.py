@@ -0,0 +1,62 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the regime-partitioned batch functions of the C library against the generic functions,
+# in SI and IP units, on batches alternating between ice and liquid water, and points at the
+# freezing and triple points.
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+# Dry-bulb temperature range, freezing point, triple point and pressure range in each system of units
+DOMAINS = {'SI': (-60., 90., 0., 0.01, 60000., 101325.), 'IP': (-76., 194., 32., 32.018, 8.7, 14.696)}
+
+# Number of points partitioned together in the default build
+BLOCK = 1024
+
+@pytest.fixture
+def points(units):
+    TMin, TMax, TFreezing, TTriple, PMin, PMax = DOMAINS[units]
+    rng = np.random.default_rng(49)
+    # More than one block, with the regime changing from point to point
+    TWetBulb = rng.uniform(TMin, TMax, 2500)
+    TWetBulb[::7] = np.resize([TFreezing, TTriple, (TFreezing + TTriple) / 2., np.nextafter(TTriple, TMax)], len(TWetBulb[::7]))
+    TDryBulb = np.minimum(TWetBulb + rng.uniform(0., 30., len(TWetBulb)), TMax)
+    Pressure = rng.uniform(PMin, PMax, len(TWetBulb))
+    return TDryBulb, TWetBulb, Pressure
+
+def batch(psycmodule, function, schedule, *inputs):
+    ffi = psycmodule.ffi
+    out = np.empty(len(inputs[0]))
+    function(len(inputs[0]), *[ffi.from_buffer("double[]", np.ascontiguousarray(x)) for x in inputs],
+             ffi.from_buffer("double[]", out), schedule)
+    return out
+
+@pytest.mark.parametrize('name, inputs', [('GetSatVapPres', (1,)), ('GetSatHumRatio', (1, 2)),
+                                          ('GetHumRatioFromTWetBulb', (0, 1, 2))])
+def test_RegimeSchedules(psycmodule, points, name, inputs):
+    # Both schedules give the results of the generic function at the index of each point, to within
+    # the error of the logarithm and exponential of the kernels, amplified in the humidity ratios
+    # near the boiling point. The saturation functions are evaluated at the wet-bulb temperatures,
+    # which include the points at the freezing and triple points
+    lib = psycmodule.lib
+    args = [points[i] for i in inputs]
+    expected = [getattr(lib, name)(*arg) for arg in zip(*args)]
+    function = getattr(lib, 'Regime' + name)
+    interleaved = batch(psycmodule, function, lib.PSYCHRO_REGIME_INTERLEAVED, *args)
+    assert np.array_equal(interleaved, expected)
+    assert batch(psycmodule, function, lib.PSYCHRO_REGIME_PARTITIONED, *args) == pytest.approx(expected, rel = 1e-12)
+
+def test_RegimeOrderAndBatchSize(psycmodule, points):
+    # Each point has the same result whatever its neighbours and the size of the batch
+    lib = psycmodule.lib
+    TDryBulb, TWetBulb, Pressure = points
+    function = lib.RegimeGetHumRatioFromTWetBulb
+    HumRatio = batch(psycmodule, function, lib.PSYCHRO_REGIME_PARTITIONED, TDryBulb, TWetBulb, Pressure)
+    order = np.random.default_rng(1).permutation(len(TDryBulb))
+    shuffled = batch(psycmodule, function, lib.PSYCHRO_REGIME_PARTITIONED, TDryBulb[order], TWetBulb[order], Pressure[order])
+    assert np.array_equal(shuffled, HumRatio[order])
+    for n in (0, 1, BLOCK, BLOCK + 1):
+        assert np.array_equal(batch(psycmodule, function, lib.PSYCHRO_REGIME_PARTITIONED, TDryBulb[:n], TWetBulb[:n], Pressure[:n]), HumRatio[:n])
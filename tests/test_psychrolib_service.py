@@ -0,0 +1,238 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the compute service of the C library, in SI and IP units: service in a thread of the
+# test process, with clients through the shared-memory transport, against the bounded functions;
+# coalesced requests, invalid points and requests, statistics, and the daemon in its own process.
+
+import os
+import shutil
+import signal
+import subprocess
+import tempfile
+import threading
+import time
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+PATH_TO_C = Path(__file__).parents[1] / 'src' / 'c'
+
+# Ranges of dry-bulb temperature and pressure
+DOMAINS = {'SI': ((-40., 90.), (60000., 105000.)),
+           'IP': ((-40., 194.), (8.7, 15.2))}
+
+@pytest.fixture
+def socket_path():
+    # Short path: the path of a Unix domain socket is limited to about 100 characters
+    directory = tempfile.mkdtemp(prefix = 'psy')
+    yield os.path.join(directory, 'service.sock')
+    shutil.rmtree(directory, ignore_errors = True)
+
+@pytest.fixture
+def service(psycmodule, units, socket_path):
+    # Service run in a thread: cffi releases the GIL during PsychroServiceRun
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    path = ffi.new('char[]', socket_path.encode())
+    config = ffi.new('struct PsychroServiceConfig *', {'SocketPath': path, 'Threads': 2, 'CoalescedPoints': 4096})
+    handle = lib.PsychroServiceCreate(config)
+    assert handle != ffi.NULL
+    result = []
+    thread = threading.Thread(target = lambda: result.append(lib.PsychroServiceRun(handle)))
+    thread.start()
+    yield handle, socket_path.encode()
+    lib.PsychroServiceStop(handle)
+    thread.join()
+    lib.PsychroServiceDestroy(handle)
+    assert result == [0]
+    assert not os.path.exists(socket_path)
+
+def points(units, n, seed = 42):
+    rng = np.random.default_rng(seed)
+    (TLow, THigh), (PLow, PHigh) = DOMAINS[units]
+    return rng.uniform(TLow, THigh, n), rng.uniform(0.05, 1., n), rng.uniform(PLow, PHigh, n)
+
+def inputs(ffi, function, T, RH, P, lib):
+    if function == lib.PSYCHRO_SERVICE_TDEW_POINT_FROM_REL_HUM:
+        arrays = [T, RH]
+    else:
+        arrays = [T, RH, P]
+    buffers = [ffi.new('double[]', list(a)) for a in arrays]
+    return buffers, ffi.new('double *[]', buffers)
+
+def outputs(ffi, lib, function, n):
+    NIn, NOut = ffi.new('int *'), ffi.new('int *')
+    assert lib.PsychroServiceGetShape(function, NIn, NOut) == 0
+    buffers = [ffi.new('double[]', n) for _ in range(NOut[0])]
+    return buffers, ffi.new('double *[]', buffers)
+
+def expected(psycmodule, function, T, RH, P):
+    # Outputs of the bounded functions, NaN outside the range of the equations
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    out = [ffi.new('double *') for _ in range(7)]
+    if function == lib.PSYCHRO_SERVICE_CALC_FROM_REL_HUM:
+        status = lib.BoundedCalcPsychrometricsFromRelHum(T, RH, P, *out)
+        n = 7
+    elif function == lib.PSYCHRO_SERVICE_HUM_RATIO_FROM_REL_HUM:
+        status, n = lib.BoundedGetHumRatioFromRelHum(T, RH, P, out[0]), 1
+    elif function == lib.PSYCHRO_SERVICE_TWET_BULB_FROM_REL_HUM:
+        status, n = lib.BoundedGetTWetBulbFromRelHum(T, RH, P, out[0]), 1
+    else:
+        status, n = lib.BoundedGetTDewPointFromRelHum(T, RH, out[0]), 1
+    return [x[0] if status == lib.PSYCHRO_STATUS_OK else float('nan') for x in out[:n]]
+
+@pytest.fixture
+def client(psycmodule, service):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    handle = lib.PsychroClientConnect(service[1], 1 << 16)
+    assert handle != ffi.NULL
+    yield handle
+    lib.PsychroClientClose(handle)
+
+FUNCTIONS = ['PSYCHRO_SERVICE_CALC_FROM_REL_HUM', 'PSYCHRO_SERVICE_HUM_RATIO_FROM_REL_HUM',
+             'PSYCHRO_SERVICE_TWET_BULB_FROM_REL_HUM', 'PSYCHRO_SERVICE_TDEW_POINT_FROM_REL_HUM']
+
+@pytest.mark.parametrize('name', FUNCTIONS)
+def test_ServiceCall(psycmodule, units, client, name):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    function = getattr(lib, name)
+    assert lib.PsychroClientGetUnitSystem(client) == getattr(lib, units)
+    T, RH, P = points(units, 100)
+    _, In = inputs(ffi, function, T, RH, P, lib)
+    Out, OutPointers = outputs(ffi, lib, function, len(T))
+    assert lib.PsychroClientCall(client, function, len(T), In, OutPointers) == 0
+    for i in range(len(T)):
+        assert [o[i] for o in Out] == expected(psycmodule, function, T[i], RH[i], P[i])
+
+def test_ServiceCalcFromTWetBulbAndTDewPoint(psycmodule, units, client):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    T, RH, P = points(units, 50)
+    TWetBulb = [lib.GetTWetBulbFromRelHum(*x) for x in zip(T, RH, P)]
+    TDewPoint = [lib.GetTDewPointFromRelHum(t, rh) for t, rh in zip(T, RH)]
+    for function, other, scalar in [(lib.PSYCHRO_SERVICE_CALC_FROM_TWET_BULB, TWetBulb, lib.BoundedCalcPsychrometricsFromTWetBulb),
+                                    (lib.PSYCHRO_SERVICE_CALC_FROM_TDEW_POINT, TDewPoint, lib.BoundedCalcPsychrometricsFromTDewPoint)]:
+        _, In = inputs(ffi, function, T, other, P, lib)
+        Out, OutPointers = outputs(ffi, lib, function, len(T))
+        assert lib.PsychroClientCall(client, function, len(T), In, OutPointers) == 0
+        for i in range(len(T)):
+            out = [ffi.new('double *') for _ in range(7)]
+            assert scalar(T[i], other[i], P[i], *out) == lib.PSYCHRO_STATUS_OK
+            assert [o[i] for o in Out] == [x[0] for x in out]
+
+def test_ServiceCoalescing(psycmodule, units, service):
+    # Requests of several clients submitted before any response: results in the order of the tickets
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    function = lib.PSYCHRO_SERVICE_TWET_BULB_FROM_REL_HUM
+    clients = [lib.PsychroClientConnect(service[1], 1 << 14) for _ in range(3)]
+    assert ffi.NULL not in clients
+    try:
+        submitted = []
+        for k in range(60):
+            T, RH, P = points(units, 1 + 37 * k % 700, seed = k)
+            keep, In = inputs(ffi, function, T, RH, P, lib)
+            ticket = lib.PsychroClientSubmit(clients[k % 3], function, len(T), In)
+            assert ticket >= 0
+            submitted.append((clients[k % 3], ticket, T, RH, P))
+            # Waits in a different order from the submissions
+            if k % 10 == 9:
+                for c, t, T, RH, P in reversed(submitted):
+                    Out, OutPointers = outputs(ffi, lib, function, len(T))
+                    assert lib.PsychroClientWait(c, t, OutPointers) == 0
+                    assert list(Out[0]) == [expected(psycmodule, function, *x)[0] for x in zip(T, RH, P)]
+                    # A request is waited for once
+                    assert lib.PsychroClientWait(c, t, OutPointers) == -1
+                submitted = []
+        stats = ffi.new('struct PsychroServiceStats *')
+        assert lib.PsychroClientGetStats(clients[0], stats) == 0
+        assert stats.Clients == 3
+        assert stats.Requests == 60
+        assert stats.Points == sum(1 + 37 * k % 700 for k in range(60))
+        assert stats.Batches <= stats.Requests
+    finally:
+        for c in clients:
+            lib.PsychroClientClose(c)
+
+def test_ServiceRingFull(psycmodule, units, service):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    function = lib.PSYCHRO_SERVICE_HUM_RATIO_FROM_REL_HUM
+    client = lib.PsychroClientConnect(service[1], 1000)
+    try:
+        T, RH, P = points(units, 100)
+        _, In = inputs(ffi, function, T, RH, P, lib)
+        # 400 doubles per request: the third does not fit until the first is waited for
+        tickets = [lib.PsychroClientSubmit(client, function, 100, In) for _ in range(2)]
+        assert lib.PsychroClientSubmit(client, function, 100, In) == -1
+        assert lib.PsychroClientSubmit(client, function, 251, In) == -1
+        assert lib.PsychroClientWait(client, tickets[0], ffi.NULL) == 0
+        tickets.append(lib.PsychroClientSubmit(client, function, 100, In))
+        assert tickets[2] >= 0
+        Out, OutPointers = outputs(ffi, lib, function, 100)
+        for ticket in tickets[1:]:
+            assert lib.PsychroClientWait(client, ticket, OutPointers) == 0
+            assert list(Out[0]) == [expected(psycmodule, function, *x)[0] for x in zip(T, RH, P)]
+    finally:
+        lib.PsychroClientClose(client)
+
+def test_ServiceInvalidPoints(psycmodule, units, client, service):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    function = lib.PSYCHRO_SERVICE_CALC_FROM_REL_HUM
+    T, RH, P = points(units, 20)
+    RH[3], T[7], P[11] = 1.5, 1e4, -1.
+    _, In = inputs(ffi, function, T, RH, P, lib)
+    Out, OutPointers = outputs(ffi, lib, function, len(T))
+    assert lib.PsychroClientCall(client, function, len(T), In, OutPointers) == 3
+    for i in range(len(T)):
+        assert all(np.isnan(o[i]) for o in Out) == (i in (3, 7, 11))
+    # Invalid request: the function does not exist
+    assert lib.PsychroClientSubmit(client, lib.PSYCHRO_SERVICE_N_FUNCTIONS, 1, In) == -1
+    stats = ffi.new('struct PsychroServiceStats *')
+    lib.PsychroServiceGetStats(service[0], stats)
+    assert (stats.Requests, stats.Points, stats.InvalidPoints) == (1, 20, 3)
+    assert 0. < stats.MedianLatency <= stats.P99Latency
+    assert stats.MeanLatency <= stats.MaxLatency < 2. * stats.P99Latency + 1e-9
+
+def test_ServiceConnectFailure(psycmodule, socket_path):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    assert lib.PsychroClientConnect(socket_path.encode(), 1024) == ffi.NULL
+    # Path too long for a Unix domain socket, kept alive until the service is created
+    path = ffi.new('char[]', b'/' + b'x' * 200)
+    config = ffi.new('struct PsychroServiceConfig *', {'SocketPath': path})
+    assert lib.PsychroServiceCreate(config) == ffi.NULL
+
+def test_ServiceDaemon(psycmodule, tmp_path, socket_path):
+    # Daemon in its own process, stopped by SIGTERM
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    cc = os.environ.get('CC', 'cc')
+    if shutil.which(cc) is None:
+        pytest.skip('requires a C compiler')
+    daemon = tmp_path / 'psychrolib_serviced'
+    sources = [str(PATH_TO_C / name) for name in
+               ['psychrolib_serviced.c', 'psychrolib_service.c', 'psychrolib_bounded.c', 'psychrolib.c']]
+    result = subprocess.run([cc, '-O2', '-o', str(daemon)] + sources + ['-lm', '-pthread'], capture_output = True, text = True)
+    assert result.returncode == 0, result.stderr
+    process = subprocess.Popen([str(daemon), socket_path, 'IP'], stdout = subprocess.PIPE, stderr = subprocess.PIPE, text = True)
+    try:
+        for _ in range(200):
+            client = lib.PsychroClientConnect(socket_path.encode(), 1024)
+            if client != ffi.NULL:
+                break
+            time.sleep(0.01)
+        assert client != ffi.NULL
+        assert lib.PsychroClientGetUnitSystem(client) == lib.IP
+        function = lib.PSYCHRO_SERVICE_TDEW_POINT_FROM_REL_HUM
+        _, In = inputs(ffi, function, [77.], [0.5], [14.696], lib)
+        Out, OutPointers = outputs(ffi, lib, function, 1)
+        assert lib.PsychroClientCall(client, function, 1, In, OutPointers) == 0
+        lib.PsychroClientClose(client)
+        lib.SetUnitSystem(lib.IP)
+        assert Out[0][0] == expected(psycmodule, function, 77., 0.5, 14.696)[0]
+    finally:
+        lib.SetUnitSystem(lib.SI)
+        process.send_signal(signal.SIGTERM)
+        stdout, stderr = process.communicate(timeout = 10)
+    assert process.returncode == 0, stderr
+    assert 'Requests: 1 (0 rejected), points: 1 (0 invalid)' in stdout
+    assert not os.path.exists(socket_path)
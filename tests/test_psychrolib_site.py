@@ -0,0 +1,89 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the site context of the C library against the generic functions, in SI and IP units.
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+# Dry-bulb temperature range, relative humidity range and pressure in each system of units
+DOMAINS = {'SI': (-60., 90., 0.01, 1., 101325. * 0.85), 'IP': (-76., 194., 0.01, 1., 14.696 * 0.85)}
+
+@pytest.fixture
+def site(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    TMin, TMax, RHMin, RHMax, Pressure = DOMAINS[units]
+    site = ffi.gc(lib.PsychroSiteCreate(Pressure), lib.PsychroSiteDestroy)
+    rng = np.random.default_rng(30)
+    TDryBulb = rng.uniform(TMin, TMax, 2000)
+    RelHum = rng.uniform(RHMin, RHMax, 2000)
+    return site, TDryBulb, RelHum, Pressure
+
+def batch(psycmodule, function, site, *inputs, outputs = 1):
+    ffi = psycmodule.ffi
+    out = [np.empty(len(inputs[0])) for _ in range(outputs)]
+    function(site, len(inputs[0]), *[ffi.from_buffer("double[]", np.ascontiguousarray(x)) for x in inputs],
+             *[ffi.from_buffer("double[]", o) for o in out])
+    return out[0] if outputs == 1 else out
+
+def generic(function, *inputs):
+    return np.array([function(*args) for args in zip(*inputs)])
+
+def test_PsychroSiteGetSatVapPresAndSatHumRatio(psycmodule, site):
+    lib = psycmodule.lib
+    site, TDryBulb, _, Pressure = site
+    assert lib.PsychroSiteGetPressure(site) == Pressure
+    # Both sides of the triple point
+    TDryBulb = np.concatenate([TDryBulb, [lib.GetTDewPointFromVapPres(20., lib.GetSatVapPres(0.01)), 0., 32., 32.018]])
+    assert batch(psycmodule, lib.PsychroSiteGetSatVapPres, site, TDryBulb) == \
+        pytest.approx(generic(lib.GetSatVapPres, TDryBulb), rel = 1e-9)
+    assert batch(psycmodule, lib.PsychroSiteGetSatHumRatio, site, TDryBulb) == \
+        pytest.approx(generic(lib.GetSatHumRatio, TDryBulb, np.full_like(TDryBulb, Pressure)), rel = 1e-9)
+
+def test_PsychroSiteGetHumRatio(psycmodule, site):
+    lib = psycmodule.lib
+    site, TDryBulb, RelHum, Pressure = site
+    P = np.full_like(TDryBulb, Pressure)
+    HumRatio = batch(psycmodule, lib.PsychroSiteGetHumRatioFromRelHum, site, TDryBulb, RelHum)
+    assert HumRatio == pytest.approx(generic(lib.GetHumRatioFromRelHum, TDryBulb, RelHum, P), rel = 1e-9)
+    VapPres = generic(lib.GetVapPresFromRelHum, TDryBulb, RelHum)
+    assert batch(psycmodule, lib.PsychroSiteGetHumRatioFromVapPres, site, VapPres) == \
+        pytest.approx(generic(lib.GetHumRatioFromVapPres, VapPres, P), rel = 1e-9)
+    TWetBulb = generic(lib.GetTWetBulbFromRelHum, TDryBulb, RelHum, P)
+    assert batch(psycmodule, lib.PsychroSiteGetHumRatioFromTWetBulb, site, TDryBulb, TWetBulb) == \
+        pytest.approx(generic(lib.GetHumRatioFromTWetBulb, TDryBulb, TWetBulb, P), rel = 1e-9, abs = 1e-12)
+
+# The generic functions solve the temperatures to within PSYCHROLIB_TOLERANCE
+def test_PsychroSiteGetTWetBulbAndTDewPoint(psycmodule, site):
+    lib = psycmodule.lib
+    site, TDryBulb, RelHum, Pressure = site
+    tolerance = 0.001 * (9. / 5. if lib.GetUnitSystem() == lib.IP else 1.)
+    P = np.full_like(TDryBulb, Pressure)
+    HumRatio = generic(lib.GetHumRatioFromRelHum, TDryBulb, RelHum, P)
+    TWetBulb = batch(psycmodule, lib.PsychroSiteGetTWetBulbFromHumRatio, site, TDryBulb, HumRatio)
+    assert TWetBulb == pytest.approx(generic(lib.GetTWetBulbFromHumRatio, TDryBulb, HumRatio, P), abs = tolerance)
+    TDewPoint = batch(psycmodule, lib.PsychroSiteGetTDewPointFromHumRatio, site, TDryBulb, HumRatio)
+    assert TDewPoint == pytest.approx(generic(lib.GetTDewPointFromHumRatio, TDryBulb, HumRatio, P), abs = tolerance)
+    # The site solvers are converged to a much tighter tolerance
+    assert generic(lib.GetHumRatioFromTWetBulb, TDryBulb, TWetBulb, P) == pytest.approx(HumRatio, rel = 1e-6, abs = 1e-9)
+    assert generic(lib.GetSatVapPres, TDewPoint) == \
+        pytest.approx(generic(lib.GetVapPresFromHumRatio, HumRatio, P), rel = 1e-8)
+
+def test_PsychroSiteCalcPsychrometricsFromRelHum(psycmodule, site):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    site, TDryBulb, RelHum, Pressure = site
+    tolerance = 0.001 * (9. / 5. if lib.GetUnitSystem() == lib.IP else 1.)
+    outputs = batch(psycmodule, lib.PsychroSiteCalcPsychrometricsFromRelHum, site, TDryBulb, RelHum, outputs = 7)
+    expected = [ffi.new("double *") for _ in range(7)]
+    for i in range(0, len(TDryBulb), 37):
+        lib.CalcPsychrometricsFromRelHum(TDryBulb[i], RelHum[i], Pressure, *expected)
+        HumRatio, TWetBulb, TDewPoint, *others = [e[0] for e in expected]
+        assert outputs[0][i] == pytest.approx(HumRatio, rel = 1e-9)
+        assert outputs[1][i] == pytest.approx(TWetBulb, abs = tolerance)
+        assert outputs[2][i] == pytest.approx(TDewPoint, abs = tolerance)
+        assert [o[i] for o in outputs[3:]] == pytest.approx(others, rel = 1e-9)
+
+def test_PsychroSiteCreateInvalidPressure(psycmodule):
+    assert psycmodule.lib.PsychroSiteCreate(0.) == psycmodule.ffi.NULL
@@ -0,0 +1,227 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the property tables of the C library, in SI and IP units: exact values at the nodes and
+# outside the box, interpolation error against the error report and the tolerances, and tables
+# saved to a file and mapped in memory again.
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+# Unsaturated box of dry-bulb temperature, humidity ratio and pressure in each system of units
+BOXES = {'SI': ((20., 40.), (0.001, 0.012), (80000., 101325.)),
+         'IP': ((68., 104.), (0.001, 0.012), (11.6, 14.696))}
+
+# Cold and dry box down to a humidity ratio of 0, where the dew-point temperature varies as the
+# logarithm of the humidity ratio, with the tolerances of its tables
+DRY_BOXES = {'SI': ((-40., 40.), (0., 0.012), (80000., 101325.)),
+             'IP': ((-40., 104.), (0., 0.012), (11.6, 14.696))}
+
+TOLERANCES = {'SI': 0.05, 'IP': 0.09}
+
+PROPERTIES = ['MOIST_AIR_DENSITY', 'MOIST_AIR_ENTHALPY', 'MOIST_AIR_VOLUME', 'TWET_BULB', 'TDEW_POINT', 'REL_HUM']
+
+EXACT = ['GetMoistAirDensity', 'GetMoistAirEnthalpy', 'GetMoistAirVolume', 'GetTWetBulbFromHumRatio',
+         'GetTDewPointFromHumRatio', 'GetRelHumFromHumRatio']
+
+def exact(lib, p, T, W, P):
+    if EXACT[p] == 'GetMoistAirEnthalpy':
+        return lib.GetMoistAirEnthalpy(T, W)
+    return getattr(lib, EXACT[p])(T, W, P)
+
+def create(psycmodule, box, counts, interpolation = 'TRILINEAR', properties = None, tolerances = {}):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    config = ffi.new('struct PsychroTableConfig *')
+    for axis, (lo, hi), n in zip([config.TDryBulb, config.HumRatio, config.Pressure], box, counts):
+        axis.Min, axis.Max, axis.Count = lo, hi, n
+    config.Properties = (1 << len(PROPERTIES)) - 1 if properties is None else properties
+    config.Interpolation = getattr(lib, 'PSYCHRO_TABLE_' + interpolation)
+    for p, tolerance in tolerances.items():
+        config.Tolerance[PROPERTIES.index(p)] = tolerance
+    return lib.PsychroTableCreate(config)
+
+def random_points(box, n, seed = 35):
+    rng = np.random.default_rng(seed)
+    return [rng.uniform(lo, hi, n) for lo, hi in box]
+
+def report(psycmodule, table):
+    r = psycmodule.ffi.new('struct PsychroTableErrorReport *')
+    psycmodule.lib.PsychroTableGetErrorReport(table, r)
+    return r
+
+def test_PsychroTableNodesAreExact(psycmodule, units):
+    lib = psycmodule.lib
+    box = BOXES[units]
+    table = create(psycmodule, box, (5, 4, 3), 'CUBIC')
+    for T in np.linspace(*box[0], 5):
+        for W in np.linspace(*box[1], 4):
+            for P in np.linspace(*box[2], 3):
+                for p in range(len(PROPERTIES)):
+                    assert lib.PsychroTableLookup(table, p, T, W, P) == pytest.approx(exact(lib, p, T, W, P), rel = 1e-12, abs = 1e-12)
+    lib.PsychroTableDestroy(table)
+
+@pytest.mark.parametrize('interpolation', ['TRILINEAR', 'CUBIC'])
+def test_PsychroTableErrorWithinReport(psycmodule, units, interpolation):
+    lib = psycmodule.lib
+    table = create(psycmodule, BOXES[units], (41, 23, 5), interpolation)
+    r = report(psycmodule, table)
+    assert r.Samples == 40 * 22 * 4
+    for p in range(len(PROPERTIES)):
+        errors = [abs(lib.PsychroTableLookup(table, p, T, W, P) - exact(lib, p, T, W, P))
+                  for T, W, P in zip(*random_points(BOXES[units], 500))]
+        assert r.MaxAbsError[p] > 0
+        assert r.RmsError[p] <= r.MaxAbsError[p]
+        # The centers of the cells are the farthest points from the nodes; allow for the tolerance
+        # of the iterative solvers on the wet-bulb temperature, and for the change from ice to
+        # liquid water of the dew-point temperature at freezing, where the error peaks elsewhere
+        if PROPERTIES[p] == 'TDEW_POINT':
+            assert max(errors) <= 1.5 * r.MaxAbsError[p]
+        else:
+            assert max(errors) <= 1.1 * r.MaxAbsError[p] + (2e-3 if PROPERTIES[p] == 'TWET_BULB' else 0.)
+    lib.PsychroTableDestroy(table)
+
+def test_PsychroTableCubicMoreAccurate(psycmodule, units):
+    lib = psycmodule.lib
+    linear = create(psycmodule, BOXES[units], (21, 12, 5), 'TRILINEAR')
+    cubic = create(psycmodule, BOXES[units], (21, 12, 5), 'CUBIC')
+    for p in ['MOIST_AIR_DENSITY', 'MOIST_AIR_VOLUME', 'REL_HUM']:
+        i = PROPERTIES.index(p)
+        assert report(psycmodule, cubic).MaxAbsError[i] < 0.1 * report(psycmodule, linear).MaxAbsError[i]
+    lib.PsychroTableDestroy(linear)
+    lib.PsychroTableDestroy(cubic)
+
+def test_PsychroTableFallbackOutsideBox(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    box = BOXES[units]
+    table = create(psycmodule, box, (11, 11, 3), properties = 1 << lib.PSYCHRO_TABLE_TWET_BULB)
+    T = [box[0][0] - 5., box[0][1], (box[0][0] + box[0][1]) / 2, box[0][1] + 1.]
+    W = [0.005, 0.005, box[1][1] + 0.001, 0.005]
+    P = [box[2][1]] * 4
+    values = ffi.new('double[4]')
+    assert lib.PsychroTableLookupBatch(table, lib.PSYCHRO_TABLE_TWET_BULB, 4, T, W, P, values) == 3
+    for i in [0, 2, 3]:
+        assert values[i] == lib.GetTWetBulbFromHumRatio(T[i], W[i], P[i])
+    # Properties that are not tabulated are always exact
+    assert lib.PsychroTableLookupBatch(table, lib.PSYCHRO_TABLE_MOIST_AIR_DENSITY, 4, T, W, P, values) == 4
+    for i in range(4):
+        assert values[i] == lib.GetMoistAirDensity(T[i], W[i], P[i])
+        assert lib.PsychroTableLookup(table, lib.PSYCHRO_TABLE_MOIST_AIR_DENSITY, T[i], W[i], P[i]) == values[i]
+    lib.PsychroTableDestroy(table)
+
+def test_PsychroTableBatchEqualsLookup(psycmodule, units):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    table = create(psycmodule, BOXES[units], (21, 12, 5), 'CUBIC')
+    T, W, P = random_points(BOXES[units], 200)
+    values = ffi.new('double[200]')
+    for p in range(len(PROPERTIES)):
+        assert lib.PsychroTableLookupBatch(table, p, 200, list(T), list(W), list(P), values) == 0
+        for i in range(200):
+            assert values[i] == lib.PsychroTableLookup(table, p, T[i], W[i], P[i])
+    lib.PsychroTableDestroy(table)
+
+def test_PsychroTableFixedPressure(psycmodule, units):
+    lib = psycmodule.lib
+    box = BOXES[units]
+    P = box[2][1]
+    table = create(psycmodule, (box[0], box[1], (P, P)), (41, 23, 1))
+    r = report(psycmodule, table)
+    assert r.Samples == 40 * 22
+    for T, W, _ in zip(*random_points(box, 100)):
+        assert lib.PsychroTableLookup(table, lib.PSYCHRO_TABLE_TDEW_POINT, T, W, P) == \
+            pytest.approx(lib.GetTDewPointFromHumRatio(T, W, P), abs = 1.1 * r.MaxAbsError[lib.PSYCHRO_TABLE_TDEW_POINT])
+    lib.PsychroTableDestroy(table)
+
+def test_PsychroTableSaveAndOpen(psycmodule, units, tmp_path):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    path = str(tmp_path / 'table.bin').encode()
+    properties = 1 << lib.PSYCHRO_TABLE_MOIST_AIR_ENTHALPY | 1 << lib.PSYCHRO_TABLE_TWET_BULB
+    table = create(psycmodule, BOXES[units], (21, 12, 5), 'CUBIC', properties)
+    assert lib.PsychroTableSave(table, path) == 0
+    mapped = lib.PsychroTableOpen(path)
+    assert mapped != ffi.NULL
+
+    config = ffi.new('struct PsychroTableConfig *')
+    lib.PsychroTableGetConfig(mapped, config)
+    assert config.Properties == properties
+    assert config.Interpolation == lib.PSYCHRO_TABLE_CUBIC
+    assert (config.HumRatio.Min, config.HumRatio.Max, config.HumRatio.Count) == (*BOXES[units][1], 12)
+    original, reopened = report(psycmodule, table), report(psycmodule, mapped)
+    assert reopened.Samples == original.Samples
+    assert list(reopened.MaxAbsError) == list(original.MaxAbsError)
+
+    for T, W, P in zip(*random_points(BOXES[units], 100)):
+        for p in range(len(PROPERTIES)):
+            assert lib.PsychroTableLookup(mapped, p, T, W, P) == lib.PsychroTableLookup(table, p, T, W, P)
+    lib.PsychroTableDestroy(table)
+    lib.PsychroTableDestroy(mapped)
+
+    # Files in the other system of units are rejected
+    lib.SetUnitSystem(lib.IP if units == 'SI' else lib.SI)
+    assert lib.PsychroTableOpen(path) == ffi.NULL
+
+@pytest.mark.parametrize('interpolation', ['TRILINEAR', 'CUBIC'])
+def test_PsychroTableTolerance(psycmodule, units, interpolation, tmp_path):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    box, tolerance = DRY_BOXES[units], TOLERANCES[units]
+    p = PROPERTIES.index('TDEW_POINT')
+    points = list(zip(*random_points(box, 2000)))
+    unbounded = create(psycmodule, box, (41, 25, 3), interpolation, 1 << p)
+    table = create(psycmodule, box, (41, 25, 3), interpolation, 1 << p, {'TDEW_POINT': tolerance})
+    assert report(psycmodule, unbounded).ExactCells[p] == 0
+    assert 0 < report(psycmodule, table).ExactCells[p] < 40 * 24 * 2
+    assert report(psycmodule, table).MaxAbsError[p] <= tolerance
+
+    # Linear interpolation in the humidity ratio is off by degrees in dry air without tolerance
+    errors = [abs(lib.PsychroTableLookup(unbounded, p, T, W, P) - lib.GetTDewPointFromHumRatio(T, W, P)) for T, W, P in points]
+    assert max(errors) > 10 * tolerance
+    errors = [abs(lib.PsychroTableLookup(table, p, T, W, P) - lib.GetTDewPointFromHumRatio(T, W, P)) for T, W, P in points]
+    assert max(errors) <= tolerance
+
+    # The cells calculated with the exact function are saved with the table
+    path = str(tmp_path / 'table.bin').encode()
+    assert lib.PsychroTableSave(table, path) == 0
+    mapped = lib.PsychroTableOpen(path)
+    assert mapped != ffi.NULL
+    config = ffi.new('struct PsychroTableConfig *')
+    lib.PsychroTableGetConfig(mapped, config)
+    assert config.Tolerance[p] == tolerance
+    assert report(psycmodule, mapped).ExactCells[p] == report(psycmodule, table).ExactCells[p]
+    for T, W, P in points[:200]:
+        assert lib.PsychroTableLookup(mapped, p, T, W, P) == lib.PsychroTableLookup(table, p, T, W, P)
+    for t in [unbounded, table, mapped]:
+        lib.PsychroTableDestroy(t)
+
+def test_PsychroTableOpenInvalidFile(psycmodule, tmp_path):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    path = tmp_path / 'table.bin'
+    table = create(psycmodule, BOXES['SI'], (11, 11, 3))
+    assert lib.PsychroTableSave(table, str(path).encode()) == 0
+    lib.PsychroTableDestroy(table)
+    data = path.read_bytes()
+
+    assert lib.PsychroTableOpen(str(tmp_path / 'missing.bin').encode()) == ffi.NULL
+    path.write_bytes(data[:-8])
+    assert lib.PsychroTableOpen(str(path).encode()) == ffi.NULL
+    path.write_bytes(b'X' + data[1:])
+    assert lib.PsychroTableOpen(str(path).encode()) == ffi.NULL
+    path.write_bytes(data)
+    table = lib.PsychroTableOpen(str(path).encode())
+    assert table != ffi.NULL
+    assert lib.PsychroTableSave(table, str(tmp_path / 'missing' / 'table.bin').encode()) == -1
+    lib.PsychroTableDestroy(table)
+
+def test_PsychroTableCreateInvalidConfig(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    box = BOXES['SI']
+    assert create(psycmodule, box, (11, 11, 0)) == ffi.NULL
+    assert create(psycmodule, box, (11, 11, 1)) == ffi.NULL
+    assert create(psycmodule, (box[0][::-1], box[1], box[2]), (11, 11, 3)) == ffi.NULL
+    assert create(psycmodule, ((-120., 20.), box[1], box[2]), (11, 11, 3)) == ffi.NULL
+    assert create(psycmodule, (box[0], (-0.001, 0.01), box[2]), (11, 11, 3)) == ffi.NULL
+    assert create(psycmodule, (box[0], box[1], (0., 101325.)), (11, 11, 3)) == ffi.NULL
+    assert create(psycmodule, box, (11, 11, 3), properties = 0) == ffi.NULL
+    assert create(psycmodule, box, (11, 11, 3), properties = 1 << len(PROPERTIES)) == ffi.NULL
+    for tolerance in [-0.01, float('nan'), float('inf')]:
+        assert create(psycmodule, box, (11, 11, 3), tolerances = {'TWET_BULB': tolerance}) == ffi.NULL
@@ -0,0 +1,62 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the static tracepoints of the C library: without PSYCHROLIB_USDT the objects have no
+# probe, note or semaphore, and with it (when sys/sdt.h is installed) each instrumented module has
+# its probes of provider psychrolib, with their arguments and semaphores.
+
+import os
+import re
+import shutil
+import subprocess
+from pathlib import Path
+
+import pytest
+
+PATH_TO_SRC = Path(__file__).parents[1] / 'src' / 'c'
+
+# Probes of each instrumented module, with their number of arguments
+PROBES = {'psychrolib': {'assert_failed': 3, 'tdew_point_entry': 2, 'tdew_point_return': 2, 'twet_bulb_entry': 3,
+                         'twet_bulb_return': 2, 'calc_entry': 4, 'calc_return': 2},
+          'psychrolib_site': {'batch_entry': 2, 'batch_return': 2},
+          'psychrolib_inverse': {'batch_entry': 2, 'batch_return': 2},
+          'psychrolib_table': {'batch_entry': 2, 'batch_return': 2},
+          'psychrolib_gradient': {'batch_entry': 2, 'batch_return': 2},
+          'psychrolib_lockstep': {'batch_entry': 2, 'batch_return': 2},
+          'psychrolib_regime': {'batch_entry': 2, 'batch_return': 2},
+          'psychrolib_frame': {'batch_entry': 2, 'batch_return': 2}}
+
+def Compile(tmp_path, module, defines):
+    obj = tmp_path / (module + '.o')
+    command = [os.environ.get('CC', 'cc'), '-O2', '-fPIC', '-Wall', '-Werror'] + ['-D' + define for define in defines] + \
+              ['-c', str(PATH_TO_SRC / (module + '.c')), '-o', str(obj)]
+    if shutil.which(command[0]) is None or shutil.which('readelf') is None:
+        pytest.skip('requires a C compiler and readelf')
+    result = subprocess.run(command, capture_output = True, text = True)
+    if 'sys/sdt.h' in result.stderr:
+        pytest.skip('requires sys/sdt.h')
+    assert result.returncode == 0, result.stderr
+    return obj
+
+def ReadElf(option, obj):
+    return subprocess.run(['readelf', '-W', option, str(obj)], capture_output = True, text = True, check = True).stdout
+
+@pytest.mark.parametrize('module', PROBES)
+def test_NoProbesByDefault(tmp_path, module):
+    obj = Compile(tmp_path, module, [])
+    assert 'stapsdt' not in ReadElf('-S', obj)
+    assert '.probes' not in ReadElf('-S', obj)
+    assert 'semaphore' not in ReadElf('-s', obj)
+
+@pytest.mark.parametrize('module', PROBES)
+def test_Probes(tmp_path, module):
+    obj = Compile(tmp_path, module, ['PSYCHROLIB_USDT'])
+    notes = re.findall(r'Provider: (\w+)\s+Name: (\w+)\s+Location: .*?Semaphore: (0x[0-9a-f]+)\s+Arguments: ([^\n]*)',
+                       ReadElf('-n', obj), re.S)
+    assert {provider for provider, _, _, _ in notes} == {'psychrolib'}
+    assert {name: len(arguments.split()) for _, name, _, arguments in notes} == PROBES[module]
+
+    # Every probe has its semaphore, defined weak in the .probes section by each translation unit
+    symbols = ReadElf('-s', obj)
+    for name in PROBES[module]:
+        assert re.search(r'WEAK +DEFAULT +\d+ psychrolib_' + name + '_semaphore$', symbols, re.M)
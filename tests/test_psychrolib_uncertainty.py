@@ -0,0 +1,137 @@
+# PsychroLib (version 2.5.0) (https://github.com/psychrometrics/psychrolib).
+# Copyright (c) 2018-2020 The PsychroLib Contributors. Licensed under the MIT License.
+
+# Test of the Monte Carlo uncertainty propagation of the C library, in SI and IP units: statistics
+# against the first-order propagation of the gradients, correlation, reproducibility and threads.
+
+import math
+
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.usefixtures('SetUnitSystem_SI')
+
+# Points and standard uncertainties of dry-bulb temperature, relative humidity and pressure
+POINTS = {'SI': ([24., 5., 32.], [0.5, 0.8, 0.3], [101325., 95000., 98000.], [0.1, 0.01, 50.]),
+          'IP': ([75.2, 41., 89.6], [0.5, 0.8, 0.3], [14.696, 13.78, 14.21], [0.18, 0.01, 0.00725])}
+
+def config(psycmodule, std, samples = 10000, correlation = None, seed = 39, threads = 1):
+    c = psycmodule.ffi.new('struct PsychroUncertaintyConfig *')
+    c.StdDev = list(std)
+    c.Correlation = [list(row) for row in (correlation if correlation is not None else np.eye(3))]
+    c.Samples = samples
+    c.NQuantiles = 3
+    c.Probabilities = [0.025, 0.5, 0.975] + [0.] * 5
+    c.Seed = seed
+    c.Threads = threads
+    return c
+
+def propagate(psycmodule, c, T, RH, P):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    results = ffi.new('struct PsychroUncertaintyResult[]', len(T))
+    assert lib.PsychroUncertaintyPropagate(c, len(T), T, RH, P, results) == 0
+    return results
+
+def linear_std(psycmodule, T, RH, P, std, correlation):
+    # First-order propagation of the covariance with the analytic Jacobian
+    ffi, lib = psycmodule.ffi, psycmodule.lib
+    values, jacobian = ffi.new('double[7]'), ffi.new('double[21]')
+    lib.GradCalcPsychrometricsFromRelHum(1, [T], [RH], [P], values, jacobian)
+    J = np.array(list(jacobian)).reshape(7, 3)
+    covariance = np.outer(std, std) * np.array(correlation)
+    return list(values), np.sqrt(np.einsum('ij,jk,ik->i', J, covariance, J))
+
+def test_PsychroUncertaintyAgainstLinear(psycmodule, units):
+    lib = psycmodule.lib
+    T, RH, P, std = POINTS[units]
+    results = propagate(psycmodule, config(psycmodule, std), T, RH, P)
+    for i in range(3):
+        values, expected_std = linear_std(psycmodule, T[i], RH[i], P[i], std, np.eye(3))
+        r = results[i]
+        assert r.Rejected == 0
+        for k in [lib.PSYCHRO_UNC_HUM_RATIO, lib.PSYCHRO_UNC_TWET_BULB, lib.PSYCHRO_UNC_TDEW_POINT,
+                  lib.PSYCHRO_UNC_MOIST_AIR_ENTHALPY, lib.PSYCHRO_UNC_MOIST_AIR_VOLUME]:
+            # Small uncertainties: nearly linear, with a sampling error of about 1/sqrt(10000)
+            assert r.StdDev[k] == pytest.approx(expected_std[k], rel = 0.05)
+            assert r.Mean[k] == pytest.approx(values[k], abs = 0.05 * expected_std[k])
+            low, median, high = list(r.Quantiles[k])[:3]
+            assert median == pytest.approx(values[k], abs = 0.1 * expected_std[k])
+            assert low == pytest.approx(values[k] - 1.96 * expected_std[k], abs = 0.15 * expected_std[k])
+            assert high == pytest.approx(values[k] + 1.96 * expected_std[k], abs = 0.15 * expected_std[k])
+            assert math.isnan(r.Quantiles[k][3])
+
+def test_PsychroUncertaintyCorrelation(psycmodule):
+    lib = psycmodule.lib
+    T, RH, P, std = POINTS['SI']
+    # Errors of temperature and relative humidity of the same sign, or of opposite signs
+    for rho in [0.8, -0.8]:
+        correlation = [[1., rho, 0.], [rho, 1., 0.], [0., 0., 1.]]
+        results = propagate(psycmodule, config(psycmodule, std, correlation = correlation), T, RH, P)
+        for i in range(3):
+            _, expected_std = linear_std(psycmodule, T[i], RH[i], P[i], std, correlation)
+            for k in [lib.PSYCHRO_UNC_TDEW_POINT, lib.PSYCHRO_UNC_MOIST_AIR_ENTHALPY]:
+                assert results[i].StdDev[k] == pytest.approx(expected_std[k], rel = 0.05)
+
+    # Perfectly correlated errors of a singular matrix
+    correlation = [[1., 1., 0.], [1., 1., 0.], [0., 0., 1.]]
+    results = propagate(psycmodule, config(psycmodule, std, correlation = correlation), T, RH, P)
+    _, expected_std = linear_std(psycmodule, T[0], RH[0], P[0], std, correlation)
+    assert results[0].StdDev[lib.PSYCHRO_UNC_TDEW_POINT] == pytest.approx(expected_std[lib.PSYCHRO_UNC_TDEW_POINT], rel = 0.05)
+
+def test_PsychroUncertaintyReproducible(psycmodule):
+    lib = psycmodule.lib
+    rng = np.random.default_rng(39)
+    n = 13
+    T, RH, P = list(rng.uniform(0., 40., n)), list(rng.uniform(0.2, 0.9, n)), list(rng.uniform(90000., 101325., n))
+    std = POINTS['SI'][3]
+    serial = propagate(psycmodule, config(psycmodule, std, samples = 1000), T, RH, P)
+    again = propagate(psycmodule, config(psycmodule, std, samples = 1000), T, RH, P)
+    other = propagate(psycmodule, config(psycmodule, std, samples = 1000, seed = 40), T, RH, P)
+    for threads in [2, 5, 64]:
+        parallel = propagate(psycmodule, config(psycmodule, std, samples = 1000, threads = threads), T, RH, P)
+        for i in range(n):
+            assert list(parallel[i].Mean) == list(serial[i].Mean)
+            assert list(parallel[i].StdDev) == list(serial[i].StdDev)
+            assert [list(q)[:3] for q in parallel[i].Quantiles[0:7]] == [list(q)[:3] for q in serial[i].Quantiles[0:7]]
+    for i in range(n):
+        assert list(again[i].Mean) == list(serial[i].Mean)
+        assert list(other[i].Mean) != list(serial[i].Mean)
+    # The stream of a point depends on its index only, not on the points before it
+    tail = propagate(psycmodule, config(psycmodule, std, samples = 1000), T[:1], RH[:1], P[:1])
+    assert list(tail[0].Mean) == list(serial[0].Mean)
+
+def test_PsychroUncertaintyZeroUncertainty(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    results = propagate(psycmodule, config(psycmodule, [0., 0., 0.], samples = 3), [24.], [0.5], [101325.])
+    expected = ffi.new('double[7]')
+    lib.BoundedCalcPsychrometricsFromRelHum(24., 0.5, 101325., *[expected + k for k in range(7)])
+    for k in range(lib.PSYCHRO_UNC_N_OUTPUTS):
+        assert results[0].Mean[k] == pytest.approx(expected[k], rel = 1e-12)
+        assert results[0].StdDev[k] == pytest.approx(0., abs = 1e-12 * abs(expected[k]))
+        assert list(results[0].Quantiles[k])[:3] == pytest.approx([expected[k]] * 3, rel = 1e-12)
+
+def test_PsychroUncertaintyRejectedSamples(psycmodule):
+    lib = psycmodule.lib
+    # Half of the temperatures above the range of the equations; relative humidities clipped at saturation
+    results = propagate(psycmodule, config(psycmodule, [1., 0.05, 0.], samples = 2000), [200., 30.], [0.05, 1.], [101325.] * 2)
+    assert 800 < results[0].Rejected < 1200
+    assert results[0].Mean[lib.PSYCHRO_UNC_TWET_BULB] < 200.
+    assert results[1].Rejected == 0
+    assert results[1].Quantiles[lib.PSYCHRO_UNC_TDEW_POINT][2] <= 30. + 3.
+
+def test_PsychroUncertaintyInvalidConfig(psycmodule):
+    lib, ffi = psycmodule.lib, psycmodule.ffi
+    std = POINTS['SI'][3]
+    results = ffi.new('struct PsychroUncertaintyResult[1]')
+    invalid = [config(psycmodule, std, samples = 0), config(psycmodule, [-1., 0., 0.]),
+               config(psycmodule, std, correlation = [[1., 0.5, 0.], [0.4, 1., 0.], [0., 0., 1.]]),
+               config(psycmodule, std, correlation = [[1., 0.9, 0.9], [0.9, 1., -0.9], [0.9, -0.9, 1.]]),
+               config(psycmodule, std, correlation = 2. * np.eye(3))]
+    c = config(psycmodule, std)
+    c.Probabilities[1] = 1.
+    invalid.append(c)
+    c = config(psycmodule, std)
+    c.NQuantiles = 9
+    invalid.append(c)
+    for c in invalid:
+        assert lib.PsychroUncertaintyPropagate(c, 1, [24.], [0.5], [101325.], results) == -1